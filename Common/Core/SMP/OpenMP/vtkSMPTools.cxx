@@ -26,11 +26,6 @@ namespace
 int vtkSMPNumberOfSpecifiedThreads = 0;
 }
 
-const char* vtkSMPTools::GetBackend()
-{
-  return VTK_SMP_BACKEND;
-}
-
 void vtkSMPTools::Initialize(int numThreads)
 {
 #pragma omp single
@@ -43,7 +38,9 @@ void vtkSMPTools::Initialize(int numThreads)
 
 int vtkSMPTools::GetEstimatedNumberOfThreads()
 {
-  return vtk::detail::smp::GetNumberOfThreads();
+  int numThreads = vtk::detail::smp::GetNumberOfThreads();
+  int maxThreads = vtk::detail::smp::vtkSMPToolsScope::GetMaxNumberOfThreads();
+  return (maxThreads > 0 && maxThreads < numThreads) ? maxThreads : numThreads;
 }
 
 int vtk::detail::smp::GetNumberOfThreads()
@@ -54,15 +51,36 @@ int vtk::detail::smp::GetNumberOfThreads()
 void vtk::detail::smp::vtkSMPTools_Impl_For_OpenMP(vtkIdType first, vtkIdType last, vtkIdType grain,
   ExecuteFunctorPtrType functorExecuter, void* functor)
 {
+  const vtkSMPToolsScopeState state = vtkSMPToolsScope::GetState();
+  const bool nested = vtkSMPToolsScope::IsParallelScope();
+  if (nested && !vtkSMPToolsScope::GetNestedParallelism())
+  {
+    // Nested parallelism is disabled: run the chunks on the calling thread.
+    vtkSMPToolsTaskScope scope(state);
+    const vtkIdType step = (grain > 0) ? grain : last - first;
+    for (vtkIdType from = first; from < last; from += step)
+    {
+      functorExecuter(functor, from, step, last);
+    }
+    return;
+  }
+
+  const int numThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+  if (nested && omp_get_max_active_levels() <= omp_get_active_level())
+  {
+    omp_set_max_active_levels(omp_get_active_level() + 1);
+  }
+
   if (grain <= 0)
   {
-    vtkIdType estimateGrain = (last - first) / (omp_get_max_threads() * 4);
+    vtkIdType estimateGrain = (last - first) / (numThreads * 4);
     grain = (estimateGrain > 0) ? estimateGrain : 1;
   }
 
-#pragma omp parallel for schedule(runtime)
+#pragma omp parallel for schedule(runtime) num_threads(numThreads)
   for (vtkIdType from = first; from < last; from += grain)
   {
+    vtkSMPToolsTaskScope scope(state);
     functorExecuter(functor, from, grain, last);
   }
 }
@@ -0,0 +1,344 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPThreadPool.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkSMPThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+namespace
+{
+// Index of the queue owned by the calling thread, -1 for external threads.
+thread_local int vtkSMPWorkerIndex = -1;
+
+int GetHardwareNumberOfThreads()
+{
+  unsigned int numThreads = std::thread::hardware_concurrency();
+  return numThreads > 0 ? static_cast<int>(numThreads) : 1;
+}
+}
+
+//--------------------------------------------------------------------------------
+vtkSMPThreadPool& vtkSMPThreadPool::GetInstance()
+{
+  static vtkSMPThreadPool instance;
+  return instance;
+}
+
+//--------------------------------------------------------------------------------
+vtkSMPThreadPool::vtkSMPThreadPool()
+  : NumberOfThreads(GetHardwareNumberOfThreads())
+  , Started(false)
+  , PendingTasks(0)
+  , SleepingWorkers(0)
+  , Shutdown(false)
+{
+}
+
+//--------------------------------------------------------------------------------
+vtkSMPThreadPool::~vtkSMPThreadPool()
+{
+  std::lock_guard<std::mutex> lock(this->StartMutex);
+  this->Stop();
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPThreadPool::SetNumberOfThreads(int numThreads)
+{
+  if (numThreads <= 0)
+  {
+    numThreads = GetHardwareNumberOfThreads();
+  }
+
+  std::lock_guard<std::mutex> lock(this->StartMutex);
+  if (numThreads != this->NumberOfThreads)
+  {
+    this->Stop();
+    this->NumberOfThreads = numThreads;
+  }
+}
+
+//--------------------------------------------------------------------------------
+int vtkSMPThreadPool::GetNumberOfThreads()
+{
+  std::lock_guard<std::mutex> lock(this->StartMutex);
+  return this->NumberOfThreads;
+}
+
+//--------------------------------------------------------------------------------
+bool vtkSMPThreadPool::Job::TryAcquire()
+{
+  if (this->MaxThreads <= 0)
+  {
+    ++this->Running;
+    return true;
+  }
+  int running = this->Running.load();
+  while (running < this->MaxThreads)
+  {
+    if (this->Running.compare_exchange_weak(running, running + 1))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+//--------------------------------------------------------------------------------
+// Must be called with StartMutex held.
+void vtkSMPThreadPool::Start()
+{
+  if (this->Started)
+  {
+    return;
+  }
+
+  const int numWorkers = this->NumberOfThreads - 1;
+  this->Queues.clear();
+  for (int i = 0; i <= numWorkers; ++i)
+  {
+    this->Queues.emplace_back(new TaskQueue);
+  }
+  this->Shutdown = false;
+  for (int i = 0; i < numWorkers; ++i)
+  {
+    this->Workers.emplace_back(&vtkSMPThreadPool::WorkerLoop, this, i);
+  }
+  this->Started = true;
+}
+
+//--------------------------------------------------------------------------------
+// Must be called with StartMutex held.
+void vtkSMPThreadPool::Stop()
+{
+  if (!this->Started)
+  {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->SleepMutex);
+    this->Shutdown = true;
+  }
+  this->WakeUp.notify_all();
+  for (auto& worker : this->Workers)
+  {
+    worker.join();
+  }
+  this->Workers.clear();
+  this->Queues.clear();
+  this->Started = false;
+}
+
+//--------------------------------------------------------------------------------
+int vtkSMPThreadPool::GetQueueIndex() const
+{
+  return vtkSMPWorkerIndex >= 0 ? vtkSMPWorkerIndex
+                                : static_cast<int>(this->Queues.size()) - 1;
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPThreadPool::Push(int queueIndex, const Task& task)
+{
+  {
+    TaskQueue& queue = *this->Queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.Mutex);
+    queue.Tasks.push_back(task);
+  }
+  ++this->PendingTasks;
+
+  // Taking the lock before notifying guarantees that a worker which has
+  // just checked PendingTasks is actually waiting, so no wake up is lost.
+  if (this->SleepingWorkers.load() > 0)
+  {
+    std::lock_guard<std::mutex> lock(this->SleepMutex);
+    this->WakeUp.notify_one();
+  }
+}
+
+//--------------------------------------------------------------------------------
+// Must be called with the queue mutex held. Takes the task only if its job
+// accepts one more thread.
+bool vtkSMPThreadPool::Take(std::deque<Task>& tasks, std::deque<Task>::iterator it, Task& task)
+{
+  if (!it->Owner->TryAcquire())
+  {
+    return false;
+  }
+  task = *it;
+  tasks.erase(it);
+  --this->PendingTasks;
+  return true;
+}
+
+//--------------------------------------------------------------------------------
+bool vtkSMPThreadPool::Pop(int queueIndex, Job* job, Task& task)
+{
+  TaskQueue& queue = *this->Queues[queueIndex];
+  std::lock_guard<std::mutex> lock(queue.Mutex);
+  for (auto it = queue.Tasks.rbegin(); it != queue.Tasks.rend(); ++it)
+  {
+    if ((!job || it->Owner == job) && this->Take(queue.Tasks, std::next(it).base(), task))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+//--------------------------------------------------------------------------------
+bool vtkSMPThreadPool::Steal(int thiefIndex, Job* job, Task& task)
+{
+  const int numQueues = static_cast<int>(this->Queues.size());
+  for (int i = 1; i < numQueues; ++i)
+  {
+    TaskQueue& queue = *this->Queues[(thiefIndex + i) % numQueues];
+    std::lock_guard<std::mutex> lock(queue.Mutex);
+    for (auto it = queue.Tasks.begin(); it != queue.Tasks.end(); ++it)
+    {
+      if ((!job || it->Owner == job) && this->Take(queue.Tasks, it, task))
+      {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+//--------------------------------------------------------------------------------
+// The calling thread must have acquired the job of the task.
+void vtkSMPThreadPool::Run(int queueIndex, Task task)
+{
+  Job* job = task.Owner;
+
+  // Lazy binary splitting: keep the lower half, expose the upper half to
+  // thieves. Splits happen on grain boundaries so that chunks match the
+  // ones produced by the other backends.
+  vtkIdType numChunks = (task.Last - task.First + job->Grain - 1) / job->Grain;
+  while (numChunks > 1)
+  {
+    vtkIdType middle = task.First + (numChunks / 2) * job->Grain;
+    this->Push(queueIndex, Task{ job, middle, task.Last });
+    task.Last = middle;
+    numChunks = (task.Last - task.First + job->Grain - 1) / job->Grain;
+  }
+
+  {
+    vtkSMPToolsTaskScope scope(job->State);
+    job->Executer(job->Functor, task.First, task.Last);
+  }
+
+  // The job may be destroyed by its owner as soon as Remaining reaches zero.
+  --job->Running;
+  job->Remaining -= task.Last - task.First;
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPThreadPool::WorkerLoop(int index)
+{
+  vtkSMPWorkerIndex = index;
+  for (;;)
+  {
+    Task task;
+    if (this->Pop(index, nullptr, task) || this->Steal(index, nullptr, task))
+    {
+      this->Run(index, task);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(this->SleepMutex);
+    if (this->PendingTasks.load() > 0 && !this->Shutdown.load())
+    {
+      // The remaining tasks belong to jobs already using all the threads
+      // they are allowed to. Back off instead of spinning.
+      this->WakeUp.wait_for(lock, std::chrono::microseconds(100));
+      continue;
+    }
+    ++this->SleepingWorkers;
+    this->WakeUp.wait(
+      lock, [this]() { return this->PendingTasks.load() > 0 || this->Shutdown.load(); });
+    --this->SleepingWorkers;
+    if (this->Shutdown.load())
+    {
+      break;
+    }
+  }
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPThreadPool::ParallelFor(vtkIdType first, vtkIdType last, vtkIdType grain,
+  ExecuteFunctorPtrType functorExecuter, void* functor, int maxThreads)
+{
+  vtkIdType n = last - first;
+  if (n <= 0)
+  {
+    return;
+  }
+
+  int queueIndex;
+  int numThreads;
+  {
+    std::lock_guard<std::mutex> lock(this->StartMutex);
+    this->Start();
+    queueIndex = this->GetQueueIndex();
+    numThreads = this->NumberOfThreads;
+  }
+
+  if (maxThreads > 0 && maxThreads < numThreads)
+  {
+    numThreads = maxThreads;
+  }
+  if (grain <= 0)
+  {
+    vtkIdType estimateGrain = n / (numThreads * 4);
+    grain = (estimateGrain > 0) ? estimateGrain : 1;
+  }
+
+  Job job;
+  job.Executer = functorExecuter;
+  job.Functor = functor;
+  job.Grain = grain;
+  job.Remaining = n;
+  job.MaxThreads = maxThreads;
+  job.Running = 1; // the calling thread
+  job.State = vtkSMPToolsScope::GetState();
+
+  this->Run(queueIndex, Task{ &job, first, last });
+
+  // Help with the remaining chunks of this job only, see the header.
+  while (job.Remaining.load() > 0)
+  {
+    Task task;
+    if (this->Pop(queueIndex, &job, task) || this->Steal(queueIndex, &job, task))
+    {
+      this->Run(queueIndex, task);
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+}
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
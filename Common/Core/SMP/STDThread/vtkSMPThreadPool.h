@@ -0,0 +1,145 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPThreadPool.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// A work-stealing thread pool built only on the C++11 standard library. Each
+// worker owns a double ended queue of range tasks. A thread executing a task
+// lazily splits it in halves until it reaches the grain size, pushing the
+// upper halves on the back of its own queue. The owner pops from the back
+// (LIFO, cache friendly) while idle threads steal from the front of the other
+// queues (FIFO, so they take the largest remaining ranges). Threads that are
+// not part of the pool (e.g. the main thread) share one additional queue and
+// participate in the execution of the jobs they submitted.
+//
+// A thread waiting for a job only executes tasks belonging to that job. This
+// guarantees that a functor is never re-entered on the same thread, which
+// would break the vtkSMPThreadLocal assumptions of most VTK functors. It also
+// makes nested parallelism safe: a task starting a job waits for it while
+// executing its chunks, and idle workers steal the others.
+//
+// A job may be limited to a maximum number of threads: a thread only takes a
+// task when fewer than that many chunks of the job are being executed.
+
+#ifndef vtkSMPThreadPool_h
+#define vtkSMPThreadPool_h
+
+#include "vtkSystemIncludes.h"
+
+#include "vtkSMPToolsInternal.h" // For ExecuteFunctorPtrType
+#include "vtkSMPToolsScope.h"    // For vtkSMPToolsScopeState
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+class vtkSMPThreadPool
+{
+public:
+  /**
+   * Access the process wide pool. Workers are started lazily.
+   */
+  static vtkSMPThreadPool& GetInstance();
+
+  ~vtkSMPThreadPool();
+
+  /**
+   * Set the total number of threads used by the pool, including the thread
+   * calling ParallelFor(). A value <= 0 restores the hardware default. Must
+   * not be called while a parallel operation is in progress.
+   */
+  void SetNumberOfThreads(int numThreads);
+  int GetNumberOfThreads();
+
+  /**
+   * Execute [first, last) in chunks of at most grain items and block until
+   * all chunks are done. The calling thread takes part in the execution.
+   * At most maxThreads threads execute the chunks concurrently, unless
+   * maxThreads <= 0.
+   */
+  void ParallelFor(vtkIdType first, vtkIdType last, vtkIdType grain,
+    ExecuteFunctorPtrType functorExecuter, void* functor, int maxThreads = 0);
+
+private:
+  struct Job
+  {
+    ExecuteFunctorPtrType Executer;
+    void* Functor;
+    vtkIdType Grain;
+    std::atomic<vtkIdType> Remaining;
+    int MaxThreads;
+    std::atomic<int> Running;
+    vtkSMPToolsScopeState State;
+
+    bool TryAcquire();
+  };
+
+  struct Task
+  {
+    Job* Owner;
+    vtkIdType First;
+    vtkIdType Last;
+  };
+
+  struct TaskQueue
+  {
+    std::mutex Mutex;
+    std::deque<Task> Tasks;
+  };
+
+  vtkSMPThreadPool();
+  vtkSMPThreadPool(const vtkSMPThreadPool&) = delete;
+  void operator=(const vtkSMPThreadPool&) = delete;
+
+  void Start();
+  void Stop();
+  void WorkerLoop(int index);
+  void Push(int queueIndex, const Task& task);
+  bool Pop(int queueIndex, Job* job, Task& task);
+  bool Steal(int thiefIndex, Job* job, Task& task);
+  bool Take(std::deque<Task>& tasks, std::deque<Task>::iterator it, Task& task);
+  void Run(int queueIndex, Task task);
+  int GetQueueIndex() const;
+
+  int NumberOfThreads;
+  bool Started;
+  std::mutex StartMutex;
+
+  // One queue per worker plus a shared one (the last) for external threads.
+  std::vector<std::unique_ptr<TaskQueue>> Queues;
+  std::vector<std::thread> Workers;
+
+  std::atomic<int> PendingTasks;
+  std::atomic<int> SleepingWorkers;
+  std::atomic<bool> Shutdown;
+  std::mutex SleepMutex;
+  std::condition_variable WakeUp;
+};
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPThreadPool.h
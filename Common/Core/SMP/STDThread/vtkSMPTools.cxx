@@ -0,0 +1,265 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPTools.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkSMPTools.h"
+
+#include "vtkSMP.h"
+#include "vtkSMPThreadPool.h"
+#include "vtkSMPToolsAPI.h"
+
+#ifdef VTK_SMP_ENABLE_OPENMP
+#include <omp.h>
+#endif
+
+#ifdef VTK_SMP_ENABLE_TBB
+#ifdef _MSC_VER
+#pragma push_macro("__TBB_NO_IMPLICIT_LINKAGE")
+#define __TBB_NO_IMPLICIT_LINKAGE 1
+#endif
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#include <tbb/task_scheduler_init.h>
+
+#ifdef _MSC_VER
+#pragma pop_macro("__TBB_NO_IMPLICIT_LINKAGE")
+#endif
+#endif
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+// The STDThread implementation owns a dependency free work-stealing thread
+// pool and is also able to dispatch the (type erased) functors to the other
+// backends that were enabled at build time. The backend actually used can
+// be changed at run time with vtkSMPTools::SetBackend() or with the
+// VTK_SMP_BACKEND_IN_USE environment variable.
+
+namespace
+{
+using vtk::detail::smp::vtkSMPThreadPool;
+using vtk::detail::smp::vtkSMPToolsScope;
+using vtk::detail::smp::vtkSMPToolsScopeState;
+using vtk::detail::smp::vtkSMPToolsTaskScope;
+
+using namespace vtk::detail::smp;
+
+int vtkSMPNumberOfSpecifiedThreads = 0;
+
+#ifdef VTK_SMP_ENABLE_TBB
+std::unique_ptr<tbb::task_scheduler_init> vtkSMPTBBInit;
+std::mutex vtkSMPTBBInitMutex;
+
+// The task arena capping the TBB jobs started by a thread. It is reused by
+// the next jobs of the thread with the same cap.
+struct vtkSMPTBBArena
+{
+  std::unique_ptr<tbb::task_arena> Arena;
+  int MaxNumberOfThreads = 0;
+  bool InUse = false;
+};
+thread_local vtkSMPTBBArena vtkSMPTBBThreadArena;
+
+//--------------------------------------------------------------------------------
+// Runs f on at most maxNumberOfThreads threads, the calling one included,
+// as the thread pool caps each of its jobs.
+template <typename F>
+void ExecuteCappedTBB(int maxNumberOfThreads, F& f)
+{
+  vtkSMPTBBArena& cached = vtkSMPTBBThreadArena;
+  if (cached.InUse)
+  {
+    // A nested job started by a chunk running in the arena of the calling
+    // thread gets its own arena, to be capped on its own.
+    tbb::task_arena arena(maxNumberOfThreads);
+    arena.execute(f);
+    return;
+  }
+  if (!cached.Arena || cached.MaxNumberOfThreads != maxNumberOfThreads)
+  {
+    cached.Arena.reset(new tbb::task_arena(maxNumberOfThreads));
+    cached.MaxNumberOfThreads = maxNumberOfThreads;
+  }
+  cached.InUse = true;
+  cached.Arena->execute(f);
+  cached.InUse = false;
+}
+#endif
+
+//--------------------------------------------------------------------------------
+void ExecuteSequential(vtkIdType first, vtkIdType last, vtkIdType grain,
+  vtk::detail::smp::ExecuteFunctorPtrType functorExecuter, void* functor)
+{
+  vtkSMPToolsTaskScope scope(vtkSMPToolsScope::GetState());
+  if (grain <= 0)
+  {
+    grain = last - first;
+  }
+  for (vtkIdType from = first; from < last; from += grain)
+  {
+    vtkIdType to = from + grain;
+    functorExecuter(functor, from, to < last ? to : last);
+  }
+}
+}
+
+//--------------------------------------------------------------------------------
+void vtk::detail::smp::InitializeBackendInUse()
+{
+  vtkSMPTools::Initialize(vtkSMPNumberOfSpecifiedThreads);
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPTools::Initialize(int numThreads)
+{
+  vtkSMPNumberOfSpecifiedThreads = numThreads > 0 ? numThreads : 0;
+  switch (GetBackendInUse())
+  {
+    case STDTHREAD:
+      vtkSMPThreadPool::GetInstance().SetNumberOfThreads(numThreads);
+      break;
+#ifdef VTK_SMP_ENABLE_OPENMP
+    case OPENMP:
+#pragma omp single
+      if (numThreads > 0)
+      {
+        omp_set_num_threads(numThreads);
+      }
+      break;
+#endif
+#ifdef VTK_SMP_ENABLE_TBB
+    case TBB:
+    {
+      // As with the TBB backend, only the first request is honored.
+      std::lock_guard<std::mutex> lock(vtkSMPTBBInitMutex);
+      if (numThreads > 0 && !vtkSMPTBBInit)
+      {
+        vtkSMPTBBInit.reset(new tbb::task_scheduler_init(numThreads));
+      }
+      break;
+    }
+#endif
+    default:
+      break;
+  }
+}
+
+//--------------------------------------------------------------------------------
+int vtkSMPTools::GetEstimatedNumberOfThreads()
+{
+  int numThreads = vtk::detail::smp::GetNumberOfThreads();
+  int maxThreads = vtkSMPToolsScope::GetMaxNumberOfThreads();
+  return (maxThreads > 0 && maxThreads < numThreads) ? maxThreads : numThreads;
+}
+
+//--------------------------------------------------------------------------------
+int vtk::detail::smp::GetNumberOfThreads()
+{
+  switch (GetBackendInUse())
+  {
+    case STDTHREAD:
+      return vtkSMPThreadPool::GetInstance().GetNumberOfThreads();
+#ifdef VTK_SMP_ENABLE_OPENMP
+    case OPENMP:
+      return vtkSMPNumberOfSpecifiedThreads ? vtkSMPNumberOfSpecifiedThreads
+                                            : omp_get_max_threads();
+#endif
+#ifdef VTK_SMP_ENABLE_TBB
+    case TBB:
+      return vtkSMPNumberOfSpecifiedThreads ? vtkSMPNumberOfSpecifiedThreads
+                                            : tbb::task_scheduler_init::default_num_threads();
+#endif
+    default:
+      return 1;
+  }
+}
+
+//--------------------------------------------------------------------------------
+void vtk::detail::smp::vtkSMPTools_Impl_For_STDThread(vtkIdType first, vtkIdType last,
+  vtkIdType grain, ExecuteFunctorPtrType functorExecuter, void* functor)
+{
+  if (vtkSMPToolsScope::IsParallelScope() && !vtkSMPToolsScope::GetNestedParallelism())
+  {
+    // Nested parallelism is disabled: run the chunks on the calling thread.
+    ExecuteSequential(first, last, grain, functorExecuter, functor);
+    return;
+  }
+
+  const vtkSMPToolsScopeState state = vtkSMPToolsScope::GetState();
+  switch (GetBackendInUse())
+  {
+    case STDTHREAD:
+      vtkSMPThreadPool::GetInstance().ParallelFor(
+        first, last, grain, functorExecuter, functor, state.MaxNumberOfThreads);
+      break;
+#ifdef VTK_SMP_ENABLE_OPENMP
+    case OPENMP:
+    {
+      const int numThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+      if (vtkSMPToolsScope::IsParallelScope() &&
+        omp_get_max_active_levels() <= omp_get_active_level())
+      {
+        omp_set_max_active_levels(omp_get_active_level() + 1);
+      }
+      if (grain <= 0)
+      {
+        vtkIdType estimateGrain = (last - first) / (numThreads * 4);
+        grain = (estimateGrain > 0) ? estimateGrain : 1;
+      }
+#pragma omp parallel for schedule(runtime) num_threads(numThreads)
+      for (vtkIdType from = first; from < last; from += grain)
+      {
+        vtkSMPToolsTaskScope scope(state);
+        vtkIdType to = from + grain;
+        functorExecuter(functor, from, to < last ? to : last);
+      }
+      break;
+    }
+#endif
+#ifdef VTK_SMP_ENABLE_TBB
+    case TBB:
+    {
+      auto body = [functorExecuter, functor, &state](const tbb::blocked_range<vtkIdType>& r) {
+        vtkSMPToolsTaskScope scope(state);
+        functorExecuter(functor, r.begin(), r.end());
+      };
+      auto parallelFor = [&]() {
+        if (grain > 0)
+        {
+          tbb::parallel_for(tbb::blocked_range<vtkIdType>(first, last, grain), body);
+        }
+        else
+        {
+          tbb::parallel_for(tbb::blocked_range<vtkIdType>(first, last), body);
+        }
+      };
+      if (state.MaxNumberOfThreads > 0)
+      {
+        ExecuteCappedTBB(state.MaxNumberOfThreads, parallelFor);
+      }
+      else
+      {
+        parallelFor();
+      }
+      break;
+    }
+#endif
+    default:
+      ExecuteSequential(first, last, grain, functorExecuter, functor);
+      break;
+  }
+}
@@ -19,11 +19,6 @@
 
 // Simple implementation that runs everything sequentially.
 
-const char* vtkSMPTools::GetBackend()
-{
-  return VTK_SMP_BACKEND;
-}
-
 //--------------------------------------------------------------------------------
 void vtkSMPTools::Initialize(int) {}
 
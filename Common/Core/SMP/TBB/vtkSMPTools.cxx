@@ -23,12 +23,15 @@
 #define __TBB_NO_IMPLICIT_LINKAGE 1
 #endif
 
+#include <tbb/task_arena.h>
 #include <tbb/task_scheduler_init.h>
 
 #ifdef _MSC_VER
 #pragma pop_macro("__TBB_NO_IMPLICIT_LINKAGE")
 #endif
 
+#include <memory>
+
 struct vtkSMPToolsInit
 {
   tbb::task_scheduler_init Init;
@@ -43,11 +46,15 @@ static bool vtkSMPToolsInitialized = 0;
 static int vtkTBBNumSpecifiedThreads = 0;
 static vtkSimpleCriticalSection vtkSMPToolsCS;
 
-//--------------------------------------------------------------------------------
-const char* vtkSMPTools::GetBackend()
+// The task arena capping the jobs started by a thread, see
+// vtkSMPTools_Impl_CappedExecute().
+struct vtkSMPToolsArena
 {
-  return VTK_SMP_BACKEND;
-}
+  std::unique_ptr<tbb::task_arena> Arena;
+  int MaxNumberOfThreads = 0;
+  bool InUse = false;
+};
+static thread_local vtkSMPToolsArena vtkSMPToolsThreadArena;
 
 //--------------------------------------------------------------------------------
 void vtkSMPTools::Initialize(int numThreads)
@@ -70,6 +77,31 @@ void vtkSMPTools::Initialize(int numThreads)
 //--------------------------------------------------------------------------------
 int vtkSMPTools::GetEstimatedNumberOfThreads()
 {
-  return vtkTBBNumSpecifiedThreads ? vtkTBBNumSpecifiedThreads
-                                   : tbb::task_scheduler_init::default_num_threads();
+  int numThreads = vtkTBBNumSpecifiedThreads ? vtkTBBNumSpecifiedThreads
+                                             : tbb::task_scheduler_init::default_num_threads();
+  int maxThreads = vtk::detail::smp::vtkSMPToolsScope::GetMaxNumberOfThreads();
+  return (maxThreads > 0 && maxThreads < numThreads) ? maxThreads : numThreads;
+}
+
+//--------------------------------------------------------------------------------
+void vtk::detail::smp::vtkSMPTools_Impl_CappedExecute(
+  int maxNumberOfThreads, void (*call)(void*), void* lambda)
+{
+  vtkSMPToolsArena& cached = vtkSMPToolsThreadArena;
+  if (cached.InUse)
+  {
+    // A nested job started by a chunk running in the arena of the calling
+    // thread: it gets its own arena to be capped on its own, as in STDThread.
+    tbb::task_arena arena(maxNumberOfThreads);
+    arena.execute([call, lambda]() { call(lambda); });
+    return;
+  }
+  if (!cached.Arena || cached.MaxNumberOfThreads != maxNumberOfThreads)
+  {
+    cached.Arena.reset(new tbb::task_arena(maxNumberOfThreads));
+    cached.MaxNumberOfThreads = maxNumberOfThreads;
+  }
+  cached.InUse = true;
+  cached.Arena->execute([call, lambda]() { call(lambda); });
+  cached.InUse = false;
 }
@@ -15,10 +15,16 @@
 #include "vtkNew.h"
 #include "vtkObject.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMP.h"
 #include "vtkSMPThreadLocal.h"
 #include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <functional>
+#include <numeric>
+#include <thread>
 #include <vector>
 
 static const int Target = 10000;
@@ -78,15 +84,194 @@ public:
   void Reduce() {}
 };
 
+class NestedFunctor
+{
+public:
+  vtkSMPThreadLocal<int> Counter;
+
+  NestedFunctor()
+    : Counter(0)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; i++)
+    {
+      ARangeFunctor inner;
+      vtkSMPTools::For(0, 100, inner);
+      for (auto value : inner.Counter)
+      {
+        this->Counter.Local() += value;
+      }
+    }
+  }
+};
+
+// Records the maximum number of chunks executed concurrently.
+class ConcurrencyFunctor
+{
+public:
+  std::atomic<int> Running;
+  std::atomic<int> MaxRunning;
+  std::atomic<int> NotInParallelScope;
+
+  ConcurrencyFunctor()
+    : Running(0)
+    , MaxRunning(0)
+    , NotInParallelScope(0)
+  {
+  }
+
+  void operator()(vtkIdType, vtkIdType)
+  {
+    int running = ++this->Running;
+    int maxRunning = this->MaxRunning;
+    while (running > maxRunning && !this->MaxRunning.compare_exchange_weak(maxRunning, running))
+    {
+    }
+    if (!vtkSMPTools::IsParallelScope())
+    {
+      ++this->NotInParallelScope;
+    }
+    std::this_thread::yield();
+    --this->Running;
+  }
+};
+
+int TestSMPLocalScope()
+{
+  if (vtkSMPTools::IsParallelScope())
+  {
+    cerr << "Error: IsParallelScope() is true outside of a parallel operation." << endl;
+    return 1;
+  }
+
+  // TBB nests its parallel operations by default, the other backends do not.
+  const bool defaultNestedParallelism = vtkSMPTools::GetNestedParallelism();
+  if (defaultNestedParallelism != (strcmp(vtkSMPTools::GetBackend(), "TBB") == 0))
+  {
+    cerr << "Error: Wrong default nested parallelism for " << vtkSMPTools::GetBackend() << endl;
+    return 1;
+  }
+
+  int status = 0;
+  for (bool nestedParallelism : { false, true })
+  {
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ 2, nestedParallelism }, [&]() {
+      if (vtkSMPTools::GetNestedParallelism() != nestedParallelism ||
+        vtkSMPTools::GetEstimatedNumberOfThreads() > 2)
+      {
+        cerr << "Error: LocalScope configuration not applied." << endl;
+        status = 1;
+      }
+
+      ConcurrencyFunctor functor;
+      vtkSMPTools::For(0, 1000, 1, functor);
+      if (functor.MaxRunning > 2 || functor.NotInParallelScope > 0)
+      {
+        cerr << "Error: " << functor.MaxRunning << " threads used in a scope limited to 2."
+             << endl;
+        status = 1;
+      }
+
+      NestedFunctor nested;
+      vtkSMPTools::For(0, 100, 1, nested);
+      int total = 0;
+      for (auto value : nested.Counter)
+      {
+        total += value;
+      }
+      if (total != 100 * 100)
+      {
+        cerr << "Error: NestedFunctor with nested parallelism " << nestedParallelism
+             << " did not generate " << 100 * 100 << endl;
+        status = 1;
+      }
+    });
+
+    if (vtkSMPTools::GetNestedParallelism() != defaultNestedParallelism)
+    {
+      cerr << "Error: LocalScope configuration not restored." << endl;
+      status = 1;
+    }
+  }
+  return status;
+}
+
 // For sorting comparison
 bool myComp(double a, double b)
 {
   return (a < b);
 }
 
-int TestSMP(int, char*[])
+int TestSMPPrimitives(vtkIdType size)
 {
-  // vtkSMPTools::Initialize(8);
+  std::vector<int> data(size);
+  std::iota(data.begin(), data.end(), -size / 2);
+
+  std::vector<int> result(size);
+  vtkSMPTools::Transform(data.begin(), data.end(), result.begin(), [](int x) { return 2 * x; });
+  vtkSMPTools::Transform(
+    data.begin(), data.end(), result.begin(), result.begin(), [](int x, int y) { return y - x; });
+  if (result != data)
+  {
+    cerr << "Error: bad Transform of " << size << " values." << endl;
+    return 1;
+  }
+
+  vtkSMPTools::Fill(result.begin(), result.end(), 3);
+  if (std::count(result.begin(), result.end(), 3) != size)
+  {
+    cerr << "Error: bad Fill of " << size << " values." << endl;
+    return 1;
+  }
+
+  const long long sum = vtkSMPTools::Reduce(data.begin(), data.end(), 7LL);
+  const int maximum = vtkSMPTools::Reduce(
+    data.begin(), data.end(), -size, [](int a, int b) { return std::max(a, b); });
+  if (sum != std::accumulate(data.begin(), data.end(), 7LL) ||
+    maximum != (size ? data.back() : -size))
+  {
+    cerr << "Error: bad Reduce of " << size << " values." << endl;
+    return 1;
+  }
+
+  // Compare the scans with the sequential std::partial_sum.
+  std::vector<int> expected(size + 1, 5);
+  std::partial_sum(data.begin(), data.end(), expected.begin() + 1);
+  std::transform(
+    expected.begin() + 1, expected.end(), expected.begin() + 1, [](int x) { return x + 5; });
+
+  vtkSMPTools::InclusiveScan(data.begin(), data.end(), result.begin());
+  if (!std::equal(result.begin(), result.end(), expected.begin() + 1, [](int a, int b) {
+        return a + 5 == b;
+      }))
+  {
+    cerr << "Error: bad InclusiveScan of " << size << " values." << endl;
+    return 1;
+  }
+
+  result = data;
+  const int total = vtkSMPTools::ExclusiveScan(result.begin(), result.end(), result.begin(), 5);
+  if (total != expected.back() || !std::equal(result.begin(), result.end(), expected.begin()))
+  {
+    cerr << "Error: bad in place ExclusiveScan of " << size << " values." << endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+int TestSMPBackend()
+{
+  for (vtkIdType size : { 0, 1, 1000, 100001 })
+  {
+    if (TestSMPPrimitives(size))
+    {
+      return 1;
+    }
+  }
 
   ARangeFunctor functor1;
 
@@ -130,6 +315,24 @@ int TestSMP(int, char*[])
     return 1;
   }
 
+  NestedFunctor functor3;
+  vtkSMPTools::For(0, 100, 1, functor3);
+  total = 0;
+  for (auto value : functor3.Counter)
+  {
+    total += value;
+  }
+  if (total != 100 * 100)
+  {
+    cerr << "Error: NestedFunctor did not generate " << 100 * 100 << endl;
+    return 1;
+  }
+
+  if (TestSMPLocalScope())
+  {
+    return 1;
+  }
+
   // Test sorting
   double data0[] = { 2, 1, 0, 3, 9, 6, 7, 3, 8, 4, 5 };
   std::vector<double> myvector(data0, data0 + 11);
@@ -159,3 +362,45 @@ int TestSMP(int, char*[])
 
   return 0;
 }
+
+int TestSMP(int, char*[])
+{
+  // vtkSMPTools::Initialize(8);
+
+  if (!vtkSMPTools::SetBackend(VTK_SMP_BACKEND))
+  {
+    cerr << "Error: could not select the " << VTK_SMP_BACKEND << " backend." << endl;
+    return 1;
+  }
+  if (TestSMPBackend())
+  {
+    return 1;
+  }
+
+  // The STDThread build is able to switch backends at run time.
+  if (strcmp(VTK_SMP_BACKEND, "STDThread") == 0)
+  {
+    const char* backends[] = { "Sequential", "STDThread" };
+    for (const char* backend : backends)
+    {
+      for (int numThreads : { 1, 2, 5 })
+      {
+        if (!vtkSMPTools::SetBackend(backend) || strcmp(vtkSMPTools::GetBackend(), backend) != 0)
+        {
+          cerr << "Error: could not select the " << backend << " backend." << endl;
+          return 1;
+        }
+        vtkSMPTools::Initialize(numThreads);
+        if (TestSMPBackend())
+        {
+          cerr << "Error: with the " << backend << " backend and " << numThreads << " threads."
+               << endl;
+          return 1;
+        }
+      }
+    }
+    vtkSMPTools::Initialize();
+  }
+
+  return 0;
+}
@@ -1,11 +1,12 @@
 set(VTK_SMP_IMPLEMENTATION_TYPE "Sequential"
-  CACHE STRING "Which multi-threaded parallelism implementation to use. Options are Sequential, OpenMP or TBB")
+  CACHE STRING "Which multi-threaded parallelism implementation to use. Options are Sequential, STDThread, OpenMP or TBB")
 set_property(CACHE VTK_SMP_IMPLEMENTATION_TYPE
   PROPERTY
-    STRINGS Sequential OpenMP TBB)
+    STRINGS Sequential STDThread OpenMP TBB)
 
 if (NOT (VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "OpenMP" OR
-         VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "TBB"))
+         VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "TBB" OR
+         VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "STDThread"))
   set_property(CACHE VTK_SMP_IMPLEMENTATION_TYPE
     PROPERTY
       VALUE "Sequential")
@@ -51,6 +52,39 @@ elseif (VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "OpenMP")
       "atomics implementation.")
   endif()
 
+elseif (VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "STDThread")
+  # The STDThread implementation can dispatch to the other backends at run
+  # time (see vtkSMPTools::SetBackend), when they are enabled here.
+  option(VTK_SMP_ENABLE_OPENMP "Make the OpenMP backend selectable at run time" OFF)
+  option(VTK_SMP_ENABLE_TBB "Make the TBB backend selectable at run time" OFF)
+  mark_as_advanced(VTK_SMP_ENABLE_OPENMP VTK_SMP_ENABLE_TBB)
+
+  if (VTK_SMP_ENABLE_OPENMP)
+    vtk_module_find_package(PACKAGE OpenMP)
+    list(APPEND vtk_smp_libraries
+      OpenMP::OpenMP_CXX)
+    list(APPEND vtk_smp_defines
+      VTK_SMP_ENABLE_OPENMP)
+  endif ()
+
+  if (VTK_SMP_ENABLE_TBB)
+    vtk_module_find_package(PACKAGE TBB)
+    list(APPEND vtk_smp_libraries
+      TBB::tbb)
+    list(APPEND vtk_smp_defines
+      VTK_SMP_ENABLE_TBB)
+  endif ()
+
+  set(vtk_smp_implementation_dir "${CMAKE_CURRENT_SOURCE_DIR}/SMP/STDThread")
+  list(APPEND vtk_smp_sources
+    "${vtk_smp_implementation_dir}/vtkSMPTools.cxx"
+    "${vtk_smp_implementation_dir}/vtkSMPThreadLocalImpl.cxx"
+    "${vtk_smp_implementation_dir}/vtkSMPThreadPool.cxx")
+  list(APPEND vtk_smp_headers_to_configure
+    vtkSMPThreadLocal.h
+    vtkSMPThreadLocalImpl.h
+    vtkSMPToolsInternal.h)
+
 elseif (VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "Sequential")
   set(vtk_smp_implementation_dir "${CMAKE_CURRENT_SOURCE_DIR}/SMP/Sequential")
   list(APPEND vtk_smp_sources
@@ -77,6 +111,11 @@ foreach (vtk_smp_header IN LISTS vtk_smp_headers_to_configure)
     "${CMAKE_CURRENT_BINARY_DIR}/${vtk_smp_header}")
 endforeach()
 
+list(APPEND vtk_smp_sources
+  vtkSMPToolsAPI.cxx
+  vtkSMPToolsScope.cxx)
+
 list(APPEND vtk_smp_headers
   vtkSMPTools.h
+  vtkSMPToolsScope.h
   vtkSMPThreadLocalObject.h)
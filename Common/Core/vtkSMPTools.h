@@ -19,8 +19,12 @@
  * vtkSMPTools provides a set of utility functions that can
  * be used to parallelize parts of VTK code using multiple threads.
  * There are several back-end implementations of parallel functionality
- * (currently Sequential, TBB and X-Kaapi) that actual execution is
- * delegated to.
+ * (currently Sequential, STDThread, OpenMP and TBB) that actual execution is
+ * delegated to. The back-end is chosen at build time with
+ * VTK_SMP_IMPLEMENTATION_TYPE. The STDThread back-end can additionally
+ * switch at run time between Sequential, STDThread and the OpenMP/TBB
+ * back-ends enabled with VTK_SMP_ENABLE_OPENMP/VTK_SMP_ENABLE_TBB, see
+ * SetBackend().
  */
 
 #ifndef vtkSMPTools_h
@@ -31,6 +35,11 @@
 
 #include "vtkSMPThreadLocal.h" // For Initialized
 #include "vtkSMPToolsInternal.h"
+#include "vtkSMPToolsScope.h" // For LocalScope
+
+#include <functional> // For std::plus
+#include <iterator>   // For std::iterator_traits
+#include <vector>     // For the per block results of Reduce and Scan
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 #ifndef __VTK_WRAP__
@@ -144,6 +153,219 @@ class vtkSMPTools_Lookup_For<Functor const>
 public:
   typedef vtkSMPTools_FunctorInternal<Functor const, init> type;
 };
+template <typename InputIt, typename OutputIt, typename Functor>
+class vtkSMPTools_UnaryTransformCall
+{
+  InputIt In;
+  OutputIt Out;
+  Functor& Transform;
+
+public:
+  vtkSMPTools_UnaryTransformCall(InputIt in, OutputIt out, Functor& transform)
+    : In(in)
+    , Out(out)
+    , Transform(transform)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    InputIt itIn(this->In);
+    OutputIt itOut(this->Out);
+    std::advance(itIn, begin);
+    std::advance(itOut, begin);
+    for (vtkIdType it = begin; it < end; ++it, ++itIn, ++itOut)
+    {
+      *itOut = this->Transform(*itIn);
+    }
+  }
+};
+
+template <typename InputIt1, typename InputIt2, typename OutputIt, typename Functor>
+class vtkSMPTools_BinaryTransformCall
+{
+  InputIt1 In1;
+  InputIt2 In2;
+  OutputIt Out;
+  Functor& Transform;
+
+public:
+  vtkSMPTools_BinaryTransformCall(InputIt1 in1, InputIt2 in2, OutputIt out, Functor& transform)
+    : In1(in1)
+    , In2(in2)
+    , Out(out)
+    , Transform(transform)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    InputIt1 itIn1(this->In1);
+    InputIt2 itIn2(this->In2);
+    OutputIt itOut(this->Out);
+    std::advance(itIn1, begin);
+    std::advance(itIn2, begin);
+    std::advance(itOut, begin);
+    for (vtkIdType it = begin; it < end; ++it, ++itIn1, ++itIn2, ++itOut)
+    {
+      *itOut = this->Transform(*itIn1, *itIn2);
+    }
+  }
+};
+
+template <typename Iterator, typename T>
+class vtkSMPTools_FillFunctor
+{
+  Iterator Begin;
+  const T& Value;
+
+public:
+  vtkSMPTools_FillFunctor(Iterator begin, const T& value)
+    : Begin(begin)
+    , Value(value)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    Iterator it(this->Begin);
+    std::advance(it, begin);
+    for (vtkIdType i = begin; i < end; ++i, ++it)
+    {
+      *it = this->Value;
+    }
+  }
+};
+
+// Reduce and the scans split the range into a fixed number of contiguous
+// blocks, so that the order in which the operator is applied only depends on
+// the number of blocks, not on the scheduling of the backend.
+struct vtkSMPTools_Blocks
+{
+  vtkIdType Size;
+  vtkIdType BlockSize;
+  vtkIdType NumberOfBlocks;
+
+  vtkSMPTools_Blocks(vtkIdType size, int numThreads)
+    : Size(size)
+  {
+    // Small ranges are not worth the parallel overhead.
+    const vtkIdType minBlockSize = 1024;
+    vtkIdType numBlocks = (size + minBlockSize - 1) / minBlockSize;
+    if (numBlocks > 4 * numThreads)
+    {
+      numBlocks = 4 * numThreads;
+    }
+    if (numBlocks < 1 || numThreads <= 1)
+    {
+      numBlocks = 1;
+    }
+    this->BlockSize = (size + numBlocks - 1) / numBlocks;
+    this->NumberOfBlocks = this->BlockSize > 0 ? (size + this->BlockSize - 1) / this->BlockSize : 0;
+  }
+
+  vtkIdType GetBegin(vtkIdType block) const { return block * this->BlockSize; }
+  vtkIdType GetEnd(vtkIdType block) const
+  {
+    vtkIdType end = (block + 1) * this->BlockSize;
+    return end < this->Size ? end : this->Size;
+  }
+};
+
+template <typename InputIt, typename T, typename BinaryOp>
+class vtkSMPTools_ReduceBlocks
+{
+  InputIt In;
+  const vtkSMPTools_Blocks& Blocks;
+  std::vector<T>& Results;
+  BinaryOp& Op;
+
+public:
+  vtkSMPTools_ReduceBlocks(
+    InputIt in, const vtkSMPTools_Blocks& blocks, std::vector<T>& results, BinaryOp& op)
+    : In(in)
+    , Blocks(blocks)
+    , Results(results)
+    , Op(op)
+  {
+  }
+
+  void operator()(vtkIdType beginBlock, vtkIdType endBlock)
+  {
+    for (vtkIdType block = beginBlock; block < endBlock; ++block)
+    {
+      const vtkIdType end = this->Blocks.GetEnd(block);
+      vtkIdType i = this->Blocks.GetBegin(block);
+      InputIt itIn(this->In);
+      std::advance(itIn, i);
+      T acc = static_cast<T>(*itIn);
+      for (++i, ++itIn; i < end; ++i, ++itIn)
+      {
+        acc = this->Op(acc, *itIn);
+      }
+      this->Results[block] = acc;
+    }
+  }
+};
+
+// Scans each block starting from the reduction of all the previous blocks.
+// The first block of an inclusive scan has no such offset. Each input value
+// is read before the output value at the same position is written, so the
+// scans can be performed in place.
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp, bool Inclusive>
+class vtkSMPTools_ScanBlocks
+{
+  InputIt In;
+  OutputIt Out;
+  const vtkSMPTools_Blocks& Blocks;
+  const std::vector<T>& Offsets;
+  BinaryOp& Op;
+
+public:
+  vtkSMPTools_ScanBlocks(InputIt in, OutputIt out, const vtkSMPTools_Blocks& blocks,
+    const std::vector<T>& offsets, BinaryOp& op)
+    : In(in)
+    , Out(out)
+    , Blocks(blocks)
+    , Offsets(offsets)
+    , Op(op)
+  {
+  }
+
+  void operator()(vtkIdType beginBlock, vtkIdType endBlock)
+  {
+    for (vtkIdType block = beginBlock; block < endBlock; ++block)
+    {
+      const vtkIdType end = this->Blocks.GetEnd(block);
+      vtkIdType i = this->Blocks.GetBegin(block);
+      InputIt itIn(this->In);
+      OutputIt itOut(this->Out);
+      std::advance(itIn, i);
+      std::advance(itOut, i);
+      T acc = this->Offsets[block];
+      if (Inclusive && block == 0)
+      {
+        acc = static_cast<T>(*itIn);
+        *itOut = acc;
+        ++i, ++itIn, ++itOut;
+      }
+      for (; i < end; ++i, ++itIn, ++itOut)
+      {
+        if (Inclusive)
+        {
+          acc = this->Op(acc, *itIn);
+          *itOut = acc;
+        }
+        else
+        {
+          const T value = static_cast<T>(*itIn);
+          *itOut = acc;
+          acc = this->Op(acc, value);
+        }
+      }
+    }
+  }
+};
 } // namespace smp
 } // namespace detail
 } // namespace vtk
@@ -224,15 +446,25 @@ public:
    */
   static const char* GetBackend();
 
+  /**
+   * Select the backend used by subsequent parallel operations (the name is
+   * case insensitive). Only the STDThread build is able to switch backends;
+   * the other builds only accept their own name. The initial backend of the
+   * STDThread build can also be set with the VTK_SMP_BACKEND_IN_USE
+   * environment variable. The number of threads set with Initialize() is
+   * carried over to the new backend. Returns false, leaving the backend
+   * unchanged, when the requested backend is not available. Must not be
+   * called while a parallel operation is in progress.
+   */
+  static bool SetBackend(const char* backend);
+
   /**
    * Initialize the underlying libraries for execution. This is
    * not required as it is automatically called before the first
    * execution of any parallel code. However, it can be used to
    * control the maximum number of threads used when the back-end
-   * supports it (currently Simple and TBB only). Make sure to call
+   * supports it (currently STDThread, OpenMP and TBB). Make sure to call
    * it before any other parallel operation.
-   * When using Kaapi, use the KAAPI_CPUCOUNT env. variable to control
-   * the number of threads used in the thread pool.
    */
   static void Initialize(int numThreads = 0);
 
@@ -244,6 +476,274 @@ public:
    */
   static int GetEstimatedNumberOfThreads();
 
+  /**
+   * Enable or disable nested parallelism by default. When disabled, a
+   * parallel operation started from within another parallel operation runs
+   * sequentially on the calling thread. When enabled, it runs in parallel,
+   * sharing the threads of the backend with the enclosing operation. Until
+   * this is called, nested parallelism is enabled with the TBB backend, as
+   * TBB always nested its parallel operations, and disabled with the others.
+   * LocalScope() overrides this for the operations it encloses.
+   */
+  static void SetNestedParallelism(bool isNested)
+  {
+    vtk::detail::smp::vtkSMPToolsScope::SetDefaultNestedParallelism(isNested);
+  }
+
+  /**
+   * Get the nested parallelism applying to parallel operations started from
+   * the calling thread, taking the enclosing LocalScope() into account.
+   */
+  static bool GetNestedParallelism()
+  {
+    return vtk::detail::smp::vtkSMPToolsScope::GetNestedParallelism();
+  }
+
+  /**
+   * Returns true when called from within a parallel operation (e.g. from the
+   * functor of a vtkSMPTools::For).
+   */
+  static bool IsParallelScope() { return vtk::detail::smp::vtkSMPToolsScope::IsParallelScope(); }
+
+  /**
+   * Configuration of a LocalScope(). MaxNumberOfThreads caps the number of
+   * threads, the calling one included, used by each parallel operation of
+   * the scope (0 keeps the enclosing limit) and NestedParallelism tells
+   * whether these operations may run parallel operations themselves. By
+   * default a Config keeps the current nested parallelism.
+   */
+  struct Config
+  {
+    int MaxNumberOfThreads;
+    bool NestedParallelism;
+
+    Config()
+      : MaxNumberOfThreads(0)
+      , NestedParallelism(vtkSMPTools::GetNestedParallelism())
+    {
+    }
+
+    Config(int maxNumberOfThreads)
+      : MaxNumberOfThreads(maxNumberOfThreads)
+      , NestedParallelism(vtkSMPTools::GetNestedParallelism())
+    {
+    }
+
+    Config(int maxNumberOfThreads, bool nestedParallelism)
+      : MaxNumberOfThreads(maxNumberOfThreads)
+      , NestedParallelism(nestedParallelism)
+    {
+    }
+  };
+
+  /**
+   * Execute lambda with the given configuration. The configuration applies
+   * to the parallel operations started by lambda on the calling thread,
+   * including the ones started from within these operations, and is restored
+   * when lambda returns. Scopes only affect the calling thread, so several
+   * threads (e.g. the blocks of a vtkThreadedCompositeDataPipeline) can use
+   * different configurations concurrently. It behaves the same on all
+   * backends:
+   * \code
+   * // Run the blocks on at most 8 threads, and let the filters of each
+   * // block use the idle threads.
+   * vtkSMPTools::LocalScope(vtkSMPTools::Config{ 8, true }, [&]() { pipeline->Update(); });
+   * \endcode
+   */
+  template <typename T>
+  static void LocalScope(Config const& config, T&& lambda)
+  {
+    vtk::detail::smp::vtkSMPToolsScope scope(config.MaxNumberOfThreads, config.NestedParallelism);
+    vtk::detail::smp::vtkSMPTools_Impl_LocalScope(config.MaxNumberOfThreads, lambda);
+  }
+
+  /**
+   * A convenience method for transforming data. It is a drop in replacement
+   * for std::transform(): it applies the unary functor to every element of
+   * [inBegin, inEnd) and stores the result at the same position starting at
+   * outBegin. The functor is called concurrently, it must be thread safe.
+   * The iterators must be random access iterators.
+   */
+  template <typename InputIt, typename OutputIt, typename Functor>
+  static void Transform(InputIt inBegin, InputIt inEnd, OutputIt outBegin, Functor transform)
+  {
+    vtk::detail::smp::vtkSMPTools_UnaryTransformCall<InputIt, OutputIt, Functor> call(
+      inBegin, outBegin, transform);
+    vtkSMPTools::For(0, std::distance(inBegin, inEnd), call);
+  }
+
+  /**
+   * A convenience method for transforming data. It is a drop in replacement
+   * for the binary version of std::transform(): the functor is called with
+   * the elements at the same position in [inBegin1, inEnd) and inBegin2.
+   */
+  template <typename InputIt1, typename InputIt2, typename OutputIt, typename Functor>
+  static void Transform(
+    InputIt1 inBegin1, InputIt1 inEnd, InputIt2 inBegin2, OutputIt outBegin, Functor transform)
+  {
+    vtk::detail::smp::vtkSMPTools_BinaryTransformCall<InputIt1, InputIt2, OutputIt, Functor> call(
+      inBegin1, inBegin2, outBegin, transform);
+    vtkSMPTools::For(0, std::distance(inBegin1, inEnd), call);
+  }
+
+  /**
+   * A convenience method for filling data. It is a drop in replacement for
+   * std::fill(), with random access iterators.
+   */
+  template <typename Iterator, typename T>
+  static void Fill(Iterator begin, Iterator end, const T& value)
+  {
+    vtk::detail::smp::vtkSMPTools_FillFunctor<Iterator, T> fill(begin, value);
+    vtkSMPTools::For(0, std::distance(begin, end), fill);
+  }
+
+  /**
+   * A convenience method for reducing data. It is a drop in replacement for
+   * std::reduce(): it returns init combined with all the elements of
+   * [begin, end) by the associative binary operator op. The range is split in
+   * contiguous blocks that are reduced in parallel and then combined in order,
+   * so op does not need to be commutative. Floating point results may differ
+   * from a sequential accumulation by round-off since the operations are
+   * grouped differently.
+   */
+  template <typename Iterator, typename T, typename BinaryOp>
+  static T Reduce(Iterator begin, Iterator end, T init, BinaryOp op)
+  {
+    const vtk::detail::smp::vtkSMPTools_Blocks blocks(
+      std::distance(begin, end), vtkSMPTools::GetEstimatedNumberOfThreads());
+    std::vector<T> results(static_cast<size_t>(blocks.NumberOfBlocks), init);
+    vtk::detail::smp::vtkSMPTools_ReduceBlocks<Iterator, T, BinaryOp> reduce(
+      begin, blocks, results, op);
+    vtkSMPTools::For(0, blocks.NumberOfBlocks, 1, reduce);
+    for (const T& value : results)
+    {
+      init = op(init, value);
+    }
+    return init;
+  }
+
+  /**
+   * Sum the elements of [begin, end) to init, see the Reduce() overload above.
+   */
+  template <typename Iterator, typename T>
+  static T Reduce(Iterator begin, Iterator end, T init)
+  {
+    return vtkSMPTools::Reduce(begin, end, init, std::plus<T>());
+  }
+
+  /**
+   * A convenience method computing a prefix sum. It is a drop in replacement
+   * for std::inclusive_scan(): the i-th output is the combination by the
+   * associative operator op of the first i+1 inputs. The scan may be
+   * performed in place (outBegin == begin). The scan is computed in two
+   * parallel passes over the data: block reductions, then block scans.
+   * Returns the iterator past the last element written.
+   */
+  template <typename InputIt, typename OutputIt, typename BinaryOp>
+  static OutputIt InclusiveScan(InputIt begin, InputIt end, OutputIt outBegin, BinaryOp op)
+  {
+    using T = typename std::iterator_traits<InputIt>::value_type;
+    const vtkIdType size = std::distance(begin, end);
+    if (size > 0)
+    {
+      const vtk::detail::smp::vtkSMPTools_Blocks blocks(
+        size, vtkSMPTools::GetEstimatedNumberOfThreads());
+      std::vector<T> offsets(static_cast<size_t>(blocks.NumberOfBlocks), *begin);
+      if (blocks.NumberOfBlocks > 1)
+      {
+        vtk::detail::smp::vtkSMPTools_ReduceBlocks<InputIt, T, BinaryOp> reduce(
+          begin, blocks, offsets, op);
+        vtkSMPTools::For(0, blocks.NumberOfBlocks, 1, reduce);
+        // offsets[b] becomes the reduction of blocks [0, b).
+        for (vtkIdType block = blocks.NumberOfBlocks - 1; block > 1; --block)
+        {
+          offsets[block] = offsets[block - 1];
+        }
+        offsets[1] = offsets[0];
+        for (vtkIdType block = 2; block < blocks.NumberOfBlocks; ++block)
+        {
+          offsets[block] = op(offsets[block - 1], offsets[block]);
+        }
+      }
+      vtk::detail::smp::vtkSMPTools_ScanBlocks<InputIt, OutputIt, T, BinaryOp, true> scan(
+        begin, outBegin, blocks, offsets, op);
+      vtkSMPTools::For(0, blocks.NumberOfBlocks, 1, scan);
+    }
+    std::advance(outBegin, size);
+    return outBegin;
+  }
+
+  /**
+   * Prefix sum of [begin, end), see the InclusiveScan() overload above.
+   */
+  template <typename InputIt, typename OutputIt>
+  static OutputIt InclusiveScan(InputIt begin, InputIt end, OutputIt outBegin)
+  {
+    using T = typename std::iterator_traits<InputIt>::value_type;
+    return vtkSMPTools::InclusiveScan(begin, end, outBegin, std::plus<T>());
+  }
+
+  /**
+   * A convenience method computing an exclusive prefix sum. It behaves as
+   * std::exclusive_scan(): the i-th output is init combined by the
+   * associative operator op with the first i inputs. The scan may be
+   * performed in place (outBegin == begin). Unlike std::exclusive_scan() the
+   * reduction of init with all the inputs is returned, which is the total
+   * size when converting counts to offsets:
+   * \code
+   * vtkIdType size = vtkSMPTools::ExclusiveScan(counts, counts + n, offsets, vtkIdType(0));
+   * \endcode
+   */
+  template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  static T ExclusiveScan(InputIt begin, InputIt end, OutputIt outBegin, T init, BinaryOp op)
+  {
+    const vtkIdType size = std::distance(begin, end);
+    if (size <= 0)
+    {
+      return init;
+    }
+
+    const vtk::detail::smp::vtkSMPTools_Blocks blocks(
+      size, vtkSMPTools::GetEstimatedNumberOfThreads());
+    if (blocks.NumberOfBlocks == 1)
+    {
+      for (vtkIdType i = 0; i < size; ++i, ++begin, ++outBegin)
+      {
+        const T value = static_cast<T>(*begin);
+        *outBegin = init;
+        init = op(init, value);
+      }
+      return init;
+    }
+
+    std::vector<T> offsets(static_cast<size_t>(blocks.NumberOfBlocks), init);
+    vtk::detail::smp::vtkSMPTools_ReduceBlocks<InputIt, T, BinaryOp> reduce(
+      begin, blocks, offsets, op);
+    vtkSMPTools::For(0, blocks.NumberOfBlocks, 1, reduce);
+    // offsets[b] becomes init combined with the reduction of blocks [0, b).
+    T total = init;
+    for (T& offset : offsets)
+    {
+      const T blockValue = offset;
+      offset = total;
+      total = op(total, blockValue);
+    }
+    vtk::detail::smp::vtkSMPTools_ScanBlocks<InputIt, OutputIt, T, BinaryOp, false> scan(
+      begin, outBegin, blocks, offsets, op);
+    vtkSMPTools::For(0, blocks.NumberOfBlocks, 1, scan);
+    return total;
+  }
+
+  /**
+   * Exclusive prefix sum of [begin, end) starting at init, see the
+   * ExclusiveScan() overload above.
+   */
+  template <typename InputIt, typename OutputIt, typename T>
+  static T ExclusiveScan(InputIt begin, InputIt end, OutputIt outBegin, T init)
+  {
+    return vtkSMPTools::ExclusiveScan(begin, end, outBegin, init, std::plus<T>());
+  }
+
   /**
    * A convenience method for sorting data. It is a drop in replacement for
    * std::sort(). Under the hood different methods are used. For example,
@@ -0,0 +1,130 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsAPI.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkSMPToolsAPI.h"
+
+#include "vtkSMP.h"
+#include "vtkSMPTools.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <atomic>
+
+namespace
+{
+using namespace vtk::detail::smp;
+
+const char* const vtkSMPBackendNames[NUMBER_OF_BACKENDS] = { "Sequential", "STDThread",
+  "OpenMP", "TBB" };
+
+//--------------------------------------------------------------------------------
+// Returns the backend matching name (case insensitive), -1 if unknown.
+int FindBackend(const char* name)
+{
+  for (int i = 0; name && i < NUMBER_OF_BACKENDS; ++i)
+  {
+    if (vtksys::SystemTools::Strucmp(name, vtkSMPBackendNames[i]) == 0)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+//--------------------------------------------------------------------------------
+// The STDThread implementation dispatches to the backends enabled at build
+// time, the other implementations only run their own backend.
+bool IsBackendAvailable(int backend)
+{
+#ifdef VTK_SMP_STDThread
+  switch (backend)
+  {
+    case SEQUENTIAL:
+    case STDTHREAD:
+      return true;
+#ifdef VTK_SMP_ENABLE_OPENMP
+    case OPENMP:
+      return true;
+#endif
+#ifdef VTK_SMP_ENABLE_TBB
+    case TBB:
+      return true;
+#endif
+    default:
+      return false;
+  }
+#else
+  return backend >= 0 && backend == FindBackend(VTK_SMP_BACKEND);
+#endif
+}
+
+//--------------------------------------------------------------------------------
+int GetInitialBackend()
+{
+  const int defaultBackend = FindBackend(VTK_SMP_BACKEND);
+#ifdef VTK_SMP_STDThread
+  const char* name = vtksys::SystemTools::GetEnv("VTK_SMP_BACKEND_IN_USE");
+  if (name && *name)
+  {
+    int backend = FindBackend(name);
+    if (IsBackendAvailable(backend))
+    {
+      return backend;
+    }
+    vtkGenericWarningMacro("VTK_SMP_BACKEND_IN_USE is set to the unavailable backend \""
+      << name << "\". Using " << vtkSMPBackendNames[defaultBackend] << " instead.");
+  }
+#endif
+  return defaultBackend;
+}
+
+//--------------------------------------------------------------------------------
+std::atomic<int>& GetBackendInUseReference()
+{
+  static std::atomic<int> backend{ GetInitialBackend() };
+  return backend;
+}
+}
+
+//--------------------------------------------------------------------------------
+int vtk::detail::smp::GetBackendInUse()
+{
+  return GetBackendInUseReference().load();
+}
+
+//--------------------------------------------------------------------------------
+const char* vtkSMPTools::GetBackend()
+{
+  return vtkSMPBackendNames[GetBackendInUse()];
+}
+
+//--------------------------------------------------------------------------------
+bool vtkSMPTools::SetBackend(const char* backend)
+{
+  int type = FindBackend(backend);
+  if (!IsBackendAvailable(type))
+  {
+    vtkGenericWarningMacro("SMP backend \"" << (backend ? backend : "(null)")
+                                            << "\" is not available in this build.");
+    return false;
+  }
+#ifdef VTK_SMP_STDThread
+  if (GetBackendInUseReference().exchange(type) != type)
+  {
+    vtk::detail::smp::InitializeBackendInUse();
+  }
+#endif
+  return true;
+}
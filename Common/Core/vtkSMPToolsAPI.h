@@ -0,0 +1,52 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsAPI.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Private header shared by the vtkSMPTools implementations. It holds the
+// backend selection behind vtkSMPTools::GetBackend() and SetBackend(), which
+// is common to all the implementations: only the STDThread implementation
+// has more than one backend available.
+
+#ifndef vtkSMPToolsAPI_h
+#define vtkSMPToolsAPI_h
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+enum vtkSMPBackendType
+{
+  SEQUENTIAL = 0,
+  STDTHREAD,
+  OPENMP,
+  TBB,
+  NUMBER_OF_BACKENDS
+};
+
+// Returns the backend in use, a vtkSMPBackendType.
+int GetBackendInUse();
+
+// Applies the last vtkSMPTools::Initialize() request to the backend in use.
+// Called by vtkSMPTools::SetBackend() when the backend changes, it is only
+// defined by the STDThread implementation.
+void InitializeBackendInUse();
+
+}
+}
+}
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPToolsAPI.h
@@ -0,0 +1,115 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsScope.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkSMPToolsScope.h"
+
+#include "vtkSMPToolsAPI.h"
+
+#include <atomic>
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+namespace
+{
+thread_local vtkSMPToolsScopeState vtkSMPCurrentState = { 0, -1 };
+thread_local int vtkSMPParallelDepth = 0;
+// -1 until vtkSMPTools::SetNestedParallelism() is called, the backend in use
+// then decides.
+std::atomic<int> vtkSMPDefaultNestedParallelism(-1);
+}
+
+//--------------------------------------------------------------------------------
+vtkSMPToolsScope::vtkSMPToolsScope(int maxNumberOfThreads, bool nestedParallelism)
+  : Previous(vtkSMPCurrentState)
+{
+  if (maxNumberOfThreads > 0)
+  {
+    vtkSMPCurrentState.MaxNumberOfThreads = maxNumberOfThreads;
+  }
+  vtkSMPCurrentState.NestedParallelism = nestedParallelism ? 1 : 0;
+}
+
+//--------------------------------------------------------------------------------
+vtkSMPToolsScope::~vtkSMPToolsScope()
+{
+  vtkSMPCurrentState = this->Previous;
+}
+
+//--------------------------------------------------------------------------------
+vtkSMPToolsScopeState vtkSMPToolsScope::GetState()
+{
+  return vtkSMPCurrentState;
+}
+
+//--------------------------------------------------------------------------------
+int vtkSMPToolsScope::GetMaxNumberOfThreads()
+{
+  return vtkSMPCurrentState.MaxNumberOfThreads;
+}
+
+//--------------------------------------------------------------------------------
+bool vtkSMPToolsScope::GetNestedParallelism()
+{
+  if (vtkSMPCurrentState.NestedParallelism < 0)
+  {
+    return vtkSMPToolsScope::GetDefaultNestedParallelism();
+  }
+  return vtkSMPCurrentState.NestedParallelism != 0;
+}
+
+//--------------------------------------------------------------------------------
+bool vtkSMPToolsScope::IsParallelScope()
+{
+  return vtkSMPParallelDepth > 0;
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPToolsScope::SetDefaultNestedParallelism(bool isNested)
+{
+  vtkSMPDefaultNestedParallelism = isNested ? 1 : 0;
+}
+
+//--------------------------------------------------------------------------------
+bool vtkSMPToolsScope::GetDefaultNestedParallelism()
+{
+  const int isNested = vtkSMPDefaultNestedParallelism;
+  // TBB composes nested parallel operations by itself, the other backends
+  // run them on the calling thread.
+  return isNested < 0 ? GetBackendInUse() == TBB : isNested != 0;
+}
+
+//--------------------------------------------------------------------------------
+vtkSMPToolsTaskScope::vtkSMPToolsTaskScope(const vtkSMPToolsScopeState& state)
+  : Previous(vtkSMPCurrentState)
+{
+  vtkSMPCurrentState = state;
+  ++vtkSMPParallelDepth;
+}
+
+//--------------------------------------------------------------------------------
+vtkSMPToolsTaskScope::~vtkSMPToolsTaskScope()
+{
+  --vtkSMPParallelDepth;
+  vtkSMPCurrentState = this->Previous;
+}
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
@@ -0,0 +1,99 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsScope.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Per thread state of vtkSMPTools::LocalScope(), shared by all the SMP
+// backends. A scope caps the number of threads used by the parallel
+// operations started from the calling thread and decides whether these
+// operations may themselves run parallel operations (nested parallelism).
+//
+// The state of the thread starting a parallel operation is carried over to
+// the threads executing its chunks (see vtkSMPToolsTaskScope), so that a
+// filter running inside a parallel operation follows the enclosing scope.
+
+#ifndef vtkSMPToolsScope_h
+#define vtkSMPToolsScope_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+
+#ifndef __VTK_WRAP__
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+struct vtkSMPToolsScopeState
+{
+  // Maximum number of threads, <= 0 means no limit.
+  int MaxNumberOfThreads;
+  // 0 or 1, or -1 to follow vtkSMPTools::SetNestedParallelism().
+  int NestedParallelism;
+};
+
+class VTKCOMMONCORE_EXPORT vtkSMPToolsScope
+{
+public:
+  /**
+   * Push a scope on the calling thread. A maxNumberOfThreads <= 0 keeps
+   * the limit of the enclosing scope.
+   */
+  vtkSMPToolsScope(int maxNumberOfThreads, bool nestedParallelism);
+  ~vtkSMPToolsScope();
+
+  /**
+   * State of the calling thread.
+   */
+  static vtkSMPToolsScopeState GetState();
+  static int GetMaxNumberOfThreads();
+  static bool GetNestedParallelism();
+  static bool IsParallelScope();
+
+  /**
+   * Process wide default of the nested parallelism. Until it is set, it is
+   * on for the TBB backend and off for the others.
+   */
+  static void SetDefaultNestedParallelism(bool isNested);
+  static bool GetDefaultNestedParallelism();
+
+private:
+  vtkSMPToolsScope(const vtkSMPToolsScope&) = delete;
+  void operator=(const vtkSMPToolsScope&) = delete;
+
+  vtkSMPToolsScopeState Previous;
+};
+
+// Marks the calling thread as executing a chunk of a parallel operation
+// started by a thread whose scope state was state.
+class VTKCOMMONCORE_EXPORT vtkSMPToolsTaskScope
+{
+public:
+  explicit vtkSMPToolsTaskScope(const vtkSMPToolsScopeState& state);
+  ~vtkSMPToolsTaskScope();
+
+private:
+  vtkSMPToolsTaskScope(const vtkSMPToolsTaskScope&) = delete;
+  void operator=(const vtkSMPToolsTaskScope&) = delete;
+
+  vtkSMPToolsScopeState Previous;
+};
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+#endif // __VTK_WRAP__
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPToolsScope.h
@@ -81,26 +81,34 @@ int TestFindCellsAlongLine()
   // generated above reproduces the bug
   double p1[] = { 0.897227, 0.0973691, 0.0389687 };
   double p2[] = { 0.342117, 0.492077, 0.423446 };
+  // The query is repeated to check that the cells visited by the first one
+  // are not skipped by the next ones.
   vtkSmartPointer<vtkIdList> cellIds = vtkSmartPointer<vtkIdList>::New();
-  cellLocator->FindCellsAlongLine(p1, p2, 0.0, cellIds);
-
-  if (cellIds->GetNumberOfIds() != 4)
+  for (int query = 0; query < 2; query++)
   {
-    vtkGenericWarningMacro("Wrong amount of intersected Ids " << cellIds->GetNumberOfIds());
-    return 0;
-  }
+    cellIds->Reset();
+    cellLocator->FindCellsAlongLine(p1, p2, 0.0, cellIds);
+
+    if (cellIds->GetNumberOfIds() != 4)
+    {
+      vtkGenericWarningMacro("Wrong amount of intersected Ids " << cellIds->GetNumberOfIds()
+                                                                 << " in query " << query);
+      return 0;
+    }
 
-  // these ids are the ones that should be in the list.
-  // if we uniquely add them the list size should still be 4.
-  cellIds->InsertUniqueId(657);
-  cellIds->InsertUniqueId(856);
-  cellIds->InsertUniqueId(1885);
-  cellIds->InsertUniqueId(1887);
+    // these ids are the ones that should be in the list.
+    // if we uniquely add them the list size should still be 4.
+    cellIds->InsertUniqueId(657);
+    cellIds->InsertUniqueId(856);
+    cellIds->InsertUniqueId(1885);
+    cellIds->InsertUniqueId(1887);
 
-  if (cellIds->GetNumberOfIds() != 4)
-  {
-    vtkGenericWarningMacro("Wrong cell Ids in the list " << cellIds->GetNumberOfIds());
-    return 0;
+    if (cellIds->GetNumberOfIds() != 4)
+    {
+      vtkGenericWarningMacro(
+        "Wrong cell Ids in the list " << cellIds->GetNumberOfIds() << " in query " << query);
+      return 0;
+    }
   }
 
   return 1;
@@ -12,6 +12,7 @@
      PURPOSE.  See the above copyright notice for more information.
 
 =========================================================================*/
+#include "vtkCellArray.h"
 #include "vtkExtractGeometry.h"
 #include "vtkImageData.h"
 #include "vtkPolyData.h"
@@ -23,6 +24,8 @@
 #include "vtkTimerLog.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+
 // Test the building of static cell links in both unstructured and structured
 // grids.
 int TestStaticCellLinks(int, char*[])
@@ -194,5 +197,23 @@ int TestStaticCellLinks(int, char*[])
     return EXIT_FAILURE;
   }
 
+  // Add a vertex at the pole: it comes first, before the polygons
+  vtkSmartPointer<vtkCellArray> verts = vtkSmartPointer<vtkCellArray>::New();
+  vtkIdType pole = 0;
+  verts->InsertNextCell(1, &pole);
+  pdata->SetVerts(verts);
+
+  slinks.Initialize(); // reuse
+  slinks.BuildLinks(pdata);
+
+  numCells = slinks.GetNumberOfCells(0);
+  cells = slinks.GetCells(0);
+  cout << "   Pole with vertex: (numCells, first cell): " << numCells << " (" << cells[0] << ")\n";
+  if (numCells != 13 || *std::min_element(cells, cells + numCells) != 0 ||
+    slinks.GetNumberOfCells(5) != 6)
+  {
+    return EXIT_FAILURE;
+  }
+
   return EXIT_SUCCESS;
 }
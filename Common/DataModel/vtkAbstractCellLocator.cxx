@@ -22,6 +22,7 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 vtkAbstractCellLocator::vtkAbstractCellLocator()
@@ -51,10 +52,21 @@ bool vtkAbstractCellLocator::StoreCellBounds()
   // Allocate space for cell bounds storage, then fill
   vtkIdType numCells = this->DataSet->GetNumberOfCells();
   this->CellBounds = new double[numCells][6];
-  for (vtkIdType j = 0; j < numCells; j++)
+  if (numCells < 1)
   {
-    this->DataSet->GetCellBounds(j, CellBounds[j]);
+    return true;
   }
+  // The first call performs the non-thread safe initialization of the
+  // dataset (e.g. building the cells of polydata), the others are threaded.
+  vtkDataSet* dataSet = this->DataSet;
+  double(*cellBounds)[6] = this->CellBounds;
+  dataSet->GetCellBounds(0, cellBounds[0]);
+  vtkSMPTools::For(1, numCells, [dataSet, cellBounds](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      dataSet->GetCellBounds(cellId, cellBounds[cellId]);
+    }
+  });
   return true;
 }
 //----------------------------------------------------------------------------
@@ -29,6 +29,15 @@
  *  using vtkAbstractCellLocator::FindClosestPointWithinRadius;
  * \endverbatim
  *
+ * @warning
+ * Once the locator is built, the FindCell() and IntersectWithLine() methods
+ * which take a vtkGenericCell may be called concurrently on the same locator
+ * by subclasses that only use the supplied cell as scratch space (for
+ * instance vtkCellLocator, vtkCellTreeLocator, vtkModifiedBSPTree and
+ * vtkStaticCellLocator). Each thread must pass its own cell, and the locator
+ * must be built beforehand (e.g. with BuildLocator() and LazyEvaluation off)
+ * so that no query rebuilds it. The signatures without a vtkGenericCell use
+ * an internal cell and are not thread safe.
  *
  * @sa
  * vtkLocator vtkPointLocator vtkOBBTree vtkCellLocator
@@ -128,7 +137,8 @@ public:
   /**
    * Return intersection point (if any) AND the cell which was intersected by
    * the finite line. The cell is returned as a cell id and as a generic
-   * cell.
+   * cell. See the class documentation about calling this method from
+   * several threads.
    */
   virtual int IntersectWithLine(const double p1[3], const double p2[3], double tol, double& t,
     double x[3], double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell);
@@ -243,7 +253,8 @@ public:
   /**
    * Find the cell containing a given point. returns -1 if no cell found
    * the cell parameters are copied into the supplied variables, a cell must
-   * be provided to store the information.
+   * be provided to store the information. See the class documentation about
+   * calling this method from several threads.
    */
   virtual vtkIdType FindCell(
     double x[3], double tol2, vtkGenericCell* GenCell, double pcoords[3], double* weights);
@@ -265,7 +276,8 @@ protected:
    * all cell Bounds into the internal CellBounds array. Subsequent
    * calls to InsideCellBounds(...) can make use of the data
    * A valid dataset must be present for this to work. Returns true
-   * if bounds wre copied, false otherwise.
+   * if bounds wre copied, false otherwise. The bounds are computed in
+   * parallel.
    */
   virtual bool StoreCellBounds();
   virtual void FreeCellBounds();
@@ -240,6 +240,12 @@ struct ArrayList
   void ExcludeArray(vtkDataArray* da);
   vtkTypeBool IsExcluded(vtkDataArray* da);
 
+  // Whether all the arrays of the attributes are processed by AddArrays(),
+  // so that the attributes can be copied from several threads with an
+  // ArrayList instead of vtkDataSetAttributes: the arrays must be named,
+  // uniquely, data arrays of standard memory layout that are not bit arrays.
+  static bool CanCopyInParallel(vtkDataSetAttributes* attributes);
+
   // Loop over the array pairs and copy data from one to another
   void Copy(vtkIdType inId, vtkIdType outId)
   {
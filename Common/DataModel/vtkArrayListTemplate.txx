@@ -16,6 +16,8 @@
 #include "vtkFloatArray.h"
 
 #include <cassert>
+#include <set>
+#include <string>
 
 #ifndef vtkArrayListTemplate_txx
 #define vtkArrayListTemplate_txx
@@ -55,6 +57,23 @@ inline vtkTypeBool ArrayList::IsExcluded(vtkDataArray* da)
   return (std::find(ExcludedArrays.begin(), ExcludedArrays.end(), da) != ExcludedArrays.end());
 }
 
+//----------------------------------------------------------------------------
+// Can all the arrays be processed, and so copied by threads?
+inline bool ArrayList::CanCopyInParallel(vtkDataSetAttributes* attributes)
+{
+  std::set<std::string> names;
+  for (int i = 0; i < attributes->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array = vtkArrayDownCast<vtkDataArray>(attributes->GetAbstractArray(i));
+    if (!array || !array->HasStandardMemoryLayout() || array->GetDataType() == VTK_BIT ||
+      !array->GetName() || !names.insert(array->GetName()).second)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 //----------------------------------------------------------------------------
 // Add an array pair (input,output) using the name provided for the output. The
 // numTuples is the number of output tuples allocated.
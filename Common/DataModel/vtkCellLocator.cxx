@@ -20,8 +20,13 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <unordered_set>
+#include <vector>
 
 vtkStandardNewMacro(vtkCellLocator);
 
@@ -146,17 +151,22 @@ void vtkCellLocator::ComputeOctantBounds(int i, int j, int k)
   this->OctantBounds[5] = this->OctantBounds[4] + H[2];
 }
 
+//----------------------------------------------------------------------------
+static bool vtkCellLocator_InsideOctant(
+  const double octantBounds[6], const double x[3], double tol)
+{
+  return octantBounds[0] - tol <= x[0] && x[0] <= octantBounds[1] + tol &&
+    octantBounds[2] - tol <= x[1] && x[1] <= octantBounds[3] + tol &&
+    octantBounds[4] - tol <= x[2] && x[2] <= octantBounds[5] + tol;
+}
+
 //----------------------------------------------------------------------------
 // Return intersection point (if any) AND the cell which was intersected by
 // finite line.
 //
-// NOTE: This method is not thread safe (i.e., when invoking this method on
-// the same instance of vtkCellLocator). This is the due to the use of the
-// data members QueryNumber and CellHasBeenVisited. These should be pulled
-// out of the class and made local to the appropriate methods that use
-// them. Since there may be a performance cost and possible effects on
-// output, this will be done TODO when more time is available. To see an
-// alternative implementation, see vtkStaticCellLocator which is thread safe.
+// NOTE: This method is thread safe once the locator is built: the cells
+// already visited along the line and the bounds of the current octant are
+// local to the query, and the supplied cell is the only scratch cell used.
 //
 int vtkCellLocator::IntersectWithLine(const double a0[3], const double a1[3], double tol, double& t,
   double x[3], double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell)
@@ -223,15 +233,11 @@ int vtkCellLocator::IntersectWithLine(const double a0[3], const double a1[3], do
     leafStart = this->NumberOfOctants - this->NumberOfDivisions * prod;
     bestCellId = -1;
 
-    // Clear the array that indicates whether we have visited this cell.
-    // The array is only cleared when the query number rolls over.  This
-    // saves a number of calls to memset.
-    this->QueryNumber++;
-    if (this->QueryNumber == 0)
-    {
-      this->ClearCellHasBeenVisited();
-      this->QueryNumber++; // can't use 0 as a marker
-    }
+    // The cells which have been visited along the line. Only a small
+    // fraction of the cells is visited, so a set local to the query is used
+    // instead of a flag per cell stored in the locator.
+    std::unordered_set<vtkIdType> cellHasBeenVisited;
+    double octantBounds[6];
 
     // set up curr and stop dist
     currDist = 0;
@@ -262,14 +268,17 @@ int vtkCellLocator::IntersectWithLine(const double a0[3], const double a1[3], do
     {
       if (this->Tree[idx])
       {
-        this->ComputeOctantBounds(pos[0] - 1, pos[1] - 1, pos[2] - 1);
+        for (i = 0; i < 3; i++)
+        {
+          octantBounds[2 * i] = this->Bounds[2 * i] + (pos[i] - 1) * this->H[i];
+          octantBounds[2 * i + 1] = octantBounds[2 * i] + this->H[i];
+        }
         for (tMax = VTK_DOUBLE_MAX, cellId = 0; cellId < this->Tree[idx]->GetNumberOfIds();
              cellId++)
         {
           cId = this->Tree[idx]->GetId(cellId);
-          if (this->CellHasBeenVisited[cId] != this->QueryNumber)
+          if (cellHasBeenVisited.insert(cId).second)
           {
-            this->CellHasBeenVisited[cId] = this->QueryNumber;
             int hitCellBounds = 0;
 
             // check whether we intersect the cell bounds
@@ -292,9 +301,9 @@ int vtkCellLocator::IntersectWithLine(const double a0[3], const double a1[3], do
               this->DataSet->GetCell(cId, cell);
               if (cell->IntersectWithLine(a0, a1, tol, t, x, pcoords, subId))
               {
-                if (!this->IsInOctantBounds(x, tol))
+                if (!vtkCellLocator_InsideOctant(octantBounds, x, tol))
                 {
-                  this->CellHasBeenVisited[cId] = 0; // mark the cell non-visited
+                  cellHasBeenVisited.erase(cId); // mark the cell non-visited
                 }
                 else
                 {
@@ -311,7 +320,7 @@ int vtkCellLocator::IntersectWithLine(const double a0[3], const double a1[3], do
                 }   // if within current parametric range
               }     // if intersection
             }       // if (hitCellBounds)
-          }         // if (!this->CellHasBeenVisited[cId])
+          }         // if (cId has not been visited)
         }
       }
 
@@ -1189,11 +1198,10 @@ void vtkCellLocator::ForceBuildLocator()
 //
 void vtkCellLocator::BuildLocatorInternal()
 {
-  double length, cellBounds[6], *boundsPtr;
+  double length, cellBounds[6];
   vtkIdType numCells;
   int ndivs, product;
-  int i, j, k, ijkMin[3], ijkMax[3];
-  vtkIdType cellId, idx;
+  int i, j, k;
   int parentOffset;
   vtkIdList* octant;
   int numCellsPerBucket = this->NumberOfCellsPerNode;
@@ -1273,61 +1281,126 @@ void vtkCellLocator::BuildLocatorInternal()
   }
 
   //  Insert each cell into the appropriate octant.  Make sure cell
-  //  falls within octant.
+  //  falls within octant. The cells are first counted per leaf octant, then
+  //  inserted in parallel and finally sorted, so that each octant lists its
+  //  cells in increasing order as a sequential insertion would.
   //
   parentOffset = numOctants - (ndivs * ndivs * ndivs);
   product = ndivs * ndivs;
-  boundsPtr = cellBounds;
-  for (cellId = 0; cellId < numCells; cellId++)
+  const vtkIdType numLeaves = static_cast<vtkIdType>(product) * ndivs;
+  if (!this->CellBounds)
   {
+    // Non-thread safe initialization of the dataset, if any.
+    this->DataSet->GetCellBounds(0, cellBounds);
+  }
+
+  // find min/max locations of the bounding box of a cell
+  auto findLeafRange = [this, ndivs, &hTol](vtkIdType id, int minIjk[3], int maxIjk[3]) {
+    double localBounds[6];
+    const double* cellBoundsPtr = localBounds;
     if (this->CellBounds)
     {
-      boundsPtr = this->CellBounds[cellId];
+      cellBoundsPtr = this->CellBounds[id];
     }
     else
     {
-      this->DataSet->GetCellBounds(cellId, cellBounds);
+      this->DataSet->GetCellBounds(id, localBounds);
     }
-
-    // find min/max locations of bounding box
-    for (i = 0; i < 3; i++)
+    for (int ii = 0; ii < 3; ii++)
     {
-      ijkMin[i] = static_cast<int>((boundsPtr[2 * i] - this->Bounds[2 * i] - hTol[i]) / this->H[i]);
-      ijkMax[i] =
-        static_cast<int>((boundsPtr[2 * i + 1] - this->Bounds[2 * i] + hTol[i]) / this->H[i]);
+      minIjk[ii] = static_cast<int>(
+        (cellBoundsPtr[2 * ii] - this->Bounds[2 * ii] - hTol[ii]) / this->H[ii]);
+      maxIjk[ii] = static_cast<int>(
+        (cellBoundsPtr[2 * ii + 1] - this->Bounds[2 * ii] + hTol[ii]) / this->H[ii]);
 
-      if (ijkMin[i] < 0)
+      if (minIjk[ii] < 0)
       {
-        ijkMin[i] = 0;
+        minIjk[ii] = 0;
       }
-      if (ijkMax[i] >= ndivs)
+      if (maxIjk[ii] >= ndivs)
       {
-        ijkMax[i] = ndivs - 1;
+        maxIjk[ii] = ndivs - 1;
       }
     }
+  };
 
-    // each octant between min/max point may have cell in it
-    for (k = ijkMin[2]; k <= ijkMax[2]; k++)
+  // each octant between min/max point may have cell in it
+  std::vector<std::atomic<vtkIdType>> leafSizes(numLeaves);
+  vtkSMPTools::For(0, numLeaves, [&](vtkIdType leaf, vtkIdType endLeaf) {
+    for (; leaf < endLeaf; ++leaf)
+    {
+      leafSizes[leaf].store(0, std::memory_order_relaxed);
+    }
+  });
+  vtkSMPTools::For(0, numCells, [&](vtkIdType id, vtkIdType endId) {
+    int minIjk[3], maxIjk[3];
+    for (; id < endId; ++id)
     {
-      for (j = ijkMin[1]; j <= ijkMax[1]; j++)
+      findLeafRange(id, minIjk, maxIjk);
+      for (int kk = minIjk[2]; kk <= maxIjk[2]; kk++)
       {
-        for (i = ijkMin[0]; i <= ijkMax[0]; i++)
+        for (int jj = minIjk[1]; jj <= maxIjk[1]; jj++)
+        {
+          for (int ii = minIjk[0]; ii <= maxIjk[0]; ii++)
+          {
+            leafSizes[ii + jj * ndivs + kk * product].fetch_add(1, std::memory_order_relaxed);
+          }
+        }
+      }
+    }
+  });
+
+  // Allocate the non-empty octants and mark their parents. The sizes are
+  // then reused as insertion positions.
+  for (k = 0; k < ndivs; k++)
+  {
+    for (j = 0; j < ndivs; j++)
+    {
+      for (i = 0; i < ndivs; i++)
+      {
+        const vtkIdType leaf = i + j * ndivs + k * product;
+        const vtkIdType size = leafSizes[leaf].load(std::memory_order_relaxed);
+        if (size > 0)
         {
-          idx = parentOffset + i + j * ndivs + k * product;
           this->MarkParents(reinterpret_cast<void*>(VTK_CELL_INSIDE), i, j, k, ndivs, this->Level);
-          octant = this->Tree[idx];
-          if (!octant)
+          octant = vtkIdList::New();
+          octant->SetNumberOfIds(size);
+          this->Tree[parentOffset + leaf] = octant;
+          leafSizes[leaf].store(0, std::memory_order_relaxed);
+        }
+      }
+    }
+  }
+
+  vtkSMPTools::For(0, numCells, [&](vtkIdType id, vtkIdType endId) {
+    int minIjk[3], maxIjk[3];
+    for (; id < endId; ++id)
+    {
+      findLeafRange(id, minIjk, maxIjk);
+      for (int kk = minIjk[2]; kk <= maxIjk[2]; kk++)
+      {
+        for (int jj = minIjk[1]; jj <= maxIjk[1]; jj++)
+        {
+          for (int ii = minIjk[0]; ii <= maxIjk[0]; ii++)
           {
-            octant = vtkIdList::New();
-            octant->Allocate(numCellsPerBucket, numCellsPerBucket / 2);
-            this->Tree[idx] = octant;
+            const vtkIdType leaf = ii + jj * ndivs + kk * product;
+            this->Tree[parentOffset + leaf]->SetId(
+              leafSizes[leaf].fetch_add(1, std::memory_order_relaxed), id);
           }
-          octant->InsertNextId(cellId);
         }
       }
     }
+  });
 
-  } // for all cells
+  vtkSMPTools::For(0, numLeaves, [&](vtkIdType leaf, vtkIdType endLeaf) {
+    for (; leaf < endLeaf; ++leaf)
+    {
+      if (vtkIdList* leafCells = this->Tree[parentOffset + leaf])
+      {
+        std::sort(leafCells->GetPointer(0), leafCells->GetPointer(0) + leafCells->GetNumberOfIds());
+      }
+    }
+  });
 
   this->BuildTime.Modified();
 }
@@ -1860,15 +1933,10 @@ void vtkCellLocator::FindCellsAlongLine(
     prod = this->NumberOfDivisions * this->NumberOfDivisions;
     leafStart = this->NumberOfOctants - this->NumberOfDivisions * prod;
 
-    // Clear the array that indicates whether we have visited this cell.
-    // The array is only cleared when the query number rolls over.  This
-    // saves a number of calls to memset.
-    this->QueryNumber++;
-    if (this->QueryNumber == 0)
-    {
-      this->ClearCellHasBeenVisited();
-      this->QueryNumber++; // can't use 0 as a marker
-    }
+    // The cells which have been visited along the line. Only a small
+    // fraction of the cells is visited, so a set local to the query is used
+    // instead of a flag per cell stored in the locator.
+    std::unordered_set<vtkIdType> cellHasBeenVisited;
 
     // set up curr and stop dist
     currDist = 0;
@@ -1899,13 +1967,11 @@ void vtkCellLocator::FindCellsAlongLine(
     {
       if (this->Tree[idx])
       {
-        this->ComputeOctantBounds(pos[0] - 1, pos[1] - 1, pos[2] - 1);
         for (cellId = 0; cellId < this->Tree[idx]->GetNumberOfIds(); cellId++)
         {
           cId = this->Tree[idx]->GetId(cellId);
-          if (this->CellHasBeenVisited[cId] != this->QueryNumber)
+          if (cellHasBeenVisited.insert(cId).second)
           {
-            this->CellHasBeenVisited[cId] = this->QueryNumber;
 
             // check whether we intersect the cell bounds
             if (this->CacheCellBounds)
@@ -1924,7 +1990,7 @@ void vtkCellLocator::FindCellsAlongLine(
             {
               cells->InsertUniqueId(cId);
             } // if (hitCellBounds)
-          }   // if (!this->CellHasBeenVisited[cId])
+          }   // if (cId has not been visited)
         }
       }
 
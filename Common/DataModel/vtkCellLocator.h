@@ -33,7 +33,10 @@
  *
  * @warning
  * Most of the methods of this class are not thread-safe. For a thread-safe,
- * more efficient generic implementation, please use vtkStaticCellLocator
+ * more efficient generic implementation, please use vtkStaticCellLocator.
+ * Once the locator is built, FindCell() and IntersectWithLine() with a
+ * vtkGenericCell supplied by each thread can however be called concurrently.
+ * The build itself is threaded with vtkSMPTools.
  *
  * @sa
  * vtkLocator vtkPointLocator vtkOBBTree vtkStaticCellLocator
@@ -76,7 +79,8 @@ public:
    * the finite line. The cell is returned as a cell id and as a generic
    * cell.  For other IntersectWithLine signatures, see
    * vtkAbstractCellLocator.
-   * THIS METHOD IS NOT THREAD SAFE.
+   * This method is thread safe once the locator is built, as long as each
+   * thread supplies its own cell.
    */
   int IntersectWithLine(const double a0[3], const double a1[3], double tol, double& t, double x[3],
     double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell) override;
@@ -132,6 +136,8 @@ public:
    * Find the cell containing a given point. returns -1 if no cell found
    * the cell parameters are copied into the supplied variables, a cell must
    * be provided to store the information.
+   * This method is thread safe once the locator is built, as long as each
+   * thread supplies its own cell.
    */
   vtkIdType FindCell(
     double x[3], double tol2, vtkGenericCell* GenCell, double pcoords[3], double* weights) override;
@@ -1001,15 +1001,16 @@ void vtkPolyData::GetCellPoints(vtkIdType cellId, vtkIdList* ptIds)
     this->BuildCells();
   }
 
-  vtkIdType npts;
-  const vtkIdType* pts;
-  this->GetCellPoints(cellId, npts, pts);
-
-  ptIds->SetNumberOfIds(npts);
-  for (vtkIdType i = 0; i < npts; ++i)
+  // Copy the ids directly into the list rather than through the temporary
+  // list of the cell array, so that this method is thread safe.
+  const TaggedCellId tag = this->Cells->GetTag(cellId);
+  if (tag.IsDeleted())
   {
-    ptIds->SetId(i, pts[i]);
+    ptIds->SetNumberOfIds(0);
+    return;
   }
+
+  this->GetCellArrayInternal(tag)->GetCellAtId(tag.GetCellId(), ptIds);
 }
 
 //----------------------------------------------------------------------------
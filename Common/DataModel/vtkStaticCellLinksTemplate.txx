@@ -361,14 +361,8 @@ void vtkStaticCellLinksTemplate<TIds>::ThreadedBuildLinks(
   vtkSMPTools::For(0, numCells, count);
 
   // Perform prefix sum to determine offsets
-  vtkIdType ptId, npts;
   this->Offsets = new TIds[numPts + 1];
-  this->Offsets[0] = 0;
-  for (ptId = 1; ptId < numPts; ++ptId)
-  {
-    npts = counts[ptId - 1];
-    this->Offsets[ptId] = this->Offsets[ptId - 1] + npts;
-  }
+  vtkSMPTools::ExclusiveScan(counts, counts + numPts, this->Offsets, static_cast<TIds>(0));
   this->Offsets[numPts] = this->LinksSize;
 
   // Now insert cell ids into cell links.
@@ -464,11 +458,10 @@ void vtkStaticCellLinksTemplate<TIds>::BuildLinks(vtkPolyData* pd)
   vtkIdType npts, CellId, ptId;
 
   // Visit the four arrays
-  for (CellId = 0, j = 0; j < 4; ++j)
+  for (j = 0; j < 4; ++j)
   {
     // Count number of point uses
-    cellArrays[j]->Visit(vtkSCLT_detail::CountPoints{}, this->Offsets, 0, numCells[j], CellId);
-    CellId += numCells[j];
+    cellArrays[j]->Visit(vtkSCLT_detail::CountPoints{}, this->Offsets, 0, numCells[j]);
   } // for each of the four polydata cell arrays
 
   // Perform prefix sum (inclusive scan)
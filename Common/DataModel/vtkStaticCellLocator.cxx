@@ -205,15 +205,8 @@ struct vtkCellBinner
   void Reduce()
   {
     // Perform prefix sum
-    vtkIdType* counts = this->Counts;
-    vtkIdType numBins, total = 0, numCells = this->NumCells;
-    for (vtkIdType i = 0; i < numCells; ++i)
-    {
-      numBins = *counts;
-      *counts++ = total;
-      total += numBins;
-    }
-    this->NumFragments = total;
+    this->NumFragments = vtkSMPTools::ExclusiveScan(
+      this->Counts, this->Counts + this->NumCells, this->Counts, static_cast<vtkIdType>(0));
   }
 
 }; // vtkCellBinner
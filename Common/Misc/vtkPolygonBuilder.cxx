@@ -167,6 +167,7 @@ void vtkPolygonBuilder::GetPolygons(vtkIdListCollection* polys)
 
 void vtkPolygonBuilder::Reset()
 {
+  this->Tris.clear();
   this->EdgeCounter.clear();
   this->Edges.clear();
 }
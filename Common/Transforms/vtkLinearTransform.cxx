@@ -14,10 +14,16 @@
 =========================================================================*/
 #include "vtkLinearTransform.h"
 
+#include "vtkArrayDispatch.h"
 #include "vtkDataArray.h"
+#include "vtkDataArrayRange.h"
 #include "vtkMath.h"
 #include "vtkMatrix4x4.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
+
+#include <utility>
+#include <vector>
 
 //------------------------------------------------------------------------
 void vtkLinearTransform::PrintSelf(ostream& os, vtkIndent indent)
@@ -84,41 +90,104 @@ inline void vtkLinearTransformNormal(T1 mat[4][4], T2 in[3], T3 out[3])
 }
 
 //------------------------------------------------------------------------
-template <class T1, class T2, class T3>
-inline void vtkLinearTransformPoints(T1 matrix[4][4], T2* in, T3* out, vtkIdType n)
+namespace
+{
+// How the tuples of an array are transformed. Points are translated, and
+// normals, multiplied by the transposed inverse matrix, are normalized.
+enum class TupleKind
 {
-  for (vtkIdType i = 0; i < n; i++)
+  Point,
+  Vector,
+  Normal
+};
+
+// Transform the tuples [begin, end) of an array into those of another one,
+// from outOffset on. The matrix is held in locals so that the loop over
+// tuples does not reload it and can be vectorized.
+template <TupleKind Kind>
+struct TransformTuplesWorker
+{
+  template <typename InArrayT, typename OutArrayT>
+  void operator()(InArrayT* inArray, OutArrayT* outArray, const double (*matrix)[4],
+    vtkIdType begin, vtkIdType end, vtkIdType outOffset) const
   {
-    vtkLinearTransformPoint(matrix, in, out);
-    in += 3;
-    out += 3;
+    using OutValueT = vtk::GetAPIType<OutArrayT>;
+    const auto inTuples = vtk::DataArrayTupleRange<3>(inArray, begin, end);
+    auto outTuples = vtk::DataArrayTupleRange<3>(outArray, begin + outOffset, end + outOffset);
+    const double m00 = matrix[0][0], m01 = matrix[0][1], m02 = matrix[0][2], m03 = matrix[0][3];
+    const double m10 = matrix[1][0], m11 = matrix[1][1], m12 = matrix[1][2], m13 = matrix[1][3];
+    const double m20 = matrix[2][0], m21 = matrix[2][1], m22 = matrix[2][2], m23 = matrix[2][3];
+
+    auto outTuple = outTuples.begin();
+    for (const auto inTuple : inTuples)
+    {
+      const double x = inTuple[0];
+      const double y = inTuple[1];
+      const double z = inTuple[2];
+      OutValueT out[3];
+      if (Kind == TupleKind::Point)
+      {
+        out[0] = static_cast<OutValueT>(m00 * x + m01 * y + m02 * z + m03);
+        out[1] = static_cast<OutValueT>(m10 * x + m11 * y + m12 * z + m13);
+        out[2] = static_cast<OutValueT>(m20 * x + m21 * y + m22 * z + m23);
+      }
+      else
+      {
+        out[0] = static_cast<OutValueT>(m00 * x + m01 * y + m02 * z);
+        out[1] = static_cast<OutValueT>(m10 * x + m11 * y + m12 * z);
+        out[2] = static_cast<OutValueT>(m20 * x + m21 * y + m22 * z);
+      }
+      if (Kind == TupleKind::Normal)
+      {
+        vtkMath::Normalize(out);
+      }
+      (*outTuple)[0] = out[0];
+      (*outTuple)[1] = out[1];
+      (*outTuple)[2] = out[2];
+      ++outTuple;
+    }
   }
-}
+};
 
-//------------------------------------------------------------------------
-template <class T1, class T2, class T3>
-inline void vtkLinearTransformVectors(T1 matrix[4][4], T2* in, T3* out, vtkIdType n)
+// Transform tuples with the fast paths of float and double arrays, of any
+// memory layout, falling back on the vtkDataArray API for other types.
+template <TupleKind Kind>
+void TransformTuples(vtkDataArray* inArray, vtkDataArray* outArray, const double (*matrix)[4],
+  vtkIdType begin, vtkIdType end, vtkIdType outOffset)
 {
-  for (vtkIdType i = 0; i < n; i++)
+  using Dispatcher =
+    vtkArrayDispatch::Dispatch2ByValueType<vtkArrayDispatch::Reals, vtkArrayDispatch::Reals>;
+  TransformTuplesWorker<Kind> worker;
+  if (!Dispatcher::Execute(inArray, outArray, worker, matrix, begin, end, outOffset))
   {
-    vtkLinearTransformVector(matrix, in, out);
-    in += 3;
-    out += 3;
+    worker(inArray, outArray, matrix, begin, end, outOffset);
   }
 }
 
-//------------------------------------------------------------------------
-template <class T1, class T2, class T3>
-inline void vtkLinearTransformNormals(T1 matrix[4][4], T2* in, T3* out, vtkIdType n)
+// Extend an array by n tuples, keeping its values, and return its previous
+// number of tuples.
+vtkIdType ExtendTuples(vtkDataArray* array, vtkIdType n)
 {
-  for (vtkIdType i = 0; i < n; i++)
+  const vtkIdType m = array->GetNumberOfTuples();
+  if (m > 0)
   {
-    // matrix has been transposed & inverted, so use TransformVector
-    vtkLinearTransformVector(matrix, in, out);
-    vtkMath::Normalize(out);
-    in += 3;
-    out += 3;
+    array->Resize(m + n);
   }
+  array->SetNumberOfTuples(m + n);
+  return m;
+}
+
+// Append the tuples of an array to another one, transformed in parallel.
+template <TupleKind Kind>
+void TransformAllTuples(vtkDataArray* inArray, vtkDataArray* outArray, const double (*matrix)[4])
+{
+  const vtkIdType n = inArray->GetNumberOfTuples();
+  const vtkIdType m = ExtendTuples(outArray, n);
+  vtkSMPTools::For(0, n, [&](vtkIdType begin, vtkIdType end) {
+    TransformTuples<Kind>(inArray, outArray, matrix, begin, end, m);
+  });
+  outArray->Modified();
+}
 }
 
 //------------------------------------------------------------------------
@@ -182,77 +251,95 @@ void vtkLinearTransform::TransformPointsNormalsVectors(vtkPoints* inPts, vtkPoin
   vtkDataArray* inNms, vtkDataArray* outNms, vtkDataArray* inVrs, vtkDataArray* outVrs,
   int nOptionalVectors, vtkDataArray** inVrsArr, vtkDataArray** outVrsArr)
 {
-  this->TransformPoints(inPts, outPts);
-  if (inNms)
+  // The arrays are transformed in a single pass over the points when they
+  // all have a tuple per point.
+  const vtkIdType n = inPts->GetNumberOfPoints();
+  bool samePoints = (!inNms || inNms->GetNumberOfTuples() == n) &&
+    (!inVrs || inVrs->GetNumberOfTuples() == n);
+  for (int iArr = 0; inVrsArr && iArr < nOptionalVectors; iArr++)
   {
-    this->TransformNormals(inNms, outNms);
+    samePoints &= inVrsArr[iArr]->GetNumberOfTuples() == n;
   }
-  if (inVrs)
-  {
-    this->TransformVectors(inVrs, outVrs);
-  }
-  if (inVrsArr)
+  if (!samePoints)
   {
-    for (int iArr = 0; iArr < nOptionalVectors; iArr++)
+    this->TransformPoints(inPts, outPts);
+    if (inNms)
+    {
+      this->TransformNormals(inNms, outNms);
+    }
+    if (inVrs)
+    {
+      this->TransformVectors(inVrs, outVrs);
+    }
+    for (int iArr = 0; inVrsArr && iArr < nOptionalVectors; iArr++)
     {
       this->TransformVectors(inVrsArr[iArr], outVrsArr[iArr]);
     }
+    return;
   }
-}
-
-//----------------------------------------------------------------------------
-void vtkLinearTransform::TransformPoints(vtkPoints* inPts, vtkPoints* outPts)
-{
-  vtkIdType n = inPts->GetNumberOfPoints();
-  vtkIdType m = outPts->GetNumberOfPoints();
-  double(*matrix)[4] = this->Matrix->Element;
 
   this->Update();
 
-  // operate directly on the memory to avoid GetPoint()/SetPoint() calls.
-  vtkDataArray* inArray = inPts->GetData();
-  vtkDataArray* outArray = outPts->GetData();
-  int inType = inArray->GetDataType();
-  int outType = outArray->GetDataType();
-  void* inPtr = inArray->GetVoidPointer(0);
-  void* outPtr = outArray->WriteVoidPointer(3 * m, 3 * n);
+  double(*matrix)[4] = this->Matrix->Element;
+  double normalMatrix[4][4];
+  vtkMatrix4x4::DeepCopy(*normalMatrix, this->Matrix);
+  vtkMatrix4x4::Invert(*normalMatrix, *normalMatrix);
+  vtkMatrix4x4::Transpose(*normalMatrix, *normalMatrix);
 
-  if (inType == VTK_FLOAT && outType == VTK_FLOAT)
+  // The output arrays are extended, and the transformed tuples appended.
+  std::vector<std::pair<vtkDataArray*, vtkDataArray*>> vectors;
+  if (inVrs)
   {
-    vtkLinearTransformPoints(matrix, static_cast<float*>(inPtr), static_cast<float*>(outPtr), n);
+    vectors.emplace_back(inVrs, outVrs);
   }
-  else if (inType == VTK_FLOAT && outType == VTK_DOUBLE)
+  for (int iArr = 0; inVrsArr && iArr < nOptionalVectors; iArr++)
   {
-    vtkLinearTransformPoints(matrix, static_cast<float*>(inPtr), static_cast<double*>(outPtr), n);
+    vectors.emplace_back(inVrsArr[iArr], outVrsArr[iArr]);
   }
-  else if (inType == VTK_DOUBLE && outType == VTK_FLOAT)
+  std::vector<vtkIdType> vectorOffsets;
+  for (const auto& vrs : vectors)
   {
-    vtkLinearTransformPoints(matrix, static_cast<double*>(inPtr), static_cast<float*>(outPtr), n);
+    vectorOffsets.push_back(ExtendTuples(vrs.second, n));
   }
-  else if (inType == VTK_DOUBLE && outType == VTK_DOUBLE)
+  const vtkIdType pointOffset = ExtendTuples(outPts->GetData(), n);
+  const vtkIdType normalOffset = inNms ? ExtendTuples(outNms, n) : 0;
+
+  vtkSMPTools::For(0, n, [&](vtkIdType begin, vtkIdType end) {
+    TransformTuples<TupleKind::Point>(
+      inPts->GetData(), outPts->GetData(), matrix, begin, end, pointOffset);
+    if (inNms)
+    {
+      TransformTuples<TupleKind::Normal>(inNms, outNms, normalMatrix, begin, end, normalOffset);
+    }
+    for (size_t i = 0; i < vectors.size(); ++i)
+    {
+      TransformTuples<TupleKind::Vector>(
+        vectors[i].first, vectors[i].second, matrix, begin, end, vectorOffsets[i]);
+    }
+  });
+  outPts->Modified();
+  if (inNms)
   {
-    vtkLinearTransformPoints(matrix, static_cast<double*>(inPtr), static_cast<double*>(outPtr), n);
+    outNms->Modified();
   }
-  else
+  for (const auto& vrs : vectors)
   {
-    double point[3];
-
-    for (vtkIdType i = 0; i < n; i++)
-    {
-      inPts->GetPoint(i, point);
+    vrs.second->Modified();
+  }
+}
 
-      vtkLinearTransformPoint(matrix, point, point);
+//----------------------------------------------------------------------------
+void vtkLinearTransform::TransformPoints(vtkPoints* inPts, vtkPoints* outPts)
+{
+  this->Update();
 
-      outPts->SetPoint(m + i, point);
-    }
-  }
+  TransformAllTuples<TupleKind::Point>(inPts->GetData(), outPts->GetData(), this->Matrix->Element);
+  outPts->Modified();
 }
 
 //----------------------------------------------------------------------------
 void vtkLinearTransform::TransformNormals(vtkDataArray* inNms, vtkDataArray* outNms)
 {
-  vtkIdType n = inNms->GetNumberOfTuples();
-  vtkIdType m = outNms->GetNumberOfTuples();
   double matrix[4][4];
 
   this->Update();
@@ -262,88 +349,13 @@ void vtkLinearTransform::TransformNormals(vtkDataArray* inNms, vtkDataArray* out
   vtkMatrix4x4::Invert(*matrix, *matrix);
   vtkMatrix4x4::Transpose(*matrix, *matrix);
 
-  // operate directly on the memory to avoid GetTuple()/SetPoint() calls.
-  int inType = inNms->GetDataType();
-  int outType = outNms->GetDataType();
-  void* inPtr = inNms->GetVoidPointer(0);
-  void* outPtr = outNms->WriteVoidPointer(3 * m, 3 * n);
-
-  if (inType == VTK_FLOAT && outType == VTK_FLOAT)
-  {
-    vtkLinearTransformNormals(matrix, static_cast<float*>(inPtr), static_cast<float*>(outPtr), n);
-  }
-  else if (inType == VTK_FLOAT && outType == VTK_DOUBLE)
-  {
-    vtkLinearTransformNormals(matrix, static_cast<float*>(inPtr), static_cast<double*>(outPtr), n);
-  }
-  else if (inType == VTK_DOUBLE && outType == VTK_FLOAT)
-  {
-    vtkLinearTransformNormals(matrix, static_cast<double*>(inPtr), static_cast<float*>(outPtr), n);
-  }
-  else if (inType == VTK_DOUBLE && outType == VTK_DOUBLE)
-  {
-    vtkLinearTransformNormals(matrix, static_cast<double*>(inPtr), static_cast<double*>(outPtr), n);
-  }
-  else
-  {
-    for (vtkIdType i = 0; i < n; i++)
-    {
-      double norm[3];
-
-      inNms->GetTuple(i, norm);
-
-      // use TransformVector because matrix is already transposed & inverted
-      vtkLinearTransformVector(matrix, norm, norm);
-      vtkMath::Normalize(norm);
-
-      outNms->SetTuple(m + i, norm);
-    }
-  }
+  TransformAllTuples<TupleKind::Normal>(inNms, outNms, matrix);
 }
 
 //----------------------------------------------------------------------------
 void vtkLinearTransform::TransformVectors(vtkDataArray* inVrs, vtkDataArray* outVrs)
 {
-  vtkIdType n = inVrs->GetNumberOfTuples();
-  vtkIdType m = outVrs->GetNumberOfTuples();
-
-  double(*matrix)[4] = this->Matrix->Element;
-
   this->Update();
 
-  // operate directly on the memory to avoid GetTuple()/SetTuple() calls.
-  int inType = inVrs->GetDataType();
-  int outType = outVrs->GetDataType();
-  void* inPtr = inVrs->GetVoidPointer(0);
-  void* outPtr = outVrs->WriteVoidPointer(3 * m, 3 * n);
-
-  if (inType == VTK_FLOAT && outType == VTK_FLOAT)
-  {
-    vtkLinearTransformVectors(matrix, static_cast<float*>(inPtr), static_cast<float*>(outPtr), n);
-  }
-  else if (inType == VTK_FLOAT && outType == VTK_DOUBLE)
-  {
-    vtkLinearTransformVectors(matrix, static_cast<float*>(inPtr), static_cast<double*>(outPtr), n);
-  }
-  else if (inType == VTK_DOUBLE && outType == VTK_FLOAT)
-  {
-    vtkLinearTransformVectors(matrix, static_cast<double*>(inPtr), static_cast<float*>(outPtr), n);
-  }
-  else if (inType == VTK_DOUBLE && outType == VTK_DOUBLE)
-  {
-    vtkLinearTransformVectors(matrix, static_cast<double*>(inPtr), static_cast<double*>(outPtr), n);
-  }
-  else
-  {
-    for (vtkIdType i = 0; i < n; i++)
-    {
-      double vec[3];
-
-      inVrs->GetTuple(i, vec);
-
-      vtkLinearTransformVector(matrix, vec, vec);
-
-      outVrs->SetTuple(m + i, vec);
-    }
-  }
+  TransformAllTuples<TupleKind::Vector>(inVrs, outVrs, this->Matrix->Element);
 }
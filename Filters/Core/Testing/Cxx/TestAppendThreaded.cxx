@@ -0,0 +1,328 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestAppendThreaded.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Checks that the datasets appended in parallel by vtkAppendPolyData and
+// vtkAppendFilter, with one or several threads, are the concatenation of
+// their inputs, with inputs larger than a single copy task, several types of
+// datasets and cells, coincident points merged exactly or within a
+// tolerance, and bit and string arrays, which are not copied concurrently.
+// Several threads must give the same outputs as one.
+
+#include "vtkAppendFilter.h"
+#include "vtkAppendPolyData.h"
+#include "vtkBitArray.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkStringArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Add to the attributes a bit and a string array derived from their ids.
+void AddBitAndStringArrays(vtkDataSetAttributes* attributes)
+{
+  vtkDataArray* ids = attributes->GetArray("Ids");
+  vtkNew<vtkBitArray> flags;
+  flags->SetName("Flags");
+  vtkNew<vtkStringArray> labels;
+  labels->SetName("Labels");
+  for (vtkIdType i = 0; i < ids->GetNumberOfTuples(); ++i)
+  {
+    const int id = static_cast<int>(ids->GetComponent(i, 0));
+    flags->InsertNextValue(id % 3 == 0);
+    labels->InsertNextValue(std::to_string(id));
+  }
+  attributes->AddArray(flags);
+  attributes->AddArray(labels);
+}
+
+// A sphere with more points than copied by a single task, with point and
+// cell ids shifted by the given offset.
+vtkSmartPointer<vtkPolyData> MakeSphere(int resolution, double shift, int offset)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(resolution);
+  sphere->SetPhiResolution(resolution);
+  sphere->SetCenter(shift, 0, 0);
+  sphere->Update();
+  auto output = vtkSmartPointer<vtkPolyData>::New();
+  output->ShallowCopy(sphere->GetOutput());
+  vtkNew<vtkIntArray> pointIds;
+  pointIds->SetName("Ids");
+  pointIds->SetNumberOfValues(output->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    pointIds->SetValue(ptId, static_cast<int>(ptId) + offset);
+  }
+  output->GetPointData()->AddArray(pointIds);
+  vtkNew<vtkIntArray> cellIds;
+  cellIds->SetName("Ids");
+  cellIds->SetNumberOfValues(output->GetNumberOfCells());
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    cellIds->SetValue(cellId, static_cast<int>(cellId) + offset);
+  }
+  output->GetCellData()->AddArray(cellIds);
+  AddBitAndStringArrays(output->GetPointData());
+  AddBitAndStringArrays(output->GetCellData());
+  return output;
+}
+
+// A single polyhedron, given with its sorted point ids, and a tetrahedron.
+vtkSmartPointer<vtkUnstructuredGrid> MakePolyhedra()
+{
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i < 8; ++i)
+  {
+    points->InsertNextPoint(i & 1, (i >> 1) & 1, 3 + ((i >> 2) & 1));
+  }
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->Allocate(2);
+  const vtkIdType ptIds[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+  const vtkIdType faces[] = { 6, 4, 0, 2, 3, 1, 4, 4, 5, 7, 6, 4, 0, 1, 5, 4, 4, 2, 6, 7, 3, 4, 0,
+    4, 6, 2, 4, 1, 3, 7, 5 };
+  grid->InsertNextCell(VTK_POLYHEDRON, 8, ptIds, 6, faces);
+  grid->InsertNextCell(VTK_TETRA, 4, ptIds);
+  vtkNew<vtkIntArray> pointIds;
+  pointIds->SetName("Ids");
+  for (int i = 0; i < 8; ++i)
+  {
+    pointIds->InsertNextValue(-i);
+  }
+  grid->GetPointData()->AddArray(pointIds);
+  vtkNew<vtkIntArray> cellIds;
+  cellIds->SetName("Ids");
+  cellIds->InsertNextValue(-1);
+  cellIds->InsertNextValue(-2);
+  grid->GetCellData()->AddArray(cellIds);
+  return grid;
+}
+
+vtkSmartPointer<vtkImageData> MakeImage()
+{
+  auto image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(4, 3, 2);
+  image->SetOrigin(0, 0, -3);
+  vtkNew<vtkIntArray> pointIds;
+  pointIds->SetName("Ids");
+  pointIds->SetNumberOfValues(image->GetNumberOfPoints());
+  pointIds->Fill(7);
+  image->GetPointData()->AddArray(pointIds);
+  vtkNew<vtkIntArray> cellIds;
+  cellIds->SetName("Ids");
+  cellIds->SetNumberOfValues(image->GetNumberOfCells());
+  cellIds->Fill(8);
+  image->GetCellData()->AddArray(cellIds);
+  return image;
+}
+
+// Whether the tuples have the same ids, and flags and labels when both
+// attributes have them.
+bool CheckValue(vtkDataSetAttributes* a, vtkIdType idA, vtkDataSetAttributes* b, vtkIdType idB)
+{
+  for (const char* name : { "Flags", "Labels" })
+  {
+    vtkAbstractArray* arrayA = a->GetAbstractArray(name);
+    vtkAbstractArray* arrayB = b->GetAbstractArray(name);
+    if (arrayA && arrayB && arrayA->GetVariantValue(idA) != arrayB->GetVariantValue(idB))
+    {
+      return false;
+    }
+  }
+  return a->GetArray("Ids")->GetComponent(idA, 0) == b->GetArray("Ids")->GetComponent(idB, 0);
+}
+
+// Check that the output contains each input, in order, with its point ids
+// shifted or mapped through the point map when given.
+bool CheckAppended(const std::vector<vtkDataSet*>& inputs, vtkDataSet* output,
+  const std::vector<vtkIdType>& pointMap = std::vector<vtkIdType>())
+{
+  vtkIdType pointOffset = 0;
+  vtkIdType cellOffset = 0;
+  vtkNew<vtkIdList> inIds;
+  vtkNew<vtkIdList> outIds;
+  for (vtkDataSet* input : inputs)
+  {
+    for (vtkIdType ptId = 0; pointMap.empty() && ptId < input->GetNumberOfPoints(); ++ptId)
+    {
+      double inPt[3];
+      double outPt[3];
+      input->GetPoint(ptId, inPt);
+      output->GetPoint(pointOffset + ptId, outPt);
+      if (!std::equal(inPt, inPt + 3, outPt) ||
+        !CheckValue(input->GetPointData(), ptId, output->GetPointData(), pointOffset + ptId))
+      {
+        cerr << "Wrong point " << pointOffset + ptId << endl;
+        return false;
+      }
+    }
+    for (vtkIdType cellId = 0; cellId < input->GetNumberOfCells(); ++cellId)
+    {
+      input->GetCellPoints(cellId, inIds);
+      output->GetCellPoints(cellOffset + cellId, outIds);
+      for (vtkIdType& id : *inIds)
+      {
+        id = pointMap.empty() ? id + pointOffset : pointMap[pointOffset + id];
+      }
+      if (input->GetCellType(cellId) != output->GetCellType(cellOffset + cellId) ||
+        inIds->GetNumberOfIds() != outIds->GetNumberOfIds() ||
+        !std::equal(inIds->begin(), inIds->end(), outIds->begin()) ||
+        !CheckValue(input->GetCellData(), cellId, output->GetCellData(), cellOffset + cellId))
+      {
+        cerr << "Wrong cell " << cellOffset + cellId << endl;
+        return false;
+      }
+    }
+    pointOffset += input->GetNumberOfPoints();
+    cellOffset += input->GetNumberOfCells();
+  }
+  if (pointMap.empty() && output->GetNumberOfPoints() != pointOffset)
+  {
+    cerr << "Found " << output->GetNumberOfPoints() << " points instead of " << pointOffset
+         << endl;
+    return false;
+  }
+  if (output->GetNumberOfCells() != cellOffset)
+  {
+    cerr << "Found " << output->GetNumberOfCells() << " cells instead of " << cellOffset << endl;
+    return false;
+  }
+  return true;
+}
+
+// The face stream of the polyhedron, with its point ids shifted.
+bool CheckFaces(vtkUnstructuredGrid* input, vtkUnstructuredGrid* output, vtkIdType cellId,
+  vtkIdType pointOffset)
+{
+  vtkNew<vtkIdList> inFaces;
+  vtkNew<vtkIdList> outFaces;
+  input->GetFaceStream(0, inFaces);
+  output->GetFaceStream(cellId, outFaces);
+  if (inFaces->GetNumberOfIds() != outFaces->GetNumberOfIds())
+  {
+    return false;
+  }
+  for (vtkIdType i = 1; i < inFaces->GetNumberOfIds(); i += inFaces->GetId(i) + 1)
+  {
+    for (vtkIdType j = i + 1; j <= i + inFaces->GetId(i); ++j)
+    {
+      if (inFaces->GetId(j) + pointOffset != outFaces->GetId(j))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestAppendThreaded(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> sphere = MakeSphere(300, 0.0, 0);
+  vtkSmartPointer<vtkPolyData> shifted = MakeSphere(300, 1e-6, 1000000);
+  vtkSmartPointer<vtkPolyData> small = MakeSphere(8, 3.0, 2000000);
+  vtkSmartPointer<vtkUnstructuredGrid> polyhedra = MakePolyhedra();
+  vtkSmartPointer<vtkImageData> image = MakeImage();
+
+  vtkSMPTestUtilities::OutputRecorder recorder;
+  return vtkSMPTestUtilities::RunWithThreads([&](int numThreads) {
+    int status = 0;
+    vtkNew<vtkAppendPolyData> appendPolyData;
+    appendPolyData->AddInputData(small);
+    appendPolyData->AddInputData(sphere);
+    appendPolyData->AddInputData(shifted);
+    appendPolyData->Update();
+    if (!recorder.Check(appendPolyData->GetOutput(), numThreads) ||
+      !CheckAppended({ small, sphere, shifted }, appendPolyData->GetOutput()))
+    {
+      cerr << "Wrong polydata with " << numThreads << " threads" << endl;
+      status = 1;
+    }
+
+    vtkNew<vtkAppendFilter> append;
+    append->AddInputData(sphere);
+    append->AddInputData(polyhedra);
+    append->AddInputData(image);
+    append->AddInputData(small);
+    append->Update();
+    vtkUnstructuredGrid* output = append->GetOutput();
+    const vtkIdType polyhedronId = sphere->GetNumberOfCells();
+    if (!recorder.Check(output, numThreads) ||
+      !CheckAppended({ sphere, polyhedra, image, small }, output) ||
+      !CheckFaces(polyhedra, output, polyhedronId, sphere->GetNumberOfPoints()) ||
+      output->GetFaceLocations()->GetValue(polyhedronId + 1) != -1)
+    {
+      cerr << "Wrong unstructured grid with " << numThreads << " threads" << endl;
+      status = 1;
+    }
+
+    // The points of a sphere appended to itself are merged, and so are those
+    // of a slightly shifted copy within a tolerance, the last copy of each
+    // point giving its data to the merged point.
+    const vtkIdType numPoints = sphere->GetNumberOfPoints();
+    std::vector<vtkIdType> pointMap(2 * numPoints);
+    std::iota(pointMap.begin(), pointMap.begin() + numPoints, 0);
+    std::iota(pointMap.begin() + numPoints, pointMap.end(), 0);
+    append->RemoveAllInputs();
+    append->AddInputData(sphere);
+    append->AddInputData(sphere);
+    append->MergePointsOn();
+    append->Update();
+    if (!recorder.Check(output, numThreads) || output->GetNumberOfPoints() != numPoints ||
+      !CheckAppended({ sphere, sphere }, output, pointMap))
+    {
+      cerr << "Wrong merged points with " << numThreads << " threads" << endl;
+      status = 1;
+    }
+    append->RemoveAllInputs();
+    append->AddInputData(sphere);
+    append->AddInputData(shifted);
+    append->Update();
+    if (!recorder.Check(output, numThreads) || output->GetNumberOfPoints() != 2 * numPoints ||
+      !CheckAppended({ sphere, shifted }, output))
+    {
+      cerr << "Points merged without tolerance with " << numThreads << " threads" << endl;
+      status = 1;
+    }
+    append->SetTolerance(1e-5);
+    append->Update();
+    if (!recorder.Check(output, numThreads) || output->GetNumberOfPoints() != numPoints ||
+      !CheckAppended({ sphere, shifted }, output, pointMap) ||
+      !CheckValue(shifted->GetPointData(), 0, output->GetPointData(), 0) ||
+      output->GetPoint(numPoints - 1)[0] != sphere->GetPoint(numPoints - 1)[0])
+    {
+      cerr << "Wrong points merged within tolerance with " << numThreads << " threads" << endl;
+      status = 1;
+    }
+    return status;
+  });
+}
@@ -0,0 +1,189 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCellDataToPointDataThreaded.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Checks the averages computed by vtkCellDataToPointData on unstructured
+// grids and polydata with cells of mixed dimensions, for all the contributing
+// cell options and with several threads, against a sequential reference. The
+// links of a grid are used when it has some, giving the same output.
+
+#include "vtkCell.h"
+#include "vtkCellData.h"
+#include "vtkCellDataToPointData.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+const int Res = 6;
+
+// Adds double, float and int arrays, and a bit array averaged through the
+// vtkDataArray API, to the cell data.
+void AddCellData(vtkDataSet* ds)
+{
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkIntArray> ids;
+  ids->SetName("Ids");
+  for (vtkIdType i = 0; i < ds->GetNumberOfCells(); ++i)
+  {
+    vectors->InsertNextTuple3(std::sin(0.1 * i), std::cos(0.3 * i), 0.01 * i);
+    scalars->InsertNextValue(static_cast<float>(std::sqrt(i + 0.3)));
+    ids->InsertNextValue(static_cast<int>(7 * i % 23));
+  }
+  ds->GetCellData()->AddArray(vectors);
+  ds->GetCellData()->AddArray(scalars);
+  ds->GetCellData()->AddArray(ids);
+  vtkSMPTestUtilities::AddSequentialArray(ds->GetCellData(), ds->GetNumberOfCells());
+}
+
+// The sequential average of the values of a cell array, accumulated in its
+// value type in increasing cell id order.
+template <typename T>
+std::vector<double> ReferenceAverage(vtkDataSet* ds, vtkDataArray* cellArray, int option)
+{
+  const vtkIdType numPts = ds->GetNumberOfPoints();
+  const int numComps = cellArray->GetNumberOfComponents();
+  std::vector<std::vector<vtkIdType>> pointCells(numPts);
+  std::vector<int> dimensions(ds->GetNumberOfCells());
+  int maxDimension = 0;
+  vtkNew<vtkIdList> ids;
+  for (vtkIdType cellId = 0; cellId < ds->GetNumberOfCells(); ++cellId)
+  {
+    dimensions[cellId] = ds->GetCell(cellId)->GetCellDimension();
+    maxDimension = std::max(maxDimension, dimensions[cellId]);
+    ds->GetCellPoints(cellId, ids);
+    for (vtkIdType i = 0; i < ids->GetNumberOfIds(); ++i)
+    {
+      pointCells[ids->GetId(i)].push_back(cellId);
+    }
+  }
+
+  std::vector<double> result(numPts * numComps, 0.0);
+  std::vector<T> sum(numComps);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    int minDimension = option == vtkCellDataToPointData::DataSetMax ? maxDimension : 0;
+    if (option == vtkCellDataToPointData::Patch)
+    {
+      for (vtkIdType cellId : pointCells[ptId])
+      {
+        minDimension = std::max(minDimension, dimensions[cellId]);
+      }
+    }
+    std::fill(sum.begin(), sum.end(), T(0));
+    T count = 0;
+    for (vtkIdType cellId : pointCells[ptId])
+    {
+      if (dimensions[cellId] >= minDimension)
+      {
+        for (int c = 0; c < numComps; ++c)
+        {
+          sum[c] += static_cast<T>(cellArray->GetComponent(cellId, c));
+        }
+        ++count;
+      }
+    }
+    for (int c = 0; c < numComps && count != T(0); ++c)
+    {
+      result[ptId * numComps + c] = static_cast<double>(sum[c] / count);
+    }
+  }
+  return result;
+}
+
+int TestInput(vtkDataSet* input)
+{
+  int status = 0;
+  vtkNew<vtkCellDataToPointData> filter;
+  filter->SetInputData(input);
+  for (int option = 0; option < 3; ++option)
+  {
+    filter->SetContributingCellOption(option);
+    filter->Update();
+    vtkPointData* outPD = filter->GetOutput()->GetPointData();
+    vtkCellData* inCD = input->GetCellData();
+    if (!vtkSMPTestUtilities::CompareValues(outPD->GetArray("Vectors"),
+          ReferenceAverage<double>(input, inCD->GetArray("Vectors"), option)) ||
+      !vtkSMPTestUtilities::CompareValues(outPD->GetArray("Scalars"),
+        ReferenceAverage<float>(input, inCD->GetArray("Scalars"), option)) ||
+      !vtkSMPTestUtilities::CompareValues(outPD->GetArray("Ids"),
+        ReferenceAverage<int>(input, inCD->GetArray("Ids"), option)))
+    {
+      cerr << "Wrong averages for " << input->GetClassName() << " and option " << option << endl;
+      status = 1;
+    }
+    vtkDataArray* bits = outPD->GetArray(vtkSMPTestUtilities::GetSequentialArrayName());
+    if (!bits || bits->GetNumberOfTuples() != input->GetNumberOfPoints())
+    {
+      cerr << "Missing bit array for " << input->GetClassName() << endl;
+      status = 1;
+    }
+  }
+  return status;
+}
+
+// Checks that the links of the grid give the same output as the ones built
+// by the filter.
+int TestLinks(vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkUnstructuredGrid> linked;
+  linked->DeepCopy(grid);
+  linked->BuildLinks();
+  vtkNew<vtkCellDataToPointData> filter;
+  filter->SetInputData(grid);
+  vtkNew<vtkCellDataToPointData> linkedFilter;
+  linkedFilter->SetInputData(linked);
+  for (vtkCellDataToPointData* f : { filter.Get(), linkedFilter.Get() })
+  {
+    f->SetContributingCellOption(vtkCellDataToPointData::Patch);
+    f->PassCellDataOn();
+    f->Update();
+  }
+  if (!vtkSMPTestUtilities::CompareOutputs(vtkUnstructuredGrid::SafeDownCast(filter->GetOutput()),
+        vtkUnstructuredGrid::SafeDownCast(linkedFilter->GetOutput())))
+  {
+    cerr << "The links of the grid change the output." << endl;
+    return 1;
+  }
+  return TestInput(linked);
+}
+}
+
+int TestCellDataToPointDataThreaded(int, char*[])
+{
+  vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSMPTestUtilities::MakeMixedGrid(Res);
+  AddCellData(grid);
+  vtkSmartPointer<vtkPolyData> polyData =
+    vtkSMPTestUtilities::MakeMixedPolyData(vtkSMPTestUtilities::MakeLatticePoints(Res), Res, 0);
+  AddCellData(polyData);
+  return vtkSMPTestUtilities::RunWithThreads([&](int) {
+    return TestInput(grid) | TestInput(polyData) | TestLinks(grid);
+  });
+}
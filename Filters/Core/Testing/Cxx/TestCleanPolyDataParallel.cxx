@@ -0,0 +1,320 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCleanPolyDataParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Checks that the threaded implementations of vtkCleanPolyData and
+// vtkStaticCleanPolyData give the same output as the sequential ones. A bit
+// array, which cannot be copied concurrently, forces the sequential path, as
+// does an array not stored as an array of structures. Overrides of
+// OperateOnPoint() must only be called on the calling thread.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCleanPolyData.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticCleanPolyData.h"
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+// Snaps the points to a grid, recording whether it is ever called from
+// another thread than the one that created it.
+class vtkSnapCleanPolyData : public vtkCleanPolyData
+{
+public:
+  static vtkSnapCleanPolyData* New();
+  vtkTypeMacro(vtkSnapCleanPolyData, vtkCleanPolyData);
+
+  bool CalledFromOtherThread = false;
+
+  void OperateOnPoint(double in[3], double out[3]) override
+  {
+    if (std::this_thread::get_id() != this->Thread)
+    {
+      this->CalledFromOtherThread = true;
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+      out[i] = std::floor(in[i] * 8.0) / 8.0;
+    }
+  }
+
+protected:
+  vtkSnapCleanPolyData() = default;
+
+  std::thread::id Thread = std::this_thread::get_id();
+};
+vtkStandardNewMacro(vtkSnapCleanPolyData);
+
+namespace
+{
+// A soup of cells of all types with many duplicate and unused points,
+// degenerate cells, and point and cell data.
+vtkSmartPointer<vtkPolyData> MakeSoup(int pointsType)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1234);
+  const int numDistinct = 500;
+  std::vector<double> distinct;
+  for (int i = 0; i < numDistinct; ++i)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      random->Next();
+      distinct.push_back(static_cast<float>(random->GetRangeValue(-1.0, 1.0)));
+    }
+  }
+  // Signed zeros are merged.
+  distinct[0] = 0.0;
+  distinct[1] = 0.0;
+  distinct[2] = 0.0;
+  distinct[3] = -0.0;
+  distinct[4] = 0.0;
+  distinct[5] = -0.0;
+
+  vtkNew<vtkPoints> points;
+  points->SetDataType(pointsType);
+  vtkNew<vtkFloatArray> pointScalars;
+  pointScalars->SetName("PointScalars");
+  vtkNew<vtkIntArray> pointIds;
+  pointIds->SetName("PointIds");
+  pointIds->SetNumberOfComponents(2);
+  const vtkIdType numPts = 20000;
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    random->Next();
+    const int which = static_cast<int>(random->GetRangeValue(0, numDistinct - 0.001));
+    points->InsertNextPoint(&distinct[3 * which]);
+    pointScalars->InsertNextValue(static_cast<float>(i));
+    pointIds->InsertNextTuple2(static_cast<double>(i), -static_cast<double>(i));
+  }
+
+  vtkCellArray* cells[4];
+  for (auto& cellArray : cells)
+  {
+    cellArray = vtkCellArray::New();
+  }
+  vtkIdType ids[6];
+  // Most cells use the first points only, so that the others are unused.
+  const double maxUsed = numPts * 0.9;
+  for (int c = 0; c < 30000; ++c)
+  {
+    random->Next();
+    const int type = static_cast<int>(random->GetRangeValue(0, 3.999));
+    random->Next();
+    const int npts = 1 + static_cast<int>(random->GetRangeValue(0, 5.999));
+    for (int i = 0; i < npts; ++i)
+    {
+      random->Next();
+      ids[i] = static_cast<vtkIdType>(random->GetRangeValue(0, maxUsed));
+      // Repeated points make degenerate cells.
+      if (i > 0 && c % 5 == 0)
+      {
+        ids[i] = ids[i - 1];
+      }
+    }
+    cells[type]->InsertNextCell(npts, ids);
+  }
+
+  auto polyData = vtkSmartPointer<vtkPolyData>::New();
+  polyData->SetPoints(points);
+  polyData->SetVerts(cells[0]);
+  polyData->SetLines(cells[1]);
+  polyData->SetPolys(cells[2]);
+  polyData->SetStrips(cells[3]);
+  for (auto& cellArray : cells)
+  {
+    cellArray->Delete();
+  }
+  polyData->GetPointData()->SetScalars(pointScalars);
+  polyData->GetPointData()->AddArray(pointIds);
+
+  vtkNew<vtkIntArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType i = 0; i < polyData->GetNumberOfCells(); ++i)
+  {
+    cellIds->InsertNextValue(static_cast<int>(i));
+  }
+  polyData->GetCellData()->AddArray(cellIds);
+  return polyData;
+}
+
+// Adds a bit array to the attributes so that the sequential path is used.
+vtkSmartPointer<vtkPolyData> WithBitArray(vtkPolyData* input, vtkDataSetAttributes* attributes)
+{
+  auto copy = vtkSmartPointer<vtkPolyData>::New();
+  copy->ShallowCopy(input);
+  vtkDataSetAttributes* copyAttributes = copy->GetCellData();
+  if (attributes == input->GetPointData())
+  {
+    copyAttributes = copy->GetPointData();
+  }
+  vtkSMPTestUtilities::AddSequentialArray(copyAttributes, attributes->GetNumberOfTuples());
+  return copy;
+}
+
+int TestClean(vtkPolyData* input)
+{
+  int status = 0;
+  for (int merging = 0; merging < 2; ++merging)
+  {
+    for (int convert = 0; convert < 2; ++convert)
+    {
+      for (int precision : { vtkAlgorithm::DEFAULT_PRECISION, vtkAlgorithm::DOUBLE_PRECISION })
+      {
+        vtkNew<vtkCleanPolyData> sequential;
+        sequential->SetInputData(WithBitArray(input, input->GetPointData()));
+        vtkNew<vtkCleanPolyData> parallel;
+        parallel->SetInputData(input);
+        for (vtkCleanPolyData* clean : { sequential.Get(), parallel.Get() })
+        {
+          clean->SetPointMerging(merging);
+          clean->SetConvertLinesToPoints(convert);
+          clean->SetConvertPolysToLines(convert);
+          clean->SetConvertStripsToPolys(convert);
+          clean->SetOutputPointsPrecision(precision);
+          clean->Update();
+        }
+        if (!vtkSMPTestUtilities::CompareOutputs(sequential->GetOutput(), parallel->GetOutput()))
+        {
+          cerr << "vtkCleanPolyData differs with merging " << merging << ", conversions "
+               << convert << ", precision " << precision << endl;
+          status = 1;
+        }
+      }
+    }
+  }
+  return status;
+}
+
+// Adds the coordinates of the points as a point data array stored as a
+// structure of arrays, and checks it is copied along with the points.
+int TestStructureOfArrays(vtkPolyData* input)
+{
+  vtkNew<vtkPolyData> copy;
+  copy->ShallowCopy(input);
+  vtkNew<vtkSOADataArrayTemplate<double> > coords;
+  coords->SetName("Coordinates");
+  coords->SetNumberOfComponents(3);
+  coords->SetNumberOfTuples(input->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+  {
+    coords->SetTuple(ptId, input->GetPoint(ptId));
+  }
+  copy->GetPointData()->AddArray(coords);
+
+  vtkNew<vtkCleanPolyData> clean;
+  clean->SetInputData(copy);
+  clean->Update();
+  vtkPolyData* output = clean->GetOutput();
+  vtkDataArray* outCoords = output->GetPointData()->GetArray("Coordinates");
+  if (!outCoords || outCoords->GetNumberOfTuples() != output->GetNumberOfPoints())
+  {
+    cerr << "vtkCleanPolyData did not copy the structure of arrays." << endl;
+    return 1;
+  }
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3], y[3];
+    output->GetPoint(ptId, x);
+    outCoords->GetTuple(ptId, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      cerr << "vtkCleanPolyData copied the structure of arrays wrongly." << endl;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+int TestOperateOnPoint(vtkPolyData* input)
+{
+  int status = 0;
+  for (int merging = 0; merging < 2; ++merging)
+  {
+    vtkNew<vtkSnapCleanPolyData> sequential;
+    sequential->SetInputData(WithBitArray(input, input->GetPointData()));
+    vtkNew<vtkSnapCleanPolyData> parallel;
+    parallel->SetInputData(input);
+    for (vtkSnapCleanPolyData* clean : { sequential.Get(), parallel.Get() })
+    {
+      clean->SetPointMerging(merging);
+      clean->Update();
+      if (clean->CalledFromOtherThread)
+      {
+        cerr << "OperateOnPoint was called from another thread." << endl;
+        status = 1;
+      }
+    }
+    if (!vtkSMPTestUtilities::CompareOutputs(sequential->GetOutput(), parallel->GetOutput()))
+    {
+      cerr << "vtkCleanPolyData differs with OperateOnPoint and merging " << merging << endl;
+      status = 1;
+    }
+  }
+  return status;
+}
+
+int TestStaticClean(vtkPolyData* input)
+{
+  int status = 0;
+  for (int convert = 0; convert < 2; ++convert)
+  {
+    vtkNew<vtkStaticCleanPolyData> sequential;
+    sequential->SetInputData(WithBitArray(input, input->GetCellData()));
+    vtkNew<vtkStaticCleanPolyData> parallel;
+    parallel->SetInputData(input);
+    for (vtkStaticCleanPolyData* clean : { sequential.Get(), parallel.Get() })
+    {
+      clean->SetConvertLinesToPoints(convert);
+      clean->SetConvertPolysToLines(convert);
+      clean->SetConvertStripsToPolys(convert);
+      clean->Update();
+    }
+    if (!vtkSMPTestUtilities::CompareOutputs(sequential->GetOutput(), parallel->GetOutput()))
+    {
+      cerr << "vtkStaticCleanPolyData differs with conversions " << convert << endl;
+      status = 1;
+    }
+  }
+  return status;
+}
+}
+
+int TestCleanPolyDataParallel(int, char*[])
+{
+  return vtkSMPTestUtilities::RunWithThreads([](int) {
+    int status = 0;
+    for (int pointsType : { VTK_FLOAT, VTK_DOUBLE })
+    {
+      vtkSmartPointer<vtkPolyData> input = MakeSoup(pointsType);
+      status |= TestClean(input);
+      status |= TestOperateOnPoint(input);
+      status |= TestStaticClean(input);
+      status |= TestStructureOfArrays(input);
+    }
+    return status;
+  });
+}
@@ -0,0 +1,517 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestConnectivityFilterThreaded.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Checks the regions labeled by vtkConnectivityFilter and
+// vtkPolyDataConnectivityFilter against a sequential wave propagation, for
+// all the extraction modes, with and without scalar connectivity, and checks
+// that several threads give the same outputs as one.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkConnectivityFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataConnectivityFilter.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+const double ScalarRange[2] = { -0.2, 0.5 };
+
+// Adds point scalars, and the input ids of the points and cells to find them
+// in the output.
+void AddArrays(vtkDataSet* ds)
+{
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkIdTypeArray> pointIds;
+  pointIds->SetName("PointIds");
+  for (vtkIdType i = 0; i < ds->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    ds->GetPoint(i, x);
+    scalars->InsertNextValue(std::sin(0.7 * x[0]) * std::cos(0.4 * x[1]) + 0.1 * x[2]);
+    pointIds->InsertNextValue(i);
+  }
+  ds->GetPointData()->SetScalars(scalars);
+  ds->GetPointData()->AddArray(pointIds);
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType i = 0; i < ds->GetNumberOfCells(); ++i)
+  {
+    cellIds->InsertNextValue(i);
+  }
+  ds->GetCellData()->AddArray(cellIds);
+}
+
+// Quads and triangles in blocks separated by gaps, with lines and vertices
+// here and there, and an unused point.
+vtkSmartPointer<vtkPolyData> MakePolyData()
+{
+  const int res = 24;
+  const int dim = res + 1;
+  vtkNew<vtkPoints> points;
+  for (int j = 0; j < dim; ++j)
+  {
+    for (int i = 0; i < dim; ++i)
+    {
+      points->InsertNextPoint(i, j, 0.0);
+    }
+  }
+  points->InsertNextPoint(-1, -1, -1);
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkCellArray> polys;
+  for (int j = 0; j < res; ++j)
+  {
+    for (int i = 0; i < res; ++i)
+    {
+      const vtkIdType q[4] = { i + dim * j, i + 1 + dim * j, i + 1 + dim * (j + 1),
+        i + dim * (j + 1) };
+      if (i % 7 == 3 || j % 5 == 2)
+      {
+        if ((i + j) % 4 == 0)
+        {
+          verts->InsertNextCell(1, q);
+        }
+        else if ((i + j) % 4 == 1)
+        {
+          lines->InsertNextCell(2, q + 1);
+        }
+        continue;
+      }
+      if ((i + 2 * j) % 3 == 0)
+      {
+        polys->InsertNextCell(3, q);
+      }
+      else
+      {
+        polys->InsertNextCell(4, q);
+      }
+    }
+  }
+  auto polyData = vtkSmartPointer<vtkPolyData>::New();
+  polyData->SetPoints(points);
+  polyData->SetVerts(verts);
+  polyData->SetLines(lines);
+  polyData->SetPolys(polys);
+  AddArrays(polyData);
+  return polyData;
+}
+
+// Hexahedra and tetrahedra in blocks separated by gaps, with vertices and
+// empty cells.
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid()
+{
+  const int res = 10;
+  const int dim = res + 1;
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < dim; ++k)
+  {
+    for (int j = 0; j < dim; ++j)
+    {
+      for (int i = 0; i < dim; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->Allocate();
+  auto id = [dim](int i, int j, int k) -> vtkIdType { return i + dim * (j + dim * k); };
+  for (int k = 0; k < res; ++k)
+  {
+    for (int j = 0; j < res; ++j)
+    {
+      for (int i = 0; i < res; ++i)
+      {
+        const vtkIdType h[8] = { id(i, j, k), id(i + 1, j, k), id(i + 1, j + 1, k),
+          id(i, j + 1, k), id(i, j, k + 1), id(i + 1, j, k + 1), id(i + 1, j + 1, k + 1),
+          id(i, j + 1, k + 1) };
+        if (i % 4 == 2 || k % 3 == 1)
+        {
+          if ((i + j + k) % 5 == 0)
+          {
+            grid->InsertNextCell(VTK_VERTEX, 1, h);
+          }
+          else if ((i + j + k) % 5 == 1)
+          {
+            grid->InsertNextCell(VTK_EMPTY_CELL, 0, h);
+          }
+          continue;
+        }
+        if ((i + j + k) % 3 == 0)
+        {
+          const vtkIdType tet[4] = { h[0], h[1], h[3], h[4] };
+          grid->InsertNextCell(VTK_TETRA, 4, tet);
+        }
+        else
+        {
+          grid->InsertNextCell(VTK_HEXAHEDRON, 8, h);
+        }
+      }
+    }
+  }
+  AddArrays(grid);
+  return grid;
+}
+
+// The sequential labeling of the regions: a wave propagation from each cell
+// not yet in a region, or from the seed cells only, across the shared points
+// of the cells that satisfy the scalar criterion.
+struct Reference
+{
+  std::vector<vtkIdType> CellRegions;
+  std::vector<vtkIdType> PointRegions;
+  std::vector<vtkIdType> RegionSizes;
+
+  Reference(vtkDataSet* ds, bool scalarConnectivity, bool full, const std::vector<vtkIdType>* seeds)
+  {
+    const vtkIdType numCells = ds->GetNumberOfCells();
+    const vtkIdType numPts = ds->GetNumberOfPoints();
+    vtkDataArray* scalars = ds->GetPointData()->GetScalars();
+    std::vector<std::vector<vtkIdType>> cellPoints(numCells);
+    std::vector<std::vector<vtkIdType>> pointCells(numPts);
+    std::vector<bool> connected(numCells, true);
+    vtkNew<vtkIdList> ids;
+    for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+      ds->GetCellPoints(cellId, ids);
+      double range[2] = { VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+      for (vtkIdType i = 0; i < ids->GetNumberOfIds(); ++i)
+      {
+        cellPoints[cellId].push_back(ids->GetId(i));
+        pointCells[ids->GetId(i)].push_back(cellId);
+        range[0] = std::min(range[0], scalars->GetTuple1(ids->GetId(i)));
+        range[1] = std::max(range[1], scalars->GetTuple1(ids->GetId(i)));
+      }
+      if (scalarConnectivity)
+      {
+        connected[cellId] = full ? range[0] >= ScalarRange[0] && range[1] <= ScalarRange[1]
+                                 : range[1] >= ScalarRange[0] && range[0] <= ScalarRange[1];
+      }
+    }
+
+    this->CellRegions.assign(numCells, -1);
+    auto grow = [&](std::vector<vtkIdType> wave) {
+      const vtkIdType regionId = static_cast<vtkIdType>(this->RegionSizes.size());
+      this->RegionSizes.push_back(0);
+      while (!wave.empty())
+      {
+        std::vector<vtkIdType> nextWave;
+        for (vtkIdType cellId : wave)
+        {
+          if (this->CellRegions[cellId] >= 0)
+          {
+            continue;
+          }
+          this->CellRegions[cellId] = regionId;
+          ++this->RegionSizes[regionId];
+          for (vtkIdType ptId : cellPoints[cellId])
+          {
+            for (vtkIdType neighbor : pointCells[ptId])
+            {
+              if (connected[neighbor])
+              {
+                nextWave.push_back(neighbor);
+              }
+            }
+          }
+        }
+        wave.swap(nextWave);
+      }
+    };
+    if (seeds)
+    {
+      grow(*seeds);
+    }
+    else
+    {
+      for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+      {
+        if (this->CellRegions[cellId] < 0)
+        {
+          grow(std::vector<vtkIdType>(1, cellId));
+        }
+      }
+    }
+
+    this->PointRegions.assign(numPts, -1);
+    for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+      const vtkIdType regionId = this->CellRegions[cellId];
+      for (vtkIdType ptId : cellPoints[cellId])
+      {
+        if (regionId >= 0 &&
+          (this->PointRegions[ptId] < 0 || regionId < this->PointRegions[ptId]))
+        {
+          this->PointRegions[ptId] = regionId;
+        }
+      }
+    }
+  }
+};
+
+// Checks the extracted cells and points, and their region ids when they are
+// given.
+bool CheckOutput(vtkDataSet* output, const Reference& reference,
+  const std::vector<bool>& extracted, bool checkCellRegions, bool checkPointRegions)
+{
+  vtkDataArray* cellIds = output->GetCellData()->GetArray("CellIds");
+  vtkDataArray* pointIds = output->GetPointData()->GetArray("PointIds");
+  vtkDataArray* cellRegions = output->GetCellData()->GetArray("RegionId");
+  vtkDataArray* pointRegions = output->GetPointData()->GetArray("RegionId");
+  const vtkIdType numExtracted =
+    static_cast<vtkIdType>(std::count(extracted.begin(), extracted.end(), true));
+  if (!cellIds || !pointIds || output->GetNumberOfCells() != numExtracted)
+  {
+    cerr << "Wrong number of cells: " << output->GetNumberOfCells() << " instead of "
+         << numExtracted << endl;
+    return false;
+  }
+  vtkIdType outCellId = 0;
+  for (vtkIdType cellId = 0; cellId < static_cast<vtkIdType>(extracted.size()); ++cellId)
+  {
+    if (!extracted[cellId])
+    {
+      continue;
+    }
+    if (static_cast<vtkIdType>(cellIds->GetTuple1(outCellId)) != cellId ||
+      (checkCellRegions &&
+        static_cast<vtkIdType>(cellRegions->GetTuple1(outCellId)) !=
+          reference.CellRegions[cellId]))
+    {
+      cerr << "Wrong output cell " << outCellId << endl;
+      return false;
+    }
+    ++outCellId;
+  }
+
+  // The points of the cells in a region, in increasing input id order.
+  vtkIdType outPtId = 0;
+  for (vtkIdType ptId = 0; ptId < static_cast<vtkIdType>(reference.PointRegions.size()); ++ptId)
+  {
+    if (reference.PointRegions[ptId] < 0)
+    {
+      continue;
+    }
+    if (outPtId >= output->GetNumberOfPoints() ||
+      static_cast<vtkIdType>(pointIds->GetTuple1(outPtId)) != ptId ||
+      (checkPointRegions &&
+        static_cast<vtkIdType>(pointRegions->GetTuple1(outPtId)) !=
+          reference.PointRegions[ptId]))
+    {
+      cerr << "Wrong output point " << outPtId << endl;
+      return false;
+    }
+    ++outPtId;
+  }
+  if (outPtId != output->GetNumberOfPoints())
+  {
+    cerr << "Wrong number of points." << endl;
+    return false;
+  }
+  return true;
+}
+
+// vtkConnectivityFilter does not expose its region sizes.
+bool CheckRegionSizes(vtkConnectivityFilter* filter, const Reference& reference)
+{
+  return filter->GetNumberOfExtractedRegions() ==
+    static_cast<int>(reference.RegionSizes.size());
+}
+
+bool CheckRegionSizes(vtkPolyDataConnectivityFilter* filter, const Reference& reference)
+{
+  vtkIdTypeArray* regionSizes = filter->GetRegionSizes();
+  if (regionSizes->GetNumberOfValues() != static_cast<vtkIdType>(reference.RegionSizes.size()))
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < regionSizes->GetNumberOfValues(); ++i)
+  {
+    if (regionSizes->GetValue(i) != reference.RegionSizes[i])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Sets the options of either filter, without seeds.
+template <typename FilterT>
+void Configure(FilterT* filter, int mode, bool scalarConnectivity, const double closestPoint[3])
+{
+  filter->SetExtractionMode(mode);
+  filter->SetScalarConnectivity(scalarConnectivity);
+  filter->SetScalarRange(ScalarRange[0], ScalarRange[1]);
+  filter->SetClosestPoint(closestPoint[0], closestPoint[1], closestPoint[2]);
+  filter->InitializeSeedList();
+  filter->InitializeSpecifiedRegionList();
+  filter->AddSpecifiedRegion(1);
+  filter->AddSpecifiedRegion(3);
+  filter->SetColorRegions(mode == VTK_EXTRACT_ALL_REGIONS);
+}
+
+template <typename FilterT>
+int TestFilter(vtkDataSet* input, bool full, vtkSMPTestUtilities::OutputRecorder& recorder,
+  int numThreads)
+{
+  int status = 0;
+  vtkNew<FilterT> filter;
+  filter->SetInputData(input);
+  const bool isPolyDataFilter = std::is_same<FilterT, vtkPolyDataConnectivityFilter>::value;
+
+  // Seeds, with ids out of range that are ignored.
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+  const std::vector<vtkIdType> seedPoints = { 5, numPts / 2, -1, numPts + 3 };
+  const std::vector<vtkIdType> seedCells = { 2, numCells / 3, numCells - 1, -4, numCells };
+  const double closestPoint[3] = { 8.3, 7.6, 0.4 };
+
+  for (int scalarConnectivity = 0; scalarConnectivity < 2; ++scalarConnectivity)
+  {
+    if (isPolyDataFilter)
+    {
+      vtkPolyDataConnectivityFilter::SafeDownCast(filter)->SetFullScalarConnectivity(full);
+    }
+    else if (full)
+    {
+      continue;
+    }
+    for (int mode = VTK_EXTRACT_POINT_SEEDED_REGIONS; mode <= VTK_EXTRACT_CLOSEST_POINT_REGION;
+         ++mode)
+    {
+      Configure(filter.Get(), mode, scalarConnectivity != 0, closestPoint);
+
+      // The seed cells of the reference.
+      std::vector<vtkIdType> seeds;
+      std::vector<vtkIdType> pointSeeds;
+      if (mode == VTK_EXTRACT_POINT_SEEDED_REGIONS)
+      {
+        for (vtkIdType ptId : seedPoints)
+        {
+          filter->AddSeed(ptId);
+          if (ptId >= 0 && ptId < numPts)
+          {
+            pointSeeds.push_back(ptId);
+          }
+        }
+      }
+      else if (mode == VTK_EXTRACT_CLOSEST_POINT_REGION)
+      {
+        vtkIdType closestId = 0;
+        double closestDistance2 = VTK_DOUBLE_MAX;
+        for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+        {
+          double x[3];
+          input->GetPoint(ptId, x);
+          const double distance2 = vtkMath::Distance2BetweenPoints(x, closestPoint);
+          if (distance2 < closestDistance2)
+          {
+            closestId = ptId;
+            closestDistance2 = distance2;
+          }
+        }
+        pointSeeds.push_back(closestId);
+      }
+      else if (mode == VTK_EXTRACT_CELL_SEEDED_REGIONS)
+      {
+        for (vtkIdType cellId : seedCells)
+        {
+          filter->AddSeed(cellId);
+          if (cellId >= 0 && cellId < numCells)
+          {
+            seeds.push_back(cellId);
+          }
+        }
+      }
+      vtkNew<vtkIdList> ids;
+      for (vtkIdType ptId : pointSeeds)
+      {
+        input->GetPointCells(ptId, ids);
+        seeds.insert(seeds.end(), ids->GetPointer(0), ids->GetPointer(0) + ids->GetNumberOfIds());
+      }
+      const bool seeded = mode == VTK_EXTRACT_POINT_SEEDED_REGIONS ||
+        mode == VTK_EXTRACT_CELL_SEEDED_REGIONS || mode == VTK_EXTRACT_CLOSEST_POINT_REGION;
+      Reference reference(input, scalarConnectivity != 0, full, seeded ? &seeds : nullptr);
+
+      filter->Update();
+
+      std::vector<bool> extracted(numCells);
+      const vtkIdType largest = std::max_element(reference.RegionSizes.begin(),
+                                  reference.RegionSizes.end()) -
+        reference.RegionSizes.begin();
+      for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+      {
+        const vtkIdType regionId = reference.CellRegions[cellId];
+        switch (mode)
+        {
+          case VTK_EXTRACT_SPECIFIED_REGIONS:
+            extracted[cellId] = regionId == 1 || regionId == 3;
+            break;
+          case VTK_EXTRACT_LARGEST_REGION:
+            extracted[cellId] = regionId == largest;
+            break;
+          default:
+            extracted[cellId] = regionId >= 0;
+            break;
+        }
+      }
+      const bool colored = mode == VTK_EXTRACT_ALL_REGIONS;
+      vtkDataSet* output = vtkDataSet::SafeDownCast(filter->GetOutputDataObject(0));
+      if (!recorder.Check(output, numThreads) ||
+        !CheckOutput(output, reference, extracted, colored && !isPolyDataFilter, colored) ||
+        !CheckRegionSizes(filter.Get(), reference))
+      {
+        cerr << "Wrong output of " << filter->GetClassName() << " for "
+             << input->GetClassName() << ", mode " << mode << ", scalar connectivity "
+             << scalarConnectivity << ", full " << full << endl;
+        status = 1;
+      }
+    }
+  }
+  return status;
+}
+}
+
+int TestConnectivityFilterThreaded(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> polyData = MakePolyData();
+  vtkSmartPointer<vtkUnstructuredGrid> grid = MakeGrid();
+  vtkSMPTestUtilities::OutputRecorder recorder;
+  return vtkSMPTestUtilities::RunWithThreads([&](int numThreads) {
+    int status = 0;
+    status |= TestFilter<vtkConnectivityFilter>(polyData, false, recorder, numThreads);
+    status |= TestFilter<vtkConnectivityFilter>(grid, false, recorder, numThreads);
+    status |= TestFilter<vtkPolyDataConnectivityFilter>(polyData, false, recorder, numThreads);
+    status |= TestFilter<vtkPolyDataConnectivityFilter>(polyData, true, recorder, numThreads);
+    return status;
+  });
+}
@@ -0,0 +1,223 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestContourGridThreaded.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Checks that the cells contoured in parallel by vtkContourGrid and vtkCutter,
+// with one or several threads, give the output of their serial path, which
+// is used with a vtkPointLocator merging coincident points, for a grid of
+// several types and dimensions of cells larger than a single contouring task,
+// with bit and string arrays, which are not copied concurrently.
+
+#include "vtkBitArray.h"
+#include "vtkCellData.h"
+#include "vtkContourGrid.h"
+#include "vtkCutter.h"
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPlane.h"
+#include "vtkPointData.h"
+#include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkSmartPointer.h"
+#include "vtkStringArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <string>
+
+namespace
+{
+// Add to the attributes a bit and a string array.
+void AddBitAndStringArrays(vtkDataSetAttributes* attributes, vtkIdType numTuples)
+{
+  vtkNew<vtkBitArray> flags;
+  flags->SetName("Flags");
+  vtkNew<vtkStringArray> labels;
+  labels->SetName("Labels");
+  for (vtkIdType i = 0; i < numTuples; ++i)
+  {
+    flags->InsertNextValue(i % 3 == 0);
+    labels->InsertNextValue(std::to_string(i));
+  }
+  attributes->AddArray(flags);
+  attributes->AddArray(labels);
+}
+
+// A grid of hexahedra alternating with cubes split in tetrahedra, followed by
+// triangles and lines on its points.
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid(int n)
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        const double x[3] = { i / (n - 1.0), j / (n - 1.0), k / (n - 1.0) };
+        points->InsertNextPoint(x);
+        const double s = std::sin(3 * x[0]) + std::cos(2 * x[1]) * x[2];
+        scalars->InsertNextValue(s);
+        vectors->InsertNextTuple3(x[0], 2 * x[1], s);
+      }
+    }
+  }
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->GetPointData()->SetScalars(scalars);
+  grid->GetPointData()->AddArray(vectors);
+
+  const vtkIdType tetras[6][4] = { { 0, 1, 3, 7 }, { 0, 3, 2, 7 }, { 0, 2, 6, 7 },
+    { 0, 6, 4, 7 }, { 0, 4, 5, 7 }, { 0, 5, 1, 7 } };
+  for (int k = 0; k < n - 1; ++k)
+  {
+    for (int j = 0; j < n - 1; ++j)
+    {
+      for (int i = 0; i < n - 1; ++i)
+      {
+        vtkIdType corners[8];
+        for (int c = 0; c < 8; ++c)
+        {
+          corners[c] = (i + (c & 1)) + (j + ((c >> 1) & 1)) * n + (k + ((c >> 2) & 1)) * n * n;
+        }
+        if ((i + j + k) % 2 == 0)
+        {
+          const vtkIdType hexahedron[8] = { corners[0], corners[1], corners[3], corners[2],
+            corners[4], corners[5], corners[7], corners[6] };
+          grid->InsertNextCell(VTK_HEXAHEDRON, 8, hexahedron);
+          continue;
+        }
+        for (const auto& tetra : tetras)
+        {
+          const vtkIdType ptIds[4] = { corners[tetra[0]], corners[tetra[1]], corners[tetra[2]],
+            corners[tetra[3]] };
+          grid->InsertNextCell(VTK_TETRA, 4, ptIds);
+        }
+      }
+    }
+  }
+  for (vtkIdType i = 0; i < n * n; i += 3)
+  {
+    const vtkIdType triangle[3] = { i, i + 1, i + n };
+    grid->InsertNextCell(VTK_TRIANGLE, 3, triangle);
+    const vtkIdType line[2] = { i, i + n * n + 1 };
+    grid->InsertNextCell(VTK_LINE, 2, line);
+  }
+
+  vtkNew<vtkIntArray> cellIds;
+  cellIds->SetName("Ids");
+  cellIds->SetNumberOfValues(grid->GetNumberOfCells());
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    cellIds->SetValue(cellId, static_cast<int>(cellId));
+  }
+  grid->GetCellData()->AddArray(cellIds);
+  AddBitAndStringArrays(grid->GetPointData(), grid->GetNumberOfPoints());
+  AddBitAndStringArrays(grid->GetCellData(), grid->GetNumberOfCells());
+  return grid;
+}
+
+// Compares the outputs without their cell data.
+bool CompareWithoutCellData(vtkPolyData* a, vtkPolyData* b)
+{
+  vtkNew<vtkPolyData> aCopy;
+  aCopy->ShallowCopy(a);
+  aCopy->GetCellData()->Initialize();
+  vtkNew<vtkPolyData> bCopy;
+  bCopy->ShallowCopy(b);
+  bCopy->GetCellData()->Initialize();
+  return vtkSMPTestUtilities::CompareOutputs(aCopy, bCopy);
+}
+}
+
+int TestContourGridThreaded(int, char*[])
+{
+  vtkSmartPointer<vtkUnstructuredGrid> grid = MakeGrid(24);
+  vtkNew<vtkPlane> plane;
+  plane->SetOrigin(0.5, 0.5, 0.5);
+  plane->SetNormal(1, 2, 3);
+
+  return vtkSMPTestUtilities::RunWithThreads([&](int numThreads) {
+    int status = 0;
+    for (int generateTriangles = 0; generateTriangles < 2; ++generateTriangles)
+    {
+      vtkNew<vtkPointLocator> contourLocator;
+      contourLocator->SetTolerance(0.0);
+      vtkNew<vtkContourGrid> serialContour;
+      serialContour->SetLocator(contourLocator);
+      vtkNew<vtkContourGrid> contour;
+      for (vtkContourGrid* filter : { serialContour.Get(), contour.Get() })
+      {
+        filter->SetInputData(grid);
+        filter->SetGenerateTriangles(generateTriangles);
+        filter->SetNumberOfContours(3);
+        for (int i = 0; i < 3; ++i)
+        {
+          filter->SetValue(i, 0.25 + 0.5 * i);
+        }
+        filter->Update();
+      }
+      if (contour->GetOutput()->GetNumberOfPolys() == 0 ||
+        !vtkSMPTestUtilities::CompareOutputs(serialContour->GetOutput(), contour->GetOutput()))
+      {
+        cerr << "Wrong contour with " << numThreads << " threads and triangles "
+             << generateTriangles << endl;
+        status = 1;
+      }
+
+      vtkNew<vtkPointLocator> cutterLocator;
+      cutterLocator->SetTolerance(0.0);
+      vtkNew<vtkCutter> serialCutter;
+      serialCutter->SetLocator(cutterLocator);
+      vtkNew<vtkCutter> cutter;
+      for (int sortBy : { VTK_SORT_BY_VALUE, VTK_SORT_BY_CELL })
+      {
+        for (vtkCutter* filter : { serialCutter.Get(), cutter.Get() })
+        {
+          filter->SetInputData(grid);
+          filter->SetCutFunction(plane);
+          filter->SetGenerateTriangles(generateTriangles);
+          filter->SetNumberOfContours(2);
+          filter->SetValue(0, -0.1);
+          filter->SetValue(1, 0.1);
+          filter->SetSortBy(sortBy);
+          filter->Update();
+        }
+        // Sorting by cell, the serial path numbers the cell data of each output
+        // cell after the verts and lines output so far, which misplaces some
+        // of it when the cells have mixed dimensions.
+        vtkPolyData* serialCut = serialCutter->GetOutput();
+        vtkPolyData* cut = cutter->GetOutput();
+        if (cut->GetNumberOfPolys() == 0 ||
+          !(sortBy == VTK_SORT_BY_VALUE ? vtkSMPTestUtilities::CompareOutputs(serialCut, cut)
+                                        : CompareWithoutCellData(serialCut, cut)))
+        {
+          cerr << "Wrong cut with " << numThreads << " threads, triangles " << generateTriangles
+               << " and sort by " << sortBy << endl;
+          status = 1;
+        }
+      }
+    }
+    return status;
+  });
+}
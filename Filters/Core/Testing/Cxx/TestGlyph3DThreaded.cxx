@@ -0,0 +1,265 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestGlyph3DThreaded.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Checks that the glyphs generated in parallel by vtkGlyph3D and
+// vtkTensorGlyph, with one or several threads, are the glyphs generated for
+// each input point on its own, appended in the order of the points, for
+// several scaling, orientation, masking and index modes. Point data with
+// string and bit arrays, which are copied on the calling thread, is checked
+// too.
+
+#include "vtkAppendPolyData.h"
+#include "vtkBitArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkGlyph3D.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkStringArray.h"
+#include "vtkTensorGlyph.h"
+#include "vtkTransform.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cmath>
+#include <functional>
+#include <string>
+
+namespace
+{
+// More points than glyphed by a single task, some of them masked as
+// duplicated ghost points, with a zero vector every few points.
+vtkSmartPointer<vtkPolyData> MakeInput()
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkFloatArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vtkNew<vtkDoubleArray> tensors;
+  tensors->SetName("Tensors");
+  tensors->SetNumberOfComponents(9);
+  vtkNew<vtkIntArray> ids;
+  ids->SetName("Ids");
+  vtkNew<vtkUnsignedCharArray> ghosts;
+  ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  for (int i = 0; i < 2500; ++i)
+  {
+    const double a = std::sin(0.3 * i);
+    const double b = std::cos(0.7 * i);
+    points->InsertNextPoint(10 * a, 10 * b, 0.01 * i);
+    scalars->InsertNextValue(std::abs(std::sin(0.11 * i)) * 1.2 - 0.1);
+    if (i % 11 == 0)
+    {
+      vectors->InsertNextTuple3(0, 0, 0);
+    }
+    else
+    {
+      vectors->InsertNextTuple3(a, i % 7 == 0 ? 0.0 : b, i % 7 == 0 ? 0.0 : 0.3);
+    }
+    tensors->InsertNextTuple9(1 + a, b, 0.2, b, 2 - a, a * b, 0.2, a * b, -0.5 + b);
+    ids->InsertNextValue(i);
+    ghosts->InsertNextValue(i % 13 == 0 ? vtkDataSetAttributes::DUPLICATEPOINT : 0);
+  }
+  auto input = vtkSmartPointer<vtkPolyData>::New();
+  input->SetPoints(points);
+  input->GetPointData()->SetScalars(scalars);
+  input->GetPointData()->SetVectors(vectors);
+  input->GetPointData()->SetTensors(tensors);
+  input->GetPointData()->AddArray(ids);
+  input->GetPointData()->AddArray(ghosts);
+  return input;
+}
+
+// A glyph with several types of cells.
+vtkSmartPointer<vtkPolyData> MakeMixedGlyph()
+{
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(0, 0, 0);
+  points->InsertNextPoint(1, 0, 0);
+  points->InsertNextPoint(0, 1, 0);
+  points->InsertNextPoint(0, 0, 1);
+  auto glyph = vtkSmartPointer<vtkPolyData>::New();
+  glyph->SetPoints(points);
+  glyph->AllocateEstimate(4, 3);
+  const vtkIdType ids[3] = { 0, 1, 2 };
+  const vtkIdType line[2] = { 0, 3 };
+  glyph->InsertNextCell(VTK_TRIANGLE, 3, ids);
+  glyph->InsertNextCell(VTK_LINE, 2, line);
+  glyph->InsertNextCell(VTK_VERTEX, 1, ids);
+  glyph->InsertNextCell(VTK_POLY_LINE, 3, ids);
+  return glyph;
+}
+
+vtkSmartPointer<vtkPolyData> ExtractPoint(vtkPolyData* input, vtkIdType ptId)
+{
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(input->GetPoint(ptId));
+  auto point = vtkSmartPointer<vtkPolyData>::New();
+  point->SetPoints(points);
+  point->GetPointData()->CopyAllocate(input->GetPointData(), 1);
+  point->GetPointData()->CopyData(input->GetPointData(), ptId, 0);
+  return point;
+}
+
+// Glyph each point of the input on its own and append the glyphs.
+vtkSmartPointer<vtkPolyData> GlyphPointByPoint(
+  vtkPolyData* input, vtkPolyDataAlgorithm* filter, int numberOfPoints)
+{
+  vtkNew<vtkAppendPolyData> append;
+  vtkSMPTools::Initialize(1);
+  for (vtkIdType ptId = 0; ptId < numberOfPoints; ++ptId)
+  {
+    filter->SetInputData(ExtractPoint(input, ptId));
+    filter->Update();
+    if (filter->GetOutput()->GetNumberOfPoints() > 0)
+    {
+      vtkNew<vtkPolyData> glyph;
+      glyph->DeepCopy(filter->GetOutput());
+      // The glyphed point is the first one of its input, restore its id.
+      if (vtkDataArray* ids = glyph->GetPointData()->GetArray("InputPointIds"))
+      {
+        ids->Fill(ptId);
+      }
+      append->AddInputData(glyph);
+    }
+  }
+  append->Update();
+  auto expected = vtkSmartPointer<vtkPolyData>::New();
+  expected->ShallowCopy(append->GetOutput());
+  return expected;
+}
+
+// Adds a string and a bit array to the point data of a copy of the data.
+vtkSmartPointer<vtkPolyData> WithStringAndBitArrays(vtkPolyData* data)
+{
+  auto copy = vtkSmartPointer<vtkPolyData>::New();
+  copy->ShallowCopy(data);
+  vtkNew<vtkStringArray> labels;
+  labels->SetName("Labels");
+  vtkNew<vtkBitArray> flags;
+  flags->SetName("Flags");
+  for (vtkIdType ptId = 0; ptId < data->GetNumberOfPoints(); ++ptId)
+  {
+    labels->InsertNextValue("point " + std::to_string(ptId));
+    flags->InsertNextValue(ptId % 3 == 0);
+  }
+  copy->GetPointData()->AddArray(labels);
+  copy->GetPointData()->AddArray(flags);
+  return copy;
+}
+
+int TestFilter(vtkPolyData* input, vtkPolyDataAlgorithm* filter, const char* name)
+{
+  const int numberOfPoints = static_cast<int>(input->GetNumberOfPoints());
+  vtkSmartPointer<vtkPolyData> expected = GlyphPointByPoint(input, filter, numberOfPoints);
+  if (expected->GetNumberOfPoints() == 0)
+  {
+    cerr << "No glyphs for " << name << endl;
+    return 1;
+  }
+
+  filter->SetInputData(input);
+  return vtkSMPTestUtilities::RunWithThreads([&](int numThreads) {
+    filter->Modified();
+    filter->Update();
+    if (!vtkSMPTestUtilities::CompareOutputs(expected, filter->GetOutput()))
+    {
+      cerr << "Wrong glyphs for " << name << " with " << numThreads << " threads" << endl;
+      return 1;
+    }
+    return 0;
+  });
+}
+}
+
+int TestGlyph3DThreaded(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> input = MakeInput();
+  vtkSmartPointer<vtkPolyData> mixedGlyph = MakeMixedGlyph();
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(6);
+  sphere->SetPhiResolution(5);
+  sphere->Update();
+
+  int status = 0;
+
+  // Scaled by scalar and oriented by vector, with the input point ids and
+  // the point data of the input on the cells.
+  vtkNew<vtkGlyph3D> glyph;
+  glyph->SetSourceData(sphere->GetOutput());
+  glyph->SetScaleFactor(0.5);
+  glyph->GeneratePointIdsOn();
+  glyph->FillCellDataOn();
+  status |= TestFilter(input, glyph, "scalar scaling");
+
+  // Indexed by scalar, scaled by vector components with clamping, colored by
+  // vector magnitude, in double precision.
+  vtkNew<vtkGlyph3D> indexedGlyph;
+  indexedGlyph->SetSourceData(0, sphere->GetOutput());
+  indexedGlyph->SetSourceData(1, mixedGlyph);
+  indexedGlyph->SetSourceData(2, sphere->GetOutput());
+  indexedGlyph->SetIndexModeToScalar();
+  indexedGlyph->SetScaleModeToScaleByVectorComponents();
+  indexedGlyph->ClampingOn();
+  indexedGlyph->SetRange(0.1, 0.9);
+  indexedGlyph->SetColorModeToColorByVector();
+  indexedGlyph->SetOutputPointsPrecision(vtkAlgorithm::DOUBLE_PRECISION);
+  status |= TestFilter(input, indexedGlyph, "index mode");
+
+  // Facing the camera, with a source transform, the cell data of a glyph
+  // with several types of cells and colored by the input scalars.
+  vtkNew<vtkTransform> sourceTransform;
+  sourceTransform->RotateX(30.0);
+  vtkNew<vtkGlyph3D> cameraGlyph;
+  cameraGlyph->SetSourceData(mixedGlyph);
+  cameraGlyph->SetVectorModeToFollowCameraDirection();
+  double cameraPosition[3] = { 3.0, 4.0, 5.0 };
+  cameraGlyph->SetFollowedCameraPosition(cameraPosition);
+  cameraGlyph->SetSourceTransform(sourceTransform);
+  cameraGlyph->SetScaleModeToDataScalingOff();
+  cameraGlyph->SetColorModeToColorByScalar();
+  cameraGlyph->FillCellDataOn();
+  status |= TestFilter(input, cameraGlyph, "camera direction");
+
+  // Three mirrored tensor glyphs per point.
+  vtkNew<vtkTensorGlyph> tensorGlyph;
+  tensorGlyph->SetSourceData(sphere->GetOutput());
+  tensorGlyph->ThreeGlyphsOn();
+  tensorGlyph->SymmetricOn();
+  tensorGlyph->ClampScalingOn();
+  tensorGlyph->SetMaxScaleFactor(1.5);
+  tensorGlyph->SetColorModeToEigenvalues();
+  status |= TestFilter(input, tensorGlyph, "tensor glyphs");
+
+  // Point data that cannot be copied concurrently, on the points and cells
+  // of the glyphs, and as the scalars of the source of tensor glyphs.
+  status |= TestFilter(WithStringAndBitArrays(input), glyph, "string and bit arrays");
+  vtkSmartPointer<vtkPolyData> tensorSource = WithStringAndBitArrays(sphere->GetOutput());
+  tensorSource->GetPointData()->SetActiveScalars("Flags");
+  vtkNew<vtkTensorGlyph> copyingTensorGlyph;
+  copyingTensorGlyph->SetSourceData(tensorSource);
+  copyingTensorGlyph->ColorGlyphsOff();
+  status |= TestFilter(input, copyingTensorGlyph, "tensor glyphs copying bit arrays");
+
+  return status;
+}
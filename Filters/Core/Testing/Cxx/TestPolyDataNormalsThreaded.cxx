@@ -0,0 +1,133 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPolyDataNormalsThreaded.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Checks that vtkPolyDataNormals splits sharp edges, orders polygons
+// consistently and gives the same output whatever the number of threads.
+
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataNormals.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkSmartPointer.h"
+
+#include <cmath>
+#include <utility>
+
+namespace
+{
+// A roof: two planes of quads and triangles meeting at a right angle along
+// the ridge x = 0. One polygon out of seven is reversed.
+vtkSmartPointer<vtkPolyData> MakeRoof(int resolution)
+{
+  vtkNew<vtkPoints> points;
+  for (int j = 0; j <= resolution; ++j)
+  {
+    for (int i = -resolution; i <= resolution; ++i)
+    {
+      points->InsertNextPoint(i, j, -std::abs(i));
+    }
+  }
+  const int rowSize = 2 * resolution + 1;
+  vtkNew<vtkCellArray> polys;
+  for (int j = 0; j < resolution; ++j)
+  {
+    for (int i = 0; i + 1 < rowSize; ++i)
+    {
+      const vtkIdType a = j * rowSize + i;
+      vtkIdType quad[4] = { a, a + 1, a + rowSize + 1, a + rowSize };
+      if ((i + j) % 7 == 0)
+      {
+        std::swap(quad[1], quad[3]);
+      }
+      if (i % 3 == 0)
+      {
+        vtkIdType tri1[3] = { quad[0], quad[1], quad[2] };
+        vtkIdType tri2[3] = { quad[0], quad[2], quad[3] };
+        polys->InsertNextCell(3, tri1);
+        polys->InsertNextCell(3, tri2);
+      }
+      else
+      {
+        polys->InsertNextCell(4, quad);
+      }
+    }
+  }
+  auto roof = vtkSmartPointer<vtkPolyData>::New();
+  roof->SetPoints(points);
+  roof->SetPolys(polys);
+  return roof;
+}
+
+vtkSmartPointer<vtkPolyData> ComputeNormals(vtkPolyData* input)
+{
+  vtkNew<vtkPolyDataNormals> normals;
+  normals->SetInputData(input);
+  normals->SetFeatureAngle(30.0);
+  normals->SplittingOn();
+  normals->ConsistencyOn();
+  normals->ComputeCellNormalsOn();
+  normals->Update();
+  return normals->GetOutput();
+}
+}
+
+int TestPolyDataNormalsThreaded(int, char*[])
+{
+  const int resolution = 60;
+  vtkSmartPointer<vtkPolyData> roof = MakeRoof(resolution);
+  vtkSMPTestUtilities::OutputRecorder recorder;
+  return vtkSMPTestUtilities::RunWithThreads([&](int numThreads) {
+    vtkSmartPointer<vtkPolyData> output = ComputeNormals(roof);
+    int status = EXIT_SUCCESS;
+    if (!recorder.Check(output, numThreads))
+    {
+      status = EXIT_FAILURE;
+    }
+
+    // The points of the ridge are duplicated.
+    const vtkIdType expectedPts = roof->GetNumberOfPoints() + resolution + 1;
+    if (output->GetNumberOfPoints() != expectedPts)
+    {
+      cerr << "Expected " << expectedPts << " points after splitting, got "
+           << output->GetNumberOfPoints() << endl;
+      status = EXIT_FAILURE;
+    }
+
+    // Each point has the normal of its side of the roof, all pointing up or
+    // all pointing down.
+    vtkDataArray* normals = output->GetPointData()->GetNormals();
+    double n[3];
+    normals->GetTuple(0, n);
+    const double up = n[2] > 0 ? 1.0 : -1.0;
+    const double side = std::sqrt(0.5);
+    for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+    {
+      normals->GetTuple(i, n);
+      if (std::abs(std::abs(n[0]) - side) > 1e-6 || std::abs(n[1]) > 1e-6 ||
+        std::abs(n[2] - up * side) > 1e-6)
+      {
+        cerr << "Unexpected normal (" << n[0] << ", " << n[1] << ", " << n[2] << ") at point "
+             << i << " with " << numThreads << " threads" << endl;
+        status = EXIT_FAILURE;
+        break;
+      }
+    }
+    return status;
+  });
+}
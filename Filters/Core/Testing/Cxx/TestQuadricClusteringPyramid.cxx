@@ -0,0 +1,172 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestQuadricClusteringPyramid.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Compares the levels of vtkQuadricClusteringPyramid with vtkQuadricClustering
+// run on the same bins, for a sphere made of polygons or of triangle strips.
+// The finest level must be identical, and the coarser ones, whose quadrics
+// are summed in another order, must have the same cells and close points.
+// The pyramid must not depend on the number of threads.
+
+#include "vtkCompositeDataSet.h"
+#include "vtkInformation.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkQuadricClustering.h"
+#include "vtkQuadricClusteringPyramid.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkStripper.h"
+#include "vtkTimerLog.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+const int Divisions = 64;
+const int Levels = 4;
+
+// Whether the level has the cells of the clustered mesh and its points within
+// the tolerance, or is the same output when the tolerance is zero.
+bool CompareLevel(vtkPolyData* level, vtkPolyData* clustered, double tolerance)
+{
+  if (tolerance == 0.0)
+  {
+    return vtkSMPTestUtilities::CompareOutputs(clustered, level);
+  }
+  vtkDataArray* points = clustered->GetPoints()->GetData();
+  std::vector<double> expected(points->GetNumberOfValues());
+  for (vtkIdType i = 0; i < points->GetNumberOfValues(); ++i)
+  {
+    expected[i] = points->GetComponent(i / 3, i % 3);
+  }
+  return vtkSMPTestUtilities::CompareCells(clustered->GetPolys(), level->GetPolys()) &&
+    vtkSMPTestUtilities::CompareValues(level->GetPoints()->GetData(), expected, tolerance);
+}
+
+vtkSmartPointer<vtkMultiBlockDataSet> Pyramid(vtkPolyData* mesh, double& time)
+{
+  vtkNew<vtkQuadricClusteringPyramid> pyramid;
+  pyramid->SetInputData(mesh);
+  pyramid->SetNumberOfLevels(Levels);
+  pyramid->SetNumberOfDivisions(Divisions, Divisions, Divisions);
+  pyramid->AutoAdjustNumberOfDivisionsOff();
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  pyramid->Update();
+  timer->StopTimer();
+  time = timer->GetElapsedTime();
+  return pyramid->GetOutput();
+}
+
+// Cluster the mesh with vtkQuadricClustering for each level of the pyramid.
+int CheckLevels(vtkPolyData* mesh, vtkMultiBlockDataSet* pyramid)
+{
+  int status = EXIT_SUCCESS;
+  double bounds[6];
+  mesh->GetBounds(bounds);
+  vtkIdType numPolys = VTK_ID_MAX;
+  double clusteringTime = 0.0;
+  for (int level = 0; level < Levels; ++level)
+  {
+    vtkNew<vtkQuadricClustering> clustering;
+    clustering->SetInputData(mesh);
+    clustering->AutoAdjustNumberOfDivisionsOff();
+    if (level == 0)
+    {
+      clustering->SetNumberOfDivisions(Divisions, Divisions, Divisions);
+    }
+    else
+    {
+      const double scale = (1 << level) / static_cast<double>(Divisions);
+      clustering->SetDivisionOrigin(bounds[0], bounds[2], bounds[4]);
+      clustering->SetDivisionSpacing((bounds[1] - bounds[0]) * scale,
+        (bounds[3] - bounds[2]) * scale, (bounds[5] - bounds[4]) * scale);
+    }
+    vtkNew<vtkTimerLog> timer;
+    timer->StartTimer();
+    clustering->Update();
+    timer->StopTimer();
+    clusteringTime += timer->GetElapsedTime();
+
+    vtkPolyData* output = vtkPolyData::SafeDownCast(pyramid->GetBlock(level));
+    const std::string name = pyramid->GetMetaData(level)->Get(vtkCompositeDataSet::NAME());
+    if (!output || name != "Level " + std::to_string(level))
+    {
+      cerr << "Missing level " << level << endl;
+      return EXIT_FAILURE;
+    }
+    if (!CompareLevel(output, clustering->GetOutput(), level == 0 ? 0.0 : 1e-6))
+    {
+      cerr << "Level " << level << " has " << output->GetNumberOfPoints() << " points and "
+           << output->GetNumberOfPolys() << " triangles instead of "
+           << clustering->GetOutput()->GetNumberOfPoints() << " and "
+           << clustering->GetOutput()->GetNumberOfPolys() << endl;
+      status = EXIT_FAILURE;
+    }
+    if (output->GetNumberOfPolys() >= numPolys)
+    {
+      cerr << "Level " << level << " is not coarser than level " << level - 1 << endl;
+      status = EXIT_FAILURE;
+    }
+    numPolys = output->GetNumberOfPolys();
+  }
+  cout << "vtkQuadricClustering of the " << Levels << " levels: " << clusteringTime << " s"
+       << endl;
+  return status;
+}
+}
+
+int TestQuadricClusteringPyramid(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetRadius(0.5);
+  sphere->SetThetaResolution(400);
+  sphere->SetPhiResolution(200);
+  vtkNew<vtkStripper> stripper;
+  stripper->SetInputConnection(sphere->GetOutputPort());
+  stripper->Update();
+  sphere->Update();
+
+  vtkPolyData* meshes[2] = { sphere->GetOutput(), stripper->GetOutput() };
+  vtkSMPTestUtilities::OutputRecorder recorder;
+  return vtkSMPTestUtilities::RunWithThreads([&](int numThreads) {
+    int status = EXIT_SUCCESS;
+    for (int i = 0; i < 2; ++i)
+    {
+      double time;
+      vtkSmartPointer<vtkMultiBlockDataSet> pyramid = Pyramid(meshes[i], time);
+      cout << "Pyramid of the " << (i ? "strips" : "polygons") << " with " << numThreads
+           << " threads: " << time << " s" << endl;
+      if (numThreads == 1 && CheckLevels(meshes[i], pyramid) != EXIT_SUCCESS)
+      {
+        status = EXIT_FAILURE;
+      }
+      for (int level = 0; level < Levels; ++level)
+      {
+        vtkPolyData* output = vtkPolyData::SafeDownCast(pyramid->GetBlock(level));
+        if (!output || !recorder.Check(output, numThreads))
+        {
+          cerr << "Level " << level << " differs with " << numThreads << " threads" << endl;
+          status = EXIT_FAILURE;
+        }
+      }
+    }
+    return status;
+  });
+}
@@ -0,0 +1,148 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestQuadricDecimationThreaded.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Compares the decimation of a sphere by vtkQuadricDecimation in partitions
+// with its sequential decimation: the reduction is reached, the surface stays
+// closed and the distance to the sphere is similar. The partitioned result
+// must not depend on the number of threads. The times of both are printed.
+
+#include "vtkElevationFilter.h"
+#include "vtkFeatureEdges.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkQuadricDecimation.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkTimerLog.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+const double Radius = 0.5;
+const double Target = 0.9;
+
+// The largest distance of the points to the sphere.
+double MaxError(vtkPolyData* mesh)
+{
+  double error = 0.0;
+  for (vtkIdType ptId = 0; ptId < mesh->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    mesh->GetPoint(ptId, x);
+    error = std::max(error, std::abs(vtkMath::Norm(x) - Radius));
+  }
+  return error;
+}
+
+vtkIdType NumberOfBoundaryEdges(vtkPolyData* mesh)
+{
+  vtkNew<vtkFeatureEdges> edges;
+  edges->SetInputData(mesh);
+  edges->BoundaryEdgesOn();
+  edges->NonManifoldEdgesOn();
+  edges->FeatureEdgesOff();
+  edges->ManifoldEdgesOff();
+  edges->Update();
+  return edges->GetOutput()->GetNumberOfLines();
+}
+
+vtkSmartPointer<vtkPolyData> Decimate(
+  vtkPolyData* mesh, int numPartitions, bool attributes, double& time)
+{
+  vtkNew<vtkQuadricDecimation> decimate;
+  decimate->SetInputData(mesh);
+  decimate->SetTargetReduction(Target);
+  decimate->SetNumberOfPartitions(numPartitions);
+  decimate->SetAttributeErrorMetric(attributes);
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  decimate->Update();
+  timer->StopTimer();
+  time = timer->GetElapsedTime();
+  if (decimate->GetActualReduction() < Target)
+  {
+    cerr << "Reduction of " << decimate->GetActualReduction() << " with " << numPartitions
+         << " partitions" << endl;
+    return nullptr;
+  }
+  return decimate->GetOutput();
+}
+}
+
+int TestQuadricDecimationThreaded(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetRadius(Radius);
+  sphere->SetThetaResolution(200);
+  sphere->SetPhiResolution(100);
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(sphere->GetOutputPort());
+  elevation->SetLowPoint(0, 0, -Radius);
+  elevation->SetHighPoint(0, 0, Radius);
+  elevation->Update();
+  vtkPolyData* mesh = vtkPolyData::SafeDownCast(elevation->GetOutput());
+
+  double serialTime;
+  vtkSmartPointer<vtkPolyData> serial = Decimate(mesh, 1, false, serialTime);
+  if (!serial)
+  {
+    return EXIT_FAILURE;
+  }
+  const double serialError = MaxError(serial);
+  cout << "Sequential decimation: " << serial->GetNumberOfPolys() << " triangles, error "
+       << serialError << ", " << serialTime << " s" << endl;
+
+  vtkSMPTestUtilities::OutputRecorder recorder;
+  return vtkSMPTestUtilities::RunWithThreads([&](int numThreads) {
+    int status = EXIT_SUCCESS;
+    for (int attributes = 0; attributes < 2; ++attributes)
+    {
+      double time;
+      vtkSmartPointer<vtkPolyData> output = Decimate(mesh, 16, attributes != 0, time);
+      if (!output)
+      {
+        status = EXIT_FAILURE;
+        continue;
+      }
+      const double error = MaxError(output);
+      cout << "Decimation of 16 partitions with " << numThreads << " threads"
+           << (attributes ? " and attributes: " : ": ") << output->GetNumberOfPolys()
+           << " triangles, error " << error << ", " << time << " s" << endl;
+
+      if (NumberOfBoundaryEdges(output) != 0)
+      {
+        cerr << "The partitions were not stitched" << endl;
+        status = EXIT_FAILURE;
+      }
+      if (!attributes && error > 2 * serialError)
+      {
+        cerr << "The partitions are decimated with an error of " << error << " instead of "
+             << serialError << endl;
+        status = EXIT_FAILURE;
+      }
+      if (!recorder.Check(output, numThreads))
+      {
+        cerr << "The decimation differs with " << numThreads << " threads" << endl;
+        status = EXIT_FAILURE;
+      }
+    }
+    return status;
+  });
+}
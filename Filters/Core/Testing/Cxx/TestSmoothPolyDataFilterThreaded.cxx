@@ -0,0 +1,203 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSmoothPolyDataFilterThreaded.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Checks that vtkSmoothPolyDataFilter moves each point from the positions of
+// the previous iteration toward the mean of its neighbors, and that it and
+// vtkWindowedSincPolyDataFilter give the same output whatever the number of
+// threads, for a mesh with feature edges, boundaries, lines and vertices.
+
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPlaneSource.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkSmartPointer.h"
+#include "vtkSmoothPolyDataFilter.h"
+#include "vtkWindowedSincPolyDataFilter.h"
+
+#include <cmath>
+
+namespace
+{
+const int Resolution = 40;
+
+// A bumpy plane of quads, with a ridge along its middle row of points, a
+// polyline across it and a few vertices.
+vtkSmartPointer<vtkPolyData> MakeMesh(bool withLinesAndVerts)
+{
+  vtkNew<vtkPlaneSource> plane;
+  plane->SetResolution(Resolution, Resolution);
+  plane->SetOutputPointsPrecision(vtkAlgorithm::DOUBLE_PRECISION);
+  plane->Update();
+
+  auto mesh = vtkSmartPointer<vtkPolyData>::New();
+  mesh->DeepCopy(plane->GetOutput());
+  vtkPoints* points = mesh->GetPoints();
+  for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    points->GetPoint(ptId, x);
+    x[2] = 0.02 * std::sin(20 * x[0]) * std::cos(15 * x[1]) + (x[1] > 0 ? 0.5 : -0.5) * x[1];
+    points->SetPoint(ptId, x);
+  }
+
+  if (withLinesAndVerts)
+  {
+    vtkNew<vtkCellArray> lines;
+    lines->InsertNextCell(Resolution - 10);
+    for (vtkIdType i = 5; i < Resolution - 5; ++i)
+    {
+      lines->InsertCellPoint(i * (Resolution + 1) + i);
+    }
+    mesh->SetLines(lines);
+    vtkNew<vtkCellArray> verts;
+    for (vtkIdType ptId = 100; ptId < points->GetNumberOfPoints(); ptId += 300)
+    {
+      verts->InsertNextCell(1, &ptId);
+    }
+    mesh->SetVerts(verts);
+  }
+  return mesh;
+}
+
+// One Laplacian iteration: interior points move toward the mean of their 4
+// neighbors, boundary points toward the mean of their 2 boundary neighbors,
+// and the corners are fixed.
+int CheckOneIteration(vtkPolyData* mesh)
+{
+  const double factor = 0.5;
+  vtkNew<vtkSmoothPolyDataFilter> smooth;
+  smooth->SetInputData(mesh);
+  smooth->SetNumberOfIterations(1);
+  smooth->SetRelaxationFactor(factor);
+  smooth->SetEdgeAngle(60.0);
+  smooth->Update();
+  vtkPoints* inPts = mesh->GetPoints();
+  vtkPoints* outPts = smooth->GetOutput()->GetPoints();
+
+  const int n = Resolution + 1;
+  for (int j = 0; j < n; ++j)
+  {
+    for (int i = 0; i < n; ++i)
+    {
+      const bool iBoundary = i == 0 || i == n - 1;
+      const bool jBoundary = j == 0 || j == n - 1;
+      double x[3], mean[3] = { 0, 0, 0 }, y[3];
+      inPts->GetPoint(i + j * n, x);
+      int numNeighbors = 0;
+      for (const auto& step : { std::make_pair(-1, 0), std::make_pair(1, 0),
+             std::make_pair(0, -1), std::make_pair(0, 1) })
+      {
+        const int ni = i + step.first;
+        const int nj = j + step.second;
+        if (ni < 0 || ni >= n || nj < 0 || nj >= n || (iBoundary && step.first != 0) ||
+          (jBoundary && !iBoundary && step.second != 0))
+        {
+          continue;
+        }
+        inPts->GetPoint(ni + nj * n, y);
+        for (int k = 0; k < 3; ++k)
+        {
+          mean[k] += y[k];
+        }
+        ++numNeighbors;
+      }
+      double expected[3];
+      for (int k = 0; k < 3; ++k)
+      {
+        expected[k] =
+          iBoundary && jBoundary ? x[k] : x[k] + factor * (mean[k] / numNeighbors - x[k]);
+      }
+      outPts->GetPoint(i + j * n, y);
+      if (std::abs(y[0] - expected[0]) > 1e-12 || std::abs(y[1] - expected[1]) > 1e-12 ||
+        std::abs(y[2] - expected[2]) > 1e-12)
+      {
+        cerr << "Wrong smoothed point " << i + j * n << endl;
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+}
+
+int TestSmoothPolyDataFilterThreaded(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> mesh = MakeMesh(true);
+  int status = CheckOneIteration(MakeMesh(false));
+
+  vtkSMPTestUtilities::OutputRecorder recorder;
+  status |= vtkSMPTestUtilities::RunWithThreads([&](int numThreads) {
+    vtkNew<vtkSmoothPolyDataFilter> smooth;
+    smooth->SetInputData(mesh);
+    smooth->SetNumberOfIterations(30);
+    smooth->SetRelaxationFactor(0.2);
+    smooth->FeatureEdgeSmoothingOn();
+    smooth->SetFeatureAngle(30.0);
+    smooth->GenerateErrorScalarsOn();
+    smooth->GenerateErrorVectorsOn();
+    smooth->Update();
+
+    vtkNew<vtkSmoothPolyDataFilter> constrained;
+    constrained->SetInputData(mesh);
+    constrained->SetSourceData(MakeMesh(false));
+    constrained->SetNumberOfIterations(10);
+    constrained->SetRelaxationFactor(0.5);
+    constrained->Update();
+
+    vtkNew<vtkWindowedSincPolyDataFilter> sinc;
+    sinc->SetInputData(mesh);
+    sinc->SetNumberOfIterations(20);
+    sinc->FeatureEdgeSmoothingOn();
+    sinc->SetFeatureAngle(30.0);
+    sinc->NormalizeCoordinatesOn();
+    sinc->GenerateErrorScalarsOn();
+    sinc->GenerateErrorVectorsOn();
+    sinc->Update();
+
+    int runStatus = 0;
+    vtkPolyData* outputs[3] = { smooth->GetOutput(), constrained->GetOutput(), sinc->GetOutput() };
+    for (int i = 0; i < 3; ++i)
+    {
+      vtkPolyData* output = outputs[i];
+      if (vtkSMPTestUtilities::CompareArrays(
+            output->GetPoints()->GetData(), mesh->GetPoints()->GetData()))
+      {
+        cerr << "Output " << i << " was not smoothed" << endl;
+        runStatus = 1;
+      }
+      // The vertices are fixed, up to the single precision of vtkWindowedSincPolyDataFilter.
+      double x[3], y[3];
+      mesh->GetPoint(100, x);
+      output->GetPoint(100, y);
+      if (vtkMath::Distance2BetweenPoints(x, y) > 1e-12)
+      {
+        cerr << "Vertex of output " << i << " was moved" << endl;
+        runStatus = 1;
+      }
+      if (!recorder.Check(output, numThreads))
+      {
+        cerr << "Output " << i << " differs with " << numThreads << " threads" << endl;
+        runStatus = 1;
+      }
+    }
+    return runStatus;
+  });
+  return status;
+}
@@ -0,0 +1,228 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestThresholdThreaded.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Checks that the threaded implementation of vtkThreshold gives the same
+// output as the sequential one, for all the threshold methods and component
+// modes. A bit array, which cannot be copied concurrently, forces the
+// sequential path.
+
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkSmartPointer.h"
+#include "vtkThreshold.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+
+namespace
+{
+// A lattice of hexahedra, tetrahedra and polyhedra, with empty cells and
+// unused points, and 2-component point and cell scalars.
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid()
+{
+  const int res = 10;
+  const int dim = res + 1;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> pointScalars;
+  pointScalars->SetName("PointScalars");
+  pointScalars->SetNumberOfComponents(2);
+  for (int k = 0; k < dim; ++k)
+  {
+    for (int j = 0; j < dim; ++j)
+    {
+      for (int i = 0; i < dim; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+        pointScalars->InsertNextTuple2(std::sin(0.7 * i + 0.3 * j) + k * 0.1, std::cos(0.5 * k));
+      }
+    }
+  }
+  // Unused points.
+  points->InsertNextPoint(-1, -1, -1);
+  pointScalars->InsertNextTuple2(0.0, 0.0);
+
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->GetPointData()->SetScalars(pointScalars);
+  grid->Allocate();
+  auto id = [dim](int i, int j, int k) -> vtkIdType { return i + dim * (j + dim * k); };
+  for (int k = 0; k < res; ++k)
+  {
+    for (int j = 0; j < res; ++j)
+    {
+      for (int i = 0; i < res; ++i)
+      {
+        const vtkIdType hex[8] = { id(i, j, k), id(i + 1, j, k), id(i + 1, j + 1, k),
+          id(i, j + 1, k), id(i, j, k + 1), id(i + 1, j, k + 1), id(i + 1, j + 1, k + 1),
+          id(i, j + 1, k + 1) };
+        switch ((i + 2 * j + 3 * k) % 4)
+        {
+          case 0:
+          {
+            const vtkIdType tet[4] = { hex[0], hex[1], hex[3], hex[4] };
+            grid->InsertNextCell(VTK_TETRA, 4, tet);
+            break;
+          }
+          case 1:
+          {
+            const vtkIdType faces[30] = { 4, hex[0], hex[3], hex[2], hex[1], 4, hex[4], hex[5],
+              hex[6], hex[7], 4, hex[0], hex[1], hex[5], hex[4], 4, hex[1], hex[2], hex[6], hex[5],
+              4, hex[2], hex[3], hex[7], hex[6], 4, hex[3], hex[0], hex[4], hex[7] };
+            grid->InsertNextCell(VTK_POLYHEDRON, 8, hex, 6, faces);
+            break;
+          }
+          case 2:
+            grid->InsertNextCell(VTK_EMPTY_CELL, 0, hex);
+            break;
+          default:
+            grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+            break;
+        }
+      }
+    }
+  }
+
+  vtkNew<vtkDoubleArray> cellScalars;
+  cellScalars->SetName("CellScalars");
+  cellScalars->SetNumberOfComponents(2);
+  vtkNew<vtkIntArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType i = 0; i < grid->GetNumberOfCells(); ++i)
+  {
+    cellScalars->InsertNextTuple2(std::sin(0.01 * i), std::cos(0.02 * i));
+    cellIds->InsertNextValue(static_cast<int>(i));
+  }
+  grid->GetCellData()->AddArray(cellScalars);
+  grid->GetCellData()->AddArray(cellIds);
+  return grid;
+}
+
+vtkSmartPointer<vtkImageData> MakeImage()
+{
+  auto image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(12, 9, 7);
+  vtkNew<vtkDoubleArray> pointScalars;
+  pointScalars->SetName("PointScalars");
+  pointScalars->SetNumberOfComponents(2);
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+  {
+    pointScalars->InsertNextTuple2(std::sin(0.1 * i), std::cos(0.03 * i));
+  }
+  image->GetPointData()->SetScalars(pointScalars);
+  vtkNew<vtkDoubleArray> cellScalars;
+  cellScalars->SetName("CellScalars");
+  cellScalars->SetNumberOfComponents(2);
+  for (vtkIdType i = 0; i < image->GetNumberOfCells(); ++i)
+  {
+    cellScalars->InsertNextTuple2(std::sin(0.01 * i), std::cos(0.02 * i));
+  }
+  image->GetCellData()->AddArray(cellScalars);
+  return image;
+}
+
+// Adds a bit array to the cell data so that the sequential path is used.
+vtkSmartPointer<vtkDataSet> WithBitArray(vtkDataSet* input)
+{
+  vtkSmartPointer<vtkDataSet> copy = vtk::TakeSmartPointer(input->NewInstance());
+  copy->ShallowCopy(input);
+  vtkSMPTestUtilities::AddSequentialArray(copy->GetCellData(), input->GetNumberOfCells());
+  return copy;
+}
+
+int TestInput(vtkDataSet* input)
+{
+  int status = 0;
+  vtkSmartPointer<vtkDataSet> sequentialInput = WithBitArray(input);
+  vtkNew<vtkThreshold> sequential;
+  sequential->SetInputData(sequentialInput);
+  vtkNew<vtkThreshold> threaded;
+  threaded->SetInputData(input);
+  for (int association = 0; association < 2; ++association)
+  {
+    for (int method = 0; method < 3; ++method)
+    {
+      for (int mode = VTK_COMPONENT_MODE_USE_SELECTED; mode <= VTK_COMPONENT_MODE_USE_ANY; ++mode)
+      {
+        for (int options = 0; options < 16; ++options)
+        {
+          for (vtkThreshold* threshold : { sequential.Get(), threaded.Get() })
+          {
+            if (association == 0)
+            {
+              threshold->SetInputArrayToProcess(
+                0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "PointScalars");
+            }
+            else
+            {
+              threshold->SetInputArrayToProcess(
+                0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, "CellScalars");
+            }
+            switch (method)
+            {
+              case 0:
+                threshold->ThresholdByLower(0.2);
+                break;
+              case 1:
+                threshold->ThresholdByUpper(0.4);
+                break;
+              default:
+                threshold->ThresholdBetween(-0.3, 0.5);
+                break;
+            }
+            threshold->SetComponentMode(mode);
+            threshold->SetSelectedComponent(1);
+            threshold->SetAllScalars(options & 1);
+            threshold->SetUseContinuousCellRange((options & 2) != 0);
+            threshold->SetInvert((options & 4) != 0);
+            threshold->SetCompactPoints((options & 8) == 0);
+            threshold->Update();
+          }
+          if (!vtkSMPTestUtilities::CompareOutputs(sequential->GetOutput(), threaded->GetOutput()))
+          {
+            cerr << "Outputs differ for association " << association << ", method " << method
+                 << ", component mode " << mode << ", options " << options << endl;
+            status = 1;
+          }
+        }
+      }
+    }
+  }
+
+  // Without compaction, the points of a point set are passed without copy.
+  threaded->CompactPointsOff();
+  threaded->Update();
+  vtkPointSet* pointSet = vtkPointSet::SafeDownCast(input);
+  if (pointSet && threaded->GetOutput()->GetPoints() != pointSet->GetPoints())
+  {
+    cerr << "The input points are not passed to the output." << endl;
+    status = 1;
+  }
+  return status;
+}
+}
+
+int TestThresholdThreaded(int, char*[])
+{
+  vtkSmartPointer<vtkUnstructuredGrid> grid = MakeGrid();
+  vtkSmartPointer<vtkImageData> image = MakeImage();
+  return vtkSMPTestUtilities::RunWithThreads(
+    [&](int) { return TestInput(grid) | TestInput(image); });
+}
@@ -16,20 +16,33 @@
 
 #include "vtkBoundingBox.h"
 #include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDataSetCollection.h"
 #include "vtkExecutive.h"
-#include "vtkIncrementalOctreePointLocator.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMath.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSMPFiltersInternal.h" // For CopyTuples
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <numeric>
 #include <string>
+#include <utility>
+#include <vector>
 
 vtkStandardNewMacro(vtkAppendFilter);
 
@@ -102,6 +115,279 @@ vtkDataSetCollection* vtkAppendFilter::GetInputList()
   return this->InputList;
 }
 
+//----------------------------------------------------------------------------
+namespace
+{
+// The number of points or cells of an input processed by each task of the
+// threaded append.
+const vtkIdType APPEND_CHUNK_SIZE = 65536;
+
+// A range of the points or cells of an input. For cells, the sizes and then
+// the offsets of their connectivity and face streams in the output, and the
+// cells gathered before they are copied to the output when they cannot be
+// copied as is.
+struct AppendChunk
+{
+  int Input;
+  vtkIdType Begin;
+  vtkIdType End;
+  vtkIdType ConnectivitySize = 0;
+  vtkIdType FacesSize = 0;
+  vtkIdType ConnectivityOffset = 0;
+  vtkIdType FacesOffset = 0;
+  std::vector<vtkIdType> Connectivity;
+  std::vector<vtkIdType> FaceLocations;
+  std::vector<vtkIdType> Faces;
+
+  AppendChunk(int input, vtkIdType begin, vtkIdType end)
+    : Input(input)
+    , Begin(begin)
+    , End(end)
+  {
+  }
+};
+
+void AddAppendChunks(std::vector<AppendChunk>& chunks, int input, vtkIdType size)
+{
+  for (vtkIdType begin = 0; begin < size; begin += APPEND_CHUNK_SIZE)
+  {
+    chunks.emplace_back(input, begin, std::min(begin + APPEND_CHUNK_SIZE, size));
+  }
+}
+
+// Copy the cells [begin, end) of a cell array to the output offsets and
+// connectivity, from the connectivity offset connOffset on, mapping their
+// point ids to the output ones.
+struct CopyCellsImpl
+{
+  template <typename CellStateT>
+  void operator()(CellStateT& state, vtkIdType begin, vtkIdType end, vtkIdType* outOffsets,
+    vtkIdType* outConn, vtkIdType connOffset, const vtkIdType* pointMap)
+  {
+    const vtkIdType connBegin = state.GetBeginOffset(begin);
+    const auto inOffsets = vtk::DataArrayValueRange<1>(state.GetOffsets(), begin, end);
+    std::transform(inOffsets.cbegin(), inOffsets.cend(), outOffsets,
+      [&](vtkIdType offset) { return offset - connBegin + connOffset; });
+    const auto inConn =
+      vtk::DataArrayValueRange<1>(state.GetConnectivity(), connBegin, state.GetEndOffset(end - 1));
+    std::transform(inConn.cbegin(), inConn.cend(), outConn + connOffset,
+      [&](vtkIdType ptId) { return pointMap[ptId]; });
+  }
+};
+
+// Get the type and the output point ids of a cell of an input, given the
+// output ids of the points of this input. For a polyhedron, also get its
+// output face stream; its point ids are then the sorted unique ids of its
+// faces, as vtkUnstructuredGrid::InsertNextCell() makes them.
+int GetOutputCell(vtkDataSet* dataSet, vtkIdType cellId, const vtkIdType* pointMap,
+  vtkIdList* ptIds, std::vector<vtkIdType>& faces)
+{
+  const int cellType = dataSet->GetCellType(cellId);
+  vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(dataSet);
+  if (ug && cellType == VTK_POLYHEDRON)
+  {
+    const vtkIdType* facePtIds = ug->GetFaces(cellId);
+    const vtkIdType nfaces = *facePtIds++;
+    faces.assign(1, nfaces);
+    ptIds->Reset();
+    for (vtkIdType face = 0; face < nfaces; ++face)
+    {
+      const vtkIdType nPoints = *facePtIds++;
+      faces.push_back(nPoints);
+      for (vtkIdType j = 0; j < nPoints; ++j)
+      {
+        faces.push_back(pointMap[facePtIds[j]]);
+        ptIds->InsertNextId(pointMap[facePtIds[j]]);
+      }
+      facePtIds += nPoints;
+    }
+    std::sort(ptIds->begin(), ptIds->end());
+    ptIds->SetNumberOfIds(std::unique(ptIds->begin(), ptIds->end()) - ptIds->begin());
+  }
+  else
+  {
+    faces.clear();
+    dataSet->GetCellPoints(cellId, ptIds);
+    for (vtkIdType& ptId : *ptIds)
+    {
+      ptId = pointMap[ptId];
+    }
+  }
+  return cellType;
+}
+
+// Merge the coincident points within a tolerance. On return, pointMap maps
+// each point to the point it is merged with, itself for the points that are
+// kept. As with vtkIncrementalOctreePointLocator::InsertUniquePoint(), the
+// points are processed in order and each point is merged with the closest
+// point kept before it within the tolerance.
+void MergeCoincidentPoints(vtkPoints* points, double tol, std::vector<vtkIdType>& pointMap)
+{
+  const vtkIdType numPts = points->GetNumberOfPoints();
+  vtkNew<vtkPolyData> pointSet;
+  pointSet->SetPoints(points);
+  vtkNew<vtkStaticPointLocator> locator;
+  locator->SetDataSet(pointSet);
+  locator->BuildLocator();
+  pointMap.resize(numPts);
+
+  if (tol <= 0.0)
+  {
+    // The classes of identical points are found concurrently, and their
+    // points are merged with the first one.
+    std::vector<vtkIdType> mergeMap(numPts);
+    locator->MergePoints(0.0, mergeMap.data());
+    std::vector<vtkIdType> firstIds(numPts, -1);
+    for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+    {
+      vtkIdType& firstId = firstIds[mergeMap[ptId]];
+      if (firstId < 0)
+      {
+        firstId = ptId;
+      }
+      pointMap[ptId] = firstId;
+    }
+    return;
+  }
+
+  // The points within the tolerance of each point, and before it, are found
+  // concurrently by blocks and sorted by distance. The greedy merge then
+  // goes through the points in order.
+  const vtkIdType numBlocks = (numPts - 1) / APPEND_CHUNK_SIZE + 1;
+  std::vector<std::vector<vtkIdType>> blockCandidates(numBlocks);
+  std::vector<vtkIdType> numCandidates(numPts);
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType beginBlock, vtkIdType endBlock) {
+    vtkNew<vtkIdList> nearby;
+    std::vector<std::pair<double, vtkIdType>> sorted;
+    for (vtkIdType block = beginBlock; block < endBlock; ++block)
+    {
+      std::vector<vtkIdType>& candidates = blockCandidates[block];
+      const vtkIdType endPtId = std::min((block + 1) * APPEND_CHUNK_SIZE, numPts);
+      for (vtkIdType ptId = block * APPEND_CHUNK_SIZE; ptId < endPtId; ++ptId)
+      {
+        double x[3], y[3];
+        points->GetPoint(ptId, x);
+        locator->FindPointsWithinRadius(tol, x, nearby);
+        sorted.clear();
+        for (vtkIdType nearId : *nearby)
+        {
+          if (nearId < ptId)
+          {
+            points->GetPoint(nearId, y);
+            sorted.emplace_back(vtkMath::Distance2BetweenPoints(x, y), nearId);
+          }
+        }
+        std::sort(sorted.begin(), sorted.end());
+        numCandidates[ptId] = static_cast<vtkIdType>(sorted.size());
+        for (const auto& candidate : sorted)
+        {
+          candidates.push_back(candidate.second);
+        }
+      }
+    }
+  });
+
+  for (vtkIdType block = 0, ptId = 0; block < numBlocks; ++block)
+  {
+    const vtkIdType* candidate = blockCandidates[block].data();
+    const vtkIdType endPtId = std::min((block + 1) * APPEND_CHUNK_SIZE, numPts);
+    for (; ptId < endPtId; ++ptId)
+    {
+      pointMap[ptId] = ptId;
+      for (vtkIdType i = 0; i < numCandidates[ptId]; ++i)
+      {
+        if (pointMap[candidate[i]] == candidate[i])
+        {
+          pointMap[ptId] = candidate[i];
+          break;
+        }
+      }
+      candidate += numCandidates[ptId];
+    }
+  }
+}
+
+// Copy the point or cell data common to all inputs to the output. The
+// tuples of the inputs are numbered one input after the other, from the
+// given offsets. When sourceIds is given, the output tuple i is copied from
+// the tuple sourceIds[i]; otherwise the tuples are copied in this order.
+void AppendArrays(vtkDataSetAttributes* outputData, int attributesType,
+  const std::vector<vtkDataSet*>& inputs, const std::vector<vtkIdType>& offsets,
+  const vtkIdType* sourceIds, vtkIdType totalNumberOfElements)
+{
+  vtkDataSetAttributes::FieldList fieldList;
+  for (vtkDataSet* dataSet : inputs)
+  {
+    fieldList.IntersectFieldList(dataSet->GetAttributes(attributesType));
+  }
+
+  // The arrays are given their final number of tuples so that they can be
+  // filled concurrently.
+  outputData->CopyAllocate(fieldList, totalNumberOfElements);
+  for (int i = 0; i < outputData->GetNumberOfArrays(); ++i)
+  {
+    outputData->GetAbstractArray(i)->SetNumberOfTuples(totalNumberOfElements);
+  }
+
+  const int numInputs = static_cast<int>(inputs.size());
+  std::vector<std::vector<std::pair<vtkAbstractArray*, vtkAbstractArray*>>> arrays(numInputs);
+  std::vector<AppendChunk> chunks;
+  for (int inputIndex = 0; inputIndex < numInputs; ++inputIndex)
+  {
+    vtkDataSetAttributes* inputData = inputs[inputIndex]->GetAttributes(attributesType);
+    fieldList.TransformData(inputIndex, inputData, outputData,
+      [&](vtkAbstractArray* in, vtkAbstractArray* out) {
+        arrays[inputIndex].emplace_back(in, out);
+      });
+    AddAppendChunks(chunks, inputIndex, offsets[inputIndex + 1] - offsets[inputIndex]);
+  }
+
+  // The arrays that cannot be written concurrently, such as bit or string
+  // arrays, are copied on the calling thread once the others are copied.
+  if (sourceIds != nullptr)
+  {
+    auto copyIds = [&](vtkIdType begin, vtkIdType end, bool inParallel) {
+      for (vtkIdType id = begin; id < end; ++id)
+      {
+        const auto inputIndex =
+          std::upper_bound(offsets.begin(), offsets.end(), sourceIds[id]) - offsets.begin() - 1;
+        const vtkIdType inputId = sourceIds[id] - offsets[inputIndex];
+        for (const auto& pair : arrays[inputIndex])
+        {
+          if (CanCopyTuplesInParallel(pair.second) == inParallel)
+          {
+            pair.second->SetTuple(id, inputId, pair.first);
+          }
+        }
+      }
+    };
+    vtkSMPTools::For(0, totalNumberOfElements,
+      [&](vtkIdType begin, vtkIdType end) { copyIds(begin, end, true); });
+    copyIds(0, totalNumberOfElements, false);
+    return;
+  }
+
+  auto copyChunks = [&](vtkIdType begin, vtkIdType end, bool inParallel) {
+    for (vtkIdType chunkId = begin; chunkId < end; ++chunkId)
+    {
+      const AppendChunk& chunk = chunks[chunkId];
+      for (const auto& pair : arrays[chunk.Input])
+      {
+        if (CanCopyTuplesInParallel(pair.second) == inParallel)
+        {
+          CopyTuples(
+            pair.second, pair.first, chunk.Begin, chunk.End, offsets[chunk.Input] + chunk.Begin);
+        }
+      }
+    }
+  };
+  const vtkIdType numChunks = static_cast<vtkIdType>(chunks.size());
+  vtkSMPTools::For(
+    0, numChunks, [&](vtkIdType begin, vtkIdType end) { copyChunks(begin, end, true); });
+  copyChunks(0, numChunks, false);
+}
+}
+
 //----------------------------------------------------------------------------
 // Append data sets into single unstructured grid
 int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
@@ -136,30 +422,26 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
 
   vtkDebugMacro(<< "Appending data together");
 
-  // Loop over all data sets, checking to see what data is common to
-  // all inputs. Note that data is common if 1) it is the same attribute
-  // type (scalar, vector, etc.), 2) it is the same native type (int,
-  // float, etc.), and 3) if a data array in a field, if it has the same name.
-  vtkIdType totalNumPts = 0;
-  vtkIdType totalNumCells = 0;
-  // If we only have a single dataset and it's an unstructured grid
-  // we can just shallow copy that and exit quickly.
-  int numDataSets = 0;
-  vtkUnstructuredGrid* inputUG = nullptr;
-
-  vtkSmartPointer<vtkDataSetCollection> inputs;
-  inputs.TakeReference(this->GetNonEmptyInputs(inputVector));
-
-  vtkCollectionSimpleIterator iter;
-  inputs->InitTraversal(iter);
-  vtkDataSet* dataSet = nullptr;
-  while ((dataSet = inputs->GetNextDataSet(iter)))
+  // Gather the non empty inputs, and the offsets of their points and cells
+  // in the output before points are merged.
+  std::vector<vtkDataSet*> inputs;
+  std::vector<vtkIdType> pointOffsets(1, 0);
+  std::vector<vtkIdType> cellOffsets(1, 0);
   {
-    totalNumPts += dataSet->GetNumberOfPoints();
-    totalNumCells += dataSet->GetNumberOfCells();
-    numDataSets++;
-    inputUG = vtkUnstructuredGrid::SafeDownCast(dataSet);
+    vtkSmartPointer<vtkDataSetCollection> inputList;
+    inputList.TakeReference(this->GetNonEmptyInputs(inputVector));
+    vtkCollectionSimpleIterator iter;
+    inputList->InitTraversal(iter);
+    while (vtkDataSet* dataSet = inputList->GetNextDataSet(iter))
+    {
+      inputs.push_back(dataSet);
+      pointOffsets.push_back(pointOffsets.back() + dataSet->GetNumberOfPoints());
+      cellOffsets.push_back(cellOffsets.back() + dataSet->GetNumberOfCells());
+    }
   }
+  const vtkIdType totalNumPts = pointOffsets.back();
+  const vtkIdType totalNumCells = cellOffsets.back();
+  const int numDataSets = static_cast<int>(inputs.size());
 
   if (totalNumPts < 1)
   {
@@ -167,17 +449,16 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
-  if (numDataSets == 1 && inputUG != nullptr)
+  // If we only have a single dataset and it's an unstructured grid
+  // we can just shallow copy that and exit quickly.
+  if (numDataSets == 1 && vtkUnstructuredGrid::SafeDownCast(inputs[0]) != nullptr)
   {
     vtkDebugMacro(
       << "Only a single unstructured grid in the composite dataset and we can shallow copy.");
-    output->ShallowCopy(inputUG);
+    output->ShallowCopy(inputs[0]);
     return 1;
   }
 
-  // Now we can allocate memory
-  output->Allocate(totalNumCells);
-
   vtkSmartPointer<vtkPoints> newPts = vtkSmartPointer<vtkPoints>::New();
 
   // set precision for the points in the output
@@ -211,132 +492,219 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
     newPts->SetDataType(VTK_DOUBLE);
   }
 
-  // If we aren't merging points, we need to allocate the points here.
-  if (!reallyMergePoints)
+  // Split the points and cells of the inputs in chunks processed
+  // concurrently. The dataset methods used concurrently are called once from
+  // this thread first, so that the inputs build their internal structures.
+  std::vector<AppendChunk> pointChunks;
+  std::vector<AppendChunk> cellChunks;
+  vtkNew<vtkIdList> ptIds;
+  for (int inputIndex = 0; inputIndex < numDataSets; ++inputIndex)
   {
-    newPts->SetNumberOfPoints(totalNumPts);
-  }
-
-  vtkSmartPointer<vtkIdList> ptIds = vtkSmartPointer<vtkIdList>::New();
-  ptIds->Allocate(VTK_CELL_SIZE);
-  vtkSmartPointer<vtkIdList> newPtIds = vtkSmartPointer<vtkIdList>::New();
-  newPtIds->Allocate(VTK_CELL_SIZE);
-
-  vtkIdType twentieth = (totalNumPts + totalNumCells) / 20 + 1;
-
-  // For optionally merging duplicate points
-  vtkIdType* globalIndices = new vtkIdType[totalNumPts];
-  vtkSmartPointer<vtkIncrementalOctreePointLocator> ptInserter;
-  if (reallyMergePoints)
-  {
-    vtkBoundingBox outputBB;
-
-    inputs->InitTraversal(iter);
-    while ((dataSet = inputs->GetNextDataSet(iter)))
+    vtkDataSet* dataSet = inputs[inputIndex];
+    AddAppendChunks(pointChunks, inputIndex, dataSet->GetNumberOfPoints());
+    AddAppendChunks(cellChunks, inputIndex, dataSet->GetNumberOfCells());
+    if (dataSet->GetNumberOfPoints() > 0)
     {
-
-      // Union of bounding boxes
-      double localBox[6];
-      dataSet->GetBounds(localBox);
-      outputBB.AddBounds(localBox);
+      double x[3];
+      dataSet->GetPoint(0, x);
     }
-
-    double outputBounds[6];
-    outputBB.GetBounds(outputBounds);
-
-    ptInserter = vtkSmartPointer<vtkIncrementalOctreePointLocator>::New();
-    if (this->ToleranceIsAbsolute)
-    {
-      ptInserter->SetTolerance(this->Tolerance);
-    }
-    else
+    if (dataSet->GetNumberOfCells() > 0)
     {
-      ptInserter->SetTolerance(this->Tolerance * outputBB.GetDiagonalLength());
+      dataSet->GetCellType(0);
+      dataSet->GetCellPoints(0, ptIds);
     }
-
-    ptInserter->InitPointInsertion(newPts, outputBounds);
   }
 
-  // append the blocks / pieces in terms of the geometry and topology
-  vtkIdType count = 0;
-  vtkIdType ptOffset = 0;
-  float decimal = 0.0;
-  inputs->InitTraversal(iter);
-  int abort = 0;
-  while (!abort && (dataSet = inputs->GetNextDataSet(iter)))
+  // Copy the points of the inputs one input after the other.
+  newPts->SetNumberOfPoints(totalNumPts);
+  vtkSMPTools::For(
+    0, static_cast<vtkIdType>(pointChunks.size()), [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType chunkId = begin; chunkId < end; ++chunkId)
+      {
+        const AppendChunk& chunk = pointChunks[chunkId];
+        vtkDataSet* dataSet = inputs[chunk.Input];
+        const vtkIdType offset = pointOffsets[chunk.Input];
+        if (vtkPointSet* ps = vtkPointSet::SafeDownCast(dataSet))
+        {
+          CopyTuples(newPts->GetData(), ps->GetPoints()->GetData(), chunk.Begin, chunk.End,
+            offset + chunk.Begin);
+          continue;
+        }
+        double x[3];
+        for (vtkIdType ptId = chunk.Begin; ptId < chunk.End; ++ptId)
+        {
+          dataSet->GetPoint(ptId, x);
+          newPts->SetPoint(offset + ptId, x);
+        }
+      }
+    });
+
+  // The output id of each input point, the input points being numbered one
+  // input after the other. When merging points, the output points keep the
+  // coordinates of the first point merged into them and the data of the last
+  // one, given by sourceIds.
+  std::vector<vtkIdType> pointMap;
+  std::vector<vtkIdType> sourceIds;
+  if (reallyMergePoints)
   {
-    vtkIdType dataSetNumPts = dataSet->GetNumberOfPoints();
-    vtkIdType dataSetNumCells = dataSet->GetNumberOfCells();
+    double tolerance = this->Tolerance;
+    if (!this->ToleranceIsAbsolute)
+    {
+      double bounds[6];
+      newPts->GetBounds(bounds);
+      tolerance *= vtkBoundingBox(bounds).GetDiagonalLength();
+    }
+    MergeCoincidentPoints(newPts, tolerance, pointMap);
 
-    // copy points
-    for (vtkIdType ptId = 0; ptId < dataSetNumPts && !abort; ++ptId)
+    std::vector<vtkIdType> keptIds;
+    for (vtkIdType ptId = 0; ptId < totalNumPts; ++ptId)
     {
-      if (reallyMergePoints)
+      if (pointMap[ptId] == ptId)
       {
-        vtkIdType globalPtId = 0;
-        ptInserter->InsertUniquePoint(dataSet->GetPoint(ptId), globalPtId);
-        globalIndices[ptId + ptOffset] = globalPtId;
-        // The point inserter puts the point into newPts, so we don't have to do that here.
+        pointMap[ptId] = static_cast<vtkIdType>(keptIds.size());
+        keptIds.push_back(ptId);
+        sourceIds.push_back(ptId);
       }
       else
       {
-        globalIndices[ptId + ptOffset] = ptId + ptOffset;
-        newPts->SetPoint(ptId + ptOffset, dataSet->GetPoint(ptId));
-      }
-
-      // Update progress
-      count++;
-      if (!(count % twentieth))
-      {
-        decimal += 0.05;
-        this->UpdateProgress(decimal);
-        abort = this->GetAbortExecute();
+        pointMap[ptId] = pointMap[pointMap[ptId]];
+        sourceIds[pointMap[ptId]] = ptId;
       }
     }
 
-    // copy cell
-    vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(dataSet);
-    for (vtkIdType cellId = 0; cellId < dataSetNumCells && !abort; ++cellId)
-    {
-      newPtIds->Reset();
-      if (ug && dataSet->GetCellType(cellId) == VTK_POLYHEDRON)
+    vtkSmartPointer<vtkPoints> mergedPts = vtkSmartPointer<vtkPoints>::New();
+    mergedPts->SetDataType(newPts->GetDataType());
+    mergedPts->SetNumberOfPoints(static_cast<vtkIdType>(keptIds.size()));
+    vtkSMPTools::For(
+      0, static_cast<vtkIdType>(keptIds.size()), [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType ptId = begin; ptId < end; ++ptId)
+        {
+          mergedPts->GetData()->SetTuple(ptId, keptIds[ptId], newPts->GetData());
+        }
+      });
+    newPts = mergedPts;
+  }
+  else
+  {
+    pointMap.resize(totalNumPts);
+    std::iota(pointMap.begin(), pointMap.end(), 0);
+  }
+  this->UpdateProgress(0.25);
+
+  // Allocate the cell types and offsets once. The cells of each chunk are
+  // then counted, and those not copied as is are gathered along with their
+  // types and offsets within the chunk.
+  vtkNew<vtkUnsignedCharArray> newTypes;
+  newTypes->SetNumberOfValues(totalNumCells);
+  vtkNew<vtkIdTypeArray> newOffsets;
+  newOffsets->SetNumberOfValues(totalNumCells + 1);
+  vtkSMPTools::For(
+    0, static_cast<vtkIdType>(cellChunks.size()), [&](vtkIdType begin, vtkIdType end) {
+      vtkNew<vtkIdList> cellPtIds;
+      std::vector<vtkIdType> faces;
+      for (vtkIdType chunkId = begin; chunkId < end; ++chunkId)
       {
-        vtkIdType nfaces;
-        const vtkIdType* facePtIds;
-        ug->GetFaceStream(cellId, nfaces, facePtIds);
-        for (vtkIdType id = 0; id < nfaces; ++id)
+        AppendChunk& chunk = cellChunks[chunkId];
+        vtkDataSet* dataSet = inputs[chunk.Input];
+        vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(dataSet);
+        if (ug && !ug->GetFaces())
         {
-          vtkIdType nPoints = facePtIds[0];
-          newPtIds->InsertNextId(nPoints);
-          for (vtkIdType j = 1; j <= nPoints; ++j)
+          vtkDataArray* offsets = ug->GetCells()->GetOffsetsArray();
+          chunk.ConnectivitySize = static_cast<vtkIdType>(
+            offsets->GetComponent(chunk.End, 0) - offsets->GetComponent(chunk.Begin, 0));
+          continue;
+        }
+        const vtkIdType* inputPointMap = pointMap.data() + pointOffsets[chunk.Input];
+        for (vtkIdType cellId = chunk.Begin; cellId < chunk.End; ++cellId)
+        {
+          const vtkIdType outCellId = cellOffsets[chunk.Input] + cellId;
+          const int cellType = GetOutputCell(dataSet, cellId, inputPointMap, cellPtIds, faces);
+          newTypes->SetValue(outCellId, static_cast<unsigned char>(cellType));
+          newOffsets->SetValue(outCellId, static_cast<vtkIdType>(chunk.Connectivity.size()));
+          chunk.Connectivity.insert(chunk.Connectivity.end(), cellPtIds->begin(), cellPtIds->end());
+          if (!faces.empty() && chunk.FaceLocations.empty())
           {
-            newPtIds->InsertNextId(globalIndices[facePtIds[j] + ptOffset]);
+            chunk.FaceLocations.resize(chunk.End - chunk.Begin, -1);
+          }
+          if (!faces.empty())
+          {
+            chunk.FaceLocations[cellId - chunk.Begin] = static_cast<vtkIdType>(chunk.Faces.size());
+            chunk.Faces.insert(chunk.Faces.end(), faces.begin(), faces.end());
           }
-          facePtIds += nPoints + 1;
         }
-        output->InsertNextCell(VTK_POLYHEDRON, nfaces, newPtIds->GetPointer(0));
+        chunk.ConnectivitySize = static_cast<vtkIdType>(chunk.Connectivity.size());
+        chunk.FacesSize = static_cast<vtkIdType>(chunk.Faces.size());
       }
-      else
+    });
+  vtkIdType connectivitySize = 0;
+  vtkIdType facesSize = 0;
+  for (AppendChunk& chunk : cellChunks)
+  {
+    chunk.ConnectivityOffset = connectivitySize;
+    chunk.FacesOffset = facesSize;
+    connectivitySize += chunk.ConnectivitySize;
+    facesSize += chunk.FacesSize;
+  }
+
+  // Fill the connectivity concurrently. The faces are only allocated if
+  // there are polyhedra.
+  newOffsets->SetValue(totalNumCells, connectivitySize);
+  vtkNew<vtkIdTypeArray> newConnectivity;
+  newConnectivity->SetNumberOfValues(connectivitySize);
+  vtkSmartPointer<vtkIdTypeArray> newFaceLocations;
+  vtkSmartPointer<vtkIdTypeArray> newFaces;
+  if (facesSize > 0)
+  {
+    newFaceLocations = vtkSmartPointer<vtkIdTypeArray>::New();
+    newFaceLocations->SetNumberOfValues(totalNumCells);
+    newFaces = vtkSmartPointer<vtkIdTypeArray>::New();
+    newFaces->SetNumberOfValues(facesSize);
+  }
+  vtkSMPTools::For(
+    0, static_cast<vtkIdType>(cellChunks.size()), [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType chunkId = begin; chunkId < end; ++chunkId)
       {
-        dataSet->GetCellPoints(cellId, ptIds);
-        for (vtkIdType id = 0; id < ptIds->GetNumberOfIds(); ++id)
+        AppendChunk& chunk = cellChunks[chunkId];
+        const vtkIdType outCellId = cellOffsets[chunk.Input] + chunk.Begin;
+        const vtkIdType numCells = chunk.End - chunk.Begin;
+        vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(inputs[chunk.Input]);
+        if (ug && !ug->GetFaces())
         {
-          newPtIds->InsertId(id, globalIndices[ptIds->GetId(id) + ptOffset]);
+          // The cells of unstructured grids without polyhedra are copied as is.
+          const unsigned char* types = ug->GetCellTypesArray()->GetPointer(0);
+          std::copy(types + chunk.Begin, types + chunk.End, newTypes->GetPointer(outCellId));
+          ug->GetCells()->Visit(CopyCellsImpl{}, chunk.Begin, chunk.End,
+            newOffsets->GetPointer(outCellId), newConnectivity->GetPointer(0),
+            chunk.ConnectivityOffset, pointMap.data() + pointOffsets[chunk.Input]);
+        }
+        else
+        {
+          vtkIdType* offsets = newOffsets->GetPointer(outCellId);
+          std::transform(offsets, offsets + numCells, offsets,
+            [&](vtkIdType offset) { return offset + chunk.ConnectivityOffset; });
+          std::copy(chunk.Connectivity.begin(), chunk.Connectivity.end(),
+            newConnectivity->GetPointer(chunk.ConnectivityOffset));
+          std::vector<vtkIdType>().swap(chunk.Connectivity);
+        }
+        if (newFaces)
+        {
+          vtkIdType* faceLocations = newFaceLocations->GetPointer(outCellId);
+          if (chunk.FaceLocations.empty())
+          {
+            std::fill_n(faceLocations, numCells, -1);
+            continue;
+          }
+          std::transform(chunk.FaceLocations.begin(), chunk.FaceLocations.end(), faceLocations,
+            [&](vtkIdType location) { return location < 0 ? -1 : location + chunk.FacesOffset; });
+          std::copy(
+            chunk.Faces.begin(), chunk.Faces.end(), newFaces->GetPointer(chunk.FacesOffset));
         }
-        output->InsertNextCell(dataSet->GetCellType(cellId), newPtIds);
-      }
-
-      // Update progress
-      count++;
-      if (!(count % twentieth))
-      {
-        decimal += 0.05;
-        this->UpdateProgress(decimal);
-        abort = this->GetAbortExecute();
       }
-    }
-    ptOffset += dataSetNumPts;
-  }
+    });
+  vtkNew<vtkCellArray> newCells;
+  newCells->SetData(newOffsets, newConnectivity);
+  output->SetCells(newTypes, newCells, newFaceLocations, newFaces);
+  this->UpdateProgress(0.5);
 
   // this filter can copy global ids except for global point ids when merging
   // points (see paraview/paraview#18666).
@@ -348,18 +716,17 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
   output->GetCellData()->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
 
   // Now copy the array data
-  this->AppendArrays(
-    vtkDataObject::POINT, inputVector, globalIndices, output, newPts->GetNumberOfPoints());
+  AppendArrays(output->GetPointData(), vtkDataObject::POINT, inputs, pointOffsets,
+    reallyMergePoints ? sourceIds.data() : nullptr, newPts->GetNumberOfPoints());
   this->UpdateProgress(0.75);
-  this->AppendArrays(vtkDataObject::CELL, inputVector, nullptr, output, output->GetNumberOfCells());
+  AppendArrays(
+    output->GetCellData(), vtkDataObject::CELL, inputs, cellOffsets, nullptr, totalNumCells);
   this->UpdateProgress(1.0);
 
   // Update ourselves and release memory
   output->SetPoints(newPts);
   output->Squeeze();
 
-  delete[] globalIndices;
-
   return 1;
 }
 
@@ -389,59 +756,6 @@ vtkDataSetCollection* vtkAppendFilter::GetNonEmptyInputs(vtkInformationVector**
   return collection;
 }
 
-//----------------------------------------------------------------------------
-void vtkAppendFilter::AppendArrays(int attributesType, vtkInformationVector** inputVector,
-  vtkIdType* globalIds, vtkUnstructuredGrid* output, vtkIdType totalNumberOfElements)
-{
-  // Check if attributesType is supported
-  if (attributesType != vtkDataObject::POINT && attributesType != vtkDataObject::CELL)
-  {
-    vtkErrorMacro(<< "Unhandled attributes type " << attributesType << ", must be either "
-                  << "vtkDataObject::POINT or vtkDataObject::CELL");
-    return;
-  }
-
-  vtkDataSetAttributes::FieldList fieldList;
-  auto inputs = vtkSmartPointer<vtkDataSetCollection>::Take(this->GetNonEmptyInputs(inputVector));
-  vtkCollectionSimpleIterator iter;
-  vtkDataSet* dataSet = nullptr;
-  for (dataSet = nullptr, inputs->InitTraversal(iter); (dataSet = inputs->GetNextDataSet(iter));)
-  {
-    if (auto inputData = dataSet->GetAttributes(attributesType))
-    {
-      fieldList.IntersectFieldList(inputData);
-    }
-  }
-
-  vtkDataSetAttributes* outputData = output->GetAttributes(attributesType);
-  outputData->CopyAllocate(fieldList, totalNumberOfElements);
-
-  // copy arrays.
-  int inputIndex;
-  vtkIdType offset = 0;
-  for (inputIndex = 0, dataSet = nullptr, inputs->InitTraversal(iter);
-       (dataSet = inputs->GetNextDataSet(iter));)
-  {
-    if (auto inputData = dataSet->GetAttributes(attributesType))
-    {
-      const auto numberOfInputTuples = inputData->GetNumberOfTuples();
-      if (globalIds != nullptr)
-      {
-        for (vtkIdType id = 0; id < numberOfInputTuples; ++id)
-        {
-          fieldList.CopyData(inputIndex, inputData, id, outputData, globalIds[offset + id]);
-        }
-      }
-      else
-      {
-        fieldList.CopyData(inputIndex, inputData, 0, numberOfInputTuples, outputData, offset);
-      }
-      offset += numberOfInputTuples;
-      ++inputIndex;
-    }
-  }
-}
-
 //----------------------------------------------------------------------------
 int vtkAppendFilter::RequestUpdateExtent(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* vtkNotUsed(outputVector))
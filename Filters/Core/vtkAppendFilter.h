@@ -23,6 +23,9 @@
  * (For example, if one dataset has scalars but another does not, scalars will
  * not be appended.)
  *
+ * The output is allocated once, and the points, cells and attributes of the
+ * inputs are copied into it concurrently using vtkSMPTools.
+ *
  * @sa
  * vtkAppendPolyData
  */
@@ -67,8 +70,9 @@ public:
    * Get/Set the tolerance to use to find coincident points when `MergePoints`
    * is `true`. Default is 0.0.
    *
-   * This is simply passed on to the internal vtkLocator used to merge points.
-   * @sa `vtkLocator::SetTolerance`.
+   * Coincident points are found with a vtkStaticPointLocator built in
+   * parallel. Each point within the tolerance of points kept before it is
+   * merged with the closest of them.
    */
   vtkSetClampMacro(Tolerance, double, 0.0, VTK_DOUBLE_MAX);
   vtkGetMacro(Tolerance, double);
@@ -137,9 +141,6 @@ private:
   // Get all input data sets that have points, cells, or both.
   // Caller must delete the returned vtkDataSetCollection.
   vtkDataSetCollection* GetNonEmptyInputs(vtkInformationVector** inputVector);
-
-  void AppendArrays(int attributesType, vtkInformationVector** inputVector, vtkIdType* globalIds,
-    vtkUnstructuredGrid* output, vtkIdType totalNumberOfElements);
 };
 
 #endif
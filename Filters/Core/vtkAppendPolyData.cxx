@@ -21,16 +21,23 @@
 #include "vtkCellData.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPFiltersInternal.h" // For CopyTuples
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTrivialProducer.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <utility>
+#include <vector>
 
 vtkStandardNewMacro(vtkAppendPolyData);
 
@@ -119,37 +126,84 @@ void vtkAppendPolyData::SetInputConnectionByNumber(int num, vtkAlgorithmOutput*
   this->SetNthInputConnection(0, num, input);
 }
 
+//----------------------------------------------------------------------------
+namespace
+{
+// The number of points or cells of an input copied by each task of the
+// threaded append.
+const vtkIdType APPEND_CHUNK_SIZE = 65536;
+
+// A range of the points, or of the cells of one type, of an input.
+struct AppendChunk
+{
+  int Input;
+  int Type;
+  vtkIdType Begin;
+  vtkIdType End;
+};
+
+void AddAppendChunks(std::vector<AppendChunk>& chunks, int input, int type, vtkIdType size)
+{
+  for (vtkIdType begin = 0; begin < size; begin += APPEND_CHUNK_SIZE)
+  {
+    chunks.push_back({ input, type, begin, std::min(begin + APPEND_CHUNK_SIZE, size) });
+  }
+}
+
+// Where the points and the cells of each type of an input go in the output,
+// and the pairs of input and output arrays of its point and cell data.
+struct AppendInput
+{
+  vtkPolyData* Input = nullptr;
+  vtkIdType PointOffset = 0;
+  vtkIdType CellOffsets[4] = { 0, 0, 0, 0 };
+  vtkIdType ConnectivityOffsets[4] = { 0, 0, 0, 0 };
+  vtkIdType InputCellOffsets[4] = { 0, 0, 0, 0 };
+  std::vector<std::pair<vtkAbstractArray*, vtkAbstractArray*>> PointArrays;
+  std::vector<std::pair<vtkAbstractArray*, vtkAbstractArray*>> CellArrays;
+};
+
+// Copy the cells [begin, end) of a cell array to the output offsets and
+// connectivity, from the connectivity offset connOffset on, shifting their
+// point ids by ptOffset.
+struct CopyCellsImpl
+{
+  template <typename CellStateT>
+  void operator()(CellStateT& state, vtkIdType begin, vtkIdType end, vtkIdType* outOffsets,
+    vtkIdType* outConn, vtkIdType connOffset, vtkIdType ptOffset)
+  {
+    const auto inOffsets = vtk::DataArrayValueRange<1>(state.GetOffsets(), begin, end);
+    std::transform(inOffsets.cbegin(), inOffsets.cend(), outOffsets,
+      [&](vtkIdType offset) { return offset + connOffset; });
+    const vtkIdType connBegin = state.GetBeginOffset(begin);
+    const auto inConn =
+      vtk::DataArrayValueRange<1>(state.GetConnectivity(), connBegin, state.GetEndOffset(end - 1));
+    std::transform(inConn.cbegin(), inConn.cend(), outConn + connOffset + connBegin,
+      [&](vtkIdType ptId) { return ptId + ptOffset; });
+  }
+};
+}
+
 //----------------------------------------------------------------------------
 int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output, vtkPolyData* inputs[], int numInputs)
 {
   int idx;
   vtkPolyData* ds;
-  vtkPoints* inPts;
-  vtkPoints* newPts;
-  vtkCellArray *inVerts, *newVerts;
-  vtkCellArray *inLines, *newLines;
-  vtkCellArray *inPolys, *newPolys;
-  vtkIdType sizePolys, numPolys;
-  vtkCellArray *inStrips, *newStrips;
-  vtkIdType numPts, numCells;
-  vtkPointData* inPD = nullptr;
-  vtkCellData* inCD = nullptr;
+  vtkIdType numPts = 0;
+  vtkIdType numCells = 0;
   vtkPointData* outputPD = output->GetPointData();
   vtkCellData* outputCD = output->GetCellData();
 
   vtkDebugMacro(<< "Appending polydata");
 
-  // loop over all data sets, checking to see what point data is available.
-  numPts = 0;
-  numCells = 0;
-  sizePolys = numPolys = 0;
+  // The number of cells and connectivity ids of each type of cells: verts,
+  // lines, polys and strips.
+  vtkIdType numTypeCells[4] = { 0, 0, 0, 0 };
+  vtkIdType sizeTypeCells[4] = { 0, 0, 0, 0 };
 
   int countPD = 0;
   int countCD = 0;
 
-  vtkIdType numVerts = 0, numLines = 0, numStrips = 0;
-  vtkIdType sizeLines = 0, sizeStrips = 0, sizeVerts = 0;
-
   // These Field lists are very picky.  Count the number of non empty inputs
   // so we can initialize them properly.
   for (idx = 0; idx < numInputs; ++idx)
@@ -172,72 +226,71 @@ int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output, vtkPolyData* inputs[],
   vtkDataSetAttributes::FieldList ptList(countPD);
   vtkDataSetAttributes::FieldList cellList(countCD);
 
+  // Compute where the points and cells of each input go in the output. Cells
+  // are output by type, so the cells of each type of an input follow those of
+  // the previous inputs.
+  std::vector<AppendInput> appendInputs;
+  appendInputs.reserve(numInputs);
   countPD = countCD = 0;
   for (idx = 0; idx < numInputs; ++idx)
   {
     ds = inputs[idx];
-    if (ds != nullptr)
+    if (ds == nullptr || (ds->GetNumberOfPoints() <= 0 && ds->GetNumberOfCells() <= 0))
     {
-      // Skip points and cells if there are no points.  Empty inputs may have no arrays.
-      if (ds->GetNumberOfPoints() > 0)
+      continue; // no input, just skip
+    }
+    AppendInput appendInput;
+    appendInput.Input = ds;
+    appendInput.PointOffset = numPts;
+
+    // Skip points and cells if there are no points.  Empty inputs may have no arrays.
+    if (ds->GetNumberOfPoints() > 0)
+    {
+      numPts += ds->GetNumberOfPoints();
+      // Take intersection of available point data fields.
+      if (countPD == 0)
       {
-        numPts += ds->GetNumberOfPoints();
-        // Take intersection of available point data fields.
-        inPD = ds->GetPointData();
-        if (countPD == 0)
-        {
-          ptList.InitializeFieldList(inPD);
-        }
-        else
-        {
-          ptList.IntersectFieldList(inPD);
-        }
-        ++countPD;
-      } // for a data set that has points
+        ptList.InitializeFieldList(ds->GetPointData());
+      }
+      else
+      {
+        ptList.IntersectFieldList(ds->GetPointData());
+      }
+      ++countPD;
+    } // for a data set that has points
 
-      // Although we cannot have cells without points ... let's not nest.
-      if (ds->GetNumberOfCells() > 0)
+    // Although we cannot have cells without points ... let's not nest.
+    if (ds->GetNumberOfCells() > 0)
+    {
+      vtkCellArray* cellArrays[4] = { ds->GetVerts(), ds->GetLines(), ds->GetPolys(),
+        ds->GetStrips() };
+      vtkIdType inputCellOffset = 0;
+      for (int type = 0; type < 4; ++type)
       {
-        if (ds->GetVerts())
-        {
-          sizeVerts += ds->GetVerts()->GetNumberOfConnectivityIds();
-        }
-        if (ds->GetLines())
-        {
-          sizeLines += ds->GetLines()->GetNumberOfConnectivityIds();
-        }
-        // keep track of the size of the poly cell array
-        if (ds->GetPolys())
-        {
-          sizePolys += ds->GetPolys()->GetNumberOfConnectivityIds();
-        }
-        if (ds->GetStrips())
+        appendInput.CellOffsets[type] = numTypeCells[type];
+        appendInput.ConnectivityOffsets[type] = sizeTypeCells[type];
+        appendInput.InputCellOffsets[type] = inputCellOffset;
+        if (cellArrays[type])
         {
-          sizeStrips += ds->GetStrips()->GetNumberOfConnectivityIds();
+          numTypeCells[type] += cellArrays[type]->GetNumberOfCells();
+          sizeTypeCells[type] += cellArrays[type]->GetNumberOfConnectivityIds();
+          inputCellOffset += cellArrays[type]->GetNumberOfCells();
         }
+      }
+      numCells += ds->GetNumberOfCells();
 
-        numCells += ds->GetNumberOfCells();
-        // Count the cells of each type.
-        // This is used to ensure that cell data is copied at the correct
-        // locations in the output.
-        numVerts += ds->GetNumberOfVerts();
-        numLines += ds->GetNumberOfLines();
-        numPolys += ds->GetNumberOfPolys();
-        numStrips += ds->GetNumberOfStrips();
-
-        inCD = ds->GetCellData();
-        if (countCD == 0)
-        {
-          cellList.InitializeFieldList(inCD);
-        }
-        else
-        {
-          cellList.IntersectFieldList(inCD);
-        }
-        ++countCD;
-      } // for a data set that has cells
-    }   // for a non nullptr input
-  }     // for each input
+      if (countCD == 0)
+      {
+        cellList.InitializeFieldList(ds->GetCellData());
+      }
+      else
+      {
+        cellList.IntersectFieldList(ds->GetCellData());
+      }
+      ++countCD;
+    } // for a data set that has cells
+    appendInputs.push_back(std::move(appendInput));
+  } // for each input
 
   if (numPts < 1 && numCells < 1)
   {
@@ -269,7 +322,7 @@ int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output, vtkPolyData* inputs[],
   }
 
   // Allocate geometry/topology
-  newPts = vtkPoints::New();
+  vtkNew<vtkPoints> newPts;
 
   // Set the desired precision for the points in the output.
   if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
@@ -287,40 +340,21 @@ int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output, vtkPolyData* inputs[],
 
   newPts->SetNumberOfPoints(numPts);
 
-  newVerts = vtkCellArray::New();
-  bool allocated = newVerts->AllocateExact(numVerts, sizeVerts);
-
-  if (sizeVerts > 0 && !allocated)
-  {
-    vtkErrorMacro(<< "Memory allocation failed in append filter");
-    return 0;
-  }
-
-  newLines = vtkCellArray::New();
-  allocated = newLines->AllocateExact(numLines, sizeLines);
-
-  if (sizeLines > 0 && !allocated)
-  {
-    vtkErrorMacro(<< "Memory allocation failed in append filter");
-    return 0;
-  }
-
-  newPolys = vtkCellArray::New();
-  allocated = newPolys->AllocateExact(numPolys, sizePolys);
-
-  if (sizePolys > 0 && !allocated)
-  {
-    vtkErrorMacro(<< "Memory allocation failed in append filter");
-    return 0;
-  }
-
-  newStrips = vtkCellArray::New();
-  allocated = newStrips->AllocateExact(numStrips, sizeStrips);
-
-  if (sizeStrips > 0 && !allocated)
+  // The offsets and connectivity of the verts, lines, polys and strips. They
+  // are allocated to their exact size, then filled concurrently.
+  vtkNew<vtkIdTypeArray> newOffsets[4];
+  vtkNew<vtkIdTypeArray> newConnectivity[4];
+  for (int type = 0; type < 4; ++type)
   {
-    vtkErrorMacro(<< "Memory allocation failed in append filter");
-    return 0;
+    if (!newOffsets[type]->Resize(numTypeCells[type] + 1) ||
+      !newConnectivity[type]->Resize(sizeTypeCells[type]))
+    {
+      vtkErrorMacro(<< "Memory allocation failed in append filter");
+      return 0;
+    }
+    newOffsets[type]->SetNumberOfValues(numTypeCells[type] + 1);
+    newOffsets[type]->SetValue(numTypeCells[type], sizeTypeCells[type]);
+    newConnectivity[type]->SetNumberOfValues(sizeTypeCells[type]);
   }
 
   // Since points are cells are not merged,
@@ -328,108 +362,142 @@ int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output, vtkPolyData* inputs[],
   outputPD->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
   outputCD->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
 
-  // Allocate the point and cell data
+  // Allocate the point and cell data. The arrays are given their final number
+  // of tuples so that the inputs can be copied to them concurrently.
   outputPD->CopyAllocate(ptList, numPts);
   outputCD->CopyAllocate(cellList, numCells);
+  for (int i = 0; i < outputPD->GetNumberOfArrays(); ++i)
+  {
+    outputPD->GetAbstractArray(i)->SetNumberOfTuples(numPts);
+  }
+  for (int i = 0; i < outputCD->GetNumberOfArrays(); ++i)
+  {
+    outputCD->GetAbstractArray(i)->SetNumberOfTuples(numCells);
+  }
 
-  // loop over all input sets
-  vtkIdType ptOffset = 0;
-  vtkIdType vertOffset = 0;
-  vtkIdType linesOffset = numVerts;
-  vtkIdType polysOffset = numVerts + numLines;
-  vtkIdType stripsOffset = numVerts + numLines + numPolys;
+  // Pair the arrays of each input with the output arrays, and split the
+  // points and cells of the inputs in chunks copied concurrently.
+  std::vector<AppendChunk> chunks;
   countPD = countCD = 0;
-  for (idx = 0; idx < numInputs; ++idx)
+  for (int i = 0; i < static_cast<int>(appendInputs.size()); ++i)
   {
-    this->UpdateProgress(0.2 + 0.8 * idx / numInputs);
-    ds = inputs[idx];
-    // this check is not necessary, but I'll put it in anyway
-    if (ds != nullptr)
+    AppendInput& appendInput = appendInputs[i];
+    ds = appendInput.Input;
+    if (ds->GetNumberOfPoints() > 0)
+    {
+      ptList.TransformData(countPD++, ds->GetPointData(), outputPD,
+        [&](vtkAbstractArray* in, vtkAbstractArray* out) {
+          appendInput.PointArrays.emplace_back(in, out);
+        });
+      AddAppendChunks(chunks, i, -1, ds->GetNumberOfPoints());
+    }
+    if (ds->GetNumberOfCells() > 0)
     {
-      numPts = ds->GetNumberOfPoints();
-      numCells = ds->GetNumberOfCells();
-      if (numPts <= 0 && numCells <= 0)
+      cellList.TransformData(countCD++, ds->GetCellData(), outputCD,
+        [&](vtkAbstractArray* in, vtkAbstractArray* out) {
+          appendInput.CellArrays.emplace_back(in, out);
+        });
+      vtkCellArray* cellArrays[4] = { ds->GetVerts(), ds->GetLines(), ds->GetPolys(),
+        ds->GetStrips() };
+      for (int type = 0; type < 4; ++type)
       {
-        continue; // no input, just skip
+        if (cellArrays[type])
+        {
+          AddAppendChunks(chunks, i, type, cellArrays[type]->GetNumberOfCells());
+        }
       }
+    }
+  }
 
-      inPD = ds->GetPointData();
-      inCD = ds->GetCellData();
-
-      inPts = ds->GetPoints();
-      inVerts = ds->GetVerts();
-      inLines = ds->GetLines();
-      inPolys = ds->GetPolys();
-      inStrips = ds->GetStrips();
+  // The output ids of the first cell of each type.
+  const vtkIdType outputCellOffsets[4] = { 0, numTypeCells[0], numTypeCells[0] + numTypeCells[1],
+    numTypeCells[0] + numTypeCells[1] + numTypeCells[2] };
 
-      if (ds->GetNumberOfPoints() > 0)
+  // Copy the point or cell data of a chunk held by the arrays that can, or
+  // cannot, be written concurrently.
+  auto copyChunkData = [&](const AppendChunk& chunk, bool inParallel) {
+    const AppendInput& appendInput = appendInputs[chunk.Input];
+    if (chunk.Type < 0)
+    {
+      const vtkIdType offset = appendInput.PointOffset + chunk.Begin;
+      for (const auto& arrays : appendInput.PointArrays)
       {
-        // copy points directly
-        this->AppendData(newPts->GetData(), inPts->GetData(), ptOffset);
-        outputPD->CopyData(ptList, inPD, countPD, ptOffset, numPts, 0);
-        ++countPD;
+        if (CanCopyTuplesInParallel(arrays.second) == inParallel)
+        {
+          CopyTuples(arrays.second, arrays.first, chunk.Begin, chunk.End, offset);
+        }
+      }
+      return;
+    }
+    const int type = chunk.Type;
+    const vtkIdType cellOffset = appendInput.CellOffsets[type] + chunk.Begin;
+    const vtkIdType inputCellId = appendInput.InputCellOffsets[type] + chunk.Begin;
+    for (const auto& arrays : appendInput.CellArrays)
+    {
+      if (CanCopyTuplesInParallel(arrays.second) == inParallel)
+      {
+        CopyTuples(arrays.second, arrays.first, inputCellId,
+          inputCellId + chunk.End - chunk.Begin, outputCellOffsets[type] + cellOffset);
       }
+    }
+  };
 
-      if (ds->GetNumberOfCells() > 0)
+  vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType chunkId = begin; chunkId < end; ++chunkId)
+    {
+      const AppendChunk& chunk = chunks[chunkId];
+      const AppendInput& appendInput = appendInputs[chunk.Input];
+      vtkPolyData* input = appendInput.Input;
+      copyChunkData(chunk, true);
+      if (chunk.Type < 0)
       {
-        // These are the cellIDs at which each of the cell types start.
-        vtkIdType vertsIndex = 0;
-        vtkIdType linesIndex = ds->GetNumberOfVerts();
-        vtkIdType polysIndex = linesIndex + ds->GetNumberOfLines();
-        vtkIdType stripsIndex = polysIndex + ds->GetNumberOfPolys();
-
-        // copy the cells
-        this->AppendCells(newVerts, inVerts, ptOffset);
-        this->AppendCells(newLines, inLines, ptOffset);
-        this->AppendCells(newPolys, inPolys, ptOffset);
-        this->AppendCells(newStrips, inStrips, ptOffset);
-
-        // copy cell data
-        outputCD->CopyData(cellList, inCD, countCD, vertOffset, ds->GetNumberOfVerts(), vertsIndex);
-        vertOffset += ds->GetNumberOfVerts();
-        outputCD->CopyData(
-          cellList, inCD, countCD, linesOffset, ds->GetNumberOfLines(), linesIndex);
-        linesOffset += ds->GetNumberOfLines();
-        outputCD->CopyData(
-          cellList, inCD, countCD, polysOffset, ds->GetNumberOfPolys(), polysIndex);
-        polysOffset += ds->GetNumberOfPolys();
-        outputCD->CopyData(
-          cellList, inCD, countCD, stripsOffset, ds->GetNumberOfStrips(), stripsIndex);
-        stripsOffset += ds->GetNumberOfStrips();
-        ++countCD;
+        // copy points directly
+        CopyTuples(newPts->GetData(), input->GetPoints()->GetData(), chunk.Begin, chunk.End,
+          appendInput.PointOffset + chunk.Begin);
+        continue;
       }
-      ptOffset += numPts;
+
+      // copy the cells
+      const int type = chunk.Type;
+      vtkCellArray* cellArrays[4] = { input->GetVerts(), input->GetLines(), input->GetPolys(),
+        input->GetStrips() };
+      vtkCellArray* cells = cellArrays[type];
+      const vtkIdType cellOffset = appendInput.CellOffsets[type] + chunk.Begin;
+      cells->Visit(CopyCellsImpl{}, chunk.Begin, chunk.End,
+        newOffsets[type]->GetPointer(cellOffset), newConnectivity[type]->GetPointer(0),
+        appendInput.ConnectivityOffsets[type], appendInput.PointOffset);
     }
+  });
+  for (const AppendChunk& chunk : chunks)
+  {
+    copyChunkData(chunk, false);
   }
 
   // Update ourselves and release memory
   //
   output->SetPoints(newPts);
-  newPts->Delete();
 
-  if (newVerts->GetNumberOfCells() > 0)
+  vtkNew<vtkCellArray> newCells[4];
+  for (int type = 0; type < 4; ++type)
   {
-    output->SetVerts(newVerts);
+    newCells[type]->SetData(newOffsets[type], newConnectivity[type]);
   }
-  newVerts->Delete();
-
-  if (newLines->GetNumberOfCells() > 0)
+  if (numTypeCells[0] > 0)
   {
-    output->SetLines(newLines);
+    output->SetVerts(newCells[0]);
   }
-  newLines->Delete();
-
-  if (newPolys->GetNumberOfCells() > 0)
+  if (numTypeCells[1] > 0)
   {
-    output->SetPolys(newPolys);
+    output->SetLines(newCells[1]);
   }
-  newPolys->Delete();
-
-  if (newStrips->GetNumberOfCells() > 0)
+  if (numTypeCells[2] > 0)
+  {
+    output->SetPolys(newCells[2]);
+  }
+  if (numTypeCells[3] > 0)
   {
-    output->SetStrips(newStrips);
+    output->SetStrips(newCells[3]);
   }
-  newStrips->Delete();
 
   // When all optimizations are complete, this squeeze will be unnecessary.
   // (But it does not seem to cost much.)
@@ -24,6 +24,9 @@
  * attributes available.  (For example, if one dataset has point scalars but
  * another does not, point scalars will not be appended.)
  *
+ * The output is allocated once, and the points, cells and attributes of the
+ * inputs are copied into it concurrently using vtkSMPTools.
+ *
  * @sa
  * vtkAppendFilter
  */
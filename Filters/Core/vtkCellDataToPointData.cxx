@@ -17,22 +17,26 @@
 #include "vtkArrayDispatch.h"
 #include "vtkCell.h"
 #include "vtkCellData.h"
+#include "vtkCellTypes.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
+#include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticCellLinks.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUniformGrid.h"
-#include "vtkUnsignedIntArray.h"
+#include "vtkUnstructuredGrid.h"
 
 #include <algorithm>
-#include <functional>
 #include <set>
+#include <vector>
 
 #define VTK_MAX_CELLS_PER_POINT 4096
 
@@ -42,94 +46,184 @@ namespace
 {
 
 //----------------------------------------------------------------------------
-// Helper template function that implement the major part of the algorighm
-// which will be expanded by the vtkTemplateMacro. The template function is
-// provided so that coverage test can cover this function.
-struct Spread
+// The cells contributing to each point, stored contiguously in increasing
+// cell id order. The order makes the averages independent of the number of
+// threads and of the order of the links.
+struct PointStencils
 {
-  template <typename SrcArrayT, typename DstArrayT>
-  void operator()(SrcArrayT* const srcarray, DstArrayT* const dstarray, vtkDataSet* const src,
-    vtkUnsignedIntArray* const num, vtkIdType ncells, vtkIdType npoints, vtkIdType ncomps,
-    int highestCellDimension, int contributingCellOption) const
-  {
-    // Both arrays will have the same value type:
-    using T = vtk::GetAPIType<SrcArrayT>;
+  std::vector<vtkIdType> Offsets;
+  std::vector<vtkIdType> CellIds;
+};
 
-    // zero initialization
-    std::fill_n(vtk::DataArrayValueRange(dstarray).begin(), npoints * ncomps, T(0));
+//----------------------------------------------------------------------------
+// Gathers the contributing cells of every point from the cell links, in
+// parallel. A cell contributes if its dimension is at least
+// highestCellDimension, or, with the Patch option, if it has the highest
+// dimension of the cells using the point.
+void BuildStencils(vtkDataSet* src, vtkStaticCellLinks* links, const unsigned char* cellDimensions,
+  int highestCellDimension, bool patch, PointStencils& stencils)
+{
+  const vtkIdType npoints = src->GetNumberOfPoints();
+  stencils.Offsets.resize(npoints + 1);
+  vtkIdType* offsets = stencils.Offsets.data();
 
-    const auto srcTuples = vtk::DataArrayTupleRange(srcarray);
-    auto dstTuples = vtk::DataArrayTupleRange(dstarray);
+  // The dimension of a cell only matters if some cells may be excluded.
+  const bool allCells = !patch && highestCellDimension == 0;
+  if (!allCells)
+  {
+    // Make sure the cell types can be accessed concurrently.
+    src->GetCellType(0);
+  }
 
-    // accumulate
-    if (contributingCellOption != vtkCellDataToPointData::Patch)
+  // Count the contributing cells of each point.
+  auto patchDimension = [&](vtkIdType pid) {
+    const vtkIdType ncells = links->GetNcells(pid);
+    const vtkIdType* cells = links->GetCells(pid);
+    int dimension = 0;
+    for (vtkIdType i = 0; i < ncells; ++i)
     {
-      for (vtkIdType cid = 0; cid < ncells; ++cid)
+      dimension = std::max(dimension, static_cast<int>(cellDimensions[src->GetCellType(cells[i])]));
+    }
+    return dimension;
+  };
+  vtkSMPTools::For(0, npoints, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType pid = begin; pid < end; ++pid)
+    {
+      const vtkIdType ncells = links->GetNcells(pid);
+      if (allCells)
       {
-        vtkCell* cell = src->GetCell(cid);
-        if (cell->GetCellDimension() >= highestCellDimension)
-        {
-          const auto srcTuple = srcTuples[cid];
-          vtkIdList* pids = cell->GetPointIds();
-          for (vtkIdType i = 0, I = pids->GetNumberOfIds(); i < I; ++i)
-          {
-            const vtkIdType ptId = pids->GetId(i);
-            auto dstTuple = dstTuples[ptId];
-            // accumulate cell data to point data <==> point_data += cell_data
-            std::transform(srcTuple.cbegin(), srcTuple.cend(), dstTuple.cbegin(), dstTuple.begin(),
-              std::plus<T>());
-          }
-        }
+        offsets[pid] = ncells;
+        continue;
+      }
+      const vtkIdType* cells = links->GetCells(pid);
+      const int minDimension = patch ? patchDimension(pid) : highestCellDimension;
+      vtkIdType count = 0;
+      for (vtkIdType i = 0; i < ncells; ++i)
+      {
+        count += cellDimensions[src->GetCellType(cells[i])] >= minDimension ? 1 : 0;
       }
-      // average
-      for (vtkIdType pid = 0; pid < npoints; ++pid)
+      offsets[pid] = count;
+    }
+  });
+  const vtkIdType zero = 0;
+  vtkSMPTools::ExclusiveScan(offsets, offsets + npoints + 1, offsets, zero);
+
+  // Copy and sort them.
+  stencils.CellIds.resize(offsets[npoints]);
+  vtkIdType* cellIds = stencils.CellIds.data();
+  vtkSMPTools::For(0, npoints, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType pid = begin; pid < end; ++pid)
+    {
+      const vtkIdType ncells = links->GetNcells(pid);
+      const vtkIdType* cells = links->GetCells(pid);
+      vtkIdType* stencil = cellIds + offsets[pid];
+      if (allCells)
+      {
+        std::copy(cells, cells + ncells, stencil);
+      }
+      else
       {
-        // guard against divide by zero
-        if (unsigned int const denom = num->GetValue(pid))
+        const int minDimension = patch ? patchDimension(pid) : highestCellDimension;
+        vtkIdType* next = stencil;
+        for (vtkIdType i = 0; i < ncells; ++i)
         {
-          // divide point data by the number of cells using it <==>
-          // point_data /= denum
-          auto dstTuple = dstTuples[pid];
-          std::transform(dstTuple.cbegin(), dstTuple.cend(), dstTuple.begin(),
-            std::bind(std::divides<T>(), std::placeholders::_1, denom));
+          if (cellDimensions[src->GetCellType(cells[i])] >= minDimension)
+          {
+            *next++ = cells[i];
+          }
         }
       }
+      std::sort(stencil, cellIds + offsets[pid + 1]);
     }
-    else
-    { // compute over cell patches
-      vtkNew<vtkIdList> cellsOnPoint;
-      std::vector<T> data(4 * ncomps);
-      for (vtkIdType pid = 0; pid < npoints; ++pid)
+  });
+}
+
+//----------------------------------------------------------------------------
+// Builds the stencils of an unstructured grid or a polydata from static cell
+// links, reusing those of the grid when it has some.
+void BuildPointStencils(vtkDataSet* src, int contributingCellOption, PointStencils& stencils)
+{
+  vtkSmartPointer<vtkStaticCellLinks> links;
+  if (vtkUnstructuredGrid* ugrid = vtkUnstructuredGrid::SafeDownCast(src))
+  {
+    links = vtkStaticCellLinks::SafeDownCast(ugrid->GetCellLinks());
+  }
+  if (!links)
+  {
+    links = vtkSmartPointer<vtkStaticCellLinks>::New();
+    links->BuildLinks(src);
+  }
+
+  // The dimension of each cell type of the dataset.
+  unsigned char cellDimensions[VTK_NUMBER_OF_CELL_TYPES] = {};
+  vtkNew<vtkCellTypes> cellTypes;
+  src->GetCellTypes(cellTypes);
+  vtkNew<vtkGenericCell> cell;
+  int maxDimension = 0;
+  for (vtkIdType i = 0; i < cellTypes->GetNumberOfTypes(); ++i)
+  {
+    const unsigned char type = cellTypes->GetCellType(i);
+    cell->SetCellType(type);
+    cellDimensions[type] = static_cast<unsigned char>(cell->GetCellDimension());
+    maxDimension = std::max(maxDimension, cell->GetCellDimension());
+  }
+
+  const int highestCellDimension =
+    contributingCellOption == vtkCellDataToPointData::DataSetMax ? maxDimension : 0;
+  BuildStencils(src, links, cellDimensions, highestCellDimension,
+    contributingCellOption == vtkCellDataToPointData::Patch, stencils);
+}
+
+//----------------------------------------------------------------------------
+// Averages the cell data of the contributing cells of each point. The sums
+// are accumulated in the value type of the arrays. Typed arrays are
+// processed in parallel, the others through the vtkDataArray API in serial.
+struct Average
+{
+  template <typename SrcArrayT, typename DstArrayT>
+  void operator()(SrcArrayT* const srcarray, DstArrayT* const dstarray,
+    const PointStencils& stencils, bool threaded) const
+  {
+    // Both arrays will have the same value type:
+    using T = vtk::GetAPIType<SrcArrayT>;
+
+    const vtkIdType npoints = static_cast<vtkIdType>(stencils.Offsets.size()) - 1;
+    const int ncomps = srcarray->GetNumberOfComponents();
+    const vtkIdType* offsets = stencils.Offsets.data();
+    const vtkIdType* cellIds = stencils.CellIds.data();
+
+    auto average = [&](vtkIdType begin, vtkIdType end) {
+      const auto srcTuples = vtk::DataArrayTupleRange(srcarray);
+      auto dstTuples = vtk::DataArrayTupleRange(dstarray);
+      std::vector<T> sum(ncomps);
+      for (vtkIdType pid = begin; pid < end; ++pid)
       {
-        std::fill(data.begin(), data.end(), 0);
-        T numPointCells[4] = { 0, 0, 0, 0 };
-        // Get all cells touching this point.
-        src->GetPointCells(pid, cellsOnPoint);
-        vtkIdType numPatchCells = cellsOnPoint->GetNumberOfIds();
-        for (vtkIdType pc = 0; pc < numPatchCells; pc++)
+        std::fill(sum.begin(), sum.end(), T(0));
+        for (vtkIdType i = offsets[pid]; i < offsets[pid + 1]; ++i)
         {
-          vtkIdType cellId = cellsOnPoint->GetId(pc);
-          int cellDimension = src->GetCell(cellId)->GetCellDimension();
-          numPointCells[cellDimension] += 1;
-          const auto srcTuple = srcTuples[cellId];
-          for (int comp = 0; comp < ncomps; comp++)
+          const auto srcTuple = srcTuples[cellIds[i]];
+          for (int comp = 0; comp < ncomps; ++comp)
           {
-            data[comp + ncomps * cellDimension] += srcTuple[comp];
+            sum[comp] += srcTuple[comp];
           }
         }
         auto dstTuple = dstTuples[pid];
-        for (int dimension = 3; dimension >= 0; dimension--)
+        const T count = static_cast<T>(offsets[pid + 1] - offsets[pid]);
+        for (int comp = 0; comp < ncomps; ++comp)
         {
-          if (numPointCells[dimension])
-          {
-            for (int comp = 0; comp < ncomps; comp++)
-            {
-              dstTuple[comp] = data[comp + dimension * ncomps] / numPointCells[dimension];
-            }
-            break;
-          }
+          // guard against divide by zero
+          dstTuple[comp] = count != T(0) ? sum[comp] / count : T(0);
         }
       }
+    };
+
+    if (threaded)
+    {
+      vtkSMPTools::For(0, npoints, average);
+    }
+    else
+    {
+      average(0, npoints);
     }
   }
 };
@@ -375,47 +469,6 @@ int vtkCellDataToPointData::RequestDataForUnstructuredData(
     return 1;
   }
 
-  // count the number of cells associated with each point. if we are doing patches
-  // though we will do that later on.
-  vtkSmartPointer<vtkUnsignedIntArray> num;
-  int highestCellDimension = 0;
-  if (this->ContributingCellOption != vtkCellDataToPointData::Patch)
-  {
-    num = vtkSmartPointer<vtkUnsignedIntArray>::New();
-    num->SetNumberOfComponents(1);
-    num->SetNumberOfTuples(npoints);
-    std::fill_n(num->GetPointer(0), npoints, 0u);
-    if (this->ContributingCellOption == vtkCellDataToPointData::DataSetMax)
-    {
-      int maxDimension = src->IsA("vtkPolyData") == 1 ? 2 : 3;
-      for (vtkIdType i = 0; i < src->GetNumberOfCells(); i++)
-      {
-        int dim = src->GetCell(i)->GetCellDimension();
-        if (dim > highestCellDimension)
-        {
-          highestCellDimension = dim;
-          if (highestCellDimension == maxDimension)
-          {
-            break;
-          }
-        }
-      }
-    }
-    vtkNew<vtkIdList> pids;
-    for (vtkIdType cid = 0; cid < ncells; ++cid)
-    {
-      if (src->GetCell(cid)->GetCellDimension() >= highestCellDimension)
-      {
-        src->GetCellPoints(cid, pids);
-        for (vtkIdType i = 0, I = pids->GetNumberOfIds(); i < I; ++i)
-        {
-          vtkIdType const pid = pids->GetId(i);
-          num->SetValue(pid, num->GetValue(pid) + 1);
-        }
-      }
-    }
-  }
-
   // First, copy the input to the output as a starting point
   dst->CopyStructure(src);
   vtkPointData* const opd = dst->GetPointData();
@@ -466,8 +519,14 @@ int vtkCellDataToPointData::RequestDataForUnstructuredData(
   opd->InterpolateAllocate(cfl, npoints, npoints);
 
   const auto nfields = processedCellData->GetNumberOfArrays();
+  PointStencils stencils;
+  if (nfields > 0)
+  {
+    BuildPointStencils(src, this->ContributingCellOption, stencils);
+  }
+
   int fid = 0;
-  auto f = [this, &fid, nfields, npoints, src, num, ncells, highestCellDimension](
+  auto f = [this, &fid, nfields, npoints, &stencils](
              vtkAbstractArray* aa_srcarray, vtkAbstractArray* aa_dstarray) {
     // update progress and check for an abort request.
     this->UpdateProgress((fid + 1.0) / nfields);
@@ -483,15 +542,12 @@ int vtkCellDataToPointData::RequestDataForUnstructuredData(
     if (srcarray && dstarray)
     {
       dstarray->SetNumberOfTuples(npoints);
-      vtkIdType const ncomps = srcarray->GetNumberOfComponents();
 
-      Spread worker;
+      Average worker;
       using Dispatcher = vtkArrayDispatch::Dispatch2SameValueType;
-      if (!Dispatcher::Execute(srcarray, dstarray, worker, src, num, ncells, npoints, ncomps,
-            highestCellDimension, this->ContributingCellOption))
-      { // fallback for unknown arrays:
-        worker(srcarray, dstarray, src, num, ncells, npoints, ncomps, highestCellDimension,
-          this->ContributingCellOption);
+      if (!Dispatcher::Execute(srcarray, dstarray, worker, stencils, true))
+      { // fallback for unknown arrays, which may not support concurrent access:
+        worker(srcarray, dstarray, stencils, false);
       }
     }
   };
@@ -30,6 +30,12 @@
  * cells attached to a point. DataSetMax uses the highest cell dimension in
  * the entire data set.
  *
+ * For unstructured grids and polydata, the cells using each point are
+ * gathered from static cell links (those of the input unstructured grid
+ * when it has some), and the points are then processed in parallel with
+ * vtkSMPTools. The cell values are summed in increasing cell id order so
+ * that the output does not depend on the number of threads.
+ *
  * @warning
  * This filter is an abstract filter, that is, the output is an abstract type
  * (i.e., vtkDataSet). Use the convenience methods (e.g.,
@@ -16,6 +16,7 @@
 
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkCleanPolyDataInternal.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -23,10 +24,90 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
 vtkStandardNewMacro(vtkCleanPolyData);
 
+namespace
+{ // anonymous
+
+//----------------------------------------------------------------------------
+// What a cell becomes once its points are renumbered, exactly as decided
+// when inserting the cells one at a time in RequestData(): consecutive
+// duplicate points are removed, then degenerate cells are converted or
+// discarded.
+struct CleanClassifier
+{
+  bool ConvertLinesToPoints;
+  bool ConvertPolysToLines;
+  bool ConvertStripsToPolys;
+
+  int operator()(int type, vtkIdType npts, const vtkIdType* pts, const vtkIdType* pointMap,
+    vtkIdType* newPts, vtkIdType& numNewPts) const
+  {
+    numNewPts = 0;
+    if (type == CLEAN_VERTS)
+    {
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        newPts[numNewPts++] = pointMap[pts[i]];
+      }
+      return numNewPts > 0 ? CLEAN_VERTS : CLEAN_NONE;
+    }
+
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      const vtkIdType ptId = pointMap[pts[i]];
+      if (i == 0 || ptId != newPts[numNewPts - 1])
+      {
+        newPts[numNewPts++] = ptId;
+      }
+    }
+    if (((type == CLEAN_POLYS && numNewPts > 2) || (type == CLEAN_STRIPS && numNewPts > 1)) &&
+      newPts[0] == newPts[numNewPts - 1])
+    {
+      numNewPts--;
+    }
+
+    if (type == CLEAN_STRIPS && numNewPts > 3)
+    {
+      return CLEAN_STRIPS;
+    }
+    if (type == CLEAN_STRIPS && numNewPts == 3 && (npts == 3 || this->ConvertStripsToPolys))
+    {
+      return CLEAN_POLYS;
+    }
+    if (type == CLEAN_POLYS && numNewPts > 2)
+    {
+      return CLEAN_POLYS;
+    }
+    if (type != CLEAN_LINES && numNewPts == 2 && (npts == 2 || this->ConvertPolysToLines))
+    {
+      return CLEAN_LINES;
+    }
+    if (type == CLEAN_LINES && numNewPts >= 2)
+    {
+      return CLEAN_LINES;
+    }
+    if (numNewPts == 1 && (npts == 1 || this->ConvertLinesToPoints))
+    {
+      return CLEAN_VERTS;
+    }
+    return CLEAN_NONE;
+  }
+};
+
+} // anonymous namespace
+
 //---------------------------------------------------------------------------
 // Specify a spatial locator for speeding the search process. By
 // default an instance of vtkPointLocator is used.
@@ -129,6 +210,10 @@ int vtkCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
     vtkDebugMacro(<< "No data to Operate On!");
     return 1;
   }
+  if (this->RequestDataInParallel(input, output))
+  {
+    return 1;
+  }
   vtkIdType* updatedPts = new vtkIdType[input->GetMaxCellSize()];
 
   vtkIdType numNewPts;
@@ -610,6 +695,211 @@ int vtkCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//--------------------------------------------------------------------------
+// Threaded version of RequestData() producing the same output. Points are
+// either not merged, or merged when they are exactly coincident: in this
+// case vtkMergePoints and vtkStaticPointLocator agree on which points are
+// duplicates. The output points are numbered by first use, in the order the
+// cells are traversed, as they would be when inserted one at a time.
+bool vtkCleanPolyData::RequestDataInParallel(vtkPolyData* input, vtkPolyData* output)
+{
+  vtkPoints* inPts = input->GetPoints();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  vtkPointData* inputPD = input->GetPointData();
+  vtkCellData* inputCD = input->GetCellData();
+
+  int outType = inPts->GetDataType();
+  if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    outType = VTK_FLOAT;
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    outType = VTK_DOUBLE;
+  }
+  if ((outType != VTK_FLOAT && outType != VTK_DOUBLE) ||
+    (inPts->GetDataType() != VTK_FLOAT && inPts->GetDataType() != VTK_DOUBLE) ||
+    !ArrayList::CanCopyInParallel(inputPD) || !ArrayList::CanCopyInParallel(inputCD))
+  {
+    return false;
+  }
+
+  // Overrides of OperateOnPoint() are not assumed to be thread safe: they
+  // are called once per point, on the calling thread. The implementation of
+  // this class leaves the points as they are and is not called at all.
+  vtkSmartPointer<vtkPoints> operatedPts;
+  if (strcmp(this->GetClassName(), "vtkCleanPolyData") != 0)
+  {
+    operatedPts = vtkSmartPointer<vtkPoints>::New();
+    operatedPts->SetDataTypeToDouble();
+    operatedPts->SetNumberOfPoints(numPts);
+    double x[3], newx[3];
+    for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+    {
+      inPts->GetPoint(ptId, x);
+      this->OperateOnPoint(x, newx);
+      operatedPts->SetPoint(ptId, newx);
+    }
+  }
+  vtkPoints* pts = operatedPts ? operatedPts.Get() : inPts;
+
+  // Points can be merged in parallel when they are merged exactly with
+  // vtkMergePoints, on finite coordinates that are stored exactly.
+  std::vector<vtkIdType> mergeMap;
+  if (this->PointMerging)
+  {
+    const double tol = this->ToleranceIsAbsolute ? this->AbsoluteTolerance
+                                                 : this->Tolerance * input->GetLength();
+    this->CreateDefaultLocator(input);
+    if (tol != 0.0 || !this->Locator->IsA("vtkMergePoints"))
+    {
+      return false;
+    }
+    std::atomic<bool> exact(true);
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      double x[3];
+      for (; ptId < endPtId; ++ptId)
+      {
+        pts->GetPoint(ptId, x);
+        for (int i = 0; i < 3; ++i)
+        {
+          if (!std::isfinite(x[i]) || (outType == VTK_FLOAT && static_cast<float>(x[i]) != x[i]))
+          {
+            exact = false;
+          }
+        }
+      }
+    });
+    if (!exact)
+    {
+      return false;
+    }
+
+    // Merge the points with a threaded locator.
+    vtkNew<vtkPolyData> mergedPoints;
+    mergedPoints->SetPoints(pts);
+    mergeMap.resize(numPts);
+    vtkNew<vtkStaticPointLocator> locator;
+    locator->SetDataSet(mergedPoints);
+    locator->BuildLocator();
+    locator->MergePoints(0.0, mergeMap.data());
+  }
+  this->UpdateProgress(0.25);
+
+  // Find the first use of each (merged) point, in the order of the cells.
+  // Uses are numbered with 64 bit integers, which do not overflow for
+  // 32 bit ids.
+  const CleanCellChunks chunks(input);
+  const vtkTypeInt64 maxCellSize = chunks.MaxCellSize;
+  auto useOf = [maxCellSize](vtkIdType cellId, vtkIdType i) {
+    return static_cast<vtkTypeInt64>(cellId) * maxCellSize + i;
+  };
+  const vtkIdType* merged = mergeMap.empty() ? nullptr : mergeMap.data();
+  std::unique_ptr<std::atomic<vtkTypeInt64>[]> firstUse(new std::atomic<vtkTypeInt64>[numPts]);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      firstUse[ptId].store(std::numeric_limits<vtkTypeInt64>::max(), std::memory_order_relaxed);
+    }
+  });
+  auto findFirstUse = [&](vtkIdType, int, vtkIdType cellId, vtkIdType npts,
+                        const vtkIdType* cellPts, vtkIdType*) {
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      const vtkTypeInt64 use = useOf(cellId, i);
+      std::atomic<vtkTypeInt64>& first = firstUse[merged ? merged[cellPts[i]] : cellPts[i]];
+      vtkTypeInt64 current = first.load(std::memory_order_relaxed);
+      while (use < current && !first.compare_exchange_weak(current, use))
+      {
+      }
+    }
+  };
+  chunks.For(findFirstUse);
+
+  // Number the points by first use.
+  std::vector<vtkIdType> chunkOffsets(chunks.NumberOfChunks, 0);
+  auto countNewPoints = [&](vtkIdType chunk, int, vtkIdType cellId, vtkIdType npts,
+                          const vtkIdType* cellPts, vtkIdType*) {
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      if (firstUse[merged ? merged[cellPts[i]] : cellPts[i]] == useOf(cellId, i))
+      {
+        ++chunkOffsets[chunk];
+      }
+    }
+  };
+  chunks.For(countNewPoints);
+  const vtkIdType numNewPts = vtkSMPTools::ExclusiveScan(
+    chunkOffsets.begin(), chunkOffsets.end(), chunkOffsets.begin(), vtkIdType(0));
+
+  std::vector<vtkIdType> pointMap(numPts, -1);
+  std::vector<vtkIdType> sourcePts(numNewPts);
+  auto numberNewPoints = [&](vtkIdType chunk, int, vtkIdType cellId, vtkIdType npts,
+                           const vtkIdType* cellPts, vtkIdType*) {
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      const vtkIdType ptId = merged ? merged[cellPts[i]] : cellPts[i];
+      if (firstUse[ptId] == useOf(cellId, i))
+      {
+        const vtkIdType newPtId = chunkOffsets[chunk]++;
+        pointMap[ptId] = newPtId;
+        sourcePts[newPtId] = cellPts[i];
+      }
+    }
+  };
+  chunks.For(numberNewPoints);
+  firstUse.reset();
+  if (merged)
+  {
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ++ptId)
+      {
+        if (merged[ptId] != ptId)
+        {
+          pointMap[ptId] = pointMap[merged[ptId]];
+        }
+      }
+    });
+  }
+  this->UpdateProgress(0.5);
+
+  // Copy the points used first, and their data.
+  vtkPointData* outputPD = output->GetPointData();
+  vtkCellData* outputCD = output->GetCellData();
+  if (!this->PointMerging)
+  {
+    outputPD->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
+  }
+  outputPD->CopyAllocate(inputPD);
+  outputCD->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
+  outputCD->CopyAllocate(inputCD);
+
+  vtkSmartPointer<vtkPoints> newPts = vtk::TakeSmartPointer(inPts->NewInstance());
+  newPts->SetDataType(outType);
+  newPts->SetNumberOfPoints(numNewPts);
+  ArrayList pointArrays;
+  pointArrays.AddArrays(numNewPts, inputPD, outputPD, 0.0, false);
+  vtkSMPTools::For(0, numNewPts, [&](vtkIdType newPtId, vtkIdType endNewPtId) {
+    double x[3];
+    for (; newPtId < endNewPtId; ++newPtId)
+    {
+      const vtkIdType ptId = sourcePts[newPtId];
+      pts->GetPoint(ptId, x);
+      newPts->SetPoint(newPtId, x);
+      pointArrays.Copy(ptId, newPtId);
+    }
+  });
+  output->SetPoints(newPts);
+  this->UpdateProgress(0.75);
+
+  CleanClassifier classifier{ this->ConvertLinesToPoints != 0, this->ConvertPolysToLines != 0,
+    this->ConvertStripsToPolys != 0 };
+  CleanRemapCells(input, pointMap.data(), classifier, inputCD, outputCD, output);
+
+  vtkDebugMacro(<< "Removed " << numPts - numNewPts << " points");
+  return true;
+}
+
 //--------------------------------------------------------------------------
 // Method manages creation of locators. It takes into account the potential
 // change of tolerance (zero to non-zero).
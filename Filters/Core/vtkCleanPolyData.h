@@ -50,6 +50,15 @@
  * will not be used, and points that are not used by any cells will be
  * eliminated, but never merged.
  *
+ * When points are not merged, or merged with a zero tolerance by the default
+ * vtkMergePoints locator, this class is threaded with vtkSMPTools: points
+ * are merged with a vtkStaticPointLocator and cells are rewritten in
+ * parallel, giving the same output as the sequential insertion. Merging
+ * within a non-zero tolerance depends on the order in which points are
+ * inserted and remains sequential; see vtkStaticCleanPolyData for a
+ * threaded alternative. In the threaded cases, OperateOnPoint is still
+ * called on the calling thread, once for each input point.
+ *
  * @warning
  * Merging points can alter topology, including introducing non-manifold
  * forms. The tolerance should be chosen carefully to avoid these problems.
@@ -209,6 +218,14 @@ protected:
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
+  /**
+   * Threaded implementation of RequestData() used when points are not
+   * merged, or merged with a zero tolerance by the default locator. Returns
+   * false, leaving the output untouched, when the input or the settings
+   * require the sequential implementation.
+   */
+  bool RequestDataInParallel(vtkPolyData* input, vtkPolyData* output);
+
   vtkTypeBool PointMerging;
   double Tolerance;
   double AbsoluteTolerance;
@@ -0,0 +1,253 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCleanPolyDataInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkCleanPolyDataInternal
+ * @brief   threaded traversal and rewriting of the cells of cleaned polydata
+ *
+ * vtkCleanPolyDataInternal provides the threaded machinery shared by
+ * vtkCleanPolyData and vtkStaticCleanPolyData: visiting the verts, lines,
+ * polys and strips of a vtkPolyData in parallel chunks of cells, and
+ * rewriting them with renumbered points. A classifier given by the filter
+ * decides what each cell becomes (a vert, a line, a poly, a strip or
+ * nothing) so that the output cells are the same, and in the same order, as
+ * the ones inserted one at a time by a sequential traversal.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkCleanPolyData vtkStaticCleanPolyData
+ */
+
+#ifndef vtkCleanPolyDataInternal_h
+#define vtkCleanPolyDataInternal_h
+
+#include "vtkArrayListTemplate.h" // For processing attribute data
+#include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
+#include "vtkCellData.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+// Cell types of vtkPolyData, in the order of the cell ids.
+enum CleanCellType
+{
+  CLEAN_VERTS = 0,
+  CLEAN_LINES = 1,
+  CLEAN_POLYS = 2,
+  CLEAN_STRIPS = 3,
+  CLEAN_NONE = -1
+};
+
+// Number of cells processed by one task.
+const vtkIdType CleanCellsPerChunk = 8192;
+
+//----------------------------------------------------------------------------
+// Visits all the cells of a vtkPolyData, by increasing cell id, in parallel
+// chunks of cells. The functor is called as
+// f(chunk, cellType, cellId, numCellPts, cellPts, scratch) where scratch has
+// room for the points of the largest cell.
+struct CleanCellChunks
+{
+  vtkCellArray* Cells[4];
+  vtkIdType CellOffsets[5];
+  vtkIdType NumberOfChunks;
+  int MaxCellSize;
+
+  CleanCellChunks(vtkPolyData* input)
+  {
+    this->Cells[CLEAN_VERTS] = input->GetVerts();
+    this->Cells[CLEAN_LINES] = input->GetLines();
+    this->Cells[CLEAN_POLYS] = input->GetPolys();
+    this->Cells[CLEAN_STRIPS] = input->GetStrips();
+    this->CellOffsets[0] = 0;
+    for (int type = 0; type < 4; ++type)
+    {
+      this->CellOffsets[type + 1] =
+        this->CellOffsets[type] + this->Cells[type]->GetNumberOfCells();
+    }
+    this->NumberOfChunks = (this->CellOffsets[4] + CleanCellsPerChunk - 1) / CleanCellsPerChunk;
+    this->MaxCellSize = std::max(input->GetMaxCellSize(), 1);
+  }
+
+  vtkIdType GetNumberOfCells(int type) const
+  {
+    return this->CellOffsets[type + 1] - this->CellOffsets[type];
+  }
+
+  template <typename Functor>
+  void For(Functor& f) const
+  {
+    vtkSMPTools::For(0, this->NumberOfChunks, [&](vtkIdType chunk, vtkIdType endChunk) {
+      // Iterators give thread safe access to cells of any storage.
+      vtkSmartPointer<vtkCellArrayIterator> iters[4];
+      std::vector<vtkIdType> scratch(this->MaxCellSize);
+      vtkIdType numCellPts;
+      const vtkIdType* cellPts;
+      for (; chunk < endChunk; ++chunk)
+      {
+        const vtkIdType endCellId =
+          std::min((chunk + 1) * CleanCellsPerChunk, this->CellOffsets[4]);
+        int type = 0;
+        for (vtkIdType cellId = chunk * CleanCellsPerChunk; cellId < endCellId; ++cellId)
+        {
+          while (cellId >= this->CellOffsets[type + 1])
+          {
+            ++type;
+          }
+          if (!iters[type])
+          {
+            iters[type] = vtk::TakeSmartPointer(this->Cells[type]->NewIterator());
+          }
+          iters[type]->GetCellAtId(cellId - this->CellOffsets[type], numCellPts, cellPts);
+          f(chunk, type, cellId, numCellPts, cellPts, scratch.data());
+        }
+      }
+    });
+  }
+};
+
+//----------------------------------------------------------------------------
+// Rewrites the cells of the input with the point map in parallel. The
+// classifier is called as
+// classify(cellType, numCellPts, cellPts, pointMap, newPts, numNewPts)
+// and returns the type of the output cell, whose numNewPts points it writes
+// in newPts, or CLEAN_NONE to discard the cell. As when inserting the cells
+// one at a time, an output cell array is created when the input has cells of
+// this type or when some cells are converted to it, and the cell data of
+// verts, lines, polys and strips follow each other. outCD must have been
+// allocated with CopyAllocate().
+template <typename Classifier>
+void CleanRemapCells(vtkPolyData* input, const vtkIdType* pointMap, const Classifier& classify,
+  vtkCellData* inCD, vtkCellData* outCD, vtkPolyData* output)
+{
+  const CleanCellChunks chunks(input);
+  const vtkIdType numChunks = chunks.NumberOfChunks;
+
+  // Count the cells and connectivity of each type produced by each chunk.
+  std::vector<vtkIdType> cellCounts(4 * numChunks, 0);
+  std::vector<vtkIdType> connCounts(4 * numChunks, 0);
+  auto count = [&](vtkIdType chunk, int type, vtkIdType, vtkIdType npts, const vtkIdType* pts,
+                 vtkIdType* newPts) {
+    vtkIdType numNewPts;
+    const int outType = classify(type, npts, pts, pointMap, newPts, numNewPts);
+    if (outType != CLEAN_NONE)
+    {
+      ++cellCounts[4 * chunk + outType];
+      connCounts[4 * chunk + outType] += numNewPts;
+    }
+  };
+  chunks.For(count);
+
+  // Offsets of the chunks in the output cell arrays.
+  vtkIdType numCells[4] = { 0, 0, 0, 0 };
+  vtkIdType connSizes[4] = { 0, 0, 0, 0 };
+  for (vtkIdType chunk = 0; chunk < numChunks; ++chunk)
+  {
+    for (int type = 0; type < 4; ++type)
+    {
+      const vtkIdType cells = cellCounts[4 * chunk + type];
+      const vtkIdType conn = connCounts[4 * chunk + type];
+      cellCounts[4 * chunk + type] = numCells[type];
+      connCounts[4 * chunk + type] = connSizes[type];
+      numCells[type] += cells;
+      connSizes[type] += conn;
+    }
+  }
+
+  vtkSmartPointer<vtkIdTypeArray> offsets[4];
+  vtkSmartPointer<vtkIdTypeArray> conns[4];
+  vtkIdType* offsetPtrs[4] = { nullptr, nullptr, nullptr, nullptr };
+  vtkIdType* connPtrs[4] = { nullptr, nullptr, nullptr, nullptr };
+  vtkIdType cellDataOffsets[4];
+  vtkIdType numOutCells = 0;
+  for (int type = 0; type < 4; ++type)
+  {
+    cellDataOffsets[type] = numOutCells;
+    numOutCells += numCells[type];
+    if (chunks.GetNumberOfCells(type) > 0 || numCells[type] > 0)
+    {
+      offsets[type] = vtkSmartPointer<vtkIdTypeArray>::New();
+      offsets[type]->SetNumberOfValues(numCells[type] + 1);
+      offsetPtrs[type] = offsets[type]->GetPointer(0);
+      offsetPtrs[type][numCells[type]] = connSizes[type];
+      conns[type] = vtkSmartPointer<vtkIdTypeArray>::New();
+      conns[type]->SetNumberOfValues(connSizes[type]);
+      connPtrs[type] = conns[type]->GetPointer(0);
+    }
+  }
+
+  ArrayList cellArrays;
+  cellArrays.AddArrays(numOutCells, inCD, outCD, 0.0, false);
+
+  // Write the cells and their data.
+  auto write = [&](vtkIdType chunk, int type, vtkIdType cellId, vtkIdType npts,
+                 const vtkIdType* pts, vtkIdType* newPts) {
+    vtkIdType numNewPts;
+    const int outType = classify(type, npts, pts, pointMap, newPts, numNewPts);
+    if (outType != CLEAN_NONE)
+    {
+      const vtkIdType outCellId = cellCounts[4 * chunk + outType]++;
+      vtkIdType& connOffset = connCounts[4 * chunk + outType];
+      offsetPtrs[outType][outCellId] = connOffset;
+      std::copy(newPts, newPts + numNewPts, connPtrs[outType] + connOffset);
+      connOffset += numNewPts;
+      cellArrays.Copy(cellId, cellDataOffsets[outType] + outCellId);
+    }
+  };
+  chunks.For(write);
+
+  for (int type = 0; type < 4; ++type)
+  {
+    if (offsets[type])
+    {
+      vtkNew<vtkCellArray> cells;
+      cells->SetData(offsets[type], conns[type]);
+      switch (type)
+      {
+        case CLEAN_VERTS:
+          output->SetVerts(cells);
+          break;
+        case CLEAN_LINES:
+          output->SetLines(cells);
+          break;
+        case CLEAN_POLYS:
+          output->SetPolys(cells);
+          break;
+        default:
+          output->SetStrips(cells);
+          break;
+      }
+    }
+  }
+}
+
+} // anonymous namespace
+
+#endif // vtkCleanPolyDataInternal_h
+// VTK-HeaderTest-Exclude: vtkCleanPolyDataInternal.h
@@ -16,6 +16,7 @@
 
 #include "vtkCell.h"
 #include "vtkCellData.h"
+#include "vtkConnectivityFilterInternal.h"
 #include "vtkDataSet.h"
 #include "vtkDemandDrivenPipeline.h"
 #include "vtkFloatArray.h"
@@ -23,14 +24,17 @@
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
-#include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkUnstructuredGrid.h"
 
 #include <map>
+#include <numeric>
+#include <vector>
 
 vtkObjectFactoryNewMacro(vtkConnectivityFilter);
 
@@ -48,17 +52,27 @@ vtkConnectivityFilter::vtkConnectivityFilter()
 
   this->ClosestPoint[0] = this->ClosestPoint[1] = this->ClosestPoint[2] = 0.0;
 
+  this->Seeds = vtkIdList::New();
+  this->SpecifiedRegionIds = vtkIdList::New();
+
+#if !defined(VTK_LEGACY_REMOVE)
   this->CellScalars = vtkFloatArray::New();
   this->CellScalars->Allocate(8);
-
   this->NeighborCellPointIds = vtkIdList::New();
   this->NeighborCellPointIds->Allocate(8);
-
-  this->Seeds = vtkIdList::New();
-  this->SpecifiedRegionIds = vtkIdList::New();
-
+  this->Visited = nullptr;
+  this->PointMap = nullptr;
   this->NewScalars = nullptr;
   this->NewCellScalars = nullptr;
+  this->RegionNumber = 0;
+  this->PointNumber = 0;
+  this->NumCellsInRegion = 0;
+  this->InScalars = nullptr;
+  this->Wave = nullptr;
+  this->Wave2 = nullptr;
+  this->PointIds = nullptr;
+  this->CellIds = nullptr;
+#endif
 
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
 }
@@ -66,10 +80,12 @@ vtkConnectivityFilter::vtkConnectivityFilter()
 vtkConnectivityFilter::~vtkConnectivityFilter()
 {
   this->RegionSizes->Delete();
-  this->CellScalars->Delete();
-  this->NeighborCellPointIds->Delete();
   this->Seeds->Delete();
   this->SpecifiedRegionIds->Delete();
+#if !defined(VTK_LEGACY_REMOVE)
+  this->CellScalars->Delete();
+  this->NeighborCellPointIds->Delete();
+#endif
 }
 
 int vtkConnectivityFilter::RequestDataObject(vtkInformation* vtkNotUsed(request),
@@ -128,11 +144,9 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkPolyData* pdOutput = vtkPolyData::SafeDownCast(output);
   vtkUnstructuredGrid* ugOutput = vtkUnstructuredGrid::SafeDownCast(output);
 
-  vtkIdType numPts, numCells, cellId, i, j, pt;
+  vtkIdType numPts, numCells, cellId, i, pt;
   vtkPoints* newPts;
   vtkIdType id;
-  vtkIdType maxCellsInRegion;
-  vtkIdType largestRegionId = 0;
   vtkPointData *pd = input->GetPointData(), *outputPD = output->GetPointData();
   vtkCellData *cd = input->GetCellData(), *outputCD = output->GetCellData();
 
@@ -158,41 +172,16 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
 
   // See whether to consider scalar connectivity
   //
-  this->InScalars = input->GetPointData()->GetScalars();
-  if (!this->ScalarConnectivity)
-  {
-    this->InScalars = nullptr;
-  }
-  else
+  vtkDataArray* inScalars = nullptr;
+  if (this->ScalarConnectivity)
   {
+    inScalars = input->GetPointData()->GetScalars();
     if (this->ScalarRange[1] < this->ScalarRange[0])
     {
       this->ScalarRange[1] = this->ScalarRange[0];
     }
   }
 
-  // Initialize.  Keep track of points and cells visited.
-  //
-  this->RegionSizes->Reset();
-  this->Visited = new vtkIdType[numCells];
-  for (i = 0; i < numCells; i++)
-  {
-    this->Visited[i] = -1;
-  }
-  this->PointMap = new vtkIdType[numPts];
-  for (i = 0; i < numPts; i++)
-  {
-    this->PointMap[i] = -1;
-  }
-
-  this->NewScalars = vtkIdTypeArray::New();
-  this->NewScalars->SetName("RegionId");
-  this->NewScalars->SetNumberOfTuples(numPts);
-
-  this->NewCellScalars = vtkIdTypeArray::New();
-  this->NewCellScalars->SetName("RegionId");
-  this->NewCellScalars->SetNumberOfTuples(numCells);
-
   newPts = vtkPoints::New();
 
   // Set the desired precision for the points in the output.
@@ -217,116 +206,115 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
     newPts->SetDataType(VTK_DOUBLE);
   }
 
-  newPts->Allocate(numPts);
-
-  // Traverse all cells marking those visited.  Each new search
-  // starts a new connected region. Connected region grows
-  // using a connected wave propagation.
+  // Label the cells with their region. Each cell that is not yet in a region
+  // starts a new one, in increasing cell id order, which grows across shared
+  // points. The regions are labeled in parallel with a union-find over the
+  // points rather than grown one after the other.
   //
-  this->Wave = vtkIdList::New();
-  this->Wave->Allocate(numPts / 4 + 1, numPts);
-  this->Wave2 = vtkIdList::New();
-  this->Wave2->Allocate(numPts / 4 + 1, numPts);
-
-  this->PointNumber = 0;
-  this->RegionNumber = 0;
-  maxCellsInRegion = 0;
-
-  this->CellIds = vtkIdList::New();
-  this->CellIds->Allocate(8, VTK_CELL_SIZE);
-  this->PointIds = vtkIdList::New();
-  this->PointIds->Allocate(8, VTK_CELL_SIZE);
-
+  ConnectedRegions regions(input, inScalars, this->ScalarRange,
+    inScalars ? ConnectedRegions::ANY_SCALAR_IN_RANGE : ConnectedRegions::NO_SCALARS);
   if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
   { // visit all cells marking with region number
-    for (cellId = 0; cellId < numCells; cellId++)
-    {
-      if (cellId && !(cellId % 5000))
-      {
-        this->UpdateProgress(0.1 + 0.8 * cellId / numCells);
-      }
-
-      if (this->Visited[cellId] < 0)
-      {
-        this->NumCellsInRegion = 0;
-        this->Wave->InsertNextId(cellId);
-        this->TraverseAndMark(input);
-
-        if (this->NumCellsInRegion > maxCellsInRegion)
-        {
-          maxCellsInRegion = this->NumCellsInRegion;
-          largestRegionId = this->RegionNumber;
-        }
-
-        this->RegionSizes->InsertValue(this->RegionNumber++, this->NumCellsInRegion);
-        this->Wave->Reset();
-        this->Wave2->Reset();
-      }
-    }
+    regions.LabelAllRegions();
   }
   else // regions have been seeded, everything considered in same region
   {
-    this->NumCellsInRegion = 0;
-
-    if (this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS)
-    {
-      for (i = 0; i < this->Seeds->GetNumberOfIds(); i++)
-      {
-        pt = this->Seeds->GetId(i);
-        if (pt >= 0)
-        {
-          input->GetPointCells(pt, this->CellIds);
-          for (j = 0; j < this->CellIds->GetNumberOfIds(); j++)
-          {
-            this->Wave->InsertNextId(this->CellIds->GetId(j));
-          }
-        }
-      }
-    }
-    else if (this->ExtractionMode == VTK_EXTRACT_CELL_SEEDED_REGIONS)
+    if (this->ExtractionMode == VTK_EXTRACT_CELL_SEEDED_REGIONS)
     {
+      std::vector<unsigned char> seedCells(numCells, 0);
       for (i = 0; i < this->Seeds->GetNumberOfIds(); i++)
       {
         cellId = this->Seeds->GetId(i);
-        if (cellId >= 0)
+        if (cellId >= 0 && cellId < numCells)
         {
-          this->Wave->InsertNextId(cellId);
+          seedCells[cellId] = 1;
         }
       }
+      regions.LabelSeededRegion(seedCells);
     }
-    else if (this->ExtractionMode == VTK_EXTRACT_CLOSEST_POINT_REGION)
-    { // loop over points, find closest one
-      double minDist2, dist2, x[3];
-      vtkIdType minId = 0;
-      for (minDist2 = VTK_DOUBLE_MAX, i = 0; i < numPts; i++)
+    else
+    {
+      std::vector<unsigned char> seedPoints(numPts, 0);
+      if (this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS)
       {
-        input->GetPoint(i, x);
-        dist2 = vtkMath::Distance2BetweenPoints(x, this->ClosestPoint);
-        if (dist2 < minDist2)
+        for (i = 0; i < this->Seeds->GetNumberOfIds(); i++)
         {
-          minId = i;
-          minDist2 = dist2;
+          pt = this->Seeds->GetId(i);
+          if (pt >= 0 && pt < numPts)
+          {
+            seedPoints[pt] = 1;
+          }
         }
       }
-      input->GetPointCells(minId, this->CellIds);
-      for (j = 0; j < this->CellIds->GetNumberOfIds(); j++)
+      else // find the closest point
       {
-        this->Wave->InsertNextId(this->CellIds->GetId(j));
+        seedPoints[FindClosestPoint(input, this->ClosestPoint)] = 1;
       }
+      regions.LabelSeededRegionFromPoints(seedPoints);
     }
-    this->UpdateProgress(0.5);
+  }
+  this->UpdateProgress(0.5);
 
-    // mark all seeded regions
-    this->TraverseAndMark(input);
-    this->RegionSizes->InsertValue(this->RegionNumber, this->NumCellsInRegion);
-    this->UpdateProgress(0.9);
+  const std::vector<vtkIdType>& cellRegions = regions.CellRegions;
+  const vtkIdType numRegions = static_cast<vtkIdType>(regions.RegionSizes.size());
+  this->RegionSizes->SetNumberOfValues(numRegions);
+  vtkIdType largestRegionId = 0;
+  for (vtkIdType regionId = 0; regionId < numRegions; ++regionId)
+  {
+    this->RegionSizes->SetValue(regionId, regions.RegionSizes[regionId]);
+    if (regions.RegionSizes[regionId] > regions.RegionSizes[largestRegionId])
+    {
+      largestRegionId = regionId;
+    }
   }
+  vtkDebugMacro(<< "Extracted " << numRegions << " region(s)");
 
-  vtkDebugMacro(<< "Extracted " << this->RegionNumber << " region(s)");
-  this->Wave->Delete();
-  this->Wave2->Delete();
+  // The points of the cells in a region are kept, in increasing id order.
+  const vtkIdType zero = 0;
+  std::vector<vtkIdType> pointMap(numPts + 1);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      pointMap[ptId] = regions.PointRegions[ptId] >= 0 ? 1 : 0;
+    }
+  });
+  const vtkIdType numNewPts =
+    vtkSMPTools::ExclusiveScan(pointMap.begin(), pointMap.end() - 1, pointMap.begin(), zero);
+  pointMap[numPts] = numNewPts;
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      if (regions.PointRegions[ptId] < 0)
+      {
+        pointMap[ptId] = -1;
+      }
+    }
+  });
+
+  vtkIdTypeArray* newScalars = vtkIdTypeArray::New();
+  newScalars->SetName("RegionId");
+  newScalars->SetNumberOfTuples(numNewPts);
+  vtkIdTypeArray* newCellScalars = vtkIdTypeArray::New();
+  newCellScalars->SetName("RegionId");
+  newCellScalars->SetNumberOfTuples(numCells);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      if (pointMap[ptId] >= 0)
+      {
+        newScalars->SetValue(pointMap[ptId], regions.PointRegions[ptId]);
+      }
+    }
+  });
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      newCellScalars->SetValue(cellId, cellRegions[cellId]);
+    }
+  });
+  this->UpdateProgress(0.9);
 
   // Now that points and cells have been marked, traverse these lists pulling
   // everything that has been visited.
@@ -335,192 +323,105 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
   outputPD->CopyAllocate(pd);
   outputCD->CopyAllocate(cd);
 
+  newPts->SetNumberOfPoints(numNewPts);
   for (i = 0; i < numPts; i++)
   {
-    if (this->PointMap[i] > -1)
+    if (pointMap[i] > -1)
     {
-      newPts->InsertPoint(this->PointMap[i], input->GetPoint(i));
-      outputPD->CopyData(pd, i, this->PointMap[i]);
+      newPts->SetPoint(pointMap[i], input->GetPoint(i));
+      outputPD->CopyData(pd, i, pointMap[i]);
     }
   }
 
   // if coloring regions; send down new scalar data
   if (this->ColorRegions)
   {
-    this->OrderRegionIds(this->NewScalars, this->NewCellScalars);
+    this->OrderRegionIds(newScalars, newCellScalars);
 
-    int idx = outputPD->AddArray(this->NewScalars);
+    int idx = outputPD->AddArray(newScalars);
     outputPD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
-    idx = outputCD->AddArray(this->NewCellScalars);
+    idx = outputCD->AddArray(newCellScalars);
     outputCD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
   }
-  this->NewScalars->Delete();
-  this->NewCellScalars->Delete();
+  newScalars->Delete();
+  newCellScalars->Delete();
 
   output->SetPoints(newPts);
   newPts->Delete();
 
   // Create output cells
   //
-  if (this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS ||
-    this->ExtractionMode == VTK_EXTRACT_CELL_SEEDED_REGIONS ||
-    this->ExtractionMode == VTK_EXTRACT_CLOSEST_POINT_REGION ||
-    this->ExtractionMode == VTK_EXTRACT_ALL_REGIONS)
-  { // extract any cell that's been visited
-    for (cellId = 0; cellId < numCells; cellId++)
+  vtkNew<vtkIdList> pointIds;
+  vtkUnstructuredGrid* ugInput = vtkUnstructuredGrid::SafeDownCast(input);
+  for (cellId = 0; cellId < numCells; cellId++)
+  {
+    const vtkIdType regionId = cellRegions[cellId];
+    bool extract;
+    if (this->ExtractionMode == VTK_EXTRACT_SPECIFIED_REGIONS)
     {
-      if (this->Visited[cellId] >= 0)
-      {
-        // special handling for polyhedron cells
-        if (vtkUnstructuredGrid::SafeDownCast(input) &&
-          input->GetCellType(cellId) == VTK_POLYHEDRON)
-        {
-          vtkUnstructuredGrid::SafeDownCast(input)->GetFaceStream(cellId, this->PointIds);
-          vtkUnstructuredGrid::ConvertFaceStreamPointIds(this->PointIds, this->PointMap);
-        }
-        else
-        {
-          input->GetCellPoints(cellId, this->PointIds);
-          for (i = 0; i < this->PointIds->GetNumberOfIds(); i++)
-          {
-            id = this->PointMap[this->PointIds->GetId(i)];
-            this->PointIds->InsertId(i, id);
-          }
-        }
-        vtkIdType newCellId = -1;
-        if (pdOutput)
-        {
-          newCellId = pdOutput->InsertNextCell(input->GetCellType(cellId), this->PointIds);
-        }
-        else if (ugOutput)
-        {
-          newCellId = ugOutput->InsertNextCell(input->GetCellType(cellId), this->PointIds);
-        }
-        if (newCellId >= 0)
-        {
-          outputCD->CopyData(cd, cellId, newCellId);
-        }
-      }
+      extract = regionId >= 0 && this->SpecifiedRegionIds->IsId(regionId) >= 0;
     }
-  }
-  else if (this->ExtractionMode == VTK_EXTRACT_SPECIFIED_REGIONS)
-  {
-    for (cellId = 0; cellId < numCells; cellId++)
+    else if (this->ExtractionMode == VTK_EXTRACT_LARGEST_REGION)
     {
-      int inReg, regionId;
-      if ((regionId = this->Visited[cellId]) >= 0)
-      {
-        for (inReg = 0, i = 0; i < this->SpecifiedRegionIds->GetNumberOfIds(); i++)
-        {
-          if (regionId == this->SpecifiedRegionIds->GetId(i))
-          {
-            inReg = 1;
-            break;
-          }
-        }
-        if (inReg)
-        {
-          // special handling for polyhedron cells
-          if (vtkUnstructuredGrid::SafeDownCast(input) &&
-            input->GetCellType(cellId) == VTK_POLYHEDRON)
-          {
-            vtkUnstructuredGrid::SafeDownCast(input)->GetFaceStream(cellId, this->PointIds);
-            vtkUnstructuredGrid::ConvertFaceStreamPointIds(this->PointIds, this->PointMap);
-          }
-          else
-          {
-            input->GetCellPoints(cellId, this->PointIds);
-            for (i = 0; i < this->PointIds->GetNumberOfIds(); i++)
-            {
-              id = this->PointMap[this->PointIds->GetId(i)];
-              this->PointIds->InsertId(i, id);
-            }
-          }
-          vtkIdType newCellId = -1;
-          if (pdOutput)
-          {
-            newCellId = pdOutput->InsertNextCell(input->GetCellType(cellId), this->PointIds);
-          }
-          else if (ugOutput)
-          {
-            newCellId = ugOutput->InsertNextCell(input->GetCellType(cellId), this->PointIds);
-          }
-          if (newCellId >= 0)
-          {
-            outputCD->CopyData(cd, cellId, newCellId);
-          }
-        }
-      }
+      extract = regionId == largestRegionId;
     }
-  }
-  else // extract largest region
-  {
-    for (cellId = 0; cellId < numCells; cellId++)
+    else // extract any cell that's been visited
+    {
+      extract = regionId >= 0;
+    }
+    if (!extract)
     {
-      if (this->Visited[cellId] == largestRegionId)
+      continue;
+    }
+
+    // special handling for polyhedron cells
+    if (ugInput && ugInput->GetCellType(cellId) == VTK_POLYHEDRON)
+    {
+      ugInput->GetFaceStream(cellId, pointIds);
+      vtkUnstructuredGrid::ConvertFaceStreamPointIds(pointIds, pointMap.data());
+    }
+    else
+    {
+      input->GetCellPoints(cellId, pointIds);
+      for (i = 0; i < pointIds->GetNumberOfIds(); i++)
       {
-        // special handling for polyhedron cells
-        if (vtkUnstructuredGrid::SafeDownCast(input) &&
-          input->GetCellType(cellId) == VTK_POLYHEDRON)
-        {
-          vtkUnstructuredGrid::SafeDownCast(input)->GetFaceStream(cellId, this->PointIds);
-          vtkUnstructuredGrid::ConvertFaceStreamPointIds(this->PointIds, this->PointMap);
-        }
-        else
-        {
-          input->GetCellPoints(cellId, this->PointIds);
-          for (i = 0; i < this->PointIds->GetNumberOfIds(); i++)
-          {
-            id = this->PointMap[this->PointIds->GetId(i)];
-            this->PointIds->InsertId(i, id);
-          }
-        }
-        vtkIdType newCellId = -1;
-        if (pdOutput)
-        {
-          newCellId = pdOutput->InsertNextCell(input->GetCellType(cellId), this->PointIds);
-        }
-        else if (ugOutput)
-        {
-          newCellId = ugOutput->InsertNextCell(input->GetCellType(cellId), this->PointIds);
-        }
-        if (newCellId >= 0)
-        {
-          outputCD->CopyData(cd, cellId, newCellId);
-        }
+        id = pointMap[pointIds->GetId(i)];
+        pointIds->SetId(i, id);
       }
     }
+    vtkIdType newCellId = -1;
+    if (pdOutput)
+    {
+      newCellId = pdOutput->InsertNextCell(input->GetCellType(cellId), pointIds);
+    }
+    else if (ugOutput)
+    {
+      newCellId = ugOutput->InsertNextCell(input->GetCellType(cellId), pointIds);
+    }
+    if (newCellId >= 0)
+    {
+      outputCD->CopyData(cd, cellId, newCellId);
+    }
   }
 
-  delete[] this->Visited;
-  delete[] this->PointMap;
-  this->PointIds->Delete();
-  this->CellIds->Delete();
   output->Squeeze();
-  vtkDataArray* outScalars = nullptr;
-  if (this->ColorRegions && (outScalars = output->GetPointData()->GetScalars()))
-  {
-    outScalars->Resize(output->GetNumberOfPoints());
-  }
 
-  int num = this->GetNumberOfExtractedRegions();
-  int count = 0;
-
-  for (int ii = 0; ii < num; ii++)
-  {
-    count += this->RegionSizes->GetValue(ii);
-  }
-  vtkDebugMacro(<< "Total # of cells accounted for: " << count);
+  vtkDebugMacro(<< "Total # of cells accounted for: "
+                << std::accumulate(regions.RegionSizes.begin(), regions.RegionSizes.end(),
+                     static_cast<vtkIdType>(0)));
   vtkDebugMacro(<< "Extracted " << output->GetNumberOfCells() << " cells");
 
   return 1;
 }
 
+#if !defined(VTK_LEGACY_REMOVE)
 // Mark current cell as visited and assign region number.  Note:
 // traversal occurs across shared vertices.
 //
 void vtkConnectivityFilter::TraverseAndMark(vtkDataSet* input)
 {
+  VTK_LEGACY_BODY(vtkConnectivityFilter::TraverseAndMark, "VTK 9.0");
+
   vtkIdType i, j, k, cellId, numIds, ptId, numPts, numCells;
   vtkIdList* tmpWave;
 
@@ -596,6 +497,7 @@ void vtkConnectivityFilter::TraverseAndMark(vtkDataSet* input)
     tmpWave->Reset();
   } // while wave is not empty
 }
+#endif
 
 void vtkConnectivityFilter::OrderRegionIds(
   vtkIdTypeArray* pointRegionIds, vtkIdTypeArray* cellRegionIds)
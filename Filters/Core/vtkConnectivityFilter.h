@@ -50,6 +50,12 @@
  * was processed and has no other significance with respect to the size of
  * or number of cells.
  *
+ * The regions are labeled in parallel with vtkSMPTools, with a union-find
+ * over the points of the cells. The regions do not depend on the number of
+ * threads: they are numbered in increasing order of their smallest cell id.
+ * The output points are the points of the cells in a region (all the cells
+ * unless the regions are seeded), in increasing input id order.
+ *
  * @sa
  * vtkPolyDataConnectivityFilter
  */
@@ -58,6 +64,7 @@
 #define vtkConnectivityFilter_h
 
 #include "vtkFiltersCoreModule.h" // For export macro
+#include "vtkLegacy.h"            // For VTK_LEGACY
 #include "vtkPointSetAlgorithm.h"
 
 #define VTK_EXTRACT_POINT_SEEDED_REGIONS 1
@@ -243,12 +250,17 @@ protected:
 
   int RegionIdAssignmentMode;
 
-  void TraverseAndMark(vtkDataSet* input);
+  /**
+   * @deprecated The regions are no longer grown with a wave propagation,
+   * this method is not called by the filter anymore and will be removed.
+   */
+  VTK_LEGACY(void TraverseAndMark(vtkDataSet* input));
 
   void OrderRegionIds(vtkIdTypeArray* pointRegionIds, vtkIdTypeArray* cellRegionIds);
 
+#if !defined(VTK_LEGACY_REMOVE)
 private:
-  // used to support algorithm execution
+  // used to support the deprecated wave propagation
   vtkFloatArray* CellScalars;
   vtkIdList* NeighborCellPointIds;
   vtkIdType* Visited;
@@ -263,6 +275,7 @@ private:
   vtkIdList* Wave2;
   vtkIdList* PointIds;
   vtkIdList* CellIds;
+#endif
 
 private:
   vtkConnectivityFilter(const vtkConnectivityFilter&) = delete;
@@ -0,0 +1,500 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConnectivityFilterInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkConnectivityFilterInternal
+ * @brief   parallel labeling of the connected regions of a dataset
+ *
+ * vtkConnectivityFilterInternal labels the connected regions of the cells of
+ * a dataset with vtkSMPTools. Two cells are connected when they share a point
+ * and both satisfy the scalar criterion of the filter. A cell that does not
+ * satisfy it only joins a region when the region starts from it, or when it
+ * is a seed. The connected components of the cells that satisfy the criterion
+ * are built with a lock-free union-find over their points, then each
+ * component joins the region of the smallest cell that reaches it. This gives
+ * the regions, and the region numbering, of a sequential wave propagation
+ * started from each cell in increasing id order, whatever the number of
+ * threads.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkConnectivityFilter vtkPolyDataConnectivityFilter
+ */
+
+#ifndef vtkConnectivityFilterInternal_h
+#define vtkConnectivityFilterInternal_h
+
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+// Lowers an atomic value to the given one when it is smaller.
+inline void AtomicMin(std::atomic<vtkIdType>& value, vtkIdType newValue)
+{
+  vtkIdType current = value.load();
+  while (newValue < current && !value.compare_exchange_weak(current, newValue))
+  {
+  }
+}
+
+// Returns the id of the point of a dataset closest to a position, the
+// smallest one in case of ties.
+inline vtkIdType FindClosestPoint(vtkDataSet* input, const double position[3])
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  if (numPts < 1)
+  {
+    return -1;
+  }
+  double x[3];
+  input->GetPoint(0, x);
+
+  struct Closest
+  {
+    double Distance2 = VTK_DOUBLE_MAX;
+    vtkIdType PointId = -1;
+  };
+  vtkSMPThreadLocal<Closest> tlClosest;
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    Closest& closest = tlClosest.Local();
+    double p[3];
+    for (; ptId < endPtId; ++ptId)
+    {
+      input->GetPoint(ptId, p);
+      const double dist2 = vtkMath::Distance2BetweenPoints(p, position);
+      if (dist2 < closest.Distance2)
+      {
+        closest.Distance2 = dist2;
+        closest.PointId = ptId;
+      }
+    }
+  });
+
+  Closest result;
+  result.PointId = 0;
+  for (const Closest& closest : tlClosest)
+  {
+    if (closest.PointId >= 0 &&
+      (closest.Distance2 < result.Distance2 ||
+        (closest.Distance2 == result.Distance2 && closest.PointId < result.PointId)))
+    {
+      result = closest;
+    }
+  }
+  return result.PointId;
+}
+
+// Labels the connected regions of the cells of a dataset, see above.
+class ConnectedRegions
+{
+public:
+  // The scalar criterion that the cells satisfy to be connected to their
+  // neighbors.
+  enum ScalarCriterion
+  {
+    NO_SCALARS,          // all the cells
+    ANY_SCALAR_IN_RANGE, // the range of the scalars of the cell meets the scalar range
+    ALL_SCALARS_IN_RANGE // the range of the scalars of the cell is in the scalar range
+  };
+
+  // The region of each cell, or -1 for the cells in no region.
+  std::vector<vtkIdType> CellRegions;
+
+  // The smallest region of the cells using each point, or -1 for the points
+  // that no cell in a region uses.
+  std::vector<vtkIdType> PointRegions;
+
+  // The number of cells in each region.
+  std::vector<vtkIdType> RegionSizes;
+
+  // The scalars are the first component of the given array, which may be
+  // null with the NO_SCALARS criterion.
+  ConnectedRegions(
+    vtkDataSet* input, vtkDataArray* scalars, const double range[2], ScalarCriterion criterion)
+    : CellRegions(input->GetNumberOfCells())
+    , PointRegions(input->GetNumberOfPoints())
+    , Input(input)
+    , NumberOfPoints(input->GetNumberOfPoints())
+    , NumberOfCells(input->GetNumberOfCells())
+    , Scalars(scalars)
+    , Criterion(scalars ? criterion : NO_SCALARS)
+    , Parents(input->GetNumberOfPoints())
+    , Claimers(input->GetNumberOfPoints())
+    , Connected(input->GetNumberOfCells())
+    , FirstPoints(input->GetNumberOfCells())
+  {
+    this->Range[0] = range[0];
+    this->Range[1] = range[1];
+
+    // GetCellPoints is only thread safe once it has been called from a single
+    // thread.
+    if (this->NumberOfCells > 0)
+    {
+      vtkNew<vtkIdList> ids;
+      input->GetCellPoints(0, ids);
+    }
+  }
+
+  // Labels all the regions. They are numbered in the order of their smallest
+  // cell id.
+  void LabelAllRegions()
+  {
+    this->BuildComponents();
+    this->ClaimComponents(nullptr);
+
+    // A region starts from each cell that is not connected, and from the
+    // smallest cell of each component that no such cell reaches first.
+    const vtkIdType numCells = this->NumberOfCells;
+    std::vector<vtkIdType> regionStarts(numCells + 1);
+    vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+      for (; cellId < endCellId; ++cellId)
+      {
+        const vtkIdType root = this->GetRoot(cellId);
+        regionStarts[cellId] = root < 0 || this->Claimers[root].load() == cellId ? 1 : 0;
+      }
+    });
+    const vtkIdType zero = 0;
+    const vtkIdType numRegions = vtkSMPTools::ExclusiveScan(
+      regionStarts.begin(), regionStarts.end() - 1, regionStarts.begin(), zero);
+    regionStarts[numCells] = numRegions;
+
+    vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+      for (; cellId < endCellId; ++cellId)
+      {
+        const vtkIdType root = this->GetRoot(cellId);
+        this->CellRegions[cellId] =
+          root < 0 ? regionStarts[cellId] : regionStarts[this->Claimers[root].load()];
+      }
+    });
+
+    this->CountRegions(numRegions);
+    this->LabelPoints();
+  }
+
+  // Labels the region 0 grown from the cells flagged as seeds, all the other
+  // cells are in no region.
+  void LabelSeededRegion(const std::vector<unsigned char>& seeds)
+  {
+    this->BuildComponents();
+    this->ClaimComponents(&seeds);
+
+    const vtkIdType numCells = this->NumberOfCells;
+    vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+      for (; cellId < endCellId; ++cellId)
+      {
+        const vtkIdType root = this->GetRoot(cellId);
+        this->CellRegions[cellId] =
+          seeds[cellId] || (root >= 0 && this->Claimers[root].load() < numCells) ? 0 : -1;
+      }
+    });
+
+    this->CountRegions(1);
+    this->LabelPoints();
+  }
+
+  // Labels the region 0 grown from the cells using the points flagged as
+  // seeds.
+  void LabelSeededRegionFromPoints(const std::vector<unsigned char>& seedPoints)
+  {
+    std::vector<unsigned char> seeds(this->NumberOfCells);
+    vtkSMPTools::For(0, this->NumberOfCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+      vtkIdList* pts = this->CellPoints.Local();
+      for (; cellId < endCellId; ++cellId)
+      {
+        this->Input->GetCellPoints(cellId, pts);
+        const vtkIdType* begin = pts->GetPointer(0);
+        const vtkIdType* end = begin + pts->GetNumberOfIds();
+        seeds[cellId] =
+          std::any_of(begin, end, [&](vtkIdType ptId) { return seedPoints[ptId] != 0; }) ? 1 : 0;
+      }
+    });
+    this->LabelSeededRegion(seeds);
+  }
+
+private:
+  // Returns the root of a point of a connected cell.
+  vtkIdType Find(vtkIdType ptId)
+  {
+    vtkIdType parent = this->Parents[ptId].load();
+    while (parent != ptId)
+    {
+      // Path halving: the point is moved up to its grandparent.
+      const vtkIdType grandParent = this->Parents[parent].load();
+      if (grandParent != parent)
+      {
+        this->Parents[ptId].compare_exchange_weak(parent, grandParent);
+      }
+      ptId = grandParent;
+      parent = this->Parents[ptId].load();
+    }
+    return ptId;
+  }
+
+  // Merges the components of two points of connected cells. The larger root
+  // is linked to the smaller one, so that the root of each component is its
+  // smallest point id whatever the order of the merges.
+  void Unite(vtkIdType ptId0, vtkIdType ptId1)
+  {
+    for (;;)
+    {
+      ptId0 = this->Find(ptId0);
+      ptId1 = this->Find(ptId1);
+      if (ptId0 == ptId1)
+      {
+        return;
+      }
+      if (ptId0 < ptId1)
+      {
+        std::swap(ptId0, ptId1);
+      }
+      vtkIdType expected = ptId0;
+      if (this->Parents[ptId0].compare_exchange_strong(expected, ptId1))
+      {
+        return;
+      }
+    }
+  }
+
+  // Returns the root of the component of a cell, or -1 when the cell is not
+  // connected or has no points.
+  vtkIdType GetRoot(vtkIdType cellId) const
+  {
+    return this->Connected[cellId] && this->FirstPoints[cellId] >= 0
+      ? this->Parents[this->FirstPoints[cellId]].load()
+      : -1;
+  }
+
+  bool SatisfiesCriterion(vtkIdList* pts) const
+  {
+    if (this->Criterion == NO_SCALARS)
+    {
+      return true;
+    }
+    double range[2] = { VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+    for (vtkIdType i = 0; i < pts->GetNumberOfIds(); ++i)
+    {
+      const double s = this->Scalars->GetComponent(pts->GetId(i), 0);
+      range[0] = s < range[0] ? s : range[0];
+      range[1] = s > range[1] ? s : range[1];
+    }
+    if (this->Criterion == ALL_SCALARS_IN_RANGE)
+    {
+      return range[0] >= this->Range[0] && range[1] <= this->Range[1];
+    }
+    return range[1] >= this->Range[0] && range[0] <= this->Range[1];
+  }
+
+  // Builds the connected components of the points of the connected cells.
+  // The parent of the other points stays -1. Once done, the parent of each
+  // point is its root.
+  void BuildComponents()
+  {
+    vtkSMPTools::For(0, this->NumberOfPoints, [&](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ++ptId)
+      {
+        this->Parents[ptId].store(-1);
+      }
+    });
+
+    vtkSMPTools::For(0, this->NumberOfCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+      vtkIdList* pts = this->CellPoints.Local();
+      for (; cellId < endCellId; ++cellId)
+      {
+        this->Input->GetCellPoints(cellId, pts);
+        const vtkIdType npts = pts->GetNumberOfIds();
+        this->FirstPoints[cellId] = npts > 0 ? pts->GetId(0) : -1;
+        this->Connected[cellId] = this->SatisfiesCriterion(pts) ? 1 : 0;
+        if (!this->Connected[cellId] || npts == 0)
+        {
+          continue;
+        }
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          vtkIdType expected = -1;
+          this->Parents[pts->GetId(i)].compare_exchange_strong(expected, pts->GetId(i));
+        }
+        for (vtkIdType i = 1; i < npts; ++i)
+        {
+          this->Unite(pts->GetId(0), pts->GetId(i));
+        }
+      }
+    });
+
+    vtkSMPTools::For(0, this->NumberOfPoints, [&](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ++ptId)
+      {
+        if (this->Parents[ptId].load() >= 0)
+        {
+          this->Parents[ptId].store(this->Find(ptId));
+        }
+      }
+    });
+  }
+
+  // Records, for the root of each component, the smallest of the given cells
+  // that reaches it: a connected cell reaches its own component, a cell that
+  // is not connected reaches the components of its points. All the cells are
+  // considered when no flags are given. The claimer of the other roots is the
+  // number of cells.
+  void ClaimComponents(const std::vector<unsigned char>* cellFlags)
+  {
+    const vtkIdType numCells = this->NumberOfCells;
+    vtkSMPTools::For(0, this->NumberOfPoints, [&](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ++ptId)
+      {
+        this->Claimers[ptId].store(numCells);
+      }
+    });
+
+    vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+      vtkIdList* pts = this->CellPoints.Local();
+      for (; cellId < endCellId; ++cellId)
+      {
+        if (cellFlags && !(*cellFlags)[cellId])
+        {
+          continue;
+        }
+        if (this->Connected[cellId])
+        {
+          const vtkIdType root = this->GetRoot(cellId);
+          if (root >= 0)
+          {
+            AtomicMin(this->Claimers[root], cellId);
+          }
+          continue;
+        }
+        this->Input->GetCellPoints(cellId, pts);
+        for (vtkIdType i = 0; i < pts->GetNumberOfIds(); ++i)
+        {
+          const vtkIdType root = this->Parents[pts->GetId(i)].load();
+          if (root >= 0)
+          {
+            AtomicMin(this->Claimers[root], cellId);
+          }
+        }
+      }
+    });
+  }
+
+  // Counts the cells in each region. Consecutive cells are mostly in the same
+  // region, so the counts are accumulated over runs of cells before being
+  // added to the shared counters.
+  void CountRegions(vtkIdType numRegions)
+  {
+    std::vector<std::atomic<vtkIdType>> sizes(numRegions);
+    vtkSMPTools::For(0, numRegions, [&](vtkIdType regionId, vtkIdType endRegionId) {
+      for (; regionId < endRegionId; ++regionId)
+      {
+        sizes[regionId].store(0);
+      }
+    });
+    vtkSMPTools::For(0, this->NumberOfCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+      vtkIdType regionId = -1;
+      vtkIdType count = 0;
+      for (; cellId < endCellId; ++cellId)
+      {
+        if (this->CellRegions[cellId] != regionId)
+        {
+          if (regionId >= 0)
+          {
+            sizes[regionId] += count;
+          }
+          regionId = this->CellRegions[cellId];
+          count = 0;
+        }
+        ++count;
+      }
+      if (regionId >= 0)
+      {
+        sizes[regionId] += count;
+      }
+    });
+    this->RegionSizes.resize(numRegions);
+    for (vtkIdType regionId = 0; regionId < numRegions; ++regionId)
+    {
+      this->RegionSizes[regionId] = sizes[regionId].load();
+    }
+  }
+
+  void LabelPoints()
+  {
+    // The claimers are not needed anymore, they hold the smallest region of
+    // the cells using each point.
+    vtkSMPTools::For(0, this->NumberOfPoints, [&](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ++ptId)
+      {
+        this->Claimers[ptId].store(VTK_ID_MAX);
+      }
+    });
+    vtkSMPTools::For(0, this->NumberOfCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+      vtkIdList* pts = this->CellPoints.Local();
+      for (; cellId < endCellId; ++cellId)
+      {
+        const vtkIdType regionId = this->CellRegions[cellId];
+        if (regionId < 0)
+        {
+          continue;
+        }
+        this->Input->GetCellPoints(cellId, pts);
+        for (vtkIdType i = 0; i < pts->GetNumberOfIds(); ++i)
+        {
+          AtomicMin(this->Claimers[pts->GetId(i)], regionId);
+        }
+      }
+    });
+    vtkSMPTools::For(0, this->NumberOfPoints, [&](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ++ptId)
+      {
+        const vtkIdType regionId = this->Claimers[ptId].load();
+        this->PointRegions[ptId] = regionId == VTK_ID_MAX ? -1 : regionId;
+      }
+    });
+  }
+
+  vtkDataSet* Input;
+  const vtkIdType NumberOfPoints;
+  const vtkIdType NumberOfCells;
+  vtkDataArray* Scalars;
+  ScalarCriterion Criterion;
+  double Range[2];
+
+  // The union-find forest over the points of the connected cells.
+  std::vector<std::atomic<vtkIdType>> Parents;
+  std::vector<std::atomic<vtkIdType>> Claimers;
+  std::vector<unsigned char> Connected;
+  std::vector<vtkIdType> FirstPoints;
+  vtkSMPThreadLocalObject<vtkIdList> CellPoints;
+};
+
+} // anonymous namespace
+
+#endif // vtkConnectivityFilterInternal_h
+// VTK-HeaderTest-Exclude: vtkConnectivityFilterInternal.h
@@ -209,7 +209,15 @@ void vtkContourGridExecute(vtkContourGrid* self, vtkDataSet* input, vtkPolyData*
   // If enabled, build a scalar tree to accelerate search
   //
   vtkIdType numCellsContoured = 0;
-  if (!useScalarTree)
+  if (!useScalarTree && vtkMergePoints::SafeDownCast(locator) &&
+    vtkContourHelper::CanContourInParallel(input))
+  {
+    // Contour the cells concurrently, with the output of the loops below in
+    // which all the coincident points are merged.
+    vtkContourHelper::ContourCells(input, inScalars, values, numContours, false, newPts, newVerts,
+      newLines, newPolys, inPd, inCd, outPd, outCd, generateTriangles);
+  }
+  else if (!useScalarTree)
   {
     // Three passes over the cells to process lower dimensional cells first.
     // For poly data output cells need to be added in the order:
@@ -34,6 +34,11 @@
  * contours are being extracted. If you want to use a scalar tree,
  * invoke the method UseScalarTreeOn().
  *
+ * Without a scalar tree, the cells are contoured concurrently with
+ * vtkSMPTools when the locator is a vtkMergePoints (the default), with the
+ * same output whatever the number of threads. Any other locator contours
+ * the cells serially.
+ *
  * @warning
  * If the input vtkUnstructuredGrid contains 3D linear cells, the class
  * vtkContour3DLinearGrid is much faster and may be preferred in certain
@@ -17,11 +17,393 @@
 #include "vtkCell.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkCellTypes.h"
+#include "vtkCutter.h"
 #include "vtkDataArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
 #include "vtkIdListCollection.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
 #include "vtkPolygonBuilder.h"
+#include "vtkSMPFiltersInternal.h" // For CopyTuples
+#include "vtkSMPTools.h"
+#include "vtkStaticPointLocator.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// The number of cells contoured by a single task.
+constexpr vtkIdType CONTOUR_CHUNK_SIZE = 8192;
+
+// A range of cells, contoured either for the cells of a dimension or for a
+// single value, and what it produced. Its verts, lines and polys each have
+// their own cell data.
+struct ContourChunk
+{
+  int Pass;
+  vtkIdType Begin;
+  vtkIdType End;
+  vtkSmartPointer<vtkPoints> Points;
+  vtkSmartPointer<vtkCellArray> Cells[3];
+  vtkSmartPointer<vtkPointData> PointData;
+  vtkSmartPointer<vtkCellData> CellData[3];
+  vtkIdType PointOffset = 0;
+  vtkIdType CellOffsets[3] = { 0, 0, 0 };
+  vtkIdType ConnectivityOffsets[3] = { 0, 0, 0 };
+  // The first and number of the polygons merged from the triangles of a cell.
+  std::vector<std::pair<vtkIdType, vtkIdType>> MergedPolygons;
+
+  ContourChunk(int pass, vtkIdType begin, vtkIdType end)
+    : Pass(pass)
+    , Begin(begin)
+    , End(end)
+  {
+  }
+};
+
+// Get the scalars of the points of a cell, and their range over all the
+// components.
+void GetCellScalars(
+  vtkDataArray* scalars, vtkIdList* ptIds, vtkDoubleArray* cellScalars, double range[2])
+{
+  const int numComps = scalars->GetNumberOfComponents();
+  const vtkIdType numPts = ptIds->GetNumberOfIds();
+  cellScalars->SetNumberOfTuples(numPts);
+  range[0] = std::numeric_limits<double>::max();
+  range[1] = std::numeric_limits<double>::lowest();
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    for (int comp = 0; comp < numComps; ++comp)
+    {
+      const double s = scalars->GetComponent(ptIds->GetId(i), comp);
+      cellScalars->SetTypedComponent(i, comp, s);
+      range[0] = std::min(range[0], s);
+      range[1] = std::max(range[1], s);
+    }
+  }
+}
+
+template <typename T>
+void RoundCoordinates(const double x[3], std::array<double, 3>& key)
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    key[i] = static_cast<double>(static_cast<T>(x[i]));
+  }
+}
+
+struct CoordinatesHash
+{
+  size_t operator()(const std::array<double, 3>& key) const
+  {
+    std::hash<double> hash;
+    return hash(key[0]) ^ (hash(key[1]) * 31) ^ (hash(key[2]) * 961);
+  }
+};
+
+// A locator merging the points whose coordinates, once stored in its points,
+// are equal. vtkMergePoints only searches the bucket of a point, which
+// depends on the bounds given to InitPointInsertion(): coincident points on
+// both sides of a bucket boundary would not be merged within a chunk, while
+// the chunks share their points exactly.
+class ContourChunkLocator : public vtkMergePoints
+{
+public:
+  static ContourChunkLocator* New();
+  vtkTypeMacro(ContourChunkLocator, vtkMergePoints);
+
+  int InitPointInsertion(vtkPoints* newPts, const double bounds[6]) override
+  {
+    return this->InitPointInsertion(newPts, bounds, 0);
+  }
+
+  int InitPointInsertion(vtkPoints* newPts, const double*, vtkIdType estSize) override
+  {
+    if (this->Points)
+    {
+      this->Points->UnRegister(this);
+    }
+    this->Points = newPts;
+    this->Points->Register(this);
+    this->PointIds.clear();
+    this->PointIds.reserve(static_cast<size_t>(estSize));
+    switch (newPts->GetDataType())
+    {
+      vtkTemplateMacro(this->Round = &RoundCoordinates<VTK_TT>);
+      default:
+        this->Round = &RoundCoordinates<double>;
+    }
+    return 1;
+  }
+
+  vtkIdType IsInsertedPoint(const double x[3]) override
+  {
+    std::array<double, 3> key;
+    this->Round(x, key);
+    auto found = this->PointIds.find(key);
+    return found == this->PointIds.end() ? -1 : found->second;
+  }
+
+  vtkIdType IsInsertedPoint(double x, double y, double z) override
+  {
+    const double xyz[3] = { x, y, z };
+    return this->IsInsertedPoint(xyz);
+  }
+
+  int InsertUniquePoint(const double x[3], vtkIdType& ptId) override
+  {
+    std::array<double, 3> key;
+    this->Round(x, key);
+    auto inserted = this->PointIds.emplace(key, this->Points->GetNumberOfPoints());
+    ptId = inserted.first->second;
+    if (inserted.second)
+    {
+      this->Points->InsertNextPoint(x);
+    }
+    return inserted.second ? 1 : 0;
+  }
+
+  vtkIdType InsertNextPoint(const double x[3]) override
+  {
+    const vtkIdType ptId = this->Points->InsertNextPoint(x);
+    std::array<double, 3> key;
+    this->Round(x, key);
+    this->PointIds.emplace(key, ptId);
+    return ptId;
+  }
+
+  void InsertPoint(vtkIdType ptId, const double x[3]) override
+  {
+    this->Points->InsertPoint(ptId, x);
+    std::array<double, 3> key;
+    this->Round(x, key);
+    this->PointIds.emplace(key, ptId);
+  }
+
+protected:
+  ContourChunkLocator() = default;
+  ~ContourChunkLocator() override = default;
+
+private:
+  std::unordered_map<std::array<double, 3>, vtkIdType, CoordinatesHash> PointIds;
+  void (*Round)(const double x[3], std::array<double, 3>& key) = &RoundCoordinates<double>;
+
+  ContourChunkLocator(const ContourChunkLocator&) = delete;
+  void operator=(const ContourChunkLocator&) = delete;
+};
+vtkStandardNewMacro(ContourChunkLocator);
+
+// Contour the cells of each chunk into its own output.
+struct ContourChunkCells
+{
+  vtkDataSet* Input;
+  vtkDataArray* Scalars;
+  const double* Values;
+  vtkIdType NumberOfValues;
+  bool SortByCell;
+  int PointsType;
+  vtkPointData* InPd;
+  vtkCellData* InCd;
+  vtkPointData* PointDataFlags;
+  vtkCellData* CellDataFlags;
+  bool OutputTriangles;
+  std::vector<ContourChunk>& Chunks;
+  const unsigned char* CellTypeDimensions;
+
+  bool IsContoured(const ContourChunk& chunk, const double range[2]) const
+  {
+    if (this->SortByCell)
+    {
+      return this->Values[chunk.Pass] >= range[0] && this->Values[chunk.Pass] <= range[1];
+    }
+    return std::any_of(this->Values, this->Values + this->NumberOfValues,
+      [&](double value) { return value >= range[0] && value <= range[1]; });
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkNew<vtkGenericCell> cell;
+    vtkNew<vtkIdList> ptIds;
+    vtkNew<vtkDoubleArray> cellScalars;
+    cellScalars->SetNumberOfComponents(this->Scalars->GetNumberOfComponents());
+    std::vector<vtkIdType> cellIds;
+    for (vtkIdType chunkId = begin; chunkId < end; ++chunkId)
+    {
+      ContourChunk& chunk = this->Chunks[chunkId];
+
+      // Find the cells to contour.
+      cellIds.clear();
+      for (vtkIdType cellId = chunk.Begin; cellId < chunk.End; ++cellId)
+      {
+        if (!this->SortByCell)
+        {
+          const int cellType = this->Input->GetCellType(cellId);
+          if (cellType >= VTK_NUMBER_OF_CELL_TYPES ||
+            this->CellTypeDimensions[cellType] != chunk.Pass)
+          {
+            continue;
+          }
+        }
+        this->Input->GetCellPoints(cellId, ptIds);
+        double range[2];
+        GetCellScalars(this->Scalars, ptIds, cellScalars, range);
+        if (ptIds->GetNumberOfIds() == 0 || !this->IsContoured(chunk, range))
+        {
+          continue;
+        }
+        cellIds.push_back(cellId);
+      }
+      if (cellIds.empty())
+      {
+        continue;
+      }
+
+      const vtkIdType estimatedSize = static_cast<vtkIdType>(cellIds.size()) *
+        (this->SortByCell ? 1 : this->NumberOfValues);
+      chunk.Points = vtkSmartPointer<vtkPoints>::New();
+      chunk.Points->SetDataType(this->PointsType);
+      chunk.Points->Allocate(estimatedSize);
+      // The cells of a dimension other than the one of the chunk are only
+      // contoured when sorting by cell.
+      vtkIdType typeSizes[3];
+      for (int i = 0; i < 3; ++i)
+      {
+        typeSizes[i] = this->SortByCell || i == chunk.Pass - 1 ? estimatedSize : 1;
+        chunk.Cells[i] = vtkSmartPointer<vtkCellArray>::New();
+        chunk.Cells[i]->AllocateEstimate(typeSizes[i], i == 2 ? 4 : i + 1);
+        chunk.CellData[i] = vtkSmartPointer<vtkCellData>::New();
+      }
+      chunk.PointData = vtkSmartPointer<vtkPointData>::New();
+      chunk.PointData->DeepCopy(this->PointDataFlags);
+      chunk.PointData->InterpolateAllocate(this->InPd, estimatedSize);
+      for (int i = 0; i < 3; ++i)
+      {
+        chunk.CellData[i]->DeepCopy(this->CellDataFlags);
+        chunk.CellData[i]->CopyAllocate(this->InCd, typeSizes[i]);
+      }
+      vtkNew<ContourChunkLocator> locator;
+      locator->InitPointInsertion(chunk.Points, nullptr, estimatedSize);
+
+      // A helper numbers the cells it outputs after the verts and lines of
+      // its arrays in its cell data. Each dimension has its own helper, with
+      // no other cells, so that the cells of a chunk may have any dimension.
+      vtkNew<vtkCellArray> noCells;
+      vtkContourHelper vertsHelper(locator, chunk.Cells[0], noCells, noCells, this->InPd,
+        this->InCd, chunk.PointData, chunk.CellData[0], static_cast<int>(typeSizes[0]),
+        this->OutputTriangles);
+      vtkContourHelper linesHelper(locator, noCells, chunk.Cells[1], noCells, this->InPd,
+        this->InCd, chunk.PointData, chunk.CellData[1], static_cast<int>(typeSizes[1]),
+        this->OutputTriangles);
+      vtkContourHelper polysHelper(locator, noCells, noCells, chunk.Cells[2], this->InPd,
+        this->InCd, chunk.PointData, chunk.CellData[2], static_cast<int>(typeSizes[2]),
+        this->OutputTriangles);
+      vtkContourHelper* helpers[3] = { &vertsHelper, &linesHelper, &polysHelper };
+
+      auto contourCell = [&](double value, vtkIdType cellId) {
+        const int dimension = cell->GetCellDimension();
+        vtkContourHelper* helper = helpers[std::max(dimension, 1) - 1];
+        helper->Contour(cell, value, cellScalars, cellId);
+        const vtkIdType numMerged = helper->GetNumberOfMergedPolygons();
+        if (numMerged > 0)
+        {
+          chunk.MergedPolygons.emplace_back(
+            chunk.Cells[2]->GetNumberOfCells() - numMerged, numMerged);
+        }
+      };
+      for (vtkIdType cellId : cellIds)
+      {
+        this->Input->GetCell(cellId, cell);
+        double range[2];
+        GetCellScalars(this->Scalars, cell->GetPointIds(), cellScalars, range);
+        if (this->SortByCell)
+        {
+          contourCell(this->Values[chunk.Pass], cellId);
+          continue;
+        }
+        for (vtkIdType i = 0; i < this->NumberOfValues; ++i)
+        {
+          if (this->Values[i] >= range[0] && this->Values[i] <= range[1])
+          {
+            contourCell(this->Values[i], cellId);
+          }
+        }
+      }
+    }
+  }
+};
+
+// Copy the cells of a chunk to the output offsets and connectivity, from the
+// connectivity offset connOffset on, mapping their point ids to the output
+// ones. The offset past the last cell is left to the caller.
+struct CopyCellsImpl
+{
+  template <typename CellStateT>
+  void operator()(CellStateT& state, vtkIdType* outOffsets, vtkIdType* outConn,
+    vtkIdType connOffset, const vtkIdType* pointMap)
+  {
+    const auto inOffsets =
+      vtk::DataArrayValueRange<1>(state.GetOffsets(), 0, state.GetNumberOfCells());
+    std::transform(inOffsets.cbegin(), inOffsets.cend(), outOffsets,
+      [&](vtkIdType offset) { return offset + connOffset; });
+    const auto inConn = vtk::DataArrayValueRange<1>(state.GetConnectivity());
+    std::transform(inConn.cbegin(), inConn.cend(), outConn + connOffset,
+      [&](vtkIdType ptId) { return pointMap[ptId]; });
+  }
+};
+
+// Order the polygons merged from the triangles of a cell as vtkPolygonBuilder
+// does for the output point ids: each polygon starts with its smallest point
+// id, and the polygons are sorted by it.
+void SortMergedPolygons(vtkCellArray* polys, vtkIdType firstPoly, vtkIdType numPolys,
+  vtkIdType* outOffsets, vtkIdType* outConn)
+{
+  std::vector<std::vector<vtkIdType>> polygons(numPolys);
+  vtkIdType* outPolys = outConn + outOffsets[firstPoly];
+  for (auto& polygon : polygons)
+  {
+    polygon.assign(outPolys, outPolys + polys->GetCellSize(firstPoly++));
+    outPolys += polygon.size();
+    std::rotate(polygon.begin(), std::min_element(polygon.begin(), polygon.end()), polygon.end());
+  }
+  std::stable_sort(polygons.begin(), polygons.end(),
+    [](const std::vector<vtkIdType>& a, const std::vector<vtkIdType>& b) { return a[0] < b[0]; });
+  firstPoly -= numPolys;
+  outPolys = outConn + outOffsets[firstPoly];
+  for (const auto& polygon : polygons)
+  {
+    outOffsets[firstPoly++] = outPolys - outConn;
+    outPolys = std::copy(polygon.begin(), polygon.end(), outPolys);
+  }
+}
+
+// An empty copy of attributes, keeping their copy flags.
+template <typename AttributesT>
+void CopyFlags(AttributesT* attributes, AttributesT* flags)
+{
+  flags->DeepCopy(attributes);
+  for (int i = flags->GetNumberOfArrays() - 1; i >= 0; --i)
+  {
+    flags->RemoveArray(i);
+  }
+}
+}
 
 //----------------------------------------------------------------------------
 vtkContourHelper::vtkContourHelper(vtkIncrementalPointLocator* locator, vtkCellArray* verts,
@@ -36,6 +418,7 @@ vtkContourHelper::vtkContourHelper(vtkIncrementalPointLocator* locator, vtkCellA
   , OutPd(outPd)
   , OutCd(outCd)
   , GenerateTriangles(outputTriangles)
+  , NumberOfMergedPolygons(0)
 {
   this->Tris = vtkCellArray::New();
   this->TriOutCd = vtkCellData::New();
@@ -59,6 +442,7 @@ vtkContourHelper::~vtkContourHelper()
 void vtkContourHelper::Contour(
   vtkCell* cell, double value, vtkDataArray* cellScalars, vtkIdType cellId)
 {
+  this->NumberOfMergedPolygons = 0;
   bool mergeTriangles = (!this->GenerateTriangles) && cell->GetCellDimension() == 3;
   vtkCellData* outCD = nullptr;
   vtkCellArray* outPoly = nullptr;
@@ -104,9 +488,256 @@ void vtkContourHelper::Contour(
         vtkIdType outCellId = this->Polys->InsertNextCell(poly);
         this->OutCd->CopyData(this->InCd, cellId,
           outCellId + this->Verts->GetNumberOfCells() + this->Lines->GetNumberOfCells());
+        ++this->NumberOfMergedPolygons;
       }
       poly->Delete();
     }
     this->PolyCollection->RemoveAllItems();
   }
 }
+
+//----------------------------------------------------------------------------
+bool vtkContourHelper::CanContourInParallel(vtkDataSet* input)
+{
+  // Contouring higher order cells sets their order and rational weights from
+  // the input, which modifies its cell data.
+  vtkNew<vtkCellTypes> types;
+  input->GetCellTypes(types);
+  for (vtkIdType i = 0; i < types->GetNumberOfTypes(); ++i)
+  {
+    const unsigned char type = types->GetCellType(i);
+    if (type >= VTK_LAGRANGE_CURVE && type <= VTK_BEZIER_PYRAMID)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkContourHelper::ContourCells(vtkDataSet* input, vtkDataArray* scalars,
+  const double* values, vtkIdType numValues, bool sortByCell, vtkPoints* points,
+  vtkCellArray* verts, vtkCellArray* lines, vtkCellArray* polys, vtkPointData* inPd,
+  vtkCellData* inCd, vtkPointData* outPd, vtkCellData* outCd, bool outputTriangles)
+{
+  // The chunks are ordered as the cells are visited: by dimension, or by
+  // value when sorting by cell.
+  const vtkIdType numCells = input->GetNumberOfCells();
+  const int numPasses = sortByCell ? static_cast<int>(numValues) : 3;
+  std::vector<ContourChunk> chunks;
+  for (int pass = 0; pass < numPasses; ++pass)
+  {
+    for (vtkIdType begin = 0; begin < numCells; begin += CONTOUR_CHUNK_SIZE)
+    {
+      chunks.emplace_back(
+        sortByCell ? pass : pass + 1, begin, std::min(begin + CONTOUR_CHUNK_SIZE, numCells));
+    }
+  }
+
+  // The cells and points of the input are only thread safe once they have
+  // been accessed from a single thread.
+  if (numCells > 0)
+  {
+    vtkNew<vtkGenericCell> cell;
+    input->GetCell(0, cell);
+    vtkNew<vtkIdList> ptIds;
+    input->GetCellPoints(0, ptIds);
+    input->GetCellType(0);
+    if (input->GetNumberOfPoints() > 0)
+    {
+      double x[3];
+      input->GetPoint(0, x);
+    }
+  }
+
+  vtkNew<vtkPointData> pointDataFlags;
+  CopyFlags<vtkPointData>(outPd, pointDataFlags);
+  vtkNew<vtkCellData> cellDataFlags;
+  CopyFlags<vtkCellData>(outCd, cellDataFlags);
+  unsigned char cellTypeDimensions[VTK_NUMBER_OF_CELL_TYPES];
+  vtkCutter::GetCellTypeDimensions(cellTypeDimensions);
+  ContourChunkCells contour{ input, scalars, values, numValues, sortByCell,
+    points->GetDataType(), inPd, inCd, pointDataFlags, cellDataFlags, outputTriangles, chunks,
+    cellTypeDimensions };
+  vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()), 1, contour);
+
+  // Offsets of the points, cells and connectivity of each chunk.
+  vtkIdType numPts = 0;
+  vtkIdType numOutCells[3] = { 0, 0, 0 };
+  vtkIdType connectivitySizes[3] = { 0, 0, 0 };
+  int numOutputChunks = 0;
+  for (ContourChunk& chunk : chunks)
+  {
+    if (!chunk.Points)
+    {
+      continue;
+    }
+    ++numOutputChunks;
+    chunk.PointOffset = numPts;
+    numPts += chunk.Points->GetNumberOfPoints();
+    for (int i = 0; i < 3; ++i)
+    {
+      chunk.CellOffsets[i] = numOutCells[i];
+      chunk.ConnectivityOffsets[i] = connectivitySizes[i];
+      numOutCells[i] += chunk.Cells[i]->GetNumberOfCells();
+      connectivitySizes[i] += chunk.Cells[i]->GetNumberOfConnectivityIds();
+    }
+  }
+
+  // The points of different chunks may coincide. They are merged, and
+  // numbered by their first use.
+  std::vector<vtkIdType> mergeMap(numPts);
+  if (numOutputChunks > 1)
+  {
+    vtkNew<vtkPoints> allPoints;
+    allPoints->SetDataType(points->GetDataType());
+    allPoints->SetNumberOfPoints(numPts);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()), [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType chunkId = begin; chunkId < end; ++chunkId)
+      {
+        const ContourChunk& chunk = chunks[chunkId];
+        if (chunk.Points)
+        {
+          CopyTuples(allPoints->GetData(), chunk.Points->GetData(), 0,
+            chunk.Points->GetNumberOfPoints(), chunk.PointOffset);
+        }
+      }
+    });
+    vtkNew<vtkPolyData> pointSet;
+    pointSet->SetPoints(allPoints);
+    vtkNew<vtkStaticPointLocator> locator;
+    locator->SetDataSet(pointSet);
+    locator->BuildLocator();
+    locator->MergePoints(0.0, mergeMap.data());
+  }
+  else
+  {
+    std::iota(mergeMap.begin(), mergeMap.end(), 0);
+  }
+  std::vector<vtkIdType> pointMap(numPts, -1);
+  std::vector<vtkIdType> sourceIds;
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    vtkIdType& outId = pointMap[mergeMap[ptId]];
+    if (outId < 0)
+    {
+      outId = static_cast<vtkIdType>(sourceIds.size());
+      sourceIds.push_back(ptId);
+    }
+    pointMap[ptId] = outId;
+  }
+  const vtkIdType numOutPts = static_cast<vtkIdType>(sourceIds.size());
+
+  // Allocate the output, and copy the chunks to it concurrently.
+  points->SetNumberOfPoints(numOutPts);
+  for (int i = 0; i < outPd->GetNumberOfArrays(); ++i)
+  {
+    outPd->GetAbstractArray(i)->SetNumberOfTuples(numOutPts);
+  }
+  const vtkIdType totalNumCells = numOutCells[0] + numOutCells[1] + numOutCells[2];
+  for (int i = 0; i < outCd->GetNumberOfArrays(); ++i)
+  {
+    outCd->GetAbstractArray(i)->SetNumberOfTuples(totalNumCells);
+  }
+  const vtkIdType typeOffsets[3] = { 0, numOutCells[0], numOutCells[0] + numOutCells[1] };
+  vtkCellArray* outCells[3] = { verts, lines, polys };
+  vtkNew<vtkIdTypeArray> offsets[3];
+  vtkNew<vtkIdTypeArray> connectivity[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    offsets[i]->SetNumberOfValues(numOutCells[i] + 1);
+    offsets[i]->SetValue(numOutCells[i], connectivitySizes[i]);
+    connectivity[i]->SetNumberOfValues(connectivitySizes[i]);
+  }
+
+  // Copy the point and cell data of a chunk held by the output arrays that
+  // can, or cannot, be written concurrently. The points and their data come
+  // from their first use.
+  auto copyChunkData = [&](const ContourChunk& chunk, bool inParallel) {
+    const vtkIdType* chunkPointMap = pointMap.data() + chunk.PointOffset;
+    const vtkIdType numChunkPts = chunk.Points->GetNumberOfPoints();
+    const int numPointArrays =
+      std::min(outPd->GetNumberOfArrays(), chunk.PointData->GetNumberOfArrays());
+    for (int i = 0; i < numPointArrays; ++i)
+    {
+      vtkAbstractArray* outArray = outPd->GetAbstractArray(i);
+      if (CanCopyTuplesInParallel(outArray) != inParallel)
+      {
+        continue;
+      }
+      for (vtkIdType ptId = 0; ptId < numChunkPts; ++ptId)
+      {
+        const vtkIdType outId = chunkPointMap[ptId];
+        if (sourceIds[outId] == chunk.PointOffset + ptId)
+        {
+          outArray->SetTuple(outId, ptId, chunk.PointData->GetAbstractArray(i));
+        }
+      }
+    }
+    for (int type = 0; type < 3; ++type)
+    {
+      vtkCellData* chunkCd = chunk.CellData[type];
+      const int numCellArrays = std::min(outCd->GetNumberOfArrays(), chunkCd->GetNumberOfArrays());
+      for (int i = 0; i < numCellArrays; ++i)
+      {
+        if (CanCopyTuplesInParallel(outCd->GetAbstractArray(i)) == inParallel)
+        {
+          CopyTuples(outCd->GetAbstractArray(i), chunkCd->GetAbstractArray(i), 0,
+            chunk.Cells[type]->GetNumberOfCells(), typeOffsets[type] + chunk.CellOffsets[type]);
+        }
+      }
+    }
+  };
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType chunkId = begin; chunkId < end; ++chunkId)
+    {
+      const ContourChunk& chunk = chunks[chunkId];
+      if (!chunk.Points)
+      {
+        continue;
+      }
+
+      const vtkIdType* chunkPointMap = pointMap.data() + chunk.PointOffset;
+      const vtkIdType numChunkPts = chunk.Points->GetNumberOfPoints();
+      for (vtkIdType ptId = 0; ptId < numChunkPts; ++ptId)
+      {
+        const vtkIdType outId = chunkPointMap[ptId];
+        if (sourceIds[outId] == chunk.PointOffset + ptId)
+        {
+          points->GetData()->SetTuple(outId, ptId, chunk.Points->GetData());
+        }
+      }
+      copyChunkData(chunk, true);
+
+      for (int type = 0; type < 3; ++type)
+      {
+        const vtkIdType numChunkCells = chunk.Cells[type]->GetNumberOfCells();
+        if (numChunkCells == 0)
+        {
+          continue;
+        }
+        chunk.Cells[type]->Visit(CopyCellsImpl{},
+          offsets[type]->GetPointer(chunk.CellOffsets[type]), connectivity[type]->GetPointer(0),
+          chunk.ConnectivityOffsets[type], chunkPointMap);
+        for (size_t i = 0; type == 2 && i < chunk.MergedPolygons.size(); ++i)
+        {
+          SortMergedPolygons(chunk.Cells[2], chunk.MergedPolygons[i].first,
+            chunk.MergedPolygons[i].second, offsets[2]->GetPointer(chunk.CellOffsets[2]),
+            connectivity[2]->GetPointer(0));
+        }
+      }
+    }
+  });
+  for (const ContourChunk& chunk : chunks)
+  {
+    if (chunk.Points)
+    {
+      copyChunkData(chunk, false);
+    }
+  }
+  for (int i = 0; i < 3; ++i)
+  {
+    outCells[i]->SetData(offsets[i], connectivity[i]);
+  }
+}
@@ -20,6 +20,9 @@
  *  produce either triangles and/or polygons based on the outputTriangles parameter
  *  When working with multidimensional dataset, it is needed to process cells
  *  from low to high dimensions.
+ *
+ *  ContourCells() contours all the cells of a dataset concurrently, and is
+ *  shared by the generic paths of vtkContourGrid and vtkCutter.
  * @sa
  * vtkContourGrid vtkCutter vtkContourFilter
  */
@@ -33,6 +36,8 @@
 
 class vtkIncrementalPointLocator;
 class vtkCellArray;
+class vtkDataSet;
+class vtkPoints;
 class vtkPointData;
 class vtkCellData;
 class vtkCell;
@@ -48,6 +53,41 @@ public:
   ~vtkContourHelper();
   void Contour(vtkCell* cell, double value, vtkDataArray* cellScalars, vtkIdType cellId);
 
+  /**
+   * The number of polygons merged from triangles by the last call to
+   * Contour(). They are the last polygons it inserted.
+   */
+  vtkIdType GetNumberOfMergedPolygons() const { return this->NumberOfMergedPolygons; }
+
+  /**
+   * Whether ContourCells() can contour the cells of the input. Higher order
+   * cells, which update the input when they are contoured, must be
+   * contoured sequentially.
+   */
+  static bool CanContourInParallel(vtkDataSet* input);
+
+  /**
+   * Contour the cells of the input with vtkSMPTools. The cells are split in
+   * chunks, each contoured by its own helper into its own points, cells and
+   * attributes, merging the points of equal coordinates. The chunks are then
+   * merged in order, coincident points keeping the id and data of their first
+   * use, so that the output is the one of a single helper contouring the
+   * cells in order, whatever the number of threads. Unlike vtkMergePoints,
+   * which only searches the bucket of a point, all the coincident points are
+   * merged.
+   *
+   * The cells are visited by increasing dimension and contoured for each
+   * value within the range of their scalars, or for each value in turn when
+   * sortByCell is true. The range of a cell covers all the components of
+   * its scalars. The points, cells and attributes are replaced. The output
+   * attributes must have been allocated from the input ones, so that their
+   * copy flags apply.
+   */
+  static void ContourCells(vtkDataSet* input, vtkDataArray* scalars, const double* values,
+    vtkIdType numValues, bool sortByCell, vtkPoints* points, vtkCellArray* verts,
+    vtkCellArray* lines, vtkCellArray* polys, vtkPointData* inPd, vtkCellData* inCd,
+    vtkPointData* outPd, vtkCellData* outCd, bool outputTriangles);
+
 private:
   vtkContourHelper(const vtkContourHelper&) = delete;
   vtkContourHelper& operator=(const vtkContourHelper&) = delete;
@@ -66,6 +106,7 @@ private:
   vtkPolygonBuilder PolyBuilder;
   vtkIdListCollection* PolyCollection;
   bool GenerateTriangles;
+  vtkIdType NumberOfMergedPolygons;
 };
 
 #endif
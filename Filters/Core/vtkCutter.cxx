@@ -41,6 +41,8 @@
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearSynchronizedTemplates.h"
+#include "vtkSMPFiltersInternal.h" // For CanEvaluateInParallel
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
@@ -558,12 +560,31 @@ void vtkCutter::DataSetCutter(vtkDataSet* input, vtkPolyData* output)
 
   // Loop over all points evaluating scalar function at each point
   //
-  for (vtkIdType i = 0; i < numPts; ++i)
+  if (numPts > 0 && CanEvaluateInParallel(this->CutFunction))
   {
+    // GetPoint() is only thread safe once it has been called from a single
+    // thread.
     double x[3];
-    input->GetPoint(i, x);
-    double s = this->CutFunction->FunctionValue(x);
-    cutScalars->SetComponent(i, 0, s);
+    input->GetPoint(0, x);
+    vtkImplicitFunction* cutFunction = this->CutFunction;
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      double pt[3];
+      for (; ptId < endPtId; ++ptId)
+      {
+        input->GetPoint(ptId, pt);
+        cutScalars->SetValue(ptId, cutFunction->FunctionValue(pt));
+      }
+    });
+  }
+  else
+  {
+    for (vtkIdType i = 0; i < numPts; ++i)
+    {
+      double x[3];
+      input->GetPoint(i, x);
+      double s = this->CutFunction->FunctionValue(x);
+      cutScalars->SetComponent(i, 0, s);
+    }
   }
 
   // Compute some information for progress methods
@@ -571,7 +592,16 @@ void vtkCutter::DataSetCutter(vtkDataSet* input, vtkPolyData* output)
   cell = vtkGenericCell::New();
   vtkContourHelper helper(this->Locator, newVerts, newLines, newPolys, inPD, inCD, outPD, outCD,
     estimatedSize, this->GenerateTriangles != 0);
-  if (this->SortBy == VTK_SORT_BY_CELL)
+  if (vtkMergePoints::SafeDownCast(this->Locator) &&
+    vtkContourHelper::CanContourInParallel(input))
+  {
+    // Cut the cells concurrently, with the output of the loops below in
+    // which all the coincident points are merged.
+    vtkContourHelper::ContourCells(input, cutScalars, this->ContourValues->GetValues(),
+      numContours, this->SortBy == VTK_SORT_BY_CELL, newPoints, newVerts, newLines, newPolys, inPD,
+      inCD, outPD, outCD, this->GenerateTriangles != 0);
+  }
+  else if (this->SortBy == VTK_SORT_BY_CELL)
   {
     vtkIdType numCuts = numContours * numCells;
     vtkIdType progressInterval = numCuts / 20 + 1;
@@ -732,7 +762,6 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet* input, vtkPolyData* output)
   vtkCellArray *newVerts, *newLines, *newPolys;
   vtkPoints* newPoints;
   vtkDoubleArray* cutScalars;
-  double value;
   vtkIdType estimatedSize, numCells = input->GetNumberOfCells();
   vtkIdType numPts = input->GetNumberOfPoints();
   vtkIdType numCellPts;
@@ -813,7 +842,20 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet* input, vtkPolyData* output)
   this->Locator->InitPointInsertion(newPoints, input->GetBounds());
 
   // Loop over all points evaluating scalar function at each point
-  if (inputPointSet)
+  if (inputPointSet && CanEvaluateInParallel(this->CutFunction))
+  {
+    vtkPoints* inPts = inputPointSet->GetPoints();
+    vtkImplicitFunction* cutFunction = this->CutFunction;
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      double pt[3];
+      for (; ptId < endPtId; ++ptId)
+      {
+        inPts->GetPoint(ptId, pt);
+        cutScalars->SetValue(ptId, cutFunction->FunctionValue(pt));
+      }
+    });
+  }
+  else if (inputPointSet)
   {
     vtkDataArray* dataArrayInput = inputPointSet->GetPoints()->GetData();
     this->CutFunction->FunctionValue(dataArrayInput, cutScalars);
@@ -830,7 +872,16 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet* input, vtkPolyData* output)
 
   vtkContourHelper helper(this->Locator, newVerts, newLines, newPolys, inPD, inCD, outPD, outCD,
     estimatedSize, this->GenerateTriangles != 0);
-  if (this->SortBy == VTK_SORT_BY_CELL)
+  if (vtkMergePoints::SafeDownCast(this->Locator) &&
+    vtkContourHelper::CanContourInParallel(input))
+  {
+    // Cut the cells concurrently, with the output of the loops below in
+    // which all the coincident points are merged.
+    vtkContourHelper::ContourCells(input, cutScalars, contourValues, numContours,
+      this->SortBy == VTK_SORT_BY_CELL, newPoints, newVerts, newLines, newPolys, inPD, inCD, outPD,
+      outCD, this->GenerateTriangles != 0);
+  }
+  else if (this->SortBy == VTK_SORT_BY_CELL)
   {
     // Compute some information for progress methods
     //
@@ -884,12 +935,7 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet* input, vtkPolyData* output)
           input->SetCellOrderAndRationalWeights(cellId, cell);
           cellIds = cell->GetPointIds();
           cutScalars->GetTuples(cellIds, cellScalars);
-          // Loop over all contour values.
-          for (iter = 0; iter < numContours && !abortExecute; iter++)
-          {
-            value = this->ContourValues->GetValue(iter);
-            helper.Contour(cell, value, cellScalars, cellIter->GetCellId());
-          }
+          helper.Contour(cell, val, cellScalars, cellId);
         }
 
       } // for all cells
@@ -983,7 +1029,7 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet* input, vtkPolyData* output)
         {
           // Fetch the full cell -- most expensive.
           cellIter->GetCell(cell);
-          input->SetCellOrderAndRationalWeights(cellId, cell);
+          input->SetCellOrderAndRationalWeights(cellIter->GetCellId(), cell);
           cutScalars->GetTuples(pointIdList, cellScalars);
           // Loop over all contour values.
           for (contourIter = contourValues; contourIter != contourValuesEnd; ++contourIter)
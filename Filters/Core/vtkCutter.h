@@ -38,6 +38,10 @@
  * By default, if an implicit function is set it is used to clip the data
  * set, otherwise the dataset scalars are used to perform the clipping.
  *
+ * Unless the input is handled by one of the specialized algorithms, its
+ * cells are cut concurrently with vtkSMPTools when the locator is a
+ * vtkMergePoints (the default). Any other locator cuts the cells serially.
+ *
  * @sa
  * vtkImplicitFunction vtkClipPolyData
  */
@@ -167,7 +171,8 @@ public:
   //@{
   /**
    * Specify a spatial locator for merging points. By default,
-   * an instance of vtkMergePoints is used.
+   * an instance of vtkMergePoints is used, and the cells are cut in
+   * parallel.
    */
   void SetLocator(vtkIncrementalPointLocator* locator);
   vtkGetObjectMacro(Locator, vtkIncrementalPointLocator);
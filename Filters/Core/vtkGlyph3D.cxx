@@ -14,7 +14,9 @@
 =========================================================================*/
 #include "vtkGlyph3D.h"
 
+#include "vtkArrayListTemplate.h"
 #include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
@@ -22,10 +24,13 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkMatrix4x4.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTransform.h"
@@ -33,6 +38,150 @@
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace
+{
+// The number of input points glyphed by each task of the threaded passes.
+const vtkIdType GLYPH_BLOCK_SIZE = 1024;
+
+// A glyph source prepared to be copied concurrently: its points, transformed
+// by the source transform, in double precision, and the offsets and
+// connectivity of its verts, lines, polys and strips.
+struct GlyphSource
+{
+  vtkIdType NumberOfPoints = 0;
+  std::vector<double> Points;
+  vtkDataArray* Normals = nullptr;
+  std::vector<vtkIdType> Offsets[4] = { { 0 }, { 0 }, { 0 }, { 0 } };
+  std::vector<vtkIdType> Connectivity[4];
+
+  void Initialize(vtkPolyData* source, vtkTransform* sourceTransform)
+  {
+    vtkSmartPointer<vtkPoints> points = source->GetPoints();
+    if (points && sourceTransform)
+    {
+      vtkNew<vtkPoints> transformedPoints;
+      transformedPoints->SetDataTypeToDouble();
+      transformedPoints->Allocate(points->GetNumberOfPoints());
+      sourceTransform->TransformPoints(points, transformedPoints);
+      points = transformedPoints;
+    }
+    this->NumberOfPoints = points ? points->GetNumberOfPoints() : 0;
+    this->Points.resize(3 * this->NumberOfPoints);
+    for (vtkIdType i = 0; i < this->NumberOfPoints; ++i)
+    {
+      points->GetPoint(i, this->Points.data() + 3 * i);
+    }
+    this->Normals = source->GetPointData()->GetNormals();
+
+    vtkCellArray* cellArrays[4] = { source->GetVerts(), source->GetLines(), source->GetPolys(),
+      source->GetStrips() };
+    vtkNew<vtkIdList> cellPts;
+    for (int type = 0; type < 4; ++type)
+    {
+      const vtkIdType numCells = cellArrays[type]->GetNumberOfCells();
+      this->Offsets[type].assign(1, 0);
+      this->Offsets[type].reserve(numCells + 1);
+      this->Connectivity[type].clear();
+      this->Connectivity[type].reserve(cellArrays[type]->GetNumberOfConnectivityIds());
+      for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+      {
+        cellArrays[type]->GetCellAtId(cellId, cellPts);
+        this->Connectivity[type].insert(
+          this->Connectivity[type].end(), cellPts->begin(), cellPts->end());
+        this->Offsets[type].push_back(static_cast<vtkIdType>(this->Connectivity[type].size()));
+      }
+    }
+  }
+
+  vtkIdType GetNumberOfCells(int type) const
+  {
+    return static_cast<vtkIdType>(this->Offsets[type].size()) - 1;
+  }
+};
+
+// The number of points, cells and connectivity ids generated for a block of
+// input points and, once scanned, the offsets of the block in the output.
+struct GlyphOffsets
+{
+  vtkIdType Points = 0;
+  vtkIdType Cells[4] = { 0, 0, 0, 0 };
+  vtkIdType Connectivity[4] = { 0, 0, 0, 0 };
+
+  void Add(const GlyphSource& source)
+  {
+    this->Points += source.NumberOfPoints;
+    for (int type = 0; type < 4; ++type)
+    {
+      this->Cells[type] += source.GetNumberOfCells(type);
+      this->Connectivity[type] += static_cast<vtkIdType>(source.Connectivity[type].size());
+    }
+  }
+
+  void Add(const GlyphOffsets& other)
+  {
+    this->Points += other.Points;
+    for (int type = 0; type < 4; ++type)
+    {
+      this->Cells[type] += other.Cells[type];
+      this->Connectivity[type] += other.Connectivity[type];
+    }
+  }
+};
+
+// The glyph of an input point: its scalar, its vector (with magnitude), its
+// scale factors and the index of its source.
+struct PointGlyph
+{
+  double S;
+  double V[3];
+  double VMag;
+  double Scale[3];
+  int Source;
+};
+
+// Apply the glyph matrix to the source points and write them to the output.
+template <typename T>
+void TransformGlyphPoints(const double* matrix, const double* in, vtkIdType numPts, T* out)
+{
+  for (vtkIdType i = 0; i < numPts; ++i, in += 3, out += 3)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      out[j] = static_cast<T>(matrix[4 * j] * in[0] + matrix[4 * j + 1] * in[1] +
+        matrix[4 * j + 2] * in[2] + matrix[4 * j + 3]);
+    }
+  }
+}
+
+// Apply the transposed inverse of the glyph matrix to the source normals,
+// normalize them and write them to the output.
+void TransformGlyphNormals(
+  const double* matrix, vtkDataArray* inNormals, vtkIdType numPts, float* out)
+{
+  double normalMatrix[16];
+  vtkMatrix4x4::Invert(matrix, normalMatrix);
+  vtkMatrix4x4::Transpose(normalMatrix, normalMatrix);
+  for (vtkIdType i = 0; i < numPts; ++i, out += 3)
+  {
+    double in[3], normal[3];
+    inNormals->GetTuple(i, in);
+    for (int j = 0; j < 3; ++j)
+    {
+      normal[j] = normalMatrix[4 * j] * in[0] + normalMatrix[4 * j + 1] * in[1] +
+        normalMatrix[4 * j + 2] * in[2];
+    }
+    vtkMath::Normalize(normal);
+    out[0] = static_cast<float>(normal[0]);
+    out[1] = static_cast<float>(normal[1]);
+    out[2] = static_cast<float>(normal[2]);
+  }
+}
+}
+
 vtkStandardNewMacro(vtkGlyph3D);
 vtkCxxSetObjectMacro(vtkGlyph3D, SourceTransform, vtkTransform);
 
@@ -136,40 +285,24 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   vtkPointData* pd;
   vtkDataArray* inCScalars; // Scalars for Coloring
   unsigned char* inGhostLevels = nullptr;
-  vtkDataArray *inNormals, *sourceNormals = nullptr;
+  vtkDataArray* inNormals;
   vtkDataArray* sourceTCoords = nullptr;
-  vtkIdType numPts, numSourcePts, numSourceCells, inPtId, i;
-  vtkPoints* sourcePts = nullptr;
-  vtkSmartPointer<vtkPoints> transformedSourcePts = vtkSmartPointer<vtkPoints>::New();
+  vtkIdType numPts;
   vtkPoints* newPts;
   vtkDataArray* newScalars = nullptr;
-  vtkDataArray* newVectors = nullptr;
-  vtkDataArray* newNormals = nullptr;
-  vtkDataArray* newTCoords = nullptr;
-  double x[3], v[3], vNew[3], s = 0.0, vMag = 0.0, value, tc[3];
-  vtkTransform* trans = vtkTransform::New();
-  vtkNew<vtkIdList> pointIdList;
-  vtkIdList* cellPts;
-  int npts;
-  vtkIdList* pts;
-  vtkIdType ptIncr, cellIncr, cellId;
+  vtkFloatArray* newVectors = nullptr;
+  vtkFloatArray* newNormals = nullptr;
+  vtkFloatArray* newTCoords = nullptr;
   int haveVectors, haveNormals, haveTCoords = 0;
-  double scalex, scaley, scalez, den;
+  double den;
   vtkPointData* outputPD = output->GetPointData();
   vtkCellData* outputCD = output->GetCellData();
   int numberOfSources = this->GetNumberOfInputConnections(1);
   vtkIdTypeArray* pointIds = nullptr;
   vtkSmartPointer<vtkPolyData> source = this->GetSource(0, sourceVector);
-  vtkNew<vtkIdList> srcPointIdList;
-  vtkNew<vtkIdList> dstPointIdList;
-  vtkNew<vtkIdList> srcCellIdList;
-  vtkNew<vtkIdList> dstCellIdList;
 
   vtkDebugMacro(<< "Generating glyphs");
 
-  pts = vtkIdList::New();
-  pts->Allocate(VTK_CELL_SIZE);
-
   pd = input->GetPointData();
   inNormals = this->GetInputArrayToProcess(2, input);
   inCScalars = this->GetInputArrayToProcess(3, input);
@@ -196,8 +329,6 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   if (numPts < 1)
   {
     vtkDebugMacro(<< "No points to glyph!");
-    pts->Delete();
-    trans->Delete();
     return true;
   }
 
@@ -219,6 +350,17 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     haveVectors = 0;
   }
 
+  vtkDataArray* array3D = nullptr;
+  if (haveVectors && this->VectorMode != VTK_FOLLOW_CAMERA_DIRECTION)
+  {
+    array3D = this->VectorMode == VTK_USE_NORMAL ? inNormals : inVectors;
+    if (array3D->GetNumberOfComponents() > 3)
+    {
+      vtkErrorMacro(<< "vtkDataArray " << array3D->GetName() << " has more than 3 components.\n");
+      return false;
+    }
+  }
+
   if ((this->IndexMode == VTK_INDEXING_BY_SCALAR && !inSScalars) ||
     (this->IndexMode == VTK_INDEXING_BY_VECTOR &&
       ((!inVectors && this->VectorMode == VTK_USE_VECTOR) ||
@@ -227,8 +369,6 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     if (source == nullptr)
     {
       vtkErrorMacro(<< "Indexing on but don't have data to index with");
-      pts->Delete();
-      trans->Delete();
       return true;
     }
     else
@@ -260,24 +400,21 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     source = defaultSource;
   }
 
+  // Prepare the glyph sources to be copied concurrently. In index mode, the
+  // points indexing a missing source get an empty glyph.
+  std::vector<GlyphSource> glyphSources;
   if (this->IndexMode != VTK_INDEXING_OFF)
   {
     pd = nullptr;
     haveNormals = 1;
-    for (numSourcePts = numSourceCells = i = 0; i < numberOfSources; i++)
+    glyphSources.resize(numberOfSources);
+    for (int i = 0; i < numberOfSources; i++)
     {
       source = this->GetSource(i, sourceVector);
       if (source != nullptr)
       {
-        if (source->GetNumberOfPoints() > numSourcePts)
-        {
-          numSourcePts = source->GetNumberOfPoints();
-        }
-        if (source->GetNumberOfCells() > numSourceCells)
-        {
-          numSourceCells = source->GetNumberOfCells();
-        }
-        if (!(sourceNormals = source->GetPointData()->GetNormals()))
+        glyphSources[i].Initialize(source, this->SourceTransform);
+        if (!glyphSources[i].Normals)
         {
           haveNormals = 0;
         }
@@ -286,19 +423,9 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   }
   else
   {
-    sourcePts = source->GetPoints();
-    numSourcePts = sourcePts->GetNumberOfPoints();
-    numSourceCells = source->GetNumberOfCells();
-
-    sourceNormals = source->GetPointData()->GetNormals();
-    if (sourceNormals)
-    {
-      haveNormals = 1;
-    }
-    else
-    {
-      haveNormals = 0;
-    }
+    glyphSources.resize(1);
+    glyphSources[0].Initialize(source, this->SourceTransform);
+    haveNormals = glyphSources[0].Normals ? 1 : 0;
 
     sourceTCoords = source->GetPointData()->GetTCoords();
     if (sourceTCoords)
@@ -310,19 +437,137 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
       haveTCoords = 0;
     }
 
-    // Prepare to copy output.
     pd = input->GetPointData();
-    outputPD->CopyAllocate(pd, numPts * numSourcePts);
-    if (this->FillCellData)
+  }
+
+  // Compute the scale factors, orientation vector and source of a point.
+  auto computeGlyph = [&](vtkIdType inPtId, PointGlyph& glyph) {
+    double& scalex = glyph.Scale[0];
+    double& scaley = glyph.Scale[1];
+    double& scalez = glyph.Scale[2];
+    double* v = glyph.V;
+    scalex = scaley = scalez = 1.0;
+    glyph.S = 0.0;
+    glyph.VMag = 0.0;
+    v[0] = v[1] = v[2] = 0.0;
+
+    // Get the scalar and vector data
+    if (inSScalars)
+    {
+      glyph.S = inSScalars->GetComponent(inPtId, 0);
+      if (this->ScaleMode == VTK_SCALE_BY_SCALAR || this->ScaleMode == VTK_DATA_SCALING_OFF)
+      {
+        scalex = scaley = scalez = glyph.S;
+      }
+    }
+
+    if (haveVectors)
+    {
+      if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+      {
+        glyph.VMag = 1.0; // v will be set later
+      }
+      else
+      {
+        array3D->GetTuple(inPtId, v);
+        glyph.VMag = vtkMath::Norm(v);
+        if (this->ScaleMode == VTK_SCALE_BY_VECTORCOMPONENTS)
+        {
+          scalex = v[0];
+          scaley = v[1];
+          scalez = v[2];
+        }
+        else if (this->ScaleMode == VTK_SCALE_BY_VECTOR)
+        {
+          scalex = scaley = scalez = glyph.VMag;
+        }
+      }
+    }
+
+    // Clamp data scale if enabled
+    if (this->Clamping)
     {
-      outputCD->CopyAllocate(pd, numPts * numSourceCells);
+      scalex = (scalex < this->Range[0] ? this->Range[0]
+                                        : (scalex > this->Range[1] ? this->Range[1] : scalex));
+      scalex = (scalex - this->Range[0]) / den;
+      scaley = (scaley < this->Range[0] ? this->Range[0]
+                                        : (scaley > this->Range[1] ? this->Range[1] : scaley));
+      scaley = (scaley - this->Range[0]) / den;
+      scalez = (scalez < this->Range[0] ? this->Range[0]
+                                        : (scalez > this->Range[1] ? this->Range[1] : scalez));
+      scalez = (scalez - this->Range[0]) / den;
+    }
+
+    // Compute index into table of glyphs
+    glyph.Source = 0;
+    if (this->IndexMode != VTK_INDEXING_OFF)
+    {
+      double value = this->IndexMode == VTK_INDEXING_BY_SCALAR ? glyph.S : glyph.VMag;
+      int index = static_cast<int>((value - this->Range[0]) * numberOfSources / den);
+      glyph.Source =
+        (index < 0 ? 0 : (index >= numberOfSources ? (numberOfSources - 1) : index));
+    }
+  };
+
+  // Mask the points that are not glyphed (-1). If we are processing a piece,
+  // we do not want to duplicate glyphs on the borders, and blanked points are
+  // not glyphed either. This is done on the calling thread, since overrides
+  // of IsPointVisible() are not required to be thread safe.
+  std::vector<int> pointSources(numPts, 0);
+  for (vtkIdType inPtId = 0; inPtId < numPts; ++inPtId)
+  {
+    if ((inGhostLevels && inGhostLevels[inPtId] & vtkDataSetAttributes::DUPLICATEPOINT) ||
+      (inputUG && !inputUG->IsPointVisible(inPtId)) || !this->IsPointVisible(input, inPtId))
+    {
+      pointSources[inPtId] = -1;
     }
   }
 
-  srcPointIdList->SetNumberOfIds(numSourcePts);
-  dstPointIdList->SetNumberOfIds(numSourcePts);
-  srcCellIdList->SetNumberOfIds(numSourceCells);
-  dstCellIdList->SetNumberOfIds(numSourceCells);
+  // Make sure the lazily built structures of the input are ready before the
+  // threads query them.
+  double x[3];
+  input->GetPoint(0, x);
+
+  // First pass: select the source of each glyphed point (-1 if it has none)
+  // and count what each block of points generates. The counts are then
+  // scanned into the offsets of the blocks in the output.
+  const vtkIdType numBlocks = (numPts + GLYPH_BLOCK_SIZE - 1) / GLYPH_BLOCK_SIZE;
+  std::vector<GlyphOffsets> blockOffsets(numBlocks + 1);
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType beginBlock, vtkIdType endBlock) {
+    PointGlyph glyph;
+    for (vtkIdType block = beginBlock; block < endBlock; ++block)
+    {
+      GlyphOffsets& blockSize = blockOffsets[block + 1];
+      const vtkIdType endPtId = std::min(numPts, (block + 1) * GLYPH_BLOCK_SIZE);
+      for (vtkIdType inPtId = block * GLYPH_BLOCK_SIZE; inPtId < endPtId; ++inPtId)
+      {
+        if (pointSources[inPtId] < 0)
+        {
+          continue;
+        }
+        computeGlyph(inPtId, glyph);
+        pointSources[inPtId] = glyph.Source;
+        if (glyph.Source >= 0)
+        {
+          blockSize.Add(glyphSources[glyph.Source]);
+        }
+      }
+    }
+  });
+  for (vtkIdType block = 0; block < numBlocks; ++block)
+  {
+    blockOffsets[block + 1].Add(blockOffsets[block]);
+  }
+  this->UpdateProgress(0.1);
+  const GlyphOffsets& totals = blockOffsets[numBlocks];
+  const vtkIdType numOutPts = totals.Points;
+  vtkIdType numOutCells = 0;
+  vtkIdType cellTypeOffsets[4];
+  for (int type = 0; type < 4; ++type)
+  {
+    cellTypeOffsets[type] = numOutCells;
+    numOutCells += totals.Cells[type];
+  }
 
   newPts = vtkPoints::New();
 
@@ -339,13 +584,32 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   {
     newPts->SetDataType(VTK_DOUBLE);
   }
+  newPts->SetNumberOfPoints(numOutPts);
+
+  // Prepare to copy output. The attributes are copied by the threads when
+  // all their arrays can be, else on the calling thread once the glyphs
+  // are generated.
+  ArrayList pointArrays;
+  ArrayList cellArrays;
+  const bool copyInParallel = pd && ArrayList::CanCopyInParallel(pd);
+  if (pd)
+  {
+    outputPD->CopyAllocate(pd, numOutPts);
+    if (this->FillCellData)
+    {
+      outputCD->CopyAllocate(pd, numOutCells);
+      if (copyInParallel)
+      {
+        cellArrays.AddArrays(numOutCells, pd, outputCD, 0.0, false);
+      }
+    }
+  }
 
-  newPts->Allocate(numPts * numSourcePts);
   if (this->GeneratePointIds)
   {
     pointIds = vtkIdTypeArray::New();
     pointIds->SetName(this->PointIdsName);
-    pointIds->Allocate(numPts * numSourcePts);
+    pointIds->SetNumberOfValues(numOutPts);
     outputPD->AddArray(pointIds);
     pointIds->Delete();
   }
@@ -353,13 +617,13 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   {
     newScalars = inCScalars->NewInstance();
     newScalars->SetNumberOfComponents(inCScalars->GetNumberOfComponents());
-    newScalars->Allocate(inCScalars->GetNumberOfComponents() * numPts * numSourcePts);
+    newScalars->SetNumberOfTuples(numOutPts);
     newScalars->SetName(inCScalars->GetName());
   }
   else if ((this->ColorMode == VTK_COLOR_BY_SCALE) && inSScalars)
   {
     newScalars = vtkFloatArray::New();
-    newScalars->Allocate(numPts * numSourcePts);
+    newScalars->SetNumberOfTuples(numOutPts);
     newScalars->SetName("GlyphScale");
     if (this->ScaleMode == VTK_SCALE_BY_SCALAR)
     {
@@ -369,21 +633,33 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   else if ((this->ColorMode == VTK_COLOR_BY_VECTOR) && haveVectors)
   {
     newScalars = vtkFloatArray::New();
-    newScalars->Allocate(numPts * numSourcePts);
+    newScalars->SetNumberOfTuples(numOutPts);
     newScalars->SetName("VectorMagnitude");
   }
+  if (copyInParallel)
+  {
+    // The copied array that the new scalars replace is not filled.
+    vtkDataArray* replacedArray = (newScalars && newScalars->GetName())
+      ? outputPD->GetArray(newScalars->GetName())
+      : nullptr;
+    if (replacedArray)
+    {
+      pointArrays.ExcludeArray(replacedArray);
+    }
+    pointArrays.AddArrays(numOutPts, pd, outputPD, 0.0, false);
+  }
   if (haveVectors)
   {
     newVectors = vtkFloatArray::New();
     newVectors->SetNumberOfComponents(3);
-    newVectors->Allocate(3 * numPts * numSourcePts);
+    newVectors->SetNumberOfTuples(numOutPts);
     newVectors->SetName("GlyphVector");
   }
   if (haveNormals)
   {
     newNormals = vtkFloatArray::New();
     newNormals->SetNumberOfComponents(3);
-    newNormals->Allocate(3 * numPts * numSourcePts);
+    newNormals->SetNumberOfTuples(numOutPts);
     newNormals->SetName("Normals");
   }
   if (haveTCoords)
@@ -391,335 +667,308 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     newTCoords = vtkFloatArray::New();
     int numComps = sourceTCoords->GetNumberOfComponents();
     newTCoords->SetNumberOfComponents(numComps);
-    newTCoords->Allocate(numComps * numPts * numSourcePts);
+    newTCoords->SetNumberOfTuples(numOutPts);
     newTCoords->SetName("TCoords");
   }
 
-  // Setting up for calls to PolyData::InsertNextCell()
-  output->AllocateEstimate(numPts * numSourceCells, 3);
-
-  transformedSourcePts->SetDataTypeToDouble();
-  transformedSourcePts->Allocate(numSourcePts);
+  vtkNew<vtkIdTypeArray> outOffsets[4];
+  vtkNew<vtkIdTypeArray> outConnectivity[4];
+  for (int type = 0; type < 4; ++type)
+  {
+    outOffsets[type]->SetNumberOfValues(totals.Cells[type] + 1);
+    outOffsets[type]->SetValue(totals.Cells[type], totals.Connectivity[type]);
+    outConnectivity[type]->SetNumberOfValues(totals.Connectivity[type]);
+  }
 
-  // Traverse all Input points, transforming Source points and copying
-  // point attributes.
+  // Second pass: traverse all Input points, transforming Source points and
+  // copying point attributes and cells at the offsets of the glyphs. The
+  // progress observers are not assumed to be thread safe, so progress is
+  // only reported from the calling thread.
   //
-  ptIncr = 0;
-  cellIncr = 0;
-  for (inPtId = 0; inPtId < numPts; inPtId++)
-  {
-    scalex = scaley = scalez = 1.0;
-    if (!(inPtId % 10000))
+  vtkSMPThreadLocalObject<vtkTransform> localTransforms;
+  std::atomic<bool> aborted(false);
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType beginBlock, vtkIdType endBlock) {
+    vtkTransform* trans = localTransforms.Local();
+    PointGlyph glyph;
+    double xPt[3], vNew[3], tc[3];
+    vtkIdType i;
+    for (vtkIdType block = beginBlock; block < endBlock && !aborted; ++block)
     {
-      this->UpdateProgress(static_cast<double>(inPtId) / numPts);
-      if (this->GetAbortExecute())
+      GlyphOffsets offsets = blockOffsets[block];
+      const vtkIdType endPtId = std::min(numPts, (block + 1) * GLYPH_BLOCK_SIZE);
+      for (vtkIdType inPtId = block * GLYPH_BLOCK_SIZE; inPtId < endPtId; ++inPtId)
       {
-        break;
-      }
-    }
+        if (pointSources[inPtId] < 0)
+        {
+          continue;
+        }
+        const GlyphSource& glyphSource = glyphSources[pointSources[inPtId]];
+        const vtkIdType numSourcePts = glyphSource.NumberOfPoints;
+        const vtkIdType ptIncr = offsets.Points;
+        computeGlyph(inPtId, glyph);
+        double* v = glyph.V;
+        double scalex = glyph.Scale[0];
+        double scaley = glyph.Scale[1];
+        double scalez = glyph.Scale[2];
+
+        // Now begin copying/transforming glyph
+        trans->Identity();
+
+        // Copy all topology (transformation independent)
+        for (int type = 0; type < 4; ++type)
+        {
+          const vtkIdType numSourceCells = glyphSource.GetNumberOfCells(type);
+          vtkIdType* cellOffsets = outOffsets[type]->GetPointer(offsets.Cells[type]);
+          for (vtkIdType cellId = 0; cellId < numSourceCells; ++cellId)
+          {
+            cellOffsets[cellId] = glyphSource.Offsets[type][cellId] + offsets.Connectivity[type];
+          }
+          vtkIdType* cellPts = outConnectivity[type]->GetPointer(offsets.Connectivity[type]);
+          for (vtkIdType ptId : glyphSource.Connectivity[type])
+          {
+            *cellPts++ = ptId + ptIncr;
+          }
+        }
 
-    // Get the scalar and vector data
-    if (inSScalars)
-    {
-      s = inSScalars->GetComponent(inPtId, 0);
-      if (this->ScaleMode == VTK_SCALE_BY_SCALAR || this->ScaleMode == VTK_DATA_SCALING_OFF)
-      {
-        scalex = scaley = scalez = s;
-      }
-    }
+        // translate Source to Input point
+        input->GetPoint(inPtId, xPt);
+        trans->Translate(xPt[0], xPt[1], xPt[2]);
 
-    if (haveVectors)
-    {
-      if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
-      {
-        vMag = 1.0; // v will be set later
-      }
-      else
-      {
-        vtkDataArray* array3D = this->VectorMode == VTK_USE_NORMAL ? inNormals : inVectors;
-        if (array3D->GetNumberOfComponents() > 3)
+        if (haveVectors)
         {
-          vtkErrorMacro(<< "vtkDataArray " << array3D->GetName()
-                        << " has more than 3 components.\n");
-          pts->Delete();
-          trans->Delete();
-          if (newPts)
+          // Copy Input vector
+          for (i = 0; i < numSourcePts; i++)
           {
-            newPts->Delete();
+            newVectors->SetTuple(i + ptIncr, v);
           }
-          if (newVectors)
+          if (this->Orient)
           {
-            newVectors->Delete();
+            if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+            {
+              // v = glyphNormal_World (glyph normal direction in World coordinate system)
+              v[0] = this->FollowedCameraPosition[0] - xPt[0];
+              v[1] = this->FollowedCameraPosition[1] - xPt[1];
+              v[2] = this->FollowedCameraPosition[2] - xPt[2];
+              vtkMath::Normalize(v);
+              double glyphRight_World[3]; // glyph right direction in World coordinate system
+              vtkMath::Cross(this->FollowedCameraViewUp, v, glyphRight_World);
+              // glyph up direction in World coordinate system
+              // (approximately the same as this->FollowedCameraViewUp, but slightly adjusted to be
+              // orthogonal to the normal direction)
+              double glyphUp_World[3];
+              vtkMath::Cross(v, glyphRight_World, glyphUp_World);
+              double glyphToWorld[16] = { glyphRight_World[0], glyphUp_World[0], v[0], 0.0,
+                glyphRight_World[1], glyphUp_World[1], v[1], 0.0, glyphRight_World[2],
+                glyphUp_World[2], v[2], 0.0, 0.0, 0.0, 0.0, 1.0 };
+              trans->Concatenate(glyphToWorld);
+            }
+            else if (glyph.VMag > 0.0)
+            {
+              // if there is no y or z component
+              if (v[1] == 0.0 && v[2] == 0.0)
+              {
+                if (v[0] < 0) // just flip x if we need to
+                {
+                  trans->RotateWXYZ(180.0, 0, 1, 0);
+                }
+              }
+              else
+              {
+                vNew[0] = (v[0] + glyph.VMag) / 2.0;
+                vNew[1] = v[1] / 2.0;
+                vNew[2] = v[2] / 2.0;
+                trans->RotateWXYZ(180.0, vNew[0], vNew[1], vNew[2]);
+              }
+            }
           }
-          return false;
         }
 
-        v[0] = 0;
-        v[1] = 0;
-        v[2] = 0;
-        array3D->GetTuple(inPtId, v);
-        vMag = vtkMath::Norm(v);
-        if (this->ScaleMode == VTK_SCALE_BY_VECTORCOMPONENTS)
+        if (haveTCoords)
         {
-          scalex = v[0];
-          scaley = v[1];
-          scalez = v[2];
+          for (i = 0; i < numSourcePts; i++)
+          {
+            sourceTCoords->GetTuple(i, tc);
+            newTCoords->SetTuple(i + ptIncr, tc);
+          }
         }
-        else if (this->ScaleMode == VTK_SCALE_BY_VECTOR)
+
+        // determine scale factor from scalars if appropriate
+        // Copy scalar value
+        if (inSScalars && (this->ColorMode == VTK_COLOR_BY_SCALE))
         {
-          scalex = scaley = scalez = vMag;
+          for (i = 0; i < numSourcePts; i++)
+          {
+            newScalars->SetTuple(i + ptIncr, &scalex); // = scaley = scalez
+          }
+        }
+        else if (inCScalars && (this->ColorMode == VTK_COLOR_BY_SCALAR))
+        {
+          for (i = 0; i < numSourcePts; i++)
+          {
+            newScalars->SetTuple(ptIncr + i, inPtId, inCScalars);
+          }
+        }
+        if (haveVectors && this->ColorMode == VTK_COLOR_BY_VECTOR)
+        {
+          for (i = 0; i < numSourcePts; i++)
+          {
+            newScalars->SetTuple(i + ptIncr, &glyph.VMag);
+          }
         }
-      }
-    }
-
-    // Clamp data scale if enabled
-    if (this->Clamping)
-    {
-      scalex = (scalex < this->Range[0] ? this->Range[0]
-                                        : (scalex > this->Range[1] ? this->Range[1] : scalex));
-      scalex = (scalex - this->Range[0]) / den;
-      scaley = (scaley < this->Range[0] ? this->Range[0]
-                                        : (scaley > this->Range[1] ? this->Range[1] : scaley));
-      scaley = (scaley - this->Range[0]) / den;
-      scalez = (scalez < this->Range[0] ? this->Range[0]
-                                        : (scalez > this->Range[1] ? this->Range[1] : scalez));
-      scalez = (scalez - this->Range[0]) / den;
-    }
-
-    // Compute index into table of glyphs
-    if (this->IndexMode != VTK_INDEXING_OFF)
-    {
-      if (this->IndexMode == VTK_INDEXING_BY_SCALAR)
-      {
-        value = s;
-      }
-      else
-      {
-        value = vMag;
-      }
-
-      int index = static_cast<int>((value - this->Range[0]) * numberOfSources / den);
-      index = (index < 0 ? 0 : (index >= numberOfSources ? (numberOfSources - 1) : index));
-
-      source = this->GetSource(index, sourceVector);
-      if (source != nullptr)
-      {
-        sourcePts = source->GetPoints();
-        sourceNormals = source->GetPointData()->GetNormals();
-        numSourcePts = sourcePts->GetNumberOfPoints();
-        numSourceCells = source->GetNumberOfCells();
-      }
-    }
-
-    // Make sure we're not indexing into empty glyph
-    if (source == nullptr)
-    {
-      continue;
-    }
-
-    // Check ghost points.
-    // If we are processing a piece, we do not want to duplicate
-    // glyphs on the borders.
-    if (inGhostLevels && inGhostLevels[inPtId] & vtkDataSetAttributes::DUPLICATEPOINT)
-    {
-      continue;
-    }
-
-    if (inputUG && !inputUG->IsPointVisible(inPtId))
-    {
-      // input is a vtkUniformGrid and the current point is blanked. Don't glyph
-      // it.
-      continue;
-    }
-
-    if (!this->IsPointVisible(input, inPtId))
-    {
-      continue;
-    }
 
-    // Now begin copying/transforming glyph
-    trans->Identity();
+        // scale data if appropriate
+        if (this->Scaling)
+        {
+          if (this->ScaleMode == VTK_DATA_SCALING_OFF)
+          {
+            scalex = scaley = scalez = this->ScaleFactor;
+          }
+          else
+          {
+            scalex *= this->ScaleFactor;
+            scaley *= this->ScaleFactor;
+            scalez *= this->ScaleFactor;
+          }
 
-    // Copy all topology (transformation independent)
-    for (cellId = 0; cellId < numSourceCells; cellId++)
-    {
-      source->GetCellPoints(cellId, pointIdList);
-      cellPts = pointIdList;
-      npts = cellPts->GetNumberOfIds();
-      for (pts->Reset(), i = 0; i < npts; i++)
-      {
-        pts->InsertId(i, cellPts->GetId(i) + ptIncr);
-      }
-      output->InsertNextCell(source->GetCellType(cellId), pts);
-    }
+          if (scalex == 0.0)
+          {
+            scalex = 1.0e-10;
+          }
+          if (scaley == 0.0)
+          {
+            scaley = 1.0e-10;
+          }
+          if (scalez == 0.0)
+          {
+            scalez = 1.0e-10;
+          }
+          trans->Scale(scalex, scaley, scalez);
+        }
 
-    // translate Source to Input point
-    input->GetPoint(inPtId, x);
-    trans->Translate(x[0], x[1], x[2]);
+        // multiply points and normals by resulting matrix
+        const double* matrix = trans->GetMatrix()->GetData();
+        if (newPts->GetDataType() == VTK_DOUBLE)
+        {
+          TransformGlyphPoints(matrix, glyphSource.Points.data(), numSourcePts,
+            static_cast<double*>(newPts->GetData()->GetVoidPointer(3 * ptIncr)));
+        }
+        else
+        {
+          TransformGlyphPoints(matrix, glyphSource.Points.data(), numSourcePts,
+            static_cast<float*>(newPts->GetData()->GetVoidPointer(3 * ptIncr)));
+        }
 
-    if (haveVectors)
-    {
-      // Copy Input vector
-      for (i = 0; i < numSourcePts; i++)
-      {
-        newVectors->InsertTuple(i + ptIncr, v);
-      }
-      if (this->Orient)
-      {
-        if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+        if (haveNormals)
         {
-          // v = glyphNormal_World (glyph normal direction in World coordinate system)
-          v[0] = this->FollowedCameraPosition[0] - x[0];
-          v[1] = this->FollowedCameraPosition[1] - x[1];
-          v[2] = this->FollowedCameraPosition[2] - x[2];
-          vtkMath::Normalize(v);
-          double glyphRight_World[3]; // glyph right direction in World coordinate system
-          vtkMath::Cross(this->FollowedCameraViewUp, v, glyphRight_World);
-          // glyph up direction in World coordinate system
-          // (approximately the same as this->FollowedCameraViewUp, but slightly adjusted to be
-          // orthogonal to the normal direction)
-          double glyphUp_World[3];
-          vtkMath::Cross(v, glyphRight_World, glyphUp_World);
-          double glyphToWorld[16] = { glyphRight_World[0], glyphUp_World[0], v[0], 0.0,
-            glyphRight_World[1], glyphUp_World[1], v[1], 0.0, glyphRight_World[2], glyphUp_World[2],
-            v[2], 0.0, 0.0, 0.0, 0.0, 1.0 };
-          trans->Concatenate(glyphToWorld);
+          TransformGlyphNormals(
+            matrix, glyphSource.Normals, numSourcePts, newNormals->GetPointer(3 * ptIncr));
         }
-        else if (vMag > 0.0)
+
+        // Copy point data from source (if possible)
+        if (copyInParallel)
         {
-          // if there is no y or z component
-          if (v[1] == 0.0 && v[2] == 0.0)
+          for (i = 0; i < numSourcePts; ++i)
+          {
+            pointArrays.Copy(inPtId, ptIncr + i);
+          }
+          if (this->FillCellData)
           {
-            if (v[0] < 0) // just flip x if we need to
+            for (int type = 0; type < 4; ++type)
             {
-              trans->RotateWXYZ(180.0, 0, 1, 0);
+              const vtkIdType firstCellId = cellTypeOffsets[type] + offsets.Cells[type];
+              for (i = 0; i < glyphSource.GetNumberOfCells(type); ++i)
+              {
+                cellArrays.Copy(inPtId, firstCellId + i);
+              }
             }
           }
-          else
+        }
+
+        // If point ids are to be generated, do it here
+        if (this->GeneratePointIds)
+        {
+          for (i = 0; i < numSourcePts; i++)
           {
-            vNew[0] = (v[0] + vMag) / 2.0;
-            vNew[1] = v[1] / 2.0;
-            vNew[2] = v[2] / 2.0;
-            trans->RotateWXYZ(180.0, vNew[0], vNew[1], vNew[2]);
+            pointIds->SetValue(ptIncr + i, inPtId);
           }
         }
-      }
-    }
-
-    if (haveTCoords)
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        sourceTCoords->GetTuple(i, tc);
-        newTCoords->InsertTuple(i + ptIncr, tc);
-      }
-    }
 
-    // determine scale factor from scalars if appropriate
-    // Copy scalar value
-    if (inSScalars && (this->ColorMode == VTK_COLOR_BY_SCALE))
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        newScalars->InsertTuple(i + ptIncr, &scalex); // = scaley = scalez
-      }
-    }
-    else if (inCScalars && (this->ColorMode == VTK_COLOR_BY_SCALAR))
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        outputPD->CopyTuple(inCScalars, newScalars, inPtId, ptIncr + i);
+        offsets.Add(glyphSource);
       }
-    }
-    if (haveVectors && this->ColorMode == VTK_COLOR_BY_VECTOR)
-    {
-      for (i = 0; i < numSourcePts; i++)
+      if (this->GetAbortExecute())
       {
-        newScalars->InsertTuple(i + ptIncr, &vMag);
+        aborted = true;
       }
     }
+  });
 
-    // scale data if appropriate
-    if (this->Scaling)
+  // Update ourselves and release memory
+  //
+  if (aborted)
+  {
+    // The glyphs of the remaining blocks were not generated.
+    newPts->Delete();
+    if (newScalars)
     {
-      if (this->ScaleMode == VTK_DATA_SCALING_OFF)
-      {
-        scalex = scaley = scalez = this->ScaleFactor;
-      }
-      else
-      {
-        scalex *= this->ScaleFactor;
-        scaley *= this->ScaleFactor;
-        scalez *= this->ScaleFactor;
-      }
-
-      if (scalex == 0.0)
-      {
-        scalex = 1.0e-10;
-      }
-      if (scaley == 0.0)
-      {
-        scaley = 1.0e-10;
-      }
-      if (scalez == 0.0)
-      {
-        scalez = 1.0e-10;
-      }
-      trans->Scale(scalex, scaley, scalez);
+      newScalars->Delete();
     }
-
-    // multiply points and normals by resulting matrix
-    if (this->SourceTransform)
+    if (newVectors)
     {
-      transformedSourcePts->Reset();
-      this->SourceTransform->TransformPoints(sourcePts, transformedSourcePts);
-      trans->TransformPoints(transformedSourcePts, newPts);
+      newVectors->Delete();
     }
-    else
+    if (newNormals)
     {
-      trans->TransformPoints(sourcePts, newPts);
+      newNormals->Delete();
     }
-
-    if (haveNormals)
+    if (newTCoords)
     {
-      trans->TransformNormals(sourceNormals, newNormals);
+      newTCoords->Delete();
     }
+    output->Initialize();
+    return true;
+  }
 
-    // Copy point data from source (if possible)
-    if (pd)
+  // Copy the attributes that could not be copied by the threads.
+  if (pd && !copyInParallel)
+  {
+    GlyphOffsets offsets;
+    for (vtkIdType inPtId = 0; inPtId < numPts; ++inPtId)
     {
-      for (i = 0; i < numSourcePts; ++i)
+      if (pointSources[inPtId] < 0)
+      {
+        continue;
+      }
+      const GlyphSource& glyphSource = glyphSources[pointSources[inPtId]];
+      for (vtkIdType i = 0; i < glyphSource.NumberOfPoints; ++i)
       {
-        srcPointIdList->SetId(i, inPtId);
-        dstPointIdList->SetId(i, ptIncr + i);
+        outputPD->CopyData(pd, inPtId, offsets.Points + i);
       }
-      outputPD->CopyData(pd, srcPointIdList, dstPointIdList);
       if (this->FillCellData)
       {
-        for (i = 0; i < numSourceCells; ++i)
+        for (int type = 0; type < 4; ++type)
         {
-          srcCellIdList->SetId(i, inPtId);
-          dstCellIdList->SetId(i, cellIncr + i);
+          const vtkIdType firstCellId = cellTypeOffsets[type] + offsets.Cells[type];
+          for (vtkIdType i = 0; i < glyphSource.GetNumberOfCells(type); ++i)
+          {
+            outputCD->CopyData(pd, inPtId, firstCellId + i);
+          }
         }
-        outputCD->CopyData(pd, srcCellIdList, dstCellIdList);
-      }
-    }
-
-    // If point ids are to be generated, do it here
-    if (this->GeneratePointIds)
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        pointIds->InsertNextValue(inPtId);
       }
+      offsets.Add(glyphSource);
     }
+  }
+  this->UpdateProgress(1.0);
 
-    ptIncr += numSourcePts;
-    cellIncr += numSourceCells;
+  vtkNew<vtkCellArray> outCells[4];
+  for (int type = 0; type < 4; ++type)
+  {
+    outCells[type]->SetData(outOffsets[type], outConnectivity[type]);
   }
+  output->SetVerts(outCells[0]);
+  output->SetLines(outCells[1]);
+  output->SetPolys(outCells[2]);
+  output->SetStrips(outCells[3]);
 
-  // Update ourselves and release memory
-  //
   output->SetPoints(newPts);
   newPts->Delete();
 
@@ -749,12 +998,9 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   }
 
   output->Squeeze();
-  trans->Delete();
-  pts->Delete();
 
   return true;
 }
-
 //----------------------------------------------------------------------------
 // Specify a source object at a specified table location.
 void vtkGlyph3D::SetSourceConnection(int id, vtkAlgorithmOutput* algOutput)
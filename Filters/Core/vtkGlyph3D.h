@@ -34,6 +34,12 @@
  * you'll have to decide whether to index into it with scalar value or with
  * vector magnitude.
  *
+ * The glyphs are generated in parallel with vtkSMPTools, in two passes. The
+ * first one counts the points and cells generated for each input point, and
+ * the counts are scanned into the offsets of the glyphs in the output. The
+ * second one transforms and fills the glyphs at these offsets. The output
+ * does not depend on the number of threads.
+ *
  * @warning
  * The scaling of the glyphs is controlled by the ScaleFactor ivar multiplied
  * by the scalar value at each point (if VTK_SCALE_BY_SCALAR is set), or
@@ -17,17 +17,20 @@
 #include "vtkCell.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkConnectivityFilterInternal.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
-#include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 
-#include <algorithm> // for fill_n
+#include <numeric>
+#include <vector>
 
 vtkStandardNewMacro(vtkPolyDataConnectivityFilter);
 
@@ -45,29 +48,42 @@ vtkPolyDataConnectivityFilter::vtkPolyDataConnectivityFilter()
 
   this->ClosestPoint[0] = this->ClosestPoint[1] = this->ClosestPoint[2] = 0.0;
 
-  this->CellScalars = vtkFloatArray::New();
-  this->CellScalars->Allocate(8);
-
-  this->NeighborCellPointIds = vtkIdList::New();
-  this->NeighborCellPointIds->Allocate(8);
-
   this->Seeds = vtkIdList::New();
   this->SpecifiedRegionIds = vtkIdList::New();
 
   this->MarkVisitedPointIds = 0;
   this->VisitedPointIds = vtkIdList::New();
 
+#if !defined(VTK_LEGACY_REMOVE)
+  this->CellScalars = vtkFloatArray::New();
+  this->CellScalars->Allocate(8);
+  this->NeighborCellPointIds = vtkIdList::New();
+  this->NeighborCellPointIds->Allocate(8);
+  this->Visited = nullptr;
+  this->PointMap = nullptr;
+  this->NewScalars = nullptr;
+  this->RegionNumber = 0;
+  this->PointNumber = 0;
+  this->NumCellsInRegion = 0;
+  this->InScalars = nullptr;
+  this->Mesh = nullptr;
+  this->PointIds = nullptr;
+  this->CellIds = nullptr;
+#endif
+
   this->OutputPointsPrecision = DEFAULT_PRECISION;
 }
 
 vtkPolyDataConnectivityFilter::~vtkPolyDataConnectivityFilter()
 {
   this->RegionSizes->Delete();
-  this->CellScalars->Delete();
-  this->NeighborCellPointIds->Delete();
   this->Seeds->Delete();
   this->SpecifiedRegionIds->Delete();
   this->VisitedPointIds->Delete();
+#if !defined(VTK_LEGACY_REMOVE)
+  this->CellScalars->Delete();
+  this->NeighborCellPointIds->Delete();
+#endif
 }
 
 int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
@@ -84,12 +100,9 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
   vtkIdType cellId, newCellId, i, pt;
   vtkPoints* inPts;
   vtkPoints* newPts;
-  vtkIdType *cells, id, n;
+  vtkIdType id, n;
   vtkIdType npts;
   const vtkIdType* pts;
-  vtkIdType ncells;
-  vtkIdType maxCellsInRegion;
-  vtkIdType largestRegionId = 0;
   vtkPointData *pd = input->GetPointData(), *outputPD = output->GetPointData();
   vtkCellData *cd = input->GetCellData(), *outputCD = output->GetCellData();
 
@@ -116,40 +129,19 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
 
   // See whether to consider scalar connectivity
   //
-  this->InScalars = input->GetPointData()->GetScalars();
-  if (!this->ScalarConnectivity)
-  {
-    this->InScalars = nullptr;
-  }
-  else
+  vtkDataArray* inScalars = nullptr;
+  if (this->ScalarConnectivity)
   {
+    inScalars = input->GetPointData()->GetScalars();
     if (this->ScalarRange[1] < this->ScalarRange[0])
     {
       this->ScalarRange[1] = this->ScalarRange[0];
     }
   }
 
-  // Build cell structure
-  //
-  this->Mesh = vtkPolyData::New();
-  this->Mesh->CopyStructure(input);
-  this->Mesh->BuildLinks();
-  this->UpdateProgress(0.10);
-
   // Remove all visited point ids
   this->VisitedPointIds->Reset();
 
-  // Initialize.  Keep track of points and cells visited.
-  //
-  this->RegionSizes->Reset();
-  this->Visited = new vtkIdType[numCells];
-  std::fill_n(this->Visited, numCells, -1);
-  this->PointMap = new vtkIdType[numPts];
-  std::fill_n(this->PointMap, numPts, -1);
-
-  this->NewScalars = vtkIdTypeArray::New();
-  this->NewScalars->SetName("RegionId");
-  this->NewScalars->SetNumberOfTuples(numPts);
   newPts = vtkPoints::New();
 
   // Set the desired precision for the points in the output.
@@ -166,112 +158,102 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
     newPts->SetDataType(VTK_DOUBLE);
   }
 
-  newPts->Allocate(numPts);
-
-  // Traverse all cells marking those visited.  Each new search
-  // starts a new connected region. Connected region grows
-  // using a connected wave propagation.
+  // Label the cells with their region. Each cell that is not yet in a region
+  // starts a new one, in increasing cell id order, which grows across shared
+  // points. The regions are labeled in parallel with a union-find over the
+  // points rather than grown one after the other.
   //
-  this->Wave.reserve(numPts);
-  this->Wave2.reserve(numPts);
-
-  this->PointNumber = 0;
-  this->RegionNumber = 0;
-  maxCellsInRegion = 0;
-
-  this->CellIds = vtkIdList::New();
-  this->CellIds->Allocate(8, VTK_CELL_SIZE);
-  this->PointIds = vtkIdList::New();
-  this->PointIds->Allocate(8, VTK_CELL_SIZE);
-
+  ConnectedRegions regions(input, inScalars, this->ScalarRange,
+    this->FullScalarConnectivity ? ConnectedRegions::ALL_SCALARS_IN_RANGE
+                                 : ConnectedRegions::ANY_SCALAR_IN_RANGE);
   if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
   { // visit all cells marking with region number
-    for (cellId = 0; cellId < numCells; cellId++)
-    {
-      if (cellId && !(cellId % 5000))
-      {
-        this->UpdateProgress(0.1 + 0.8 * cellId / numCells);
-      }
-
-      if (this->Visited[cellId] < 0)
-      {
-        this->NumCellsInRegion = 0;
-        this->Wave.push_back(cellId);
-        this->TraverseAndMark();
-
-        if (this->NumCellsInRegion > maxCellsInRegion)
-        {
-          maxCellsInRegion = this->NumCellsInRegion;
-          largestRegionId = this->RegionNumber;
-        }
-
-        this->RegionSizes->InsertValue(this->RegionNumber++, this->NumCellsInRegion);
-        this->Wave.clear();
-        this->Wave2.clear();
-      }
-    }
+    regions.LabelAllRegions();
   }
   else // regions have been seeded, everything considered in same region
   {
-    this->NumCellsInRegion = 0;
-
-    if (this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS)
+    if (this->ExtractionMode == VTK_EXTRACT_CELL_SEEDED_REGIONS)
     {
+      std::vector<unsigned char> seedCells(numCells, 0);
       for (i = 0; i < this->Seeds->GetNumberOfIds(); i++)
       {
-        pt = this->Seeds->GetId(i);
-        if (pt >= 0)
+        cellId = this->Seeds->GetId(i);
+        if (cellId >= 0 && cellId < numCells)
         {
-          this->Mesh->GetPointCells(pt, ncells, cells);
-          for (unsigned short j = 0; j < ncells; ++j)
-          {
-            this->Wave.push_back(cells[j]);
-          }
+          seedCells[cellId] = 1;
         }
       }
+      regions.LabelSeededRegion(seedCells);
     }
-    else if (this->ExtractionMode == VTK_EXTRACT_CELL_SEEDED_REGIONS)
+    else
     {
-      for (i = 0; i < this->Seeds->GetNumberOfIds(); i++)
+      std::vector<unsigned char> seedPoints(numPts, 0);
+      if (this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS)
       {
-        cellId = this->Seeds->GetId(i);
-        if (cellId >= 0)
+        for (i = 0; i < this->Seeds->GetNumberOfIds(); i++)
         {
-          this->Wave.push_back(cellId);
+          pt = this->Seeds->GetId(i);
+          if (pt >= 0 && pt < numPts)
+          {
+            seedPoints[pt] = 1;
+          }
         }
       }
+      else // find the closest point
+      {
+        seedPoints[FindClosestPoint(input, this->ClosestPoint)] = 1;
+      }
+      regions.LabelSeededRegionFromPoints(seedPoints);
     }
-    else if (this->ExtractionMode == VTK_EXTRACT_CLOSEST_POINT_REGION)
-    { // loop over points, find closest one
-      double minDist2, dist2, x[3];
-      int minId = 0;
-      for (minDist2 = VTK_DOUBLE_MAX, i = 0; i < numPts; i++)
+  } // else extracted seeded cells
+  this->UpdateProgress(0.5);
+
+  const std::vector<vtkIdType>& cellRegions = regions.CellRegions;
+  const vtkIdType numRegions = static_cast<vtkIdType>(regions.RegionSizes.size());
+  this->RegionSizes->SetNumberOfValues(numRegions);
+  vtkIdType largestRegionId = 0;
+  for (vtkIdType regionId = 0; regionId < numRegions; ++regionId)
+  {
+    this->RegionSizes->SetValue(regionId, regions.RegionSizes[regionId]);
+    if (regions.RegionSizes[regionId] > regions.RegionSizes[largestRegionId])
+    {
+      largestRegionId = regionId;
+    }
+  }
+  vtkDebugMacro(<< "Extracted " << numRegions << " region(s)");
+
+  // The points of the cells in a region are kept, in increasing id order.
+  const vtkIdType zero = 0;
+  std::vector<vtkIdType> pointMap(numPts + 1);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      pointMap[ptId] = regions.PointRegions[ptId] >= 0 ? 1 : 0;
+    }
+  });
+  const vtkIdType numNewPts =
+    vtkSMPTools::ExclusiveScan(pointMap.begin(), pointMap.end() - 1, pointMap.begin(), zero);
+  pointMap[numPts] = numNewPts;
+
+  vtkIdTypeArray* newScalars = vtkIdTypeArray::New();
+  newScalars->SetName("RegionId");
+  newScalars->SetNumberOfTuples(numNewPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      if (regions.PointRegions[ptId] < 0)
       {
-        inPts->GetPoint(i, x);
-        dist2 = vtkMath::Distance2BetweenPoints(x, this->ClosestPoint);
-        if (dist2 < minDist2)
-        {
-          minId = i;
-          minDist2 = dist2;
-        }
+        pointMap[ptId] = -1;
       }
-      this->Mesh->GetPointCells(minId, ncells, cells);
-      for (unsigned short j = 0; j < ncells; ++j)
+      else
       {
-        this->Wave.push_back(cells[j]);
+        newScalars->SetValue(pointMap[ptId], regions.PointRegions[ptId]);
       }
     }
-    this->UpdateProgress(0.5);
-
-    // mark all seeded regions
-    this->TraverseAndMark();
-    this->RegionSizes->InsertValue(this->RegionNumber, this->NumCellsInRegion);
-    this->UpdateProgress(0.9);
-  } // else extracted seeded cells
-
-  vtkDebugMacro(<< "Extracted " << this->RegionNumber << " region(s)");
+  });
+  this->UpdateProgress(0.9);
 
   // Now that points and cells have been marked, traverse these lists pulling
   // everything that has been visited.
@@ -280,22 +262,23 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
   outputPD->CopyAllocate(pd);
   outputCD->CopyAllocate(cd);
 
+  newPts->SetNumberOfPoints(numNewPts);
   for (i = 0; i < numPts; i++)
   {
-    if (this->PointMap[i] > -1)
+    if (pointMap[i] > -1)
     {
-      newPts->InsertPoint(this->PointMap[i], inPts->GetPoint(i));
-      outputPD->CopyData(pd, i, this->PointMap[i]);
+      newPts->SetPoint(pointMap[i], inPts->GetPoint(i));
+      outputPD->CopyData(pd, i, pointMap[i]);
     }
   }
 
   // if coloring regions; send down new scalar data
   if (this->ColorRegions)
   {
-    int idx = outputPD->AddArray(this->NewScalars);
+    int idx = outputPD->AddArray(newScalars);
     outputPD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
   }
-  this->NewScalars->Delete();
+  newScalars->Delete();
 
   output->SetPoints(newPts);
   newPts->Delete();
@@ -331,119 +314,76 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
     newStrips->Delete();
   }
 
-  if (this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS ||
-    this->ExtractionMode == VTK_EXTRACT_CELL_SEEDED_REGIONS ||
-    this->ExtractionMode == VTK_EXTRACT_CLOSEST_POINT_REGION ||
-    this->ExtractionMode == VTK_EXTRACT_ALL_REGIONS)
-  { // extract any cell that's been visited
-    for (cellId = 0; cellId < numCells; cellId++)
+  // The visited point ids are listed in the order the output cells use them.
+  std::vector<unsigned char> visitedPoints(this->MarkVisitedPointIds ? numPts : 0, 0);
+  vtkNew<vtkIdList> pointIds;
+  for (cellId = 0; cellId < numCells; cellId++)
+  {
+    const vtkIdType regionId = cellRegions[cellId];
+    bool extract;
+    if (this->ExtractionMode == VTK_EXTRACT_SPECIFIED_REGIONS)
     {
-      if (this->Visited[cellId] >= 0)
-      {
-        this->Mesh->GetCellPoints(cellId, npts, pts);
-        this->PointIds->Reset();
-        for (i = 0; i < npts; i++)
-        {
-          id = this->PointMap[pts[i]];
-          this->PointIds->InsertId(i, id);
-
-          // If we asked to mark the visited point ids, mark them.
-          if (this->MarkVisitedPointIds)
-          {
-            this->VisitedPointIds->InsertUniqueId(pts[i]);
-          }
-        }
-        newCellId = output->InsertNextCell(this->Mesh->GetCellType(cellId), this->PointIds);
-        outputCD->CopyData(cd, cellId, newCellId);
-      }
+      extract = regionId >= 0 && this->SpecifiedRegionIds->IsId(regionId) >= 0;
     }
-  }
-  else if (this->ExtractionMode == VTK_EXTRACT_SPECIFIED_REGIONS)
-  {
-    for (cellId = 0; cellId < numCells; cellId++)
+    else if (this->ExtractionMode == VTK_EXTRACT_LARGEST_REGION)
     {
-      int inReg, regionId;
-      if ((regionId = this->Visited[cellId]) >= 0)
-      {
-        for (inReg = 0, i = 0; i < this->SpecifiedRegionIds->GetNumberOfIds(); i++)
-        {
-          if (regionId == this->SpecifiedRegionIds->GetId(i))
-          {
-            inReg = 1;
-            break;
-          }
-        }
-        if (inReg)
-        {
-          this->Mesh->GetCellPoints(cellId, npts, pts);
-          this->PointIds->Reset();
-          for (i = 0; i < npts; i++)
-          {
-            id = this->PointMap[pts[i]];
-            this->PointIds->InsertId(i, id);
-
-            // If we asked to mark the visited point ids, mark them.
-            if (this->MarkVisitedPointIds)
-            {
-              this->VisitedPointIds->InsertUniqueId(pts[i]);
-            }
-          }
-          newCellId = output->InsertNextCell(this->Mesh->GetCellType(cellId), this->PointIds);
-          outputCD->CopyData(cd, cellId, newCellId);
-        }
-      }
+      extract = regionId == largestRegionId;
     }
-  }
-  else // extract largest region
-  {
-    for (cellId = 0; cellId < numCells; cellId++)
+    else // extract any cell that's been visited
     {
-      if (this->Visited[cellId] == largestRegionId)
-      {
-        this->Mesh->GetCellPoints(cellId, npts, pts);
-        this->PointIds->Reset();
-        for (i = 0; i < npts; i++)
-        {
-          id = this->PointMap[pts[i]];
-          this->PointIds->InsertId(i, id);
+      extract = regionId >= 0;
+    }
+    if (!extract)
+    {
+      continue;
+    }
 
-          // If we asked to mark the visited point ids, mark them.
-          if (this->MarkVisitedPointIds)
-          {
-            this->VisitedPointIds->InsertUniqueId(pts[i]);
-          }
-        }
-        newCellId = output->InsertNextCell(this->Mesh->GetCellType(cellId), this->PointIds);
-        outputCD->CopyData(cd, cellId, newCellId);
+    const unsigned char cellType = input->GetCellPoints(cellId, npts, pts);
+    pointIds->SetNumberOfIds(npts);
+    for (i = 0; i < npts; i++)
+    {
+      id = pointMap[pts[i]];
+      pointIds->SetId(i, id);
+
+      // If we asked to mark the visited point ids, mark them.
+      if (this->MarkVisitedPointIds && !visitedPoints[pts[i]])
+      {
+        visitedPoints[pts[i]] = 1;
+        this->VisitedPointIds->InsertNextId(pts[i]);
       }
     }
+    newCellId = output->InsertNextCell(cellType, pointIds);
+    outputCD->CopyData(cd, cellId, newCellId);
   }
 
-  delete[] this->Visited;
-  delete[] this->PointMap;
-  this->Mesh->Delete();
   output->Squeeze();
-  this->CellIds->Delete();
-  this->PointIds->Delete();
 
-  int num = this->GetNumberOfExtractedRegions();
-  vtkIdType count = 0;
-
-  for (int ii = 0; ii < num; ii++)
-  {
-    count += this->RegionSizes->GetValue(ii);
-  }
-  vtkDebugMacro(<< "Total # of cells accounted for: " << count);
+  vtkDebugMacro(<< "Total # of cells accounted for: "
+                << std::accumulate(regions.RegionSizes.begin(), regions.RegionSizes.end(),
+                     static_cast<vtkIdType>(0)));
   vtkDebugMacro(<< "Extracted " << output->GetNumberOfCells() << " cells");
 
   return 1;
 }
 
+#if !defined(VTK_LEGACY_REMOVE)
+// This is here to shut off warnings about deprecated functions
+// calling deprecated functions.
+#if defined(__GNUC__) && !defined(__INTEL_COMPILER)
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+
+#ifdef _MSC_VER
+#pragma warning(disable : 4996)
+#endif
+
 // Mark current cell as visited and assign region number.  Note:
 // traversal occurs across shared vertices.
 //
 void vtkPolyDataConnectivityFilter::TraverseAndMark()
 {
+  VTK_LEGACY_BODY(vtkPolyDataConnectivityFilter::TraverseAndMark, "VTK 9.0");
+
   vtkIdType cellId, ptId, numIds, i;
   int j, k;
   vtkIdType* cells;
@@ -505,6 +445,8 @@ void vtkPolyDataConnectivityFilter::TraverseAndMark()
 // --------------------------------------------------------------------------
 int vtkPolyDataConnectivityFilter::IsScalarConnected(vtkIdType cellId)
 {
+  VTK_LEGACY_BODY(vtkPolyDataConnectivityFilter::IsScalarConnected, "VTK 9.0");
+
   double s;
 
   this->Mesh->GetCellPoints(cellId, this->NeighborCellPointIds);
@@ -552,6 +494,7 @@ int vtkPolyDataConnectivityFilter::IsScalarConnected(vtkIdType cellId)
 
   return 0;
 }
+#endif
 
 // --------------------------------------------------------------------------
 // Obtain the number of connected regions.
@@ -29,6 +29,11 @@
  * faster and is easier to construct visualization networks that process
  * polygonal data.
  *
+ * Like vtkConnectivityFilter, this filter labels the regions in parallel with
+ * vtkSMPTools, without building the point links of the input. The regions
+ * are numbered in increasing order of their smallest cell id whatever the
+ * number of threads, and the output points keep their input order.
+ *
  * The behavior of vtkPolyDataConnectivityFilter can be modified by turning
  * on the boolean ivar ScalarConnectivity. If this flag is on, the
  * connectivity algorithm is modified so that cells are considered connected
@@ -51,8 +56,11 @@
 #define vtkPolyDataConnectivityFilter_h
 
 #include "vtkFiltersCoreModule.h" // For export macro
+#include "vtkLegacy.h"            // For VTK_LEGACY
 #include "vtkPolyDataAlgorithm.h"
 
+#include <vector> // For Wave
+
 #define VTK_EXTRACT_POINT_SEEDED_REGIONS 1
 #define VTK_EXTRACT_CELL_SEEDED_REGIONS 2
 #define VTK_EXTRACT_SPECIFIED_REGIONS 3
@@ -245,14 +253,18 @@ protected:
   vtkTypeBool ScalarConnectivity;
   vtkTypeBool FullScalarConnectivity;
 
-  // Does this cell qualify as being scalar connected ?
-  int IsScalarConnected(vtkIdType cellId);
-
   double ScalarRange[2];
 
-  void TraverseAndMark();
+  /**
+   * @deprecated The regions are no longer grown with a wave propagation,
+   * these methods and the members they use are not called by the filter
+   * anymore and will be removed.
+   */
+  VTK_LEGACY(int IsScalarConnected(vtkIdType cellId));
+  VTK_LEGACY(void TraverseAndMark());
 
-  // used to support algorithm execution
+#if !defined(VTK_LEGACY_REMOVE)
+  // used to support the deprecated wave propagation
   vtkDataArray* CellScalars;
   vtkIdList* NeighborCellPointIds;
   vtkIdType* Visited;
@@ -267,6 +279,8 @@ protected:
   std::vector<vtkIdType> Wave2;
   vtkIdList* PointIds;
   vtkIdList* CellIds;
+#endif
+
   vtkIdList* VisitedPointIds;
 
   vtkTypeBool MarkVisitedPointIds;
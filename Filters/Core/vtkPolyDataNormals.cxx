@@ -15,6 +15,7 @@
 #include "vtkPolyDataNormals.h"
 
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
@@ -27,12 +28,267 @@
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLinksTemplate.h"
 #include "vtkTriangleStrip.h"
 
-#include "vtkNew.h"
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <vector>
 
 vtkStandardNewMacro(vtkPolyDataNormals);
 
+namespace
+{ // anonymous
+
+using NormalsLinks = vtkStaticCellLinksTemplate<vtkIdType>;
+
+//----------------------------------------------------------------------------
+// Build the links from points to polygons in parallel. The cells using each
+// point are then sorted by increasing id, the order in which vtkCellLinks
+// lists them, so that the traversals below do not depend on the number of
+// threads.
+NormalsLinks* BuildSortedLinks(vtkIdType numPts, vtkCellArray* polys)
+{
+  NormalsLinks* links = new NormalsLinks;
+  links->ThreadedBuildLinks(numPts, polys->GetNumberOfCells(), polys);
+  vtkSMPTools::For(0, numPts, [links](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      vtkIdType* cells = links->GetCells(ptId);
+      std::sort(cells, cells + links->GetNcells(ptId));
+    }
+  });
+  return links;
+}
+
+//----------------------------------------------------------------------------
+// The cells, other than cellId, using the edge (p1,p2). Same as
+// vtkPolyData::GetCellEdgeNeighbors() but on static links, which makes it
+// safe to call concurrently.
+void GetCellEdgeNeighbors(
+  NormalsLinks* links, vtkIdType cellId, vtkIdType p1, vtkIdType p2, vtkIdList* cellIds)
+{
+  cellIds->Reset();
+
+  const vtkIdType* cells1 = links->GetCells(p1);
+  const vtkIdType* cells1End = cells1 + links->GetNcells(p1);
+  const vtkIdType* cells2 = links->GetCells(p2);
+  const vtkIdType* cells2End = cells2 + links->GetNcells(p2);
+
+  for (; cells1 != cells1End; ++cells1)
+  {
+    if (*cells1 != cellId && std::find(cells2, cells2End, *cells1) != cells2End)
+    {
+      cellIds->InsertNextId(*cells1);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+// Mark the polygons around each point with the region they belong to: the
+// polygons connected through edges using the point that are not feature
+// edges. Each point is processed independently, so that points are marked
+// in parallel. The region of the i-th cell using a point is stored at the
+// same position as this cell in the links, and the number of new points
+// needed to split the point (the number of regions minus one) is counted.
+struct MarkRegions
+{
+  NormalsLinks* Links;
+  vtkCellArray* Polys;
+  vtkFloatArray* PolyNormals;
+  double CosAngle;
+  int* Regions;
+  vtkIdType* NumSplits;
+
+  vtkSMPThreadLocalObject<vtkIdList> CellIds;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> Iterators;
+
+  MarkRegions(NormalsLinks* links, vtkCellArray* polys, vtkFloatArray* polyNormals,
+    double cosAngle, int* regions, vtkIdType* numSplits)
+    : Links(links)
+    , Polys(polys)
+    , PolyNormals(polyNormals)
+    , CosAngle(cosAngle)
+    , Regions(regions)
+    , NumSplits(numSplits)
+  {
+  }
+
+  void Initialize() { this->Iterators.Local() = vtk::TakeSmartPointer(this->Polys->NewIterator()); }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    vtkIdList* cellIds = this->CellIds.Local();
+    vtkCellArrayIterator* iter = this->Iterators.Local();
+    const vtkIdType* allCells = this->Links->GetCells(0);
+
+    for (; ptId < endPtId; ++ptId)
+    {
+      const vtkIdType ncells = this->Links->GetNcells(ptId);
+      const vtkIdType* cells = this->Links->GetCells(ptId);
+      int* regions = this->Regions + (cells - allCells);
+      std::fill_n(regions, ncells, -1);
+      this->NumSplits[ptId] = 0;
+      if (ncells <= 1)
+      {
+        continue; // point does not need to be further disconnected
+      }
+
+      // The region of a cell using the point. Cells are sorted so that a
+      // cell using the point several times has a single region.
+      auto region = [cells, ncells, regions](vtkIdType cellId) -> int& {
+        return regions[std::lower_bound(cells, cells + ncells, cellId) - cells];
+      };
+
+      // Start moving around the "cycle" of points using the point. Label
+      // each subregion of cells connected to this point that are connected
+      // (and not separated by a feature edge) with a given region number.
+      vtkIdType numPts;
+      const vtkIdType* pts;
+      int numRegions = 0;
+      vtkIdType spot, neiPt[2], nei, cellId, neiCellId;
+      double thisNormal[3], neiNormal[3];
+      for (vtkIdType j = 0; j < ncells; j++) // for all cells connected to point
+      {
+        if (region(cells[j]) < 0) // for all unvisited cells
+        {
+          region(cells[j]) = numRegions;
+          // okay, mark all the cells connected to this seed cell and using ptId
+          iter->GetCellAtId(cells[j], numPts, pts);
+
+          // find the two edges
+          for (spot = 0; spot < numPts; spot++)
+          {
+            if (pts[spot] == ptId)
+            {
+              break;
+            }
+          }
+
+          if (spot == 0)
+          {
+            neiPt[0] = pts[spot + 1];
+            neiPt[1] = pts[numPts - 1];
+          }
+          else if (spot == (numPts - 1))
+          {
+            neiPt[0] = pts[spot - 1];
+            neiPt[1] = pts[0];
+          }
+          else
+          {
+            neiPt[0] = pts[spot + 1];
+            neiPt[1] = pts[spot - 1];
+          }
+
+          for (int i = 0; i < 2; i++) // for each of the two edges of the seed cell
+          {
+            cellId = cells[j];
+            nei = neiPt[i];
+            while (cellId >= 0) // while we can grow this region
+            {
+              GetCellEdgeNeighbors(this->Links, cellId, ptId, nei, cellIds);
+              if (cellIds->GetNumberOfIds() == 1 && region((neiCellId = cellIds->GetId(0))) < 0)
+              {
+                this->PolyNormals->GetTuple(cellId, thisNormal);
+                this->PolyNormals->GetTuple(neiCellId, neiNormal);
+
+                if (vtkMath::Dot(thisNormal, neiNormal) > this->CosAngle)
+                {
+                  // visit and arrange to visit next edge neighbor
+                  region(neiCellId) = numRegions;
+                  cellId = neiCellId;
+                  iter->GetCellAtId(cellId, numPts, pts);
+
+                  for (spot = 0; spot < numPts; spot++)
+                  {
+                    if (pts[spot] == ptId)
+                    {
+                      break;
+                    }
+                  }
+
+                  if (spot == 0)
+                  {
+                    nei = (pts[spot + 1] != nei ? pts[spot + 1] : pts[numPts - 1]);
+                  }
+                  else if (spot == (numPts - 1))
+                  {
+                    nei = (pts[spot - 1] != nei ? pts[spot - 1] : pts[0]);
+                  }
+                  else
+                  {
+                    nei = (pts[spot + 1] != nei ? pts[spot + 1] : pts[spot - 1]);
+                  }
+
+                } // if not separated by edge angle
+                else
+                {
+                  cellId = -1; // separated by edge angle
+                }
+              } // if can move to edge neighbor
+              else
+              {
+                cellId = -1; // separated by previous visit, boundary, or non-manifold
+              }
+            } // while visit wave is propagating
+          }   // for each of the two edges of the starting cell
+          numRegions++;
+        } // if cell is unvisited
+      }   // for all cells connected to point ptId
+
+      // For N regions, N-1 duplicate (split) points are created.
+      if (numRegions > 1)
+      {
+        this->NumSplits[ptId] = numRegions - 1;
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+//----------------------------------------------------------------------------
+// Replace the points of the polygons not in the first region around them
+// with their duplicates. Polygons are rewritten in parallel.
+struct ReplaceSplitPoints
+{
+  template <typename CellStateT>
+  void operator()(
+    CellStateT& state, NormalsLinks* links, const int* regions, const vtkIdType* firstNewIds)
+  {
+    using ValueType = typename CellStateT::ValueType;
+    const vtkIdType* allCells = links->GetCells(0);
+
+    vtkSMPTools::For(0, state.GetNumberOfCells(), [&](vtkIdType cellId, vtkIdType endCellId) {
+      for (; cellId < endCellId; ++cellId)
+      {
+        for (ValueType& cellPtId : state.GetCellRange(cellId))
+        {
+          const vtkIdType ptId = static_cast<vtkIdType>(cellPtId);
+          if (firstNewIds[ptId + 1] == firstNewIds[ptId])
+          {
+            continue;
+          }
+          const vtkIdType* cells = links->GetCells(ptId);
+          const vtkIdType* cell = std::lower_bound(cells, cells + links->GetNcells(ptId), cellId);
+          const int region = regions[cell - allCells];
+          if (region > 0)
+          {
+            cellPtId = static_cast<ValueType>(firstNewIds[ptId] + region - 1);
+          }
+        }
+      }
+    });
+  }
+};
+
+} // anonymous namespace
+
 // Construct with feature angle=30, splitting and consistency turned on,
 // flipNormals turned off, and non-manifold traversal turned on.
 vtkPolyDataNormals::vtkPolyDataNormals()
@@ -56,6 +312,7 @@ vtkPolyDataNormals::vtkPolyDataNormals()
   this->Map = nullptr;
   this->OldMesh = nullptr;
   this->NewMesh = nullptr;
+  this->Links = nullptr;
   this->Visited = nullptr;
   this->PolyNormals = nullptr;
   this->CosAngle = 0.0;
@@ -91,7 +348,7 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
   vtkDataSetAttributes* outCD = output->GetCellData();
   double n[3];
   vtkCellArray* newPolys;
-  vtkIdType ptId, oldId;
+  vtkIdType ptId;
 
   vtkDebugMacro(<< "Generating surface normals");
 
@@ -175,7 +432,14 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     this->OldMesh->SetPolys(inPolys);
     polys = inPolys;
   }
-  this->OldMesh->BuildLinks();
+  this->OldMesh->BuildCells();
+
+  // Topological queries use links from points to polygons, built in
+  // parallel.
+  if (this->Consistency || this->Splitting || this->AutoOrientNormals)
+  {
+    this->Links = BuildSortedLinks(numPts, polys);
+  }
   this->UpdateProgress(0.10);
 
   pd = input->GetPointData();
@@ -191,7 +455,7 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
 
   // The visited array keeps track of which polygons have been visited.
   //
-  if (this->Consistency || this->Splitting || this->AutoOrientNormals)
+  if (this->Consistency || this->AutoOrientNormals)
   {
     this->Visited = new int[numPolys];
     memset(this->Visited, VTK_CELL_NOT_VISITED, numPolys * sizeof(int));
@@ -262,7 +526,8 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
       do
       {
         currentPointID = leftmostPoints->Pop();
-        this->OldMesh->GetPointCells(currentPointID, nleftmostCells, leftmostCells);
+        nleftmostCells = this->Links->GetNcells(currentPointID);
+        leftmostCells = this->Links->GetCells(currentPointID);
         bestNormalAbsXComponent = 0.0;
         bestReverseFlag = 0;
         for (cIdx = 0; cIdx < nleftmostCells; cIdx++)
@@ -362,19 +627,30 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     this->PolyNormals->SetTuple(cellId, n);
   }
 
-  for (cellId = 0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts); cellId++)
-  {
-    if ((cellId % 1000) == 0)
+  // The polygon normals are computed in parallel, each task checking for an
+  // abort once done. Progress is only reported from the calling thread.
+  std::atomic<bool> aborted(false);
+  vtkSMPTools::For(0, numPolys, [&](vtkIdType polyId, vtkIdType endPolyId) {
+    if (aborted)
     {
-      this->UpdateProgress(0.333 + 0.333 * (double)cellId / (double)numPolys);
-      if (this->GetAbortExecute())
-      {
-        break;
-      }
+      return;
     }
-    vtkPolygon::ComputeNormal(inPts, npts, pts, n);
-    this->PolyNormals->SetTuple(offsetCells + cellId, n);
-  }
+    auto iter = vtk::TakeSmartPointer(newPolys->NewIterator());
+    vtkIdType numPolyPts;
+    const vtkIdType* polyPts;
+    double polyNormal[3];
+    for (; polyId < endPolyId; ++polyId)
+    {
+      iter->GetCellAtId(polyId, numPolyPts, polyPts);
+      vtkPolygon::ComputeNormal(inPts, numPolyPts, polyPts, polyNormal);
+      this->PolyNormals->SetTuple(offsetCells + polyId, polyNormal);
+    }
+    if (this->GetAbortExecute())
+    {
+      aborted = true;
+    }
+  });
+  this->UpdateProgress(0.5);
 
   // Split mesh if sharp features
   if (this->Splitting)
@@ -388,18 +664,7 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     // to map new points into old points.
     //
     this->Map = vtkIdList::New();
-    this->Map->SetNumberOfIds(numPts);
-    for (vtkIdType i = 0; i < numPts; i++)
-    {
-      this->Map->SetId(i, i);
-    }
-
-    for (ptId = 0; ptId < numPts; ptId++)
-    {
-      this->MarkAndSplit(ptId);
-    } // for all input points
-
-    numNewPts = this->Map->GetNumberOfIds();
+    numNewPts = this->SplitPoints(numPts, polys, newPolys);
 
     vtkDebugMacro(<< "Created " << numNewPts - numPts << " new points");
 
@@ -433,12 +698,19 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     }
 
     newPts->SetNumberOfPoints(numNewPts);
-    for (ptId = 0; ptId < numNewPts; ptId++)
-    {
-      oldId = this->Map->GetId(ptId);
-      newPts->SetPoint(ptId, inPts->GetPoint(oldId));
-      outPD->CopyData(pd, oldId, ptId);
-    }
+    const vtkIdType* map = this->Map->GetPointer(0);
+    vtkSMPTools::For(0, numNewPts, [&](vtkIdType newPtId, vtkIdType endNewPtId) {
+      double x[3];
+      for (; newPtId < endNewPtId; ++newPtId)
+      {
+        inPts->GetPoint(map[newPtId], x);
+        newPts->SetPoint(newPtId, x);
+      }
+    });
+    vtkNew<vtkIdList> newPtIds;
+    newPtIds->SetNumberOfIds(numNewPts);
+    std::iota(newPtIds->GetPointer(0), newPtIds->GetPointer(0) + numNewPts, 0);
+    outPD->CopyData(pd, this->Map, newPtIds);
     this->Map->Delete();
   } // splitting
 
@@ -449,7 +721,7 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     outPD->PassData(pd);
   }
 
-  if (this->Consistency || this->Splitting)
+  if (this->Consistency || this->AutoOrientNormals)
   {
     delete[] this->Visited;
     this->CellIds->Delete();
@@ -481,30 +753,46 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
 
   if (this->ComputePointNormals)
   {
-    for (cellId = 0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts); ++cellId)
+    // Each point gathers the normals of the polygons using it, in the order
+    // of the polygons, so that no two threads write the same normal. The
+    // links are rebuilt if points were split.
+    if (this->Links && numNewPts != numPts)
     {
-      for (vtkIdType i = 0; i < npts; ++i)
-      {
-        fNormals[3 * pts[i]] += fPolyNormals[3 * cellId];
-        fNormals[3 * pts[i] + 1] += fPolyNormals[3 * cellId + 1];
-        fNormals[3 * pts[i] + 2] += fPolyNormals[3 * cellId + 2];
-      }
+      delete this->Links;
+      this->Links = nullptr;
     }
-
-    for (vtkIdType i = 0; i < numNewPts; ++i)
+    if (!this->Links)
     {
-      const double length =
-        sqrt(fNormals[3 * i] * fNormals[3 * i] + fNormals[3 * i + 1] * fNormals[3 * i + 1] +
-          fNormals[3 * i + 2] * fNormals[3 * i + 2]) *
-        flipDirection;
-      if (length != 0.0)
+      this->Links = BuildSortedLinks(numNewPts, newPolys);
+    }
+    NormalsLinks* links = this->Links;
+    vtkSMPTools::For(0, numNewPts, [&](vtkIdType i, vtkIdType endPtId) {
+      for (; i < endPtId; ++i)
       {
-        fNormals[3 * i] /= length;
-        fNormals[3 * i + 1] /= length;
-        fNormals[3 * i + 2] /= length;
+        const vtkIdType* cells = links->GetCells(i);
+        const vtkIdType ncells = links->GetNcells(i);
+        for (vtkIdType j = 0; j < ncells; ++j)
+        {
+          fNormals[3 * i] += fPolyNormals[3 * cells[j]];
+          fNormals[3 * i + 1] += fPolyNormals[3 * cells[j] + 1];
+          fNormals[3 * i + 2] += fPolyNormals[3 * cells[j] + 2];
+        }
+
+        const double length =
+          sqrt(fNormals[3 * i] * fNormals[3 * i] + fNormals[3 * i + 1] * fNormals[3 * i + 1] +
+            fNormals[3 * i + 2] * fNormals[3 * i + 2]) *
+          flipDirection;
+        if (length != 0.0)
+        {
+          fNormals[3 * i] /= length;
+          fNormals[3 * i + 1] /= length;
+          fNormals[3 * i + 2] /= length;
+        }
       }
-    }
+    });
   }
+  delete this->Links;
+  this->Links = nullptr;
 
   //  Update ourselves.  If no new nodes have been created (i.e., no
   //  splitting), we can simply pass data through.
@@ -577,7 +865,7 @@ void vtkPolyDataNormals::TraverseAndOrder()
 
       for (j = 0, j1 = 1; j < npts; ++j, (j1 = (++j1 < npts) ? j1 : 0)) // for each edge neighbor
       {
-        this->OldMesh->GetCellEdgeNeighbors(cellId, pts[j], pts[j1], this->CellIds);
+        GetCellEdgeNeighbors(this->Links, cellId, pts[j], pts[j1], this->CellIds);
 
         //  Check the direction of the neighbor ordering.  Should be
         //  consistent with us (i.e., if we are n1->n2,
@@ -625,152 +913,36 @@ void vtkPolyDataNormals::TraverseAndOrder()
 }
 
 //
-//  Mark polygons around vertex.  Create new vertex (if necessary) and
-//  replace (i.e., split mesh).
+//  Mark the polygons around each point with the regions separated by
+//  feature edges. Create new points for all the regions but the first and
+//  replace them in the polygons (i.e., split the mesh).
 //
-void vtkPolyDataNormals::MarkAndSplit(vtkIdType ptId)
+vtkIdType vtkPolyDataNormals::SplitPoints(
+  vtkIdType numPts, vtkCellArray* oldPolys, vtkCellArray* newPolys)
 {
-  int i, j;
-
-  // Get the cells using this point and make sure that we have to do something
-  vtkIdType ncells;
-  vtkIdType* cells;
-  this->OldMesh->GetPointCells(ptId, ncells, cells);
-  if (ncells <= 1)
-  {
-    return; // point does not need to be further disconnected
-  }
-
-  // Start moving around the "cycle" of points using the point. Label
-  // each point as requiring a visit. Then label each subregion of cells
-  // connected to this point that are connected (and not separated by
-  // a feature edge) with a given region number. For each N regions
-  // created, N-1 duplicate (split) points are created. The split point
-  // replaces the current point ptId in the polygons connectivity array.
-  //
-  // Start by initializing the cells as unvisited
-  for (i = 0; i < ncells; i++)
-  {
-    this->Visited[cells[i]] = -1;
-  }
-
-  // Loop over all cells and mark the region that each is in.
-  //
-  vtkIdType numPts;
-  const vtkIdType* pts;
-  int numRegions = 0;
-  vtkIdType spot, neiPt[2], nei, cellId, neiCellId;
-  double thisNormal[3], neiNormal[3];
-  for (j = 0; j < ncells; j++) // for all cells connected to point
-  {
-    if (this->Visited[cells[j]] < 0) // for all unvisited cells
+  std::vector<int> regions(this->Links->GetCells(numPts) - this->Links->GetCells(0));
+  std::vector<vtkIdType> firstNewIds(numPts + 1);
+  MarkRegions mark(
+    this->Links, oldPolys, this->PolyNormals, this->CosAngle, regions.data(), firstNewIds.data());
+  vtkSMPTools::For(0, numPts, mark);
+
+  // The new points of a point follow the ones of the points before it.
+  firstNewIds[numPts] = 0;
+  const vtkIdType numNewPts =
+    vtkSMPTools::ExclusiveScan(firstNewIds.begin(), firstNewIds.end(), firstNewIds.begin(), numPts);
+
+  this->Map->SetNumberOfIds(numNewPts);
+  vtkIdType* map = this->Map->GetPointer(0);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
     {
-      this->Visited[cells[j]] = numRegions;
-      // okay, mark all the cells connected to this seed cell and using ptId
-      this->OldMesh->GetCellPoints(cells[j], numPts, pts);
-
-      // find the two edges
-      for (spot = 0; spot < numPts; spot++)
-      {
-        if (pts[spot] == ptId)
-        {
-          break;
-        }
-      }
-
-      if (spot == 0)
-      {
-        neiPt[0] = pts[spot + 1];
-        neiPt[1] = pts[numPts - 1];
-      }
-      else if (spot == (numPts - 1))
-      {
-        neiPt[0] = pts[spot - 1];
-        neiPt[1] = pts[0];
-      }
-      else
-      {
-        neiPt[0] = pts[spot + 1];
-        neiPt[1] = pts[spot - 1];
-      }
-
-      for (i = 0; i < 2; i++) // for each of the two edges of the seed cell
-      {
-        cellId = cells[j];
-        nei = neiPt[i];
-        while (cellId >= 0) // while we can grow this region
-        {
-          this->OldMesh->GetCellEdgeNeighbors(cellId, ptId, nei, this->CellIds);
-          if (this->CellIds->GetNumberOfIds() == 1 &&
-            this->Visited[(neiCellId = this->CellIds->GetId(0))] < 0)
-          {
-            this->PolyNormals->GetTuple(cellId, thisNormal);
-            this->PolyNormals->GetTuple(neiCellId, neiNormal);
-
-            if (vtkMath::Dot(thisNormal, neiNormal) > CosAngle)
-            {
-              // visit and arrange to visit next edge neighbor
-              this->Visited[neiCellId] = numRegions;
-              cellId = neiCellId;
-              this->OldMesh->GetCellPoints(cellId, numPts, pts);
-
-              for (spot = 0; spot < numPts; spot++)
-              {
-                if (pts[spot] == ptId)
-                {
-                  break;
-                }
-              }
-
-              if (spot == 0)
-              {
-                nei = (pts[spot + 1] != nei ? pts[spot + 1] : pts[numPts - 1]);
-              }
-              else if (spot == (numPts - 1))
-              {
-                nei = (pts[spot - 1] != nei ? pts[spot - 1] : pts[0]);
-              }
-              else
-              {
-                nei = (pts[spot + 1] != nei ? pts[spot + 1] : pts[spot - 1]);
-              }
-
-            } // if not separated by edge angle
-            else
-            {
-              cellId = -1; // separated by edge angle
-            }
-          } // if can move to edge neighbor
-          else
-          {
-            cellId = -1; // separated by previous visit, boundary, or non-manifold
-          }
-        } // while visit wave is propagating
-      }   // for each of the two edges of the starting cell
-      numRegions++;
-    } // if cell is unvisited
-  }   // for all cells connected to point ptId
-
-  if (numRegions <= 1)
-  {
-    return; // a single region, no splitting ever required
-  }
+      map[ptId] = ptId;
+      std::fill(map + firstNewIds[ptId], map + firstNewIds[ptId + 1], ptId);
+    }
+  });
 
-  // Okay, for all cells not in the first region, the ptId is
-  // replaced with a new ptId, which is a duplicate of the first
-  // point, but disconnected topologically.
-  //
-  vtkIdType lastId = this->Map->GetNumberOfIds();
-  vtkIdType replacementPoint;
-  for (j = 0; j < ncells; j++)
-  {
-    if (this->Visited[cells[j]] > 0) // replace point if splitting needed
-    {
-      replacementPoint = lastId + this->Visited[cells[j]] - 1;
-      this->Map->InsertId(replacementPoint, ptId);
-      this->NewMesh->ReplaceCellPoint(cells[j], ptId, replacementPoint);
-    } // if not in first regions and requiring splitting
-  }   // for all cells connected to ptId
+  newPolys->Visit(ReplaceSplitPoints{}, this->Links, regions.data(), firstNewIds.data());
+  return numNewPts;
 }
 
 void vtkPolyDataNormals::PrintSelf(ostream& os, vtkIndent indent)
@@ -39,6 +39,12 @@
  * are split and new points generated to prevent blurry edges (due to
  * Gouraud shading).
  *
+ * The polygon normals, the splitting of sharp edges and the averaging of
+ * normals at points are computed in parallel with vtkSMPTools, on links from
+ * points to polygons built in parallel. Ordering polygons consistently
+ * propagates from polygon to polygon and remains sequential. The output does
+ * not depend on the number of threads.
+ *
  * @warning
  * Normals are computed only for polygons and triangle strips. Normals are
  * not computed for lines or vertices.
@@ -60,9 +66,12 @@
 #include "vtkFiltersCoreModule.h" // For export macro
 #include "vtkPolyDataAlgorithm.h"
 
+class vtkCellArray;
 class vtkFloatArray;
 class vtkIdList;
 class vtkPolyData;
+template <typename TIds>
+class vtkStaticCellLinksTemplate;
 
 class VTKFILTERSCORE_EXPORT vtkPolyDataNormals : public vtkPolyDataAlgorithm
 {
@@ -200,6 +209,7 @@ private:
   vtkIdList* Map;
   vtkPolyData* OldMesh;
   vtkPolyData* NewMesh;
+  vtkStaticCellLinksTemplate<vtkIdType>* Links;
   int* Visited;
   vtkFloatArray* PolyNormals;
   double CosAngle;
@@ -208,10 +218,10 @@ private:
   // checked and properly ordered polygons.
   void TraverseAndOrder(void);
 
-  // Check the point id give to see whether it lies on a feature
-  // edge. If so, split the point (i.e., duplicate it) to topologically
-  // separate the mesh.
-  void MarkAndSplit(vtkIdType ptId);
+  // Check in parallel whether the points lie on feature edges. If so,
+  // split the points (i.e., duplicate them) to topologically separate the
+  // mesh. Returns the number of points after splitting.
+  vtkIdType SplitPoints(vtkIdType numPts, vtkCellArray* oldPolys, vtkCellArray* newPolys);
 
 private:
   vtkPolyDataNormals(const vtkPolyDataNormals&) = delete;
@@ -968,12 +968,32 @@ void vtkQuadricClustering::EndAppend()
 //----------------------------------------------------------------------------
 void vtkQuadricClustering::ComputeRepresentativePoint(
   double quadric[9], vtkIdType binId, double point[3])
+{
+  double cellBounds[6];
+  const double binSize[3] = { this->XBinSize, this->YBinSize, this->ZBinSize };
+
+  vtkIdType x = binId % this->NumberOfDivisions[0];
+  vtkIdType y = (binId / this->NumberOfDivisions[0]) % this->NumberOfDivisions[1];
+  vtkIdType z = binId / this->SliceSize;
+
+  cellBounds[0] = this->Bounds[0] + x * this->XBinSize;
+  cellBounds[1] = this->Bounds[0] + (x + 1) * this->XBinSize;
+  cellBounds[2] = this->Bounds[2] + y * this->YBinSize;
+  cellBounds[3] = this->Bounds[2] + (y + 1) * this->YBinSize;
+  cellBounds[4] = this->Bounds[4] + z * this->ZBinSize;
+  cellBounds[5] = this->Bounds[4] + (z + 1) * this->ZBinSize;
+
+  vtkQuadricClustering::ComputeRepresentativePoint(quadric, cellBounds, binSize, point);
+}
+
+//----------------------------------------------------------------------------
+void vtkQuadricClustering::ComputeRepresentativePoint(
+  const double quadric[9], const double cellBounds[6], const double binSize[3], double point[3])
 {
   double A[3][3], U[3][3], UT[3][3], VT[3][3], V[3][3];
   double b[3], w[3];
   double W[3][3], tempMatrix[3][3];
   double cellCenter[3], tempVector[3];
-  double cellBounds[6];
   double quadric4x4[4][4];
 
   quadric4x4[0][0] = quadric[0];
@@ -987,17 +1007,6 @@ void vtkQuadricClustering::ComputeRepresentativePoint(
   quadric4x4[2][3] = quadric4x4[3][2] = quadric[8];
   quadric4x4[3][3] = 1; // arbitrary value
 
-  vtkIdType x = binId % this->NumberOfDivisions[0];
-  vtkIdType y = (binId / this->NumberOfDivisions[0]) % this->NumberOfDivisions[1];
-  vtkIdType z = binId / this->SliceSize;
-
-  cellBounds[0] = this->Bounds[0] + x * this->XBinSize;
-  cellBounds[1] = this->Bounds[0] + (x + 1) * this->XBinSize;
-  cellBounds[2] = this->Bounds[2] + y * this->YBinSize;
-  cellBounds[3] = this->Bounds[2] + (y + 1) * this->YBinSize;
-  cellBounds[4] = this->Bounds[4] + z * this->ZBinSize;
-  cellBounds[5] = this->Bounds[4] + (z + 1) * this->ZBinSize;
-
   for (int i = 0; i < 3; i++)
   {
     b[i] = -quadric4x4[3][i];
@@ -1061,9 +1070,8 @@ void vtkQuadricClustering::ComputeRepresentativePoint(
   // Make absolutely sure that the point lies in the vicinity (enclosing
   // sphere) of the bin.  If not, then clamp the point to the enclosing sphere.
   double deltaMag = vtkMath::Norm(tempVector);
-  double radius = sqrt(this->XBinSize * this->XBinSize + this->YBinSize * this->YBinSize +
-                    this->ZBinSize * this->ZBinSize) /
-    2.0;
+  double radius =
+    sqrt(binSize[0] * binSize[0] + binSize[1] * binSize[1] + binSize[2] * binSize[2]) / 2.0;
   if (deltaMag > radius)
   {
     tempVector[0] *= radius / deltaMag;
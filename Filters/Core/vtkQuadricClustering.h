@@ -80,6 +80,7 @@
  *
  * @sa
  * vtkQuadricDecimation vtkDecimatePro vtkDecimate vtkQuadricLODActor
+ * vtkQuadricClusteringPyramid
  */
 
 #ifndef vtkQuadricClustering_h
@@ -259,6 +260,15 @@ public:
   vtkBooleanMacro(PreventDuplicateCells, vtkTypeBool);
   //@}
 
+  /**
+   * Compute the point minimizing the given quadric, as accumulated by this
+   * filter, within a bin of the given bounds and size. The point is clamped
+   * to the sphere enclosing the bin. This is also used by
+   * vtkQuadricClusteringPyramid.
+   */
+  static void ComputeRepresentativePoint(
+    const double quadric[9], const double cellBounds[6], const double binSize[3], double point[3]);
+
 protected:
   vtkQuadricClustering();
   ~vtkQuadricClustering() override;
@@ -0,0 +1,538 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkQuadricClusteringPyramid.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkQuadricClusteringPyramid.h"
+
+#include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkQuadricClustering.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkTriangle.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+vtkStandardNewMacro(vtkQuadricClusteringPyramid);
+
+namespace
+{
+using KeyedId = std::pair<vtkIdType, vtkIdType>;
+
+// The bins of a level used by the mesh, sorted by increasing bin id.
+struct UsedBins
+{
+  std::vector<vtkIdType> BinIds;
+  // The first triangle corner (3 * triangle id + corner) lying in each bin,
+  // which orders the output points as vtkQuadricClustering does.
+  std::vector<vtkIdType> FirstCorners;
+  // The 9 coefficients of the quadric of each bin.
+  std::vector<double> Quadrics;
+
+  vtkIdType GetNumberOfBins() const { return static_cast<vtkIdType>(this->BinIds.size()); }
+
+  void Allocate(vtkIdType numBins)
+  {
+    this->BinIds.resize(numBins);
+    this->FirstCorners.resize(numBins);
+    this->Quadrics.resize(9 * numBins);
+  }
+};
+
+// Sort the (key, id) pairs and list the first pair of each key in
+// groupOffsets, followed by the number of pairs.
+void GroupByKey(std::vector<KeyedId>& pairs, std::vector<vtkIdType>& groupOffsets)
+{
+  vtkSMPTools::Sort(pairs.begin(), pairs.end());
+  const vtkIdType numPairs = static_cast<vtkIdType>(pairs.size());
+  auto isFirst = [&](vtkIdType i) { return i == 0 || pairs[i].first != pairs[i - 1].first; };
+
+  std::vector<vtkIdType> groupIds(numPairs);
+  vtkSMPTools::For(0, numPairs, [&](vtkIdType i, vtkIdType end) {
+    for (; i < end; ++i)
+    {
+      groupIds[i] = isFirst(i) ? 1 : 0;
+    }
+  });
+  const vtkIdType numGroups =
+    vtkSMPTools::ExclusiveScan(groupIds.begin(), groupIds.end(), groupIds.begin(), vtkIdType(0));
+  groupOffsets.resize(numGroups + 1);
+  groupOffsets[numGroups] = numPairs;
+  vtkSMPTools::For(0, numPairs, [&](vtkIdType i, vtkIdType end) {
+    for (; i < end; ++i)
+    {
+      if (isFirst(i))
+      {
+        groupOffsets[groupIds[i]] = i;
+      }
+    }
+  });
+}
+
+// Merge the bins of the previous level 2x2x2 into the bins of the next one,
+// whose numbers of divisions are given. binOfCorners maps each triangle
+// corner to its bin, and is updated to the merged bins.
+void CoarsenBins(const UsedBins& fine, const int fineDivs[3], const int coarseDivs[3],
+  UsedBins& coarse, std::vector<vtkIdType>& binOfCorners)
+{
+  const vtkIdType numFineBins = fine.GetNumberOfBins();
+  const vtkIdType fineSlice = static_cast<vtkIdType>(fineDivs[0]) * fineDivs[1];
+  const vtkIdType coarseSlice = static_cast<vtkIdType>(coarseDivs[0]) * coarseDivs[1];
+  std::vector<KeyedId> children(numFineBins);
+  vtkSMPTools::For(0, numFineBins, [&](vtkIdType bin, vtkIdType end) {
+    for (; bin < end; ++bin)
+    {
+      const vtkIdType id = fine.BinIds[bin];
+      const vtkIdType x = id % fineDivs[0];
+      const vtkIdType y = (id / fineDivs[0]) % fineDivs[1];
+      const vtkIdType z = id / fineSlice;
+      children[bin] =
+        KeyedId((x >> 1) + (y >> 1) * coarseDivs[0] + (z >> 1) * coarseSlice, bin);
+    }
+  });
+  std::vector<vtkIdType> offsets;
+  GroupByKey(children, offsets);
+
+  const vtkIdType numBins = static_cast<vtkIdType>(offsets.size()) - 1;
+  std::vector<vtkIdType> parents(numFineBins);
+  coarse.Allocate(numBins);
+  vtkSMPTools::For(0, numBins, [&](vtkIdType bin, vtkIdType end) {
+    for (; bin < end; ++bin)
+    {
+      coarse.BinIds[bin] = children[offsets[bin]].first;
+      vtkIdType firstCorner = VTK_ID_MAX;
+      double* q = coarse.Quadrics.data() + 9 * bin;
+      std::fill(q, q + 9, 0.0);
+      for (vtkIdType i = offsets[bin]; i < offsets[bin + 1]; ++i)
+      {
+        const vtkIdType child = children[i].second;
+        parents[child] = bin;
+        firstCorner = std::min(firstCorner, fine.FirstCorners[child]);
+        const double* childQ = fine.Quadrics.data() + 9 * child;
+        for (int j = 0; j < 9; ++j)
+        {
+          q[j] += childQ[j];
+        }
+      }
+      coarse.FirstCorners[bin] = firstCorner;
+    }
+  });
+
+  vtkSMPTools::Transform(binOfCorners.begin(), binOfCorners.end(), binOfCorners.begin(),
+    [&](vtkIdType bin) { return parents[bin]; });
+}
+
+// Build the mesh of a level: a point per used bin, and the triangles whose
+// corners lie in three different bins, once per triple of bins.
+void ExtractLevel(const UsedBins& bins, const std::vector<vtkIdType>& binOfCorners,
+  const int divs[3], const double origin[3], const double binSize[3], vtkPolyData* output)
+{
+  const vtkIdType numBins = bins.GetNumberOfBins();
+  const vtkIdType numTris = static_cast<vtkIdType>(binOfCorners.size()) / 3;
+
+  // Number the points in the order the triangles first visit their bins.
+  std::vector<KeyedId> visits(numBins);
+  vtkSMPTools::For(0, numBins, [&](vtkIdType bin, vtkIdType end) {
+    for (; bin < end; ++bin)
+    {
+      visits[bin] = KeyedId(bins.FirstCorners[bin], bin);
+    }
+  });
+  vtkSMPTools::Sort(visits.begin(), visits.end());
+  std::vector<vtkIdType> pointIds(numBins);
+  vtkSMPTools::For(0, numBins, [&](vtkIdType ptId, vtkIdType end) {
+    for (; ptId < end; ++ptId)
+    {
+      pointIds[visits[ptId].second] = ptId;
+    }
+  });
+
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numBins);
+  const vtkIdType slice = static_cast<vtkIdType>(divs[0]) * divs[1];
+  vtkSMPTools::For(0, numBins, [&](vtkIdType bin, vtkIdType end) {
+    double cellBounds[6], x[3];
+    for (; bin < end; ++bin)
+    {
+      const vtkIdType id = bins.BinIds[bin];
+      const vtkIdType coords[3] = { id % divs[0], (id / divs[0]) % divs[1], id / slice };
+      for (int i = 0; i < 3; ++i)
+      {
+        cellBounds[2 * i] = origin[i] + coords[i] * binSize[i];
+        cellBounds[2 * i + 1] = origin[i] + (coords[i] + 1) * binSize[i];
+      }
+      vtkQuadricClustering::ComputeRepresentativePoint(
+        bins.Quadrics.data() + 9 * bin, cellBounds, binSize, x);
+      points->SetPoint(pointIds[bin], x);
+    }
+  });
+  output->SetPoints(points);
+
+  // Gather the triangles spanning three bins, keyed by their sorted bins,
+  // and keep the first triangle of each key.
+  std::vector<unsigned char> keep(numTris);
+  vtkSMPTools::For(0, numTris, [&](vtkIdType triId, vtkIdType end) {
+    for (; triId < end; ++triId)
+    {
+      const vtkIdType* triBins = binOfCorners.data() + 3 * triId;
+      keep[triId] =
+        triBins[0] != triBins[1] && triBins[0] != triBins[2] && triBins[1] != triBins[2];
+    }
+  });
+  std::vector<vtkIdType> triOffsets(numTris);
+  const vtkIdType numSpanning =
+    vtkSMPTools::ExclusiveScan(keep.begin(), keep.end(), triOffsets.begin(), vtkIdType(0));
+  std::vector<std::array<vtkIdType, 4>> keys(numSpanning);
+  vtkSMPTools::For(0, numTris, [&](vtkIdType triId, vtkIdType end) {
+    for (; triId < end; ++triId)
+    {
+      if (keep[triId])
+      {
+        const vtkIdType* triBins = binOfCorners.data() + 3 * triId;
+        std::array<vtkIdType, 4>& key = keys[triOffsets[triId]];
+        key = { { triBins[0], triBins[1], triBins[2], triId } };
+        std::sort(key.begin(), key.begin() + 3);
+      }
+    }
+  });
+  vtkSMPTools::Sort(keys.begin(), keys.end());
+
+  vtkSMPTools::Fill(keep.begin(), keep.end(), static_cast<unsigned char>(0));
+  vtkSMPTools::For(0, numSpanning, [&](vtkIdType i, vtkIdType end) {
+    for (; i < end; ++i)
+    {
+      if (i == 0 || !std::equal(keys[i].begin(), keys[i].begin() + 3, keys[i - 1].begin()))
+      {
+        keep[keys[i][3]] = 1;
+      }
+    }
+  });
+  const vtkIdType numOutTris =
+    vtkSMPTools::ExclusiveScan(keep.begin(), keep.end(), triOffsets.begin(), vtkIdType(0));
+  if (numOutTris == 0)
+  {
+    return;
+  }
+
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numOutTris + 1);
+  vtkNew<vtkIdTypeArray> conn;
+  conn->SetNumberOfValues(3 * numOutTris);
+  vtkIdType* outOffsets = offsets->GetPointer(0);
+  vtkIdType* outConn = conn->GetPointer(0);
+  vtkSMPTools::For(0, numTris, [&](vtkIdType triId, vtkIdType end) {
+    for (; triId < end; ++triId)
+    {
+      if (keep[triId])
+      {
+        const vtkIdType outTriId = triOffsets[triId];
+        outOffsets[outTriId] = 3 * outTriId;
+        for (int i = 0; i < 3; ++i)
+        {
+          outConn[3 * outTriId + i] = pointIds[binOfCorners[3 * triId + i]];
+        }
+      }
+    }
+  });
+  outOffsets[numOutTris] = 3 * numOutTris;
+  vtkNew<vtkCellArray> polys;
+  polys->SetData(offsets, conn);
+  output->SetPolys(polys);
+}
+}
+
+//----------------------------------------------------------------------------
+vtkQuadricClusteringPyramid::vtkQuadricClusteringPyramid()
+{
+  this->NumberOfLevels = 4;
+  this->NumberOfDivisions[0] = this->NumberOfDivisions[1] = this->NumberOfDivisions[2] = 64;
+  this->AutoAdjustNumberOfDivisions = 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkQuadricClusteringPyramid::RequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkPolyData* input = vtkPolyData::GetData(inputVector[0]);
+  vtkMultiBlockDataSet* output = vtkMultiBlockDataSet::GetData(outputVector);
+
+  const int numLevels = this->NumberOfLevels;
+  std::vector<vtkPolyData*> levels(numLevels);
+  output->SetNumberOfBlocks(numLevels);
+  for (int level = 0; level < numLevels; ++level)
+  {
+    vtkNew<vtkPolyData> mesh;
+    output->SetBlock(level, mesh);
+    output->GetMetaData(level)->Set(
+      vtkCompositeDataSet::NAME(), ("Level " + std::to_string(level)).c_str());
+    levels[level] = mesh;
+  }
+
+  vtkCellArray* polys = input->GetPolys();
+  vtkCellArray* strips = input->GetStrips();
+  const vtkIdType numPolys = polys->GetNumberOfCells();
+  const vtkIdType numCells = numPolys + strips->GetNumberOfCells();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  if (numPts == 0 || numCells == 0)
+  {
+    return 1;
+  }
+
+  // Limit the number of divisions based on the number of points in the
+  // input, as vtkQuadricClustering does.
+  int divs[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    divs[i] = std::max(this->NumberOfDivisions[i], 1);
+  }
+  const vtkIdType numDiv = static_cast<vtkIdType>(divs[0]) * divs[1] * divs[2] / 2;
+  if (this->AutoAdjustNumberOfDivisions && numDiv > numPts)
+  {
+    const double factor = pow(static_cast<double>(numDiv) / numPts, 0.33333);
+    for (int i = 0; i < 3; ++i)
+    {
+      divs[i] = std::max(static_cast<int>(0.5 + divs[i] / factor), 1);
+    }
+  }
+
+  double bounds[6], origin[3], binSize[3], binStep[3];
+  input->GetBounds(bounds);
+  for (int i = 0; i < 3; ++i)
+  {
+    origin[i] = bounds[2 * i];
+    binSize[i] = (bounds[2 * i + 1] - bounds[2 * i]) / divs[i];
+    binStep[i] = binSize[i] > 0.0 ? 1.0 / binSize[i] : 0.0;
+  }
+
+  // Triangulate the polygons with fans and the strips, as
+  // vtkQuadricClustering does.
+  std::vector<vtkIdType> triOffsets(numCells + 1);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      const vtkIdType npts =
+        cellId < numPolys ? polys->GetCellSize(cellId) : strips->GetCellSize(cellId - numPolys);
+      triOffsets[cellId] = std::max(npts - 2, vtkIdType(0));
+    }
+  });
+  const vtkIdType numTris = vtkSMPTools::ExclusiveScan(
+    triOffsets.begin(), triOffsets.end(), triOffsets.begin(), vtkIdType(0));
+  if (numTris == 0)
+  {
+    return 1;
+  }
+  std::vector<vtkIdType> triangles(3 * numTris);
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> polyIterators;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> stripIterators;
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    vtkSmartPointer<vtkCellArrayIterator>& polyIter = polyIterators.Local();
+    vtkSmartPointer<vtkCellArrayIterator>& stripIter = stripIterators.Local();
+    if (!polyIter)
+    {
+      polyIter = vtk::TakeSmartPointer(polys->NewIterator());
+      stripIter = vtk::TakeSmartPointer(strips->NewIterator());
+    }
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (; cellId < endCellId; ++cellId)
+    {
+      vtkIdType* tri = triangles.data() + 3 * triOffsets[cellId];
+      if (cellId < numPolys)
+      {
+        polyIter->GetCellAtId(cellId, npts, pts);
+        for (vtkIdType j = 0; j < npts - 2; ++j, tri += 3)
+        {
+          tri[0] = pts[0];
+          tri[1] = pts[j + 1];
+          tri[2] = pts[j + 2];
+        }
+      }
+      else
+      {
+        // Every other triangle of the strip replaces its first point.
+        stripIter->GetCellAtId(cellId - numPolys, npts, pts);
+        vtkIdType edge[2] = { npts > 0 ? pts[0] : 0, npts > 1 ? pts[1] : 0 };
+        for (vtkIdType j = 2; j < npts; ++j, tri += 3)
+        {
+          tri[0] = edge[0];
+          tri[1] = edge[1];
+          tri[2] = pts[j];
+          edge[j % 2] = pts[j];
+        }
+      }
+    }
+  });
+  this->UpdateProgress(0.1);
+
+  // Hash the points in the bins of the finest level, and compute the quadric
+  // of each triangle, scaled as in vtkQuadricClustering.
+  std::vector<vtkIdType> pointBins(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    double x[3];
+    for (; ptId < endPtId; ++ptId)
+    {
+      input->GetPoint(ptId, x);
+      vtkIdType coords[3];
+      for (int i = 0; i < 3; ++i)
+      {
+        coords[i] = static_cast<vtkIdType>((x[i] - origin[i]) * binStep[i]);
+        coords[i] = std::min(std::max(coords[i], vtkIdType(0)), vtkIdType(divs[i] - 1));
+      }
+      pointBins[ptId] = coords[0] + coords[1] * divs[0] + coords[2] * divs[0] * divs[1];
+    }
+  });
+
+  std::vector<double> triQuadrics(9 * numTris);
+  vtkSMPTools::For(0, numTris, [&](vtkIdType triId, vtkIdType endTriId) {
+    double x[3][3], quadric4x4[4][4];
+    for (; triId < endTriId; ++triId)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        input->GetPoint(triangles[3 * triId + i], x[i]);
+      }
+      vtkTriangle::ComputeQuadric(x[0], x[1], x[2], quadric4x4);
+      double* q = triQuadrics.data() + 9 * triId;
+      q[0] = quadric4x4[0][0] * 100000000.0;
+      q[1] = quadric4x4[0][1] * 100000000.0;
+      q[2] = quadric4x4[0][2] * 100000000.0;
+      q[3] = quadric4x4[0][3] * 100000000.0;
+      q[4] = quadric4x4[1][1] * 100000000.0;
+      q[5] = quadric4x4[1][2] * 100000000.0;
+      q[6] = quadric4x4[1][3] * 100000000.0;
+      q[7] = quadric4x4[2][2] * 100000000.0;
+      q[8] = quadric4x4[2][3] * 100000000.0;
+    }
+  });
+  this->UpdateProgress(0.2);
+
+  // Gather the triangle corners by bin with a counting sort, which keeps the
+  // corners of each bin in the order of the triangles. The quadric of a bin
+  // is the sum of the quadrics of its corners, in that order.
+  const vtkIdType numGridBins = static_cast<vtkIdType>(divs[0]) * divs[1] * divs[2];
+  std::vector<vtkIdType> binOffsets(numGridBins + 1);
+  for (vtkIdType corner = 0; corner < 3 * numTris; ++corner)
+  {
+    ++binOffsets[pointBins[triangles[corner]]];
+  }
+  vtkSMPTools::ExclusiveScan(
+    binOffsets.begin(), binOffsets.end(), binOffsets.begin(), vtkIdType(0));
+  std::vector<vtkIdType> corners(3 * numTris);
+  std::vector<vtkIdType> cursors(binOffsets.begin(), binOffsets.end() - 1);
+  for (vtkIdType corner = 0; corner < 3 * numTris; ++corner)
+  {
+    corners[cursors[pointBins[triangles[corner]]]++] = corner;
+  }
+  std::vector<vtkIdType>().swap(cursors);
+
+  // Number the used bins in increasing order.
+  std::vector<vtkIdType> usedIds(numGridBins);
+  vtkSMPTools::Transform(binOffsets.begin(), binOffsets.end() - 1, binOffsets.begin() + 1,
+    usedIds.begin(), [](vtkIdType begin, vtkIdType end) { return end > begin ? 1 : 0; });
+  const vtkIdType numBins =
+    vtkSMPTools::ExclusiveScan(usedIds.begin(), usedIds.end(), usedIds.begin(), vtkIdType(0));
+
+  UsedBins bins;
+  std::vector<vtkIdType> binOfCorners(3 * numTris);
+  bins.Allocate(numBins);
+  vtkSMPTools::For(0, numGridBins, [&](vtkIdType gridBin, vtkIdType end) {
+    for (; gridBin < end; ++gridBin)
+    {
+      if (binOffsets[gridBin + 1] == binOffsets[gridBin])
+      {
+        continue;
+      }
+      const vtkIdType bin = usedIds[gridBin];
+      bins.BinIds[bin] = gridBin;
+      bins.FirstCorners[bin] = corners[binOffsets[gridBin]];
+      double* q = bins.Quadrics.data() + 9 * bin;
+      std::fill(q, q + 9, 0.0);
+      for (vtkIdType i = binOffsets[gridBin]; i < binOffsets[gridBin + 1]; ++i)
+      {
+        const vtkIdType corner = corners[i];
+        binOfCorners[corner] = bin;
+        const double* triQ = triQuadrics.data() + 9 * (corner / 3);
+        for (int j = 0; j < 9; ++j)
+        {
+          q[j] += triQ[j];
+        }
+      }
+    }
+  });
+  std::vector<vtkIdType>().swap(binOffsets);
+  std::vector<vtkIdType>().swap(usedIds);
+  std::vector<vtkIdType>().swap(corners);
+  std::vector<double>().swap(triQuadrics);
+  this->UpdateProgress(0.3);
+
+  // Extract the levels, merging the bins of each level into the next one.
+  for (int level = 0; level < numLevels && !this->GetAbortExecute(); ++level)
+  {
+    int levelDivs[3];
+    double levelBinSize[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      levelDivs[i] = ((divs[i] - 1) >> level) + 1;
+      levelBinSize[i] = binSize[i] * (1 << level);
+    }
+    if (level > 0)
+    {
+      int fineDivs[3];
+      for (int i = 0; i < 3; ++i)
+      {
+        fineDivs[i] = ((divs[i] - 1) >> (level - 1)) + 1;
+      }
+      UsedBins coarse;
+      CoarsenBins(bins, fineDivs, levelDivs, coarse, binOfCorners);
+      std::swap(bins, coarse);
+    }
+    ExtractLevel(bins, binOfCorners, levelDivs, origin, levelBinSize, levels[level]);
+    this->UpdateProgress(0.3 + 0.7 * (level + 1) / numLevels);
+  }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkQuadricClusteringPyramid::FillInputPortInformation(int, vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPolyData");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkQuadricClusteringPyramid::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Number Of Levels: " << this->NumberOfLevels << "\n";
+  os << indent << "Number Of Divisions: (" << this->NumberOfDivisions[0] << ", "
+     << this->NumberOfDivisions[1] << ", " << this->NumberOfDivisions[2] << ")\n";
+  os << indent << "Auto Adjust Number Of Divisions: "
+     << (this->AutoAdjustNumberOfDivisions ? "On\n" : "Off\n");
+}
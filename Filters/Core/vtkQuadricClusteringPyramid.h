@@ -0,0 +1,119 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkQuadricClusteringPyramid.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkQuadricClusteringPyramid
+ * @brief   generate levels of detail of a mesh by quadric clustering
+ *
+ * vtkQuadricClusteringPyramid reduces a triangle mesh at several resolutions
+ * in a single execution, producing a pyramid of levels of detail. Each level
+ * is the output of the vertex clustering algorithm of vtkQuadricClustering:
+ * the space is divided in uniform bins, the error quadrics of the triangles
+ * are accumulated in the bins of their vertices, each bin used by the mesh is
+ * replaced by the point minimizing its quadric, and the triangles whose
+ * vertices lie in three different bins are kept.
+ *
+ * Level 0 uses NumberOfDivisions bins spanning the bounds of the input, as
+ * vtkQuadricClustering does with the same number of divisions. The bins of
+ * level k+1 are twice as large along each axis as those of level k, each bin
+ * merging 2x2x2 bins of the previous level, so that level k matches
+ * vtkQuadricClustering with the division origin at the lower corner of the
+ * input bounds and a division spacing of 2^k bins of level 0. The binning is
+ * shared by the levels: the points are hashed, and the quadrics of the
+ * triangles computed, once for all of them; the quadrics of the bins of a
+ * level are then the sums of the quadrics of their sub-bins. All the steps
+ * run in parallel with vtkSMPTools, and the output does not depend on the
+ * number of threads.
+ *
+ * The output is a vtkMultiBlockDataSet with one vtkPolyData per level, the
+ * finest first, named "Level k". The levels can be rendered by a
+ * vtkLODProp3D, with one mapper per block.
+ *
+ * @warning
+ * Only the polygons and triangle strips of the input are clustered, as with
+ * the UseInternalTriangles and PreventDuplicateCells options of
+ * vtkQuadricClustering turned on. Vertices and lines are ignored, and the
+ * options of vtkQuadricClustering related to feature edges, input points and
+ * cell data are not available. As with vtkQuadricClustering, polygons are
+ * triangulated with a fan from their first point.
+ *
+ * @sa
+ * vtkQuadricClustering vtkQuadricLODActor vtkLODProp3D
+ */
+
+#ifndef vtkQuadricClusteringPyramid_h
+#define vtkQuadricClusteringPyramid_h
+
+#include "vtkFiltersCoreModule.h" // For export macro
+#include "vtkMultiBlockDataSetAlgorithm.h"
+
+class VTKFILTERSCORE_EXPORT vtkQuadricClusteringPyramid : public vtkMultiBlockDataSetAlgorithm
+{
+public:
+  //@{
+  /**
+   * Standard instantiation, type and print methods.
+   */
+  static vtkQuadricClusteringPyramid* New();
+  vtkTypeMacro(vtkQuadricClusteringPyramid, vtkMultiBlockDataSetAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  //@}
+
+  //@{
+  /**
+   * Set/Get the number of levels of the pyramid. The default is 4.
+   */
+  vtkSetClampMacro(NumberOfLevels, int, 1, 16);
+  vtkGetMacro(NumberOfLevels, int);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the number of divisions along each axis of the bins of the
+   * finest level. The bins of each coarser level are twice as large, the
+   * number of divisions being rounded up. The default is 64 divisions along
+   * each axis.
+   */
+  vtkSetVector3Macro(NumberOfDivisions, int);
+  vtkGetVector3Macro(NumberOfDivisions, int);
+  //@}
+
+  //@{
+  /**
+   * Enable automatic adjustment of the number of divisions of the finest
+   * level when the input has few points, as in vtkQuadricClustering. The
+   * default is On.
+   */
+  vtkSetMacro(AutoAdjustNumberOfDivisions, vtkTypeBool);
+  vtkGetMacro(AutoAdjustNumberOfDivisions, vtkTypeBool);
+  vtkBooleanMacro(AutoAdjustNumberOfDivisions, vtkTypeBool);
+  //@}
+
+protected:
+  vtkQuadricClusteringPyramid();
+  ~vtkQuadricClusteringPyramid() override = default;
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+
+  int NumberOfLevels;
+  int NumberOfDivisions[3];
+  vtkTypeBool AutoAdjustNumberOfDivisions;
+
+private:
+  vtkQuadricClusteringPyramid(const vtkQuadricClusteringPyramid&) = delete;
+  void operator=(const vtkQuadricClusteringPyramid&) = delete;
+};
+
+#endif
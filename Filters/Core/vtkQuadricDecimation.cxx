@@ -41,6 +41,7 @@
 
 #include "vtkQuadricDecimation.h"
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkDoubleArray.h"
 #include "vtkEdgeTable.h"
@@ -53,10 +54,64 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkTriangle.h"
 
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <vector>
+
 vtkStandardNewMacro(vtkQuadricDecimation);
 
+namespace
+{
+// Split the cells listed in [begin, end) in numParts partitions of about the
+// same size, by recursive bisection of their centers along the longest axis
+// of their bounds. The offset in cellIds of the first cell of each partition
+// is stored in partOffsets.
+void BisectCells(const double* centers, vtkIdType* begin, vtkIdType* end, int numParts,
+  vtkIdType* partOffsets, const vtkIdType* cellIds)
+{
+  if (numParts < 2)
+  {
+    partOffsets[0] = begin - cellIds;
+    return;
+  }
+
+  double bounds[6] = { VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX,
+    VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+  for (const vtkIdType* cellId = begin; cellId != end; ++cellId)
+  {
+    const double* center = centers + 3 * *cellId;
+    for (int j = 0; j < 3; j++)
+    {
+      bounds[2 * j] = std::min(bounds[2 * j], center[j]);
+      bounds[2 * j + 1] = std::max(bounds[2 * j + 1], center[j]);
+    }
+  }
+  int axis = 0;
+  for (int j = 1; j < 3; j++)
+  {
+    if (bounds[2 * j + 1] - bounds[2 * j] > bounds[2 * axis + 1] - bounds[2 * axis])
+    {
+      axis = j;
+    }
+  }
+
+  const int numLeftParts = numParts / 2;
+  vtkIdType* middle = begin + (end - begin) * numLeftParts / numParts;
+  std::nth_element(begin, middle, end, [centers, axis](vtkIdType a, vtkIdType b) {
+    return centers[3 * a + axis] < centers[3 * b + axis];
+  });
+  BisectCells(centers, begin, middle, numLeftParts, partOffsets, cellIds);
+  BisectCells(centers, middle, end, numParts - numLeftParts, partOffsets + numLeftParts, cellIds);
+}
+}
+
 //----------------------------------------------------------------------------
 vtkQuadricDecimation::vtkQuadricDecimation()
 {
@@ -87,6 +142,7 @@ vtkQuadricDecimation::vtkQuadricDecimation()
   this->TensorsWeight = 0.1;
 
   this->ActualReduction = 0.0;
+  this->NumberOfPartitions = 1;
 }
 
 //----------------------------------------------------------------------------
@@ -187,18 +243,12 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
 
   vtkIdType numPts = input->GetNumberOfPoints();
   vtkIdType numTris = input->GetNumberOfPolys();
-  vtkIdType edgeId, i;
-  int j;
-  double cost;
-  double* x;
+  vtkIdType i;
   vtkCellArray* polys;
   vtkDataArray* attrib;
   vtkPoints* points;
   vtkPointData* pointData;
-  vtkIdType endPtIds[2];
   vtkIdList* outputCellList;
-  vtkIdType npts;
-  const vtkIdType* pts;
   vtkIdType numDeletedTris = 0;
 
   // check some assumptions about the data
@@ -248,6 +298,85 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
+  this->NumberOfComponents = 0;
+  if (this->AttributeErrorMetric)
+  {
+    this->ComputeNumberOfComponents();
+  }
+
+  vtkDebugMacro(<< "Computing Quadrics");
+  this->InitializeQuadrics(numPts);
+  this->AddBoundaryConstraints();
+  this->UpdateProgress(0.05);
+
+  this->ActualReduction = 0.0;
+  this->NumberOfEdgeCollapses = 0;
+  if (this->NumberOfPartitions > 1 && numTris > 0)
+  {
+    vtkDebugMacro(<< "Decimating " << this->NumberOfPartitions << " partitions");
+    numDeletedTris = this->DecimatePartitions();
+  }
+
+  // Okay collapse edges until desired reduction is reached
+  this->DecimateMesh(numTris, numDeletedTris, nullptr);
+
+  // clean up working data
+  for (i = 0; i < numPts; i++)
+  {
+    delete[] this->ErrorQuadrics[i].Quadric;
+  }
+  delete[] this->ErrorQuadrics;
+
+  if (this->VolumePreservation)
+    delete[] this->VolumeConstraints;
+
+  // copy the simplified mesh from the working mesh to the output mesh
+  for (i = 0; i < this->Mesh->GetNumberOfCells(); i++)
+  {
+    if (this->Mesh->GetCell(i)->GetCellType() != VTK_EMPTY_CELL)
+    {
+      outputCellList->InsertNextId(i);
+    }
+  }
+
+  output->Reset();
+  output->AllocateCopy(this->Mesh);
+  output->GetPointData()->CopyAllocate(this->Mesh->GetPointData(), 1);
+  output->CopyCells(this->Mesh, outputCellList);
+
+  this->Mesh->DeleteLinks();
+  this->Mesh->Delete();
+  outputCellList->Delete();
+
+  // renormalize, clamp attributes
+  if (this->AttributeErrorMetric)
+  {
+    if (nullptr != (attrib = output->GetPointData()->GetNormals()))
+    {
+      for (i = 0; i < attrib->GetNumberOfTuples(); i++)
+      {
+        vtkMath::Normalize(attrib->GetTuple3(i));
+      }
+    }
+    // might want to add clamping texture coordinates??
+  }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkQuadricDecimation::DecimateMesh(
+  vtkIdType numTris, vtkIdType numDeletedTris, const unsigned char* lockedPoints)
+{
+  vtkIdType numPts = this->Mesh->GetNumberOfPoints();
+  vtkIdType edgeId, i;
+  int j;
+  double cost;
+  double* x;
+  vtkIdType endPtIds[2];
+  vtkIdType npts;
+  const vtkIdType* pts;
+
   vtkDebugMacro(<< "Computing Edges");
   this->Edges->InitEdgeInsertion(numPts, 1); // storing edge id as attribute
   this->EdgeCosts->Allocate(this->Mesh->GetPolys()->GetNumberOfCells() * 3);
@@ -272,11 +401,6 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
 
   this->UpdateProgress(0.1);
 
-  this->NumberOfComponents = 0;
-  if (this->AttributeErrorMetric)
-  {
-    this->ComputeNumberOfComponents();
-  }
   x = new double[3 + this->NumberOfComponents + this->VolumePreservation];
   this->CollapseCellIds = vtkIdList::New();
   this->TempX = new double[3 + this->NumberOfComponents + this->VolumePreservation];
@@ -293,11 +417,6 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   this->TargetPoints->SetNumberOfComponents(
     3 + this->NumberOfComponents + this->VolumePreservation);
 
-  vtkDebugMacro(<< "Computing Quadrics");
-  this->InitializeQuadrics(numPts);
-  this->AddBoundaryConstraints();
-  this->UpdateProgress(0.15);
-
   vtkDebugMacro(<< "Computing Costs");
   // Compute the cost of and target point for collapsing each edge.
   for (i = 0; i < this->Edges->GetNumberOfEdges(); i++)
@@ -316,8 +435,7 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   this->UpdateProgress(0.20);
 
   // Okay collapse edges until desired reduction is reached
-  this->ActualReduction = 0.0;
-  this->NumberOfEdgeCollapses = 0;
+  this->ActualReduction = numTris > 0 ? (double)numDeletedTris / numTris : 0.0;
   edgeId = this->EdgeCosts->Pop(0, cost);
 
   int abort = 0;
@@ -333,6 +451,14 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
 
     endPtIds[0] = this->EndPoint1List->GetId(edgeId);
     endPtIds[1] = this->EndPoint2List->GetId(edgeId);
+
+    // the edges of the locked points are dropped
+    if (lockedPoints && (lockedPoints[endPtIds[0]] || lockedPoints[endPtIds[1]]))
+    {
+      edgeId = this->EdgeCosts->Pop(0, cost);
+      continue;
+    }
+
     this->TargetPoints->GetTuple(edgeId, x);
 
     // check for a poorly placed point
@@ -367,15 +493,6 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   vtkDebugMacro(<< "Number Of Edge Collapses: " << this->NumberOfEdgeCollapses
                 << " Cost: " << cost);
 
-  // clean up working data
-  for (i = 0; i < numPts; i++)
-  {
-    delete[] this->ErrorQuadrics[i].Quadric;
-  }
-  delete[] this->ErrorQuadrics;
-
-  if (this->VolumePreservation)
-    delete[] this->VolumeConstraints;
   delete[] x;
   this->CollapseCellIds->Delete();
   delete[] this->TempX;
@@ -384,78 +501,285 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   delete[] this->TempA;
   delete[] this->TempData;
 
-  // copy the simplified mesh from the working mesh to the output mesh
-  for (i = 0; i < this->Mesh->GetNumberOfCells(); i++)
+  return numDeletedTris;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkQuadricDecimation::DecimatePartitions()
+{
+  vtkPolyData* mesh = this->Mesh;
+  vtkCellArray* polys = mesh->GetPolys();
+  const vtkIdType numPts = mesh->GetNumberOfPoints();
+  const vtkIdType numTris = polys->GetNumberOfCells();
+  const int numParts = static_cast<int>(std::min<vtkIdType>(this->NumberOfPartitions, numTris));
+  const int numTerms = 11 + 4 * this->NumberOfComponents;
+  const int numValues = 3 + this->NumberOfComponents;
+
+  // Split the triangles in partitions of about the same size, by recursive
+  // bisection of their centers.
+  std::vector<double> centers(3 * numTris);
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> iterators;
+  vtkSMPTools::For(0, numTris, [&](vtkIdType cellId, vtkIdType endCellId) {
+    vtkSmartPointer<vtkCellArrayIterator>& iter = iterators.Local();
+    if (!iter)
+    {
+      iter = vtk::TakeSmartPointer(polys->NewIterator());
+    }
+    vtkIdType npts;
+    const vtkIdType* pts;
+    double x[3];
+    for (; cellId < endCellId; cellId++)
+    {
+      iter->GetCellAtId(cellId, npts, pts);
+      double* center = centers.data() + 3 * cellId;
+      center[0] = center[1] = center[2] = 0.0;
+      for (vtkIdType i = 0; i < npts; i++)
+      {
+        mesh->GetPoint(pts[i], x);
+        for (int j = 0; j < 3; j++)
+        {
+          center[j] += x[j] / npts;
+        }
+      }
+    }
+  });
+  std::vector<vtkIdType> partCells(numTris);
+  std::iota(partCells.begin(), partCells.end(), 0);
+  std::vector<vtkIdType> partOffsets(numParts + 1);
+  BisectCells(centers.data(), partCells.data(), partCells.data() + numTris, numParts,
+    partOffsets.data(), partCells.data());
+  partOffsets[numParts] = numTris;
+  std::vector<int> cellParts(numTris);
+  for (int part = 0; part < numParts; part++)
   {
-    if (this->Mesh->GetCell(i)->GetCellType() != VTK_EMPTY_CELL)
+    for (vtkIdType i = partOffsets[part]; i < partOffsets[part + 1]; i++)
     {
-      outputCellList->InsertNextId(i);
+      cellParts[partCells[i]] = part;
     }
   }
 
-  output->Reset();
-  output->AllocateCopy(this->Mesh);
-  output->GetPointData()->CopyAllocate(this->Mesh->GetPointData(), 1);
-  output->CopyCells(this->Mesh, outputCellList);
+  // The points used by several partitions are locked.
+  std::vector<unsigned char> sharedPoints(numPts, 0);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    vtkIdType ncells, *cells;
+    for (; ptId < endPtId; ptId++)
+    {
+      mesh->GetPointCells(ptId, ncells, cells);
+      for (vtkIdType k = 1; k < ncells; k++)
+      {
+        if (cellParts[cells[k]] != cellParts[cells[0]])
+        {
+          sharedPoints[ptId] = 1;
+          break;
+        }
+      }
+    }
+  });
+
+  // Decimate each partition with a filter of its own, on a copy of its
+  // triangles, points and quadrics, then copy the moved points and merged
+  // quadrics back. Only the shared points, which are left untouched, are
+  // copied in several partitions.
+  std::vector<std::vector<vtkIdType>> remainingTris(numParts);
+  std::vector<vtkIdType> numDeletedTris(numParts, 0);
+  std::vector<int> numCollapses(numParts, 0);
+  vtkSMPTools::For(0, numParts, 1, [&](vtkIdType part, vtkIdType endPart) {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    vtkIdType localPts[3];
+    std::vector<double> x(numValues);
+    auto iter = vtk::TakeSmartPointer(polys->NewIterator());
+    for (; part < endPart; part++)
+    {
+      const vtkIdType* cells = partCells.data() + partOffsets[part];
+      const vtkIdType numLocalTris = partOffsets[part + 1] - partOffsets[part];
+
+      // the points of the partition, sorted so that their local ids are
+      // found by bisection
+      std::vector<vtkIdType> pointIds;
+      pointIds.reserve(numLocalTris);
+      for (vtkIdType i = 0; i < numLocalTris; i++)
+      {
+        iter->GetCellAtId(cells[i], npts, pts);
+        pointIds.insert(pointIds.end(), pts, pts + npts);
+      }
+      std::sort(pointIds.begin(), pointIds.end());
+      pointIds.erase(std::unique(pointIds.begin(), pointIds.end()), pointIds.end());
+      const vtkIdType numLocalPts = static_cast<vtkIdType>(pointIds.size());
+      auto localId = [&pointIds](vtkIdType ptId) {
+        return static_cast<vtkIdType>(
+          std::lower_bound(pointIds.begin(), pointIds.end(), ptId) - pointIds.begin());
+      };
+
+      vtkNew<vtkQuadricDecimation> decimate;
+      decimate->TargetReduction = this->TargetReduction;
+      decimate->AttributeErrorMetric = this->AttributeErrorMetric;
+      decimate->VolumePreservation = this->VolumePreservation;
+      decimate->NumberOfComponents = this->NumberOfComponents;
+      std::copy(this->AttributeComponents, this->AttributeComponents + 6,
+        decimate->AttributeComponents);
+      std::copy(this->AttributeScale, this->AttributeScale + 6, decimate->AttributeScale);
+
+      vtkNew<vtkPoints> localPoints;
+      localPoints->SetDataType(mesh->GetPoints()->GetDataType());
+      localPoints->SetNumberOfPoints(numLocalPts);
+      std::vector<unsigned char> lockedPoints(numLocalPts);
+      decimate->ErrorQuadrics = new vtkQuadricDecimation::ErrorQuadric[numLocalPts];
+      decimate->VolumeConstraints =
+        this->VolumePreservation ? new double[numLocalPts * 4] : nullptr;
+      for (vtkIdType i = 0; i < numLocalPts; i++)
+      {
+        const vtkIdType ptId = pointIds[i];
+        mesh->GetPoint(ptId, x.data());
+        localPoints->SetPoint(i, x.data());
+        lockedPoints[i] = sharedPoints[ptId];
+        const double* quadric = this->ErrorQuadrics[ptId].Quadric;
+        decimate->ErrorQuadrics[i].Quadric = new double[numTerms];
+        std::copy(quadric, quadric + numTerms, decimate->ErrorQuadrics[i].Quadric);
+        if (this->VolumePreservation)
+        {
+          std::copy(this->VolumeConstraints + 4 * ptId, this->VolumeConstraints + 4 * ptId + 4,
+            decimate->VolumeConstraints + 4 * i);
+        }
+      }
 
-  this->Mesh->DeleteLinks();
-  this->Mesh->Delete();
-  outputCellList->Delete();
+      // the triangles using a locked point are left to the final pass
+      vtkNew<vtkCellArray> localPolys;
+      localPolys->AllocateExact(numLocalTris, 3 * numLocalTris);
+      vtkIdType numFreeTris = 0;
+      for (vtkIdType i = 0; i < numLocalTris; i++)
+      {
+        iter->GetCellAtId(cells[i], npts, pts);
+        bool free = true;
+        for (vtkIdType j = 0; j < npts; j++)
+        {
+          localPts[j] = localId(pts[j]);
+          free = free && !sharedPoints[pts[j]];
+        }
+        localPolys->InsertNextCell(npts, localPts);
+        numFreeTris += free ? 1 : 0;
+      }
 
-  // renormalize, clamp attributes
-  if (this->AttributeErrorMetric)
-  {
-    if (nullptr != (attrib = output->GetPointData()->GetNormals()))
-    {
-      for (i = 0; i < attrib->GetNumberOfTuples(); i++)
+      decimate->Mesh = vtkPolyData::New();
+      decimate->Mesh->SetPoints(localPoints);
+      decimate->Mesh->SetPolys(localPolys);
+      if (this->AttributeErrorMetric)
       {
-        vtkMath::Normalize(attrib->GetTuple3(i));
+        // the attributes in the error metric, in the order of their components
+        vtkPointData* pd = mesh->GetPointData();
+        for (int attr = 0; attr < 5; attr++)
+        {
+          if (this->AttributeComponents[attr] == (attr ? this->AttributeComponents[attr - 1] : 0))
+          {
+            continue;
+          }
+          vtkDataArray* array = pd->GetAttribute(attr);
+          auto localArray = vtk::TakeSmartPointer(array->NewInstance());
+          localArray->SetNumberOfComponents(array->GetNumberOfComponents());
+          localArray->SetNumberOfTuples(numLocalPts);
+          for (vtkIdType i = 0; i < numLocalPts; i++)
+          {
+            localArray->SetTuple(i, pointIds[i], array);
+          }
+          decimate->Mesh->GetPointData()->SetAttribute(localArray, attr);
+        }
       }
+      decimate->Mesh->BuildCells();
+      decimate->Mesh->BuildLinks();
+
+      if (numFreeTris > 0)
+      {
+        numDeletedTris[part] = decimate->DecimateMesh(numFreeTris, 0, lockedPoints.data());
+      }
+      numCollapses[part] = decimate->NumberOfEdgeCollapses;
+
+      for (vtkIdType i = 0; i < numLocalPts; i++)
+      {
+        if (!lockedPoints[i])
+        {
+          const vtkIdType ptId = pointIds[i];
+          decimate->GetPointAttributeArray(i, x.data());
+          this->SetPointAttributeArray(ptId, x.data());
+          const double* quadric = decimate->ErrorQuadrics[i].Quadric;
+          std::copy(quadric, quadric + numTerms, this->ErrorQuadrics[ptId].Quadric);
+          if (this->VolumePreservation)
+          {
+            std::copy(decimate->VolumeConstraints + 4 * i, decimate->VolumeConstraints + 4 * i + 4,
+              this->VolumeConstraints + 4 * ptId);
+          }
+        }
+        delete[] decimate->ErrorQuadrics[i].Quadric;
+      }
+      delete[] decimate->ErrorQuadrics;
+      delete[] decimate->VolumeConstraints;
+
+      std::vector<vtkIdType>& remaining = remainingTris[part];
+      for (vtkIdType i = 0; i < numLocalTris; i++)
+      {
+        if (decimate->Mesh->GetCellType(i) != VTK_EMPTY_CELL)
+        {
+          decimate->Mesh->GetCellPoints(i, npts, pts);
+          for (vtkIdType j = 0; j < npts; j++)
+          {
+            remaining.push_back(pointIds[pts[j]]);
+          }
+        }
+      }
+      decimate->Mesh->DeleteLinks();
+      decimate->Mesh->Delete();
+      decimate->Mesh = nullptr;
     }
-    // might want to add clamping texture coordinates??
+  });
+
+  // the remaining triangles, partition after partition
+  vtkIdType numRemainingIds = 0;
+  vtkIdType numDeleted = 0;
+  for (int part = 0; part < numParts; part++)
+  {
+    numRemainingIds += static_cast<vtkIdType>(remainingTris[part].size());
+    numDeleted += numDeletedTris[part];
+    this->NumberOfEdgeCollapses += numCollapses[part];
   }
+  vtkNew<vtkCellArray> newPolys;
+  newPolys->AllocateExact(numRemainingIds / 3, numRemainingIds);
+  for (int part = 0; part < numParts; part++)
+  {
+    const std::vector<vtkIdType>& remaining = remainingTris[part];
+    for (size_t i = 0; i < remaining.size(); i += 3)
+    {
+      newPolys->InsertNextCell(3, remaining.data() + i);
+    }
+  }
+  mesh->SetPolys(newPolys);
+  mesh->BuildCells();
+  mesh->BuildLinks();
 
-  return 1;
+  vtkDebugMacro(<< "Deleted " << numDeleted << " triangles in " << numParts << " partitions");
+  return numDeleted;
 }
 
 //----------------------------------------------------------------------------
 void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
 {
   vtkPolyData* input = this->Mesh;
-  double* QEM;
-  vtkIdType ptId;
-  int i, j;
-  vtkCellArray* polys;
-  vtkIdType npts;
-  const vtkIdType* pts = nullptr;
-  double point0[3], point1[3], point2[3];
-  double n[3];
-  double tempP1[3], tempP2[3], d, triArea2;
-  double data[16];
-  double *A[4], x[4];
-  int index[4];
-  A[0] = data;
-  A[1] = data + 4;
-  A[2] = data + 8;
-  A[3] = data + 12;
-
-  // allocate local QEM sparse matrix
-  QEM = new double[11 + 4 * this->NumberOfComponents];
-
-  // clear and allocate global QEM array
-  for (ptId = 0; ptId < numPts; ptId++)
-  {
-    this->ErrorQuadrics[ptId].Quadric = new double[11 + 4 * this->NumberOfComponents];
-    for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
-    {
-      this->ErrorQuadrics[ptId].Quadric[i] = 0.0;
-    }
-  }
+  vtkCellArray* polys = input->GetPolys();
+  const int numTerms = 11 + 4 * this->NumberOfComponents;
+  std::atomic<bool> factorFailed(false);
+
+  // compute the QEM of a face, and its normal and plane offset; return half
+  // the area of the face
+  auto computeFaceQuadric = [&](const vtkIdType* pts, double* QEM, double n[3], double& d) {
+    int i;
+    double point0[3], point1[3], point2[3];
+    double tempP1[3], tempP2[3], triArea2;
+    double data[16];
+    double *A[4], x[4];
+    int index[4];
+    A[0] = data;
+    A[1] = data + 4;
+    A[2] = data + 8;
+    A[3] = data + 12;
 
-  polys = input->GetPolys();
-  // compute the QEM for each face
-  for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
-  {
     input->GetPoint(pts[0], point0);
     input->GetPoint(pts[1], point1);
     input->GetPoint(pts[2], point2);
@@ -488,220 +812,301 @@ void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
     QEM[9] = d * d;
     QEM[10] = 1;
 
-    if (this->AttributeErrorMetric)
-    {
-      for (i = 0; i < 3; i++)
+      if (this->AttributeErrorMetric)
       {
-        A[0][i] = point0[i];
-        A[1][i] = point1[i];
-        A[2][i] = point2[i];
-        A[3][i] = n[i];
-      }
-      A[0][3] = A[1][3] = A[2][3] = 1;
-      A[3][3] = 0;
+        for (i = 0; i < 3; i++)
+        {
+          A[0][i] = point0[i];
+          A[1][i] = point1[i];
+          A[2][i] = point2[i];
+          A[3][i] = n[i];
+        }
+        A[0][3] = A[1][3] = A[2][3] = 1;
+        A[3][3] = 0;
 
-      // should handle poorly condition matrix better
-      if (vtkMath::LUFactorLinearSystem(A, index, 4))
-      {
-        for (i = 0; i < this->NumberOfComponents; i++)
+        // should handle poorly condition matrix better
+        if (vtkMath::LUFactorLinearSystem(A, index, 4))
         {
-          x[3] = 0;
-          if (i < this->AttributeComponents[0])
-          {
-            x[0] = input->GetPointData()->GetScalars()->GetComponent(pts[0], i) *
-              this->AttributeScale[0];
-            x[1] = input->GetPointData()->GetScalars()->GetComponent(pts[1], i) *
-              this->AttributeScale[0];
-            x[2] = input->GetPointData()->GetScalars()->GetComponent(pts[2], i) *
-              this->AttributeScale[0];
-          }
-          else if (i < this->AttributeComponents[1])
+          for (i = 0; i < this->NumberOfComponents; i++)
           {
-            x[0] = input->GetPointData()->GetVectors()->GetComponent(
-                     pts[0], i - this->AttributeComponents[0]) *
-              this->AttributeScale[1];
-            x[1] = input->GetPointData()->GetVectors()->GetComponent(
-                     pts[1], i - this->AttributeComponents[0]) *
-              this->AttributeScale[1];
-            x[2] = input->GetPointData()->GetVectors()->GetComponent(
-                     pts[2], i - this->AttributeComponents[0]) *
-              this->AttributeScale[1];
+            x[3] = 0;
+            if (i < this->AttributeComponents[0])
+            {
+              x[0] = input->GetPointData()->GetScalars()->GetComponent(pts[0], i) *
+                this->AttributeScale[0];
+              x[1] = input->GetPointData()->GetScalars()->GetComponent(pts[1], i) *
+                this->AttributeScale[0];
+              x[2] = input->GetPointData()->GetScalars()->GetComponent(pts[2], i) *
+                this->AttributeScale[0];
+            }
+            else if (i < this->AttributeComponents[1])
+            {
+              x[0] = input->GetPointData()->GetVectors()->GetComponent(
+                       pts[0], i - this->AttributeComponents[0]) *
+                this->AttributeScale[1];
+              x[1] = input->GetPointData()->GetVectors()->GetComponent(
+                       pts[1], i - this->AttributeComponents[0]) *
+                this->AttributeScale[1];
+              x[2] = input->GetPointData()->GetVectors()->GetComponent(
+                       pts[2], i - this->AttributeComponents[0]) *
+                this->AttributeScale[1];
+            }
+            else if (i < this->AttributeComponents[2])
+            {
+              x[0] = input->GetPointData()->GetNormals()->GetComponent(
+                       pts[0], i - this->AttributeComponents[1]) *
+                this->AttributeScale[2];
+              x[1] = input->GetPointData()->GetNormals()->GetComponent(
+                       pts[1], i - this->AttributeComponents[1]) *
+                this->AttributeScale[2];
+              x[2] = input->GetPointData()->GetNormals()->GetComponent(
+                       pts[2], i - this->AttributeComponents[1]) *
+                this->AttributeScale[2];
+            }
+            else if (i < this->AttributeComponents[3])
+            {
+              x[0] = input->GetPointData()->GetTCoords()->GetComponent(
+                       pts[0], i - this->AttributeComponents[2]) *
+                this->AttributeScale[3];
+              x[1] = input->GetPointData()->GetTCoords()->GetComponent(
+                       pts[1], i - this->AttributeComponents[2]) *
+                this->AttributeScale[3];
+              x[2] = input->GetPointData()->GetTCoords()->GetComponent(
+                       pts[2], i - this->AttributeComponents[2]) *
+                this->AttributeScale[3];
+            }
+            else if (i < this->AttributeComponents[4])
+            {
+              x[0] = input->GetPointData()->GetTensors()->GetComponent(
+                       pts[0], i - this->AttributeComponents[3]) *
+                this->AttributeScale[4];
+              x[1] = input->GetPointData()->GetTensors()->GetComponent(
+                       pts[1], i - this->AttributeComponents[3]) *
+                this->AttributeScale[4];
+              x[2] = input->GetPointData()->GetTensors()->GetComponent(
+                       pts[2], i - this->AttributeComponents[3]) *
+                this->AttributeScale[4];
+            }
+            vtkMath::LUSolveLinearSystem(A, index, x, 4);
+
+            // add in the contribution of this element into the QEM
+            QEM[0] += x[0] * x[0];
+            QEM[1] += x[0] * x[1];
+            QEM[2] += x[0] * x[2];
+            QEM[3] += x[3] * x[0];
+
+            QEM[4] += x[1] * x[1];
+            QEM[5] += x[1] * x[2];
+            QEM[6] += x[3] * x[1];
+
+            QEM[7] += x[2] * x[2];
+            QEM[8] += x[3] * x[2];
+
+            QEM[9] += x[3] * x[3];
+
+            QEM[11 + i * 4] = -x[0];
+            QEM[12 + i * 4] = -x[1];
+            QEM[13 + i * 4] = -x[2];
+            QEM[14 + i * 4] = -x[3];
           }
-          else if (i < this->AttributeComponents[2])
-          {
-            x[0] = input->GetPointData()->GetNormals()->GetComponent(
-                     pts[0], i - this->AttributeComponents[1]) *
-              this->AttributeScale[2];
-            x[1] = input->GetPointData()->GetNormals()->GetComponent(
-                     pts[1], i - this->AttributeComponents[1]) *
-              this->AttributeScale[2];
-            x[2] = input->GetPointData()->GetNormals()->GetComponent(
-                     pts[2], i - this->AttributeComponents[1]) *
-              this->AttributeScale[2];
-          }
-          else if (i < this->AttributeComponents[3])
-          {
-            x[0] = input->GetPointData()->GetTCoords()->GetComponent(
-                     pts[0], i - this->AttributeComponents[2]) *
-              this->AttributeScale[3];
-            x[1] = input->GetPointData()->GetTCoords()->GetComponent(
-                     pts[1], i - this->AttributeComponents[2]) *
-              this->AttributeScale[3];
-            x[2] = input->GetPointData()->GetTCoords()->GetComponent(
-                     pts[2], i - this->AttributeComponents[2]) *
-              this->AttributeScale[3];
-          }
-          else if (i < this->AttributeComponents[4])
-          {
-            x[0] = input->GetPointData()->GetTensors()->GetComponent(
-                     pts[0], i - this->AttributeComponents[3]) *
-              this->AttributeScale[4];
-            x[1] = input->GetPointData()->GetTensors()->GetComponent(
-                     pts[1], i - this->AttributeComponents[3]) *
-              this->AttributeScale[4];
-            x[2] = input->GetPointData()->GetTensors()->GetComponent(
-                     pts[2], i - this->AttributeComponents[3]) *
-              this->AttributeScale[4];
-          }
-          vtkMath::LUSolveLinearSystem(A, index, x, 4);
-
-          // add in the contribution of this element into the QEM
-          QEM[0] += x[0] * x[0];
-          QEM[1] += x[0] * x[1];
-          QEM[2] += x[0] * x[2];
-          QEM[3] += x[3] * x[0];
-
-          QEM[4] += x[1] * x[1];
-          QEM[5] += x[1] * x[2];
-          QEM[6] += x[3] * x[1];
-
-          QEM[7] += x[2] * x[2];
-          QEM[8] += x[3] * x[2];
-
-          QEM[9] += x[3] * x[3];
-
-          QEM[11 + i * 4] = -x[0];
-          QEM[12 + i * 4] = -x[1];
-          QEM[13 + i * 4] = -x[2];
-          QEM[14 + i * 4] = -x[3];
+        }
+        else
+        {
+          factorFailed = true;
+          std::fill(QEM + 11, QEM + numTerms, 0.0);
         }
       }
-      else
-      {
-        vtkErrorMacro(<< "Unable to factor attribute matrix!");
-      }
+
+    return triArea2;
+  };
+
+  // The quadric of a point sums the QEM of the faces using it, which are
+  // listed by increasing id by the links: they are added in the order of a
+  // traversal of the faces whatever the number of threads. The QEM of each
+  // face is thus computed for each of its points, but without any storage
+  // or synchronization.
+  const std::vector<double> exemplar(numTerms);
+  vtkSMPThreadLocal<std::vector<double>> localQEM(exemplar);
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> iterators;
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    double* QEM = localQEM.Local().data();
+    vtkSmartPointer<vtkCellArrayIterator>& iter = iterators.Local();
+    if (!iter)
+    {
+      iter = vtk::TakeSmartPointer(polys->NewIterator());
     }
+    vtkIdType ncells, *cells;
+    vtkIdType npts;
+    const vtkIdType* pts;
+    double n[3], d, triArea2;
+    int i, j;
 
-    // add the QEM to all points of the face
-    for (i = 0; i < 3; i++)
+    for (; ptId < endPtId; ptId++)
     {
-      for (j = 0; j < 11 + 4 * this->NumberOfComponents; j++)
-      {
-        this->ErrorQuadrics[pts[i]].Quadric[j] += QEM[j] * triArea2;
-      }
+      // clear and allocate the QEM of the point
+      double* quadric = new double[numTerms];
+      std::fill(quadric, quadric + numTerms, 0.0);
+      this->ErrorQuadrics[ptId].Quadric = quadric;
 
-      // Set volume constraint values g_vol and d_vol
-      if (this->VolumePreservation)
+      input->GetPointCells(ptId, ncells, cells);
+      for (vtkIdType k = 0; k < ncells; k++)
       {
-        // Vector g_vol
-        for (j = 0; j < 3; j++)
+        // a face using the point several times is listed as many times
+        if (k > 0 && cells[k] == cells[k - 1])
         {
-          this->VolumeConstraints[pts[i] * 4 + j] +=
-            n[j] * triArea2 * 2.0; // triangle normal with length triArea * 2
+          continue;
+        }
+        iter->GetCellAtId(cells[k], npts, pts);
+        triArea2 = computeFaceQuadric(pts, QEM, n, d);
+
+        // add the QEM of the face for each use of the point
+        for (i = 0; i < 3; i++)
+        {
+          if (pts[i] != ptId)
+          {
+            continue;
+          }
+          for (j = 0; j < numTerms; j++)
+          {
+            quadric[j] += QEM[j] * triArea2;
+          }
+
+          // Set volume constraint values g_vol and d_vol
+          if (this->VolumePreservation)
+          {
+            // Vector g_vol
+            for (j = 0; j < 3; j++)
+            {
+              this->VolumeConstraints[ptId * 4 + j] +=
+                n[j] * triArea2 * 2.0; // triangle normal with length triArea * 2
+            }
+            // Scalar d_vol
+            this->VolumeConstraints[ptId * 4 + 3] +=
+              -d * triArea2 * 2.0; // (triangle normal with length triArea * 2) * (pts[0] position)
+          }
         }
-        // Scalar d_vol
-        this->VolumeConstraints[pts[i] * 4 + 3] +=
-          -d * triArea2 * 2.0; // (triangle normal with length triArea * 2) * (pts[0] position)
       }
-    }
-  } // for all triangles
+    } // for all points
+  });
 
-  delete[] QEM;
+  if (factorFailed)
+  {
+    vtkErrorMacro(<< "Unable to factor attribute matrix!");
+  }
 }
 
+//----------------------------------------------------------------------------
 void vtkQuadricDecimation::AddBoundaryConstraints()
 {
   vtkPolyData* input = this->Mesh;
-  double* QEM;
-  vtkIdType cellId;
-  int i, j;
-  vtkIdType npts;
-  const vtkIdType* pts;
-  double t0[3], t1[3], t2[3];
-  double e0[3], e1[3], n[3], c, d, w;
-  vtkIdList* cellIds = vtkIdList::New();
-
-  // allocate local QEM space matrix
-  QEM = new double[11 + 4 * this->NumberOfComponents];
-
-  for (cellId = 0; cellId < input->GetNumberOfCells(); cellId++)
-  {
-    input->GetCellPoints(cellId, npts, pts);
-
-    for (i = 0; i < 3; i++)
+  vtkCellArray* polys = input->GetPolys();
+
+  // As for the faces, the boundary edges are visited through the links, in
+  // the order of a traversal of the faces, and their QEM added to each of
+  // their end points.
+  vtkSMPThreadLocalObject<vtkIdList> cellIdLists;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> iterators;
+  vtkSMPTools::For(0, input->GetNumberOfPoints(), [&](vtkIdType ptId, vtkIdType endPtId) {
+    vtkIdList* cellIds = cellIdLists.Local();
+    vtkSmartPointer<vtkCellArrayIterator>& iter = iterators.Local();
+    if (!iter)
     {
-      input->GetCellEdgeNeighbors(cellId, pts[i], pts[(i + 1) % 3], cellIds);
-      if (cellIds->GetNumberOfIds() == 0)
+      iter = vtk::TakeSmartPointer(polys->NewIterator());
+    }
+    double QEM[11];
+    vtkIdType ncells, *cells;
+    int i, j;
+    vtkIdType npts;
+    const vtkIdType* pts;
+    double t0[3], t1[3], t2[3];
+    double e0[3], e1[3], n[3], c, d, w;
+
+    for (; ptId < endPtId; ptId++)
+    {
+      double* quadric = this->ErrorQuadrics[ptId].Quadric;
+      input->GetPointCells(ptId, ncells, cells);
+      for (vtkIdType k = 0; k < ncells; k++)
       {
-        // this is a boundary
-        input->GetPoint(pts[(i + 2) % 3], t0);
-        input->GetPoint(pts[i], t1);
-        input->GetPoint(pts[(i + 1) % 3], t2);
-
-        // computing a plane which is orthogonal to line t1, t2 and incident
-        // with it
-        for (j = 0; j < 3; j++)
+        if (k > 0 && cells[k] == cells[k - 1])
         {
-          e0[j] = t2[j] - t1[j];
-        }
-        for (j = 0; j < 3; j++)
-        {
-          e1[j] = t0[j] - t1[j];
+          continue;
         }
+        iter->GetCellAtId(cells[k], npts, pts);
 
-        // compute n so that it is orthogonal to e0 and parallel to the
-        // triangle
-        c = vtkMath::Dot(e0, e1) / (e0[0] * e0[0] + e0[1] * e0[1] + e0[2] * e0[2]);
-        for (j = 0; j < 3; j++)
+        for (i = 0; i < 3; i++)
         {
-          n[j] = e1[j] - c * e0[j];
-        }
-        vtkMath::Normalize(n);
-        d = -vtkMath::Dot(n, t1);
-        w = vtkMath::Norm(e0);
-
-        // w *= w;
-        // area issue ??
-        // could possible add in angle weights??
-        QEM[0] = n[0] * n[0];
-        QEM[1] = n[0] * n[1];
-        QEM[2] = n[0] * n[2];
-        QEM[3] = d * n[0];
-
-        QEM[4] = n[1] * n[1];
-        QEM[5] = n[1] * n[2];
-        QEM[6] = d * n[1];
-
-        QEM[7] = n[2] * n[2];
-        QEM[8] = d * n[2];
-
-        QEM[9] = d * d;
-
-        QEM[10] = 1;
-
-        // need to add orthogonal plane with the other Attributes, but this
-        // is not clear??
-        // check to interaction with attribute data
-        for (j = 0; j < 11; j++)
-        {
-          this->ErrorQuadrics[pts[i]].Quadric[j] += QEM[j] * w;
-          this->ErrorQuadrics[pts[(i + 1) % 3]].Quadric[j] += QEM[j] * w;
+          if (pts[i] != ptId && pts[(i + 1) % 3] != ptId)
+          {
+            continue;
+          }
+          input->GetCellEdgeNeighbors(cells[k], pts[i], pts[(i + 1) % 3], cellIds);
+          if (cellIds->GetNumberOfIds() == 0)
+          {
+            // this is a boundary
+            input->GetPoint(pts[(i + 2) % 3], t0);
+            input->GetPoint(pts[i], t1);
+            input->GetPoint(pts[(i + 1) % 3], t2);
+
+            // computing a plane which is orthogonal to line t1, t2 and incident
+            // with it
+            for (j = 0; j < 3; j++)
+            {
+              e0[j] = t2[j] - t1[j];
+            }
+            for (j = 0; j < 3; j++)
+            {
+              e1[j] = t0[j] - t1[j];
+            }
+
+            // compute n so that it is orthogonal to e0 and parallel to the
+            // triangle
+            c = vtkMath::Dot(e0, e1) / (e0[0] * e0[0] + e0[1] * e0[1] + e0[2] * e0[2]);
+            for (j = 0; j < 3; j++)
+            {
+              n[j] = e1[j] - c * e0[j];
+            }
+            vtkMath::Normalize(n);
+            d = -vtkMath::Dot(n, t1);
+            w = vtkMath::Norm(e0);
+
+            // w *= w;
+            // area issue ??
+            // could possible add in angle weights??
+            QEM[0] = n[0] * n[0];
+            QEM[1] = n[0] * n[1];
+            QEM[2] = n[0] * n[2];
+            QEM[3] = d * n[0];
+
+            QEM[4] = n[1] * n[1];
+            QEM[5] = n[1] * n[2];
+            QEM[6] = d * n[1];
+
+            QEM[7] = n[2] * n[2];
+            QEM[8] = d * n[2];
+
+            QEM[9] = d * d;
+
+            QEM[10] = 1;
+
+            // need to add orthogonal plane with the other Attributes, but this
+            // is not clear??
+            // check to interaction with attribute data
+            for (j = 0; j < 11; j++)
+            {
+              if (pts[i] == ptId)
+              {
+                quadric[j] += QEM[j] * w;
+              }
+              if (pts[(i + 1) % 3] == ptId)
+              {
+                quadric[j] += QEM[j] * w;
+              }
+            }
+          }
         }
       }
     }
-  }
-  cellIds->Delete();
-  delete[] QEM;
+  });
 }
 
 //----------------------------------------------------------------------------
@@ -1455,6 +1860,7 @@ void vtkQuadricDecimation::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Attribute Error Metric: " << (this->AttributeErrorMetric ? "On\n" : "Off\n");
   os << indent << "Volume Preservation: " << (this->VolumePreservation ? "On\n" : "Off\n");
+  os << indent << "Number Of Partitions: " << this->NumberOfPartitions << "\n";
   os << indent << "Scalars Attribute: " << (this->ScalarsAttribute ? "On\n" : "Off\n");
   os << indent << "Vectors Attribute: " << (this->VectorsAttribute ? "On\n" : "Off\n");
   os << indent << "Normals Attribute: " << (this->NormalsAttribute ? "On\n" : "Off\n");
@@ -48,6 +48,13 @@
  * Attributes" is also a good take on the subject especially as it pertains
  * to the error metric applied to attributes.
  *
+ * The quadrics of the points are accumulated in parallel (using
+ * vtkSMPTools). To also collapse the edges in parallel, set
+ * NumberOfPartitions to more than one: the triangles are then split into
+ * that many spatial partitions which are decimated concurrently, the points
+ * shared by several partitions being locked, and the edges left around these
+ * points are collapsed afterwards with the rest of the mesh.
+ *
  * @par Thanks:
  * Thanks to Bradley Lowekamp of the National Library of Medicine/NIH for
  * contributing this class.
@@ -148,6 +155,22 @@ public:
   vtkGetMacro(TensorsWeight, double);
   //@}
 
+  //@{
+  /**
+   * Set/Get the number of spatial partitions of the mesh decimated
+   * concurrently. The triangles of each partition that do not use the points
+   * it shares with its neighbors are reduced by TargetReduction, without
+   * moving these points, before a final sequential pass collapses the
+   * remaining edges of the whole mesh, those around the partition interfaces
+   * included, until the target is reached. The quality of the result is
+   * close to the sequential decimation as long as the partitions are large;
+   * a few partitions per thread is a good choice. By default the number of
+   * partitions is 1, and the mesh is decimated sequentially.
+   */
+  vtkSetClampMacro(NumberOfPartitions, int, 1, VTK_INT_MAX);
+  vtkGetMacro(NumberOfPartitions, int);
+  //@}
+
   //@{
   /**
    * Get the actual reduction. This value is only valid after the
@@ -162,6 +185,23 @@ protected:
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
+  /**
+   * Collapse the edges of the working mesh by increasing cost, its quadrics
+   * being computed, until TargetReduction of its numTris original triangles,
+   * numDeletedTris of which are already deleted, is reached. The edges using
+   * a point flagged in lockedPoints, when given, are never collapsed. Return
+   * the number of triangles deleted in total.
+   */
+  vtkIdType DecimateMesh(
+    vtkIdType numTris, vtkIdType numDeletedTris, const unsigned char* lockedPoints);
+
+  /**
+   * Decimate NumberOfPartitions spatial partitions of the working mesh
+   * concurrently, and replace its triangles with the remaining ones. Return
+   * the number of triangles deleted.
+   */
+  vtkIdType DecimatePartitions();
+
   /**
    * Do the dirty work of eliminating the edge; return the number of
    * triangles deleted.
@@ -232,6 +272,7 @@ protected:
 
   double TargetReduction;
   double ActualReduction;
+  int NumberOfPartitions;
   vtkTypeBool AttributeErrorMetric;
   vtkTypeBool VolumePreservation;
 
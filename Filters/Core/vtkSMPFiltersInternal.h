@@ -0,0 +1,110 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPFiltersInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkSMPFiltersInternal
+ * @brief   helpers shared by the threaded filters
+ *
+ * vtkSMPFiltersInternal gathers small helpers needed by several filters
+ * running with vtkSMPTools, such as telling whether an implicit function
+ * can be evaluated from several threads at once, or copying a range of
+ * tuples to a given offset of a preallocated array.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkCutter vtkContourHelper vtkClipDataSet vtkTableBasedClipDataSet vtkAppendFilter
+ * vtkAppendPolyData
+ */
+
+#ifndef vtkSMPFiltersInternal_h
+#define vtkSMPFiltersInternal_h
+
+#include "vtkArrayDispatch.h"
+#include "vtkDataArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkImplicitFunction.h"
+#include "vtkPlane.h"
+#include "vtkSphere.h"
+
+#include <algorithm>
+
+namespace
+{ // anonymous namespace
+
+//----------------------------------------------------------------------------
+// Whether the implicit function can be evaluated concurrently. Transformed
+// functions serialize on the update of their transform and other functions
+// may cache state, so only untransformed planes and spheres qualify.
+inline bool CanEvaluateInParallel(vtkImplicitFunction* function)
+{
+  return !function->GetTransform() &&
+    (vtkPlane::SafeDownCast(function) || vtkSphere::SafeDownCast(function));
+}
+
+//----------------------------------------------------------------------------
+struct CopyTuplesWorker
+{
+  vtkIdType Begin;
+  vtkIdType End;
+  vtkIdType Offset;
+
+  template <typename Array1T, typename Array2T>
+  void operator()(Array1T* dest, Array2T* src)
+  {
+    const auto srcTuples = vtk::DataArrayTupleRange(src, this->Begin, this->End);
+    auto dstTuples = vtk::DataArrayTupleRange(dest, this->Offset);
+    std::copy(srcTuples.cbegin(), srcTuples.cend(), dstTuples.begin());
+  }
+};
+
+// Whether distinct ranges of tuples of the array can be written concurrently.
+// Bit arrays pack several values per byte, and the arrays that are not data
+// arrays, such as string arrays, update shared state when they are written.
+inline bool CanCopyTuplesInParallel(vtkAbstractArray* array)
+{
+  return vtkDataArray::FastDownCast(array) && array->GetDataType() != VTK_BIT;
+}
+
+// Copy the tuples [begin, end) of src to dest, from the tuple offset on.
+// dest must already have its final number of tuples. Distinct ranges of dest
+// may be written concurrently when CanCopyTuplesInParallel(dest).
+inline void CopyTuples(
+  vtkAbstractArray* dest, vtkAbstractArray* src, vtkIdType begin, vtkIdType end, vtkIdType offset)
+{
+  vtkDataArray* destData = vtkDataArray::FastDownCast(dest);
+  vtkDataArray* srcData = vtkDataArray::FastDownCast(src);
+  if (destData && srcData)
+  {
+    CopyTuplesWorker worker{ begin, end, offset };
+    if (!vtkArrayDispatch::Dispatch2SameValueType::Execute(destData, srcData, worker))
+    {
+      worker(destData, srcData);
+    }
+    return;
+  }
+  for (vtkIdType id = begin; id < end; ++id)
+  {
+    dest->SetTuple(offset + id - begin, id, src);
+  }
+}
+
+} // anonymous namespace
+
+#endif // vtkSMPFiltersInternal_h
+// VTK-HeaderTest-Exclude: vtkSMPFiltersInternal.h
@@ -18,17 +18,22 @@
 #include "vtkCellData.h"
 #include "vtkCellLocator.h"
 #include "vtkFloatArray.h"
+#include "vtkGenericCell.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
-#include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmoothPolyDataInternal.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
-#include "vtkTriangleFilter.h"
 
+#include <algorithm>
 #include <limits>
+#include <vector>
 
 vtkStandardNewMacro(vtkSmoothPolyDataFilter);
 
@@ -147,26 +152,9 @@ vtkPolyData* vtkSmoothPolyDataFilter::GetSource()
   return vtkPolyData::SafeDownCast(this->GetExecutive()->GetInputData(1, 0));
 }
 
-#define VTK_SIMPLE_VERTEX 0
-#define VTK_FIXED_VERTEX 1
-#define VTK_FEATURE_EDGE_VERTEX 2
-#define VTK_BOUNDARY_EDGE_VERTEX 3
-
 namespace
 {
 
-// Special structure for marking vertices
-typedef struct _vtkMeshVertex
-{
-  char type;
-  vtkIdList* edges; // connected edges (list of connected point ids)
-  _vtkMeshVertex()
-  {
-    type = VTK_SIMPLE_VERTEX; // can smooth
-    edges = nullptr;
-  }
-} vtkMeshVertex, *vtkMeshVertexPtr;
-
 template <typename T>
 struct vtkSPDF_InternalParams
 {
@@ -176,16 +164,30 @@ struct vtkSPDF_InternalParams
   T factor;
   T conv;
   vtkIdType numPts;
-  vtkMeshVertexPtr vertexPtr;
+  const SmoothingTopology* topology;
   vtkPolyData* source;
   vtkSmoothPoints* SmoothPoints;
-  double* w;
   vtkCellLocator* cellLocator;
 };
 
+// Each iteration moves all the points from the positions of the previous
+// one (Jacobi iterations), reading them from one buffer and writing them to
+// the other, so that the points are moved in parallel.
 template <typename T>
 void vtkSPDF_MovePoints(vtkSPDF_InternalParams<T>& params)
 {
+  const SmoothingTopology* topology = params.topology;
+  T* newPtsCoords = static_cast<T*>(params.newPts->GetVoidPointer(0));
+  std::vector<T> buffer(newPtsCoords, newPtsCoords + 3 * params.numPts);
+  T* current = newPtsCoords;
+  T* next = buffer.data();
+
+  vtkSMPThreadLocal<T> localMaxDist(0);
+  vtkSMPThreadLocalObject<vtkGenericCell> genericCells;
+  vtkSMPThreadLocal<std::vector<double>> localWeights;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> localLostPoints;
+  const int maxCellSize = params.source ? params.source->GetMaxCellSize() : 0;
+
   int iterationNumber = 0;
   for (T maxDist = std::numeric_limits<T>::max();
        maxDist > params.conv && iterationNumber < params.numberOfIterations; ++iterationNumber)
@@ -199,79 +201,115 @@ void vtkSPDF_MovePoints(vtkSPDF_InternalParams<T>& params)
       }
     }
 
-    maxDist = 0.0;
-    T* newPtsCoords = static_cast<T*>(params.newPts->GetVoidPointer(0));
-    T* start = newPtsCoords;
-    vtkMeshVertexPtr vertsPtr = params.vertexPtr;
-    vtkIdType npts, *edgeIdPtr;
-    T dist, deltaX[3];
-    double dist2, xNew[3], closestPt[3];
+    for (T& dist : localMaxDist)
+    {
+      dist = 0.0;
+    }
 
     // For each non-fixed vertex of the mesh, move the point toward the mean
     // position of its connected neighbors using the relaxation factor.
-    for (vtkIdType i = 0; i < params.numPts; ++i)
-    {
-      if (vertsPtr->type != VTK_FIXED_VERTEX && vertsPtr->edges != nullptr &&
-        (npts = vertsPtr->edges->GetNumberOfIds()) > 0)
+    vtkSMPTools::For(0, params.numPts, [&](vtkIdType i, vtkIdType end) {
+      T& localDist = localMaxDist.Local();
+      std::vector<vtkIdType>& lostPoints = localLostPoints.Local();
+      std::vector<double>& w = localWeights.Local();
+      w.resize(maxCellSize);
+      vtkGenericCell* cell = genericCells.Local();
+      T dist, deltaX[3];
+      double dist2, xNew[3], closestPt[3];
+
+      for (; i < end; ++i)
       {
+        const T* x = current + 3 * i;
+        T* newX = next + 3 * i;
+        const vtkIdType npts = topology->GetNumberOfNeighbors(i);
+        if (topology->GetType(i) == VTK_FIXED_VERTEX || npts == 0)
+        {
+          std::copy(x, x + 3, newX);
+          continue;
+        }
+
         deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
-        edgeIdPtr = vertsPtr->edges->GetPointer(0);
+        const vtkIdType* edgeIdPtr = topology->GetNeighbors(i);
         // Compute the mean (cumulated) direction vector
         for (vtkIdType j = 0; j < npts; ++j)
         {
           for (unsigned short k = 0; k < 3; ++k)
           {
-            deltaX[k] += *(start + 3 * (*edgeIdPtr) + k);
+            deltaX[k] += current[3 * edgeIdPtr[j] + k];
           }
-          ++edgeIdPtr;
         } // for all connected points
 
         // Move the point
-        *newPtsCoords += params.factor * (deltaX[0] / npts - (*newPtsCoords));
-        xNew[0] = *newPtsCoords;
-        ++newPtsCoords;
-        *newPtsCoords += params.factor * (deltaX[1] / npts - (*newPtsCoords));
-        xNew[1] = *newPtsCoords;
-        ++newPtsCoords;
-        *newPtsCoords += params.factor * (deltaX[2] / npts - (*newPtsCoords));
-        xNew[2] = *newPtsCoords;
-        ++newPtsCoords;
-
-        // Constrain point to surface
+        for (unsigned short k = 0; k < 3; ++k)
+        {
+          newX[k] = x[k] + params.factor * (deltaX[k] / npts - x[k]);
+          xNew[k] = newX[k];
+        }
+
+        // Constrain point to surface. The points that have left their cell
+        // are projected once all the points have been moved, as the cell
+        // locator does not search concurrently.
         if (params.source)
         {
           vtkSmoothPoint* sPtr = params.SmoothPoints->GetSmoothPoint(i);
-          vtkCell* cell = nullptr;
-
           if (sPtr->cellId >= 0) // in cell
           {
-            cell = params.source->GetCell(sPtr->cellId);
+            params.source->GetCell(sPtr->cellId, cell);
           }
 
-          if (!cell ||
-            cell->EvaluatePosition(xNew, closestPt, sPtr->subId, sPtr->p, dist2, params.w) == 0)
+          if (sPtr->cellId < 0 ||
+            cell->EvaluatePosition(xNew, closestPt, sPtr->subId, sPtr->p, dist2, w.data()) == 0)
           { // not in cell anymore
-            params.cellLocator->FindClosestPoint(xNew, closestPt, sPtr->cellId, sPtr->subId, dist2);
+            lostPoints.push_back(i);
           }
-          for (int k = 0; k < 3; ++k)
+          else
           {
-            xNew[k] = closestPt[k];
+            for (unsigned short k = 0; k < 3; ++k)
+            {
+              newX[k] = static_cast<T>(closestPt[k]);
+            }
           }
-          params.newPts->SetPoint(i, xNew);
         }
 
-        if ((dist = vtkMath::Norm(deltaX)) > maxDist)
+        if ((dist = vtkMath::Norm(deltaX)) > localDist)
         {
-          maxDist = dist;
+          localDist = dist;
         }
-      } // if can move point
-      else
+      } // for all points
+    });
+
+    if (params.source)
+    {
+      double dist2, xNew[3], closestPt[3];
+      for (std::vector<vtkIdType>& lostPoints : localLostPoints)
       {
-        newPtsCoords += 3;
+        for (vtkIdType i : lostPoints)
+        {
+          vtkSmoothPoint* sPtr = params.SmoothPoints->GetSmoothPoint(i);
+          std::copy(next + 3 * i, next + 3 * i + 3, xNew);
+          params.cellLocator->FindClosestPoint(xNew, closestPt, sPtr->cellId, sPtr->subId, dist2);
+          for (unsigned short k = 0; k < 3; ++k)
+          {
+            next[3 * i + k] = static_cast<T>(closestPt[k]);
+          }
+        }
+        lostPoints.clear();
       }
-      ++vertsPtr;
-    } // for all points
-  }   // for not converged or within iteration count
+    }
+
+    maxDist = 0.0;
+    for (T dist : localMaxDist)
+    {
+      maxDist = std::max(maxDist, dist);
+    }
+    std::swap(current, next);
+  } // for not converged or within iteration count
+
+  if (current != newPtsCoords)
+  {
+    std::copy(current, current + 3 * params.numPts, newPtsCoords);
+  }
+  params.newPts->Modified();
 
   vtkDebugWithObjectMacro(params.spdf, << "Performed " << iterationNumber << " smoothing passes");
 }
@@ -295,23 +333,11 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   }
   vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkIdType numPts, numCells, i, numPolys, numStrips;
-  int j, k;
-  vtkIdType npts = 0;
-  const vtkIdType* pts = nullptr;
-  vtkIdType p1, p2;
+  vtkIdType numPts, numCells, i;
   double conv;
-  double x1[3], x2[3], x3[3], l1[3], l2[3];
-  double CosFeatureAngle; // Cosine of angle between adjacent polys
-  double CosEdgeAngle;    // Cosine of angle between adjacent edges
-  double closestPt[3], dist2, *w = nullptr;
-  vtkIdType numSimple = 0, numBEdges = 0, numFixed = 0, numFEdges = 0;
-  vtkPolyData *inMesh, *Mesh;
+  double closestPt[3], dist2;
   vtkPoints* inPts;
-  vtkTriangleFilter* toTris = nullptr;
-  vtkCellArray *inVerts, *inLines, *inPolys, *inStrips;
   vtkPoints* newPts;
-  vtkMeshVertexPtr Verts;
   vtkCellLocator* cellLocator = nullptr;
 
   // Check input
@@ -324,9 +350,6 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
-  CosFeatureAngle = cos(vtkMath::RadiansFromDegrees(this->FeatureAngle));
-  CosEdgeAngle = cos(vtkMath::RadiansFromDegrees(this->EdgeAngle));
-
   vtkDebugMacro(<< "Smoothing " << numPts << " vertices, " << numCells << " cells with:\n"
                 << "\tConvergence= " << this->Convergence << "\n"
                 << "\tIterations= " << this->NumberOfIterations << "\n"
@@ -353,268 +376,19 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   // using a subset of the attached vertices.
   //
   vtkDebugMacro(<< "Analyzing topology...");
-  Verts = new vtkMeshVertex[numPts];
-
   inPts = input->GetPoints();
   conv = this->Convergence * input->GetLength();
 
-  // check vertices first. Vertices are never smoothed_--------------
-  for (inVerts = input->GetVerts(), inVerts->InitTraversal(); inVerts->GetNextCell(npts, pts);)
-  {
-    for (j = 0; j < npts; j++)
-    {
-      Verts[pts[j]].type = VTK_FIXED_VERTEX;
-    }
-  }
-  this->UpdateProgress(0.10);
-
-  // now check lines. Only manifold lines can be smoothed------------
-  for (inLines = input->GetLines(), inLines->InitTraversal(); inLines->GetNextCell(npts, pts);)
-  {
-    for (j = 0; j < npts; j++)
-    {
-      if (Verts[pts[j]].type == VTK_SIMPLE_VERTEX)
-      {
-        if (j == (npts - 1)) // end-of-line marked FIXED
-        {
-          Verts[pts[j]].type = VTK_FIXED_VERTEX;
-        }
-        else if (j == 0) // beginning-of-line marked FIXED
-        {
-          Verts[pts[0]].type = VTK_FIXED_VERTEX;
-          inPts->GetPoint(pts[0], x2);
-          inPts->GetPoint(pts[1], x3);
-        }
-        else // is edge vertex (unless already edge vertex!)
-        {
-          Verts[pts[j]].type = VTK_FEATURE_EDGE_VERTEX;
-          Verts[pts[j]].edges = vtkIdList::New();
-          Verts[pts[j]].edges->SetNumberOfIds(2);
-          Verts[pts[j]].edges->SetId(0, pts[j - 1]);
-          Verts[pts[j]].edges->SetId(1, pts[j + 1]);
-        }
-      } // if simple vertex
-
-      else if (Verts[pts[j]].type == VTK_FEATURE_EDGE_VERTEX)
-      { // multiply connected, becomes fixed!
-        Verts[pts[j]].type = VTK_FIXED_VERTEX;
-        Verts[pts[j]].edges->Delete();
-        Verts[pts[j]].edges = nullptr;
-      }
-
-    } // for all points in this line
-  }   // for all lines
-  this->UpdateProgress(0.25);
-
-  // now polygons and triangle strips-------------------------------
-  inPolys = input->GetPolys();
-  numPolys = inPolys->GetNumberOfCells();
-  inStrips = input->GetStrips();
-  numStrips = inStrips->GetNumberOfCells();
-
-  if (numPolys > 0 || numStrips > 0)
-  { // build cell structure
-    vtkCellArray* polys;
-    vtkIdType cellId;
-    int numNei, nei, edge;
-    vtkIdType numNeiPts;
-    const vtkIdType* neiPts;
-    double normal[3], neiNormal[3];
-    vtkIdList* neighbors;
-
-    neighbors = vtkIdList::New();
-    neighbors->Allocate(VTK_CELL_SIZE);
-
-    inMesh = vtkPolyData::New();
-    inMesh->SetPoints(inPts);
-    inMesh->SetPolys(inPolys);
-    Mesh = inMesh;
-
-    if ((numStrips = inStrips->GetNumberOfCells()) > 0)
-    { // convert data to triangles
-      inMesh->SetStrips(inStrips);
-      toTris = vtkTriangleFilter::New();
-      toTris->SetInputData(inMesh);
-      toTris->Update();
-      Mesh = toTris->GetOutput();
-    }
-
-    Mesh->BuildLinks(); // to do neighborhood searching
-    polys = Mesh->GetPolys();
-    this->UpdateProgress(0.375);
-
-    for (cellId = 0, polys->InitTraversal(); polys->GetNextCell(npts, pts); cellId++)
-    {
-      for (i = 0; i < npts; i++)
-      {
-        p1 = pts[i];
-        p2 = pts[(i + 1) % npts];
-
-        if (Verts[p1].edges == nullptr)
-        {
-          Verts[p1].edges = vtkIdList::New();
-          Verts[p1].edges->Allocate(16, 6);
-        }
-        if (Verts[p2].edges == nullptr)
-        {
-          Verts[p2].edges = vtkIdList::New();
-          Verts[p2].edges->Allocate(16, 6);
-        }
-
-        Mesh->GetCellEdgeNeighbors(cellId, p1, p2, neighbors);
-        numNei = neighbors->GetNumberOfIds();
-
-        edge = VTK_SIMPLE_VERTEX;
-        if (numNei == 0)
-        {
-          edge = VTK_BOUNDARY_EDGE_VERTEX;
-        }
-
-        else if (numNei >= 2)
-        {
-          // check to make sure that this edge hasn't been marked already
-          for (j = 0; j < numNei; j++)
-          {
-            if (neighbors->GetId(j) < cellId)
-            {
-              break;
-            }
-          }
-          if (j >= numNei)
-          {
-            edge = VTK_FEATURE_EDGE_VERTEX;
-          }
-        }
-
-        else if (numNei == 1 && (nei = neighbors->GetId(0)) > cellId)
-        {
-          if (this->FeatureEdgeSmoothing)
-          {
-            vtkPolygon::ComputeNormal(inPts, npts, pts, normal);
-            Mesh->GetCellPoints(nei, numNeiPts, neiPts);
-            vtkPolygon::ComputeNormal(inPts, numNeiPts, neiPts, neiNormal);
-
-            if (vtkMath::Dot(normal, neiNormal) <= CosFeatureAngle)
-            {
-              edge = VTK_FEATURE_EDGE_VERTEX;
-            }
-          }
-        }
-        else // a visited edge; skip rest of analysis
-        {
-          continue;
-        }
-
-        if (edge && Verts[p1].type == VTK_SIMPLE_VERTEX)
-        {
-          Verts[p1].edges->Reset();
-          Verts[p1].edges->InsertNextId(p2);
-          Verts[p1].type = edge;
-        }
-        else if ((edge && Verts[p1].type == VTK_BOUNDARY_EDGE_VERTEX) ||
-          (edge && Verts[p1].type == VTK_FEATURE_EDGE_VERTEX) ||
-          (!edge && Verts[p1].type == VTK_SIMPLE_VERTEX))
-        {
-          Verts[p1].edges->InsertNextId(p2);
-          if (Verts[p1].type && edge == VTK_BOUNDARY_EDGE_VERTEX)
-          {
-            Verts[p1].type = VTK_BOUNDARY_EDGE_VERTEX;
-          }
-        }
-
-        if (edge && Verts[p2].type == VTK_SIMPLE_VERTEX)
-        {
-          Verts[p2].edges->Reset();
-          Verts[p2].edges->InsertNextId(p1);
-          Verts[p2].type = edge;
-        }
-        else if ((edge && Verts[p2].type == VTK_BOUNDARY_EDGE_VERTEX) ||
-          (edge && Verts[p2].type == VTK_FEATURE_EDGE_VERTEX) ||
-          (!edge && Verts[p2].type == VTK_SIMPLE_VERTEX))
-        {
-          Verts[p2].edges->InsertNextId(p1);
-          if (Verts[p2].type && edge == VTK_BOUNDARY_EDGE_VERTEX)
-          {
-            Verts[p2].type = VTK_BOUNDARY_EDGE_VERTEX;
-          }
-        }
-      }
-    }
-
-    inMesh->Delete();
-    if (toTris)
-    {
-      toTris->Delete();
-    }
-
-    neighbors->Delete();
-  } // if strips or polys
-
-  this->UpdateProgress(0.50);
-
-  // post-process edge vertices to make sure we can smooth them
-  for (i = 0; i < numPts; i++)
-  {
-    if (Verts[i].type == VTK_SIMPLE_VERTEX)
-    {
-      numSimple++;
-    }
-
-    else if (Verts[i].type == VTK_FIXED_VERTEX)
-    {
-      numFixed++;
-    }
+  SmoothingTopology topology;
+  topology.FeatureEdgeSmoothing = this->FeatureEdgeSmoothing != 0;
+  topology.CosFeatureAngle = cos(vtkMath::RadiansFromDegrees(this->FeatureAngle));
+  topology.CosEdgeAngle = cos(vtkMath::RadiansFromDegrees(this->EdgeAngle));
+  topology.BoundarySmoothing = this->BoundarySmoothing != 0;
+  topology.Build(input, this);
 
-    else if (Verts[i].type == VTK_FEATURE_EDGE_VERTEX || Verts[i].type == VTK_BOUNDARY_EDGE_VERTEX)
-    { // see how many edges; if two, what the angle is
-
-      if (!this->BoundarySmoothing && Verts[i].type == VTK_BOUNDARY_EDGE_VERTEX)
-      {
-        Verts[i].type = VTK_FIXED_VERTEX;
-        numBEdges++;
-      }
-
-      else if ((npts = Verts[i].edges->GetNumberOfIds()) != 2)
-      {
-        Verts[i].type = VTK_FIXED_VERTEX;
-        numFixed++;
-      }
-
-      else // check angle between edges
-      {
-        inPts->GetPoint(Verts[i].edges->GetId(0), x1);
-        inPts->GetPoint(i, x2);
-        inPts->GetPoint(Verts[i].edges->GetId(1), x3);
-
-        for (k = 0; k < 3; k++)
-        {
-          l1[k] = x2[k] - x1[k];
-          l2[k] = x3[k] - x2[k];
-        }
-        if (vtkMath::Normalize(l1) >= 0.0 && vtkMath::Normalize(l2) >= 0.0 &&
-          vtkMath::Dot(l1, l2) < CosEdgeAngle)
-        {
-          numFixed++;
-          Verts[i].type = VTK_FIXED_VERTEX;
-        }
-        else
-        {
-          if (Verts[i].type == VTK_FEATURE_EDGE_VERTEX)
-          {
-            numFEdges++;
-          }
-          else
-          {
-            numBEdges++;
-          }
-        }
-      } // if along edge
-    }   // if edge vertex
-  }     // for all points
-
-  vtkDebugMacro(<< "Found\n\t" << numSimple << " simple vertices\n\t" << numFEdges
-                << " feature edge vertices\n\t" << numBEdges << " boundary edge vertices\n\t"
-                << numFixed << " fixed vertices\n\t");
+  vtkDebugMacro(<< "Found\n\t" << topology.NumSimple << " simple vertices\n\t"
+                << topology.NumFEdges << " feature edge vertices\n\t" << topology.NumBEdges
+                << " boundary edge vertices\n\t" << topology.NumFixed << " fixed vertices\n\t");
 
   vtkDebugMacro(<< "Beginning smoothing iterations...");
 
@@ -645,7 +419,6 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
     this->SmoothPoints = new vtkSmoothPoints;
     vtkSmoothPoint* sPtr;
     cellLocator = vtkCellLocator::New();
-    w = new double[source->GetMaxCellSize()];
 
     cellLocator->SetDataSet(source);
     cellLocator->BuildLocator();
@@ -660,24 +433,28 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   }
   else // smooth normally
   {
-    for (i = 0; i < numPts; i++) // initialize to old coordinates
-    {
-      newPts->SetPoint(i, inPts->GetPoint(i));
-    }
+    vtkSMPTools::For(0, numPts, [inPts, newPts](vtkIdType ptId, vtkIdType endPtId) {
+      double x[3];
+      for (; ptId < endPtId; ptId++) // initialize to old coordinates
+      {
+        inPts->GetPoint(ptId, x);
+        newPts->SetPoint(ptId, x);
+      }
+    });
   }
 
   if (newPts->GetDataType() == VTK_DOUBLE)
   {
     vtkSPDF_InternalParams<double> params = { this, this->NumberOfIterations, newPts,
-      this->RelaxationFactor, conv, numPts, Verts, source, this->SmoothPoints, w, cellLocator };
+      this->RelaxationFactor, conv, numPts, &topology, source, this->SmoothPoints, cellLocator };
 
     vtkSPDF_MovePoints(params);
   }
   else
   {
     vtkSPDF_InternalParams<float> params = { this, this->NumberOfIterations, newPts,
-      static_cast<float>(this->RelaxationFactor), static_cast<float>(conv), numPts, Verts, source,
-      this->SmoothPoints, w, cellLocator };
+      static_cast<float>(this->RelaxationFactor), static_cast<float>(conv), numPts, &topology,
+      source, this->SmoothPoints, cellLocator };
 
     vtkSPDF_MovePoints(params);
   }
@@ -686,7 +463,7 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   {
     cellLocator->Delete();
     delete this->SmoothPoints;
-    delete[] w;
+    this->SmoothPoints = nullptr;
   }
 
   // Update output. Only point coordinates have changed.
@@ -698,12 +475,16 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   {
     vtkFloatArray* newScalars = vtkFloatArray::New();
     newScalars->SetNumberOfTuples(numPts);
-    for (i = 0; i < numPts; i++)
-    {
-      inPts->GetPoint(i, x1);
-      newPts->GetPoint(i, x2);
-      newScalars->SetComponent(i, 0, sqrt(vtkMath::Distance2BetweenPoints(x1, x2)));
-    }
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      double x1[3], x2[3];
+      for (; ptId < endPtId; ptId++)
+      {
+        inPts->GetPoint(ptId, x1);
+        newPts->GetPoint(ptId, x2);
+        newScalars->SetValue(
+          ptId, static_cast<float>(sqrt(vtkMath::Distance2BetweenPoints(x1, x2))));
+      }
+    });
     int idx = output->GetPointData()->AddArray(newScalars);
     output->GetPointData()->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
     newScalars->Delete();
@@ -714,16 +495,19 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
     vtkFloatArray* newVectors = vtkFloatArray::New();
     newVectors->SetNumberOfComponents(3);
     newVectors->SetNumberOfTuples(numPts);
-    for (i = 0; i < numPts; i++)
-    {
-      inPts->GetPoint(i, x1);
-      newPts->GetPoint(i, x2);
-      for (j = 0; j < 3; j++)
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      double x1[3], x2[3], x3[3];
+      for (; ptId < endPtId; ptId++)
       {
-        x3[j] = x2[j] - x1[j];
+        inPts->GetPoint(ptId, x1);
+        newPts->GetPoint(ptId, x2);
+        for (int j = 0; j < 3; j++)
+        {
+          x3[j] = x2[j] - x1[j];
+        }
+        newVectors->SetTuple(ptId, x3);
       }
-      newVectors->SetTuple(i, x3);
-    }
+    });
     output->GetPointData()->SetVectors(newVectors);
     newVectors->Delete();
   }
@@ -736,17 +520,6 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   output->SetPolys(input->GetPolys());
   output->SetStrips(input->GetStrips());
 
-  // free up connectivity storage
-  for (i = 0; i < numPts; i++)
-  {
-    if (Verts[i].edges != nullptr)
-    {
-      Verts[i].edges->Delete();
-      Verts[i].edges = nullptr;
-    }
-  }
-  delete[] Verts;
-
   return 1;
 }
 
@@ -32,7 +32,9 @@
  * relaxation factor is available to control the amount of displacement of
  * v).  The process repeats for each vertex. This pass over the list of
  * vertices is a single iteration. Many iterations (generally around 20 or
- * so) are repeated until the desired result is obtained.
+ * so) are repeated until the desired result is obtained. Each iteration
+ * averages the coordinates of the previous one, so that the vertices are
+ * smoothed in parallel (using vtkSMPTools) independently of their order.
  *
  * There are some special instance variables used to control the execution
  * of this filter. (These ivars basically control what vertices can be
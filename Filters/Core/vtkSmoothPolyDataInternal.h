@@ -0,0 +1,614 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSmoothPolyDataInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkSmoothPolyDataInternal
+ * @brief   threaded topological analysis of the meshes of the smoothing filters
+ *
+ * vtkSmoothPolyDataInternal classifies the points of a vtkPolyData for
+ * vtkSmoothPolyDataFilter and vtkWindowedSincPolyDataFilter, and lists the
+ * points each of them is smoothed with. The classification is one of
+ * VTK_SIMPLE_VERTEX, VTK_FIXED_VERTEX, VTK_FEATURE_EDGE_VERTEX or
+ * VTK_BOUNDARY_EDGE_VERTEX. Simple vertices are smoothed using all connected
+ * vertices, fixed vertices are never smoothed, and edge vertices are smoothed
+ * using a subset of the attached vertices.
+ *
+ * The neighbors of all the points are stored in a single array, indexed by
+ * point offsets (compressed sparse rows). The verts and lines are analyzed
+ * sequentially. The edges of the polygons are classified in parallel, then
+ * each point replays the analysis of the edges using it, in the order of a
+ * sequential traversal of the polygons, so that the types and neighbors are
+ * those of the former sequential analysis whatever the number of threads.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkSmoothPolyDataFilter vtkWindowedSincPolyDataFilter
+ */
+
+#ifndef vtkSmoothPolyDataInternal_h
+#define vtkSmoothPolyDataInternal_h
+
+#include "vtkAlgorithm.h"
+#include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticCellLinksTemplate.h"
+#include "vtkTriangleFilter.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#define VTK_SIMPLE_VERTEX 0
+#define VTK_FIXED_VERTEX 1
+#define VTK_FEATURE_EDGE_VERTEX 2
+#define VTK_BOUNDARY_EDGE_VERTEX 3
+
+namespace
+{ // anonymous namespace
+
+using SmoothingLinks = vtkStaticCellLinksTemplate<vtkIdType>;
+
+// The offset of the first point of a cell in the connectivity of a cell array.
+struct CellBeginOffset
+{
+  template <typename CellStateT>
+  vtkIdType operator()(CellStateT& state, vtkIdType cellId) const
+  {
+    return state.GetBeginOffset(cellId);
+  }
+};
+
+class SmoothingTopology
+{
+public:
+  //@{
+  /**
+   * Options of the analysis, those of the smoothing filters. Closed loops
+   * of lines are smoothed as such when ClosedLoops is set, their last point
+   * being ignored, and fixed at both ends otherwise.
+   */
+  bool FeatureEdgeSmoothing = false;
+  double CosFeatureAngle = 0.0;
+  double CosEdgeAngle = 1.0;
+  bool BoundarySmoothing = true;
+  bool NonManifoldSmoothing = false;
+  bool ClosedLoops = false;
+  //@}
+
+  //@{
+  /**
+   * The number of points of each type found, for debugging.
+   */
+  vtkIdType NumSimple = 0;
+  vtkIdType NumFixed = 0;
+  vtkIdType NumFEdges = 0;
+  vtkIdType NumBEdges = 0;
+  //@}
+
+  /**
+   * Classify the points of the input and list their neighbors, updating the
+   * progress of the filter along the way.
+   */
+  void Build(vtkPolyData* input, vtkAlgorithm* filter);
+
+  /**
+   * The type of a point.
+   */
+  char GetType(vtkIdType ptId) const { return this->Types[ptId]; }
+
+  //@{
+  /**
+   * The points a point is smoothed with. Fixed points may have some, which
+   * their neighbors do not use.
+   */
+  vtkIdType GetNumberOfNeighbors(vtkIdType ptId) const
+  {
+    return this->Offsets[ptId + 1] - this->Offsets[ptId];
+  }
+  const vtkIdType* GetNeighbors(vtkIdType ptId) const
+  {
+    return this->Neighbors.data() + this->Offsets[ptId];
+  }
+  //@}
+
+private:
+  // Edge classification of a polygon edge already analyzed with the cell on
+  // its other side.
+  static constexpr signed char VisitedEdge = -1;
+
+  void MarkVerts(vtkCellArray* verts);
+  void MarkLines(vtkCellArray* lines);
+  void ClassifyEdges(vtkPoints* inPts);
+  signed char ClassifyEdge(vtkPoints* inPts, vtkIdType cellId, vtkIdType npts,
+    const vtkIdType* pts, vtkIdType i, vtkIdList* neighbors, vtkCellArrayIterator* neiIter);
+  template <typename InsertT>
+  char ReplayEdges(vtkIdType ptId, vtkCellArrayIterator* iter, InsertT& insert) const;
+  void FixEdgeVertices(vtkPoints* inPts);
+
+  std::vector<char> Types;
+  std::vector<vtkIdType> Offsets;
+  std::vector<vtkIdType> Neighbors;
+
+  // The two neighbors of the points in the middle of lines.
+  std::vector<vtkIdType> LineEdges;
+
+  // The polygons, triangulated when given with strips, the links from the
+  // points to them sorted by cell id, and the classification of each edge
+  // at the offset of its first point in the connectivity.
+  vtkSmartPointer<vtkCellArray> Polys;
+  SmoothingLinks Links;
+  std::vector<signed char> EdgeTypes;
+};
+
+//----------------------------------------------------------------------------
+void SmoothingTopology::Build(vtkPolyData* input, vtkAlgorithm* filter)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  vtkPoints* inPts = input->GetPoints();
+  this->Types.assign(numPts, VTK_SIMPLE_VERTEX);
+  this->LineEdges.clear();
+  this->Polys = nullptr;
+  this->EdgeTypes.clear();
+
+  // check vertices first. Vertices are never smoothed
+  this->MarkVerts(input->GetVerts());
+  filter->UpdateProgress(0.10);
+
+  // now check lines. Only manifold lines can be smoothed
+  this->MarkLines(input->GetLines());
+  filter->UpdateProgress(0.25);
+
+  // now polygons and triangle strips
+  vtkCellArray* inPolys = input->GetPolys();
+  vtkCellArray* inStrips = input->GetStrips();
+  if (inStrips->GetNumberOfCells() > 0)
+  { // convert data to triangles
+    vtkNew<vtkPolyData> inMesh;
+    inMesh->SetPoints(inPts);
+    inMesh->SetPolys(inPolys);
+    inMesh->SetStrips(inStrips);
+    vtkNew<vtkTriangleFilter> toTris;
+    toTris->SetInputData(inMesh);
+    toTris->Update();
+    this->Polys = toTris->GetOutput()->GetPolys();
+  }
+  else if (inPolys->GetNumberOfCells() > 0)
+  {
+    this->Polys = inPolys;
+  }
+  if (this->Polys)
+  {
+    // The links list the cells using each point by increasing id, as the
+    // traversal of the polygons did.
+    SmoothingLinks* links = &this->Links;
+    links->ThreadedBuildLinks(numPts, this->Polys->GetNumberOfCells(), this->Polys);
+    vtkSMPTools::For(0, numPts, [links](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ++ptId)
+      {
+        vtkIdType* cells = links->GetCells(ptId);
+        std::sort(cells, cells + links->GetNcells(ptId));
+      }
+    });
+    this->ClassifyEdges(inPts);
+  }
+
+  // Count the neighbors of each point, then list them.
+  this->Offsets.assign(numPts + 1, 0);
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> iterators;
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    vtkSmartPointer<vtkCellArrayIterator>& iter = iterators.Local();
+    if (!iter && this->Polys)
+    {
+      iter = vtk::TakeSmartPointer(this->Polys->NewIterator());
+    }
+    for (; ptId < endPtId; ++ptId)
+    {
+      vtkIdType count = 0;
+      auto insert = [&count](vtkIdType, bool reset) { count = reset ? 1 : count + 1; };
+      this->ReplayEdges(ptId, iter, insert);
+      this->Offsets[ptId] = count;
+    }
+  });
+  vtkIdType offset = 0;
+  for (vtkIdType ptId = 0; ptId <= numPts; ++ptId)
+  {
+    const vtkIdType count = this->Offsets[ptId];
+    this->Offsets[ptId] = offset;
+    offset += count;
+  }
+  this->Neighbors.resize(offset);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    vtkSmartPointer<vtkCellArrayIterator>& iter = iterators.Local();
+    if (!iter && this->Polys)
+    {
+      iter = vtk::TakeSmartPointer(this->Polys->NewIterator());
+    }
+    for (; ptId < endPtId; ++ptId)
+    {
+      vtkIdType* neighbors = this->Neighbors.data() + this->Offsets[ptId];
+      const vtkIdType numNeighbors = this->GetNumberOfNeighbors(ptId);
+      vtkIdType count = 0;
+      auto insert = [neighbors, numNeighbors, &count](vtkIdType nei, bool reset) {
+        count = reset ? 0 : count;
+        // The neighbors inserted before a reset may outnumber the kept ones.
+        if (count < numNeighbors)
+        {
+          neighbors[count] = nei;
+        }
+        count++;
+      };
+      this->Types[ptId] = this->ReplayEdges(ptId, iter, insert);
+    }
+  });
+  this->Polys = nullptr;
+  this->EdgeTypes.clear();
+  this->EdgeTypes.shrink_to_fit();
+  this->LineEdges.clear();
+  this->LineEdges.shrink_to_fit();
+  filter->UpdateProgress(0.50);
+
+  // post-process edge vertices to make sure we can smooth them
+  this->FixEdgeVertices(inPts);
+}
+
+//----------------------------------------------------------------------------
+void SmoothingTopology::MarkVerts(vtkCellArray* verts)
+{
+  vtkIdType npts;
+  const vtkIdType* pts;
+  auto iter = vtk::TakeSmartPointer(verts->NewIterator());
+  for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell())
+  {
+    iter->GetCurrentCell(npts, pts);
+    for (vtkIdType j = 0; j < npts; j++)
+    {
+      this->Types[pts[j]] = VTK_FIXED_VERTEX;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void SmoothingTopology::MarkLines(vtkCellArray* lines)
+{
+  if (lines->GetNumberOfCells() == 0)
+  {
+    return;
+  }
+  this->LineEdges.resize(2 * this->Types.size());
+
+  vtkIdType npts;
+  const vtkIdType* pts;
+  auto iter = vtk::TakeSmartPointer(lines->NewIterator());
+  for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell())
+  {
+    iter->GetCurrentCell(npts, pts);
+
+    // Check for closed loop which are treated specially. Basically the
+    // last point is ignored (set to fixed).
+    const bool closedLoop = this->ClosedLoops && pts[0] == pts[npts - 1] && npts > 3;
+
+    for (vtkIdType j = 0; j < npts; j++)
+    {
+      char& type = this->Types[pts[j]];
+      vtkIdType* edges = this->LineEdges.data() + 2 * pts[j];
+      if (type == VTK_SIMPLE_VERTEX)
+      {
+        // First point
+        if (j == 0)
+        {
+          if (!closedLoop)
+          {
+            type = VTK_FIXED_VERTEX;
+          }
+          else
+          {
+            type = VTK_FEATURE_EDGE_VERTEX;
+            edges[0] = pts[npts - 2];
+            edges[1] = pts[1];
+          }
+        }
+        // Last point
+        else if (j == (npts - 1) && !closedLoop)
+        {
+          type = VTK_FIXED_VERTEX;
+        }
+        // In between point
+        else // is edge vertex (unless already edge vertex!)
+        {
+          type = VTK_FEATURE_EDGE_VERTEX;
+          edges[0] = pts[j - 1];
+          edges[1] = pts[(closedLoop && j == (npts - 2) ? 0 : (j + 1))];
+        }
+      } // if simple vertex
+
+      // Vertex has been visited before, need to fix it. Special case
+      // when working on closed loop.
+      else if (type == VTK_FEATURE_EDGE_VERTEX && !(closedLoop && j == (npts - 1)))
+      {
+        type = VTK_FIXED_VERTEX;
+      }
+    } // for all points in this line
+  }   // for all lines
+}
+
+//----------------------------------------------------------------------------
+// The cells, other than cellId, using the edge (p1,p2), by increasing id.
+void GetCellEdgeNeighbors(
+  SmoothingLinks* links, vtkIdType cellId, vtkIdType p1, vtkIdType p2, vtkIdList* cellIds)
+{
+  cellIds->Reset();
+
+  const vtkIdType* cells1 = links->GetCells(p1);
+  const vtkIdType* cells1End = cells1 + links->GetNcells(p1);
+  const vtkIdType* cells2 = links->GetCells(p2);
+  const vtkIdType* cells2End = cells2 + links->GetNcells(p2);
+
+  for (; cells1 != cells1End; ++cells1)
+  {
+    if (*cells1 != cellId && std::find(cells2, cells2End, *cells1) != cells2End)
+    {
+      cellIds->InsertNextId(*cells1);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void SmoothingTopology::ClassifyEdges(vtkPoints* inPts)
+{
+  vtkCellArray* polys = this->Polys;
+  this->EdgeTypes.resize(polys->GetNumberOfConnectivityIds());
+
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> iterators;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> neiIterators;
+  vtkSMPThreadLocalObject<vtkIdList> neighborLists;
+  vtkSMPTools::For(0, polys->GetNumberOfCells(), [&](vtkIdType cellId, vtkIdType endCellId) {
+    vtkSmartPointer<vtkCellArrayIterator>& iter = iterators.Local();
+    vtkSmartPointer<vtkCellArrayIterator>& neiIter = neiIterators.Local();
+    if (!iter)
+    {
+      iter = vtk::TakeSmartPointer(polys->NewIterator());
+      neiIter = vtk::TakeSmartPointer(polys->NewIterator());
+    }
+    vtkIdList* neighbors = neighborLists.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (; cellId < endCellId; ++cellId)
+    {
+      iter->GetCellAtId(cellId, npts, pts);
+      signed char* edgeTypes = this->EdgeTypes.data() + polys->Visit(CellBeginOffset{}, cellId);
+      for (vtkIdType i = 0; i < npts; i++)
+      {
+        edgeTypes[i] = this->ClassifyEdge(inPts, cellId, npts, pts, i, neighbors, neiIter);
+      }
+    }
+  });
+}
+
+//----------------------------------------------------------------------------
+// The classification of the edge (pts[i], pts[i+1]) of a polygon: a simple,
+// boundary or feature edge, or an edge visited with a previous polygon whose
+// analysis is skipped.
+signed char SmoothingTopology::ClassifyEdge(vtkPoints* inPts, vtkIdType cellId, vtkIdType npts,
+  const vtkIdType* pts, vtkIdType i, vtkIdList* neighbors, vtkCellArrayIterator* neiIter)
+{
+  GetCellEdgeNeighbors(&this->Links, cellId, pts[i], pts[(i + 1) % npts], neighbors);
+  const vtkIdType numNei = neighbors->GetNumberOfIds();
+
+  if (numNei == 0)
+  {
+    return VTK_BOUNDARY_EDGE_VERTEX;
+  }
+
+  if (numNei >= 2)
+  {
+    // non-manifold case, check nonmanifold smoothing state
+    if (this->NonManifoldSmoothing)
+    {
+      return VTK_SIMPLE_VERTEX;
+    }
+    // check to make sure that this edge hasn't been marked already
+    for (vtkIdType j = 0; j < numNei; j++)
+    {
+      if (neighbors->GetId(j) < cellId)
+      {
+        return VTK_SIMPLE_VERTEX;
+      }
+    }
+    return VTK_FEATURE_EDGE_VERTEX;
+  }
+
+  const vtkIdType nei = neighbors->GetId(0);
+  if (nei < cellId) // a visited edge; skip rest of analysis
+  {
+    return VisitedEdge;
+  }
+  if (this->FeatureEdgeSmoothing)
+  {
+    double normal[3], neiNormal[3];
+    vtkIdType numNeiPts;
+    const vtkIdType* neiPts;
+    vtkPolygon::ComputeNormal(inPts, static_cast<int>(npts), pts, normal);
+    neiIter->GetCellAtId(nei, numNeiPts, neiPts);
+    vtkPolygon::ComputeNormal(inPts, static_cast<int>(numNeiPts), neiPts, neiNormal);
+
+    if (vtkMath::Dot(normal, neiNormal) <= this->CosFeatureAngle)
+    {
+      return VTK_FEATURE_EDGE_VERTEX;
+    }
+  }
+  return VTK_SIMPLE_VERTEX;
+}
+
+//----------------------------------------------------------------------------
+// Replay for a point the analysis of the edges using it: those of the lines,
+// then those of the polygons in the order of their traversal, inserting its
+// neighbors with insert(id, reset), which first clears them when reset is
+// true. The type of the point is returned.
+template <typename InsertT>
+char SmoothingTopology::ReplayEdges(
+  vtkIdType ptId, vtkCellArrayIterator* iter, InsertT& insert) const
+{
+  char type = this->Types[ptId];
+  if (type == VTK_FEATURE_EDGE_VERTEX)
+  {
+    insert(this->LineEdges[2 * ptId], false);
+    insert(this->LineEdges[2 * ptId + 1], false);
+  }
+  if (!this->Polys)
+  {
+    return type;
+  }
+
+  auto addEdge = [&type, &insert](signed char edge, vtkIdType nei) {
+    if (edge && type == VTK_SIMPLE_VERTEX)
+    {
+      insert(nei, true);
+      type = edge;
+    }
+    else if ((edge && type == VTK_BOUNDARY_EDGE_VERTEX) ||
+      (edge && type == VTK_FEATURE_EDGE_VERTEX) || (!edge && type == VTK_SIMPLE_VERTEX))
+    {
+      insert(nei, false);
+      if (type && edge == VTK_BOUNDARY_EDGE_VERTEX)
+      {
+        type = VTK_BOUNDARY_EDGE_VERTEX;
+      }
+    }
+  };
+
+  // A cell using the point several times is listed as many times.
+  SmoothingLinks* links = const_cast<SmoothingLinks*>(&this->Links);
+  const vtkIdType* cells = links->GetCells(ptId);
+  const vtkIdType ncells = links->GetNcells(ptId);
+  vtkIdType npts;
+  const vtkIdType* pts;
+  for (vtkIdType k = 0; k < ncells; ++k)
+  {
+    if (k > 0 && cells[k] == cells[k - 1])
+    {
+      continue;
+    }
+    iter->GetCellAtId(cells[k], npts, pts);
+    const signed char* edgeTypes =
+      this->EdgeTypes.data() + this->Polys->Visit(CellBeginOffset{}, cells[k]);
+    for (vtkIdType i = 0; i < npts; i++)
+    {
+      if (edgeTypes[i] == VisitedEdge)
+      {
+        continue;
+      }
+      const vtkIdType p1 = pts[i];
+      const vtkIdType p2 = pts[(i + 1) % npts];
+      if (p1 == ptId)
+      {
+        addEdge(edgeTypes[i], p2);
+      }
+      if (p2 == ptId)
+      {
+        addEdge(edgeTypes[i], p1);
+      }
+    }
+  }
+  return type;
+}
+
+//----------------------------------------------------------------------------
+// Fix the boundary vertices when they are not smoothed, and the edge vertices
+// that are not on a 2-manifold edge or at a sharp corner of their edge.
+void SmoothingTopology::FixEdgeVertices(vtkPoints* inPts)
+{
+  using Counts = std::array<vtkIdType, 4>;
+  vtkSMPThreadLocal<Counts> localCounts(Counts{ { 0, 0, 0, 0 } });
+  vtkSMPTools::For(0, static_cast<vtkIdType>(this->Types.size()), [&](vtkIdType i, vtkIdType end) {
+    Counts& counts = localCounts.Local();
+    double x1[3], x2[3], x3[3], l1[3], l2[3];
+    for (; i < end; i++)
+    {
+      char& type = this->Types[i];
+      if (type == VTK_SIMPLE_VERTEX || type == VTK_FIXED_VERTEX)
+      {
+        counts[static_cast<int>(type)]++;
+      }
+
+      else if (type == VTK_FEATURE_EDGE_VERTEX || type == VTK_BOUNDARY_EDGE_VERTEX)
+      { // see how many edges; if two, what the angle is
+
+        if (!this->BoundarySmoothing && type == VTK_BOUNDARY_EDGE_VERTEX)
+        {
+          type = VTK_FIXED_VERTEX;
+          counts[VTK_BOUNDARY_EDGE_VERTEX]++;
+        }
+
+        else if (this->GetNumberOfNeighbors(i) != 2)
+        {
+          // can only smooth edges on 2-manifold surfaces
+          type = VTK_FIXED_VERTEX;
+          counts[VTK_FIXED_VERTEX]++;
+        }
+
+        else // check angle between edges
+        {
+          inPts->GetPoint(this->GetNeighbors(i)[0], x1);
+          inPts->GetPoint(i, x2);
+          inPts->GetPoint(this->GetNeighbors(i)[1], x3);
+
+          for (int k = 0; k < 3; k++)
+          {
+            l1[k] = x2[k] - x1[k];
+            l2[k] = x3[k] - x2[k];
+          }
+          if ((vtkMath::Normalize(l1) >= 0.0) && (vtkMath::Normalize(l2) >= 0.0) &&
+            (vtkMath::Dot(l1, l2) < this->CosEdgeAngle))
+          {
+            counts[VTK_FIXED_VERTEX]++;
+            type = VTK_FIXED_VERTEX;
+          }
+          else
+          {
+            counts[static_cast<int>(type)]++;
+          }
+        } // if along edge
+      }   // if edge vertex
+    }     // for all points
+  });
+
+  this->NumSimple = this->NumFixed = this->NumFEdges = this->NumBEdges = 0;
+  for (const Counts& counts : localCounts)
+  {
+    this->NumSimple += counts[VTK_SIMPLE_VERTEX];
+    this->NumFixed += counts[VTK_FIXED_VERTEX];
+    this->NumFEdges += counts[VTK_FEATURE_EDGE_VERTEX];
+    this->NumBEdges += counts[VTK_BOUNDARY_EDGE_VERTEX];
+  }
+}
+
+} // anonymous namespace
+
+#endif // vtkSmoothPolyDataInternal_h
+// VTK-HeaderTest-Exclude: vtkSmoothPolyDataInternal.h
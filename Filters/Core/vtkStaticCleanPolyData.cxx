@@ -18,6 +18,7 @@
 #include "vtkArrayListTemplate.h" // For processing attribute data
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkCleanPolyDataInternal.h"
 #include "vtkDataArrayRange.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -37,18 +38,22 @@ namespace
 { // anonymous
 
 //----------------------------------------------------------------------------
-// Fast, threaded way to copy new points and attribute data to output.
+// Fast, threaded way to copy new points and attribute data to output. Only
+// the points that others are merged with are copied, so that each output
+// point is written once.
 template <typename InArrayT, typename OutArrayT>
 struct CopyPointsAlgorithm
 {
   vtkIdType* PtMap;
+  const vtkIdType* MergeMap;
   InArrayT* InPts;
   OutArrayT* OutPts;
   ArrayList Arrays;
 
-  CopyPointsAlgorithm(vtkIdType* ptMap, InArrayT* inPts, vtkPointData* inPD, vtkIdType numNewPts,
-    OutArrayT* outPts, vtkPointData* outPD)
+  CopyPointsAlgorithm(vtkIdType* ptMap, const vtkIdType* mergeMap, InArrayT* inPts,
+    vtkPointData* inPD, vtkIdType numNewPts, OutArrayT* outPts, vtkPointData* outPD)
     : PtMap(ptMap)
+    , MergeMap(mergeMap)
     , InPts(inPts)
     , OutPts(outPts)
   {
@@ -60,6 +65,7 @@ struct CopyPointsAlgorithm
     using OutValueT = vtk::GetAPIType<OutArrayT>;
 
     const vtkIdType* ptMap = this->PtMap;
+    const vtkIdType* mergeMap = this->MergeMap;
 
     const auto inPoints = vtk::DataArrayTupleRange<3>(this->InPts);
     auto outPoints = vtk::DataArrayTupleRange<3>(this->OutPts);
@@ -67,7 +73,7 @@ struct CopyPointsAlgorithm
     for (; ptId < endPtId; ++ptId)
     {
       const vtkIdType outPtId = ptMap[ptId];
-      if (outPtId != -1)
+      if (outPtId != -1 && mergeMap[ptId] == ptId)
       {
         const auto inP = inPoints[ptId];
         auto outP = outPoints[outPtId];
@@ -83,17 +89,78 @@ struct CopyPointsAlgorithm
 struct CopyPointsLauncher
 {
   template <typename InArrayT, typename OutArrayT>
-  void operator()(InArrayT* inPts, OutArrayT* outPts, vtkIdType* ptMap, vtkPointData* inPD,
-    vtkIdType numNewPts, vtkPointData* outPD)
+  void operator()(InArrayT* inPts, OutArrayT* outPts, vtkIdType* ptMap, const vtkIdType* mergeMap,
+    vtkPointData* inPD, vtkIdType numNewPts, vtkPointData* outPD)
   {
     const vtkIdType numPts = inPts->GetNumberOfTuples();
 
-    CopyPointsAlgorithm<InArrayT, OutArrayT> algo{ ptMap, inPts, inPD, numNewPts, outPts, outPD };
+    CopyPointsAlgorithm<InArrayT, OutArrayT> algo{ ptMap, mergeMap, inPts, inPD, numNewPts,
+      outPts, outPD };
 
     vtkSMPTools::For(0, numPts, algo);
   }
 };
 
+//----------------------------------------------------------------------------
+// What a cell becomes once its points are renumbered, exactly as decided
+// when inserting the cells one at a time in RequestData().
+struct StaticCleanClassifier
+{
+  bool ConvertLinesToPoints;
+  bool ConvertPolysToLines;
+  bool ConvertStripsToPolys;
+
+  int operator()(int type, vtkIdType npts, const vtkIdType* pts, const vtkIdType* pointMap,
+    vtkIdType* newPts, vtkIdType& numNewPts) const
+  {
+    for (numNewPts = 0; numNewPts < npts; ++numNewPts)
+    {
+      newPts[numNewPts] = pointMap[pts[numNewPts]];
+    }
+    if (type == CLEAN_POLYS && numNewPts > 2 && newPts[0] == newPts[numNewPts - 1])
+    {
+      numNewPts--;
+    }
+
+    switch (type)
+    {
+      case CLEAN_VERTS:
+        return numNewPts > 0 ? CLEAN_VERTS : CLEAN_NONE;
+      case CLEAN_LINES:
+        if (numNewPts > 1 || !this->ConvertLinesToPoints)
+        {
+          return CLEAN_LINES;
+        }
+        break;
+      case CLEAN_POLYS:
+        if (numNewPts > 2 || !this->ConvertPolysToLines)
+        {
+          return CLEAN_POLYS;
+        }
+        if (numNewPts == 2 || !this->ConvertLinesToPoints)
+        {
+          return CLEAN_LINES;
+        }
+        break;
+      default:
+        if (numNewPts > 3 || !this->ConvertStripsToPolys)
+        {
+          return CLEAN_STRIPS;
+        }
+        if (numNewPts == 3 || !this->ConvertPolysToLines)
+        {
+          return CLEAN_POLYS;
+        }
+        if (numNewPts == 2 || !this->ConvertLinesToPoints)
+        {
+          return CLEAN_LINES;
+        }
+        break;
+    }
+    return numNewPts == 1 ? CLEAN_VERTS : CLEAN_NONE;
+  }
+};
+
 } // anonymous namespace
 
 //---------------------------------------------------------------------------
@@ -174,7 +241,6 @@ int vtkStaticCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
     vtkDebugMacro(<< "No data to Operate On!");
     return 1;
   }
-  vtkIdType* updatedPts = new vtkIdType[input->GetMaxCellSize()];
 
   // we'll be needing these
   vtkIdType inCellID, newId;
@@ -205,26 +271,32 @@ int vtkStaticCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
   outCD->CopyAllocate(inCD);
 
   // Prefix sum: count the number of new points; allocate memory. Populate the
-  // point map (old points to new).
+  // point map (old points to new). The points kept are flagged, their flags
+  // are scanned into new ids, then merged points take the id of the point
+  // they are ultimately merged with.
   vtkIdType* pointMap = new vtkIdType[numPts];
-  vtkIdType id, numNewPts = 0;
-  // Count and map points to new points
-  for (id = 0; id < numPts; ++id)
-  {
-    if (mergeMap[id] == id)
+  vtkSMPTools::For(0, numPts, [&](vtkIdType id, vtkIdType endId) {
+    for (; id < endId; ++id)
     {
-      pointMap[id] = numNewPts++;
+      pointMap[id] = (mergeMap[id] == id ? 1 : 0);
     }
-  }
-  // Now map old merged points to new points
-  for (id = 0; id < numPts; ++id)
-  {
-    if (mergeMap[id] != id)
+  });
+  const vtkIdType numNewPts =
+    vtkSMPTools::ExclusiveScan(pointMap, pointMap + numPts, pointMap, vtkIdType(0));
+  vtkSMPTools::For(0, numPts, [&](vtkIdType id, vtkIdType endId) {
+    for (; id < endId; ++id)
     {
-      pointMap[id] = pointMap[mergeMap[id]];
+      vtkIdType mergeId = mergeMap[id];
+      if (mergeId != id)
+      {
+        while (mergeMap[mergeId] != mergeId)
+        {
+          mergeId = mergeMap[mergeId];
+        }
+        pointMap[id] = pointMap[mergeId];
+      }
     }
-  }
-  delete[] mergeMap;
+  });
 
   vtkPoints* newPts = inPts->NewInstance();
   if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
@@ -249,10 +321,26 @@ int vtkStaticCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
   using Dispatcher = vtkArrayDispatch::Dispatch2ByValueType<FastValueTypes, FastValueTypes>;
 
   CopyPointsLauncher launcher;
-  if (!Dispatcher::Execute(inArray, outArray, launcher, pointMap, inPD, numNewPts, outPD))
+  if (!Dispatcher::Execute(
+        inArray, outArray, launcher, pointMap, mergeMap, inPD, numNewPts, outPD))
   { // Fallback to slow path for unusual types:
-    launcher(inArray, outArray, pointMap, inPD, numNewPts, outPD);
+    launcher(inArray, outArray, pointMap, mergeMap, inPD, numNewPts, outPD);
+  }
+  delete[] mergeMap;
+
+  // Remap the cells in parallel when their data can be copied concurrently.
+  if (ArrayList::CanCopyInParallel(inCD))
+  {
+    StaticCleanClassifier classifier{ this->ConvertLinesToPoints != 0,
+      this->ConvertPolysToLines != 0, this->ConvertStripsToPolys != 0 };
+    CleanRemapCells(input, pointMap, classifier, inCD, outCD, output);
+    this->Locator->Initialize(); // release memory.
+    delete[] pointMap;
+    output->SetPoints(newPts);
+    newPts->Delete();
+    return 1;
   }
+  vtkIdType* updatedPts = new vtkIdType[input->GetMaxCellSize()];
 
   // Finally, remap the topology to use new point ids. Celldata needs to be
   // copied correctly. If a poly is converted to a line, or a line to a
@@ -14,20 +14,69 @@
 =========================================================================*/
 #include "vtkTensorGlyph.h"
 
+#include "vtkArrayListTemplate.h"
 #include "vtkCell.h"
 #include "vtkCellArray.h"
 #include "vtkDataSet.h"
 #include "vtkExecutive.h"
 #include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkMatrix4x4.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTransform.h"
 
+#include <vector>
+
+namespace
+{
+// Apply the glyph matrix to the source points and write them to the output.
+void TransformGlyphPoints(const double* matrix, const double* in, vtkIdType numPts, float* out)
+{
+  for (vtkIdType i = 0; i < numPts; ++i, in += 3, out += 3)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      out[j] = static_cast<float>(matrix[4 * j] * in[0] + matrix[4 * j + 1] * in[1] +
+        matrix[4 * j + 2] * in[2] + matrix[4 * j + 3]);
+    }
+  }
+}
+
+// Apply the transposed inverse of the glyph matrix to the source normals,
+// normalize them and write them to the output.
+void TransformGlyphNormals(
+  const double* matrix, vtkDataArray* inNormals, vtkIdType numPts, float* out)
+{
+  double normalMatrix[16];
+  vtkMatrix4x4::Invert(matrix, normalMatrix);
+  vtkMatrix4x4::Transpose(normalMatrix, normalMatrix);
+  for (vtkIdType i = 0; i < numPts; ++i, out += 3)
+  {
+    double in[3], normal[3];
+    inNormals->GetTuple(i, in);
+    for (int j = 0; j < 3; ++j)
+    {
+      normal[j] = normalMatrix[4 * j] * in[0] + normalMatrix[4 * j + 1] * in[1] +
+        normalMatrix[4 * j + 2] * in[2];
+    }
+    vtkMath::Normalize(normal);
+    out[0] = static_cast<float>(normal[0]);
+    out[1] = static_cast<float>(normal[1]);
+    out[2] = static_cast<float>(normal[2]);
+  }
+}
+}
+
 vtkStandardNewMacro(vtkTensorGlyph);
 
 //----------------------------------------------------------------------------
@@ -103,42 +152,17 @@ int vtkTensorGlyph::RequestData(vtkInformation* vtkNotUsed(request),
   vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
   vtkDataArray* inTensors;
-  double tensor[9];
   vtkDataArray* inScalars;
-  vtkIdType numPts, numSourcePts, numSourceCells, inPtId, i;
-  int j;
+  vtkIdType numPts, numSourcePts;
   vtkPoints* sourcePts;
   vtkDataArray* sourceNormals;
-  vtkCellArray *sourceCells, *cells;
   vtkPoints* newPts;
   vtkFloatArray* newScalars = nullptr;
   vtkFloatArray* newNormals = nullptr;
-  double x[3], s;
-  vtkTransform* trans;
-  vtkCell* cell;
-  vtkIdList* cellPts;
-  int npts;
-  vtkIdType* pts;
-  vtkIdType ptIncr, cellId;
-  vtkIdType subIncr;
-  int numDirs, dir, eigen_dir, symmetric_dir;
-  vtkMatrix4x4* matrix;
-  double *m[3], w[3], *v[3];
-  double m0[3], m1[3], m2[3];
-  double v0[3], v1[3], v2[3];
-  double xv[3], yv[3], zv[3];
-  double maxScale;
+  int numDirs;
 
   numDirs = (this->ThreeGlyphs ? 3 : 1) * (this->Symmetric + 1);
 
-  // set up working matrices
-  m[0] = m0;
-  m[1] = m1;
-  m[2] = m2;
-  v[0] = v0;
-  v[1] = v1;
-  v[2] = v2;
-
   vtkDebugMacro(<< "Generating tensor glyphs");
 
   vtkPointData* outPD = output->GetPointData();
@@ -152,59 +176,64 @@ int vtkTensorGlyph::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
-  pts = new vtkIdType[source->GetMaxCellSize()];
-  trans = vtkTransform::New();
-  matrix = vtkMatrix4x4::New();
-
   //
   // Allocate storage for output PolyData
   //
   sourcePts = source->GetPoints();
   numSourcePts = sourcePts->GetNumberOfPoints();
-  numSourceCells = source->GetNumberOfCells();
+  const vtkIdType numOutPts = numDirs * numPts * numSourcePts;
 
   newPts = vtkPoints::New();
-  newPts->Allocate(numDirs * numPts * numSourcePts);
+  newPts->SetNumberOfPoints(numOutPts);
 
-  // Setting up for calls to PolyData::InsertNextCell()
-  if ((sourceCells = source->GetVerts())->GetNumberOfCells() > 0)
-  {
-    cells = vtkCellArray::New();
-    cells->AllocateEstimate(sourceCells->GetNumberOfCells(), numDirs * numPts);
-    output->SetVerts(cells);
-    cells->Delete();
-  }
-  if ((sourceCells = this->GetSource()->GetLines())->GetNumberOfCells() > 0)
-  {
-    cells = vtkCellArray::New();
-    cells->AllocateEstimate(sourceCells->GetNumberOfCells(), numDirs * numPts);
-    output->SetLines(cells);
-    cells->Delete();
-  }
-  if ((sourceCells = this->GetSource()->GetPolys())->GetNumberOfCells() > 0)
+  // The source points, in double precision, to be transformed concurrently.
+  std::vector<double> sourceCoords(3 * numSourcePts);
+  for (vtkIdType i = 0; i < numSourcePts; i++)
   {
-    cells = vtkCellArray::New();
-    cells->AllocateEstimate(sourceCells->GetNumberOfCells(), numDirs * numPts);
-    output->SetPolys(cells);
-    cells->Delete();
+    sourcePts->GetPoint(i, sourceCoords.data() + 3 * i);
   }
-  if ((sourceCells = this->GetSource()->GetStrips())->GetNumberOfCells() > 0)
+
+  // Each source cell is copied once per direction, for each input point, so
+  // the offsets of the cells of the glyphs in the output are known upfront.
+  vtkCellArray* sourceCellArrays[4] = { source->GetVerts(), source->GetLines(),
+    source->GetPolys(), source->GetStrips() };
+  std::vector<vtkIdType> sourceOffsets[4];
+  std::vector<vtkIdType> sourceConnectivity[4];
+  vtkNew<vtkIdTypeArray> outOffsets[4];
+  vtkNew<vtkIdTypeArray> outConnectivity[4];
+  vtkNew<vtkIdList> cellPts;
+  for (int type = 0; type < 4; type++)
   {
-    cells = vtkCellArray::New();
-    cells->AllocateEstimate(sourceCells->GetNumberOfCells(), numDirs * numPts);
-    output->SetStrips(cells);
-    cells->Delete();
+    const vtkIdType numSourceCells = sourceCellArrays[type]->GetNumberOfCells();
+    sourceOffsets[type].assign(1, 0);
+    for (vtkIdType cellId = 0; cellId < numSourceCells; cellId++)
+    {
+      sourceCellArrays[type]->GetCellAtId(cellId, cellPts);
+      sourceConnectivity[type].insert(
+        sourceConnectivity[type].end(), cellPts->begin(), cellPts->end());
+      sourceOffsets[type].push_back(static_cast<vtkIdType>(sourceConnectivity[type].size()));
+    }
+    const vtkIdType numOutCells = numDirs * numPts * numSourceCells;
+    const vtkIdType connectivitySize =
+      numDirs * numPts * static_cast<vtkIdType>(sourceConnectivity[type].size());
+    outOffsets[type]->SetNumberOfValues(numOutCells + 1);
+    outOffsets[type]->SetValue(numOutCells, connectivitySize);
+    outConnectivity[type]->SetNumberOfValues(connectivitySize);
   }
 
-  // only copy scalar data through
+  // only copy scalar data through, by the threads when it can be copied
+  // concurrently, else on the calling thread once the glyphs are generated
   vtkPointData* pd = this->GetSource()->GetPointData();
+  ArrayList pointArrays;
+  bool copyPointData = false;
+  const bool copyInParallel = ArrayList::CanCopyInParallel(pd);
   // generate scalars if eigenvalues are chosen or if scalars exist.
   if (this->ColorGlyphs &&
     ((this->ColorMode == COLOR_BY_EIGENVALUES) ||
       (inScalars && (this->ColorMode == COLOR_BY_SCALARS))))
   {
     newScalars = vtkFloatArray::New();
-    newScalars->Allocate(numDirs * numPts * numSourcePts);
+    newScalars->SetNumberOfTuples(numOutPts);
     if (this->ColorMode == COLOR_BY_EIGENVALUES)
     {
       newScalars->SetName("MaxEigenvalue");
@@ -218,253 +247,323 @@ int vtkTensorGlyph::RequestData(vtkInformation* vtkNotUsed(request),
   {
     outPD->CopyAllOff();
     outPD->CopyScalarsOn();
-    outPD->CopyAllocate(pd, numDirs * numPts * numSourcePts);
+    outPD->CopyAllocate(pd, numOutPts);
+    copyPointData = true;
+    if (copyInParallel)
+    {
+      pointArrays.AddArrays(numOutPts, pd, outPD, 0.0, false);
+    }
   }
   if ((sourceNormals = pd->GetNormals()))
   {
     newNormals = vtkFloatArray::New();
     newNormals->SetNumberOfComponents(3);
     newNormals->SetName("Normals");
-    newNormals->Allocate(numDirs * 3 * numPts * numSourcePts);
+    newNormals->SetNumberOfTuples(numOutPts);
   }
+
+  // Make sure the lazily built structures of the input are ready before the
+  // threads query it.
+  double x[3];
+  input->GetPoint(0, x);
+
   //
-  // First copy all topology (transformation independent)
+  // Traverse all Input points concurrently, copying the topology and
+  // transforming the glyphs at Source points
   //
-  for (inPtId = 0; inPtId < numPts; inPtId++)
-  {
-    ptIncr = numDirs * inPtId * numSourcePts;
-    for (cellId = 0; cellId < numSourceCells; cellId++)
+  vtkSMPThreadLocalObject<vtkTransform> localTransforms;
+  vtkSMPThreadLocalObject<vtkMatrix4x4> localMatrices;
+  vtkSMPTools::For(0, numPts, [&](vtkIdType beginPtId, vtkIdType endPtId) {
+    vtkTransform* trans = localTransforms.Local();
+    vtkMatrix4x4* matrix = localMatrices.Local();
+    double tensor[9];
+    double *m[3], w[3], *v[3];
+    double m0[3], m1[3], m2[3];
+    double v0[3], v1[3], v2[3];
+    double xv[3], yv[3], zv[3], xPt[3];
+    double maxScale, s;
+    vtkIdType i, ptIncr;
+    int j, dir, eigen_dir, symmetric_dir;
+
+    // set up working matrices
+    m[0] = m0;
+    m[1] = m1;
+    m[2] = m2;
+    v[0] = v0;
+    v[1] = v1;
+    v[2] = v2;
+
+    trans->PreMultiply();
+
+    for (vtkIdType inPtId = beginPtId; inPtId < endPtId; inPtId++)
     {
-      cell = this->GetSource()->GetCell(cellId);
-      cellPts = cell->GetPointIds();
-      npts = cellPts->GetNumberOfIds();
-      for (dir = 0; dir < numDirs; dir++)
+      ptIncr = numDirs * inPtId * numSourcePts;
+
+      // Copy all topology (transformation independent)
+      for (int type = 0; type < 4; type++)
       {
-        // This variable may be removed, but that
-        // will not improve readability
-        subIncr = ptIncr + dir * numSourcePts;
-        for (i = 0; i < npts; i++)
+        const std::vector<vtkIdType>& offsets = sourceOffsets[type];
+        const std::vector<vtkIdType>& connectivity = sourceConnectivity[type];
+        const vtkIdType numSourceCells = static_cast<vtkIdType>(offsets.size()) - 1;
+        const vtkIdType connectivitySize = static_cast<vtkIdType>(connectivity.size());
+        vtkIdType* cellOffsets = outOffsets[type]->GetPointer(numDirs * inPtId * numSourceCells);
+        vtkIdType connIncr = numDirs * inPtId * connectivitySize;
+        vtkIdType* cellPtIds = outConnectivity[type]->GetPointer(connIncr);
+        for (vtkIdType cellId = 0; cellId < numSourceCells; cellId++)
         {
-          pts[i] = cellPts->GetId(i) + subIncr;
+          for (dir = 0; dir < numDirs; dir++)
+          {
+            // This variable may be removed, but that
+            // will not improve readability
+            const vtkIdType subIncr = ptIncr + dir * numSourcePts;
+            *cellOffsets++ = connIncr;
+            for (i = offsets[cellId]; i < offsets[cellId + 1]; i++)
+            {
+              *cellPtIds++ = connectivity[i] + subIncr;
+            }
+            connIncr += offsets[cellId + 1] - offsets[cellId];
+          }
         }
-        output->InsertNextCell(cell->GetCellType(), npts, pts);
       }
-    }
-  }
-  //
-  // Traverse all Input points, transforming glyph at Source points
-  //
-  trans->PreMultiply();
-
-  for (inPtId = 0; inPtId < numPts; inPtId++)
-  {
-    ptIncr = numDirs * inPtId * numSourcePts;
 
-    // Translation is postponed
-    // Symmetric tensor support
-    inTensors->GetTuple(inPtId, tensor);
-    if (inTensors->GetNumberOfComponents() == 6)
-    {
-      vtkMath::TensorFromSymmetricTensor(tensor);
-    }
+      // Translation is postponed
+      // Symmetric tensor support
+      inTensors->GetTuple(inPtId, tensor);
+      if (inTensors->GetNumberOfComponents() == 6)
+      {
+        vtkMath::TensorFromSymmetricTensor(tensor);
+      }
 
-    // compute orientation vectors and scale factors from tensor
-    if (this->ExtractEigenvalues) // extract appropriate eigenfunctions
-    {
-      // We are interested in the symmetrical part of the tensor only, since
-      // eigenvalues are real if and only if the matrice of reals is symmetrical
-      for (j = 0; j < 3; j++)
+      // compute orientation vectors and scale factors from tensor
+      if (this->ExtractEigenvalues) // extract appropriate eigenfunctions
       {
-        for (i = 0; i < 3; i++)
+        // We are interested in the symmetrical part of the tensor only, since
+        // eigenvalues are real if and only if the matrice of reals is symmetrical
+        for (j = 0; j < 3; j++)
         {
-          m[i][j] = 0.5 * (tensor[i + 3 * j] + tensor[j + 3 * i]);
+          for (i = 0; i < 3; i++)
+          {
+            m[i][j] = 0.5 * (tensor[i + 3 * j] + tensor[j + 3 * i]);
+          }
         }
+        vtkMath::Jacobi(m, w, v);
+
+        // copy eigenvectors
+        xv[0] = v[0][0];
+        xv[1] = v[1][0];
+        xv[2] = v[2][0];
+        yv[0] = v[0][1];
+        yv[1] = v[1][1];
+        yv[2] = v[2][1];
+        zv[0] = v[0][2];
+        zv[1] = v[1][2];
+        zv[2] = v[2][2];
       }
-      vtkMath::Jacobi(m, w, v);
-
-      // copy eigenvectors
-      xv[0] = v[0][0];
-      xv[1] = v[1][0];
-      xv[2] = v[2][0];
-      yv[0] = v[0][1];
-      yv[1] = v[1][1];
-      yv[2] = v[2][1];
-      zv[0] = v[0][2];
-      zv[1] = v[1][2];
-      zv[2] = v[2][2];
-    }
-    else // use tensor columns as eigenvectors
-    {
-      for (i = 0; i < 3; i++)
+      else // use tensor columns as eigenvectors
       {
-        xv[i] = tensor[i];
-        yv[i] = tensor[i + 3];
-        zv[i] = tensor[i + 6];
+        for (i = 0; i < 3; i++)
+        {
+          xv[i] = tensor[i];
+          yv[i] = tensor[i + 3];
+          zv[i] = tensor[i + 6];
+        }
+        w[0] = vtkMath::Normalize(xv);
+        w[1] = vtkMath::Normalize(yv);
+        w[2] = vtkMath::Normalize(zv);
       }
-      w[0] = vtkMath::Normalize(xv);
-      w[1] = vtkMath::Normalize(yv);
-      w[2] = vtkMath::Normalize(zv);
-    }
 
-    // compute scale factors
-    w[0] *= this->ScaleFactor;
-    w[1] *= this->ScaleFactor;
-    w[2] *= this->ScaleFactor;
+      // compute scale factors
+      w[0] *= this->ScaleFactor;
+      w[1] *= this->ScaleFactor;
+      w[2] *= this->ScaleFactor;
 
-    if (this->ClampScaling)
-    {
-      for (maxScale = 0.0, i = 0; i < 3; i++)
+      if (this->ClampScaling)
       {
-        if (maxScale < fabs(w[i]))
+        for (maxScale = 0.0, i = 0; i < 3; i++)
         {
-          maxScale = fabs(w[i]);
+          if (maxScale < fabs(w[i]))
+          {
+            maxScale = fabs(w[i]);
+          }
         }
-      }
-      if (maxScale > this->MaxScaleFactor)
-      {
-        maxScale = this->MaxScaleFactor / maxScale;
-        for (i = 0; i < 3; i++)
+        if (maxScale > this->MaxScaleFactor)
         {
-          w[i] *= maxScale; // preserve overall shape of glyph
+          maxScale = this->MaxScaleFactor / maxScale;
+          for (i = 0; i < 3; i++)
+          {
+            w[i] *= maxScale; // preserve overall shape of glyph
+          }
         }
       }
-    }
 
-    // normalization is postponed
+      // normalization is postponed
 
-    // make sure scale is okay (non-zero) and scale data
-    for (maxScale = 0.0, i = 0; i < 3; i++)
-    {
-      if (w[i] > maxScale)
+      // make sure scale is okay (non-zero) and scale data
+      for (maxScale = 0.0, i = 0; i < 3; i++)
       {
-        maxScale = w[i];
+        if (w[i] > maxScale)
+        {
+          maxScale = w[i];
+        }
       }
-    }
-    if (maxScale == 0.0)
-    {
-      maxScale = 1.0;
-    }
-    for (i = 0; i < 3; i++)
-    {
-      if (w[i] == 0.0)
+      if (maxScale == 0.0)
       {
-        w[i] = maxScale * 1.0e-06;
+        maxScale = 1.0;
       }
-    }
-
-    // Now do the real work for each "direction"
-
-    for (dir = 0; dir < numDirs; dir++)
-    {
-      eigen_dir = dir % (this->ThreeGlyphs ? 3 : 1);
-      symmetric_dir = dir / (this->ThreeGlyphs ? 3 : 1);
-
-      // Remove previous scales ...
-      trans->Identity();
-
-      // translate Source to Input point
-      input->GetPoint(inPtId, x);
-      trans->Translate(x[0], x[1], x[2]);
-
-      // normalized eigenvectors rotate object for eigen direction 0
-      matrix->Element[0][0] = xv[0];
-      matrix->Element[0][1] = yv[0];
-      matrix->Element[0][2] = zv[0];
-      matrix->Element[1][0] = xv[1];
-      matrix->Element[1][1] = yv[1];
-      matrix->Element[1][2] = zv[1];
-      matrix->Element[2][0] = xv[2];
-      matrix->Element[2][1] = yv[2];
-      matrix->Element[2][2] = zv[2];
-      trans->Concatenate(matrix);
-
-      if (eigen_dir == 1)
+      for (i = 0; i < 3; i++)
       {
-        trans->RotateZ(90.0);
+        if (w[i] == 0.0)
+        {
+          w[i] = maxScale * 1.0e-06;
+        }
       }
 
-      if (eigen_dir == 2)
-      {
-        trans->RotateY(-90.0);
-      }
+      // Now do the real work for each "direction"
 
-      if (this->ThreeGlyphs)
-      {
-        trans->Scale(w[eigen_dir], this->ScaleFactor, this->ScaleFactor);
-      }
-      else
+      for (dir = 0; dir < numDirs; dir++)
       {
-        trans->Scale(w[0], w[1], w[2]);
-      }
+        eigen_dir = dir % (this->ThreeGlyphs ? 3 : 1);
+        symmetric_dir = dir / (this->ThreeGlyphs ? 3 : 1);
+
+        // Remove previous scales ...
+        trans->Identity();
+
+        // translate Source to Input point
+        input->GetPoint(inPtId, xPt);
+        trans->Translate(xPt[0], xPt[1], xPt[2]);
+
+        // normalized eigenvectors rotate object for eigen direction 0
+        matrix->Element[0][0] = xv[0];
+        matrix->Element[0][1] = yv[0];
+        matrix->Element[0][2] = zv[0];
+        matrix->Element[1][0] = xv[1];
+        matrix->Element[1][1] = yv[1];
+        matrix->Element[1][2] = zv[1];
+        matrix->Element[2][0] = xv[2];
+        matrix->Element[2][1] = yv[2];
+        matrix->Element[2][2] = zv[2];
+        trans->Concatenate(matrix);
+
+        if (eigen_dir == 1)
+        {
+          trans->RotateZ(90.0);
+        }
 
-      // Mirror second set to the symmetric position
-      if (symmetric_dir == 1)
-      {
-        trans->Scale(-1., 1., 1.);
-      }
+        if (eigen_dir == 2)
+        {
+          trans->RotateY(-90.0);
+        }
 
-      // if the eigenvalue is negative, shift to reverse direction.
-      // The && is there to ensure that we do not change the
-      // old behaviour of vtkTensorGlyphs (which only used one dir),
-      // in case there is an oriented glyph, e.g. an arrow.
-      if (w[eigen_dir] < 0 && numDirs > 1)
-      {
-        trans->Translate(-this->Length, 0., 0.);
-      }
+        if (this->ThreeGlyphs)
+        {
+          trans->Scale(w[eigen_dir], this->ScaleFactor, this->ScaleFactor);
+        }
+        else
+        {
+          trans->Scale(w[0], w[1], w[2]);
+        }
 
-      // multiply points (and normals if available) by resulting
-      // matrix
-      trans->TransformPoints(sourcePts, newPts);
+        // Mirror second set to the symmetric position
+        if (symmetric_dir == 1)
+        {
+          trans->Scale(-1., 1., 1.);
+        }
 
-      // Apply the transformation to a series of points,
-      // and append the results to outPts.
-      if (newNormals)
-      {
-        // a negative determinant means the transform turns the
-        // glyph surface inside out, and its surface normals all
-        // point inward. The following scale corrects the surface
-        // normals to point outward.
-        if (trans->GetMatrix()->Determinant() < 0)
+        // if the eigenvalue is negative, shift to reverse direction.
+        // The && is there to ensure that we do not change the
+        // old behaviour of vtkTensorGlyphs (which only used one dir),
+        // in case there is an oriented glyph, e.g. an arrow.
+        if (w[eigen_dir] < 0 && numDirs > 1)
         {
-          trans->Scale(-1.0, -1.0, -1.0);
+          trans->Translate(-this->Length, 0., 0.);
         }
-        trans->TransformNormals(sourceNormals, newNormals);
-      }
 
-      // Copy point data from source
-      if (this->ColorGlyphs && inScalars && (this->ColorMode == COLOR_BY_SCALARS))
-      {
-        s = inScalars->GetComponent(inPtId, 0);
-        for (i = 0; i < numSourcePts; i++)
+        // multiply points (and normals if available) by resulting
+        // matrix
+        TransformGlyphPoints(trans->GetMatrix()->GetData(), sourceCoords.data(), numSourcePts,
+          static_cast<float*>(newPts->GetData()->GetVoidPointer(3 * ptIncr)));
+
+        // Apply the transformation to a series of points,
+        // and append the results to outPts.
+        if (newNormals)
         {
-          newScalars->InsertTuple(ptIncr + i, &s);
+          // a negative determinant means the transform turns the
+          // glyph surface inside out, and its surface normals all
+          // point inward. The following scale corrects the surface
+          // normals to point outward.
+          if (trans->GetMatrix()->Determinant() < 0)
+          {
+            trans->Scale(-1.0, -1.0, -1.0);
+          }
+          TransformGlyphNormals(trans->GetMatrix()->GetData(), sourceNormals, numSourcePts,
+            newNormals->GetPointer(3 * ptIncr));
         }
-      }
-      else if (this->ColorGlyphs && (this->ColorMode == COLOR_BY_EIGENVALUES))
-      {
-        // If ThreeGlyphs is false we use the first (largest)
-        // eigenvalue as scalar.
-        s = w[eigen_dir];
-        for (i = 0; i < numSourcePts; i++)
+
+        // Copy point data from source
+        if (this->ColorGlyphs && inScalars && (this->ColorMode == COLOR_BY_SCALARS))
         {
-          newScalars->InsertTuple(ptIncr + i, &s);
+          s = inScalars->GetComponent(inPtId, 0);
+          for (i = 0; i < numSourcePts; i++)
+          {
+            newScalars->SetTuple(ptIncr + i, &s);
+          }
         }
-      }
-      else
-      {
-        for (i = 0; i < numSourcePts; i++)
+        else if (this->ColorGlyphs && (this->ColorMode == COLOR_BY_EIGENVALUES))
         {
-          outPD->CopyData(pd, i, ptIncr + i);
+          // If ThreeGlyphs is false we use the first (largest)
+          // eigenvalue as scalar.
+          s = w[eigen_dir];
+          for (i = 0; i < numSourcePts; i++)
+          {
+            newScalars->SetTuple(ptIncr + i, &s);
+          }
         }
+        else if (copyInParallel)
+        {
+          for (i = 0; i < numSourcePts; i++)
+          {
+            pointArrays.Copy(i, ptIncr + i);
+          }
+        }
+        ptIncr += numSourcePts;
       }
-      ptIncr += numSourcePts;
+    }
+  });
+  if (copyPointData && !copyInParallel)
+  {
+    // Every glyph copies the point data of all the source points.
+    for (vtkIdType outPtId = 0; outPtId < numOutPts; outPtId++)
+    {
+      outPD->CopyData(pd, outPtId % numSourcePts, outPtId);
     }
   }
   vtkDebugMacro(<< "Generated " << numPts << " tensor glyphs");
   //
   // Update output and release memory
   //
-  delete[] pts;
+  for (int type = 0; type < 4; type++)
+  {
+    if (sourceCellArrays[type]->GetNumberOfCells() > 0)
+    {
+      vtkNew<vtkCellArray> cells;
+      cells->SetData(outOffsets[type], outConnectivity[type]);
+      switch (type)
+      {
+        case 0:
+          output->SetVerts(cells);
+          break;
+        case 1:
+          output->SetLines(cells);
+          break;
+        case 2:
+          output->SetPolys(cells);
+          break;
+        default:
+          output->SetStrips(cells);
+          break;
+      }
+    }
+  }
 
   output->SetPoints(newPts);
   newPts->Delete();
@@ -483,8 +582,6 @@ int vtkTensorGlyph::RequestData(vtkInformation* vtkNotUsed(request),
   }
 
   output->Squeeze();
-  trans->Delete();
-  matrix->Delete();
 
   return 1;
 }
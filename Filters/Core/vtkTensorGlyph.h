@@ -74,6 +74,10 @@
  * additional capability over the vtkGlyph3D object. That is, the
  * glyph can be oriented in three directions instead of one.
  *
+ * The glyphs of the input points are generated in parallel with
+ * vtkSMPTools. Since every input point gets the same number of glyphs, their
+ * offsets in the output are known upfront.
+ *
  * @par Thanks:
  * Thanks to Jose Paulo Moitinho de Almeida for enhancements.
  *
@@ -14,21 +14,51 @@
 =========================================================================*/
 #include "vtkThreshold.h"
 
-#include "vtkCell.h"
+#include "vtkArrayListTemplate.h" // For processing attribute data
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
 #include <algorithm>
+#include <atomic>
+#include <vector>
 
 vtkStandardNewMacro(vtkThreshold);
 
+namespace
+{
+//----------------------------------------------------------------------------
+// The distinct points of a polyhedron face stream, sorted, which is the
+// connectivity vtkUnstructuredGrid::InsertNextCell() gives a polyhedron.
+void GetPolyhedronPoints(vtkIdList* faceStream, std::vector<vtkIdType>& pts)
+{
+  pts.clear();
+  const vtkIdType* stream = faceStream->GetPointer(0);
+  const vtkIdType numFaces = faceStream->GetNumberOfIds() > 0 ? *stream++ : 0;
+  for (vtkIdType face = 0; face < numFaces; ++face)
+  {
+    const vtkIdType numFacePts = *stream++;
+    pts.insert(pts.end(), stream, stream + numFacePts);
+    stream += numFacePts;
+  }
+  std::sort(pts.begin(), pts.end());
+  pts.erase(std::unique(pts.begin(), pts.end()), pts.end());
+}
+}
+
 // Construct with lower threshold=0, upper threshold=1, and threshold
 // function=upper AllScalars=1.
 vtkThreshold::vtkThreshold()
@@ -48,6 +78,7 @@ vtkThreshold::vtkThreshold()
 
   this->UseContinuousCellRange = 0;
   this->Invert = false;
+  this->CompactPoints = true;
 }
 
 vtkThreshold::~vtkThreshold() = default;
@@ -120,7 +151,6 @@ int vtkThreshold::RequestData(vtkInformation* vtkNotUsed(request),
   vtkIdType cellId, newCellId;
   vtkIdList *cellPts, *pointMap;
   vtkIdList* newCellPts;
-  vtkCell* cell;
   vtkPoints* newPoints;
   vtkIdType i, ptId, newId, numPts;
   int numCellPts;
@@ -146,95 +176,72 @@ int vtkThreshold::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
-  outPD->CopyGlobalIdsOn();
-  outPD->CopyAllocate(pd);
-  outCD->CopyGlobalIdsOn();
-  outCD->CopyAllocate(cd);
-
-  numPts = input->GetNumberOfPoints();
-  output->Allocate(input->GetNumberOfCells());
-
-  newPoints = vtkPoints::New();
-
   // set precision for the points in the output
+  vtkPointSet* inputPointSet = vtkPointSet::SafeDownCast(input);
+  int pointsType = VTK_FLOAT;
   if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
   {
-    vtkPointSet* inputPointSet = vtkPointSet::SafeDownCast(input);
     if (inputPointSet && inputPointSet->GetPoints())
     {
-      newPoints->SetDataType(inputPointSet->GetPoints()->GetDataType());
-    }
-    else
-    {
-      newPoints->SetDataType(VTK_FLOAT);
+      pointsType = inputPointSet->GetPoints()->GetDataType();
     }
   }
-  else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
-  {
-    newPoints->SetDataType(VTK_FLOAT);
-  }
   else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
   {
-    newPoints->SetDataType(VTK_DOUBLE);
+    pointsType = VTK_DOUBLE;
   }
 
-  newPoints->Allocate(numPts);
+  // are we using pointScalars?
+  int fieldAssociation = this->GetInputArrayAssociation(0, inputVector);
+  bool usePointScalars = fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_POINTS;
 
-  pointMap = vtkIdList::New(); // maps old point ids into new
-  pointMap->SetNumberOfIds(numPts);
-  for (i = 0; i < numPts; i++)
+  if (this->ThreadedRequestData(input, inScalars, usePointScalars, pointsType, output))
   {
-    pointMap->SetId(i, -1);
+    vtkDebugMacro(<< "Extracted " << output->GetNumberOfCells() << " number of cells.");
+    return 1;
   }
 
-  newCellPts = vtkIdList::New();
+  numPts = input->GetNumberOfPoints();
+  output->Allocate(input->GetNumberOfCells());
 
-  // are we using pointScalars?
-  int fieldAssociation = this->GetInputArrayAssociation(0, inputVector);
-  bool usePointScalars = fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_POINTS;
+  newPoints = vtkPoints::New();
+  newPoints->SetDataType(pointsType);
 
-  // Check that the scalars of each cell satisfy the threshold criterion
-  for (cellId = 0; cellId < input->GetNumberOfCells(); cellId++)
+  pointMap = vtkIdList::New(); // maps old point ids into new
+  pointMap->SetNumberOfIds(numPts);
+  if (this->CompactPoints)
   {
-    cell = input->GetCell(cellId);
-    cellPts = cell->GetPointIds();
-    numCellPts = cell->GetNumberOfPoints();
-
-    if (usePointScalars)
+    outPD->CopyGlobalIdsOn();
+    outPD->CopyAllocate(pd);
+    newPoints->Allocate(numPts);
+    for (i = 0; i < numPts; i++)
     {
-      if (this->AllScalars)
-      {
-        keepCell = 1;
-        for (i = 0; keepCell && (i < numCellPts); i++)
-        {
-          ptId = cellPts->GetId(i);
-          keepCell = this->EvaluateComponents(inScalars, ptId);
-        }
-      }
-      else
-      {
-        if (!this->UseContinuousCellRange)
-        {
-          keepCell = 0;
-          for (i = 0; (!keepCell) && (i < numCellPts); i++)
-          {
-            ptId = cellPts->GetId(i);
-            keepCell = this->EvaluateComponents(inScalars, ptId);
-          }
-        }
-        else
-        {
-          keepCell = this->EvaluateCell(inScalars, cellPts, numCellPts);
-        }
-      }
+      pointMap->SetId(i, -1);
     }
-    else // use cell scalars
+  }
+  else
+  {
+    outPD->PassData(pd);
+    newPoints->SetNumberOfPoints(numPts);
+    for (i = 0; i < numPts; i++)
     {
-      keepCell = this->EvaluateComponents(inScalars, cellId);
+      input->GetPoint(i, x);
+      newPoints->SetPoint(i, x);
+      pointMap->SetId(i, i);
     }
+  }
+  outCD->CopyGlobalIdsOn();
+  outCD->CopyAllocate(cd);
 
-    // Invert the keep flag if the Invert option is enabled.
-    keepCell = this->Invert ? (1 - keepCell) : keepCell;
+  cellPts = vtkIdList::New();
+  newCellPts = vtkIdList::New();
+
+  // Check that the scalars of each cell satisfy the threshold criterion
+  for (cellId = 0; cellId < input->GetNumberOfCells(); cellId++)
+  {
+    input->GetCellPoints(cellId, cellPts);
+    numCellPts = cellPts->GetNumberOfIds();
+    keepCell = this->KeepCell(inScalars, usePointScalars, cellId, cellPts);
 
     if (numCellPts > 0 && keepCell)
     {
@@ -258,7 +265,7 @@ int vtkThreshold::RequestData(vtkInformation* vtkNotUsed(request),
         vtkUnstructuredGrid::SafeDownCast(input)->GetFaceStream(cellId, newCellPts);
         vtkUnstructuredGrid::ConvertFaceStreamPointIds(newCellPts, pointMap->GetPointer(0));
       }
-      newCellId = output->InsertNextCell(cell->GetCellType(), newCellPts);
+      newCellId = output->InsertNextCell(input->GetCellType(cellId), newCellPts);
       outCD->CopyData(cd, cellId, newCellId);
       newCellPts->Reset();
     } // satisfied thresholding
@@ -268,9 +275,18 @@ int vtkThreshold::RequestData(vtkInformation* vtkNotUsed(request),
 
   // now clean up / update ourselves
   pointMap->Delete();
+  cellPts->Delete();
   newCellPts->Delete();
 
-  output->SetPoints(newPoints);
+  if (!this->CompactPoints && inputPointSet && inputPointSet->GetPoints() &&
+    inputPointSet->GetPoints()->GetDataType() == pointsType)
+  {
+    output->SetPoints(inputPointSet->GetPoints());
+  }
+  else
+  {
+    output->SetPoints(newPoints);
+  }
   newPoints->Delete();
 
   output->Squeeze();
@@ -278,6 +294,330 @@ int vtkThreshold::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//----------------------------------------------------------------------------
+bool vtkThreshold::ThreadedRequestData(vtkDataSet* input, vtkDataArray* inScalars,
+  bool usePointScalars, int pointsType, vtkUnstructuredGrid* output)
+{
+  vtkPointData* pd = input->GetPointData();
+  vtkCellData* cd = input->GetCellData();
+  if ((this->CompactPoints && !ArrayList::CanCopyInParallel(pd)) ||
+    !ArrayList::CanCopyInParallel(cd))
+  {
+    return false;
+  }
+
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+  vtkUnstructuredGrid* inputGrid = vtkUnstructuredGrid::SafeDownCast(input);
+  const bool hasPolyhedra = inputGrid && inputGrid->GetFaces();
+
+  // These methods are only thread safe once they have been called from a
+  // single thread.
+  if (numCells > 0)
+  {
+    vtkNew<vtkIdList> ids;
+    input->GetCellPoints(0, ids);
+    input->GetCellType(0);
+  }
+  if (numPts > 0)
+  {
+    double x[3];
+    input->GetPoint(0, x);
+  }
+
+  // Flag the cells to keep with the size of their connectivity, which is the
+  // number of distinct points of their faces for polyhedra, and the size of
+  // their face stream.
+  std::vector<vtkIdType> cellSizes(numCells + 1);
+  std::vector<vtkIdType> connSizes(numCells + 1);
+  std::vector<vtkIdType> faceSizes(hasPolyhedra ? numCells + 1 : 0);
+  vtkSMPThreadLocalObject<vtkIdList> tlCellPts;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> tlPolyhedronPts;
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    vtkIdList* cellPts = tlCellPts.Local();
+    for (; cellId < endCellId; ++cellId)
+    {
+      input->GetCellPoints(cellId, cellPts);
+      const vtkIdType numCellPts = cellPts->GetNumberOfIds();
+      const bool keepCell =
+        numCellPts > 0 && this->KeepCell(inScalars, usePointScalars, cellId, cellPts);
+      cellSizes[cellId] = keepCell ? numCellPts : 0;
+      connSizes[cellId] = cellSizes[cellId];
+      if (hasPolyhedra)
+      {
+        faceSizes[cellId] = 0;
+        if (keepCell && inputGrid->GetCellType(cellId) == VTK_POLYHEDRON)
+        {
+          inputGrid->GetFaceStream(cellId, cellPts);
+          std::vector<vtkIdType>& pts = tlPolyhedronPts.Local();
+          GetPolyhedronPoints(cellPts, pts);
+          connSizes[cellId] = static_cast<vtkIdType>(pts.size());
+          faceSizes[cellId] = cellPts->GetNumberOfIds();
+        }
+      }
+    }
+  });
+
+  // The output cells are the kept cells, in the same order. A cell is kept
+  // when it uses points, so its slots in the scans are distinct.
+  const vtkIdType zero = 0;
+  const vtkIdType numUses =
+    vtkSMPTools::ExclusiveScan(cellSizes.begin(), cellSizes.end() - 1, cellSizes.begin(), zero);
+  cellSizes[numCells] = numUses;
+  const vtkIdType connSize =
+    vtkSMPTools::ExclusiveScan(connSizes.begin(), connSizes.end() - 1, connSizes.begin(), zero);
+  connSizes[numCells] = connSize;
+  vtkIdType facesSize = 0;
+  if (hasPolyhedra)
+  {
+    facesSize =
+      vtkSMPTools::ExclusiveScan(faceSizes.begin(), faceSizes.end() - 1, faceSizes.begin(), zero);
+    faceSizes[numCells] = facesSize;
+  }
+  std::vector<vtkIdType> outCellIds(numCells + 1);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      outCellIds[cellId] = cellSizes[cellId + 1] > cellSizes[cellId] ? 1 : 0;
+    }
+  });
+  const vtkIdType numOutCells =
+    vtkSMPTools::ExclusiveScan(outCellIds.begin(), outCellIds.end() - 1, outCellIds.begin(), zero);
+  outCellIds[numCells] = numOutCells;
+  std::vector<vtkIdType> inCellIds(numOutCells);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      if (outCellIds[cellId + 1] > outCellIds[cellId])
+      {
+        inCellIds[outCellIds[cellId]] = cellId;
+      }
+    }
+  });
+
+  // The point uses of the kept cells, in the order the sequential traversal
+  // visits them.
+  std::vector<vtkIdType> uses(numUses);
+  vtkSMPTools::For(0, numOutCells, [&](vtkIdType outCellId, vtkIdType endOutCellId) {
+    vtkIdList* cellPts = tlCellPts.Local();
+    for (; outCellId < endOutCellId; ++outCellId)
+    {
+      const vtkIdType cellId = inCellIds[outCellId];
+      input->GetCellPoints(cellId, cellPts);
+      std::copy(cellPts->GetPointer(0), cellPts->GetPointer(0) + cellPts->GetNumberOfIds(),
+        uses.begin() + cellSizes[cellId]);
+    }
+  });
+
+  // Number the used points by their first use, or keep all the points.
+  vtkIdType numNewPts = numPts;
+  std::vector<vtkIdType> pointMap;
+  std::vector<vtkIdType> origPtIds;
+  if (this->CompactPoints)
+  {
+    std::vector<std::atomic<vtkIdType>> firstUses(numPts);
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ++ptId)
+      {
+        firstUses[ptId].store(numUses, std::memory_order_relaxed);
+      }
+    });
+    vtkSMPTools::For(0, numUses, [&](vtkIdType pos, vtkIdType end) {
+      for (; pos < end; ++pos)
+      {
+        std::atomic<vtkIdType>& firstUse = firstUses[uses[pos]];
+        vtkIdType current = firstUse.load(std::memory_order_relaxed);
+        while (pos < current && !firstUse.compare_exchange_weak(current, pos))
+        {
+        }
+      }
+    });
+    std::vector<vtkIdType> newPtIds(numUses);
+    vtkSMPTools::For(0, numUses, [&](vtkIdType pos, vtkIdType end) {
+      for (; pos < end; ++pos)
+      {
+        newPtIds[pos] = firstUses[uses[pos]].load(std::memory_order_relaxed) == pos ? 1 : 0;
+      }
+    });
+    numNewPts =
+      vtkSMPTools::ExclusiveScan(newPtIds.begin(), newPtIds.end(), newPtIds.begin(), zero);
+    pointMap.resize(numPts, -1);
+    origPtIds.resize(numNewPts);
+    vtkSMPTools::For(0, numUses, [&](vtkIdType pos, vtkIdType end) {
+      for (; pos < end; ++pos)
+      {
+        if (firstUses[uses[pos]].load(std::memory_order_relaxed) == pos)
+        {
+          pointMap[uses[pos]] = newPtIds[pos];
+          origPtIds[newPtIds[pos]] = uses[pos];
+        }
+      }
+    });
+  }
+
+  // Write the output cells.
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numOutCells + 1);
+  vtkNew<vtkIdTypeArray> conn;
+  conn->SetNumberOfValues(connSize);
+  vtkNew<vtkUnsignedCharArray> types;
+  types->SetNumberOfValues(numOutCells);
+  vtkNew<vtkIdTypeArray> faces;
+  faces->SetNumberOfValues(facesSize);
+  vtkNew<vtkIdTypeArray> faceLocations;
+  faceLocations->SetNumberOfValues(facesSize > 0 ? numOutCells : 0);
+  const vtkIdType* map = this->CompactPoints ? pointMap.data() : nullptr;
+  vtkSMPTools::For(0, numOutCells, [&](vtkIdType outCellId, vtkIdType endOutCellId) {
+    vtkIdList* cellPts = tlCellPts.Local();
+    for (; outCellId < endOutCellId; ++outCellId)
+    {
+      const vtkIdType cellId = inCellIds[outCellId];
+      const int cellType = input->GetCellType(cellId);
+      offsets->SetValue(outCellId, connSizes[cellId]);
+      types->SetValue(outCellId, static_cast<unsigned char>(cellType));
+      vtkIdType* cellConn = conn->GetPointer(connSizes[cellId]);
+      if (facesSize > 0 && cellType == VTK_POLYHEDRON)
+      {
+        // The face stream is renumbered and the connectivity is made of its
+        // distinct points, as vtkUnstructuredGrid::InsertNextCell() does.
+        faceLocations->SetValue(outCellId, faceSizes[cellId]);
+        inputGrid->GetFaceStream(cellId, cellPts);
+        if (map)
+        {
+          vtkUnstructuredGrid::ConvertFaceStreamPointIds(cellPts, const_cast<vtkIdType*>(map));
+        }
+        std::copy(cellPts->GetPointer(0), cellPts->GetPointer(0) + cellPts->GetNumberOfIds(),
+          faces->GetPointer(faceSizes[cellId]));
+        std::vector<vtkIdType>& pts = tlPolyhedronPts.Local();
+        GetPolyhedronPoints(cellPts, pts);
+        std::copy(pts.begin(), pts.end(), cellConn);
+        continue;
+      }
+      if (facesSize > 0)
+      {
+        faceLocations->SetValue(outCellId, -1);
+      }
+      const vtkIdType* cellUses = uses.data() + cellSizes[cellId];
+      const vtkIdType numCellPts = cellSizes[cellId + 1] - cellSizes[cellId];
+      for (vtkIdType i = 0; i < numCellPts; ++i)
+      {
+        cellConn[i] = map ? map[cellUses[i]] : cellUses[i];
+      }
+    }
+  });
+  offsets->SetValue(numOutCells, connSize);
+  std::vector<vtkIdType>().swap(uses);
+
+  // Copy the points and their data.
+  vtkPointSet* inputPointSet = vtkPointSet::SafeDownCast(input);
+  vtkPointData* outPD = output->GetPointData();
+  if (!this->CompactPoints && inputPointSet && inputPointSet->GetPoints() &&
+    inputPointSet->GetPoints()->GetDataType() == pointsType)
+  {
+    output->SetPoints(inputPointSet->GetPoints());
+  }
+  else
+  {
+    vtkNew<vtkPoints> newPoints;
+    newPoints->SetDataType(pointsType);
+    newPoints->SetNumberOfPoints(numNewPts);
+    vtkSMPTools::For(0, numNewPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      double x[3];
+      for (; ptId < endPtId; ++ptId)
+      {
+        input->GetPoint(this->CompactPoints ? origPtIds[ptId] : ptId, x);
+        newPoints->SetPoint(ptId, x);
+      }
+    });
+    output->SetPoints(newPoints);
+  }
+  if (this->CompactPoints)
+  {
+    outPD->CopyGlobalIdsOn();
+    outPD->CopyAllocate(pd, numNewPts);
+    ArrayList pointArrays;
+    pointArrays.AddArrays(numNewPts, pd, outPD, 0.0, false);
+    vtkSMPTools::For(0, numNewPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ++ptId)
+      {
+        pointArrays.Copy(origPtIds[ptId], ptId);
+      }
+    });
+  }
+  else
+  {
+    outPD->PassData(pd);
+  }
+
+  // Copy the cell data.
+  vtkCellData* outCD = output->GetCellData();
+  outCD->CopyGlobalIdsOn();
+  outCD->CopyAllocate(cd, numOutCells);
+  ArrayList cellArrays;
+  cellArrays.AddArrays(numOutCells, cd, outCD, 0.0, false);
+  vtkSMPTools::For(0, numOutCells, [&](vtkIdType outCellId, vtkIdType endOutCellId) {
+    for (; outCellId < endOutCellId; ++outCellId)
+    {
+      cellArrays.Copy(inCellIds[outCellId], outCellId);
+    }
+  });
+
+  vtkNew<vtkCellArray> cells;
+  cells->SetData(offsets, conn);
+  if (facesSize > 0)
+  {
+    output->SetCells(types, cells, faceLocations, faces);
+  }
+  else
+  {
+    output->SetCells(types, cells);
+  }
+  output->Squeeze();
+
+  return true;
+}
+
+//----------------------------------------------------------------------------
+int vtkThreshold::KeepCell(
+  vtkDataArray* scalars, bool usePointScalars, vtkIdType cellId, vtkIdList* cellPts)
+{
+  int numCellPts = static_cast<int>(cellPts->GetNumberOfIds());
+  int keepCell;
+  if (usePointScalars)
+  {
+    if (this->AllScalars)
+    {
+      keepCell = 1;
+      for (int i = 0; keepCell && (i < numCellPts); i++)
+      {
+        keepCell = this->EvaluateComponents(scalars, cellPts->GetId(i));
+      }
+    }
+    else
+    {
+      if (!this->UseContinuousCellRange)
+      {
+        keepCell = 0;
+        for (int i = 0; (!keepCell) && (i < numCellPts); i++)
+        {
+          keepCell = this->EvaluateComponents(scalars, cellPts->GetId(i));
+        }
+      }
+      else
+      {
+        keepCell = this->EvaluateCell(scalars, cellPts, numCellPts);
+      }
+    }
+  }
+  else // use cell scalars
+  {
+    keepCell = this->EvaluateComponents(scalars, cellId);
+  }
+
+  // Invert the keep flag if the Invert option is enabled.
+  return this->Invert ? (1 - keepCell) : keepCell;
+}
+
 int vtkThreshold::EvaluateCell(vtkDataArray* scalars, vtkIdList* cellPts, int numCellPts)
 {
   int c(0);
@@ -460,4 +800,5 @@ void vtkThreshold::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Upper Threshold: " << this->UpperThreshold << "\n";
   os << indent << "Precision of the output points: " << this->OutputPointsPrecision << "\n";
   os << indent << "Use Continuous Cell Range: " << this->UseContinuousCellRange << endl;
+  os << indent << "Compact Points: " << this->CompactPoints << endl;
 }
@@ -30,6 +30,13 @@
  * By default only the first scalar value is used in the decision. Use the ComponentMode
  * and SelectedComponent ivars to control this behavior.
  *
+ * The cells are evaluated and copied in parallel with vtkSMPTools: a first
+ * pass flags the cells to keep, scans give their position in the output,
+ * and a second pass fills the output cells and their data. The output is the
+ * same as the one of a sequential traversal. Attributes with arrays that
+ * cannot be copied concurrently, such as bit arrays, are processed
+ * sequentially.
+ *
  * @sa
  * vtkThresholdPoints vtkThresholdTextureCoords
  */
@@ -50,7 +57,9 @@
 #define VTK_COMPONENT_MODE_USE_ANY 2
 
 class vtkDataArray;
+class vtkDataSet;
 class vtkIdList;
+class vtkUnstructuredGrid;
 
 class VTKFILTERSCORE_EXPORT vtkThreshold : public vtkUnstructuredGridAlgorithm
 {
@@ -179,6 +188,19 @@ public:
   vtkBooleanMacro(Invert, bool);
   //@}
 
+  //@{
+  /**
+   * If on (the default), the output only has the points used by the
+   * extracted cells, numbered in the order of their first use. If off, all
+   * the input points and their data are passed to the output: the points are
+   * shared with the input, without copy, when it is a vtkPointSet whose
+   * points have the desired precision.
+   */
+  vtkSetMacro(CompactPoints, bool);
+  vtkGetMacro(CompactPoints, bool);
+  vtkBooleanMacro(CompactPoints, bool);
+  //@}
+
   //@{
   /**
    * Set/get the desired precision for the output types. See the documentation
@@ -226,6 +248,7 @@ protected:
   int OutputPointsPrecision;
   vtkTypeBool UseContinuousCellRange;
   bool Invert;
+  bool CompactPoints;
 
   int (vtkThreshold::*ThresholdFunction)(double s) const;
 
@@ -233,6 +256,20 @@ protected:
   int EvaluateCell(vtkDataArray* scalars, vtkIdList* cellPts, int numCellPts);
   int EvaluateCell(vtkDataArray* scalars, int c, vtkIdList* cellPts, int numCellPts);
 
+  /**
+   * Whether a cell, of point ids cellPts, satisfies the threshold criterion,
+   * taking Invert into account. This method is thread safe.
+   */
+  int KeepCell(vtkDataArray* scalars, bool usePointScalars, vtkIdType cellId, vtkIdList* cellPts);
+
+  /**
+   * Threaded implementation of RequestData(). Returns false, without
+   * modifying the output, when the attributes have to be copied
+   * sequentially.
+   */
+  bool ThreadedRequestData(vtkDataSet* input, vtkDataArray* inScalars, bool usePointScalars,
+    int pointsType, vtkUnstructuredGrid* output);
+
 private:
   vtkThreshold(const vtkThreshold&) = delete;
   void operator=(const vtkThreshold&) = delete;
@@ -23,9 +23,8 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
-#include "vtkPolygon.h"
-#include "vtkTriangle.h"
-#include "vtkTriangleFilter.h"
+#include "vtkSMPTools.h"
+#include "vtkSmoothPolyDataInternal.h"
 
 vtkStandardNewMacro(vtkWindowedSincPolyDataFilter);
 
@@ -52,18 +51,6 @@ vtkWindowedSincPolyDataFilter::vtkWindowedSincPolyDataFilter()
   this->NormalizeCoordinates = 0;
 }
 
-#define VTK_SIMPLE_VERTEX 0
-#define VTK_FIXED_VERTEX 1
-#define VTK_FEATURE_EDGE_VERTEX 2
-#define VTK_BOUNDARY_EDGE_VERTEX 3
-
-// Special structure for marking vertices
-typedef struct _vtkMeshVertex
-{
-  char type;
-  vtkIdList* edges; // connected edges (list of connected point ids)
-} vtkMeshVertex, *vtkMeshVertexPtr;
-
 //-----------------------------------------------------------------------------
 int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -76,26 +63,14 @@ int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
   vtkPolyData* input = vtkPolyData::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
   vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkIdType numPts, numCells, numPolys, numStrips, i;
-  int j, k;
-  vtkIdType npts = 0;
-  const vtkIdType* pts = nullptr;
-  vtkIdType p1, p2;
-  double x[3], y[3], deltaX[3], xNew[3];
-  double x1[3], x2[3], x3[3], l1[3], l2[3];
-  double CosFeatureAngle; // Cosine of angle between adjacent polys
-  double CosEdgeAngle;    // Cosine of angle between adjacent edges
+  vtkIdType numPts, numCells, i;
+  int j;
   int iterationNumber;
-  vtkIdType numSimple = 0, numBEdges = 0, numFixed = 0, numFEdges = 0;
-  vtkPolyData *inMesh = nullptr, *Mesh;
   vtkPoints* inPts;
-  vtkTriangleFilter* toTris = nullptr;
-  vtkCellArray *inVerts, *inLines, *inPolys, *inStrips;
   vtkPoints* newPts[4];
-  vtkMeshVertexPtr Verts;
 
   // variables specific to windowed sinc interpolation
-  double theta_pb, k_pb, sigma, p_x0[3], p_x1[3], p_x3[3];
+  double theta_pb, k_pb, sigma;
   double *w, *c, *cprime;
   int zero, one, two, three;
 
@@ -109,9 +84,6 @@ int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
     return 1;
   }
 
-  CosFeatureAngle = cos(vtkMath::RadiansFromDegrees(this->FeatureAngle));
-  CosEdgeAngle = cos(vtkMath::RadiansFromDegrees(this->EdgeAngle));
-
   vtkDebugMacro(<< "Smoothing " << numPts << " vertices, " << numCells << " cells with:\n"
                 << "\tIterations= " << this->NumberOfIterations << "\n"
                 << "\tPassBand= " << this->PassBand << "\n"
@@ -138,297 +110,20 @@ int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
   // vertices. FIXED vertices are never smoothed. Edge vertices are smoothed
   // using a subset of the attached vertices.
   vtkDebugMacro(<< "Analyzing topology...");
-  Verts = new vtkMeshVertex[numPts];
-  for (i = 0; i < numPts; i++)
-  {
-    Verts[i].type = VTK_SIMPLE_VERTEX; // can smooth
-    Verts[i].edges = nullptr;
-  }
-
   inPts = input->GetPoints();
 
-  // check vertices first. Vertices are never smoothed_--------------
-  for (inVerts = input->GetVerts(), inVerts->InitTraversal(); inVerts->GetNextCell(npts, pts);)
-  {
-    for (j = 0; j < npts; j++)
-    {
-      Verts[pts[j]].type = VTK_FIXED_VERTEX;
-    }
-  }
-
-  this->UpdateProgress(0.10);
-
-  // now check lines. Only manifold lines can be smoothed------------
-  for (inLines = input->GetLines(), inLines->InitTraversal(); inLines->GetNextCell(npts, pts);)
-  {
-    // Check for closed loop which are treated specially. Basically the
-    // last point is ignored (set to fixed).
-    bool closedLoop = (pts[0] == pts[npts - 1] && npts > 3);
-
-    for (j = 0; j < npts; j++)
-    {
-      if (Verts[pts[j]].type == VTK_SIMPLE_VERTEX)
-      {
-        // First point
-        if (j == 0)
-        {
-          if (!closedLoop)
-          {
-            Verts[pts[0]].type = VTK_FIXED_VERTEX;
-          }
-          else
-          {
-            Verts[pts[0]].type = VTK_FEATURE_EDGE_VERTEX;
-            Verts[pts[0]].edges = vtkIdList::New();
-            Verts[pts[0]].edges->SetNumberOfIds(2);
-            Verts[pts[0]].edges->SetId(0, pts[npts - 2]);
-            Verts[pts[0]].edges->SetId(1, pts[1]);
-          }
-        }
-        // Last point
-        else if (j == (npts - 1) && !closedLoop)
-        {
-          Verts[pts[j]].type = VTK_FIXED_VERTEX;
-        }
-        // In between point
-        else // is edge vertex (unless already edge vertex!)
-        {
-          Verts[pts[j]].type = VTK_FEATURE_EDGE_VERTEX;
-          Verts[pts[j]].edges = vtkIdList::New();
-          Verts[pts[j]].edges->SetNumberOfIds(2);
-          Verts[pts[j]].edges->SetId(0, pts[j - 1]);
-          Verts[pts[j]].edges->SetId(1, pts[(closedLoop && j == (npts - 2) ? 0 : (j + 1))]);
-        }
-      } // if simple vertex
-
-      // Vertex has been visited before, need to fix it. Special case
-      // when working on closed loop.
-      else if (Verts[pts[j]].type == VTK_FEATURE_EDGE_VERTEX && !(closedLoop && j == (npts - 1)))
-      {
-        Verts[pts[j]].type = VTK_FIXED_VERTEX;
-        Verts[pts[j]].edges->Delete();
-        Verts[pts[j]].edges = nullptr;
-      }
-    } // for all points in this line
-  }   // for all lines
-
-  this->UpdateProgress(0.25);
-
-  // now polygons and triangle strips-------------------------------
-  inPolys = input->GetPolys();
-  numPolys = inPolys->GetNumberOfCells();
-  inStrips = input->GetStrips();
-  numStrips = inStrips->GetNumberOfCells();
-
-  if (numPolys > 0 || numStrips > 0)
-  { // build cell structure
-    vtkCellArray* polys;
-    vtkIdType cellId;
-    int numNei, nei, edge;
-    vtkIdType numNeiPts;
-    const vtkIdType* neiPts;
-    double normal[3], neiNormal[3];
-    vtkIdList* neighbors;
-
-    inMesh = vtkPolyData::New();
-    inMesh->SetPoints(inPts);
-    inMesh->SetPolys(inPolys);
-    Mesh = inMesh;
-    neighbors = vtkIdList::New();
-    neighbors->Allocate(VTK_CELL_SIZE);
-
-    if ((numStrips = inStrips->GetNumberOfCells()) > 0)
-    { // convert data to triangles
-      inMesh->SetStrips(inStrips);
-      toTris = vtkTriangleFilter::New();
-      toTris->SetInputData(inMesh);
-      toTris->Update();
-      Mesh = toTris->GetOutput();
-    }
+  SmoothingTopology topology;
+  topology.FeatureEdgeSmoothing = this->FeatureEdgeSmoothing != 0;
+  topology.CosFeatureAngle = cos(vtkMath::RadiansFromDegrees(this->FeatureAngle));
+  topology.CosEdgeAngle = cos(vtkMath::RadiansFromDegrees(this->EdgeAngle));
+  topology.BoundarySmoothing = this->BoundarySmoothing != 0;
+  topology.NonManifoldSmoothing = this->NonManifoldSmoothing != 0;
+  topology.ClosedLoops = true;
+  topology.Build(input, this);
 
-    Mesh->BuildLinks(); // to do neighborhood searching
-    polys = Mesh->GetPolys();
-
-    for (cellId = 0, polys->InitTraversal(); polys->GetNextCell(npts, pts); cellId++)
-    {
-      for (i = 0; i < npts; i++)
-      {
-        p1 = pts[i];
-        p2 = pts[(i + 1) % npts];
-
-        if (Verts[p1].edges == nullptr)
-        {
-          Verts[p1].edges = vtkIdList::New();
-          Verts[p1].edges->Allocate(16, 6);
-          // Verts[p1].edges = new vtkIdList(6,6);
-        }
-        if (Verts[p2].edges == nullptr)
-        {
-          Verts[p2].edges = vtkIdList::New();
-          Verts[p2].edges->Allocate(16, 6);
-          // Verts[p2].edges = new vtkIdList(6,6);
-        }
-
-        Mesh->GetCellEdgeNeighbors(cellId, p1, p2, neighbors);
-        numNei = neighbors->GetNumberOfIds();
-
-        edge = VTK_SIMPLE_VERTEX;
-        if (numNei == 0)
-        {
-          edge = VTK_BOUNDARY_EDGE_VERTEX;
-        }
-
-        else if (numNei >= 2)
-        {
-          // non-manifold case, check nonmanifold smoothing state
-          if (!this->NonManifoldSmoothing)
-          {
-            // check to make sure that this edge hasn't been marked already
-            for (j = 0; j < numNei; j++)
-            {
-              if (neighbors->GetId(j) < cellId)
-              {
-                break;
-              }
-            }
-            if (j >= numNei)
-            {
-              edge = VTK_FEATURE_EDGE_VERTEX;
-            }
-          }
-        }
-
-        else if (numNei == 1 && (nei = neighbors->GetId(0)) > cellId)
-        {
-          if (this->FeatureEdgeSmoothing)
-          {
-            vtkPolygon::ComputeNormal(inPts, npts, pts, normal);
-            Mesh->GetCellPoints(nei, numNeiPts, neiPts);
-            vtkPolygon::ComputeNormal(inPts, numNeiPts,
-              // vtkCell API needs fixing...
-              const_cast<vtkIdType*>(neiPts), neiNormal);
-
-            if (vtkMath::Dot(normal, neiNormal) <= CosFeatureAngle)
-            {
-              edge = VTK_FEATURE_EDGE_VERTEX;
-            }
-          }
-        }
-        else // a visited edge; skip rest of analysis
-        {
-          continue;
-        }
-
-        if (edge && Verts[p1].type == VTK_SIMPLE_VERTEX)
-        {
-          Verts[p1].edges->Reset();
-          Verts[p1].edges->InsertNextId(p2);
-          Verts[p1].type = edge;
-        }
-        else if ((edge && Verts[p1].type == VTK_BOUNDARY_EDGE_VERTEX) ||
-          (edge && Verts[p1].type == VTK_FEATURE_EDGE_VERTEX) ||
-          (!edge && Verts[p1].type == VTK_SIMPLE_VERTEX))
-        {
-          Verts[p1].edges->InsertNextId(p2);
-          if (Verts[p1].type && edge == VTK_BOUNDARY_EDGE_VERTEX)
-          {
-            Verts[p1].type = VTK_BOUNDARY_EDGE_VERTEX;
-          }
-        }
-
-        if (edge && Verts[p2].type == VTK_SIMPLE_VERTEX)
-        {
-          Verts[p2].edges->Reset();
-          Verts[p2].edges->InsertNextId(p1);
-          Verts[p2].type = edge;
-        }
-        else if ((edge && Verts[p2].type == VTK_BOUNDARY_EDGE_VERTEX) ||
-          (edge && Verts[p2].type == VTK_FEATURE_EDGE_VERTEX) ||
-          (!edge && Verts[p2].type == VTK_SIMPLE_VERTEX))
-        {
-          Verts[p2].edges->InsertNextId(p1);
-          if (Verts[p2].type && edge == VTK_BOUNDARY_EDGE_VERTEX)
-          {
-            Verts[p2].type = VTK_BOUNDARY_EDGE_VERTEX;
-          }
-        }
-      }
-    }
-
-    //    delete inMesh; // delete this later, windowed sinc smoothing needs it
-    if (toTris)
-    {
-      toTris->Delete();
-    }
-    neighbors->Delete();
-  } // if strips or polys
-
-  this->UpdateProgress(0.50);
-
-  // post-process edge vertices to make sure we can smooth them
-  for (i = 0; i < numPts; i++)
-  {
-    if (Verts[i].type == VTK_SIMPLE_VERTEX)
-    {
-      numSimple++;
-    }
-
-    else if (Verts[i].type == VTK_FIXED_VERTEX)
-    {
-      numFixed++;
-    }
-
-    else if (Verts[i].type == VTK_FEATURE_EDGE_VERTEX || Verts[i].type == VTK_BOUNDARY_EDGE_VERTEX)
-    { // see how many edges; if two, what the angle is
-
-      if (!this->BoundarySmoothing && Verts[i].type == VTK_BOUNDARY_EDGE_VERTEX)
-      {
-        Verts[i].type = VTK_FIXED_VERTEX;
-        numBEdges++;
-      }
-
-      else if ((npts = Verts[i].edges->GetNumberOfIds()) != 2)
-      {
-        // can only smooth edges on 2-manifold surfaces
-        Verts[i].type = VTK_FIXED_VERTEX;
-        numFixed++;
-      }
-
-      else // check angle between edges
-      {
-        inPts->GetPoint(Verts[i].edges->GetId(0), x1);
-        inPts->GetPoint(i, x2);
-        inPts->GetPoint(Verts[i].edges->GetId(1), x3);
-
-        for (k = 0; k < 3; k++)
-        {
-          l1[k] = x2[k] - x1[k];
-          l2[k] = x3[k] - x2[k];
-        }
-        if ((vtkMath::Normalize(l1) >= 0.0) && (vtkMath::Normalize(l2) >= 0.0) &&
-          (vtkMath::Dot(l1, l2) < CosEdgeAngle))
-        {
-          numFixed++;
-          Verts[i].type = VTK_FIXED_VERTEX;
-        }
-        else
-        {
-          if (Verts[i].type == VTK_FEATURE_EDGE_VERTEX)
-          {
-            numFEdges++;
-          }
-          else
-          {
-            numBEdges++;
-          }
-        }
-      } // if along edge
-    }   // if edge vertex
-  }     // for all points
-
-  vtkDebugMacro(<< "Found\n\t" << numSimple << " simple vertices\n\t" << numFEdges
-                << " feature edge vertices\n\t" << numBEdges << " boundary edge vertices\n\t"
-                << numFixed << " fixed vertices\n\t");
+  vtkDebugMacro(<< "Found\n\t" << topology.NumSimple << " simple vertices\n\t"
+                << topology.NumFEdges << " feature edge vertices\n\t" << topology.NumBEdges
+                << " boundary edge vertices\n\t" << topology.NumFixed << " fixed vertices\n\t");
 
   // Perform Windowed Sinc function interpolation
   //
@@ -449,31 +144,37 @@ int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
   newPts[3] = vtkPoints::New();
   newPts[3]->SetNumberOfPoints(numPts);
 
+  // The points are stored in single precision, and smoothed in double
+  // precision. Each pass reads the points of the previous ones only, so that
+  // the points are smoothed in parallel.
+  float* coords[4];
+  for (j = 0; j < 4; ++j)
+  {
+    coords[j] = static_cast<float*>(newPts[j]->GetVoidPointer(0));
+  }
+
   // Get the center and length of the input dataset
-  double* inCenter = input->GetCenter();
+  double inCenter[3];
+  input->GetCenter(inCenter);
   double inLength = input->GetLength();
 
-  if (!this->NormalizeCoordinates)
-  {
-    for (i = 0; i < numPts; i++) // initialize to old coordinates
-    {
-      newPts[zero]->SetPoint(i, inPts->GetPoint(i));
-    }
-  }
-  else
-  {
-    // center the data and scale to be within unit cube [-1, 1]
-    double normalizedPoint[3];
-    for (i = 0; i < numPts; i++) // initialize to old coordinates
+  const bool normalize = this->NormalizeCoordinates != 0;
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    double x[3];
+    for (; ptId < endPtId; ptId++) // initialize to old coordinates
     {
-      inPts->GetPoint(i, normalizedPoint);
-      for (j = 0; j < 3; ++j)
+      inPts->GetPoint(ptId, x);
+      if (normalize)
       {
-        normalizedPoint[j] = (normalizedPoint[j] - inCenter[j]) / inLength;
+        // center the data and scale to be within unit cube [-1, 1]
+        for (int k = 0; k < 3; ++k)
+        {
+          x[k] = (x[k] - inCenter[k]) / inLength;
+        }
       }
-      newPts[zero]->SetPoint(i, normalizedPoint);
+      newPts[zero]->SetPoint(ptId, x);
     }
-  }
+  });
 
   // Smooth with a low pass filter defined as a windowed sinc function.
   // Taubin describes this methodology is the IBM tech report RC-20404
@@ -494,9 +195,6 @@ int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
   c = new double[this->NumberOfIterations + 1];
   cprime = new double[this->NumberOfIterations + 1];
 
-  double zerovector[3];
-  zerovector[0] = zerovector[1] = zerovector[2] = 0.0;
-
   // Calculate the weights and the Chebychev coefficients c.
   //
 
@@ -581,52 +279,60 @@ int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
   }
 
   // first iteration
-  for (i = 0; i < numPts; i++)
-  {
-    if (Verts[i].edges != nullptr && (npts = Verts[i].edges->GetNumberOfIds()) > 0)
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    const float* x0 = coords[zero];
+    float* x1 = coords[one];
+    float* x3 = coords[three];
+    double x[3], deltaX[3];
+    for (; ptId < endPtId; ptId++)
     {
-      // point is allowed to move
-      newPts[zero]->GetPoint(i, x); // use current points
-      deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
-
-      // calculate the negative of the laplacian
-      for (j = 0; j < npts; j++) // for all connected points
+      const vtkIdType npts = topology.GetNumberOfNeighbors(ptId);
+      if (npts > 0)
       {
-        newPts[zero]->GetPoint(Verts[i].edges->GetId(j), y);
-        for (k = 0; k < 3; k++)
+        // point is allowed to move
+        const vtkIdType* neighbors = topology.GetNeighbors(ptId);
+        for (int k = 0; k < 3; k++) // use current points
         {
-          deltaX[k] += (x[k] - y[k]) / npts;
+          x[k] = x0[3 * ptId + k];
+          deltaX[k] = 0.0;
         }
-      }
-      // newPts[one] = newPts[zero] - 0.5 newPts[one]
-      for (k = 0; k < 3; k++)
-      {
-        deltaX[k] = x[k] - 0.5 * deltaX[k];
-      }
-      newPts[one]->SetPoint(i, deltaX);
 
-      // calculate newPts[three] = c0 newPts[zero] + c1 newPts[one]
-      for (k = 0; k < 3; k++)
-      {
-        deltaX[k] = c[0] * x[k] + c[1] * deltaX[k];
-      }
-      if (Verts[i].type == VTK_FIXED_VERTEX)
-      {
-        newPts[three]->SetPoint(i, newPts[zero]->GetPoint(i));
-      }
+        // calculate the negative of the laplacian
+        for (vtkIdType n = 0; n < npts; n++) // for all connected points
+        {
+          const float* y = x0 + 3 * neighbors[n];
+          for (int k = 0; k < 3; k++)
+          {
+            deltaX[k] += (x[k] - y[k]) / npts;
+          }
+        }
+        // newPts[one] = newPts[zero] - 0.5 newPts[one]
+        for (int k = 0; k < 3; k++)
+        {
+          deltaX[k] = x[k] - 0.5 * deltaX[k];
+          x1[3 * ptId + k] = static_cast<float>(deltaX[k]);
+        }
+
+        // calculate newPts[three] = c0 newPts[zero] + c1 newPts[one]
+        for (int k = 0; k < 3; k++)
+        {
+          x3[3 * ptId + k] = topology.GetType(ptId) == VTK_FIXED_VERTEX
+            ? x0[3 * ptId + k]
+            : static_cast<float>(c[0] * x[k] + c[1] * deltaX[k]);
+        }
+      } // if can move point
       else
       {
-        newPts[three]->SetPoint(i, deltaX);
+        // point is not allowed to move, just use the old point...
+        // (zero out the Laplacian)
+        for (int k = 0; k < 3; k++)
+        {
+          x1[3 * ptId + k] = 0.0f;
+          x3[3 * ptId + k] = x0[3 * ptId + k];
+        }
       }
-    } // if can move point
-    else
-    {
-      // point is not allowed to move, just use the old point...
-      // (zero out the Laplacian)
-      newPts[one]->SetPoint(i, zerovector);
-      newPts[three]->SetPoint(i, newPts[zero]->GetPoint(i));
-    }
-  } // for all points
+    } // for all points
+  });
 
   // for the rest of the iterations
   for (iterationNumber = 2; iterationNumber <= this->NumberOfIterations; iterationNumber++)
@@ -640,52 +346,65 @@ int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
       }
     }
 
-    for (i = 0; i < numPts; i++)
-    {
-      if (Verts[i].edges != nullptr && (npts = Verts[i].edges->GetNumberOfIds()) > 0)
+    // The Laplacian of the points that are not allowed to move is zeroed
+    // out in newPts[one] by the previous pass.
+    const double cj = c[iterationNumber];
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      const float* x0 = coords[zero];
+      const float* x1 = coords[one];
+      float* x2 = coords[two];
+      float* x3 = coords[three];
+      double p_x1[3], deltaX[3];
+      for (; ptId < endPtId; ptId++)
       {
-        // point is allowed to move
-        newPts[zero]->GetPoint(i, p_x0); // use current points
-        newPts[one]->GetPoint(i, p_x1);
+        const vtkIdType npts = topology.GetNumberOfNeighbors(ptId);
+        if (npts > 0)
+        {
+          // point is allowed to move
+          const vtkIdType* neighbors = topology.GetNeighbors(ptId);
+          for (int k = 0; k < 3; k++) // use current points
+          {
+            p_x1[k] = x1[3 * ptId + k];
+            deltaX[k] = 0.0;
+          }
 
-        deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
+          // calculate the negative laplacian of x1
+          for (vtkIdType n = 0; n < npts; n++)
+          {
+            const float* y = x1 + 3 * neighbors[n];
+            for (int k = 0; k < 3; k++)
+            {
+              deltaX[k] += (p_x1[k] - y[k]) / npts;
+            }
+          } // for all connected points
 
-        // calculate the negative laplacian of x1
-        for (j = 0; j < npts; j++)
-        {
-          newPts[one]->GetPoint(Verts[i].edges->GetId(j), y);
-          for (k = 0; k < 3; k++)
+          // Taubin:  x2 = (x1 - x0) + (x1 - x2)
+          for (int k = 0; k < 3; k++)
           {
-            deltaX[k] += (p_x1[k] - y[k]) / npts;
+            deltaX[k] = p_x1[k] - x0[3 * ptId + k] + p_x1[k] - deltaX[k];
+            x2[3 * ptId + k] = static_cast<float>(deltaX[k]);
           }
-        } // for all connected points
 
-        // Taubin:  x2 = (x1 - x0) + (x1 - x2)
-        for (k = 0; k < 3; k++)
+          // smooth the vertex (x3 = x3 + cj x2)
+          if (topology.GetType(ptId) != VTK_FIXED_VERTEX)
+          {
+            for (int k = 0; k < 3; k++)
+            {
+              x3[3 * ptId + k] = static_cast<float>(x3[3 * ptId + k] + cj * deltaX[k]);
+            }
+          }
+        } // if can move point
+        else
         {
-          deltaX[k] = p_x1[k] - p_x0[k] + p_x1[k] - deltaX[k];
+          // point is not allowed to move, just use the old point...
+          // (zero out the Laplacian)
+          for (int k = 0; k < 3; k++)
+          {
+            x2[3 * ptId + k] = 0.0f;
+          }
         }
-        newPts[two]->SetPoint(i, deltaX);
-
-        // smooth the vertex (x3 = x3 + cj x2)
-        newPts[three]->GetPoint(i, p_x3);
-        for (k = 0; k < 3; k++)
-        {
-          xNew[k] = p_x3[k] + c[iterationNumber] * deltaX[k];
-        }
-        if (Verts[i].type != VTK_FIXED_VERTEX)
-        {
-          newPts[three]->SetPoint(i, xNew);
-        }
-      } // if can move point
-      else
-      {
-        // point is not allowed to move, just use the old point...
-        // (zero out the Laplacian)
-        newPts[one]->SetPoint(i, zerovector);
-        newPts[two]->SetPoint(i, zerovector);
-      }
-    } // for all points
+      } // for all points
+    });
 
     // update the pointers. three is always three. all other pointers
     // shift by one and wrap.
@@ -713,17 +432,15 @@ int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
   if (this->NormalizeCoordinates)
   {
     // Re-position the coordinated
-    double repositionedPoint[3];
-    for (i = 0; i < numPts; i++)
-    {
-      newPts[zero]->GetPoint(i, repositionedPoint);
-      for (j = 0; j < 3; ++j)
+    vtkSMPTools::For(0, 3 * numPts, [&](vtkIdType begin, vtkIdType end) {
+      float* x = coords[zero];
+      for (; begin < end; begin++)
       {
-        repositionedPoint[j] = repositionedPoint[j] * inLength + inCenter[j];
+        x[begin] = static_cast<float>(x[begin] * inLength + inCenter[begin % 3]);
       }
-      newPts[zero]->SetPoint(i, repositionedPoint);
-    }
+    });
   }
+  newPts[zero]->Modified();
 
   // Update output. Only point coordinates have changed.
   //
@@ -734,12 +451,16 @@ int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
   {
     vtkFloatArray* newScalars = vtkFloatArray::New();
     newScalars->SetNumberOfTuples(numPts);
-    for (i = 0; i < numPts; i++)
-    {
-      inPts->GetPoint(i, x1);
-      newPts[zero]->GetPoint(i, x2);
-      newScalars->SetComponent(i, 0, sqrt(vtkMath::Distance2BetweenPoints(x1, x2)));
-    }
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      double x1[3], x2[3];
+      for (; ptId < endPtId; ptId++)
+      {
+        inPts->GetPoint(ptId, x1);
+        newPts[zero]->GetPoint(ptId, x2);
+        newScalars->SetValue(
+          ptId, static_cast<float>(sqrt(vtkMath::Distance2BetweenPoints(x1, x2))));
+      }
+    });
     int idx = output->GetPointData()->AddArray(newScalars);
     output->GetPointData()->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
     newScalars->Delete();
@@ -750,16 +471,19 @@ int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
     vtkFloatArray* newVectors = vtkFloatArray::New();
     newVectors->SetNumberOfComponents(3);
     newVectors->SetNumberOfTuples(numPts);
-    for (i = 0; i < numPts; i++)
-    {
-      inPts->GetPoint(i, x1);
-      newPts[zero]->GetPoint(i, x2);
-      for (j = 0; j < 3; j++)
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      double x1[3], x2[3], x3[3];
+      for (; ptId < endPtId; ptId++)
       {
-        x3[j] = x2[j] - x1[j];
+        inPts->GetPoint(ptId, x1);
+        newPts[zero]->GetPoint(ptId, x2);
+        for (int k = 0; k < 3; k++)
+        {
+          x3[k] = x2[k] - x1[k];
+        }
+        newVectors->SetTuple(ptId, x3);
       }
-      newVectors->SetTuple(i, x3);
-    }
+    });
     output->GetPointData()->SetVectors(newVectors);
     newVectors->Delete();
   }
@@ -775,22 +499,6 @@ int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
   output->SetPolys(input->GetPolys());
   output->SetStrips(input->GetStrips());
 
-  // finally delete the constructed (local) mesh
-  if (inMesh != nullptr)
-  {
-    inMesh->Delete();
-  }
-
-  // free up connectivity storage
-  for (i = 0; i < numPts; i++)
-  {
-    if (Verts[i].edges != nullptr)
-    {
-      Verts[i].edges->Delete();
-    }
-  }
-  delete[] Verts;
-
   return 1;
 }
 
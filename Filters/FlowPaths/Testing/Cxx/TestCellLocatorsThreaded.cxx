@@ -0,0 +1,244 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCellLocatorsThreaded.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Checks that the cell locators, built with one or several threads, answer
+// FindCell and IntersectWithLine queries issued concurrently, each thread with
+// its own generic cell, as the same queries issued sequentially, and that all
+// the points are located and all the lines hit the surface.
+
+#include "vtkCellLocator.h"
+#include "vtkCellTreeLocator.h"
+#include "vtkGenericCell.h"
+#include "vtkModifiedBSPTree.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+const int NumberOfQueries = 2000;
+
+// A lattice of cubes, each split into 6 tetrahedra around its diagonal, with
+// enough cells for the trees to be built in parallel.
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid()
+{
+  const int res = 14;
+  const int dim = res + 1;
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < dim; ++k)
+  {
+    for (int j = 0; j < dim; ++j)
+    {
+      for (int i = 0; i < dim; ++i)
+      {
+        points->InsertNextPoint(i + 0.2 * std::sin(0.5 * j), j, k + 0.2 * std::cos(0.5 * i));
+      }
+    }
+  }
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->Allocate();
+  auto id = [dim](int i, int j, int k) -> vtkIdType { return i + dim * (j + dim * k); };
+  const int tets[6][4] = { { 0, 1, 2, 6 }, { 0, 2, 3, 6 }, { 0, 3, 7, 6 }, { 0, 7, 4, 6 },
+    { 0, 4, 5, 6 }, { 0, 5, 1, 6 } };
+  for (int k = 0; k < res; ++k)
+  {
+    for (int j = 0; j < res; ++j)
+    {
+      for (int i = 0; i < res; ++i)
+      {
+        const vtkIdType h[8] = { id(i, j, k), id(i + 1, j, k), id(i + 1, j + 1, k),
+          id(i, j + 1, k), id(i, j, k + 1), id(i + 1, j, k + 1), id(i + 1, j + 1, k + 1),
+          id(i, j + 1, k + 1) };
+        for (const auto& tet : tets)
+        {
+          const vtkIdType ids[4] = { h[tet[0]], h[tet[1]], h[tet[2]], h[tet[3]] };
+          grid->InsertNextCell(VTK_TETRA, 4, ids);
+        }
+      }
+    }
+  }
+  return grid;
+}
+
+// Points inside the lattice, away from its deformed boundary.
+void QueryPoint(int q, double x[3])
+{
+  x[0] = 0.5 + 13.0 * (0.5 + 0.5 * std::sin(1.7 * q));
+  x[1] = 0.5 + 13.0 * (0.5 + 0.5 * std::sin(2.3 * q + 1.0));
+  x[2] = 0.5 + 13.0 * (0.5 + 0.5 * std::sin(3.1 * q + 2.0));
+}
+
+// Lines from outside a sphere of radius 1 towards points near its center.
+void QueryLine(int q, double p1[3], double p2[3])
+{
+  const double theta = 0.37 * q;
+  const double phi = std::acos(std::sin(0.91 * q));
+  p1[0] = 2.0 * std::sin(phi) * std::cos(theta);
+  p1[1] = 2.0 * std::sin(phi) * std::sin(theta);
+  p1[2] = 2.0 * std::cos(phi);
+  p2[0] = 0.1 * std::sin(1.3 * q);
+  p2[1] = 0.1 * std::cos(1.9 * q);
+  p2[2] = 0.0;
+}
+
+struct FindResult
+{
+  vtkIdType CellId;
+  double PCoords[3];
+};
+
+struct LineResult
+{
+  int Hit;
+  vtkIdType CellId;
+  double T;
+  double X[3];
+};
+
+std::vector<FindResult> FindCells(vtkAbstractCellLocator* locator)
+{
+  std::vector<FindResult> results(NumberOfQueries);
+  vtkSMPThreadLocalObject<vtkGenericCell> cells;
+  vtkSMPTools::For(0, NumberOfQueries, [&](vtkIdType begin, vtkIdType end) {
+    vtkGenericCell* cell = cells.Local();
+    double weights[8];
+    for (vtkIdType q = begin; q < end; ++q)
+    {
+      double x[3];
+      QueryPoint(static_cast<int>(q), x);
+      results[q].CellId = locator->FindCell(x, 0.0, cell, results[q].PCoords, weights);
+    }
+  });
+  return results;
+}
+
+std::vector<LineResult> IntersectLines(vtkAbstractCellLocator* locator)
+{
+  std::vector<LineResult> results(NumberOfQueries);
+  vtkSMPThreadLocalObject<vtkGenericCell> cells;
+  vtkSMPTools::For(0, NumberOfQueries, [&](vtkIdType begin, vtkIdType end) {
+    vtkGenericCell* cell = cells.Local();
+    for (vtkIdType q = begin; q < end; ++q)
+    {
+      double p1[3], p2[3], pcoords[3];
+      int subId;
+      QueryLine(static_cast<int>(q), p1, p2);
+      LineResult& result = results[q];
+      result.CellId = -1;
+      result.Hit = locator->IntersectWithLine(
+        p1, p2, 0.001, result.T, result.X, pcoords, subId, result.CellId, cell);
+    }
+  });
+  return results;
+}
+
+bool CompareFindResults(const std::vector<FindResult>& a, const std::vector<FindResult>& b)
+{
+  for (int q = 0; q < NumberOfQueries; ++q)
+  {
+    if (a[q].CellId < 0 || a[q].CellId != b[q].CellId ||
+      std::abs(a[q].PCoords[0] - b[q].PCoords[0]) > 1e-12 ||
+      std::abs(a[q].PCoords[1] - b[q].PCoords[1]) > 1e-12 ||
+      std::abs(a[q].PCoords[2] - b[q].PCoords[2]) > 1e-12)
+    {
+      cerr << "Point " << q << " found in cell " << b[q].CellId << " instead of " << a[q].CellId
+           << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CompareLineResults(const std::vector<LineResult>& a, const std::vector<LineResult>& b)
+{
+  for (int q = 0; q < NumberOfQueries; ++q)
+  {
+    if (!a[q].Hit || a[q].Hit != b[q].Hit || a[q].CellId != b[q].CellId ||
+      std::abs(a[q].T - b[q].T) > 1e-12)
+    {
+      cerr << "Line " << q << " intersects cell " << b[q].CellId << " instead of "
+           << a[q].CellId << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename LocatorT>
+int TestLocator(vtkUnstructuredGrid* grid, vtkPolyData* sphere, bool cacheCellBounds)
+{
+  int status = 0;
+  for (int numThreads : { 1, 4 })
+  {
+    vtkSMPTools::Initialize(numThreads);
+    vtkNew<LocatorT> gridLocator;
+    gridLocator->SetDataSet(grid);
+    gridLocator->SetCacheCellBounds(cacheCellBounds);
+    gridLocator->LazyEvaluationOff();
+    gridLocator->BuildLocator();
+    vtkNew<LocatorT> sphereLocator;
+    sphereLocator->SetDataSet(sphere);
+    sphereLocator->SetCacheCellBounds(cacheCellBounds);
+    sphereLocator->LazyEvaluationOff();
+    sphereLocator->BuildLocator();
+
+    vtkSMPTools::Initialize(1);
+    std::vector<FindResult> sequentialCells = FindCells(gridLocator);
+    std::vector<LineResult> sequentialLines = IntersectLines(sphereLocator);
+    vtkSMPTools::Initialize(4);
+    std::vector<FindResult> cells = FindCells(gridLocator);
+    std::vector<LineResult> lines = IntersectLines(sphereLocator);
+
+    if (!CompareFindResults(sequentialCells, cells) ||
+      !CompareLineResults(sequentialLines, lines))
+    {
+      cerr << "Wrong results for " << gridLocator->GetClassName() << " built with "
+           << numThreads << " threads and cached bounds " << cacheCellBounds << endl;
+      status = 1;
+    }
+  }
+  vtkSMPTools::Initialize();
+  return status;
+}
+}
+
+int TestCellLocatorsThreaded(int, char*[])
+{
+  vtkSmartPointer<vtkUnstructuredGrid> grid = MakeGrid();
+  vtkNew<vtkSphereSource> sphereSource;
+  sphereSource->SetThetaResolution(100);
+  sphereSource->SetPhiResolution(100);
+  sphereSource->Update();
+  vtkPolyData* sphere = sphereSource->GetOutput();
+
+  int status = 0;
+  for (bool cacheCellBounds : { false, true })
+  {
+    status |= TestLocator<vtkCellLocator>(grid, sphere, cacheCellBounds);
+    status |= TestLocator<vtkCellTreeLocator>(grid, sphere, cacheCellBounds);
+  }
+  // This locator always caches the bounds of the cells.
+  status |= TestLocator<vtkModifiedBSPTree>(grid, sphere, true);
+  return status;
+}
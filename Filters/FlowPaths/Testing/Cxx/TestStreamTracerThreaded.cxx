@@ -0,0 +1,192 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStreamTracerThreaded.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Checks that the streamlines integrated in parallel by vtkStreamTracer, with
+// one or several threads, are the ones integrated sequentially, which is
+// forced with a custom termination callback, for both interpolator types and
+// for an unstructured grid and a multiblock of images.
+
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamTracer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+
+namespace
+{
+void AddVelocity(vtkDataSet* ds)
+{
+  vtkNew<vtkDoubleArray> velocity;
+  velocity->SetName("Velocity");
+  velocity->SetNumberOfComponents(3);
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  for (vtkIdType i = 0; i < ds->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    ds->GetPoint(i, x);
+    velocity->InsertNextTuple3(5.0 - x[1], x[0] - 5.0, 0.2 + 0.1 * std::sin(x[2]));
+    scalars->InsertNextValue(x[0] * x[1] - x[2]);
+  }
+  ds->GetPointData()->SetVectors(velocity);
+  ds->GetPointData()->AddArray(scalars);
+}
+
+// A lattice of cubes, each split into 6 tetrahedra around its diagonal.
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid()
+{
+  const int res = 10;
+  const int dim = res + 1;
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < dim; ++k)
+  {
+    for (int j = 0; j < dim; ++j)
+    {
+      for (int i = 0; i < dim; ++i)
+      {
+        points->InsertNextPoint(i + 0.1 * std::sin(j), j, k);
+      }
+    }
+  }
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->Allocate();
+  auto id = [dim](int i, int j, int k) -> vtkIdType { return i + dim * (j + dim * k); };
+  const int tets[6][4] = { { 0, 1, 2, 6 }, { 0, 2, 3, 6 }, { 0, 3, 7, 6 }, { 0, 7, 4, 6 },
+    { 0, 4, 5, 6 }, { 0, 5, 1, 6 } };
+  for (int k = 0; k < res; ++k)
+  {
+    for (int j = 0; j < res; ++j)
+    {
+      for (int i = 0; i < res; ++i)
+      {
+        const vtkIdType h[8] = { id(i, j, k), id(i + 1, j, k), id(i + 1, j + 1, k),
+          id(i, j + 1, k), id(i, j, k + 1), id(i + 1, j, k + 1), id(i + 1, j + 1, k + 1),
+          id(i, j + 1, k + 1) };
+        for (const auto& tet : tets)
+        {
+          const vtkIdType ids[4] = { h[tet[0]], h[tet[1]], h[tet[2]], h[tet[3]] };
+          grid->InsertNextCell(VTK_TETRA, 4, ids);
+        }
+      }
+    }
+  }
+  AddVelocity(grid);
+  return grid;
+}
+
+// Two images side by side, splitting the same domain as the grid.
+vtkSmartPointer<vtkMultiBlockDataSet> MakeImages()
+{
+  auto blocks = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+  blocks->SetNumberOfBlocks(2);
+  for (int b = 0; b < 2; ++b)
+  {
+    vtkNew<vtkImageData> image;
+    image->SetOrigin(0, 0, 0);
+    image->SetSpacing(0.5, 0.5, 0.5);
+    image->SetExtent(10 * b, 10 * b + 10, 0, 20, 0, 20);
+    AddVelocity(image);
+    blocks->SetBlock(b, image);
+  }
+  return blocks;
+}
+
+// Seeds spread in and around the domain, some of them outside of it.
+vtkSmartPointer<vtkPolyData> MakeSeeds()
+{
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i < 150; ++i)
+  {
+    points->InsertNextPoint(5.0 + 6.0 * std::sin(0.7 * i), 5.0 + 6.0 * std::cos(1.3 * i),
+      5.0 + 4.0 * std::sin(2.1 * i));
+  }
+  auto seeds = vtkSmartPointer<vtkPolyData>::New();
+  seeds->SetPoints(points);
+  return seeds;
+}
+
+bool NeverTerminate(void*, vtkPoints*, vtkDataArray*, int)
+{
+  return false;
+}
+
+void Configure(
+  vtkStreamTracer* tracer, vtkDataObject* input, vtkPolyData* seeds, int interpolatorType)
+{
+  tracer->SetInputData(input);
+  tracer->SetSourceData(seeds);
+  tracer->SetInterpolatorType(interpolatorType);
+  tracer->SetIntegratorTypeToRungeKutta45();
+  tracer->SetIntegrationDirectionToBoth();
+  tracer->SetMaximumPropagation(30.0);
+  tracer->SetInitialIntegrationStep(0.2);
+  tracer->SetComputeVorticity(true);
+}
+
+int TestInput(vtkDataObject* input, vtkPolyData* seeds, int interpolatorType)
+{
+  vtkNew<vtkStreamTracer> sequentialTracer;
+  Configure(sequentialTracer, input, seeds, interpolatorType);
+  sequentialTracer->AddCustomTerminationCallback(&NeverTerminate, nullptr, 0);
+  sequentialTracer->Update();
+  vtkPolyData* expected = sequentialTracer->GetOutput();
+  if (expected->GetNumberOfLines() < 50)
+  {
+    cerr << "Only " << expected->GetNumberOfLines() << " streamlines were integrated" << endl;
+    return 1;
+  }
+
+  vtkNew<vtkStreamTracer> tracer;
+  Configure(tracer, input, seeds, interpolatorType);
+
+  return vtkSMPTestUtilities::RunWithThreads([&](int numThreads) {
+    tracer->Modified();
+    tracer->Update();
+    if (!vtkSMPTestUtilities::CompareOutputs(expected, tracer->GetOutput()))
+    {
+      cerr << "Wrong streamlines for " << input->GetClassName() << " with interpolator "
+           << interpolatorType << " and " << numThreads << " threads" << endl;
+      return 1;
+    }
+    return 0;
+  });
+}
+}
+
+int TestStreamTracerThreaded(int, char*[])
+{
+  vtkSmartPointer<vtkUnstructuredGrid> grid = MakeGrid();
+  vtkSmartPointer<vtkMultiBlockDataSet> images = MakeImages();
+  vtkSmartPointer<vtkPolyData> seeds = MakeSeeds();
+
+  int status = 0;
+  for (int interpolatorType : { vtkStreamTracer::INTERPOLATOR_WITH_DATASET_POINT_LOCATOR,
+         vtkStreamTracer::INTERPOLATOR_WITH_CELL_LOCATOR })
+  {
+    status |= TestInput(grid, seeds, interpolatorType);
+    status |= TestInput(images, seeds, interpolatorType);
+  }
+  return status;
+}
@@ -150,25 +150,7 @@ int vtkAbstractInterpolatedVelocityField::FunctionValues(vtkDataSet* dataset, do
   vtkPointSet* ps = vtkPointSet::SafeDownCast(dataset);
   if (ps != nullptr)
   {
-    vtkFindCellStrategy* strategy;
-    vtkStrategyMap::iterator sIter = this->StrategyMap->find(ps);
-    if (sIter == this->StrategyMap->end())
-    {
-      if (this->FindCellStrategy != nullptr)
-      {
-        strategy = this->FindCellStrategy->NewInstance();
-      }
-      else
-      {
-        strategy = vtkClosestPointStrategy::New(); // default type if not provided
-      }
-      this->StrategyMap->insert(std::make_pair(ps, strategy));
-    }
-    else
-    {
-      strategy = sIter->second;
-    }
-    strategy->Initialize(ps);
+    this->InitializeFindCellStrategy(ps);
   }
 
   // Compute function values
@@ -257,6 +239,30 @@ int vtkAbstractInterpolatedVelocityField::FunctionValues(vtkDataSet* dataset, do
   return 1;
 }
 
+//---------------------------------------------------------------------------
+void vtkAbstractInterpolatedVelocityField::InitializeFindCellStrategy(vtkPointSet* ps)
+{
+  vtkFindCellStrategy* strategy;
+  vtkStrategyMap::iterator sIter = this->StrategyMap->find(ps);
+  if (sIter == this->StrategyMap->end())
+  {
+    if (this->FindCellStrategy != nullptr)
+    {
+      strategy = this->FindCellStrategy->NewInstance();
+    }
+    else
+    {
+      strategy = vtkClosestPointStrategy::New(); // default type if not provided
+    }
+    this->StrategyMap->insert(std::make_pair(ps, strategy));
+  }
+  else
+  {
+    strategy = sIter->second;
+  }
+  strategy->Initialize(ps);
+}
+
 //---------------------------------------------------------------------------
 bool vtkAbstractInterpolatedVelocityField::CheckPCoords(double pcoords[3])
 {
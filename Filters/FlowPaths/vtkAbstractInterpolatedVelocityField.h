@@ -72,6 +72,7 @@
 class vtkDataSet;
 class vtkDataArray;
 class vtkPointData;
+class vtkPointSet;
 class vtkGenericCell;
 class vtkAbstractInterpolatedVelocityFieldDataSetsType;
 class vtkFindCellStrategy;
@@ -261,6 +262,12 @@ protected:
    */
   virtual int FunctionValues(vtkDataSet* ds, double* x, double* f);
 
+  /**
+   * Create, if needed, and initialize the FindCell() strategy of a point set.
+   * Initializing a strategy builds the locator of the point set it relies on.
+   */
+  void InitializeFindCellStrategy(vtkPointSet* ps);
+
   /**
    * Check that all three pcoords are between 0 and 1 included.
    */
@@ -259,6 +259,41 @@ void vtkCellLocatorInterpolatedVelocityField::AddDataSet(vtkDataSet* dataset)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkCellLocatorInterpolatedVelocityField::BuildLocators()
+{
+  this->Superclass::BuildLocators();
+
+  for (vtkAbstractCellLocator* locator : *this->CellLocators)
+  {
+    if (locator)
+    {
+      locator->BuildLocator();
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkCellLocatorInterpolatedVelocityField::ShareDataSets(
+  vtkCompositeInterpolatedVelocityField* from)
+{
+  this->Superclass::ShareDataSets(from);
+
+  vtkCellLocatorInterpolatedVelocityField* other =
+    vtkCellLocatorInterpolatedVelocityField::SafeDownCast(from);
+  if (other)
+  {
+    *this->CellLocators = *other->CellLocators;
+  }
+  else
+  {
+    // Without locators to share, the point sets are evaluated through their
+    // FindCell() strategies, as the other datasets.
+    this->CellLocators->assign(this->DataSets->size(), nullptr);
+  }
+  this->LastCellLocator = nullptr;
+}
+
 //----------------------------------------------------------------------------
 void vtkCellLocatorInterpolatedVelocityField::CopyParameters(
   vtkAbstractInterpolatedVelocityField* from)
@@ -101,6 +101,18 @@ public:
    */
   void AddDataSet(vtkDataSet* dataset) override;
 
+  /**
+   * Also build the cell locators of the point sets, which are then shared by
+   * the velocity fields made with ShareDataSets().
+   */
+  void BuildLocators() override;
+
+  /**
+   * Evaluate the datasets of another velocity field, sharing its cell
+   * locators.
+   */
+  void ShareDataSets(vtkCompositeInterpolatedVelocityField* from) override;
+
   using Superclass::FunctionValues;
   /**
    * Evaluate the velocity field f at point (x, y, z).
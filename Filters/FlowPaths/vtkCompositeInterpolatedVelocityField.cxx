@@ -18,6 +18,7 @@
 #include "vtkDataSet.h"
 #include "vtkGenericCell.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 
@@ -35,6 +36,47 @@ vtkCompositeInterpolatedVelocityField::~vtkCompositeInterpolatedVelocityField()
   this->DataSets = nullptr;
 }
 
+//----------------------------------------------------------------------------
+void vtkCompositeInterpolatedVelocityField::BuildLocators()
+{
+  vtkNew<vtkGenericCell> cell;
+  for (vtkDataSet* dataset : *this->DataSets)
+  {
+    // The bounds and the cells of some datasets are built the first time they
+    // are queried.
+    if (dataset)
+    {
+      dataset->GetLength();
+      if (dataset->GetNumberOfCells() > 0)
+      {
+        dataset->GetCell(0, cell);
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkCompositeInterpolatedVelocityField::ShareDataSets(
+  vtkCompositeInterpolatedVelocityField* from)
+{
+  this->CopyParameters(from);
+  this->SelectVectors(from->VectorsType, from->VectorsSelection);
+  this->NormalizeVector = from->NormalizeVector;
+  this->ForceSurfaceTangentVector = from->ForceSurfaceTangentVector;
+  this->SurfaceDataset = from->SurfaceDataset;
+
+  *this->DataSets = *from->DataSets;
+  if (from->WeightsSize > this->WeightsSize)
+  {
+    this->WeightsSize = from->WeightsSize;
+    delete[] this->Weights;
+    this->Weights = new double[this->WeightsSize];
+  }
+  this->LastCellId = -1;
+  this->LastDataSet = nullptr;
+  this->LastDataSetIndex = 0;
+}
+
 //----------------------------------------------------------------------------
 void vtkCompositeInterpolatedVelocityField::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -22,7 +22,10 @@
  *
  * @warning
  *  vtkCompositeInterpolatedVelocityField is not thread safe. A new instance
- *  should be created by each thread.
+ *  should be created by each thread. Such instances can share the datasets,
+ *  and the locators built for them, of a single velocity field: call
+ *  BuildLocators() on it once from one thread, then ShareDataSets() on each
+ *  new instance.
  *
  * @sa
  *  vtkInterpolatedVelocityField vtkCellLocatorInterpolatedVelocityField
@@ -59,6 +62,23 @@ public:
    */
   virtual void AddDataSet(vtkDataSet* dataset) = 0;
 
+  /**
+   * Build the structures used to locate cells in the datasets added so far,
+   * such as the point and cell locators and the cell links, so that velocity
+   * fields sharing these datasets through ShareDataSets() can be evaluated
+   * concurrently. This method must be called from a single thread.
+   */
+  virtual void BuildLocators();
+
+  /**
+   * Evaluate the datasets of another velocity field, with the same parameters
+   * and sharing its locators. The datasets previously added to this velocity
+   * field are removed. Once BuildLocators() has been called on from, several
+   * velocity fields sharing its datasets can be evaluated concurrently, one
+   * per thread.
+   */
+  virtual void ShareDataSets(vtkCompositeInterpolatedVelocityField* from);
+
   //@{
   /**
    * Get the most recently visited dataset and its id. The dataset is used
@@ -16,7 +16,10 @@
 
 #include "vtkDataSet.h"
 #include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointSet.h"
 
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkInterpolatedVelocityField);
@@ -41,6 +44,25 @@ void vtkInterpolatedVelocityField::AddDataSet(vtkDataSet* dataset)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkInterpolatedVelocityField::BuildLocators()
+{
+  this->Superclass::BuildLocators();
+
+  // The FindCell() strategies rely on the point locators and on the links of
+  // the point sets.
+  vtkNew<vtkIdList> cellIds;
+  for (vtkDataSet* dataset : *this->DataSets)
+  {
+    vtkPointSet* ps = vtkPointSet::SafeDownCast(dataset);
+    if (ps && ps->GetNumberOfPoints() > 0)
+    {
+      ps->GetPointCells(0, cellIds);
+      this->InitializeFindCellStrategy(ps);
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkInterpolatedVelocityField::SetLastCellId(vtkIdType c, int dataindex)
 {
@@ -87,6 +87,12 @@ public:
    */
   void AddDataSet(vtkDataSet* dataset) override;
 
+  /**
+   * Also build the point locators and the cell links used by the FindCell()
+   * strategies of the point sets.
+   */
+  void BuildLocators() override;
+
   using Superclass::FunctionValues;
   /**
    * Evaluate the velocity field f at point (x, y, z).
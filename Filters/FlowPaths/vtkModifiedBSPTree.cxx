@@ -18,6 +18,7 @@
 #include "vtkIdListCollection.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 
 #include <algorithm>
 #include <functional>
@@ -43,6 +44,8 @@ enum
 };
 //
 const double Epsilon_ = 1E-8;
+// Nodes with fewer cells are divided sequentially
+const vtkIdType ParallelSize_ = 10000;
 
 //////////////////////////////////////////////////////////////////////////////
 // Main management and support for tree
@@ -212,24 +215,25 @@ void vtkModifiedBSPTree::BuildLocatorInternal()
   //
   this->StoreCellBounds();
   //
-  // sort the cells into 6 lists using structure for subdividing tests
+  // sort the cells into 6 lists using structure for subdividing tests.
+  // The lists are independent and are filled and sorted in parallel.
   Sorted_cell_extents_Lists* lists = new Sorted_cell_extents_Lists(numCells);
-  for (int i = 0; i < 3; i++)
-  { // loop over each axis
-    for (vtkIdType j = 0; j < numCells; j++)
-    {                                                   // loop over each cell
-      lists->Mins[i][j].min = CellBounds[j][i * 2];     // i=0 xmin, i=1 ymin, i=2 zmin
-      lists->Mins[i][j].max = CellBounds[j][i * 2 + 1]; // i=0 xmax, i=1 ymax, i=2 zmax
-      lists->Mins[i][j].cell_ID = j;
-      //
-      lists->Maxs[i][j].min = CellBounds[j][i * 2];
-      lists->Maxs[i][j].max = CellBounds[j][i * 2 + 1];
-      lists->Maxs[i][j].cell_ID = j;
+  double(*cellBounds)[6] = this->CellBounds;
+  vtkSMPTools::For(0, 6, 1, [lists, cellBounds, numCells](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType list = begin; list < end; list++)
+    {
+      const int i = static_cast<int>(list / 2); // the axis of the list
+      cell_extents_List extents = list % 2 ? lists->Maxs[i] : lists->Mins[i];
+      for (vtkIdType j = 0; j < numCells; j++)
+      {                                               // loop over each cell
+        extents[j].min = cellBounds[j][i * 2];     // i=0 xmin, i=1 ymin, i=2 zmin
+        extents[j].max = cellBounds[j][i * 2 + 1]; // i=0 xmax, i=1 ymax, i=2 zmax
+        extents[j].cell_ID = j;
+      }
+      // Sort
+      qsort(extents, numCells, sizeof(cell_extents), list % 2 ? __compareMax : __compareMin);
     }
-    // Sort
-    qsort(lists->Mins[i], numCells, sizeof(cell_extents), __compareMin);
-    qsort(lists->Maxs[i], numCells, sizeof(cell_extents), __compareMax);
-  }
+  });
   //
   // call the recursive subdivision routine
   //
@@ -328,82 +332,53 @@ void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lis
       // we ought to keep track of how many we are adding to each list
       vtkIdType Cmin_l[3] = { 0, 0, 0 }, Cmin_m[3] = { 0, 0, 0 }, Cmin_r[3] = { 0, 0, 0 };
       vtkIdType Cmax_l[3] = { 0, 0, 0 }, Cmax_m[3] = { 0, 0, 0 }, Cmax_r[3] = { 0, 0, 0 };
-      // Partition the cells into the correct child lists
-      // here we use the lists for the axis we're dividing along
-      for (vtkIdType i = 0; i < nCells; i++)
-      {
-        // process the MIN-List
-        cell_extents ext = lists->Mins[Daxis][i];
-        // max is on left of middle node
-        if (ext.max < pDiv)
-        {
-          left->Mins[Daxis][Cmin_l[Daxis]++] = ext;
-        }
-        // min is on right of middle node
-        else if (ext.min > pDiv)
-        {
-          right->Mins[Daxis][Cmin_r[Daxis]++] = ext;
-        }
-        // neither - must be one of ours
-        else
-        {
-          mid->Mins[Daxis][Cmin_m[Daxis]++] = ext;
-        }
-        //
-        // process the MAX-List
-        ext = lists->Maxs[Daxis][i];
-        // max is on left of middle node
-        if (ext.max < pDiv)
-        {
-          left->Maxs[Daxis][Cmax_l[Daxis]++] = ext;
-        }
-        // min is on right of middle node
-        else if (ext.min > pDiv)
-        {
-          right->Maxs[Daxis][Cmax_r[Daxis]++] = ext;
-        }
-        // neither - must be one of ours
-        else
-        {
-          mid->Maxs[Daxis][Cmax_m[Daxis]++] = ext;
-        }
-      }
-      // construct the sorted list of extents for the 2 remaining axes
-      // do everything in order so our sorted lists aren't munged
-      for (Daxis = (node->mAxis + 1) % 3; Daxis != node->mAxis; Daxis = (Daxis + 1) % 3)
-      {
-        for (vtkIdType i = 0; i < nCells; i++)
+      // Partition the cells into the correct child lists, keeping the order
+      // of each list. The cells of the lists of the axis we're dividing along
+      // are classified with their own extents, those of the 2 remaining axes
+      // with the bounds of the cells, which hold the same values. The 6
+      // lists are independent and are partitioned in parallel for large
+      // nodes.
+      auto partition = [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType list = begin; list < end; list++)
         {
-          // process the MIN-List
-          cell_extents ext = lists->Mins[Daxis][i];
-          if (this->CellBounds[ext.cell_ID][2 * node->mAxis + 1] < pDiv)
+          const int axis = static_cast<int>(list / 2);
+          const bool isMax = (list % 2) != 0;
+          const cell_extents_List extents = isMax ? lists->Maxs[axis] : lists->Mins[axis];
+          cell_extents_List children[3] = { isMax ? left->Maxs[axis] : left->Mins[axis],
+            isMax ? mid->Maxs[axis] : mid->Mins[axis],
+            isMax ? right->Maxs[axis] : right->Mins[axis] };
+          vtkIdType counts[3] = { 0, 0, 0 };
+          for (vtkIdType i = 0; i < nCells; i++)
           {
-            left->Mins[Daxis][Cmin_l[Daxis]++] = ext;
-          }
-          else if (this->CellBounds[ext.cell_ID][2 * node->mAxis] > pDiv)
-          {
-            right->Mins[Daxis][Cmin_r[Daxis]++] = ext;
-          }
-          else
-          {
-            mid->Mins[Daxis][Cmin_m[Daxis]++] = ext;
-          }
-          //
-          // process the MAX-List
-          ext = lists->Maxs[Daxis][i];
-          if (this->CellBounds[ext.cell_ID][2 * node->mAxis + 1] < pDiv)
-          {
-            left->Maxs[Daxis][Cmax_l[Daxis]++] = ext;
-          }
-          else if (this->CellBounds[ext.cell_ID][2 * node->mAxis] > pDiv)
-          {
-            right->Maxs[Daxis][Cmax_r[Daxis]++] = ext;
-          }
-          else
-          {
-            mid->Maxs[Daxis][Cmax_m[Daxis]++] = ext;
+            const cell_extents& ext = extents[i];
+            // max is on left of middle node
+            if (this->CellBounds[ext.cell_ID][2 * Daxis + 1] < pDiv)
+            {
+              children[0][counts[0]++] = ext;
+            }
+            // min is on right of middle node
+            else if (this->CellBounds[ext.cell_ID][2 * Daxis] > pDiv)
+            {
+              children[2][counts[2]++] = ext;
+            }
+            // neither - must be one of ours
+            else
+            {
+              children[1][counts[1]++] = ext;
+            }
           }
+          (isMax ? Cmax_l : Cmin_l)[axis] = counts[0];
+          (isMax ? Cmax_m : Cmin_m)[axis] = counts[1];
+          (isMax ? Cmax_r : Cmin_r)[axis] = counts[2];
         }
+      };
+      if (nCells < ParallelSize_)
+      {
+        partition(0, 6);
+      }
+      else
+      {
+        vtkSMPTools::For(0, 6, 1, partition);
       }
       //
       // Better check we didn't make a diddly
@@ -652,18 +627,15 @@ int BSPNode::getDominantAxis(const double dir[3])
 }
 //---------------------------------------------------------------------------
 int vtkModifiedBSPTree::IntersectWithLine(const double p1[3], const double p2[3], double tol,
-  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell)
+  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId)
 {
-  int hit = this->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId);
-  if (hit)
-  {
-    this->DataSet->GetCell(cellId, cell);
-  }
-  return hit;
+  return this->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId, this->GenericCell);
 }
 //---------------------------------------------------------------------------
+// The tree is only read and the supplied cell is the only scratch cell used,
+// so that this method is thread safe once the tree is built.
 int vtkModifiedBSPTree::IntersectWithLine(const double p1[3], const double p2[3], double tol,
-  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId)
+  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell)
 {
   //
   BSPNode *node, *Near, *Mid, *Far;
@@ -782,7 +754,7 @@ int vtkModifiedBSPTree::IntersectWithLine(const double p1[3], const double p2[3]
       ctmax = _tmax;
       if (BSPNode::RayMinMaxT(CellBounds[cell_ID], p1, ray_vec, ctmin, ctmax))
       {
-        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId))
+        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId, cell))
         {
           if (t_hit < closest_intersection)
           {
@@ -801,6 +773,8 @@ int vtkModifiedBSPTree::IntersectWithLine(const double p1[3], const double p2[3]
   if (HIT)
   {
     t = closest_intersection;
+    // The cell may have been overwritten by later candidates
+    this->DataSet->GetCell(cellId, cell);
   }
   //
   return HIT;
@@ -950,7 +924,8 @@ int vtkModifiedBSPTree::IntersectWithLine(
       ctmax = _tmax;
       if (BSPNode::RayMinMaxT(CellBounds[cell_ID], p1, ray_vec, ctmin, ctmax))
       {
-        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId))
+        if (this->IntersectCellInternal(
+              cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId, this->GenericCell))
         {
           if (points)
           {
@@ -997,10 +972,11 @@ int vtkModifiedBSPTree::IntersectWithLine(
 }
 //---------------------------------------------------------------------------
 int vtkModifiedBSPTree::IntersectCellInternal(vtkIdType cell_ID, const double p1[3],
-  const double p2[3], const double tol, double& t, double ipt[3], double pcoords[3], int& subId)
+  const double p2[3], const double tol, double& t, double ipt[3], double pcoords[3], int& subId,
+  vtkGenericCell* cell)
 {
-  this->DataSet->GetCell(cell_ID, this->GenericCell);
-  return this->GenericCell->IntersectWithLine(
+  this->DataSet->GetCell(cell_ID, cell);
+  return cell->IntersectWithLine(
     const_cast<double*>(p1), const_cast<double*>(p2), tol, t, ipt, pcoords, subId);
 }
 //////////////////////////////////////////////////////////////////////////////
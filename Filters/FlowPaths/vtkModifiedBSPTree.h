@@ -94,6 +94,11 @@
  * Cells are only sorted into 6 lists once - before tree creation, each node
  * segments the lists and passes them down to the new child nodes whilst
  * maintaining sorted order. This makes for an efficient subdivision strategy.
+ * The 6 lists are sorted, and those of large nodes are segmented, in parallel
+ * with vtkSMPTools.
+ *
+ * Once the tree is built, FindCell() and IntersectWithLine() may be called
+ * concurrently as long as each thread supplies its own vtkGenericCell.
  *
  * NB. The following reference has been sent to me
  *   @Article{formella-1995-ray,
@@ -203,6 +208,7 @@ public:
   /**
    * Return intersection point (if any) AND the cell which was intersected by
    * the finite line. The cell is returned as a cell id and as a generic cell.
+   * This method is thread safe once the locator is built.
    */
   int IntersectWithLine(const double p1[3], const double p2[3], double tol, double& t, double x[3],
     double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell) override;
@@ -220,7 +226,7 @@ public:
 
   /**
    * Test a point to find if it is inside a cell. Returns the cellId if inside
-   * or -1 if not.
+   * or -1 if not. This method is thread safe once the locator is built.
    */
   vtkIdType FindCell(
     double x[3], double tol2, vtkGenericCell* GenCell, double pcoords[3], double* weights) override;
@@ -253,7 +259,8 @@ protected:
   // (Example : Particles stored in tree, have no dimension, so we must
   // override the cell test to return a value based on some particle size
   virtual int IntersectCellInternal(vtkIdType cell_ID, const double p1[3], const double p2[3],
-    const double tol, double& t, double ipt[3], double pcoords[3], int& subId);
+    const double tol, double& t, double ipt[3], double pcoords[3], int& subId,
+    vtkGenericCell* cell);
 
   void BuildLocatorIfNeeded();
   void ForceBuildLocator();
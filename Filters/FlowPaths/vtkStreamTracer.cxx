@@ -16,6 +16,7 @@ PURPOSE.  See the above copyright notice for more information.
 
 #include "vtkAMRInterpolatedVelocityField.h"
 #include "vtkAbstractInterpolatedVelocityField.h"
+#include "vtkAppendPolyData.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCellLocatorInterpolatedVelocityField.h"
@@ -43,9 +44,13 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkRungeKutta2.h"
 #include "vtkRungeKutta4.h"
 #include "vtkRungeKutta45.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStaticCellLocator.h"
 
+#include <algorithm>
+#include <atomic>
 #include <vector>
 
 vtkObjectFactoryNewMacro(vtkStreamTracer);
@@ -56,6 +61,10 @@ const double vtkStreamTracer::EPSILON = 1.0E-12;
 
 namespace
 {
+// Number of seeds integrated into each output block when the seeds are
+// integrated in parallel. The blocks do not depend on the number of threads.
+const vtkIdType SEEDS_PER_BLOCK = 16;
+
 // special function to interpolate the point data from the input to the output
 // if fast == true, then it just calls the usual InterpolatePoint function,
 // otherwise,
@@ -653,6 +662,106 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
   const char* vecName, double& inPropagation, vtkIdType& inNumSteps, double& inIntegrationTime)
 {
   vtkIdType numLines = seedIds->GetNumberOfIds();
+
+  if (this->GetIntegrator() == nullptr)
+  {
+    vtkErrorMacro("No integrator is specified.");
+    return;
+  }
+
+  // Check Surface option
+  if (this->SurfaceStreamlines == true)
+  {
+    vtkInterpolatedVelocityField* surfaceFunc = vtkInterpolatedVelocityField::SafeDownCast(func);
+    if (surfaceFunc == nullptr)
+    {
+      vtkWarningMacro(<< "Surface Streamlines works only with Point Locator "
+                         "Interpolated Velocity Field, setting it off");
+      this->SetSurfaceStreamlines(false);
+    }
+    else
+    {
+      surfaceFunc->SetForceSurfaceTangentVector(true);
+      surfaceFunc->SetSurfaceDataset(true);
+    }
+  }
+
+  // The seeds are integrated by blocks, each in its own output, by one copy
+  // of the velocity field per thread. The custom termination callbacks are
+  // not assumed to be thread safe, nor are the progress observers: progress
+  // is only reported once all the blocks are integrated.
+  vtkCompositeInterpolatedVelocityField* compositeFunc =
+    vtkCompositeInterpolatedVelocityField::SafeDownCast(func);
+  bool completed = true;
+  if (numLines > 1 && compositeFunc && this->CustomTerminationCallback.empty())
+  {
+    compositeFunc->BuildLocators();
+
+    const vtkIdType numBlocks = (numLines + SEEDS_PER_BLOCK - 1) / SEEDS_PER_BLOCK;
+    std::vector<vtkSmartPointer<vtkPolyData>> blocks(numBlocks);
+    vtkSMPThreadLocal<vtkSmartPointer<vtkCompositeInterpolatedVelocityField>> localFuncs;
+    std::atomic<bool> aborted(false);
+    vtkSMPTools::For(0, numBlocks, 1, [&](vtkIdType beginBlock, vtkIdType endBlock) {
+      vtkSmartPointer<vtkCompositeInterpolatedVelocityField>& localFunc = localFuncs.Local();
+      if (!localFunc)
+      {
+        localFunc.TakeReference(compositeFunc->NewInstance());
+        localFunc->ShareDataSets(compositeFunc);
+      }
+      for (vtkIdType block = beginBlock; block < endBlock && !aborted; ++block)
+      {
+        // Only the first seed starts from the given propagation, number of
+        // steps and integration time.
+        double propagation = block == 0 ? inPropagation : 0.0;
+        vtkIdType numSteps = block == 0 ? inNumSteps : 0;
+        double integrationTime = block == 0 ? inIntegrationTime : 0.0;
+        double blockLastPoint[3];
+        blocks[block] = vtkSmartPointer<vtkPolyData>::New();
+        if (!this->IntegrateSeeds(input0Data, blocks[block], seedSource, seedIds,
+              block * SEEDS_PER_BLOCK, std::min(numLines, (block + 1) * SEEDS_PER_BLOCK),
+              integrationDirections, blockLastPoint, localFunc, maxCellSize, vecType, vecName,
+              propagation, numSteps, integrationTime, true))
+        {
+          aborted = true;
+        }
+      }
+    });
+    completed = !aborted;
+    this->UpdateProgress(1.0);
+    if (completed)
+    {
+      // Assemble the streamlines in the order of their seeds.
+      vtkNew<vtkAppendPolyData> append;
+      for (vtkPolyData* block : blocks)
+      {
+        append->AddInputData(block);
+      }
+      append->Update();
+      output->ShallowCopy(append->GetOutput());
+    }
+  }
+  else
+  {
+    completed = this->IntegrateSeeds(input0Data, output, seedSource, seedIds, 0, numLines,
+      integrationDirections, lastPoint, func, maxCellSize, vecType, vecName, inPropagation,
+      inNumSteps, inIntegrationTime, false);
+  }
+
+  if (completed && output->GetNumberOfPoints() > 1 && this->GenerateNormalsInIntegrate)
+  {
+    this->GenerateNormals(output, nullptr, vecName);
+  }
+  output->Squeeze();
+}
+
+//---------------------------------------------------------------------------
+bool vtkStreamTracer::IntegrateSeeds(vtkPointData* input0Data, vtkPolyData* output,
+  vtkDataArray* seedSource, vtkIdList* seedIds, vtkIdType beginLine, vtkIdType endLine,
+  vtkIntArray* integrationDirections, double lastPoint[3],
+  vtkAbstractInterpolatedVelocityField* func, int maxCellSize, int vecType, const char* vecName,
+  double& inPropagation, vtkIdType& inNumSteps, double& inIntegrationTime, bool threaded)
+{
+  vtkIdType numLines = seedIds->GetNumberOfIds();
   double propagation = inPropagation;
   vtkIdType numSteps = inNumSteps;
   double integrationTime = inIntegrationTime;
@@ -666,12 +775,6 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
 
   int direction = 1;
 
-  if (this->GetIntegrator() == nullptr)
-  {
-    vtkErrorMacro("No integrator is specified.");
-    return;
-  }
-
   double* weights = nullptr;
   if (maxCellSize > 0)
   {
@@ -685,22 +788,10 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
   vtkInitialValueProblemSolver* integrator = this->GetIntegrator()->NewInstance();
   integrator->SetFunctionSet(func);
 
-  // Check Surface option
   vtkInterpolatedVelocityField* surfaceFunc = nullptr;
   if (this->SurfaceStreamlines == true)
   {
     surfaceFunc = vtkInterpolatedVelocityField::SafeDownCast(func);
-    if (surfaceFunc == nullptr)
-    {
-      vtkWarningMacro(<< "Surface Streamlines works only with Point Locator "
-                         "Interpolated Velocity Field, setting it off");
-      this->SetSurfaceStreamlines(false);
-    }
-    else
-    {
-      surfaceFunc->SetForceSurfaceTangentVector(true);
-      surfaceFunc->SetSurfaceDataset(true);
-    }
   }
 
   // Since we do not know what the total number of points
@@ -773,10 +864,13 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
 
   int shouldAbort = 0;
 
-  for (int currentLine = 0; currentLine < numLines; currentLine++)
+  for (vtkIdType currentLine = beginLine; currentLine < endLine; currentLine++)
   {
     double progress = static_cast<double>(currentLine) / numLines;
-    this->UpdateProgress(progress);
+    if (!threaded)
+    {
+      this->UpdateProgress(progress);
+    }
 
     switch (integrationDirections->GetValue(currentLine))
     {
@@ -921,8 +1015,11 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
 
       if (numSteps++ % 1000 == 1)
       {
-        progress = (currentLine + propagation / this->MaximumPropagation) / numLines;
-        this->UpdateProgress(progress);
+        if (!threaded)
+        {
+          progress = (currentLine + propagation / this->MaximumPropagation) / numLines;
+          this->UpdateProgress(progress);
+        }
 
         if (this->GetAbortExecute())
         {
@@ -955,7 +1052,10 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
         }
         maxStep = stepSize.Interval;
       }
-      this->LastUsedStepSize = stepSize.Interval;
+      if (!threaded)
+      {
+        this->LastUsedStepSize = stepSize.Interval;
+      }
 
       // Calculate the next step using the integrator provided
       // Break if the next point is out of bounds.
@@ -1155,11 +1255,6 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
     {
       // Assign geometry and attributes
       output->SetLines(outputLines);
-      if (this->GenerateNormalsInIntegrate)
-      {
-        this->GenerateNormals(output, nullptr, vecName);
-      }
-
       outputCD->AddArray(retVals);
       outputCD->AddArray(sids);
     }
@@ -1189,7 +1284,7 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
 
   delete[] weights;
 
-  output->Squeeze();
+  return !shouldAbort;
 }
 
 //---------------------------------------------------------------------------
@@ -69,6 +69,13 @@
  * a source object, traces will be generated from each point in the source
  * that is inside the dataset.
  *
+ * The seeds are integrated in parallel with vtkSMPTools when the velocity
+ * field is a vtkCompositeInterpolatedVelocityField (the default) and no
+ * custom termination callback is set. Each thread evaluates its own copy of
+ * the velocity field, which shares the datasets and locators of the
+ * interpolator, and the streamlines are output in the order of their seeds,
+ * whatever the number of threads.
+ *
  * @sa
  * vtkRibbonFilter vtkRuledSurfaceFilter vtkInitialValueProblemSolver
  * vtkRungeKutta2 vtkRungeKutta4 vtkRungeKutta45 vtkParticleTracerBase
@@ -393,10 +400,27 @@ protected:
 
   void CalculateVorticity(
     vtkGenericCell* cell, double pcoords[3], vtkDoubleArray* cellVectors, double vorticity[3]);
+  /**
+   * Integrate the seeds and fill the output with the streamlines, in the
+   * order of the seeds. Several seeds are integrated in parallel when the
+   * velocity field is a vtkCompositeInterpolatedVelocityField and no custom
+   * termination callback is set; the last point, propagation, number of steps
+   * and integration time are then left unchanged.
+   */
   void Integrate(vtkPointData* inputData, vtkPolyData* output, vtkDataArray* seedSource,
     vtkIdList* seedIds, vtkIntArray* integrationDirections, double lastPoint[3],
     vtkAbstractInterpolatedVelocityField* func, int maxCellSize, int vecType,
     const char* vecFieldName, double& propagation, vtkIdType& numSteps, double& integrationTime);
+  /**
+   * Integrate the seeds of a range, without generating the normals. When
+   * threaded, the progress and the last used step size are not updated.
+   * Return false if the execution was aborted.
+   */
+  bool IntegrateSeeds(vtkPointData* inputData, vtkPolyData* output, vtkDataArray* seedSource,
+    vtkIdList* seedIds, vtkIdType beginLine, vtkIdType endLine, vtkIntArray* integrationDirections,
+    double lastPoint[3], vtkAbstractInterpolatedVelocityField* func, int maxCellSize, int vecType,
+    const char* vecFieldName, double& propagation, vtkIdType& numSteps, double& integrationTime,
+    bool threaded);
   double SimpleIntegrate(double seed[3], double lastPoint[3], double stepSize,
     vtkAbstractInterpolatedVelocityField* func);
   int CheckInputs(vtkAbstractInterpolatedVelocityField*& func, int* maxCellSize);
@@ -0,0 +1,224 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestGradientFilterThreaded.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Checks the point gradients computed by vtkGradientFilter from its cached
+// stencils against a direct sequential computation from the cell derivatives,
+// for all the contributing cell options, several arrays and several numbers of
+// threads. The cached stencils are checked to give the output of a new filter
+// after the points of the input are modified, and for another mesh with as
+// many points and cells.
+
+#include "vtkCell.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkGradientFilter.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+const int Res = 5;
+
+void AddPointData(vtkDataSet* ds)
+{
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkFloatArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  for (vtkIdType i = 0; i < ds->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    ds->GetPoint(i, x);
+    scalars->InsertNextValue(std::sin(x[0]) * x[1] + x[2] * x[2]);
+    vectors->InsertNextTuple3(x[1] * x[2], std::cos(x[0]), x[0] - 2 * x[1]);
+  }
+  ds->GetPointData()->AddArray(scalars);
+  ds->GetPointData()->AddArray(vectors);
+}
+
+// The average of the derivatives of the contributing cells at each point,
+// computed sequentially. Points without a valid cell keep the NaN
+// replacement value.
+std::vector<double> ReferenceGradients(vtkDataSet* ds, vtkDataArray* array, int option)
+{
+  const vtkIdType numPts = ds->GetNumberOfPoints();
+  const int numComps = array->GetNumberOfComponents();
+  int maxDimension = 0;
+  for (vtkIdType cellId = 0; cellId < ds->GetNumberOfCells(); ++cellId)
+  {
+    maxDimension = std::max(maxDimension, ds->GetCell(cellId)->GetCellDimension());
+  }
+
+  std::vector<double> result(numPts * 3 * numComps, vtkMath::Nan());
+  vtkNew<vtkIdList> cellIds;
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    ds->GetPointCells(ptId, cellIds);
+    int minDimension = option == vtkGradientFilter::DataSetMax ? maxDimension : 0;
+    for (vtkIdType i = 0; option == vtkGradientFilter::Patch && i < cellIds->GetNumberOfIds(); ++i)
+    {
+      minDimension = std::max(minDimension, ds->GetCell(cellIds->GetId(i))->GetCellDimension());
+    }
+    std::vector<double> sum(3 * numComps, 0.0);
+    int count = 0;
+    for (vtkIdType i = 0; i < cellIds->GetNumberOfIds(); ++i)
+    {
+      vtkCell* cell = ds->GetCell(cellIds->GetId(i));
+      if (cell->GetCellDimension() < minDimension)
+      {
+        continue;
+      }
+      double x[3], pcoords[3], dist2;
+      int subId;
+      std::vector<double> weights(cell->GetNumberOfPoints());
+      ds->GetPoint(ptId, x);
+      cell->EvaluatePosition(x, nullptr, subId, pcoords, dist2, weights.data());
+      ++count;
+      std::vector<double> values(cell->GetNumberOfPoints());
+      for (int c = 0; c < numComps; ++c)
+      {
+        for (vtkIdType p = 0; p < cell->GetNumberOfPoints(); ++p)
+        {
+          values[p] = array->GetComponent(cell->GetPointId(p), c);
+        }
+        double derivative[3];
+        cell->Derivatives(subId, pcoords, values.data(), 1, derivative);
+        for (int j = 0; j < 3; ++j)
+        {
+          sum[3 * c + j] += derivative[j];
+        }
+      }
+    }
+    for (int v = 0; v < 3 * numComps && count > 0; ++v)
+    {
+      result[ptId * 3 * numComps + v] = sum[v] / count;
+    }
+  }
+  return result;
+}
+
+int TestInput(vtkPointSet* input)
+{
+  int status = 0;
+  vtkNew<vtkGradientFilter> filter;
+  filter->SetInputData(input);
+  filter->SetReplacementValueOption(vtkGradientFilter::NaN);
+  for (int option = 0; option < 3; ++option)
+  {
+    filter->SetContributingCellOption(option);
+    for (const char* name : { "Scalars", "Vectors" })
+    {
+      filter->SetInputScalars(vtkDataObject::FIELD_ASSOCIATION_POINTS, name);
+      filter->Update();
+      vtkDataArray* gradients = filter->GetOutput()->GetPointData()->GetArray("Gradients");
+      // The vector gradients are computed in single precision.
+      const double tolerance = gradients && gradients->GetDataType() == VTK_FLOAT ? 1e-5 : 1e-10;
+      if (!vtkSMPTestUtilities::CompareValues(gradients,
+            ReferenceGradients(input, input->GetPointData()->GetArray(name), option), tolerance))
+      {
+        cerr << "Wrong gradients of " << name << " for " << input->GetClassName()
+             << " and option " << option << endl;
+        status = 1;
+      }
+    }
+  }
+  return status;
+}
+
+// Whether the filter, which may reuse its stencils, gives the same output as
+// a new filter.
+template <typename DataSetT>
+bool SameAsNewFilter(vtkGradientFilter* filter, DataSetT* input)
+{
+  vtkNew<vtkGradientFilter> newFilter;
+  newFilter->SetInputData(input);
+  newFilter->SetInputScalars(vtkDataObject::FIELD_ASSOCIATION_POINTS, "Scalars");
+  newFilter->SetReplacementValueOption(vtkGradientFilter::NaN);
+  newFilter->Update();
+  return vtkSMPTestUtilities::CompareOutputs(
+    DataSetT::SafeDownCast(newFilter->GetOutput()), DataSetT::SafeDownCast(filter->GetOutput()));
+}
+
+int TestCachedStencils()
+{
+  int status = 0;
+
+  // The stencils are rebuilt when the points move.
+  vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSMPTestUtilities::MakeMixedGrid(Res);
+  AddPointData(grid);
+  vtkNew<vtkGradientFilter> filter;
+  filter->SetInputData(grid);
+  filter->SetInputScalars(vtkDataObject::FIELD_ASSOCIATION_POINTS, "Scalars");
+  filter->SetReplacementValueOption(vtkGradientFilter::NaN);
+  filter->Update();
+  vtkPoints* points = grid->GetPoints();
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    points->GetPoint(i, x);
+    points->SetPoint(i, 2 * x[0], x[1] + 0.1 * x[2], x[2]);
+  }
+  points->Modified();
+  filter->Update();
+  if (!SameAsNewFilter(filter, grid.Get()))
+  {
+    cerr << "Wrong gradients after modifying the points." << endl;
+    status = 1;
+  }
+
+  // The stencils of a mesh are not reused for another one with as many
+  // points and cells, whose topology has the same modification time.
+  vtkSmartPointer<vtkPoints> sharedPoints = vtkSMPTestUtilities::MakeLatticePoints(Res);
+  vtkSmartPointer<vtkPolyData> bottom =
+    vtkSMPTestUtilities::MakeMixedPolyData(sharedPoints, Res, 0);
+  vtkSmartPointer<vtkPolyData> top = vtkSMPTestUtilities::MakeMixedPolyData(sharedPoints, Res, 1);
+  AddPointData(bottom);
+  AddPointData(top);
+  sharedPoints->Modified();
+  filter->SetInputData(bottom);
+  filter->Update();
+  filter->SetInputData(top);
+  filter->Update();
+  if (!SameAsNewFilter(filter, top.Get()))
+  {
+    cerr << "Wrong gradients after changing the input." << endl;
+    status = 1;
+  }
+  return status;
+}
+}
+
+int TestGradientFilterThreaded(int, char*[])
+{
+  vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSMPTestUtilities::MakeMixedGrid(Res);
+  AddPointData(grid);
+  vtkSmartPointer<vtkPolyData> polyData =
+    vtkSMPTestUtilities::MakeMixedPolyData(vtkSMPTestUtilities::MakeLatticePoints(Res), Res, 0);
+  AddPointData(polyData);
+  return vtkSMPTestUtilities::RunWithThreads(
+    [&](int) { return TestInput(grid) | TestInput(polyData) | TestCachedStencils(); });
+}
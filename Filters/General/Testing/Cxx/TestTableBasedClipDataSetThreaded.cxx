@@ -0,0 +1,207 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTableBasedClipDataSetThreaded.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Checks that the threaded clipping of unstructured grids by
+// vtkTableBasedClipDataSet gives the same output as the sequential one, for
+// clip functions and scalars, on both sides. A bit array, which cannot be
+// copied concurrently, forces the sequential path.
+
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPlane.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphere.h"
+#include "vtkTableBasedClipDataSet.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+
+namespace
+{
+// A lattice of all the cell types the clip tables handle, with integral and
+// real point and cell data.
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid()
+{
+  const int res = 8;
+  const int dim = res + 1;
+  vtkNew<vtkFloatArray> coords;
+  coords->SetNumberOfComponents(3);
+  vtkNew<vtkPoints> points;
+  points->SetData(coords);
+  vtkNew<vtkDoubleArray> pointScalars;
+  pointScalars->SetName("PointScalars");
+  vtkNew<vtkIntArray> pointInts;
+  pointInts->SetName("PointInts");
+  pointInts->SetNumberOfComponents(2);
+  vtkNew<vtkFloatArray> pointVectors;
+  pointVectors->SetName("PointVectors");
+  pointVectors->SetNumberOfComponents(3);
+  for (int k = 0; k < dim; ++k)
+  {
+    for (int j = 0; j < dim; ++j)
+    {
+      for (int i = 0; i < dim; ++i)
+      {
+        points->InsertNextPoint(i + 0.1 * std::sin(j + k), j + 0.1 * std::cos(i * k), k);
+        pointScalars->InsertNextValue(std::sin(0.7 * i + 0.3 * j) + std::cos(0.4 * k));
+        pointInts->InsertNextTuple2(7 * i - 3 * j + k, i * j * k);
+        pointVectors->InsertNextTuple3(i, 0.5 * j, std::sqrt(k + 0.5));
+      }
+    }
+  }
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->GetPointData()->SetScalars(pointScalars);
+  grid->GetPointData()->AddArray(pointInts);
+  grid->GetPointData()->SetVectors(pointVectors);
+
+  grid->Allocate();
+  auto id = [dim](int i, int j, int k) -> vtkIdType { return i + dim * (j + dim * k); };
+  for (int k = 0; k < res; ++k)
+  {
+    for (int j = 0; j < res; ++j)
+    {
+      for (int i = 0; i < res; ++i)
+      {
+        const vtkIdType h[8] = { id(i, j, k), id(i + 1, j, k), id(i + 1, j + 1, k),
+          id(i, j + 1, k), id(i, j, k + 1), id(i + 1, j, k + 1), id(i + 1, j + 1, k + 1),
+          id(i, j + 1, k + 1) };
+        switch ((i + 2 * j + 3 * k) % 6)
+        {
+          case 0:
+            grid->InsertNextCell(VTK_HEXAHEDRON, 8, h);
+            break;
+          case 1:
+          {
+            const vtkIdType voxel[8] = { h[0], h[1], h[3], h[2], h[4], h[5], h[7], h[6] };
+            grid->InsertNextCell(VTK_VOXEL, 8, voxel);
+            break;
+          }
+          case 2:
+          {
+            const vtkIdType wedge1[6] = { h[0], h[1], h[3], h[4], h[5], h[7] };
+            const vtkIdType wedge2[6] = { h[1], h[2], h[3], h[5], h[6], h[7] };
+            grid->InsertNextCell(VTK_WEDGE, 6, wedge1);
+            grid->InsertNextCell(VTK_WEDGE, 6, wedge2);
+            break;
+          }
+          case 3:
+          {
+            const vtkIdType pyramid[5] = { h[0], h[1], h[2], h[3], h[6] };
+            const vtkIdType tet[4] = { h[0], h[4], h[5], h[6] };
+            grid->InsertNextCell(VTK_PYRAMID, 5, pyramid);
+            grid->InsertNextCell(VTK_TETRA, 4, tet);
+            break;
+          }
+          case 4:
+          {
+            const vtkIdType tri[3] = { h[0], h[1], h[6] };
+            const vtkIdType quad[4] = { h[4], h[5], h[6], h[7] };
+            const vtkIdType pixel[4] = { h[0], h[1], h[4], h[5] };
+            grid->InsertNextCell(VTK_TRIANGLE, 3, tri);
+            grid->InsertNextCell(VTK_QUAD, 4, quad);
+            grid->InsertNextCell(VTK_PIXEL, 4, pixel);
+            break;
+          }
+          default:
+            grid->InsertNextCell(VTK_LINE, 2, h);
+            grid->InsertNextCell(VTK_VERTEX, 1, h + 6);
+            break;
+        }
+      }
+    }
+  }
+
+  vtkNew<vtkDoubleArray> cellScalars;
+  cellScalars->SetName("CellScalars");
+  vtkNew<vtkIntArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType i = 0; i < grid->GetNumberOfCells(); ++i)
+  {
+    cellScalars->InsertNextValue(std::sin(0.01 * i));
+    cellIds->InsertNextValue(static_cast<int>(i));
+  }
+  grid->GetCellData()->AddArray(cellScalars);
+  grid->GetCellData()->AddArray(cellIds);
+  return grid;
+}
+
+int TestGrid(vtkUnstructuredGrid* grid)
+{
+  // The sequential path is used for the copy of the grid with a bit array.
+  vtkNew<vtkUnstructuredGrid> sequentialGrid;
+  sequentialGrid->ShallowCopy(grid);
+  vtkSMPTestUtilities::AddSequentialArray(sequentialGrid->GetCellData(), grid->GetNumberOfCells());
+
+  vtkNew<vtkPlane> plane;
+  plane->SetOrigin(3.3, 2.7, 4.1);
+  plane->SetNormal(1.0, 0.5, 0.2);
+  vtkNew<vtkSphere> sphere;
+  sphere->SetCenter(4.0, 4.0, 4.0);
+  sphere->SetRadius(3.2);
+
+  vtkImplicitFunction* functions[3] = { nullptr, plane, sphere };
+
+  int status = 0;
+  vtkNew<vtkTableBasedClipDataSet> sequential;
+  sequential->SetInputData(sequentialGrid);
+  vtkNew<vtkTableBasedClipDataSet> threaded;
+  threaded->SetInputData(grid);
+  for (int clip = 0; clip < 3; ++clip)
+  {
+    for (int options = 0; options < 8; ++options)
+    {
+      for (vtkTableBasedClipDataSet* clipper : { sequential.Get(), threaded.Get() })
+      {
+        clipper->SetClipFunction(functions[clip]);
+        clipper->SetValue(clip == 0 ? 0.3 : 0.4);
+        clipper->SetInsideOut((options & 1) != 0);
+        clipper->SetGenerateClipScalars(clip != 0 && (options & 2) != 0);
+        clipper->SetUseValueAsOffset((options & 4) != 0);
+        clipper->SetOutputPointsPrecision(
+          (options & 4) != 0 ? vtkAlgorithm::DOUBLE_PRECISION : vtkAlgorithm::DEFAULT_PRECISION);
+        clipper->GenerateClippedOutputOn();
+        clipper->Update();
+      }
+      if (!vtkSMPTestUtilities::CompareOutputs(sequential->GetOutput(), threaded->GetOutput()) ||
+        !vtkSMPTestUtilities::CompareOutputs(
+          sequential->GetClippedOutput(), threaded->GetClippedOutput()))
+      {
+        cerr << "Outputs differ for clip " << clip << ", options " << options << endl;
+        status = 1;
+      }
+      if (threaded->GetOutput()->GetNumberOfCells() == 0 ||
+        threaded->GetClippedOutput()->GetNumberOfCells() == 0)
+      {
+        cerr << "Nothing clipped for clip " << clip << ", options " << options << endl;
+        status = 1;
+      }
+    }
+  }
+  return status;
+}
+}
+
+int TestTableBasedClipDataSetThreaded(int, char*[])
+{
+  vtkSmartPointer<vtkUnstructuredGrid> grid = MakeGrid();
+  return vtkSMPTestUtilities::RunWithThreads([&](int) { return TestGrid(grid); });
+}
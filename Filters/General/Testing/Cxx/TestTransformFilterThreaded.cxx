@@ -0,0 +1,291 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTransformFilterThreaded.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Checks that the points, normals and vectors transformed in parallel by
+// vtkTransformFilter, vtkTransformPolyDataFilter and vtkLinearTransform, and
+// the points warped by vtkWarpVector and vtkWarpScalar, with one or several
+// threads, are those given point by point, for float, double and integer
+// arrays of several memory layouts, larger than a single task. Several
+// threads must give the same outputs as one.
+
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPlaneSource.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkSmartPointer.h"
+#include "vtkTransform.h"
+#include "vtkTransformFilter.h"
+#include "vtkTransformPolyDataFilter.h"
+#include "vtkWarpScalar.h"
+#include "vtkWarpVector.h"
+
+#include <cmath>
+
+namespace
+{
+// A plane with point normals, point vectors stored as structures of arrays,
+// an integer vector array, point scalars and cell normals.
+vtkSmartPointer<vtkPolyData> MakePlane(int resolution)
+{
+  vtkNew<vtkPlaneSource> plane;
+  plane->SetResolution(resolution, resolution);
+  plane->Update();
+  auto output = vtkSmartPointer<vtkPolyData>::New();
+  output->ShallowCopy(plane->GetOutput());
+  output->GetPointData()->Initialize();
+
+  const vtkIdType numPts = output->GetNumberOfPoints();
+  vtkNew<vtkFloatArray> normals;
+  normals->SetName("Normals");
+  normals->SetNumberOfComponents(3);
+  normals->SetNumberOfTuples(numPts);
+  vtkNew<vtkSOADataArrayTemplate<double>> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(numPts);
+  vtkNew<vtkIntArray> offsets;
+  offsets->SetName("Offsets");
+  offsets->SetNumberOfComponents(3);
+  offsets->SetNumberOfTuples(numPts);
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(numPts);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    double x[3];
+    output->GetPoint(ptId, x);
+    normals->SetTuple3(ptId, std::sin(3 * x[0]), std::cos(5 * x[1]), 1.0);
+    vectors->SetTuple3(ptId, x[1], -x[0], 2 * x[0] * x[1]);
+    offsets->SetTuple3(ptId, ptId % 7, -(ptId % 5), 1000);
+    scalars->SetValue(ptId, std::cos(4 * x[0]) * x[1]);
+  }
+  output->GetPointData()->SetNormals(normals);
+  output->GetPointData()->SetVectors(vectors);
+  output->GetPointData()->AddArray(offsets);
+  output->GetPointData()->SetScalars(scalars);
+
+  vtkNew<vtkFloatArray> cellNormals;
+  cellNormals->SetNumberOfComponents(3);
+  cellNormals->SetNumberOfTuples(output->GetNumberOfCells());
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    cellNormals->SetTuple3(cellId, 1.0, cellId % 3, 0.5);
+  }
+  output->GetCellData()->SetNormals(cellNormals);
+  return output;
+}
+
+bool CheckArray(vtkDataArray* expected, vtkDataArray* actual, const char* name)
+{
+  if (!vtkSMPTestUtilities::CompareArrays(expected, actual))
+  {
+    cerr << "Wrong " << name << endl;
+    return false;
+  }
+  return true;
+}
+
+// The arrays of the plane transformed tuple by tuple.
+struct Expected
+{
+  vtkNew<vtkFloatArray> Points;
+  vtkNew<vtkFloatArray> Normals;
+  vtkNew<vtkDoubleArray> Vectors;
+  vtkNew<vtkFloatArray> FloatVectors;
+  vtkNew<vtkIntArray> Offsets;
+  vtkNew<vtkFloatArray> CellNormals;
+
+  Expected(vtkPolyData* plane, vtkTransform* transform)
+  {
+    vtkPointData* pd = plane->GetPointData();
+    const vtkIdType numPts = plane->GetNumberOfPoints();
+    for (vtkDataArray* array : { vtkArrayDownCast<vtkDataArray>(this->Points),
+           vtkArrayDownCast<vtkDataArray>(this->Normals),
+           vtkArrayDownCast<vtkDataArray>(this->Vectors),
+           vtkArrayDownCast<vtkDataArray>(this->FloatVectors),
+           vtkArrayDownCast<vtkDataArray>(this->Offsets) })
+    {
+      array->SetNumberOfComponents(3);
+      array->SetNumberOfTuples(numPts);
+    }
+    this->CellNormals->SetNumberOfComponents(3);
+    this->CellNormals->SetNumberOfTuples(plane->GetNumberOfCells());
+    for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+    {
+      float in[3], out[3];
+      vtkFloatArray::SafeDownCast(plane->GetPoints()->GetData())->GetTypedTuple(ptId, in);
+      transform->TransformPoint(in, out);
+      this->Points->SetTypedTuple(ptId, out);
+      vtkFloatArray::SafeDownCast(pd->GetNormals())->GetTypedTuple(ptId, in);
+      transform->TransformNormal(in, out);
+      this->Normals->SetTypedTuple(ptId, out);
+
+      double vec[3];
+      pd->GetVectors()->GetTuple(ptId, vec);
+      transform->TransformVector(vec, vec);
+      this->Vectors->SetTuple(ptId, vec);
+      this->FloatVectors->SetTuple(ptId, vec);
+      pd->GetArray("Offsets")->GetTuple(ptId, vec);
+      transform->TransformVector(vec, vec);
+      const int offset[3] = { static_cast<int>(vec[0]), static_cast<int>(vec[1]),
+        static_cast<int>(vec[2]) };
+      this->Offsets->SetTypedTuple(ptId, offset);
+    }
+    for (vtkIdType cellId = 0; cellId < plane->GetNumberOfCells(); ++cellId)
+    {
+      float in[3], out[3];
+      vtkFloatArray::SafeDownCast(plane->GetCellData()->GetNormals())->GetTypedTuple(cellId, in);
+      transform->TransformNormal(in, out);
+      this->CellNormals->SetTypedTuple(cellId, out);
+    }
+  }
+
+  // vtkTransformFilter transforms all the vectors into arrays of the input
+  // types, vtkTransformPolyDataFilter only the active vectors into floats.
+  bool Check(vtkPointSet* output, bool transformFilter)
+  {
+    vtkPointData* pd = output->GetPointData();
+    return CheckArray(this->Points, output->GetPoints()->GetData(), "points") &&
+      CheckArray(this->Normals, pd->GetNormals(), "normals") &&
+      (transformFilter ? CheckArray(this->Vectors, pd->GetVectors(), "vectors") &&
+          pd->GetVectors()->GetArrayType() == vtkAbstractArray::SoADataArrayTemplate &&
+          CheckArray(this->Offsets, pd->GetArray("Offsets"), "offsets")
+                       : CheckArray(this->FloatVectors, pd->GetVectors(), "vectors")) &&
+      CheckArray(this->CellNormals, output->GetCellData()->GetNormals(), "cell normals");
+  }
+};
+}
+
+int TestTransformFilterThreaded(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> plane = MakePlane(300);
+  vtkPointData* pd = plane->GetPointData();
+  const vtkIdType numPts = plane->GetNumberOfPoints();
+  vtkNew<vtkTransform> transform;
+  transform->Translate(0.5, -2.0, 3.0);
+  transform->RotateWXYZ(30.0, 1.0, 2.0, 3.0);
+  transform->Scale(2.0, 0.5, 3.0);
+  Expected expected(plane, transform);
+
+  vtkSMPTestUtilities::OutputRecorder recorder;
+  return vtkSMPTestUtilities::RunWithThreads([&](int numThreads) {
+    int status = 0;
+    vtkNew<vtkTransformFilter> transformFilter;
+    transformFilter->SetInputData(plane);
+    transformFilter->SetTransform(transform);
+    transformFilter->TransformAllInputVectorsOn();
+    transformFilter->Update();
+    if (!recorder.Check(transformFilter->GetOutput(), numThreads) ||
+      !expected.Check(transformFilter->GetOutput(), true))
+    {
+      cerr << "Wrong vtkTransformFilter output with " << numThreads << " threads" << endl;
+      status = 1;
+    }
+
+    vtkNew<vtkTransformPolyDataFilter> polyDataFilter;
+    polyDataFilter->SetInputData(plane);
+    polyDataFilter->SetTransform(transform);
+    polyDataFilter->Update();
+    if (!recorder.Check(polyDataFilter->GetOutput(), numThreads) ||
+      !expected.Check(polyDataFilter->GetOutput(), false))
+    {
+      cerr << "Wrong vtkTransformPolyDataFilter output with " << numThreads << " threads" << endl;
+      status = 1;
+    }
+
+    // The transformed tuples are appended to the output arrays.
+    vtkNew<vtkPoints> points;
+    points->InsertNextPoint(1.0, 2.0, 3.0);
+    transform->TransformPoints(plane->GetPoints(), points);
+    vtkNew<vtkFloatArray> normals;
+    normals->SetNumberOfComponents(3);
+    normals->InsertNextTuple3(4.0, 5.0, 6.0);
+    transform->TransformNormals(pd->GetNormals(), normals);
+    if (points->GetNumberOfPoints() != numPts + 1 || points->GetPoint(0)[2] != 3.0 ||
+      points->GetPoint(numPts)[0] != expected.Points->GetComponent(numPts - 1, 0) ||
+      normals->GetNumberOfTuples() != numPts + 1 || normals->GetComponent(0, 2) != 6.0 ||
+      normals->GetComponent(numPts, 1) != expected.Normals->GetComponent(numPts - 1, 1))
+    {
+      cerr << "Wrong appended tuples with " << numThreads << " threads" << endl;
+      status = 1;
+    }
+
+    vtkNew<vtkWarpVector> warpVector;
+    warpVector->SetInputData(plane);
+    warpVector->SetScaleFactor(0.25);
+    warpVector->Update();
+    if (!recorder.Check(warpVector->GetPolyDataOutput(), numThreads))
+    {
+      status = 1;
+    }
+    vtkPoints* warped = warpVector->GetPolyDataOutput()->GetPoints();
+    for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+    {
+      double x[3];
+      plane->GetPoint(ptId, x);
+      if (warped->GetNumberOfPoints() != numPts ||
+        warped->GetPoint(ptId)[1] != static_cast<float>(x[1] + 0.25 * -x[0]))
+      {
+        cerr << "Wrong vtkWarpVector point " << ptId << " with " << numThreads << " threads"
+             << endl;
+        status = 1;
+        break;
+      }
+    }
+
+    // The points are warped along the point normals, then along the z axis.
+    vtkNew<vtkWarpScalar> warpScalar;
+    warpScalar->SetInputData(plane);
+    warpScalar->SetScaleFactor(0.5);
+    for (int xyPlane = 0; xyPlane < 2; ++xyPlane)
+    {
+      warpScalar->SetXYPlane(xyPlane);
+      warpScalar->SetUseNormal(xyPlane);
+      warpScalar->Update();
+      if (!recorder.Check(warpScalar->GetPolyDataOutput(), numThreads))
+      {
+        status = 1;
+      }
+      warped = warpScalar->GetPolyDataOutput()->GetPoints();
+      for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+      {
+        double x[3], n[3] = { 0.0, 0.0, 1.0 };
+        plane->GetPoint(ptId, x);
+        if (!xyPlane)
+        {
+          pd->GetNormals()->GetTuple(ptId, n);
+        }
+        const double s = xyPlane ? x[2] : pd->GetScalars()->GetComponent(ptId, 0);
+        if (warped->GetNumberOfPoints() != numPts ||
+          warped->GetPoint(ptId)[0] != static_cast<float>(x[0] + 0.5 * s * n[0]) ||
+          warped->GetPoint(ptId)[2] != static_cast<float>(x[2] + 0.5 * s * n[2]))
+        {
+          cerr << "Wrong vtkWarpScalar point " << ptId << " with " << numThreads
+               << " threads and x-y plane " << xyPlane << endl;
+          status = 1;
+          break;
+        }
+      }
+    }
+    return status;
+  });
+}
@@ -21,6 +21,8 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include <algorithm>
 #include <cassert>
@@ -45,6 +47,8 @@ enum
   NEG_Z
 };
 #define CELLTREE_MAX_DEPTH 32
+// Nodes with fewer cells are split sequentially
+const vtkIdType CELLTREE_PARALLEL_SIZE = 10000;
 }
 
 // -------------------------------------------------------------------------
@@ -232,6 +236,21 @@ private:
         Max = _max;
       }
     }
+
+    void Merge(const Bucket& other)
+    {
+      Cnt += other.Cnt;
+      Min = std::min(Min, other.Min);
+      Max = std::max(Max, other.Max);
+    }
+  };
+
+  static const int NBUCKETS = 6;
+
+  // The buckets of the three dimensions used to evaluate the split planes
+  struct Buckets
+  {
+    Bucket B[3][NBUCKETS];
   };
 
   struct PerCell
@@ -270,6 +289,22 @@ private:
 
   // -------------------------------------------------------------------------
 
+  static void FindMinMaxSequential(
+    const PerCell* begin, const PerCell* end, float* min, float* max)
+  {
+    while (begin != end)
+    {
+      for (unsigned int d = 0; d < 3; ++d)
+      {
+        if (begin->Min[d] < min[d])
+          min[d] = begin->Min[d];
+        if (begin->Max[d] > max[d])
+          max[d] = begin->Max[d];
+      }
+      ++begin;
+    }
+  }
+
   void FindMinMax(const PerCell* begin, const PerCell* end, float* min, float* max)
   {
     if (begin == end)
@@ -283,14 +318,59 @@ private:
       max[d] = begin->Max[d];
     }
 
-    while (++begin != end)
+    if (end - begin < CELLTREE_PARALLEL_SIZE)
+    {
+      FindMinMaxSequential(begin + 1, end, min, max);
+      return;
+    }
+
+    // The extrema do not depend on the order of the reduction.
+    struct Extent
+    {
+      float Min[3];
+      float Max[3];
+    };
+    Extent initial;
+    std::copy(min, min + 3, initial.Min);
+    std::copy(max, max + 3, initial.Max);
+    vtkSMPThreadLocal<Extent> localExtents(initial);
+    vtkSMPTools::For(0, end - begin, [&](vtkIdType first, vtkIdType last) {
+      Extent& extent = localExtents.Local();
+      FindMinMaxSequential(begin + first, begin + last, extent.Min, extent.Max);
+    });
+    for (const Extent& extent : localExtents)
     {
       for (unsigned int d = 0; d < 3; ++d)
       {
-        if (begin->Min[d] < min[d])
-          min[d] = begin->Min[d];
-        if (begin->Max[d] > max[d])
-          max[d] = begin->Max[d];
+        min[d] = std::min(min[d], extent.Min[d]);
+        max[d] = std::max(max[d], extent.Max[d]);
+      }
+    }
+  }
+
+  // -------------------------------------------------------------------------
+
+  static void FillBuckets(const PerCell* begin, const PerCell* end, const float min[3],
+    const float iext[3], Buckets& buckets)
+  {
+    for (const PerCell* pc = begin; pc != end; ++pc)
+    {
+      for (unsigned int d = 0; d < 3; ++d)
+      {
+        float cen = (pc->Min[d] + pc->Max[d]) / 2.0f;
+        int ind = (int)((cen - min[d]) * iext[d]);
+
+        if (ind < 0)
+        {
+          ind = 0;
+        }
+
+        if (ind >= NBUCKETS)
+        {
+          ind = NBUCKETS - 1;
+        }
+
+        buckets.B[d][ind].Add(pc->Min[d], pc->Max[d]);
       }
     }
   }
@@ -311,31 +391,33 @@ private:
     PerCell* end = &(this->m_pc[0]) + start + size;
     PerCell* mid = begin;
 
-    const int nbuckets = 6;
+    const int nbuckets = NBUCKETS;
 
     const float ext[3] = { max[0] - min[0], max[1] - min[1], max[2] - min[2] };
     const float iext[3] = { nbuckets / ext[0], nbuckets / ext[1], nbuckets / ext[2] };
 
-    Bucket b[3][nbuckets];
-
-    for (const PerCell* pc = begin; pc != end; ++pc)
+    // The cells of large nodes are binned in parallel, the buckets of each
+    // thread being merged afterwards.
+    Buckets buckets;
+    if (size < CELLTREE_PARALLEL_SIZE)
     {
-      for (unsigned int d = 0; d < 3; ++d)
+      FillBuckets(begin, end, min, iext, buckets);
+    }
+    else
+    {
+      vtkSMPThreadLocal<Buckets> localBuckets;
+      vtkSMPTools::For(0, size, [&](vtkIdType first, vtkIdType last) {
+        FillBuckets(begin + first, begin + last, min, iext, localBuckets.Local());
+      });
+      for (const Buckets& local : localBuckets)
       {
-        float cen = (pc->Min[d] + pc->Max[d]) / 2.0f;
-        int ind = (int)((cen - min[d]) * iext[d]);
-
-        if (ind < 0)
-        {
-          ind = 0;
-        }
-
-        if (ind >= nbuckets)
+        for (unsigned int d = 0; d < 3; ++d)
         {
-          ind = nbuckets - 1;
+          for (int n = 0; n < nbuckets; ++n)
+          {
+            buckets.B[d][n].Merge(local.B[d][n]);
+          }
         }
-
-        b[d][ind].Add(pc->Min[d], pc->Max[d]);
       }
     }
 
@@ -354,17 +436,17 @@ private:
 
         for (unsigned int m = 0; m <= n; ++m)
         {
-          if (b[d][m].Max > lmax)
+          if (buckets.B[d][m].Max > lmax)
           {
-            lmax = b[d][m].Max;
+            lmax = buckets.B[d][m].Max;
           }
         }
 
         for (unsigned int m = n + 1; m < (unsigned int)nbuckets; ++m)
         {
-          if (b[d][m].Min < rmin)
+          if (buckets.B[d][m].Min < rmin)
           {
-            rmin = b[d][m].Min;
+            rmin = buckets.B[d][m].Min;
           }
         }
 
@@ -374,7 +456,7 @@ private:
         //
         if (lmax != -std::numeric_limits<float>::max() && rmin != std::numeric_limits<float>::max())
         {
-          sum += b[d][n].Cnt;
+          sum += buckets.B[d][n].Cnt;
 
           float lvol = (lmax - min[d]) / ext[d];
           float rvol = (max[d] - rmin) / ext[d];
@@ -433,7 +515,6 @@ public:
   void Build(vtkCellTreeLocator* ctl, vtkCellTreeLocator::vtkCellTree& ct, vtkDataSet* ds)
   {
     const vtkIdType size = ds->GetNumberOfCells();
-    double cellBounds[6];
     this->m_pc.resize(size);
 
     float min[3] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
@@ -445,36 +526,38 @@ public:
       -std::numeric_limits<float>::max(),
     };
 
-    for (vtkIdType i = 0; i < size; ++i)
+    // The first call performs the non-thread safe initialization of the
+    // dataset, if any, before the bounds of the cells are gathered in parallel.
+    double cellBounds[6];
+    if (!ctl->CellBounds && size > 0)
     {
-      this->m_pc[i].Ind = i;
-
-      double* boundsPtr = cellBounds;
-      if (ctl->CellBounds)
-      {
-        boundsPtr = ctl->CellBounds[i];
-      }
-      else
-      {
-        ds->GetCellBounds(i, boundsPtr);
-      }
-
-      for (int d = 0; d < 3; ++d)
+      ds->GetCellBounds(0, cellBounds);
+    }
+    vtkSMPTools::For(0, size, [&](vtkIdType first, vtkIdType last) {
+      double localBounds[6];
+      for (vtkIdType i = first; i < last; ++i)
       {
-        this->m_pc[i].Min[d] = boundsPtr[2 * d + 0];
-        this->m_pc[i].Max[d] = boundsPtr[2 * d + 1];
+        this->m_pc[i].Ind = i;
 
-        if (this->m_pc[i].Min[d] < min[d])
+        double* boundsPtr = localBounds;
+        if (ctl->CellBounds)
+        {
+          boundsPtr = ctl->CellBounds[i];
+        }
+        else
         {
-          min[d] = this->m_pc[i].Min[d];
+          ds->GetCellBounds(i, boundsPtr);
         }
 
-        if (this->m_pc[i].Max[d] > max[d]) /// This can be m_pc[i].max[d] instead of min
+        for (int d = 0; d < 3; ++d)
         {
-          max[d] = this->m_pc[i].Max[d];
+          this->m_pc[i].Min[d] = boundsPtr[2 * d + 0];
+          this->m_pc[i].Max[d] = boundsPtr[2 * d + 1];
         }
       }
-    }
+    });
+
+    FindMinMax(this->m_pc.data(), this->m_pc.data() + size, min, max);
 
     ct.DataBBox[0] = min[0];
     ct.DataBBox[1] = max[0];
@@ -684,18 +767,15 @@ double _getMinDistNEG_Z(const double origin[3], const double dir[3], const doubl
 typedef std::pair<double, int> Intersection;
 
 int vtkCellTreeLocator::IntersectWithLine(const double p1[3], const double p2[3], double tol,
-  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell)
+  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId)
 {
-  int hit = this->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId);
-  if (hit)
-  {
-    this->DataSet->GetCell(cellId, cell);
-  }
-  return hit;
+  return this->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId, this->GenericCell);
 }
 
+// The tree is only read and the supplied cell is the only scratch cell used,
+// so that this method is thread safe once the tree is built.
 int vtkCellTreeLocator::IntersectWithLine(const double p1[3], const double p2[3], double tol,
-  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellIds)
+  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellIds, vtkGenericCell* cell)
 {
   //
   vtkCellTreeNode *node, *near, *far;
@@ -822,7 +902,7 @@ int vtkCellTreeLocator::IntersectWithLine(const double p1[3], const double p2[3]
       ctmax = _tmax;
       if (this->RayMinMaxT(boundsPtr, p1, ray_vec, ctmin, ctmax))
       {
-        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId))
+        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId, cell))
         {
           if (t_hit < closest_intersection)
           {
@@ -841,6 +921,8 @@ int vtkCellTreeLocator::IntersectWithLine(const double p1[3], const double p2[3]
   if (HIT)
   {
     t = closest_intersection;
+    // The cell may have been overwritten by later candidates
+    this->DataSet->GetCell(cellIds, cell);
   }
   //
   return HIT;
@@ -1219,10 +1301,11 @@ void vtkCellTreeLocator::Classify(const double origin[3], const double dir[3], d
 }
 //----------------------------------------------------------------------------
 int vtkCellTreeLocator::IntersectCellInternal(vtkIdType cell_ID, const double p1[3],
-  const double p2[3], const double tol, double& t, double ipt[3], double pcoords[3], int& subId)
+  const double p2[3], const double tol, double& t, double ipt[3], double pcoords[3], int& subId,
+  vtkGenericCell* cell)
 {
-  this->DataSet->GetCell(cell_ID, this->GenericCell);
-  return this->GenericCell->IntersectWithLine(
+  this->DataSet->GetCell(cell_ID, cell);
+  return cell->IntersectWithLine(
     const_cast<double*>(p1), const_cast<double*>(p2), tol, t, ipt, pcoords, subId);
 }
 //----------------------------------------------------------------------------
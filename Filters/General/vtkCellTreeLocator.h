@@ -28,7 +28,10 @@
  * Some methods in building and traversing the cell tree in this class were derived
  * avtCellLocatorBIH class in the VisIT Visualization Tool
  *
- *
+ * The bounds of the cells are gathered, and the cells of the large nodes are
+ * binned, in parallel with vtkSMPTools when the tree is built. Once built,
+ * FindCell() and IntersectWithLine() may be called concurrently as long as
+ * each thread supplies its own vtkGenericCell.
  *
  * @sa
  * vtkLocator vtkCellLocator vtkModifiedBSPTree
@@ -63,7 +66,7 @@ public:
 
   /**
    * Test a point to find if it is inside a cell. Returns the cellId if inside
-   * or -1 if not.
+   * or -1 if not. This method is thread safe once the locator is built.
    */
   vtkIdType FindCell(double pos[3], double vtkNotUsed, vtkGenericCell* cell, double pcoords[3],
     double* weights) override;
@@ -71,6 +74,7 @@ public:
   /**
    * Return intersection point (if any) AND the cell which was intersected by
    * the finite line. The cell is returned as a cell id and as a generic cell.
+   * This method is thread safe once the locator is built.
    */
   int IntersectWithLine(const double a0[3], const double a1[3], double tol, double& t, double x[3],
     double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell) override;
@@ -215,7 +219,8 @@ protected:
   // (Example : Particles stored in tree, have no dimension, so we must
   // override the cell test to return a value based on some particle size
   virtual int IntersectCellInternal(vtkIdType cell_ID, const double p1[3], const double p2[3],
-    const double tol, double& t, double ipt[3], double pcoords[3], int& subId);
+    const double tol, double& t, double ipt[3], double pcoords[3], int& subId,
+    vtkGenericCell* cell);
 
   int NumberOfBuckets;
 
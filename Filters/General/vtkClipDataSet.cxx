@@ -32,6 +32,8 @@
 #include "vtkPlane.h"
 #include "vtkPointData.h"
 #include "vtkPolyhedron.h"
+#include "vtkSMPFiltersInternal.h" // For CanEvaluateInParallel
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
@@ -40,6 +42,7 @@
 #include <cmath>
 
 vtkStandardNewMacro(vtkClipDataSet);
+
 vtkCxxSetObjectMacro(vtkClipDataSet, ClipFunction, vtkImplicitFunction);
 
 //----------------------------------------------------------------------------
@@ -305,10 +308,29 @@ int vtkClipDataSet::RequestData(vtkInformation* vtkNotUsed(request),
     {
       inPD->SetScalars(tmpScalars);
     }
-    for (i = 0; i < numPts; i++)
+    if (CanEvaluateInParallel(this->ClipFunction))
+    {
+      // GetPoint() is only thread safe once it has been called from a single
+      // thread.
+      double x[3];
+      input->GetPoint(0, x);
+      vtkImplicitFunction* clipFunction = this->ClipFunction;
+      vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+        double pt[3];
+        for (; ptId < endPtId; ++ptId)
+        {
+          input->GetPoint(ptId, pt);
+          tmpScalars->SetValue(ptId, static_cast<float>(clipFunction->FunctionValue(pt)));
+        }
+      });
+    }
+    else
     {
-      s = this->ClipFunction->FunctionValue(input->GetPoint(i));
-      tmpScalars->SetTuple1(i, s);
+      for (i = 0; i < numPts; i++)
+      {
+        s = this->ClipFunction->FunctionValue(input->GetPoint(i));
+        tmpScalars->SetTuple1(i, s);
+      }
     }
     clipScalars = tmpScalars;
   }
@@ -47,6 +47,11 @@
  * second output is the part of the cell that is clipped away. Set the
  * GenerateClippedData boolean on if you wish to access this output data.
  *
+ * Clip functions that are planes or spheres are evaluated in parallel with
+ * vtkSMPTools. The cells are clipped sequentially, since the points are
+ * merged with the locator; vtkTableBasedClipDataSet clips unstructured grids
+ * in parallel.
+ *
  * @warning
  * vtkClipDataSet will triangulate all types of 3D cells (i.e., create
  * tetrahedra). This is true even if the cell is not actually cut. This
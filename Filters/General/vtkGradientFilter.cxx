@@ -20,11 +20,16 @@
 
 #include "vtkGradientFilter.h"
 
+#include "vtkArrayDispatch.h"
 #include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCellDataToPointData.h"
+#include "vtkCellTypes.h"
 #include "vtkDataArray.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
+#include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
@@ -35,11 +40,16 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticCellLinks.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUnstructuredGrid.h"
+#include "vtkWeakPointer.h"
 
+#include <algorithm>
 #include <limits>
 #include <vector>
 
@@ -47,6 +57,28 @@
 
 vtkStandardNewMacro(vtkGradientFilter);
 
+//-----------------------------------------------------------------------------
+class vtkGradientFilterInternals
+{
+public:
+  // The stencil of each point is the range [Offsets[i], Offsets[i + 1]) of
+  // PointIds, with 3 Weights per entry, for the x, y and z derivatives. A
+  // point with an empty stencil has no gradient computed.
+  std::vector<vtkIdType> Offsets;
+  std::vector<vtkIdType> PointIds;
+  std::vector<double> Weights;
+
+  // What the stencils were built for: the dataset, the objects holding its
+  // points and cells and their latest modification time. The weak pointers
+  // tell apart new objects allocated where deleted ones were.
+  vtkWeakPointer<vtkDataSet> DataSet;
+  std::vector<vtkWeakPointer<vtkObject>> TopologyObjects;
+  vtkMTimeType TopologyMTime = 0;
+  vtkIdType NumberOfPoints = -1;
+  vtkIdType NumberOfCells = -1;
+  int ContributingCellOption = -1;
+};
+
 namespace
 {
 // special template macro for only float and double types since we will never
@@ -84,10 +116,15 @@ void ComputeQCriterionFromGradient(data_type* gradients, data_type* qCriterion)
 }
 
 // Functions for unstructured grids and polydatas
+std::vector<vtkObject*> GetTopologyObjects(vtkDataSet* structure);
+
+void BuildPointGradientStencils(
+  vtkDataSet* structure, int contributingCellOption, vtkGradientFilterInternals* stencils);
+
 template <class data_type>
-void ComputePointGradientsUG(vtkDataSet* structure, vtkDataArray* array, data_type* gradients,
-  int numberOfInputComponents, data_type* vorticity, data_type* qCriterion, data_type* divergence,
-  int highestCellDimension, int contributingCellOption);
+void ComputePointGradientsUG(const vtkGradientFilterInternals* stencils, vtkDataArray* array,
+  data_type* gradients, int numberOfInputComponents, data_type* vorticity, data_type* qCriterion,
+  data_type* divergence);
 
 int GetCellParametricData(
   vtkIdType pointId, double pointCoord[3], vtkCell* cell, int& subId, double parametricCoord[3]);
@@ -178,6 +215,7 @@ vtkGradientFilter::vtkGradientFilter()
   this->ComputeQCriterion = 0;
   this->ContributingCellOption = vtkGradientFilter::All;
   this->ReplacementValueOption = vtkGradientFilter::Zero;
+  this->Internals = new vtkGradientFilterInternals;
   this->SetInputScalars(
     vtkDataObject::FIELD_ASSOCIATION_POINTS_THEN_CELLS, vtkDataSetAttributes::SCALARS);
 }
@@ -189,6 +227,7 @@ vtkGradientFilter::~vtkGradientFilter()
   this->SetDivergenceArrayName(nullptr);
   this->SetVorticityArrayName(nullptr);
   this->SetQCriterionArrayName(nullptr);
+  delete this->Internals;
 }
 
 //-----------------------------------------------------------------------------
@@ -449,37 +488,47 @@ int vtkGradientFilter::ComputeUnstructuredGridGradient(vtkDataArray* array, int
     }
   }
 
-  int highestCellDimension = 0;
-  if (this->ContributingCellOption == vtkGradientFilter::DataSetMax)
+  if (fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_POINTS)
   {
-    int maxDimension = input->IsA("vtkPolyData") == 1 ? 2 : 3;
-    for (vtkIdType i = 0; i < input->GetNumberOfCells(); i++)
+    if (!this->FasterApproximation)
     {
-      int dim = input->GetCell(i)->GetCellDimension();
-      if (dim > highestCellDimension)
+      // Reuse the stencils while the dataset and its topology are the same.
+      vtkGradientFilterInternals* stencils = this->Internals;
+      const std::vector<vtkObject*> topologyObjects = GetTopologyObjects(input);
+      vtkMTimeType topologyMTime = 0;
+      bool sameObjects = stencils->DataSet.GetPointer() == input &&
+        stencils->TopologyObjects.size() == topologyObjects.size();
+      for (size_t i = 0; i < topologyObjects.size(); ++i)
       {
-        highestCellDimension = dim;
-        if (highestCellDimension == maxDimension)
+        if (topologyObjects[i])
         {
-          break;
+          topologyMTime = std::max(topologyMTime, topologyObjects[i]->GetMTime());
         }
+        sameObjects =
+          sameObjects && stencils->TopologyObjects[i].GetPointer() == topologyObjects[i];
+      }
+      if (!sameObjects || stencils->TopologyMTime != topologyMTime ||
+        stencils->NumberOfPoints != input->GetNumberOfPoints() ||
+        stencils->NumberOfCells != input->GetNumberOfCells() ||
+        stencils->ContributingCellOption != this->ContributingCellOption)
+      {
+        BuildPointGradientStencils(input, this->ContributingCellOption, stencils);
+        stencils->DataSet = input;
+        stencils->TopologyObjects.assign(topologyObjects.begin(), topologyObjects.end());
+        stencils->TopologyMTime = topologyMTime;
+        stencils->NumberOfPoints = input->GetNumberOfPoints();
+        stencils->NumberOfCells = input->GetNumberOfCells();
+        stencils->ContributingCellOption = this->ContributingCellOption;
       }
-    }
-  }
 
-  if (fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_POINTS)
-  {
-    if (!this->FasterApproximation)
-    {
       switch (arrayType)
       { // ok to use template macro here since we made the output arrays ourselves
-        vtkFloatingPointTemplateMacro(ComputePointGradientsUG(input, array,
+        vtkFloatingPointTemplateMacro(ComputePointGradientsUG(stencils, array,
           (gradients == nullptr ? nullptr : static_cast<VTK_TT*>(gradients->GetVoidPointer(0))),
           numberOfInputComponents,
           (vorticity == nullptr ? nullptr : static_cast<VTK_TT*>(vorticity->GetVoidPointer(0))),
           (qCriterion == nullptr ? nullptr : static_cast<VTK_TT*>(qCriterion->GetVoidPointer(0))),
-          (divergence == nullptr ? nullptr : static_cast<VTK_TT*>(divergence->GetVoidPointer(0))),
-          highestCellDimension, this->ContributingCellOption));
+          (divergence == nullptr ? nullptr : static_cast<VTK_TT*>(divergence->GetVoidPointer(0)))));
       }
       if (gradients)
       {
@@ -806,118 +855,283 @@ int vtkGradientFilter::GetOutputArrayType(vtkDataArray* array)
 namespace
 {
 //-----------------------------------------------------------------------------
-template <class data_type>
-void ComputePointGradientsUG(vtkDataSet* structure, vtkDataArray* array, data_type* gradients,
-  int numberOfInputComponents, data_type* vorticity, data_type* qCriterion, data_type* divergence,
-  int highestCellDimension, int contributingCellOption)
+// The objects holding the points and cells of the dataset, null when missing.
+std::vector<vtkObject*> GetTopologyObjects(vtkDataSet* structure)
 {
-  vtkNew<vtkIdList> currentPoint;
-  currentPoint->SetNumberOfIds(1);
-  vtkNew<vtkIdList> cellsOnPoint;
-
-  vtkIdType numpts = structure->GetNumberOfPoints();
+  std::vector<vtkObject*> objects;
+  auto update = [&objects](vtkObject* object) { objects.push_back(object); };
+  auto updateCells = [&update](vtkCellArray* cells) {
+    update(cells);
+    update(cells ? cells->GetOffsetsArray() : nullptr);
+    update(cells ? cells->GetConnectivityArray() : nullptr);
+  };
+  if (vtkPointSet* pointSet = vtkPointSet::SafeDownCast(structure))
+  {
+    update(pointSet->GetPoints());
+  }
+  if (vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(structure))
+  {
+    updateCells(grid->GetCells());
+    update(grid->GetCellTypesArray());
+    update(grid->GetFaces());
+    update(grid->GetFaceLocations());
+  }
+  else if (vtkPolyData* polyData = vtkPolyData::SafeDownCast(structure))
+  {
+    updateCells(polyData->GetVerts());
+    updateCells(polyData->GetLines());
+    updateCells(polyData->GetPolys());
+    updateCells(polyData->GetStrips());
+  }
+  return objects;
+}
 
-  int numberOfOutputComponents = 3 * numberOfInputComponents;
-  std::vector<data_type> g(numberOfOutputComponents);
+//-----------------------------------------------------------------------------
+void BuildPointGradientStencils(
+  vtkDataSet* structure, int contributingCellOption, vtkGradientFilterInternals* stencils)
+{
+  const vtkIdType numpts = structure->GetNumberOfPoints();
+  stencils->Offsets.assign(numpts + 1, 0);
+  stencils->PointIds.clear();
+  stencils->Weights.clear();
+  if (numpts == 0)
+  {
+    return;
+  }
 
-  // if we are doing patches for contributing cell dimensions we want to keep track of
-  // the maximum expected dimension so we can exit out of the check loop quicker
-  const int maxCellDimension = structure->IsA("vtkPolyData") ? 2 : 3;
+  // The cells using each point, from the static links of the grid if it has
+  // some.
+  vtkSmartPointer<vtkStaticCellLinks> links;
+  if (vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(structure))
+  {
+    links = vtkStaticCellLinks::SafeDownCast(grid->GetCellLinks());
+  }
+  if (!links)
+  {
+    links = vtkSmartPointer<vtkStaticCellLinks>::New();
+    links->BuildLinks(structure);
+  }
 
-  for (vtkIdType point = 0; point < numpts; point++)
+  // The dimension of each cell type of the dataset.
+  unsigned char cellDimensions[VTK_NUMBER_OF_CELL_TYPES] = {};
+  int highestCellDimension = 0;
+  vtkNew<vtkCellTypes> cellTypes;
+  structure->GetCellTypes(cellTypes);
+  vtkNew<vtkGenericCell> typeCell;
+  for (vtkIdType i = 0; i < cellTypes->GetNumberOfTypes(); ++i)
   {
-    currentPoint->SetId(0, point);
-    double pointcoords[3];
-    structure->GetPoint(point, pointcoords);
-    // Get all cells touching this point.
-    structure->GetCellNeighbors(-1, currentPoint, cellsOnPoint);
-    vtkIdType numCellNeighbors = cellsOnPoint->GetNumberOfIds();
-
-    for (int i = 0; i < numberOfOutputComponents; i++)
-    {
-      g[i] = 0;
-    }
+    const unsigned char type = cellTypes->GetCellType(i);
+    typeCell->SetCellType(type);
+    cellDimensions[type] = static_cast<unsigned char>(typeCell->GetCellDimension());
+    highestCellDimension = std::max(highestCellDimension, typeCell->GetCellDimension());
+  }
+  if (contributingCellOption != vtkGradientFilter::DataSetMax)
+  {
+    highestCellDimension = 0;
+  }
 
-    if (contributingCellOption == vtkGradientFilter::Patch)
+  // Make sure the points and the cells can be accessed concurrently.
+  double x[3];
+  structure->GetPoint(0, x);
+  structure->GetCell(0, typeCell);
+  structure->GetCellType(0);
+
+  // The stencils of chunks of points are built separately, then
+  // concatenated.
+  const vtkIdType chunkSize = 1024;
+  const vtkIdType numChunks = (numpts + chunkSize - 1) / chunkSize;
+  std::vector<std::vector<vtkIdType>> chunkPointIds(numChunks);
+  std::vector<std::vector<double>> chunkWeights(numChunks);
+  vtkIdType* offsets = stencils->Offsets.data();
+
+  vtkSMPThreadLocalObject<vtkGenericCell> threadCell;
+  vtkSMPTools::For(0, numChunks, [&](vtkIdType beginChunk, vtkIdType endChunk) {
+    vtkGenericCell* cell = threadCell.Local();
+    std::vector<vtkIdType> cellsOnPoint;
+    std::vector<double> values;
+    for (vtkIdType chunk = beginChunk; chunk < endChunk; ++chunk)
     {
-      highestCellDimension = 0;
-      for (vtkIdType neighbor = 0; neighbor < numCellNeighbors; neighbor++)
+      std::vector<vtkIdType>& pointIds = chunkPointIds[chunk];
+      std::vector<double>& weights = chunkWeights[chunk];
+      const vtkIdType endPoint = std::min(numpts, (chunk + 1) * chunkSize);
+      for (vtkIdType point = chunk * chunkSize; point < endPoint; ++point)
       {
-        int cellDimension = structure->GetCell(cellsOnPoint->GetId(neighbor))->GetCellDimension();
-        if (cellDimension > highestCellDimension)
+        double pointcoords[3];
+        structure->GetPoint(point, pointcoords);
+        // Get all cells touching this point, in a deterministic order.
+        const vtkIdType* cells = links->GetCells(point);
+        cellsOnPoint.assign(cells, cells + links->GetNcells(point));
+        std::sort(cellsOnPoint.begin(), cellsOnPoint.end());
+        cellsOnPoint.erase(
+          std::unique(cellsOnPoint.begin(), cellsOnPoint.end()), cellsOnPoint.end());
+
+        int minCellDimension = highestCellDimension;
+        if (contributingCellOption == vtkGradientFilter::Patch)
         {
-          highestCellDimension = cellDimension;
-          if (highestCellDimension == maxCellDimension)
+          for (vtkIdType cellId : cellsOnPoint)
           {
-            break;
+            const int cellDimension = cellDimensions[structure->GetCellType(cellId)];
+            minCellDimension = std::max(minCellDimension, cellDimension);
           }
         }
-      }
-    }
-    vtkIdType numValidCellNeighbors = 0;
 
-    // Iterate on all cells and find all points connected to current point
-    // by an edge.
-    for (vtkIdType neighbor = 0; neighbor < numCellNeighbors; neighbor++)
-    {
-      vtkCell* cell = structure->GetCell(cellsOnPoint->GetId(neighbor));
-      if (cell->GetCellDimension() >= highestCellDimension)
-      {
-        int subId;
-        double parametricCoord[3];
-        if (GetCellParametricData(point, pointcoords, cell, subId, parametricCoord))
+        const size_t begin = pointIds.size();
+        vtkIdType numValidCellNeighbors = 0;
+        for (vtkIdType cellId : cellsOnPoint)
         {
+          if (cellDimensions[structure->GetCellType(cellId)] < minCellDimension)
+          {
+            continue;
+          }
+          structure->GetCell(cellId, cell);
+          int subId;
+          double parametricCoord[3];
+          if (!GetCellParametricData(point, pointcoords, cell, subId, parametricCoord))
+          {
+            continue;
+          }
           numValidCellNeighbors++;
-          for (int inputComponent = 0; inputComponent < numberOfInputComponents; inputComponent++)
+
+          // The derivative being linear in the values at the cell points,
+          // the weight of each point is the derivative of its basis function.
+          const int numberOfCellPoints = cell->GetNumberOfPoints();
+          values.assign(numberOfCellPoints, 0.0);
+          for (int i = 0; i < numberOfCellPoints; i++)
           {
-            int numberOfCellPoints = cell->GetNumberOfPoints();
-            std::vector<double> values(numberOfCellPoints);
-            // Get values of Array at cell points.
-            for (int i = 0; i < numberOfCellPoints; i++)
+            double derivative[3];
+            values[i] = 1.0;
+            cell->Derivatives(subId, parametricCoord, values.data(), 1, derivative);
+            values[i] = 0.0;
+
+            const vtkIdType pointId = cell->GetPointId(i);
+            size_t entry = begin;
+            while (entry < pointIds.size() && pointIds[entry] != pointId)
             {
-              values[i] = array->GetComponent(cell->GetPointId(i), inputComponent);
+              ++entry;
             }
-
-            double derivative[3];
-            // Get derivative of cell at point.
-            cell->Derivatives(subId, parametricCoord, &values[0], 1, derivative);
-
-            g[inputComponent * 3] += static_cast<data_type>(derivative[0]);
-            g[inputComponent * 3 + 1] += static_cast<data_type>(derivative[1]);
-            g[inputComponent * 3 + 2] += static_cast<data_type>(derivative[2]);
-          } // iterating over Components
-        }   // if(GetCellParametricData())
-      }     // if(cell->GetCellDimension () >= highestCellDimension
-    }       // iterating over neighbors
-
-    if (numValidCellNeighbors > 0)
-    {
-      for (int i = 0; i < 3 * numberOfInputComponents; i++)
-      {
-        g[i] /= numValidCellNeighbors;
+            if (entry == pointIds.size())
+            {
+              pointIds.push_back(pointId);
+              weights.insert(weights.end(), 3, 0.0);
+            }
+            weights[3 * entry] += derivative[0];
+            weights[3 * entry + 1] += derivative[1];
+            weights[3 * entry + 2] += derivative[2];
+          }
+        }
+        for (size_t i = 3 * begin; i < weights.size(); ++i)
+        {
+          weights[i] /= numValidCellNeighbors;
+        }
+        offsets[point] = static_cast<vtkIdType>(pointIds.size() - begin);
       }
+    }
+  });
+
+  const vtkIdType zero = 0;
+  vtkSMPTools::ExclusiveScan(offsets, offsets + numpts + 1, offsets, zero);
+  stencils->PointIds.resize(offsets[numpts]);
+  stencils->Weights.resize(3 * offsets[numpts]);
+  vtkSMPTools::For(0, numChunks, [&](vtkIdType beginChunk, vtkIdType endChunk) {
+    for (vtkIdType chunk = beginChunk; chunk < endChunk; ++chunk)
+    {
+      const vtkIdType offset = offsets[chunk * chunkSize];
+      std::copy(chunkPointIds[chunk].begin(), chunkPointIds[chunk].end(),
+        stencils->PointIds.begin() + offset);
+      std::copy(chunkWeights[chunk].begin(), chunkWeights[chunk].end(),
+        stencils->Weights.begin() + 3 * offset);
+    }
+  });
+}
 
-      if (vorticity)
-      {
-        ComputeVorticityFromGradient(&g[0], vorticity + 3 * point);
-      }
-      if (qCriterion)
-      {
-        ComputeQCriterionFromGradient(&g[0], qCriterion + point);
-      }
-      if (divergence)
-      {
-        ComputeDivergenceFromGradient(&g[0], divergence + point);
-      }
-      if (gradients)
+//-----------------------------------------------------------------------------
+// Applies the stencils to the values of an array, with a typed fast path for
+// the arrays vtkArrayDispatch knows. The others are processed sequentially.
+struct ApplyPointGradientStencils
+{
+  template <typename ArrayT, typename data_type>
+  void operator()(ArrayT* array, const vtkGradientFilterInternals* stencils,
+    data_type* gradients, int numberOfInputComponents, data_type* vorticity,
+    data_type* qCriterion, data_type* divergence, bool threaded) const
+  {
+    const vtkIdType numpts = static_cast<vtkIdType>(stencils->Offsets.size()) - 1;
+    const vtkIdType* offsets = stencils->Offsets.data();
+    const vtkIdType* pointIds = stencils->PointIds.data();
+    const double* weights = stencils->Weights.data();
+    const int numberOfOutputComponents = 3 * numberOfInputComponents;
+
+    auto apply = [&](vtkIdType begin, vtkIdType end) {
+      const auto values = vtk::DataArrayTupleRange(array);
+      std::vector<double> sum(numberOfOutputComponents);
+      std::vector<data_type> g(numberOfOutputComponents);
+      for (vtkIdType point = begin; point < end; point++)
       {
+        if (offsets[point] == offsets[point + 1])
+        {
+          // No valid cell neighbors, keep the replacement value.
+          continue;
+        }
+        std::fill(sum.begin(), sum.end(), 0.0);
+        for (vtkIdType entry = offsets[point]; entry < offsets[point + 1]; entry++)
+        {
+          const auto tuple = values[pointIds[entry]];
+          const double* w = weights + 3 * entry;
+          for (int inputComponent = 0; inputComponent < numberOfInputComponents; inputComponent++)
+          {
+            const double value = static_cast<double>(tuple[inputComponent]);
+            sum[inputComponent * 3] += w[0] * value;
+            sum[inputComponent * 3 + 1] += w[1] * value;
+            sum[inputComponent * 3 + 2] += w[2] * value;
+          }
+        }
         for (int i = 0; i < numberOfOutputComponents; i++)
         {
-          gradients[point * numberOfOutputComponents + i] = g[i];
+          g[i] = static_cast<data_type>(sum[i]);
+        }
+
+        if (vorticity)
+        {
+          ComputeVorticityFromGradient(&g[0], vorticity + 3 * point);
+        }
+        if (qCriterion)
+        {
+          ComputeQCriterionFromGradient(&g[0], qCriterion + point);
+        }
+        if (divergence)
+        {
+          ComputeDivergenceFromGradient(&g[0], divergence + point);
+        }
+        if (gradients)
+        {
+          std::copy(g.begin(), g.end(), gradients + point * numberOfOutputComponents);
         }
       }
+    };
+
+    if (threaded)
+    {
+      vtkSMPTools::For(0, numpts, apply);
+    }
+    else
+    {
+      apply(0, numpts);
     }
-  } // iterating over points in grid
+  }
+};
+
+//-----------------------------------------------------------------------------
+template <class data_type>
+void ComputePointGradientsUG(const vtkGradientFilterInternals* stencils, vtkDataArray* array,
+  data_type* gradients, int numberOfInputComponents, data_type* vorticity, data_type* qCriterion,
+  data_type* divergence)
+{
+  ApplyPointGradientStencils worker;
+  if (!vtkArrayDispatch::Dispatch::Execute(array, worker, stencils, gradients,
+        numberOfInputComponents, vorticity, qCriterion, divergence, true))
+  {
+    worker(array, stencils, gradients, numberOfInputComponents, vorticity, qCriterion,
+      divergence, false);
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -957,52 +1171,70 @@ void ComputeCellGradientsUG(vtkDataSet* structure, vtkDataArray* array, data_typ
   int numberOfInputComponents, data_type* vorticity, data_type* qCriterion, data_type* divergence)
 {
   vtkIdType numcells = structure->GetNumberOfCells();
-  std::vector<double> values(8);
-  std::vector<data_type> cellGradients(3 * numberOfInputComponents);
-  for (vtkIdType cellid = 0; cellid < numcells; cellid++)
-  {
-    vtkCell* cell = structure->GetCell(cellid);
-    int subId;
-    double cellCenter[3];
-    subId = cell->GetParametricCenter(cellCenter);
 
-    int numpoints = cell->GetNumberOfPoints();
-    if (static_cast<size_t>(numpoints) > values.size())
-    {
-      values.resize(numpoints);
-    }
-    double derivative[3];
-    for (int inputComponent = 0; inputComponent < numberOfInputComponents; inputComponent++)
+  // Make sure the cells can be accessed concurrently.
+  vtkSMPThreadLocalObject<vtkGenericCell> threadCell;
+  structure->GetCell(0, threadCell.Local());
+
+  auto compute = [&](vtkIdType begin, vtkIdType end) {
+    vtkGenericCell* cell = threadCell.Local();
+    std::vector<double> values(8);
+    std::vector<data_type> cellGradients(3 * numberOfInputComponents);
+    for (vtkIdType cellid = begin; cellid < end; cellid++)
     {
-      for (int i = 0; i < numpoints; i++)
+      structure->GetCell(cellid, cell);
+      int subId;
+      double cellCenter[3];
+      subId = cell->GetParametricCenter(cellCenter);
+
+      int numpoints = cell->GetNumberOfPoints();
+      if (static_cast<size_t>(numpoints) > values.size())
       {
-        values[i] = array->GetComponent(cell->GetPointId(i), inputComponent);
+        values.resize(numpoints);
       }
+      double derivative[3];
+      for (int inputComponent = 0; inputComponent < numberOfInputComponents; inputComponent++)
+      {
+        for (int i = 0; i < numpoints; i++)
+        {
+          values[i] = array->GetComponent(cell->GetPointId(i), inputComponent);
+        }
 
-      cell->Derivatives(subId, cellCenter, &values[0], 1, derivative);
-      cellGradients[inputComponent * 3] = static_cast<data_type>(derivative[0]);
-      cellGradients[inputComponent * 3 + 1] = static_cast<data_type>(derivative[1]);
-      cellGradients[inputComponent * 3 + 2] = static_cast<data_type>(derivative[2]);
-    }
-    if (gradients)
-    {
-      for (int i = 0; i < 3 * numberOfInputComponents; i++)
+        cell->Derivatives(subId, cellCenter, &values[0], 1, derivative);
+        cellGradients[inputComponent * 3] = static_cast<data_type>(derivative[0]);
+        cellGradients[inputComponent * 3 + 1] = static_cast<data_type>(derivative[1]);
+        cellGradients[inputComponent * 3 + 2] = static_cast<data_type>(derivative[2]);
+      }
+      if (gradients)
       {
-        gradients[cellid * 3 * numberOfInputComponents + i] = cellGradients[i];
+        for (int i = 0; i < 3 * numberOfInputComponents; i++)
+        {
+          gradients[cellid * 3 * numberOfInputComponents + i] = cellGradients[i];
+        }
+      }
+      if (vorticity)
+      {
+        ComputeVorticityFromGradient(&cellGradients[0], vorticity + 3 * cellid);
+      }
+      if (qCriterion)
+      {
+        ComputeQCriterionFromGradient(&cellGradients[0], qCriterion + cellid);
+      }
+      if (divergence)
+      {
+        ComputeDivergenceFromGradient(&cellGradients[0], divergence + cellid);
       }
     }
-    if (vorticity)
-    {
-      ComputeVorticityFromGradient(&cellGradients[0], vorticity + 3 * cellid);
-    }
-    if (qCriterion)
-    {
-      ComputeQCriterionFromGradient(&cellGradients[0], qCriterion + cellid);
-    }
-    if (divergence)
-    {
-      ComputeDivergenceFromGradient(&cellGradients[0], divergence + cellid);
-    }
+  };
+
+  // Arrays that may not support concurrent reads are processed sequentially.
+  if (array->HasStandardMemoryLayout())
+  {
+    vtkSMPTools::For(0, numcells, compute);
+  }
+  else
+  {
+    compute(0, numcells);
   }
 }
 
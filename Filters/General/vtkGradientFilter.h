@@ -39,6 +39,15 @@
  * the entire data set. For Patch or DataSetMax it is possible that some values
  * will not be computed. The ReplacementValueOption specifies what to use
  * for these values.
+ *
+ * For unstructured grids and polydata, the point gradients are computed in
+ * parallel with vtkSMPTools from a stencil per point: the weights giving the
+ * gradient as a linear combination of the values at the neighboring points.
+ * The stencils are built from the cell derivatives once and kept until the
+ * points or the cells of the input, or the ContributingCellOption, change, so
+ * that the gradients of other arrays or time steps on the same mesh are only
+ * sparse matrix-vector products. Cell gradients are also computed in
+ * parallel.
  */
 
 #ifndef vtkGradientFilter_h
@@ -47,6 +56,8 @@
 #include "vtkDataSetAlgorithm.h"
 #include "vtkFiltersGeneralModule.h" // For export macro
 
+class vtkGradientFilterInternals;
+
 class VTKFILTERSGENERAL_EXPORT vtkGradientFilter : public vtkDataSetAlgorithm
 {
 public:
@@ -313,6 +324,12 @@ protected:
    */
   int ReplacementValueOption;
 
+  /**
+   * The stencils computing the point gradients of unstructured grids and
+   * polydata, with the topology they were built for.
+   */
+  vtkGradientFilterInternals* Internals;
+
 private:
   vtkGradientFilter(const vtkGradientFilter&) = delete;
   void operator=(const vtkGradientFilter&) = delete;
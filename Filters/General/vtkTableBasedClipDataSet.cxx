@@ -45,18 +45,32 @@
 #include "vtkPlane.h"
 
 #include "vtkAppendFilter.h"
+#include "vtkArrayListTemplate.h" // For processing attribute data
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPFiltersInternal.h" // For CanEvaluateInParallel
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticEdgeLocatorTemplate.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
 #include "vtkTableBasedClipCases.cxx"
 
 vtkStandardNewMacro(vtkTableBasedClipDataSet);
@@ -1542,6 +1556,505 @@ inline void GetPoint(
 // =============== vtkTableBasedClipperVolumeFromVolume ( end ) ===============
 // ============================================================================
 
+namespace
+{
+//-----------------------------------------------------------------------------
+// The shapes output by the clip tables, in the order in which
+// vtkTableBasedClipperVolumeFromVolume lists them in its output.
+const int NumberOfClipShapes = 8;
+const int ClipShapeSizes[NumberOfClipShapes] = { 4, 5, 6, 8, 4, 3, 2, 1 };
+const unsigned char ClipShapeTypes[NumberOfClipShapes] = { VTK_TETRA, VTK_PYRAMID, VTK_WEDGE,
+  VTK_HEXAHEDRON, VTK_QUAD, VTK_TRIANGLE, VTK_LINE, VTK_VERTEX };
+
+int GetClipShapeIndex(unsigned char shape)
+{
+  switch (shape)
+  {
+    case ST_TET:
+      return 0;
+    case ST_PYR:
+      return 1;
+    case ST_WDG:
+      return 2;
+    case ST_HEX:
+      return 3;
+    case ST_QUA:
+      return 4;
+    case ST_TRI:
+      return 5;
+    case ST_LIN:
+      return 6;
+    default:
+      return 7;
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Runs the clip tables on a cell and passes the shapes to keep to a sink,
+// with the ids of their points as returned by the sink for the points it
+// creates on the edges and at the centroids. Returns false if the tables do
+// not handle the type of the cell.
+template <typename TSink>
+bool ClipCell(int cellType, vtkIdType numbPnts, const vtkIdType* pntIndxs,
+  vtkDataArray* clipAray, double isoValue, bool insideOut, TSink& sink)
+{
+  int startIdx = 0;
+  int nOutputs = 0;
+  typedef const int EDGEIDXS[2];
+  EDGEIDXS* edgeVtxs = nullptr;
+  unsigned char* thisCase = nullptr;
+  int caseIndx = 0;
+  double grdDiffs[8];
+
+  switch (cellType)
+  {
+    case VTK_TETRA:
+    case VTK_PYRAMID:
+    case VTK_WEDGE:
+    case VTK_HEXAHEDRON:
+    case VTK_VOXEL:
+    case VTK_TRIANGLE:
+    case VTK_QUAD:
+    case VTK_PIXEL:
+    case VTK_LINE:
+    case VTK_VERTEX:
+      for (vtkIdType j = numbPnts - 1; j >= 0; j--)
+      {
+        grdDiffs[j] = clipAray->GetComponent(pntIndxs[j], 0) - isoValue;
+        caseIndx += ((grdDiffs[j] >= 0.0) ? 1 : 0);
+        caseIndx <<= (1 - (!j));
+      }
+      break;
+
+    default:
+      return false;
+  }
+
+  // start index, split case, number of output, and vertices from edges
+  switch (cellType)
+  {
+    case VTK_TETRA:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesTet[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesTet[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesTet[caseIndx];
+      edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::TetVerticesFromEdges;
+      break;
+
+    case VTK_PYRAMID:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesPyr[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesPyr[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesPyr[caseIndx];
+      edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::PyramidVerticesFromEdges;
+      break;
+
+    case VTK_WEDGE:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesWdg[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesWdg[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesWdg[caseIndx];
+      edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::WedgeVerticesFromEdges;
+      break;
+
+    case VTK_HEXAHEDRON:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesHex[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesHex[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesHex[caseIndx];
+      edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::HexVerticesFromEdges;
+      break;
+
+    case VTK_VOXEL:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesVox[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesVox[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesVox[caseIndx];
+      edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::VoxVerticesFromEdges;
+      break;
+
+    case VTK_TRIANGLE:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesTri[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesTri[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesTri[caseIndx];
+      edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::TriVerticesFromEdges;
+      break;
+
+    case VTK_QUAD:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesQua[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesQua[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesQua[caseIndx];
+      edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::QuadVerticesFromEdges;
+      break;
+
+    case VTK_PIXEL:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesPix[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesPix[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesPix[caseIndx];
+      edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::PixelVerticesFromEdges;
+      break;
+
+    case VTK_LINE:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesLin[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesLin[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesLin[caseIndx];
+      edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::LineVerticesFromEdges;
+      break;
+
+    case VTK_VERTEX:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesVtx[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesVtx[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesVtx[caseIndx];
+      edgeVtxs = nullptr;
+      break;
+  }
+
+  vtkIdType intrpIds[4];
+  for (int j = 0; j < nOutputs; j++)
+  {
+    int nCellPts = 0;
+    int theColor = -1;
+    int intrpIdx = -1;
+    unsigned char theShape = *thisCase++;
+
+    // number of points and color
+    switch (theShape)
+    {
+      case ST_HEX:
+        nCellPts = 8;
+        theColor = *thisCase++;
+        break;
+
+      case ST_WDG:
+        nCellPts = 6;
+        theColor = *thisCase++;
+        break;
+
+      case ST_PYR:
+        nCellPts = 5;
+        theColor = *thisCase++;
+        break;
+
+      case ST_TET:
+        nCellPts = 4;
+        theColor = *thisCase++;
+        break;
+
+      case ST_QUA:
+        nCellPts = 4;
+        theColor = *thisCase++;
+        break;
+
+      case ST_TRI:
+        nCellPts = 3;
+        theColor = *thisCase++;
+        break;
+
+      case ST_LIN:
+        nCellPts = 2;
+        theColor = *thisCase++;
+        break;
+
+      case ST_VTX:
+        nCellPts = 1;
+        theColor = *thisCase++;
+        break;
+
+      case ST_PNT:
+        intrpIdx = *thisCase++;
+        theColor = *thisCase++;
+        nCellPts = *thisCase++;
+        break;
+
+      default:
+        vtkGenericWarningMacro(<< "An invalid output shape was found "
+                               << "in the ClipCases." << endl);
+    }
+
+    if ((!insideOut && theColor == COLOR0) || (insideOut && theColor == COLOR1))
+    {
+      // We don't want this one; it's the wrong side.
+      thisCase += nCellPts;
+      continue;
+    }
+
+    vtkIdType shapeIds[8];
+    for (int p = 0; p < nCellPts; p++)
+    {
+      unsigned char pntIndex = *thisCase++;
+
+      if (pntIndex <= P7)
+      {
+        // We know pt P0 must be >P0 since we already
+        // assume P0 == 0.  This is why we do not
+        // bother subtracting P0 from pt here.
+        shapeIds[p] = pntIndxs[pntIndex];
+      }
+      else if (pntIndex >= EA && pntIndex <= EL)
+      {
+        int pt1Index = edgeVtxs[pntIndex - EA][0];
+        int pt2Index = edgeVtxs[pntIndex - EA][1];
+        if (pt2Index < pt1Index)
+        {
+          int temp = pt2Index;
+          pt2Index = pt1Index;
+          pt1Index = temp;
+        }
+        double pt1ToPt2 = grdDiffs[pt2Index] - grdDiffs[pt1Index];
+        double pt1ToIso = 0.0 - grdDiffs[pt1Index];
+        double p1Weight = 1.0 - pt1ToIso / pt1ToPt2;
+
+        vtkIdType pntIndx1 = pntIndxs[pt1Index];
+        vtkIdType pntIndx2 = pntIndxs[pt2Index];
+
+        shapeIds[p] = sink.AddPoint(pntIndx1, pntIndx2, p1Weight);
+      }
+      else if (pntIndex >= N0 && pntIndex <= N3)
+      {
+        shapeIds[p] = intrpIds[pntIndex - N0];
+      }
+      else
+      {
+        vtkGenericWarningMacro(<< "An invalid output point value was found "
+                               << "in the ClipCases." << endl);
+      }
+    }
+
+    if (theShape == ST_PNT)
+    {
+      intrpIds[intrpIdx] = sink.AddCentroidPoint(nCellPts, shapeIds);
+    }
+    else
+    {
+      sink.AddShape(theShape, shapeIds);
+    }
+  }
+
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+// Sink of ClipCell() gathering the output in a
+// vtkTableBasedClipperVolumeFromVolume.
+struct VolumeFromVolumeSink
+{
+  vtkTableBasedClipperVolumeFromVolume* VFV;
+  vtkIdType CellId;
+
+  vtkIdType AddPoint(vtkIdType p1, vtkIdType p2, double percent)
+  {
+    return this->VFV->AddPoint(p1, p2, percent);
+  }
+
+  vtkIdType AddCentroidPoint(int n, vtkIdType* p) { return this->VFV->AddCentroidPoint(n, p); }
+
+  void AddShape(unsigned char shape, const vtkIdType* ids)
+  {
+    vtkIdType z = this->CellId;
+    switch (shape)
+    {
+      case ST_HEX:
+        this->VFV->AddHex(z, ids[0], ids[1], ids[2], ids[3], ids[4], ids[5], ids[6], ids[7]);
+        break;
+
+      case ST_WDG:
+        this->VFV->AddWedge(z, ids[0], ids[1], ids[2], ids[3], ids[4], ids[5]);
+        break;
+
+      case ST_PYR:
+        this->VFV->AddPyramid(z, ids[0], ids[1], ids[2], ids[3], ids[4]);
+        break;
+
+      case ST_TET:
+        this->VFV->AddTet(z, ids[0], ids[1], ids[2], ids[3]);
+        break;
+
+      case ST_QUA:
+        this->VFV->AddQuad(z, ids[0], ids[1], ids[2], ids[3]);
+        break;
+
+      case ST_TRI:
+        this->VFV->AddTri(z, ids[0], ids[1], ids[2]);
+        break;
+
+      case ST_LIN:
+        this->VFV->AddLine(z, ids[0], ids[1]);
+        break;
+
+      case ST_VTX:
+        this->VFV->AddVertex(z, ids[0]);
+        break;
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Sink of ClipCell() counting the output of a chunk of cells.
+struct CountSink
+{
+  vtkIdType NumberOfShapes[NumberOfClipShapes] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+  vtkIdType NumberOfEdgeUses = 0;
+  vtkIdType NumberOfCentroids = 0;
+
+  vtkIdType AddPoint(vtkIdType, vtkIdType, double) { return this->NumberOfEdgeUses++; }
+
+  vtkIdType AddCentroidPoint(int, vtkIdType*) { return -1 - this->NumberOfCentroids++; }
+
+  void AddShape(unsigned char shape, const vtkIdType*)
+  {
+    this->NumberOfShapes[GetClipShapeIndex(shape)]++;
+  }
+};
+
+// A point at the average of other points, as
+// vtkTableBasedClipperCentroidPointList stores it.
+struct ClipCentroid
+{
+  int NumberOfPoints;
+  vtkIdType PointIds[8];
+};
+
+typedef vtkStaticEdgeLocatorTemplate<vtkIdType, double> ClipEdgeLocator;
+typedef ClipEdgeLocator::MergeTupleType ClipEdge;
+
+//-----------------------------------------------------------------------------
+// Sink of ClipCell() writing the output of a chunk of cells at the offsets
+// counted by a CountSink. The ids of the points follow the convention of
+// vtkTableBasedClipperVolumeFromVolume: the input points keep their ids, the
+// edge points are numbered after them, by their use in the traversal of the
+// cells, and the centroid points are negative.
+struct WriteSink
+{
+  vtkIdType NumberOfPoints;
+  vtkIdType* Conn[NumberOfClipShapes];
+  vtkIdType* CellIds[NumberOfClipShapes];
+  ClipEdge* EdgeUses;
+  vtkIdType NextEdgeUse;
+  ClipCentroid* Centroids;
+  vtkIdType NextCentroid;
+  vtkIdType CellId;
+
+  vtkIdType AddPoint(vtkIdType p1, vtkIdType p2, double percent)
+  {
+    if (p2 < p1)
+    {
+      std::swap(p1, p2);
+      percent = 1.0 - percent;
+    }
+    this->EdgeUses[this->NextEdgeUse] = ClipEdge(p1, p2, this->NextEdgeUse, percent);
+    return this->NumberOfPoints + this->NextEdgeUse++;
+  }
+
+  vtkIdType AddCentroidPoint(int n, vtkIdType* p)
+  {
+    ClipCentroid& centroid = this->Centroids[this->NextCentroid];
+    centroid.NumberOfPoints = n;
+    std::copy(p, p + n, centroid.PointIds);
+    return -1 - this->NextCentroid++;
+  }
+
+  void AddShape(unsigned char shape, const vtkIdType* ids)
+  {
+    const int index = GetClipShapeIndex(shape);
+    *this->CellIds[index]++ = this->CellId;
+    this->Conn[index] = std::copy(ids, ids + ClipShapeSizes[index], this->Conn[index]);
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Interpolation of the point data of the new points as
+// vtkDataSetAttributes::InterpolateEdge() and
+// vtkDataSetAttributes::InterpolatePoint() do it, rounding integral values,
+// but safe to call concurrently for distinct output points.
+struct BasePointInterpolator
+{
+  virtual ~BasePointInterpolator() = default;
+  virtual void InterpolateEdge(vtkIdType v0, vtkIdType v1, double t, vtkIdType outId) = 0;
+  // Interpolates output points, which must have been computed already.
+  virtual void InterpolateOutput(
+    int numIds, const vtkIdType* ids, const double* weights, vtkIdType outId) = 0;
+};
+
+template <typename T>
+struct PointInterpolator : public BasePointInterpolator
+{
+  const T* Input;
+  T* Output;
+  int NumComp;
+
+  PointInterpolator(const T* input, T* output, int numComp)
+    : Input(input)
+    , Output(output)
+    , NumComp(numComp)
+  {
+  }
+
+  void InterpolateEdge(vtkIdType v0, vtkIdType v1, double t, vtkIdType outId) override
+  {
+    const double oneMinusT = 1. - t;
+    for (int c = 0; c < this->NumComp; ++c)
+    {
+      double val = this->Input[v0 * this->NumComp + c] * oneMinusT +
+        this->Input[v1 * this->NumComp + c] * t;
+      vtkMath::RoundDoubleToIntegralIfNecessary(val, this->Output + outId * this->NumComp + c);
+    }
+  }
+
+  void InterpolateOutput(
+    int numIds, const vtkIdType* ids, const double* weights, vtkIdType outId) override
+  {
+    for (int c = 0; c < this->NumComp; ++c)
+    {
+      double val = 0.;
+      for (int i = 0; i < numIds; ++i)
+      {
+        val += weights[i] * static_cast<double>(this->Output[ids[i] * this->NumComp + c]);
+      }
+      vtkMath::RoundDoubleToIntegralIfNecessary(val, this->Output + outId * this->NumComp + c);
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+// The interpolators of the point data arrays allocated by CopyAllocate().
+struct PointInterpolators
+{
+  std::vector<std::unique_ptr<BasePointInterpolator>> Arrays;
+
+  PointInterpolators(vtkPointData* inPD, vtkPointData* outPD)
+  {
+    for (int i = 0; i < outPD->GetNumberOfArrays(); ++i)
+    {
+      vtkDataArray* outArray = outPD->GetArray(i);
+      vtkDataArray* inArray = outArray ? inPD->GetArray(outArray->GetName()) : nullptr;
+      if (!inArray || inArray->GetDataType() != outArray->GetDataType())
+      {
+        continue;
+      }
+      void* input = inArray->GetVoidPointer(0);
+      void* output = outArray->GetVoidPointer(0);
+      switch (outArray->GetDataType())
+      {
+        vtkTemplateMacro(this->Arrays.emplace_back(new PointInterpolator<VTK_TT>(
+          static_cast<VTK_TT*>(input), static_cast<VTK_TT*>(output),
+          outArray->GetNumberOfComponents())));
+      }
+    }
+  }
+
+  void InterpolateEdge(vtkIdType v0, vtkIdType v1, double t, vtkIdType outId)
+  {
+    for (auto& array : this->Arrays)
+    {
+      array->InterpolateEdge(v0, v1, t, outId);
+    }
+  }
+
+  void InterpolateOutput(int numIds, const vtkIdType* ids, const double* weights, vtkIdType outId)
+  {
+    for (auto& array : this->Arrays)
+    {
+      array->InterpolateOutput(numIds, ids, weights, outId);
+    }
+  }
+};
+}
+
 //-----------------------------------------------------------------------------
 // Construct with user-specified implicit function; InsideOut turned off; value
 // set to 0.0; and generate clip scalars turned off.
@@ -1747,10 +2260,29 @@ int vtkTableBasedClipDataSet::RequestData(vtkInformation* vtkNotUsed(request),
       cpyInput->GetPointData()->SetScalars(pScalars);
     }
 
-    for (i = 0; i < numbPnts; i++)
+    if (CanEvaluateInParallel(this->ClipFunction))
+    {
+      // GetPoint() is only thread safe once it has been called from a single
+      // thread.
+      double x[3];
+      cpyInput->GetPoint(0, x);
+      vtkImplicitFunction* clipFunction = this->ClipFunction;
+      vtkSMPTools::For(0, numbPnts, [&](vtkIdType ptId, vtkIdType endPtId) {
+        double pt[3];
+        for (; ptId < endPtId; ++ptId)
+        {
+          cpyInput->GetPoint(ptId, pt);
+          pScalars->SetValue(ptId, clipFunction->FunctionValue(pt));
+        }
+      });
+    }
+    else
     {
-      double s = this->ClipFunction->FunctionValue(cpyInput->GetPoint(i));
-      pScalars->SetTuple1(i, s);
+      for (i = 0; i < numbPnts; i++)
+      {
+        double s = this->ClipFunction->FunctionValue(cpyInput->GetPoint(i));
+        pScalars->SetTuple1(i, s);
+      }
     }
 
     clipAray = pScalars;
@@ -2900,9 +3432,14 @@ void vtkTableBasedClipDataSet::ClipStructuredGridData(
 void vtkTableBasedClipDataSet::ClipUnstructuredGridData(
   vtkDataSet* inputGrd, vtkDataArray* clipAray, double isoValue, vtkUnstructuredGrid* outputUG)
 {
+  if (this->ThreadedClipUnstructuredGridData(inputGrd, clipAray, isoValue, outputUG))
+  {
+    return;
+  }
+
   vtkUnstructuredGrid* unstruct = vtkUnstructuredGrid::SafeDownCast(inputGrd);
 
-  vtkIdType i, j;
+  vtkIdType i;
   vtkIdType numbPnts = 0;
   int numCants = 0; // number of cells not clipped by this filter
   vtkIdType numCells = unstruct->GetNumberOfCells();
@@ -2911,6 +3448,7 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData(
   vtkTableBasedClipperVolumeFromVolume* visItVFV =
     new vtkTableBasedClipperVolumeFromVolume(this->OutputPointsPrecision,
       unstruct->GetNumberOfPoints(), int(pow(double(numCells), double(0.6667f))) * 5 + 100);
+  VolumeFromVolumeSink sink = { visItVFV, 0 };
 
   // the stuffs that can not be clipped by this filter
   vtkUnstructuredGrid* specials = vtkUnstructuredGrid::New();
@@ -2924,281 +3462,17 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData(
     const vtkIdType* pntIndxs = nullptr;
     unstruct->GetCellPoints(i, numbPnts, pntIndxs);
 
-    bool bCanClip = false;
-    switch (cellType)
+    sink.CellId = i;
+    if (ClipCell(cellType, numbPnts, pntIndxs, clipAray, isoValue, this->InsideOut != 0, sink))
     {
-      case VTK_TETRA:
-      case VTK_PYRAMID:
-      case VTK_WEDGE:
-      case VTK_HEXAHEDRON:
-      case VTK_VOXEL:
-      case VTK_TRIANGLE:
-      case VTK_QUAD:
-      case VTK_PIXEL:
-      case VTK_LINE:
-      case VTK_VERTEX:
-        bCanClip = true;
-        break;
-
-      default:
-        bCanClip = false;
-        break;
+      continue;
     }
 
-    if (bCanClip)
+    if (cellType == VTK_POLYHEDRON)
     {
-      int caseIndx = 0;
-      double grdDiffs[8];
-
-      for (j = numbPnts - 1; j >= 0; j--)
+      if (numCants == 0)
       {
-        grdDiffs[j] = clipAray->GetComponent(pntIndxs[j], 0) - isoValue;
-        caseIndx += ((grdDiffs[j] >= 0.0) ? 1 : 0);
-        caseIndx <<= (1 - (!j));
-      }
-
-      int startIdx = 0;
-      int nOutputs = 0;
-      typedef const int EDGEIDXS[2];
-      EDGEIDXS* edgeVtxs = nullptr;
-      unsigned char* thisCase = nullptr;
-
-      // start index, split case, number of output, and vertices from edges
-      switch (cellType)
-      {
-        case VTK_TETRA:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesTet[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesTet[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesTet[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::TetVerticesFromEdges;
-          break;
-
-        case VTK_PYRAMID:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesPyr[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesPyr[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesPyr[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::PyramidVerticesFromEdges;
-          break;
-
-        case VTK_WEDGE:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesWdg[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesWdg[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesWdg[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::WedgeVerticesFromEdges;
-          break;
-
-        case VTK_HEXAHEDRON:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesHex[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesHex[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesHex[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::HexVerticesFromEdges;
-          break;
-
-        case VTK_VOXEL:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesVox[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesVox[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesVox[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::VoxVerticesFromEdges;
-          break;
-
-        case VTK_TRIANGLE:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesTri[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesTri[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesTri[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::TriVerticesFromEdges;
-          break;
-
-        case VTK_QUAD:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesQua[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesQua[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesQua[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::QuadVerticesFromEdges;
-          break;
-
-        case VTK_PIXEL:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesPix[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesPix[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesPix[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::PixelVerticesFromEdges;
-          break;
-
-        case VTK_LINE:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesLin[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesLin[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesLin[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::LineVerticesFromEdges;
-          break;
-
-        case VTK_VERTEX:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesVtx[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesVtx[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesVtx[caseIndx];
-          edgeVtxs = nullptr;
-          break;
-      }
-
-      int intrpIds[4];
-      for (j = 0; j < nOutputs; j++)
-      {
-        int nCellPts = 0;
-        int theColor = -1;
-        int intrpIdx = -1;
-        unsigned char theShape = *thisCase++;
-
-        // number of points and color
-        switch (theShape)
-        {
-          case ST_HEX:
-            nCellPts = 8;
-            theColor = *thisCase++;
-            break;
-
-          case ST_WDG:
-            nCellPts = 6;
-            theColor = *thisCase++;
-            break;
-
-          case ST_PYR:
-            nCellPts = 5;
-            theColor = *thisCase++;
-            break;
-
-          case ST_TET:
-            nCellPts = 4;
-            theColor = *thisCase++;
-            break;
-
-          case ST_QUA:
-            nCellPts = 4;
-            theColor = *thisCase++;
-            break;
-
-          case ST_TRI:
-            nCellPts = 3;
-            theColor = *thisCase++;
-            break;
-
-          case ST_LIN:
-            nCellPts = 2;
-            theColor = *thisCase++;
-            break;
-
-          case ST_VTX:
-            nCellPts = 1;
-            theColor = *thisCase++;
-            break;
-
-          case ST_PNT:
-            intrpIdx = *thisCase++;
-            theColor = *thisCase++;
-            nCellPts = *thisCase++;
-            break;
-
-          default:
-            vtkErrorMacro(<< "An invalid output shape was found "
-                          << "in the ClipCases." << endl);
-        }
-
-        if ((!this->InsideOut && theColor == COLOR0) || (this->InsideOut && theColor == COLOR1))
-        {
-          // We don't want this one; it's the wrong side.
-          thisCase += nCellPts;
-          continue;
-        }
-
-        vtkIdType shapeIds[8];
-        for (int p = 0; p < nCellPts; p++)
-        {
-          unsigned char pntIndex = *thisCase++;
-
-          if (pntIndex <= P7)
-          {
-            // We know pt P0 must be >P0 since we already
-            // assume P0 == 0.  This is why we do not
-            // bother subtracting P0 from pt here.
-            shapeIds[p] = pntIndxs[pntIndex];
-          }
-          else if (pntIndex >= EA && pntIndex <= EL)
-          {
-            int pt1Index = edgeVtxs[pntIndex - EA][0];
-            int pt2Index = edgeVtxs[pntIndex - EA][1];
-            if (pt2Index < pt1Index)
-            {
-              int temp = pt2Index;
-              pt2Index = pt1Index;
-              pt1Index = temp;
-            }
-            double pt1ToPt2 = grdDiffs[pt2Index] - grdDiffs[pt1Index];
-            double pt1ToIso = 0.0 - grdDiffs[pt1Index];
-            double p1Weight = 1.0 - pt1ToIso / pt1ToPt2;
-
-            vtkIdType pntIndx1 = pntIndxs[pt1Index];
-            vtkIdType pntIndx2 = pntIndxs[pt2Index];
-
-            shapeIds[p] = visItVFV->AddPoint(pntIndx1, pntIndx2, p1Weight);
-          }
-          else if (pntIndex >= N0 && pntIndex <= N3)
-          {
-            shapeIds[p] = intrpIds[pntIndex - N0];
-          }
-          else
-          {
-            vtkErrorMacro(<< "An invalid output point value was found "
-                          << "in the ClipCases." << endl);
-          }
-        }
-
-        switch (theShape)
-        {
-          case ST_HEX:
-            visItVFV->AddHex(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3], shapeIds[4],
-              shapeIds[5], shapeIds[6], shapeIds[7]);
-            break;
-
-          case ST_WDG:
-            visItVFV->AddWedge(
-              i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3], shapeIds[4], shapeIds[5]);
-            break;
-
-          case ST_PYR:
-            visItVFV->AddPyramid(
-              i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3], shapeIds[4]);
-            break;
-
-          case ST_TET:
-            visItVFV->AddTet(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3]);
-            break;
-
-          case ST_QUA:
-            visItVFV->AddQuad(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3]);
-            break;
-
-          case ST_TRI:
-            visItVFV->AddTri(i, shapeIds[0], shapeIds[1], shapeIds[2]);
-            break;
-
-          case ST_LIN:
-            visItVFV->AddLine(i, shapeIds[0], shapeIds[1]);
-            break;
-
-          case ST_VTX:
-            visItVFV->AddVertex(i, shapeIds[0]);
-            break;
-
-          case ST_PNT:
-            intrpIds[intrpIdx] = visItVFV->AddCentroidPoint(nCellPts, shapeIds);
-            break;
-        }
-      }
-
-      edgeVtxs = nullptr;
-      thisCase = nullptr;
-    }
-    else if (cellType == VTK_POLYHEDRON)
-    {
-      if (numCants == 0)
-      {
-        specials->GetCellData()->CopyAllocate(unstruct->GetCellData(), numCells);
+        specials->GetCellData()->CopyAllocate(unstruct->GetCellData(), numCells);
       }
       vtkIdType nfaces;
       const vtkIdType* facePtIds;
@@ -3280,6 +3554,356 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData(
   unstruct = nullptr;
 }
 
+//-----------------------------------------------------------------------------
+bool vtkTableBasedClipDataSet::ThreadedClipUnstructuredGridData(
+  vtkDataSet* inputGrd, vtkDataArray* clipAray, double isoValue, vtkUnstructuredGrid* outputUG)
+{
+  vtkUnstructuredGrid* unstruct = vtkUnstructuredGrid::SafeDownCast(inputGrd);
+  vtkPointData* inPD = unstruct->GetPointData();
+  vtkCellData* inCD = unstruct->GetCellData();
+  vtkPoints* inputPts = unstruct->GetPoints();
+  if (!inputPts || clipAray->GetDataType() == VTK_BIT ||
+    inPD->GetArray("avtOriginalNodeNumbers") || !ArrayList::CanCopyInParallel(inPD) ||
+    !ArrayList::CanCopyInParallel(inCD))
+  {
+    return false;
+  }
+  vtkPointData* outPD = outputUG->GetPointData();
+  for (int attribute = 0; attribute < vtkDataSetAttributes::NUM_ATTRIBUTES; ++attribute)
+  {
+    // Nearest neighbor interpolation is left to the sequential implementation.
+    if (outPD->GetCopyAttribute(attribute, vtkDataSetAttributes::INTERPOLATE) == 2)
+    {
+      return false;
+    }
+  }
+
+  const vtkIdType numPts = unstruct->GetNumberOfPoints();
+  const vtkIdType numCells = unstruct->GetNumberOfCells();
+  const bool insideOut = this->InsideOut != 0;
+
+  // These methods are only thread safe once they have been called from a
+  // single thread.
+  if (numCells > 0)
+  {
+    vtkNew<vtkIdList> ids;
+    unstruct->GetCellPoints(0, ids);
+    unstruct->GetCellType(0);
+  }
+
+  // The cells are processed by chunks of fixed size, so that the output does
+  // not depend on the number of threads. Count the output of each chunk: its
+  // shapes of each type, the uses of edge points and the centroid points.
+  const vtkIdType chunkSize = 1024;
+  const vtkIdType numChunks = (numCells + chunkSize - 1) / chunkSize;
+  const int numCounts = NumberOfClipShapes + 2;
+  const int edgeCount = NumberOfClipShapes;
+  const int centroidCount = NumberOfClipShapes + 1;
+  std::vector<std::vector<vtkIdType>> offsets(numCounts, std::vector<vtkIdType>(numChunks + 1));
+  std::atomic<bool> allClipped(true);
+  vtkSMPThreadLocalObject<vtkIdList> tlCellPts;
+  vtkSMPTools::For(0, numChunks, [&](vtkIdType chunk, vtkIdType endChunk) {
+    vtkIdList* cellPts = tlCellPts.Local();
+    for (; chunk < endChunk && allClipped.load(std::memory_order_relaxed); ++chunk)
+    {
+      CountSink sink;
+      const vtkIdType endCellId = std::min((chunk + 1) * chunkSize, numCells);
+      for (vtkIdType cellId = chunk * chunkSize; cellId < endCellId; ++cellId)
+      {
+        unstruct->GetCellPoints(cellId, cellPts);
+        if (!ClipCell(unstruct->GetCellType(cellId), cellPts->GetNumberOfIds(),
+              cellPts->GetPointer(0), clipAray, isoValue, insideOut, sink))
+        {
+          allClipped = false;
+          return;
+        }
+      }
+      for (int shape = 0; shape < NumberOfClipShapes; ++shape)
+      {
+        offsets[shape][chunk] = sink.NumberOfShapes[shape];
+      }
+      offsets[edgeCount][chunk] = sink.NumberOfEdgeUses;
+      offsets[centroidCount][chunk] = sink.NumberOfCentroids;
+    }
+  });
+  if (!allClipped)
+  {
+    // The cells the tables do not handle are clipped by vtkClipDataSet.
+    return false;
+  }
+
+  const vtkIdType zero = 0;
+  std::vector<vtkIdType> totals(numCounts);
+  for (int count = 0; count < numCounts; ++count)
+  {
+    totals[count] = vtkSMPTools::ExclusiveScan(
+      offsets[count].begin(), offsets[count].end() - 1, offsets[count].begin(), zero);
+    offsets[count][numChunks] = totals[count];
+  }
+
+  // The output cells are grouped by shape, as vtkTableBasedClipperVolumeFromVolume
+  // builds them. Write the input cell of each output cell, and its points with
+  // the ids of WriteSink.
+  vtkIdType cellStarts[NumberOfClipShapes + 1];
+  vtkIdType connStarts[NumberOfClipShapes + 1];
+  cellStarts[0] = 0;
+  connStarts[0] = 0;
+  for (int shape = 0; shape < NumberOfClipShapes; ++shape)
+  {
+    cellStarts[shape + 1] = cellStarts[shape] + totals[shape];
+    connStarts[shape + 1] = connStarts[shape] + totals[shape] * ClipShapeSizes[shape];
+  }
+  const vtkIdType numOutCells = cellStarts[NumberOfClipShapes];
+  const vtkIdType connSize = connStarts[NumberOfClipShapes];
+  const vtkIdType numEdgeUses = totals[edgeCount];
+  const vtkIdType numCentroids = totals[centroidCount];
+  std::vector<vtkIdType> inCellIds(numOutCells);
+  std::vector<vtkIdType> uses(connSize);
+  std::vector<ClipEdge> edgeUses(numEdgeUses);
+  std::vector<ClipCentroid> centroids(numCentroids);
+  vtkSMPTools::For(0, numChunks, [&](vtkIdType chunk, vtkIdType endChunk) {
+    vtkIdList* cellPts = tlCellPts.Local();
+    for (; chunk < endChunk; ++chunk)
+    {
+      WriteSink sink;
+      sink.NumberOfPoints = numPts;
+      for (int shape = 0; shape < NumberOfClipShapes; ++shape)
+      {
+        sink.Conn[shape] =
+          uses.data() + connStarts[shape] + offsets[shape][chunk] * ClipShapeSizes[shape];
+        sink.CellIds[shape] = inCellIds.data() + cellStarts[shape] + offsets[shape][chunk];
+      }
+      sink.EdgeUses = edgeUses.data();
+      sink.NextEdgeUse = offsets[edgeCount][chunk];
+      sink.Centroids = centroids.data();
+      sink.NextCentroid = offsets[centroidCount][chunk];
+      const vtkIdType endCellId = std::min((chunk + 1) * chunkSize, numCells);
+      for (vtkIdType cellId = chunk * chunkSize; cellId < endCellId; ++cellId)
+      {
+        unstruct->GetCellPoints(cellId, cellPts);
+        sink.CellId = cellId;
+        ClipCell(unstruct->GetCellType(cellId), cellPts->GetNumberOfIds(), cellPts->GetPointer(0),
+          clipAray, isoValue, insideOut, sink);
+      }
+    }
+  });
+
+  // Number the input points used by the output cells by their first use.
+  std::vector<std::atomic<vtkIdType>> firstUses(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      firstUses[ptId].store(connSize, std::memory_order_relaxed);
+    }
+  });
+  vtkSMPTools::For(0, connSize, [&](vtkIdType pos, vtkIdType end) {
+    for (; pos < end; ++pos)
+    {
+      if (uses[pos] >= 0 && uses[pos] < numPts)
+      {
+        std::atomic<vtkIdType>& firstUse = firstUses[uses[pos]];
+        vtkIdType current = firstUse.load(std::memory_order_relaxed);
+        while (pos < current && !firstUse.compare_exchange_weak(current, pos))
+        {
+        }
+      }
+    }
+  });
+  std::vector<vtkIdType> newPtIds(connSize);
+  vtkSMPTools::For(0, connSize, [&](vtkIdType pos, vtkIdType end) {
+    for (; pos < end; ++pos)
+    {
+      newPtIds[pos] = uses[pos] >= 0 && uses[pos] < numPts &&
+          firstUses[uses[pos]].load(std::memory_order_relaxed) == pos
+        ? 1
+        : 0;
+    }
+  });
+  const vtkIdType numUsed =
+    vtkSMPTools::ExclusiveScan(newPtIds.begin(), newPtIds.end(), newPtIds.begin(), zero);
+  std::vector<vtkIdType> pointMap(numPts, -1);
+  std::vector<vtkIdType> origPtIds(numUsed);
+  vtkSMPTools::For(0, connSize, [&](vtkIdType pos, vtkIdType end) {
+    for (; pos < end; ++pos)
+    {
+      if (uses[pos] >= 0 && uses[pos] < numPts &&
+        firstUses[uses[pos]].load(std::memory_order_relaxed) == pos)
+      {
+        pointMap[uses[pos]] = newPtIds[pos];
+        origPtIds[newPtIds[pos]] = uses[pos];
+      }
+    }
+  });
+  std::vector<vtkIdType>().swap(newPtIds);
+  std::vector<std::atomic<vtkIdType>>().swap(firstUses);
+
+  // Merge the uses of the same edge. Its point is created by its first use,
+  // which also gives the interpolation weight, and the edge points are
+  // numbered by their creation.
+  vtkIdType numEdgePts = 0;
+  ClipEdgeLocator locator;
+  const vtkIdType* edgeOffsets = nullptr;
+  std::vector<vtkIdType> edgePtIds(numEdgeUses);
+  std::vector<vtkIdType> firstEdgeUses;
+  if (numEdgeUses > 0)
+  {
+    edgeOffsets = locator.MergeEdges(numEdgeUses, edgeUses.data(), numEdgePts);
+    firstEdgeUses.resize(numEdgePts);
+    vtkSMPTools::For(0, numEdgePts, [&](vtkIdType edge, vtkIdType endEdge) {
+      for (; edge < endEdge; ++edge)
+      {
+        vtkIdType first = edgeOffsets[edge];
+        for (vtkIdType use = first + 1; use < edgeOffsets[edge + 1]; ++use)
+        {
+          if (edgeUses[use].EId < edgeUses[first].EId)
+          {
+            first = use;
+          }
+        }
+        firstEdgeUses[edge] = first;
+        edgePtIds[edgeUses[first].EId] = 1;
+      }
+    });
+    vtkSMPTools::ExclusiveScan(edgePtIds.begin(), edgePtIds.end(), edgePtIds.begin(), numUsed);
+  }
+  const vtkIdType centroidStart = numUsed + numEdgePts;
+  const vtkIdType nOutPts = centroidStart + numCentroids;
+
+  // set precision for the points in the output
+  vtkNew<vtkPoints> outPts;
+  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+  {
+    outPts->SetDataType(inputPts->GetDataType());
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    outPts->SetDataType(VTK_FLOAT);
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    outPts->SetDataType(VTK_DOUBLE);
+  }
+  outPts->SetNumberOfPoints(nOutPts);
+  outPD->CopyAllocate(inPD, nOutPts);
+  ArrayList pointArrays;
+  pointArrays.AddArrays(nOutPts, inPD, outPD, 0.0, false);
+  PointInterpolators interpolators(inPD, outPD);
+
+  // Copy the used input points, then create the edge points.
+  vtkSMPTools::For(0, numUsed, [&](vtkIdType ptId, vtkIdType endPtId) {
+    double x[3];
+    for (; ptId < endPtId; ++ptId)
+    {
+      inputPts->GetPoint(origPtIds[ptId], x);
+      outPts->SetPoint(ptId, x);
+      pointArrays.Copy(origPtIds[ptId], ptId);
+    }
+  });
+  vtkSMPTools::For(0, numEdgePts, [&](vtkIdType edge, vtkIdType endEdge) {
+    double pt1[3], pt2[3], pt[3];
+    for (; edge < endEdge; ++edge)
+    {
+      const ClipEdge& first = edgeUses[firstEdgeUses[edge]];
+      const vtkIdType ptIdx = edgePtIds[first.EId];
+      inputPts->GetPoint(first.V0, pt1);
+      inputPts->GetPoint(first.V1, pt2);
+      double p = first.T;
+      double bp = 1.0 - p;
+      pt[0] = pt1[0] * p + pt2[0] * bp;
+      pt[1] = pt1[1] * p + pt2[1] * bp;
+      pt[2] = pt1[2] * p + pt2[2] * bp;
+      outPts->SetPoint(ptIdx, pt);
+      interpolators.InterpolateEdge(first.V0, first.V1, bp, ptIdx);
+      for (vtkIdType use = edgeOffsets[edge]; use < edgeOffsets[edge + 1]; ++use)
+      {
+        if (use != firstEdgeUses[edge])
+        {
+          edgePtIds[edgeUses[use].EId] = ptIdx;
+        }
+      }
+    }
+  });
+  std::vector<vtkIdType>().swap(firstEdgeUses);
+  std::vector<ClipEdge>().swap(edgeUses);
+
+  auto mapPoint = [&](vtkIdType id) -> vtkIdType {
+    if (id < 0)
+    {
+      return centroidStart - 1 - id;
+    }
+    return id >= numPts ? edgePtIds[id - numPts] : pointMap[id];
+  };
+
+  // The centroid points may use the centroid points created before them by
+  // the same cell, so those of a chunk are created in order.
+  vtkSMPTools::For(0, numChunks, [&](vtkIdType chunk, vtkIdType endChunk) {
+    vtkIdType ids[8];
+    double weights[8];
+    for (vtkIdType centroidId = offsets[centroidCount][chunk];
+         centroidId < offsets[centroidCount][endChunk]; ++centroidId)
+    {
+      const ClipCentroid& ce = centroids[centroidId];
+      double pts[8][3];
+      double pt[3] = { 0.0, 0.0, 0.0 };
+      double weight_factor = 1.0 / ce.NumberOfPoints;
+      for (int k = 0; k < ce.NumberOfPoints; k++)
+      {
+        weights[k] = 1.0 * weight_factor;
+        ids[k] = mapPoint(ce.PointIds[k]);
+        outPts->GetPoint(ids[k], pts[k]);
+        pt[0] += pts[k][0];
+        pt[1] += pts[k][1];
+        pt[2] += pts[k][2];
+      }
+      pt[0] *= weight_factor;
+      pt[1] *= weight_factor;
+      pt[2] *= weight_factor;
+
+      const vtkIdType ptIdx = centroidStart + centroidId;
+      outPts->SetPoint(ptIdx, pt);
+      interpolators.InterpolateOutput(ce.NumberOfPoints, ids, weights, ptIdx);
+    }
+  });
+  outputUG->SetPoints(outPts);
+
+  // Now set up the shapes and the cell data.
+  vtkNew<vtkIdTypeArray> cellOffsets;
+  cellOffsets->SetNumberOfValues(numOutCells + 1);
+  vtkNew<vtkIdTypeArray> conn;
+  conn->SetNumberOfValues(connSize);
+  vtkNew<vtkUnsignedCharArray> cellTypes;
+  cellTypes->SetNumberOfValues(numOutCells);
+  vtkCellData* outCD = outputUG->GetCellData();
+  outCD->CopyAllocate(inCD, numOutCells);
+  ArrayList cellArrays;
+  cellArrays.AddArrays(numOutCells, inCD, outCD, 0.0, false);
+  for (int shape = 0; shape < NumberOfClipShapes; ++shape)
+  {
+    const int shapeSize = ClipShapeSizes[shape];
+    vtkSMPTools::For(cellStarts[shape], cellStarts[shape + 1],
+      [&](vtkIdType outCellId, vtkIdType endOutCellId) {
+        for (; outCellId < endOutCellId; ++outCellId)
+        {
+          const vtkIdType start = connStarts[shape] + (outCellId - cellStarts[shape]) * shapeSize;
+          cellOffsets->SetValue(outCellId, start);
+          cellTypes->SetValue(outCellId, ClipShapeTypes[shape]);
+          for (vtkIdType pos = start; pos < start + shapeSize; ++pos)
+          {
+            conn->SetValue(pos, mapPoint(uses[pos]));
+          }
+          cellArrays.Copy(inCellIds[outCellId], outCellId);
+        }
+      });
+  }
+  cellOffsets->SetValue(numOutCells, connSize);
+
+  vtkNew<vtkCellArray> cells;
+  cells->SetData(cellOffsets, conn);
+  outputUG->SetCells(cellTypes, cells);
+
+  return true;
+}
+
 //-----------------------------------------------------------------------------
 void vtkTableBasedClipDataSet::PrintSelf(ostream& os, vtkIndent indent)
 {
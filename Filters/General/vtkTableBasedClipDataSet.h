@@ -68,6 +68,13 @@
  *  advantages are gained by adopting the unique clipping and triangulation tables
  *  proposed by VisIt.
  *
+ *  Unstructured grids are clipped in parallel with vtkSMPTools, with the
+ *  duplicate edge points merged by vtkStaticEdgeLocatorTemplate, and planes
+ *  and spheres are evaluated in parallel. The output is the same as the
+ *  sequential one, which remains in use for grids with cells that the tables
+ *  do not handle, or with attributes that cannot be processed concurrently
+ *  (such as bit arrays).
+ *
  * @warning
  *  vtkTableBasedClipDataSet makes use of a hash table (that is provided by class
  *  maintained by internal class vtkTableBasedClipperDataSetFromVolume) to achieve
@@ -283,6 +290,15 @@ protected:
   void ClipUnstructuredGridData(
     vtkDataSet* inputGrd, vtkDataArray* clipAray, double isoValue, vtkUnstructuredGrid* outputUG);
 
+  /**
+   * Threaded version of ClipUnstructuredGridData(), giving the same output. It
+   * returns false, leaving outputUG to the sequential version, when the grid
+   * has cells that the clip tables do not handle (such as polyhedra) or
+   * attributes that cannot be processed concurrently.
+   */
+  bool ThreadedClipUnstructuredGridData(
+    vtkDataSet* inputGrd, vtkDataArray* clipAray, double isoValue, vtkUnstructuredGrid* outputUG);
+
   /**
    * Register a callback function with the InternalProgressObserver.
    */
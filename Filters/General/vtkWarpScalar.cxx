@@ -14,9 +14,12 @@
 =========================================================================*/
 #include "vtkWarpScalar.h"
 
+#include "vtkArrayDispatch.h"
 #include "vtkCellData.h"
 #include "vtkDataArray.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkFloatArray.h"
 #include "vtkImageData.h"
 #include "vtkImageDataToPointSet.h"
 #include "vtkInformation.h"
@@ -27,10 +30,13 @@
 #include "vtkPoints.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearGridToPointSet.h"
+#include "vtkSMPTools.h"
 
 #include "vtkNew.h"
 #include "vtkSmartPointer.h"
 
+#include <atomic>
+
 vtkStandardNewMacro(vtkWarpScalar);
 
 //----------------------------------------------------------------------------
@@ -103,6 +109,59 @@ int vtkWarpScalar::RequestDataObject(
   }
 }
 
+//----------------------------------------------------------------------------
+namespace
+{
+// Warp the points in parallel, each along its data normal when given or else
+// along a single normal, by its first scalar component or, in the x-y plane
+// mode, its z coordinate. Progress is only reported from the calling thread.
+struct WarpScalarWorker
+{
+  template <typename PointArrayT, typename ScalarArrayT>
+  void operator()(PointArrayT* inPtArray, ScalarArrayT* scalarArray, vtkWarpScalar* self,
+    vtkDataArray* normals, const double* normal, vtkFloatArray* outPtArray) const
+  {
+    const vtkIdType numPts = inPtArray->GetNumberOfTuples();
+    const double scaleFactor = self->GetScaleFactor();
+    const bool xyPlane = self->GetXYPlane() != 0;
+
+    std::atomic<bool> aborted(false);
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      if (aborted)
+      {
+        return;
+      }
+      const auto inPts = vtk::DataArrayTupleRange<3>(inPtArray, begin, end);
+      const auto scalars = vtk::DataArrayTupleRange(scalarArray, begin, end);
+      auto outPts = vtk::DataArrayTupleRange<3>(outPtArray, begin, end);
+      double n[3] = { normal[0], normal[1], normal[2] };
+      for (vtkIdType i = 0; i < end - begin; ++i)
+      {
+        const auto x = inPts[i];
+        const double s = xyPlane ? static_cast<double>(x[2]) : static_cast<double>(scalars[i][0]);
+        if (normals)
+        {
+          // GetComponent(), unlike GetTuple(), may be called concurrently.
+          for (int c = 0; c < 3; ++c)
+          {
+            n[c] = normals->GetComponent(begin + i, c);
+          }
+        }
+        for (int c = 0; c < 3; ++c)
+        {
+          outPts[i][c] = static_cast<float>(x[c] + scaleFactor * s * n[c]);
+        }
+      }
+
+      if (self->GetAbortExecute())
+      {
+        aborted = true;
+      }
+    });
+  }
+};
+} // end anon namespace
+
 //----------------------------------------------------------------------------
 int vtkWarpScalar::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -147,9 +206,7 @@ int vtkWarpScalar::RequestData(vtkInformation* vtkNotUsed(request),
   vtkDataArray* inScalars;
   vtkPoints* newPts;
   vtkPointData* pd;
-  int i;
-  vtkIdType ptId, numPts;
-  double x[3], *n, s, newX[3];
+  vtkIdType numPts;
 
   vtkDebugMacro(<< "Warping data with scalars");
 
@@ -188,35 +245,28 @@ int vtkWarpScalar::RequestData(vtkInformation* vtkNotUsed(request),
   newPts = vtkPoints::New();
   newPts->SetNumberOfPoints(numPts);
 
-  // Loop over all points, adjusting locations
+  // Loop over all points, adjusting locations. The data normals are read by
+  // the worker, the other normals are the same for all points.
   //
-  for (ptId = 0; ptId < numPts; ptId++)
+  vtkDataArray* normals = nullptr;
+  const double* normal = this->Normal;
+  if (this->PointNormal == &vtkWarpScalar::DataNormal)
   {
-    if (!(ptId % 10000))
-    {
-      this->UpdateProgress((double)ptId / numPts);
-      if (this->GetAbortExecute())
-      {
-        break;
-      }
-    }
-
-    inPts->GetPoint(ptId, x);
-    n = (this->*(this->PointNormal))(ptId, inNormals);
-    if (this->XYPlane)
-    {
-      s = x[2];
-    }
-    else
-    {
-      s = inScalars->GetComponent(ptId, 0);
-    }
-    for (i = 0; i < 3; i++)
-    {
-      newX[i] = x[i] + this->ScaleFactor * s * n[i];
-    }
-    newPts->SetPoint(ptId, newX);
+    normals = inNormals;
+  }
+  else
+  {
+    normal = (this->*(this->PointNormal))(0, nullptr);
+  }
+  using Dispatcher =
+    vtkArrayDispatch::Dispatch2ByValueType<vtkArrayDispatch::Reals, vtkArrayDispatch::Reals>;
+  WarpScalarWorker worker;
+  vtkFloatArray* newPtArray = vtkArrayDownCast<vtkFloatArray>(newPts->GetData());
+  if (!Dispatcher::Execute(inPts->GetData(), inScalars, worker, this, normals, normal, newPtArray))
+  {
+    worker(inPts->GetData(), inScalars, this, normals, normal, newPtArray);
   }
+  this->UpdateProgress(1.0);
 
   // Update ourselves and release memory
   //
@@ -16,6 +16,7 @@
 
 #include "vtkArrayDispatch.h"
 #include "vtkCellData.h"
+#include "vtkDataArrayRange.h"
 #include "vtkImageData.h"
 #include "vtkImageDataToPointSet.h"
 #include "vtkInformation.h"
@@ -26,11 +27,13 @@
 #include "vtkPoints.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearGridToPointSet.h"
+#include "vtkSMPTools.h"
 #include "vtkStructuredGrid.h"
 
 #include "vtkNew.h"
 #include "vtkSmartPointer.h"
 
+#include <atomic>
 #include <cstdlib>
 
 vtkStandardNewMacro(vtkWarpVector);
@@ -100,32 +103,43 @@ struct WarpVectorDispatch2Points
   template <typename InPointArrayT, typename OutPointArrayT>
   void operator()(InPointArrayT* inPtArray, OutPointArrayT* outPtArray)
   {
-    typedef typename OutPointArrayT::ValueType PointValueT;
+    using PointValueT = vtk::GetAPIType<OutPointArrayT>;
     const vtkIdType numTuples = inPtArray->GetNumberOfTuples();
     const double scaleFactor = this->Self->GetScaleFactor();
+    VectorArrayT* vectors = this->Vectors;
 
-    assert(this->Vectors->GetNumberOfComponents() == 3);
+    assert(vectors->GetNumberOfComponents() == 3);
     assert(inPtArray->GetNumberOfComponents() == 3);
     assert(outPtArray->GetNumberOfComponents() == 3);
 
-    for (vtkIdType t = 0; t < numTuples; ++t)
-    {
-      if (!(t & 0xfff))
+    // The points are warped in parallel, each task checking for an abort
+    // once done. Progress is only reported from the calling thread.
+    std::atomic<bool> aborted(false);
+    vtkSMPTools::For(0, numTuples, [&](vtkIdType begin, vtkIdType end) {
+      if (aborted)
+      {
+        return;
+      }
+      const auto inPts = vtk::DataArrayTupleRange<3>(inPtArray, begin, end);
+      const auto vecs = vtk::DataArrayTupleRange<3>(vectors, begin, end);
+      auto outPts = vtk::DataArrayTupleRange<3>(outPtArray, begin, end);
+      auto vec = vecs.cbegin();
+      auto outPt = outPts.begin();
+      for (const auto inPt : inPts)
       {
-        this->Self->UpdateProgress(t / static_cast<double>(numTuples));
-        if (this->Self->GetAbortExecute())
+        for (int c = 0; c < 3; ++c)
         {
-          return;
+          (*outPt)[c] = static_cast<PointValueT>(inPt[c] + scaleFactor * (*vec)[c]);
         }
+        ++vec;
+        ++outPt;
       }
 
-      for (int c = 0; c < 3; ++c)
+      if (this->Self->GetAbortExecute())
       {
-        PointValueT val =
-          inPtArray->GetTypedComponent(t, c) + scaleFactor * this->Vectors->GetTypedComponent(t, c);
-        outPtArray->SetTypedComponent(t, c, val);
+        aborted = true;
       }
-    }
+    });
   }
 };
 
@@ -150,7 +164,8 @@ struct WarpVectorDispatch1Vector
     WarpVectorDispatch2Points<VectorArrayT> worker(this->Self, vectors);
     if (!vtkArrayDispatch::Dispatch2SameValueType::Execute(this->InPoints, this->OutPoints, worker))
     {
-      vtkGenericWarningMacro("Error dispatching point arrays.");
+      // Fall back to the vtkDataArray API for arrays not dispatched.
+      worker(this->InPoints, this->OutPoints);
     }
   }
 };
@@ -232,8 +247,10 @@ int vtkWarpVector::RequestData(vtkInformation* vtkNotUsed(request),
     this, input->GetPoints()->GetData(), output->GetPoints()->GetData());
   if (!vtkArrayDispatch::Dispatch::Execute(vectors, worker))
   {
-    vtkWarningMacro("Dispatch failed for vector array.");
+    // Fall back to the vtkDataArray API for arrays not dispatched.
+    worker(vectors);
   }
+  this->UpdateProgress(1.0);
 
   // now pass the data.
   output->GetPointData()->CopyNormalsOff(); // distorted geometry
@@ -0,0 +1,248 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataSetSurfaceFilterThreaded.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Checks that the threaded extraction of the surface of unstructured grids
+// by vtkDataSetSurfaceFilter gives the same output as the sequential one. A
+// bit array, which cannot be copied concurrently, forces the sequential path.
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkDataSetSurfaceFilter.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vector>
+
+namespace
+{
+const int Resolution = 12;
+
+vtkIdType LatticeId(int i, int j, int k)
+{
+  return i + (Resolution + 1) * (j + (Resolution + 1) * k);
+}
+
+void InsertCell(vtkUnstructuredGrid* grid, int type, std::vector<vtkIdType> ids)
+{
+  grid->InsertNextCell(type, static_cast<vtkIdType>(ids.size()), ids.data());
+}
+
+// A lattice of cubes made of hexahedra, voxels, tetrahedra, wedges,
+// polyhedra and duplicate hexahedra, capped with pyramids, next to
+// standalone prisms, 2D, 1D and 0D cells and, if asked for, quadratic cells.
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid(bool mixed, bool nonlinear)
+{
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k <= Resolution; ++k)
+  {
+    for (int j = 0; j <= Resolution; ++j)
+    {
+      for (int i = 0; i <= Resolution; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+  grid->SetPoints(points);
+  grid->Allocate(1000);
+
+  for (int k = 0; k < Resolution; ++k)
+  {
+    for (int j = 0; j < Resolution; ++j)
+    {
+      for (int i = 0; i < Resolution; ++i)
+      {
+        const vtkIdType v[8] = { LatticeId(i, j, k), LatticeId(i + 1, j, k),
+          LatticeId(i + 1, j + 1, k), LatticeId(i, j + 1, k), LatticeId(i, j, k + 1),
+          LatticeId(i + 1, j, k + 1), LatticeId(i + 1, j + 1, k + 1), LatticeId(i, j + 1, k + 1) };
+        const int pattern = mixed ? (i + 2 * j + 3 * k) % 6 : 0;
+        switch (pattern)
+        {
+          case 1:
+            InsertCell(grid, VTK_VOXEL, { v[0], v[1], v[3], v[2], v[4], v[5], v[7], v[6] });
+            break;
+          case 2:
+            InsertCell(grid, VTK_TETRA, { v[0], v[1], v[2], v[6] });
+            InsertCell(grid, VTK_TETRA, { v[0], v[2], v[3], v[6] });
+            InsertCell(grid, VTK_TETRA, { v[0], v[3], v[7], v[6] });
+            InsertCell(grid, VTK_TETRA, { v[0], v[7], v[4], v[6] });
+            InsertCell(grid, VTK_TETRA, { v[0], v[4], v[5], v[6] });
+            InsertCell(grid, VTK_TETRA, { v[0], v[5], v[1], v[6] });
+            break;
+          case 3:
+            InsertCell(grid, VTK_WEDGE, { v[0], v[1], v[3], v[4], v[5], v[7] });
+            InsertCell(grid, VTK_WEDGE, { v[1], v[2], v[3], v[5], v[6], v[7] });
+            break;
+          case 4:
+          {
+            const vtkIdType faces[] = { 4, v[0], v[3], v[2], v[1], 4, v[4], v[5], v[6], v[7], 4,
+              v[0], v[1], v[5], v[4], 4, v[1], v[2], v[6], v[5], 4, v[2], v[3], v[7], v[6], 4, v[3],
+              v[0], v[4], v[7] };
+            grid->InsertNextCell(VTK_POLYHEDRON, 8, v, 6, faces);
+            break;
+          }
+          case 5:
+            InsertCell(grid, VTK_HEXAHEDRON, { v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7] });
+            InsertCell(grid, VTK_HEXAHEDRON, { v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7] });
+            break;
+          default:
+            InsertCell(grid, VTK_HEXAHEDRON, { v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7] });
+            break;
+        }
+        if (mixed && k == Resolution - 1 && (i + j) % 3 == 0)
+        {
+          const vtkIdType apex = points->InsertNextPoint(i + 0.5, j + 0.5, k + 1.5);
+          InsertCell(grid, VTK_PYRAMID, { v[4], v[5], v[6], v[7], apex });
+        }
+      }
+    }
+  }
+  if (!mixed)
+  {
+    return grid;
+  }
+
+  // Standalone cells use new points.
+  auto newPoints = [&](int count, double z) {
+    std::vector<vtkIdType> ids;
+    for (int i = 0; i < count; ++i)
+    {
+      ids.push_back(points->InsertNextPoint(-2.0 - i, 0.5 * (i % 3), z));
+    }
+    return ids;
+  };
+  std::vector<vtkIdType> prism = newPoints(10, 1.0);
+  InsertCell(grid, VTK_PENTAGONAL_PRISM, prism);
+  prism = newPoints(12, 2.0);
+  InsertCell(grid, VTK_HEXAGONAL_PRISM, prism);
+  InsertCell(grid, VTK_TRIANGLE, newPoints(3, 3.0));
+  InsertCell(grid, VTK_QUAD, newPoints(4, 4.0));
+  InsertCell(grid, VTK_POLYGON, newPoints(7, 5.0));
+  InsertCell(grid, VTK_PIXEL, newPoints(4, 6.0));
+  InsertCell(grid, VTK_TRIANGLE_STRIP, newPoints(9, 7.0));
+  InsertCell(grid, VTK_LINE, newPoints(2, 8.0));
+  InsertCell(grid, VTK_POLY_LINE, newPoints(5, 9.0));
+  InsertCell(grid, VTK_VERTEX, newPoints(1, 10.0));
+  InsertCell(grid, VTK_POLY_VERTEX, newPoints(4, 11.0));
+  // Cells that reuse points of the lattice, some of them on its boundary.
+  InsertCell(grid, VTK_TRIANGLE, { LatticeId(0, 0, 0), LatticeId(1, 0, 0), LatticeId(0, 1, 0) });
+  InsertCell(grid, VTK_LINE, { LatticeId(5, 5, 5), LatticeId(0, 0, 0) });
+  InsertCell(grid, VTK_VERTEX, { LatticeId(Resolution, Resolution, Resolution) });
+
+  if (nonlinear)
+  {
+    // Two quadratic tetrahedra sharing a face.
+    std::vector<vtkIdType> corners = newPoints(5, 12.0);
+    std::vector<vtkIdType> mid = newPoints(9, 13.0);
+    InsertCell(grid, VTK_QUADRATIC_TETRA,
+      { corners[0], corners[1], corners[2], corners[3], mid[0], mid[1], mid[2], mid[3], mid[4],
+        mid[5] });
+    InsertCell(grid, VTK_QUADRATIC_TETRA,
+      { corners[0], corners[2], corners[1], corners[4], mid[2], mid[1], mid[0], mid[6], mid[8],
+        mid[7] });
+    InsertCell(grid, VTK_QUADRATIC_TRIANGLE, newPoints(6, 14.0));
+    InsertCell(grid, VTK_BIQUADRATIC_TRIANGLE, newPoints(7, 15.0));
+    InsertCell(grid, VTK_QUADRATIC_QUAD, newPoints(8, 16.0));
+    InsertCell(grid, VTK_QUADRATIC_EDGE, newPoints(3, 17.0));
+  }
+
+  // Point and cell data, with some hidden points.
+  vtkNew<vtkFloatArray> pointScalars;
+  pointScalars->SetName("PointScalars");
+  vtkNew<vtkUnsignedCharArray> ghosts;
+  ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    pointScalars->InsertNextValue(static_cast<float>(i));
+    ghosts->InsertNextValue(i % 97 == 0 ? vtkDataSetAttributes::HIDDENPOINT : 0);
+  }
+  grid->GetPointData()->SetScalars(pointScalars);
+  grid->GetPointData()->AddArray(ghosts);
+  vtkNew<vtkIntArray> cellIds;
+  cellIds->SetName("CellIds");
+  cellIds->SetNumberOfComponents(2);
+  for (vtkIdType i = 0; i < grid->GetNumberOfCells(); ++i)
+  {
+    cellIds->InsertNextTuple2(static_cast<double>(i), -static_cast<double>(i));
+  }
+  grid->GetCellData()->AddArray(cellIds);
+  return grid;
+}
+
+vtkSmartPointer<vtkPolyData> ExtractSurface(vtkUnstructuredGrid* input, int level, bool sequential)
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->ShallowCopy(input);
+  if (sequential)
+  {
+    vtkSMPTestUtilities::AddSequentialArray(grid->GetCellData(), grid->GetNumberOfCells());
+  }
+  vtkNew<vtkDataSetSurfaceFilter> surface;
+  surface->SetInputData(grid);
+  surface->SetNonlinearSubdivisionLevel(level);
+  surface->PassThroughCellIdsOn();
+  surface->PassThroughPointIdsOn();
+  surface->Update();
+  return surface->GetOutput();
+}
+}
+
+int TestDataSetSurfaceFilterThreaded(int, char*[])
+{
+  int status = EXIT_SUCCESS;
+
+  // The surface of a lattice of hexahedra.
+  vtkSmartPointer<vtkUnstructuredGrid> hexahedra = MakeGrid(false, false);
+  vtkSmartPointer<vtkPolyData> surface = ExtractSurface(hexahedra, 1, false);
+  const vtkIdType expectedPts = (Resolution + 1) * (Resolution + 1) * (Resolution + 1) -
+    (Resolution - 1) * (Resolution - 1) * (Resolution - 1);
+  if (surface->GetNumberOfPolys() != 6 * Resolution * Resolution ||
+    surface->GetNumberOfPoints() != expectedPts)
+  {
+    cerr << "Expected " << 6 * Resolution * Resolution << " quads and " << expectedPts
+         << " points, got " << surface->GetNumberOfPolys() << " and "
+         << surface->GetNumberOfPoints() << endl;
+    status = EXIT_FAILURE;
+  }
+
+  status |= vtkSMPTestUtilities::RunWithThreads([](int numThreads) {
+    int threadStatus = EXIT_SUCCESS;
+    for (int level : { 0, 1 })
+    {
+      vtkSmartPointer<vtkUnstructuredGrid> grid = MakeGrid(true, level == 0);
+      vtkSmartPointer<vtkPolyData> sequential = ExtractSurface(grid, level, true);
+      vtkSmartPointer<vtkPolyData> threaded = ExtractSurface(grid, level, false);
+      if (!vtkSMPTestUtilities::CompareOutputs(sequential, threaded))
+      {
+        cerr << "The threaded output differs with " << numThreads
+             << " threads and subdivision level " << level << endl;
+        threadStatus = EXIT_FAILURE;
+      }
+    }
+    return threadStatus;
+  });
+  return status;
+}
@@ -14,10 +14,12 @@
 =========================================================================*/
 #include "vtkDataSetSurfaceFilter.h"
 
+#include "vtkArrayListTemplate.h"
 #include "vtkBezierQuadrilateral.h"
 #include "vtkBezierTriangle.h"
 #include "vtkCell.h"
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkCellIterator.h"
 #include "vtkCellTypes.h"
@@ -37,6 +39,9 @@
 #include "vtkPyramid.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearGridGeometryFilter.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredData.h"
@@ -53,8 +58,11 @@
 #include "vtkVoxel.h"
 #include "vtkWedge.h"
 #include <algorithm>
+#include <atomic>
+#include <memory>
 #include <cassert>
 #include <unordered_map>
+#include <vector>
 
 static inline int sizeofFastQuad(int numPts)
 {
@@ -1451,6 +1459,655 @@ void vtkDataSetSurfaceFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "NonlinearSubdivisionLevel: " << this->GetNonlinearSubdivisionLevel() << endl;
 }
 
+//========================================================================
+// Threaded extraction of the surface of unstructured grids.
+namespace
+{
+// Kinds of output cells, in their order in the output.
+enum SurfaceCellKind
+{
+  SURFACE_VERTS = 0,
+  SURFACE_LINES = 1,
+  SURFACE_POLYS = 2
+};
+
+// How a face is matched with the faces already in the hash, as done by
+// InsertTriInHash(), InsertQuadInHash() and InsertPolygonInHash().
+enum SurfaceFaceKind : unsigned char
+{
+  SURFACE_TRI = 0,
+  SURFACE_QUAD = 1,
+  SURFACE_POLYGON = 2
+};
+
+// State of a face once the faces sharing its smallest point are matched.
+enum SurfaceFaceState : unsigned char
+{
+  SURFACE_DISCARDED = 0, // matched a face inserted before it
+  SURFACE_VISIBLE = 1,   // in the hash and not shared
+  SURFACE_HIDDEN = 2     // in the hash and shared by a face inserted after it
+};
+
+// Whether the cells of a type can be processed by the threaded extraction,
+// and whether they need the cell links.
+enum SurfaceCellSupport
+{
+  SURFACE_UNSUPPORTED,
+  SURFACE_SUPPORTED,
+  SURFACE_USES_NEIGHBORS
+};
+
+// Number of cells processed by one task.
+const vtkIdType SurfaceCellsPerChunk = 4096;
+
+//----------------------------------------------------------------------------
+SurfaceCellSupport GetSurfaceCellSupport(int cellType, int subdivisionLevel, vtkGenericCell* cell)
+{
+  switch (cellType)
+  {
+    case VTK_EMPTY_CELL:
+    case VTK_VERTEX:
+    case VTK_POLY_VERTEX:
+    case VTK_LINE:
+    case VTK_POLY_LINE:
+    case VTK_BEZIER_CURVE:
+    case VTK_HEXAHEDRON:
+    case VTK_VOXEL:
+    case VTK_TETRA:
+    case VTK_PENTAGONAL_PRISM:
+    case VTK_HEXAGONAL_PRISM:
+    case VTK_PYRAMID:
+    case VTK_WEDGE:
+    case VTK_POLYHEDRON:
+    case VTK_PIXEL:
+    case VTK_QUAD:
+    case VTK_TRIANGLE:
+    case VTK_POLYGON:
+    case VTK_TRIANGLE_STRIP:
+      return SURFACE_SUPPORTED;
+
+    // Nonlinear 2D cells are only subdivided sequentially.
+    case VTK_QUADRATIC_TRIANGLE:
+    case VTK_BIQUADRATIC_TRIANGLE:
+    case VTK_QUADRATIC_QUAD:
+    case VTK_QUADRATIC_LINEAR_QUAD:
+    case VTK_BIQUADRATIC_QUAD:
+    case VTK_QUADRATIC_POLYGON:
+    case VTK_LAGRANGE_TRIANGLE:
+    case VTK_LAGRANGE_QUADRILATERAL:
+    case VTK_BEZIER_TRIANGLE:
+    case VTK_BEZIER_QUADRILATERAL:
+      return subdivisionLevel < 1 ? SURFACE_SUPPORTED : SURFACE_UNSUPPORTED;
+
+    default:
+      break;
+  }
+
+  // The order and weights of higher order cells are set through the cell
+  // data, which is not thread safe.
+  if (cellType >= VTK_HIGHER_ORDER_EDGE && cellType <= VTK_BEZIER_PYRAMID)
+  {
+    return SURFACE_UNSUPPORTED;
+  }
+  cell->SetCellType(cellType);
+  if (cell->IsLinear() || cell->GetCellDimension() == 1)
+  {
+    return SURFACE_SUPPORTED;
+  }
+  if (cell->GetCellDimension() == 3 && subdivisionLevel < 1)
+  {
+    return SURFACE_USES_NEIGHBORS;
+  }
+  return SURFACE_UNSUPPORTED;
+}
+
+//----------------------------------------------------------------------------
+// Whether a face inserted in the hash after another face with the same
+// smallest point hides it. These are the tests of the Insert*InHash()
+// methods, which depend on the kind of the face being inserted.
+bool SurfaceFacesMatch(unsigned char kind, vtkIdType numPts, const vtkIdType* pts,
+  vtkIdType numOtherPts, const vtkIdType* otherPts)
+{
+  switch (kind)
+  {
+    case SURFACE_TRI:
+      return numOtherPts == 3 &&
+        ((pts[1] == otherPts[1] && pts[2] == otherPts[2]) ||
+          (pts[1] == otherPts[2] && pts[2] == otherPts[1]));
+    case SURFACE_QUAD:
+      return numOtherPts == 4 && pts[2] == otherPts[2] &&
+        ((pts[1] == otherPts[1] && pts[3] == otherPts[3]) ||
+          (pts[1] == otherPts[3] && pts[3] == otherPts[1]));
+    default:
+      if (numOtherPts != numPts || pts[0] != otherPts[0])
+      {
+        return false;
+      }
+      if (numPts > 1 && pts[1] == otherPts[1])
+      {
+        return std::equal(pts + 2, pts + numPts, otherPts + 2);
+      }
+      for (vtkIdType i = 1; i < numPts; ++i)
+      {
+        if (pts[numPts - i] != otherPts[i])
+        {
+          return false;
+        }
+      }
+      return true;
+  }
+}
+
+//----------------------------------------------------------------------------
+// Counts the output cells and the faces produced by a chunk of input cells.
+struct SurfaceCounter
+{
+  vtkIdType NumberOfCells[3] = { 0, 0, 0 };
+  vtkIdType CellConnSize[3] = { 0, 0, 0 };
+  vtkIdType NumberOfFaces = 0;
+  vtkIdType FaceConnSize = 0;
+
+  void InsertCell(int kind, vtkIdType numPts, const vtkIdType*, vtkIdType)
+  {
+    ++this->NumberOfCells[kind];
+    this->CellConnSize[kind] += numPts;
+  }
+
+  void InsertFace(unsigned char, vtkIdType numPts, const vtkIdType*, vtkIdType)
+  {
+    ++this->NumberOfFaces;
+    this->FaceConnSize += numPts;
+  }
+
+  void Add(const SurfaceCounter& other)
+  {
+    for (int kind = 0; kind < 3; ++kind)
+    {
+      this->NumberOfCells[kind] += other.NumberOfCells[kind];
+      this->CellConnSize[kind] += other.CellConnSize[kind];
+    }
+    this->NumberOfFaces += other.NumberOfFaces;
+    this->FaceConnSize += other.FaceConnSize;
+  }
+};
+
+//----------------------------------------------------------------------------
+// Writes the output cells and the faces produced by a chunk of input cells
+// where the counts of the previous chunks place them, and counts the faces
+// of each bin, that is the faces sharing the same smallest point.
+struct SurfaceWriter
+{
+  vtkIdType* CellOffsets[3];
+  vtkIdType* CellSources[3];
+  vtkIdType* CellConn[3];
+  vtkIdType CellConnOffset[3];
+  vtkIdType* FaceOffsets;
+  vtkIdType* FaceSources;
+  unsigned char* FaceKinds;
+  vtkIdType* FaceConn;
+  vtkIdType FaceConnOffset;
+  std::atomic<vtkIdType>* BinSizes;
+
+  void InsertCell(int kind, vtkIdType numPts, const vtkIdType* pts, vtkIdType sourceId)
+  {
+    *this->CellOffsets[kind]++ = this->CellConnOffset[kind];
+    *this->CellSources[kind]++ = sourceId;
+    std::copy(pts, pts + numPts, this->CellConn[kind] + this->CellConnOffset[kind]);
+    this->CellConnOffset[kind] += numPts;
+  }
+
+  void InsertFace(unsigned char kind, vtkIdType numPts, const vtkIdType* pts, vtkIdType sourceId)
+  {
+    *this->FaceOffsets++ = this->FaceConnOffset;
+    *this->FaceSources++ = sourceId;
+    *this->FaceKinds++ = kind;
+    std::copy(pts, pts + numPts, this->FaceConn + this->FaceConnOffset);
+    this->FaceConnOffset += numPts;
+    this->BinSizes[pts[0]].fetch_add(1, std::memory_order_relaxed);
+  }
+};
+
+//----------------------------------------------------------------------------
+// These reorder the points of the faces as the Insert*InHash() methods do.
+template <typename Sink>
+void InsertSurfaceQuad(
+  Sink& out, vtkIdType a, vtkIdType b, vtkIdType c, vtkIdType d, vtkIdType sourceId)
+{
+  vtkIdType quad[4];
+  if (b < a && b < c && b < d)
+  {
+    quad[0] = b;
+    quad[1] = c;
+    quad[2] = d;
+    quad[3] = a;
+  }
+  else if (c < a && c < b && c < d)
+  {
+    quad[0] = c;
+    quad[1] = d;
+    quad[2] = a;
+    quad[3] = b;
+  }
+  else if (d < a && d < b && d < c)
+  {
+    quad[0] = d;
+    quad[1] = a;
+    quad[2] = b;
+    quad[3] = c;
+  }
+  else
+  {
+    quad[0] = a;
+    quad[1] = b;
+    quad[2] = c;
+    quad[3] = d;
+  }
+  out.InsertFace(SURFACE_QUAD, 4, quad, sourceId);
+}
+
+template <typename Sink>
+void InsertSurfaceTri(Sink& out, vtkIdType a, vtkIdType b, vtkIdType c, vtkIdType sourceId)
+{
+  vtkIdType tri[3];
+  if (b < a && b < c)
+  {
+    tri[0] = b;
+    tri[1] = c;
+    tri[2] = a;
+  }
+  else if (c < a && c < b)
+  {
+    tri[0] = c;
+    tri[1] = a;
+    tri[2] = b;
+  }
+  else
+  {
+    tri[0] = a;
+    tri[1] = b;
+    tri[2] = c;
+  }
+  out.InsertFace(SURFACE_TRI, 3, tri, sourceId);
+}
+
+template <typename Sink>
+void InsertSurfacePolygon(Sink& out, const vtkIdType* ids, vtkIdType numPts, vtkIdType sourceId,
+  std::vector<vtkIdType>& polygon)
+{
+  if (numPts == 0)
+  {
+    return;
+  }
+  const vtkIdType offset = std::min_element(ids, ids + numPts) - ids;
+  polygon.assign(ids + offset, ids + numPts);
+  polygon.insert(polygon.end(), ids, ids + offset);
+  out.InsertFace(SURFACE_POLYGON, numPts, polygon.data(), sourceId);
+}
+
+//----------------------------------------------------------------------------
+// Extracts the output cells and the faces of chunks of cells, first to
+// count them and then to write them. Each cell is processed as the
+// sequential implementation does in the pass that handles its type.
+struct ExtractSurfaceCells
+{
+  vtkUnstructuredGrid* Input;
+  vtkCellArray* Cells;
+  const unsigned char* Types;
+  vtkUnsignedCharArray* Ghosts;
+  vtkIdType NumberOfCells;
+  std::atomic<bool> UnknownFace;
+
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> Iterator;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocalObject<vtkIdList> TriPts;
+  vtkSMPThreadLocalObject<vtkIdList> Neighbors;
+  vtkSMPThreadLocalObject<vtkPoints> Coords;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> Scratch;
+
+  ExtractSurfaceCells(vtkUnstructuredGrid* input)
+    : Input(input)
+    , Cells(input->GetCells())
+    , Types(input->GetCellTypesArray()->GetPointer(0))
+    , Ghosts(input->GetPointGhostArray())
+    , NumberOfCells(input->GetNumberOfCells())
+    , UnknownFace(false)
+  {
+  }
+
+  template <typename Sink>
+  void ExtractChunk(vtkIdType chunk, Sink& out)
+  {
+    vtkSmartPointer<vtkCellArrayIterator>& iter = this->Iterator.Local();
+    if (!iter)
+    {
+      iter = vtk::TakeSmartPointer(this->Cells->NewIterator());
+      this->Coords.Local()->SetDataType(this->Input->GetPoints()->GetDataType());
+    }
+    vtkIdType numPts;
+    const vtkIdType* pts;
+    const vtkIdType endCellId = std::min((chunk + 1) * SurfaceCellsPerChunk, this->NumberOfCells);
+    for (vtkIdType cellId = chunk * SurfaceCellsPerChunk; cellId < endCellId; ++cellId)
+    {
+      iter->GetCellAtId(cellId, numPts, pts);
+      this->ExtractCell(out, cellId, this->Types[cellId], numPts, pts);
+    }
+  }
+
+  template <typename Sink>
+  void ExtractCell(
+    Sink& out, vtkIdType cellId, int cellType, vtkIdType numPts, const vtkIdType* ids)
+  {
+    switch (cellType)
+    {
+      case VTK_VERTEX:
+      case VTK_POLY_VERTEX:
+        out.InsertCell(SURFACE_VERTS, numPts, ids, cellId);
+        break;
+
+      case VTK_LINE:
+      case VTK_POLY_LINE:
+        out.InsertCell(SURFACE_LINES, numPts, ids, cellId);
+        break;
+
+      case VTK_BEZIER_CURVE:
+      {
+        // The end points come first and last.
+        std::vector<vtkIdType>& line = this->Scratch.Local();
+        line.assign(ids + 1, ids + numPts);
+        line[0] = ids[0];
+        line.push_back(ids[1]);
+        out.InsertCell(SURFACE_LINES, numPts, line.data(), cellId);
+        break;
+      }
+
+      case VTK_HEXAHEDRON:
+        InsertSurfaceQuad(out, ids[0], ids[1], ids[5], ids[4], cellId);
+        InsertSurfaceQuad(out, ids[0], ids[3], ids[2], ids[1], cellId);
+        InsertSurfaceQuad(out, ids[0], ids[4], ids[7], ids[3], cellId);
+        InsertSurfaceQuad(out, ids[1], ids[2], ids[6], ids[5], cellId);
+        InsertSurfaceQuad(out, ids[2], ids[3], ids[7], ids[6], cellId);
+        InsertSurfaceQuad(out, ids[4], ids[5], ids[6], ids[7], cellId);
+        break;
+
+      case VTK_VOXEL:
+        InsertSurfaceQuad(out, ids[0], ids[1], ids[5], ids[4], cellId);
+        InsertSurfaceQuad(out, ids[0], ids[2], ids[3], ids[1], cellId);
+        InsertSurfaceQuad(out, ids[0], ids[4], ids[6], ids[2], cellId);
+        InsertSurfaceQuad(out, ids[1], ids[3], ids[7], ids[5], cellId);
+        InsertSurfaceQuad(out, ids[2], ids[6], ids[7], ids[3], cellId);
+        InsertSurfaceQuad(out, ids[4], ids[5], ids[7], ids[6], cellId);
+        break;
+
+      case VTK_TETRA:
+        InsertSurfaceTri(out, ids[0], ids[1], ids[3], cellId);
+        InsertSurfaceTri(out, ids[0], ids[2], ids[1], cellId);
+        InsertSurfaceTri(out, ids[0], ids[3], ids[2], cellId);
+        InsertSurfaceTri(out, ids[1], ids[2], ids[3], cellId);
+        break;
+
+      case VTK_PENTAGONAL_PRISM:
+        InsertSurfaceQuad(out, ids[0], ids[1], ids[6], ids[5], cellId);
+        InsertSurfaceQuad(out, ids[1], ids[2], ids[7], ids[6], cellId);
+        InsertSurfaceQuad(out, ids[2], ids[3], ids[8], ids[7], cellId);
+        InsertSurfaceQuad(out, ids[3], ids[4], ids[9], ids[8], cellId);
+        InsertSurfaceQuad(out, ids[4], ids[0], ids[5], ids[9], cellId);
+        InsertSurfacePolygon(out, ids, 5, cellId, this->Scratch.Local());
+        InsertSurfacePolygon(out, ids + 5, 5, cellId, this->Scratch.Local());
+        break;
+
+      case VTK_HEXAGONAL_PRISM:
+        InsertSurfaceQuad(out, ids[0], ids[1], ids[7], ids[6], cellId);
+        InsertSurfaceQuad(out, ids[1], ids[2], ids[8], ids[7], cellId);
+        InsertSurfaceQuad(out, ids[2], ids[3], ids[9], ids[8], cellId);
+        InsertSurfaceQuad(out, ids[3], ids[4], ids[10], ids[9], cellId);
+        InsertSurfaceQuad(out, ids[4], ids[5], ids[11], ids[10], cellId);
+        InsertSurfaceQuad(out, ids[5], ids[0], ids[6], ids[11], cellId);
+        InsertSurfacePolygon(out, ids, 6, cellId, this->Scratch.Local());
+        InsertSurfacePolygon(out, ids + 6, 6, cellId, this->Scratch.Local());
+        break;
+
+      case VTK_PYRAMID:
+        InsertSurfaceQuad(out, ids[3], ids[2], ids[1], ids[0], cellId);
+        InsertSurfaceTri(out, ids[0], ids[1], ids[4], cellId);
+        InsertSurfaceTri(out, ids[1], ids[2], ids[4], cellId);
+        InsertSurfaceTri(out, ids[2], ids[3], ids[4], cellId);
+        InsertSurfaceTri(out, ids[3], ids[0], ids[4], cellId);
+        break;
+
+      case VTK_WEDGE:
+        InsertSurfaceQuad(out, ids[0], ids[2], ids[5], ids[3], cellId);
+        InsertSurfaceQuad(out, ids[1], ids[0], ids[3], ids[4], cellId);
+        InsertSurfaceQuad(out, ids[2], ids[1], ids[4], ids[5], cellId);
+        InsertSurfaceTri(out, ids[0], ids[1], ids[2], cellId);
+        InsertSurfaceTri(out, ids[3], ids[5], ids[4], cellId);
+        break;
+
+      case VTK_POLYHEDRON:
+        this->ExtractPolyhedron(out, cellId);
+        break;
+
+      case VTK_PIXEL:
+      case VTK_QUAD:
+      case VTK_TRIANGLE:
+      case VTK_POLYGON:
+      case VTK_TRIANGLE_STRIP:
+      case VTK_QUADRATIC_TRIANGLE:
+      case VTK_BIQUADRATIC_TRIANGLE:
+      case VTK_QUADRATIC_QUAD:
+      case VTK_QUADRATIC_LINEAR_QUAD:
+      case VTK_BIQUADRATIC_QUAD:
+      case VTK_QUADRATIC_POLYGON:
+      case VTK_LAGRANGE_TRIANGLE:
+      case VTK_LAGRANGE_QUADRILATERAL:
+      case VTK_BEZIER_TRIANGLE:
+      case VTK_BEZIER_QUADRILATERAL:
+        this->Extract2DCell(out, cellId, cellType, numPts, ids);
+        break;
+
+      default:
+        this->ExtractGenericCell(out, cellId, cellType, numPts, ids);
+        break;
+    }
+  }
+
+  // The faces of a polyhedron, in the order of its face stream.
+  template <typename Sink>
+  void ExtractPolyhedron(Sink& out, vtkIdType cellId)
+  {
+    const vtkIdType* faces = this->Input->GetFaces(cellId);
+    if (!faces)
+    {
+      return;
+    }
+    const vtkIdType numFaces = *faces++;
+    for (vtkIdType face = 0; face < numFaces; ++face)
+    {
+      const vtkIdType numFacePts = *faces++;
+      if (numFacePts == 4)
+      {
+        InsertSurfaceQuad(out, faces[0], faces[1], faces[2], faces[3], cellId);
+      }
+      else if (numFacePts == 3)
+      {
+        InsertSurfaceTri(out, faces[0], faces[1], faces[2], cellId);
+      }
+      else
+      {
+        InsertSurfacePolygon(out, faces, numFacePts, cellId, this->Scratch.Local());
+      }
+      faces += numFacePts;
+    }
+  }
+
+  // Quadratic 2D cells are only found when the subdivision level is zero.
+  // Most of them are then treated as their linear counterpart.
+  template <typename Sink>
+  void Extract2DCell(
+    Sink& out, vtkIdType cellId, int cellType, vtkIdType numPts, const vtkIdType* ids)
+  {
+    switch (cellType)
+    {
+      case VTK_QUADRATIC_TRIANGLE:
+      case VTK_LAGRANGE_TRIANGLE:
+      case VTK_BEZIER_TRIANGLE:
+        cellType = VTK_TRIANGLE;
+        numPts = 3;
+        break;
+      case VTK_QUADRATIC_QUAD:
+      case VTK_BIQUADRATIC_QUAD:
+      case VTK_QUADRATIC_LINEAR_QUAD:
+      case VTK_LAGRANGE_QUADRILATERAL:
+      case VTK_BEZIER_QUADRILATERAL:
+        cellType = VTK_POLYGON;
+        numPts = 4;
+        break;
+    }
+
+    if (cellType == VTK_PIXEL)
+    {
+      const vtkIdType quad[4] = { ids[0], ids[1], ids[3], ids[2] };
+      out.InsertCell(SURFACE_POLYS, 4, quad, cellId);
+    }
+    else if (cellType == VTK_POLYGON || cellType == VTK_TRIANGLE || cellType == VTK_QUAD)
+    {
+      out.InsertCell(SURFACE_POLYS, numPts, ids, cellId);
+    }
+    else if (cellType == VTK_TRIANGLE_STRIP)
+    {
+      // Change strips to triangles so we do not have to worry about order.
+      if (numPts > 1)
+      {
+        int toggle = 0;
+        vtkIdType tri[3] = { ids[0], ids[1], 0 };
+        for (vtkIdType i = 2; i < numPts; ++i)
+        {
+          tri[2] = ids[i];
+          out.InsertCell(SURFACE_POLYS, 3, tri, cellId);
+          tri[toggle] = tri[2];
+          toggle = !toggle;
+        }
+      }
+    }
+    else
+    {
+      // Biquadratic triangles and quadratic polygons are triangulated,
+      // unless one of their points is hidden.
+      if (this->Ghosts)
+      {
+        for (vtkIdType i = 0; i < numPts; ++i)
+        {
+          if (this->Ghosts->GetValue(ids[i]) & vtkDataSetAttributes::HIDDENPOINT)
+          {
+            return;
+          }
+        }
+      }
+      vtkGenericCell* cell = this->GetCell(cellType, numPts, ids);
+      vtkIdList* triPts = this->TriPts.Local();
+      cell->Triangulate(0, triPts, this->Coords.Local());
+      for (vtkIdType i = 0; i + 2 < triPts->GetNumberOfIds(); i += 3)
+      {
+        out.InsertCell(SURFACE_POLYS, 3, triPts->GetPointer(i), cellId);
+      }
+    }
+  }
+
+  template <typename Sink>
+  void ExtractGenericCell(
+    Sink& out, vtkIdType cellId, int cellType, vtkIdType numPts, const vtkIdType* ids)
+  {
+    vtkGenericCell* cell = this->GetCell(cellType, numPts, ids);
+    if (cell->IsLinear())
+    {
+      if (cell->GetCellDimension() == 3)
+      {
+        const int numFaces = cell->GetNumberOfFaces();
+        for (int j = 0; j < numFaces; ++j)
+        {
+          vtkIdList* facePts = cell->GetFace(j)->PointIds;
+          const vtkIdType numFacePts = facePts->GetNumberOfIds();
+          if (numFacePts == 4)
+          {
+            InsertSurfaceQuad(out, 
+              facePts->GetId(0), facePts->GetId(1), facePts->GetId(2), facePts->GetId(3), cellId);
+          }
+          else if (numFacePts == 3)
+          {
+            InsertSurfaceTri(out, facePts->GetId(0), facePts->GetId(1), facePts->GetId(2), cellId);
+          }
+          else
+          {
+            InsertSurfacePolygon(
+              out, facePts->GetPointer(0), numFacePts, cellId, this->Scratch.Local());
+          }
+        }
+      }
+    }
+    else if (cell->GetCellDimension() == 1)
+    {
+      vtkIdList* linePts = this->TriPts.Local();
+      cell->Triangulate(0, linePts, this->Coords.Local());
+      for (vtkIdType i = 0; i + 1 < linePts->GetNumberOfIds(); i += 2)
+      {
+        out.InsertCell(SURFACE_LINES, 2, linePts->GetPointer(i), cellId);
+      }
+    }
+    else
+    {
+      // A nonlinear 3D cell, whose faces not shared with a neighbor are
+      // inserted as their linear counterpart.
+      vtkIdList* neighbors = this->Neighbors.Local();
+      const int numFaces = cell->GetNumberOfFaces();
+      for (int j = 0; j < numFaces; ++j)
+      {
+        vtkCell* face = cell->GetFace(j);
+        this->Input->GetCellNeighbors(cellId, face->PointIds, neighbors);
+        if (neighbors->GetNumberOfIds() > 0)
+        {
+          continue;
+        }
+        vtkIdList* facePts = face->PointIds;
+        switch (face->GetCellType())
+        {
+          case VTK_QUADRATIC_TRIANGLE:
+          case VTK_LAGRANGE_TRIANGLE:
+          case VTK_BEZIER_TRIANGLE:
+            InsertSurfaceTri(out, facePts->GetId(0), facePts->GetId(1), facePts->GetId(2), cellId);
+            break;
+          case VTK_QUADRATIC_QUAD:
+          case VTK_BIQUADRATIC_QUAD:
+          case VTK_QUADRATIC_LINEAR_QUAD:
+          case VTK_LAGRANGE_QUADRILATERAL:
+          case VTK_BEZIER_QUADRILATERAL:
+            InsertSurfaceQuad(out, 
+              facePts->GetId(0), facePts->GetId(1), facePts->GetId(2), facePts->GetId(3), cellId);
+            break;
+          default:
+            this->UnknownFace = true;
+            break;
+        }
+      }
+    }
+  }
+
+  // Thread safe equivalent of vtkUnstructuredGrid::GetCell() for the cells
+  // that are not polyhedra and that have no order to set.
+  vtkGenericCell* GetCell(int cellType, vtkIdType numPts, const vtkIdType* ids)
+  {
+    vtkGenericCell* cell = this->Cell.Local();
+    cell->SetCellType(cellType);
+    cell->PointIds->SetNumberOfIds(numPts);
+    std::copy(ids, ids + numPts, cell->PointIds->GetPointer(0));
+    this->Input->GetPoints()->GetPoints(cell->PointIds, cell->Points);
+    if (cell->RequiresInitialization())
+    {
+      cell->Initialize();
+    }
+    return cell;
+  }
+};
+} // anonymous namespace
+
 //========================================================================
 // Tris are now degenerate quads so we only need one hash table.
 // We might want to change the method names from QuadHash to just Hash.
@@ -1491,6 +2148,13 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet* dataSetInput, v
     }
   }
 
+  // Without subdivision, unstructured grids are processed in parallel.
+  vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(input);
+  if (!handleSubdivision && grid && this->ThreadedUnstructuredGridExecute(grid, output))
+  {
+    return 1;
+  }
+
   vtkSmartPointer<vtkUnstructuredGrid> tempInput;
   if (handleSubdivision)
   {
@@ -2276,6 +2940,431 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet* dataSetInput, v
   return 1;
 }
 
+//----------------------------------------------------------------------------
+bool vtkDataSetSurfaceFilter::ThreadedUnstructuredGridExecute(
+  vtkUnstructuredGrid* input, vtkPolyData* output)
+{
+  vtkPointData* inputPD = input->GetPointData();
+  vtkCellData* inputCD = input->GetCellData();
+  if (!input->GetPoints() || !ArrayList::CanCopyInParallel(inputPD) ||
+    !ArrayList::CanCopyInParallel(inputCD))
+  {
+    return false;
+  }
+
+  vtkNew<vtkCellTypes> types;
+  input->GetCellTypes(types);
+  bool usesNeighbors = false;
+  vtkNew<vtkGenericCell> typeCell;
+  for (vtkIdType i = 0; i < types->GetNumberOfTypes(); ++i)
+  {
+    switch (GetSurfaceCellSupport(
+      types->GetCellType(static_cast<int>(i)), this->NonlinearSubdivisionLevel, typeCell))
+    {
+      case SURFACE_UNSUPPORTED:
+        return false;
+      case SURFACE_USES_NEIGHBORS:
+        usesNeighbors = true;
+        break;
+      default:
+        break;
+    }
+  }
+  if (usesNeighbors && !input->GetCellLinks())
+  {
+    input->BuildLinks();
+  }
+
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+  vtkUnsignedCharArray* ghosts = input->GetPointGhostArray();
+  vtkPointData* outputPD = output->GetPointData();
+  vtkCellData* outputCD = output->GetCellData();
+
+  // Shallow copy field data not associated with points or cells
+  output->GetFieldData()->ShallowCopy(input->GetFieldData());
+
+  // Count the output cells and the faces of chunks of cells.
+  const vtkIdType numChunks = (numCells + SurfaceCellsPerChunk - 1) / SurfaceCellsPerChunk;
+  std::vector<SurfaceCounter> chunkStarts(numChunks + 1);
+  ExtractSurfaceCells extract(input);
+  vtkSMPTools::For(0, numChunks, [&](vtkIdType chunk, vtkIdType endChunk) {
+    for (; chunk < endChunk; ++chunk)
+    {
+      extract.ExtractChunk(chunk, chunkStarts[chunk + 1]);
+    }
+  });
+  for (vtkIdType chunk = 0; chunk < numChunks; ++chunk)
+  {
+    chunkStarts[chunk + 1].Add(chunkStarts[chunk]);
+  }
+  const SurfaceCounter& totals = chunkStarts[numChunks];
+
+  // Write them. The output cells of each kind are numbered from the start of
+  // their kind, and their connectivity is stored one kind after the other.
+  vtkIdType numKindCells[3];
+  vtkIdType sourceStarts[4] = { 0, 0, 0, 0 };
+  vtkIdType seqStarts[4] = { 0, 0, 0, 0 };
+  for (int kind = 0; kind < 3; ++kind)
+  {
+    numKindCells[kind] = totals.NumberOfCells[kind];
+    sourceStarts[kind + 1] = sourceStarts[kind] + numKindCells[kind];
+    seqStarts[kind + 1] = seqStarts[kind] + totals.CellConnSize[kind];
+  }
+  std::vector<vtkIdType> cellOffsets(sourceStarts[3]);
+  std::vector<vtkIdType> cellSources(sourceStarts[3] + totals.NumberOfFaces);
+  std::vector<vtkIdType> seq(seqStarts[3]);
+  const vtkIdType numFaces = totals.NumberOfFaces;
+  std::unique_ptr<vtkIdType[]> faceOffsets(new vtkIdType[numFaces + 1]);
+  std::unique_ptr<vtkIdType[]> faceSources(new vtkIdType[numFaces]);
+  std::unique_ptr<unsigned char[]> faceKinds(new unsigned char[numFaces]);
+  std::unique_ptr<vtkIdType[]> faceConn(new vtkIdType[totals.FaceConnSize]);
+  faceOffsets[numFaces] = totals.FaceConnSize;
+  std::vector<std::atomic<vtkIdType>> binSizes(numPts);
+  vtkSMPTools::For(0, numChunks, [&](vtkIdType chunk, vtkIdType endChunk) {
+    for (; chunk < endChunk; ++chunk)
+    {
+      const SurfaceCounter& start = chunkStarts[chunk];
+      SurfaceWriter writer;
+      for (int kind = 0; kind < 3; ++kind)
+      {
+        const vtkIdType cellStart = sourceStarts[kind] + start.NumberOfCells[kind];
+        writer.CellOffsets[kind] = cellOffsets.data() + cellStart;
+        writer.CellSources[kind] = cellSources.data() + cellStart;
+        writer.CellConn[kind] = seq.data() + seqStarts[kind];
+        writer.CellConnOffset[kind] = start.CellConnSize[kind];
+      }
+      writer.FaceOffsets = faceOffsets.get() + start.NumberOfFaces;
+      writer.FaceSources = faceSources.get() + start.NumberOfFaces;
+      writer.FaceKinds = faceKinds.get() + start.NumberOfFaces;
+      writer.FaceConn = faceConn.get();
+      writer.FaceConnOffset = start.FaceConnSize;
+      writer.BinSizes = binSizes.data();
+      extract.ExtractChunk(chunk, writer);
+    }
+  });
+  if (extract.UnknownFace)
+  {
+    vtkWarningMacro(<< "Encountered unknown nonlinear face.");
+  }
+  std::vector<SurfaceCounter>().swap(chunkStarts);
+  this->UpdateProgress(0.4);
+
+  // Partition the faces by their smallest point, which plays the role of the
+  // bins of the hash. The faces of a bin are sorted back in their order of
+  // insertion.
+  const vtkIdType zero = 0;
+  std::vector<vtkIdType> binStarts(numPts + 1);
+  binStarts[numPts] =
+    vtkSMPTools::ExclusiveScan(binSizes.begin(), binSizes.end(), binStarts.begin(), zero);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      binSizes[ptId].store(binStarts[ptId], std::memory_order_relaxed);
+    }
+  });
+  std::unique_ptr<vtkIdType[]> binFaces(new vtkIdType[numFaces]);
+  vtkSMPTools::For(0, numFaces, [&](vtkIdType face, vtkIdType endFace) {
+    for (; face < endFace; ++face)
+    {
+      binFaces[binSizes[faceConn[faceOffsets[face]]].fetch_add(1, std::memory_order_relaxed)] =
+        face;
+    }
+  });
+  std::vector<std::atomic<vtkIdType>>().swap(binSizes);
+
+  // Match the faces of each bin: a face that matches a face of the bin hides
+  // it and is discarded. The visible faces use output points, but those with
+  // a hidden point are not output.
+  std::vector<unsigned char> faceStates(numFaces, SURFACE_DISCARDED);
+  std::vector<unsigned char> isOutputFace(numFaces, 0);
+  std::vector<vtkIdType> visibleConn(numPts);
+  std::vector<vtkIdType> outputFaces(numPts);
+  std::vector<vtkIdType> outputFaceConn(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType bin, vtkIdType endBin) {
+    std::vector<vtkIdType> chain;
+    for (; bin < endBin; ++bin)
+    {
+      vtkIdType* begin = binFaces.get() + binStarts[bin];
+      vtkIdType* end = binFaces.get() + binStarts[bin + 1];
+      std::sort(begin, end);
+      chain.clear();
+      for (vtkIdType* it = begin; it != end; ++it)
+      {
+        const vtkIdType face = *it;
+        const vtkIdType* pts = faceConn.get() + faceOffsets[face];
+        const vtkIdType facePts = faceOffsets[face + 1] - faceOffsets[face];
+        bool matched = false;
+        for (vtkIdType other : chain)
+        {
+          if (SurfaceFacesMatch(faceKinds[face], facePts, pts,
+                faceOffsets[other + 1] - faceOffsets[other], faceConn.get() + faceOffsets[other]))
+          {
+            faceStates[other] = SURFACE_HIDDEN;
+            matched = true;
+            break;
+          }
+        }
+        if (!matched)
+        {
+          faceStates[face] = SURFACE_VISIBLE;
+          chain.push_back(face);
+        }
+      }
+
+      vtkIdType binVisibleConn = 0;
+      vtkIdType binOutputFaces = 0;
+      vtkIdType binOutputFaceConn = 0;
+      for (vtkIdType face : chain)
+      {
+        if (faceStates[face] != SURFACE_VISIBLE)
+        {
+          continue;
+        }
+        const vtkIdType* pts = faceConn.get() + faceOffsets[face];
+        const vtkIdType facePts = faceOffsets[face + 1] - faceOffsets[face];
+        binVisibleConn += facePts;
+        bool isOutput = true;
+        if (ghosts)
+        {
+          for (vtkIdType j = 0; j < facePts; ++j)
+          {
+            if (ghosts->GetValue(pts[j]) & vtkDataSetAttributes::HIDDENPOINT)
+            {
+              isOutput = false;
+              break;
+            }
+          }
+        }
+        if (isOutput)
+        {
+          isOutputFace[face] = 1;
+          ++binOutputFaces;
+          binOutputFaceConn += facePts;
+        }
+      }
+      visibleConn[bin] = binVisibleConn;
+      outputFaces[bin] = binOutputFaces;
+      outputFaceConn[bin] = binOutputFaceConn;
+    }
+  });
+  const vtkIdType numVisibleConn =
+    vtkSMPTools::ExclusiveScan(visibleConn.begin(), visibleConn.end(), visibleConn.begin(), zero);
+  const vtkIdType numOutputFaces =
+    vtkSMPTools::ExclusiveScan(outputFaces.begin(), outputFaces.end(), outputFaces.begin(), zero);
+  const vtkIdType numOutputFaceConn = vtkSMPTools::ExclusiveScan(
+    outputFaceConn.begin(), outputFaceConn.end(), outputFaceConn.begin(), zero);
+  this->UpdateProgress(0.6);
+
+  // The output cells: verts, lines, 2D cells, then the output faces.
+  const vtkIdType numPolys = numKindCells[SURFACE_POLYS] + numOutputFaces;
+  const vtkIdType numOutCells = sourceStarts[3] + numOutputFaces;
+  vtkSmartPointer<vtkIdTypeArray> offsets[3];
+  vtkSmartPointer<vtkIdTypeArray> conns[3];
+  for (int kind = 0; kind < 3; ++kind)
+  {
+    const vtkIdType kindCells = kind == SURFACE_POLYS ? numPolys : numKindCells[kind];
+    const vtkIdType kindConn =
+      seqStarts[kind + 1] - seqStarts[kind] + (kind == SURFACE_POLYS ? numOutputFaceConn : 0);
+    offsets[kind] = vtkSmartPointer<vtkIdTypeArray>::New();
+    offsets[kind]->SetNumberOfValues(kindCells + 1);
+    offsets[kind]->SetValue(kindCells, kindConn);
+    std::copy(cellOffsets.begin() + sourceStarts[kind],
+      cellOffsets.begin() + sourceStarts[kind + 1], offsets[kind]->GetPointer(0));
+    conns[kind] = vtkSmartPointer<vtkIdTypeArray>::New();
+    conns[kind]->SetNumberOfValues(kindConn);
+  }
+  std::vector<vtkIdType>().swap(cellOffsets);
+
+  // The points used by the output, in the order of their first use, are
+  // those of the output cells followed by those of the visible faces, in the
+  // order of the bins. The output faces are written with input points.
+  const vtkIdType seqSize = seqStarts[3] + numVisibleConn;
+  seq.resize(seqSize);
+  const vtkIdType polyFaceConnStart = seqStarts[3] - seqStarts[2];
+  vtkIdType* polyOffsets = offsets[SURFACE_POLYS]->GetPointer(numKindCells[SURFACE_POLYS]);
+  vtkIdType* polyFaceConn = conns[SURFACE_POLYS]->GetPointer(polyFaceConnStart);
+  vtkIdType* faceCellSources = cellSources.data() + sourceStarts[3];
+  vtkSMPTools::For(0, numPts, [&](vtkIdType bin, vtkIdType endBin) {
+    for (; bin < endBin; ++bin)
+    {
+      vtkIdType visible = seqStarts[3] + visibleConn[bin];
+      vtkIdType outputFace = outputFaces[bin];
+      vtkIdType outputConn = outputFaceConn[bin];
+      for (vtkIdType i = binStarts[bin]; i < binStarts[bin + 1]; ++i)
+      {
+        const vtkIdType face = binFaces[i];
+        if (faceStates[face] != SURFACE_VISIBLE)
+        {
+          continue;
+        }
+        const vtkIdType* pts = faceConn.get() + faceOffsets[face];
+        const vtkIdType facePts = faceOffsets[face + 1] - faceOffsets[face];
+        std::copy(pts, pts + facePts, seq.data() + visible);
+        visible += facePts;
+        if (isOutputFace[face])
+        {
+          polyOffsets[outputFace] = polyFaceConnStart + outputConn;
+          faceCellSources[outputFace] = faceSources[face];
+          std::copy(pts, pts + facePts, polyFaceConn + outputConn);
+          ++outputFace;
+          outputConn += facePts;
+        }
+      }
+    }
+  });
+  std::vector<vtkIdType>().swap(binStarts);
+  binFaces.reset();
+  std::vector<vtkIdType>().swap(visibleConn);
+  std::vector<vtkIdType>().swap(outputFaces);
+  std::vector<vtkIdType>().swap(outputFaceConn);
+  faceOffsets.reset();
+  faceSources.reset();
+  faceKinds.reset();
+  faceConn.reset();
+  std::vector<unsigned char>().swap(faceStates);
+  std::vector<unsigned char>().swap(isOutputFace);
+  cellSources.resize(numOutCells);
+
+  // Number the points by their first use.
+  std::vector<std::atomic<vtkIdType>> firstUses(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      firstUses[ptId].store(seqSize, std::memory_order_relaxed);
+    }
+  });
+  vtkSMPTools::For(0, seqSize, [&](vtkIdType pos, vtkIdType end) {
+    for (; pos < end; ++pos)
+    {
+      std::atomic<vtkIdType>& firstUse = firstUses[seq[pos]];
+      vtkIdType current = firstUse.load(std::memory_order_relaxed);
+      while (pos < current && !firstUse.compare_exchange_weak(current, pos))
+      {
+      }
+    }
+  });
+  std::vector<vtkIdType> newPtIds(seqSize);
+  vtkSMPTools::For(0, seqSize, [&](vtkIdType pos, vtkIdType end) {
+    for (; pos < end; ++pos)
+    {
+      newPtIds[pos] = firstUses[seq[pos]].load(std::memory_order_relaxed) == pos ? 1 : 0;
+    }
+  });
+  const vtkIdType numNewPts =
+    vtkSMPTools::ExclusiveScan(newPtIds.begin(), newPtIds.end(), newPtIds.begin(), zero);
+  std::vector<vtkIdType> origPtIds(numNewPts);
+  std::vector<vtkIdType> pointMap(numPts);
+  vtkSMPTools::For(0, seqSize, [&](vtkIdType pos, vtkIdType end) {
+    for (; pos < end; ++pos)
+    {
+      if (firstUses[seq[pos]].load(std::memory_order_relaxed) == pos)
+      {
+        origPtIds[newPtIds[pos]] = seq[pos];
+        pointMap[seq[pos]] = newPtIds[pos];
+      }
+    }
+  });
+  std::vector<std::atomic<vtkIdType>>().swap(firstUses);
+  std::vector<vtkIdType>().swap(newPtIds);
+  this->UpdateProgress(0.8);
+
+  // Write the connectivity of the output cells.
+  for (int kind = 0; kind < 3; ++kind)
+  {
+    vtkIdType* kindConn = conns[kind]->GetPointer(0);
+    const vtkIdType start = seqStarts[kind];
+    vtkSMPTools::For(start, seqStarts[kind + 1], [&](vtkIdType pos, vtkIdType end) {
+      for (; pos < end; ++pos)
+      {
+        kindConn[pos - start] = pointMap[seq[pos]];
+      }
+    });
+  }
+  vtkSMPTools::For(0, numOutputFaceConn, [&](vtkIdType i, vtkIdType end) {
+    for (; i < end; ++i)
+    {
+      polyFaceConn[i] = pointMap[polyFaceConn[i]];
+    }
+  });
+  std::vector<vtkIdType>().swap(seq);
+
+  // Copy the points and their data.
+  vtkNew<vtkPoints> newPts;
+  vtkPoints* inPts = input->GetPoints();
+  newPts->SetDataType(inPts->GetDataType());
+  newPts->SetNumberOfPoints(numNewPts);
+  if (this->NonlinearSubdivisionLevel < 2)
+  {
+    outputPD->CopyGlobalIdsOn();
+    outputPD->CopyAllocate(inputPD, numNewPts);
+  }
+  else
+  {
+    outputPD->InterpolateAllocate(inputPD, numNewPts);
+  }
+  ArrayList pointArrays;
+  pointArrays.AddArrays(numNewPts, inputPD, outputPD, 0.0, false);
+  vtkSMPTools::For(0, numNewPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    double x[3];
+    for (; ptId < endPtId; ++ptId)
+    {
+      inPts->GetPoint(origPtIds[ptId], x);
+      newPts->SetPoint(ptId, x);
+      pointArrays.Copy(origPtIds[ptId], ptId);
+    }
+  });
+
+  // Copy the cell data.
+  outputCD->CopyGlobalIdsOn();
+  outputCD->CopyAllocate(inputCD, numOutCells);
+  ArrayList cellArrays;
+  cellArrays.AddArrays(numOutCells, inputCD, outputCD, 0.0, false);
+  vtkSMPTools::For(0, numOutCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      cellArrays.Copy(cellSources[cellId], cellId);
+    }
+  });
+
+  if (this->PassThroughCellIds)
+  {
+    vtkNew<vtkIdTypeArray> originalCellIds;
+    originalCellIds->SetName(this->GetOriginalCellIdsName());
+    originalCellIds->SetNumberOfValues(numOutCells);
+    std::copy(cellSources.begin(), cellSources.end(), originalCellIds->GetPointer(0));
+    outputCD->AddArray(originalCellIds);
+  }
+  if (this->PassThroughPointIds)
+  {
+    vtkNew<vtkIdTypeArray> originalPointIds;
+    originalPointIds->SetName(this->GetOriginalPointIdsName());
+    originalPointIds->SetNumberOfValues(numNewPts);
+    std::copy(origPtIds.begin(), origPtIds.end(), originalPointIds->GetPointer(0));
+    outputPD->AddArray(originalPointIds);
+  }
+
+  output->SetPoints(newPts);
+  vtkNew<vtkCellArray> newPolys;
+  newPolys->SetData(offsets[SURFACE_POLYS], conns[SURFACE_POLYS]);
+  output->SetPolys(newPolys);
+  if (numKindCells[SURFACE_VERTS] > 0)
+  {
+    vtkNew<vtkCellArray> newVerts;
+    newVerts->SetData(offsets[SURFACE_VERTS], conns[SURFACE_VERTS]);
+    output->SetVerts(newVerts);
+  }
+  if (numKindCells[SURFACE_LINES] > 0)
+  {
+    vtkNew<vtkCellArray> newLines;
+    newLines->SetData(offsets[SURFACE_LINES], conns[SURFACE_LINES]);
+    output->SetLines(newLines);
+  }
+  output->Squeeze();
+
+  return true;
+}
+
 //----------------------------------------------------------------------------
 void vtkDataSetSurfaceFilter::InitializeQuadHash(vtkIdType numPoints)
 {
@@ -21,6 +21,15 @@
  * vtkGeometryFilter.  It only has one option: whether to use triangle strips
  * when the input type is structured.
  *
+ * The external faces of unstructured grids are extracted in parallel with
+ * vtkSMPTools: chunks of cells collect their faces, which are then
+ * partitioned by their smallest point id and matched one partition at a
+ * time, and the points, cells and their data are copied in parallel. The
+ * output is the same, and in the same order, as the one of a sequential
+ * traversal. Grids that need nonlinear subdivision, that have Lagrange or
+ * Bezier volumes, or whose attributes have arrays that cannot be copied
+ * concurrently are processed sequentially.
+ *
  * @sa
  * vtkGeometryFilter vtkStructuredGridGeometryFilter.
  */
@@ -35,6 +44,7 @@ class vtkPointData;
 class vtkPoints;
 class vtkIdTypeArray;
 class vtkStructuredGrid;
+class vtkUnstructuredGrid;
 
 // Helper structure for hashing faces.
 struct vtkFastGeomQuadStruct
@@ -253,6 +263,13 @@ protected:
 
   int NonlinearSubdivisionLevel;
 
+  /**
+   * Threaded implementation of UnstructuredGridExecute() for grids that do
+   * not need nonlinear subdivision. Returns false, without modifying the
+   * output, when the input has to be processed sequentially.
+   */
+  bool ThreadedUnstructuredGridExecute(vtkUnstructuredGrid* input, vtkPolyData* output);
+
 private:
   vtkDataSetSurfaceFilter(const vtkDataSetSurfaceFilter&) = delete;
   void operator=(const vtkDataSetSurfaceFilter&) = delete;
@@ -20,7 +20,9 @@
  * a point to get new point data.  This subclass requests a layer of
  * ghost cells to make the results invariant to pieces.  There is a
  * "PieceInvariant" flag that lets the user change the behavior
- * of the filter to that of its superclass.
+ * of the filter to that of its superclass. The averaging itself is done
+ * by the superclass, threaded over the points for unstructured grids and
+ * polydata.
  */
 
 #ifndef vtkPCellDataToPointData_h
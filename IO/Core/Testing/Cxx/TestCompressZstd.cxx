@@ -0,0 +1,66 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCompressZstd.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of vtkZstdDataCompressor
+// .SECTION Description
+//
+
+#include "vtkNew.h"
+#include "vtkZstdDataCompressor.h"
+
+#include <cstring>
+#include <vector>
+
+int TestCompressZstd(int, char*[])
+{
+  const size_t start_size = 100024;
+  std::vector<unsigned char> buffer(start_size);
+  for (size_t cc = 0; cc < start_size; cc++)
+  {
+    buffer[cc] = static_cast<unsigned char>((cc * cc) % 251);
+  }
+  buffer[0] = 'v';
+  buffer[1] = 't';
+  buffer[2] = 'k';
+
+  vtkNew<vtkZstdDataCompressor> compressor;
+  for (int level = 1; level <= 9; level += 4)
+  {
+    compressor->SetCompressionLevel(level);
+    if (compressor->GetCompressionLevel() != level)
+    {
+      cerr << "Compression level " << level << " not restored, got "
+           << compressor->GetCompressionLevel() << endl;
+      return 1;
+    }
+
+    size_t nlen = compressor->GetMaximumCompressionSpace(start_size);
+    std::vector<unsigned char> cbuffer(nlen);
+    size_t rlen = compressor->Compress(buffer.data(), start_size, cbuffer.data(), nlen);
+    if (rlen == 0 || rlen >= start_size)
+    {
+      cerr << "Compression failed at level " << level << endl;
+      return 1;
+    }
+
+    std::vector<unsigned char> ucbuffer(start_size);
+    rlen = compressor->Uncompress(cbuffer.data(), rlen, ucbuffer.data(), start_size);
+    if (rlen != start_size || memcmp(buffer.data(), ucbuffer.data(), start_size) != 0)
+    {
+      cerr << "Uncompressed data differs at level " << level << endl;
+      return 1;
+    }
+  }
+  return 0;
+}
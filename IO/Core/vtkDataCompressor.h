@@ -28,6 +28,15 @@
  * should be implemented with this in mind to provide a predictable
  * compressor interface for vtkDataCompressor users.
  *
+ * @warning
+ * The XML writers and readers compress and uncompress the blocks of an array
+ * in parallel with vtkSMPTools, calling Compress() and Uncompress() on the
+ * same compressor from several threads at once. Subclasses must implement
+ * CompressBuffer() and UncompressBuffer() so that concurrent calls are safe:
+ * they must not modify the state of the compressor, and only read settings
+ * such as the compression level, which are not changed during the calls.
+ * The compressors provided by VTK keep no state between the calls.
+ *
  * @pat Thanks:
  * Homogeneous CompressionLevel behavior contributed by Quincy Wofford
  * (qwofford@lanl.gov) and John Patchett (patchett@lanl.gov)
@@ -105,10 +114,12 @@ protected:
 
   // Actual compression method.  This must be provided by a subclass.
   // Must return the size of the compressed data, or zero on error.
+  // May be called from several threads at once, see the class warning.
   virtual size_t CompressBuffer(unsigned char const* uncompressedData, size_t uncompressedSize,
     unsigned char* compressedData, size_t compressionSpace) = 0;
   // Actual decompression method.  This must be provided by a subclass.
   // Must return the size of the uncompressed data, or zero on error.
+  // May be called from several threads at once, see the class warning.
   virtual size_t UncompressBuffer(unsigned char const* compressedData, size_t compressedSize,
     unsigned char* uncompressedData, size_t uncompressedSize) = 0;
 
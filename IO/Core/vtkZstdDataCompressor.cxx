@@ -0,0 +1,120 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkZstdDataCompressor.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkZstdDataCompressor.h"
+#include "vtkObjectFactory.h"
+#include "vtk_zstd.h"
+
+vtkStandardNewMacro(vtkZstdDataCompressor);
+
+namespace
+{
+// zstd level used for each of the compression levels 1..9.
+const int ZstdLevels[9] = { 1, 2, 3, 4, 6, 9, 12, 16, 19 };
+}
+
+//----------------------------------------------------------------------------
+vtkZstdDataCompressor::vtkZstdDataCompressor()
+{
+  this->ZstdLevel = ZstdLevels[4];
+}
+
+//----------------------------------------------------------------------------
+vtkZstdDataCompressor::~vtkZstdDataCompressor() = default;
+
+//----------------------------------------------------------------------------
+void vtkZstdDataCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "ZstdLevel: " << this->ZstdLevel << endl;
+}
+
+//----------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::CompressBuffer(unsigned char const* uncompressedData,
+  size_t uncompressedSize, unsigned char* compressedData, size_t compressionSpace)
+{
+  // ZSTD_compress() uses its own context, so blocks may be compressed
+  // concurrently with the same compressor.
+  size_t cs = ZSTD_compress(
+    compressedData, compressionSpace, uncompressedData, uncompressedSize, this->ZstdLevel);
+  if (ZSTD_isError(cs))
+  {
+    vtkErrorMacro("Zstd error while compressing data: " << ZSTD_getErrorName(cs));
+    return 0;
+  }
+  return cs;
+}
+
+//----------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::UncompressBuffer(unsigned char const* compressedData,
+  size_t compressedSize, unsigned char* uncompressedData, size_t uncompressedSize)
+{
+  size_t us = ZSTD_decompress(uncompressedData, uncompressedSize, compressedData, compressedSize);
+  if (ZSTD_isError(us))
+  {
+    vtkErrorMacro("Zstd error while uncompressing data: " << ZSTD_getErrorName(us));
+    return 0;
+  }
+  // Make sure the output size matched that expected.
+  if (us != uncompressedSize)
+  {
+    vtkErrorMacro("Decompression produced incorrect size.\n"
+                  "Expected "
+      << uncompressedSize << " and got " << us);
+    return 0;
+  }
+  return us;
+}
+
+//----------------------------------------------------------------------------
+int vtkZstdDataCompressor::GetCompressionLevel()
+{
+  // Return the smallest compression level using at least the zstd level.
+  int compressionLevel = 1;
+  while (compressionLevel < 9 && ZstdLevels[compressionLevel - 1] < this->ZstdLevel)
+  {
+    ++compressionLevel;
+  }
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): returning CompressionLevel "
+                << compressionLevel);
+  return compressionLevel;
+}
+
+//----------------------------------------------------------------------------
+void vtkZstdDataCompressor::SetCompressionLevel(int compressionLevel)
+{
+  int min = 1;
+  int max = 9;
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): setting CompressionLevel to "
+                << compressionLevel);
+  // In order to make an intuitive interface for vtkDataCompressor objects
+  // we accept compressionLevel values 1..9. 1 is fastest, 9 is slowest
+  // 1 is worst compression, 9 is best compression. They are spread over the
+  // zstd levels 1..19, the levels above 19 need much more memory.
+  compressionLevel =
+    compressionLevel < min ? min : (compressionLevel > max ? max : compressionLevel);
+  int level = ZstdLevels[compressionLevel - 1];
+  if (this->ZstdLevel != level)
+  {
+    this->ZstdLevel = level;
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::GetMaximumCompressionSpace(size_t size)
+{
+  return ZSTD_compressBound(size);
+}
@@ -0,0 +1,256 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLegacyASCIIArrays.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Checks that the arrays of ASCII legacy files, which are parsed in
+// parallel, hold exactly the values extracted one at a time by operator>>,
+// and that the values operator>> rejects fail to be read.
+
+#include "vtkDataArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataReader.h"
+#include "vtkSMPTools.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+const char* Separators[] = { " ", "\n", "\t", "  ", "\r\n", " \n" };
+
+// Appends the tokens separated by various whitespaces.
+void AppendTokens(std::ostringstream& text, const std::vector<std::string>& tokens)
+{
+  for (size_t i = 0; i < tokens.size(); ++i)
+  {
+    text << tokens[i] << Separators[i % 6];
+  }
+}
+
+std::vector<std::string> RealTokens(size_t count, std::mt19937_64& random)
+{
+  const char* formats[] = { "%.17g", "%.9g", "%.6g", "%+.3e", "%.4E", "%f" };
+  const char* special[] = { "0", "-0", "+1", "1.", ".5", "007.25", "1e-310", "4.9e-324",
+    "1.17549435e-38", "3.4028234e38", "1e-46", "123456789012345678901234567890" };
+  std::vector<std::string> tokens;
+  char token[64];
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (i % 97 < 12)
+    {
+      tokens.push_back(special[i % 97]);
+      continue;
+    }
+    // Values spread over the whole range of floats.
+    std::uniform_real_distribution<double> mantissa(-10.0, 10.0);
+    std::uniform_int_distribution<int> exponent(-35, 35);
+    double value = mantissa(random) * std::pow(10.0, exponent(random));
+    snprintf(token, sizeof(token), formats[i % 6], value);
+    tokens.push_back(token);
+  }
+  return tokens;
+}
+
+std::vector<std::string> IntegerTokens(size_t count, long long min, long long max,
+  std::mt19937_64& random)
+{
+  std::uniform_int_distribution<long long> distribution(min, max);
+  std::vector<std::string> tokens;
+  for (size_t i = 0; i < count; ++i)
+  {
+    long long value = i % 50 == 0 ? (i % 100 == 0 ? min : max) : distribution(random);
+    std::string token = std::to_string(value);
+    if (i % 7 == 0 && value >= 0)
+    {
+      token = "+" + token;
+    }
+    else if (i % 11 == 0 && value >= 0)
+    {
+      token = "00" + token;
+    }
+    tokens.push_back(token);
+  }
+  return tokens;
+}
+
+// The values extracted one at a time, as read by vtkDataReader::Read().
+template <class T, class ParseType = T>
+std::vector<T> Extract(const std::vector<std::string>& tokens)
+{
+  std::ostringstream text;
+  AppendTokens(text, tokens);
+  std::istringstream stream(text.str());
+  std::vector<T> values;
+  for (size_t i = 0; i < tokens.size(); ++i)
+  {
+    ParseType value;
+    stream >> value;
+    values.push_back(static_cast<T>(value));
+  }
+  return values;
+}
+
+struct ArrayCase
+{
+  std::string Name;
+  std::string Type;
+  std::vector<std::string> Tokens;
+  std::string Expected;
+};
+
+template <class T>
+std::string Bytes(const std::vector<T>& values)
+{
+  return std::string(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+// Reads an unsigned int array with a negative value, which operator>> wraps
+// around when it is in range and rejects otherwise.
+int TestNegativeUnsigned(size_t numPts, std::mt19937_64& random)
+{
+  std::vector<std::string> tokens =
+    IntegerTokens(numPts, 0, std::numeric_limits<unsigned int>::max(), random);
+  int status = EXIT_SUCCESS;
+  vtkObject::GlobalWarningDisplayOff();
+  for (const char* negative : { "-5", "-4294967295", "-99999999999" })
+  {
+    tokens[numPts / 2] = negative;
+    std::istringstream stream(negative);
+    unsigned int expected;
+    const bool valid = static_cast<bool>(stream >> expected);
+
+    std::ostringstream text;
+    text << "# vtk DataFile Version 4.2\nASCII negative\nASCII\nDATASET POLYDATA\n";
+    text << "POINTS " << numPts << " float\n";
+    for (size_t i = 0; i < numPts; ++i)
+    {
+      text << "0 0 0\n";
+    }
+    text << "POINT_DATA " << numPts << "\nFIELD FieldData 1\n";
+    text << "Negative 1 " << numPts << " unsigned_int\n";
+    AppendTokens(text, tokens);
+
+    for (int numThreads : { 1, 4 })
+    {
+      vtkSMPTools::Initialize(numThreads);
+      vtkNew<vtkPolyDataReader> reader;
+      reader->ReadFromInputStringOn();
+      reader->SetInputString(text.str());
+      reader->Update();
+      vtkDataArray* array = reader->GetOutput()->GetPointData()->GetArray("Negative");
+      if (valid != (array != nullptr) ||
+        (array && array->GetTuple1(static_cast<vtkIdType>(numPts / 2)) != expected))
+      {
+        cerr << numThreads << " threads: " << negative << " read differently from operator>>."
+             << endl;
+        status = EXIT_FAILURE;
+      }
+    }
+  }
+  vtkObject::GlobalWarningDisplayOn();
+  return status;
+}
+}
+
+int TestLegacyASCIIArrays(int, char*[])
+{
+  std::mt19937_64 random(42);
+  // Enough values for several chunks.
+  const size_t numPts = 40000;
+  std::vector<std::string> points = RealTokens(3 * numPts, random);
+
+  std::vector<ArrayCase> cases;
+  std::vector<std::string> tokens = RealTokens(numPts, random);
+  cases.push_back({ "Float", "float", tokens, Bytes(Extract<float>(tokens)) });
+  tokens = RealTokens(numPts, random);
+  cases.push_back({ "Double", "double", tokens, Bytes(Extract<double>(tokens)) });
+  tokens = IntegerTokens(numPts, -128, 127, random);
+  cases.push_back({ "Char", "char", tokens, Bytes(Extract<char, int>(tokens)) });
+  tokens = IntegerTokens(numPts, 0, 255, random);
+  cases.push_back(
+    { "UnsignedChar", "unsigned_char", tokens, Bytes(Extract<unsigned char, int>(tokens)) });
+  tokens = IntegerTokens(numPts, -32768, 32767, random);
+  cases.push_back({ "Short", "short", tokens, Bytes(Extract<short>(tokens)) });
+  tokens = IntegerTokens(
+    numPts, std::numeric_limits<int>::min(), std::numeric_limits<int>::max(), random);
+  cases.push_back({ "Int", "int", tokens, Bytes(Extract<int>(tokens)) });
+  tokens = IntegerTokens(numPts, 0, std::numeric_limits<unsigned int>::max(), random);
+  cases.push_back({ "UnsignedInt", "unsigned_int", tokens, Bytes(Extract<unsigned int>(tokens)) });
+  tokens = IntegerTokens(numPts, std::numeric_limits<long long>::min(),
+    std::numeric_limits<long long>::max(), random);
+  cases.push_back(
+    { "Int64", "vtktypeint64", tokens, Bytes(Extract<vtkTypeInt64, long long>(tokens)) });
+  tokens = IntegerTokens(numPts, -1000000, 1000000, random);
+  cases.push_back({ "Ids", "vtkIdType", tokens, Bytes(Extract<vtkIdType, int>(tokens)) });
+
+  std::ostringstream text;
+  text << "# vtk DataFile Version 4.2\nASCII arrays\nASCII\nDATASET POLYDATA\n";
+  text << "POINTS " << numPts << " double\n";
+  AppendTokens(text, points);
+  text << "\nPOINT_DATA " << numPts << "\nFIELD FieldData " << cases.size() << "\n";
+  for (size_t i = 0; i < cases.size(); ++i)
+  {
+    text << cases[i].Name << " 1 " << numPts << " " << cases[i].Type << "\n";
+    AppendTokens(text, cases[i].Tokens);
+    // The last array ends at the end of the file.
+    if (i + 1 < cases.size())
+    {
+      text << "\n";
+    }
+  }
+  std::string file = text.str();
+  file.pop_back();
+
+  const std::string expectedPoints = Bytes(Extract<double>(points));
+  int status = EXIT_SUCCESS;
+  for (int numThreads : { 1, 4 })
+  {
+    vtkSMPTools::Initialize(numThreads);
+    vtkNew<vtkPolyDataReader> reader;
+    reader->ReadFromInputStringOn();
+    reader->SetInputString(file);
+    reader->Update();
+    vtkPolyData* output = reader->GetOutput();
+    vtkDataArray* pointArray = output->GetPoints() ? output->GetPoints()->GetData() : nullptr;
+    if (!pointArray || pointArray->GetNumberOfValues() != static_cast<vtkIdType>(3 * numPts) ||
+      memcmp(pointArray->GetVoidPointer(0), expectedPoints.data(), expectedPoints.size()) != 0)
+    {
+      cerr << numThreads << " threads: points differ." << endl;
+      status = EXIT_FAILURE;
+    }
+    for (const ArrayCase& arrayCase : cases)
+    {
+      vtkDataArray* array = output->GetPointData()->GetArray(arrayCase.Name.c_str());
+      if (!array || array->GetNumberOfValues() != static_cast<vtkIdType>(numPts) ||
+        memcmp(array->GetVoidPointer(0), arrayCase.Expected.data(), arrayCase.Expected.size()) !=
+          0)
+      {
+        cerr << numThreads << " threads: array " << arrayCase.Name << " differs." << endl;
+        status = EXIT_FAILURE;
+      }
+    }
+  }
+  status |= TestNegativeUnsigned(numPts, random);
+  vtkSMPTools::Initialize();
+  return status;
+}
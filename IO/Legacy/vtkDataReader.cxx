@@ -45,6 +45,7 @@
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkShortArray.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
@@ -58,12 +59,19 @@
 #include "vtkUnsignedShortArray.h"
 #include "vtkVariantArray.h"
 
+#include "vtk_doubleconversion.h"
+#include VTK_DOUBLECONVERSION_HEADER(double-conversion.h)
+
 #include "vtksys/FStream.hxx"
 #include <vtksys/SystemTools.hxx>
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <cmath>
+#include <limits>
 #include <sstream>
+#include <type_traits>
 #include <vector>
 
 // I need a safe way to read a line of arbitrary length.  It exists on
@@ -1490,12 +1498,239 @@ int vtkReadBinaryData(istream* IS, T* data, vtkIdType numTuples, vtkIdType numCo
   return 1;
 }
 
+namespace
+{
+// Number of values parsed by a single task of the parallel ASCII reader.
+const vtkIdType vtkASCIIValuesPerChunk = 16384;
+
+// Type parsed by operator>> for a given value type. Characters are read as
+// integers, see vtkDataReader::Read(char*).
+template <class T>
+struct vtkASCIIParseType
+{
+  using Type = T;
+};
+template <>
+struct vtkASCIIParseType<char>
+{
+  using Type = int;
+};
+template <>
+struct vtkASCIIParseType<unsigned char>
+{
+  using Type = int;
+};
+
+inline bool vtkIsASCIISpace(char c)
+{
+  return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// Parses the token [begin, end) as a decimal integer. Only the tokens fully
+// consumed by operator>> without overflow are accepted. Negative unsigned
+// values, which operator>> wraps around or rejects, are left to it.
+template <class V>
+bool vtkParseASCIIToken(const char* begin, const char* end, V& value, std::true_type)
+{
+  bool negative = false;
+  if (*begin == '+' || *begin == '-')
+  {
+    negative = *begin == '-';
+    ++begin;
+  }
+  if (begin == end || (negative && !std::is_signed<V>::value))
+  {
+    return false;
+  }
+  using UV = unsigned long long;
+  UV limit = static_cast<UV>(std::numeric_limits<V>::max());
+  if (negative)
+  {
+    limit = limit + 1;
+  }
+  UV magnitude = 0;
+  for (; begin != end; ++begin)
+  {
+    const UV digit = static_cast<unsigned char>(*begin - '0');
+    if (digit > 9 || magnitude > (limit - digit) / 10)
+    {
+      return false;
+    }
+    magnitude = magnitude * 10 + digit;
+  }
+  value = negative && magnitude ? static_cast<V>(-static_cast<long long>(magnitude - 1) - 1)
+                                : static_cast<V>(magnitude);
+  return true;
+}
+
+// Parses the token [begin, end) as a floating point value. The conversion
+// is correctly rounded, like the one of operator>>, and the tokens this one
+// rejects (overflow, infinity, nan or hexadecimal) are rejected.
+inline bool vtkConvertASCIIToken(
+  const double_conversion::StringToDoubleConverter& converter, const char* begin, int length,
+  float& value, int& processed)
+{
+  value = converter.StringToFloat(begin, length, &processed);
+  return std::isfinite(value);
+}
+
+inline bool vtkConvertASCIIToken(const double_conversion::StringToDoubleConverter& converter,
+  const char* begin, int length, double& value, int& processed)
+{
+  value = converter.StringToDouble(begin, length, &processed);
+  return std::isfinite(value);
+}
+
+template <class V>
+bool vtkParseASCIIToken(const char* begin, const char* end, V& value, std::false_type)
+{
+  for (const char* c = begin; c != end; ++c)
+  {
+    if (!((*c >= '0' && *c <= '9') || *c == '.' || *c == 'e' || *c == 'E' || *c == '+' ||
+          *c == '-'))
+    {
+      return false;
+    }
+  }
+  const double_conversion::StringToDoubleConverter converter(
+    double_conversion::StringToDoubleConverter::NO_FLAGS, 0.0,
+    std::numeric_limits<double>::quiet_NaN(), nullptr, nullptr);
+  const int length = static_cast<int>(end - begin);
+  int processed = 0;
+  return vtkConvertASCIIToken(converter, begin, length, value, processed) && processed == length;
+}
+
+// Reads the next numValues whitespace separated tokens of the stream in
+// memory and parses them in parallel. The stream is left right after the
+// last token, as if the values were extracted one by one. Returns false,
+// with the stream back at its initial position, if the values cannot be
+// parsed exactly like operator>> would, so that the caller can fall back to
+// it.
+template <class T>
+bool vtkReadASCIIDataInParallel(istream* is, T* data, vtkIdType numValues)
+{
+  if (!is || !*is || numValues <= 0)
+  {
+    return false;
+  }
+  const std::streampos start = is->tellg();
+  if (start == std::streampos(-1))
+  {
+    return false;
+  }
+
+  // Read blocks until the end of the last token is found, recording where
+  // each chunk of values begins.
+  std::vector<char> buffer;
+  std::vector<size_t> chunkStarts;
+  const size_t blockSize = static_cast<size_t>(
+    std::min<vtkIdType>(std::max<vtkIdType>(numValues * 8, 4096), 1 << 26));
+  vtkIdType numTokens = 0;
+  bool inToken = false;
+  bool done = false;
+  size_t end = 0;
+  size_t pos = 0;
+  while (!done)
+  {
+    const size_t size = buffer.size();
+    buffer.resize(size + blockSize);
+    is->read(buffer.data() + size, blockSize);
+    const size_t count = static_cast<size_t>(is->gcount());
+    buffer.resize(size + count);
+    for (; pos < buffer.size(); ++pos)
+    {
+      const bool space = vtkIsASCIISpace(buffer[pos]);
+      if (inToken && space)
+      {
+        inToken = false;
+        if (numTokens == numValues)
+        {
+          done = true;
+          end = pos;
+          break;
+        }
+      }
+      else if (!inToken && !space)
+      {
+        inToken = true;
+        if (numTokens % vtkASCIIValuesPerChunk == 0)
+        {
+          chunkStarts.push_back(pos);
+        }
+        ++numTokens;
+      }
+    }
+    if (!done && count < blockSize)
+    {
+      // End of the stream: the last token may end there.
+      done = inToken && numTokens == numValues;
+      end = pos;
+      break;
+    }
+  }
+
+  is->clear();
+  if (!done)
+  {
+    is->seekg(start);
+    return false;
+  }
+
+  std::atomic<bool> failed(false);
+  const char* chars = buffer.data();
+  vtkSMPTools::For(0, static_cast<vtkIdType>(chunkStarts.size()),
+    [&](vtkIdType beginChunk, vtkIdType endChunk) {
+      using ParseType = typename vtkASCIIParseType<T>::Type;
+      for (vtkIdType chunk = beginChunk; chunk < endChunk && !failed; ++chunk)
+      {
+        const vtkIdType first = chunk * vtkASCIIValuesPerChunk;
+        const vtkIdType last = std::min(first + vtkASCIIValuesPerChunk, numValues);
+        const char* c = chars + chunkStarts[chunk];
+        for (vtkIdType i = first; i < last; ++i)
+        {
+          while (vtkIsASCIISpace(*c))
+          {
+            ++c;
+          }
+          const char* tokenBegin = c;
+          while (c != chars + end && !vtkIsASCIISpace(*c))
+          {
+            ++c;
+          }
+          ParseType value;
+          if (!vtkParseASCIIToken(tokenBegin, c, value, std::is_integral<ParseType>()))
+          {
+            failed = true;
+            return;
+          }
+          data[i] = static_cast<T>(value);
+        }
+      }
+    });
+
+  if (failed)
+  {
+    is->seekg(start);
+    return false;
+  }
+  is->seekg(start + static_cast<std::streamoff>(end));
+  return true;
+}
+}
+
 // General templated function to read data of various types.
 template <class T>
 int vtkReadASCIIData(vtkDataReader* self, T* data, vtkIdType numTuples, vtkIdType numComp)
 {
   vtkIdType i, j;
 
+  // Most arrays are parsed in parallel. The values are read one at a time
+  // only when some of them are not plain decimal numbers.
+  if (vtkReadASCIIDataInParallel(self->GetIStream(), data, numTuples * numComp))
+  {
+    return 1;
+  }
+
   for (i = 0; i < numTuples; i++)
   {
     for (j = 0; j < numComp; j++)
@@ -465,7 +465,8 @@ public:
     this->AddOptionValues("HeaderType", &vtkXMLDataObjectWriter::SetHeaderType, "32Bit",
       vtkXMLWriter::UInt32, "64Bit", vtkXMLWriter::UInt64);
     this->AddOptionValues("CompressorType", &vtkXMLDataObjectWriter::SetCompressorType, "NONE",
-      vtkXMLWriter::NONE, "ZLIB", vtkXMLWriter::ZLIB, "LZ4", vtkXMLWriter::LZ4);
+      vtkXMLWriter::NONE, "ZLIB", vtkXMLWriter::ZLIB, "LZ4", vtkXMLWriter::LZ4, "ZSTD",
+      vtkXMLWriter::ZSTD);
     this->AddOptionValues("DataMode", &vtkXMLDataObjectWriter::SetDataMode, "Ascii",
       vtkXMLWriter::Ascii, "Binary", vtkXMLWriter::Binary, "Appended", vtkXMLWriter::Appended);
 
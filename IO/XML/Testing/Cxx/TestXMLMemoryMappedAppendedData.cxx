@@ -0,0 +1,242 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLMemoryMappedAppendedData.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that raw appended arrays memory mapped by the XML readers hold the
+// values written, use the memory of the file in place, and that modifying
+// them does not modify the file. Arrays are only aligned, and then mapped,
+// when the writer is asked to.
+
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkTesting.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkXMLDataElement.h"
+#include "vtkXMLDataParser.h"
+#include "vtkXMLUnstructuredGridReader.h"
+#include "vtkXMLUnstructuredGridWriter.h"
+
+#include <string>
+
+namespace
+{
+bool CompareArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!b || a->GetNumberOfValues() != b->GetNumberOfValues() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType t = 0; t < a->GetNumberOfTuples(); ++t)
+  {
+    for (int c = 0; c < a->GetNumberOfComponents(); ++c)
+    {
+      if (a->GetComponent(t, c) != b->GetComponent(t, c))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid()
+{
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  const int numPts = 1001;
+  for (int i = 0; i < numPts; ++i)
+  {
+    points->InsertNextPoint(i, 0.5 * i, -0.25 * i);
+  }
+  grid->SetPoints(points);
+  for (vtkIdType i = 0; i + 3 < numPts; i += 3)
+  {
+    vtkIdType tet[4] = { i, i + 1, i + 2, i + 3 };
+    grid->InsertNextCell(VTK_TETRA, 4, tet);
+  }
+
+  // A one byte array first, so that the next arrays would not be aligned
+  // without padding.
+  vtkNew<vtkUnsignedCharArray> flags;
+  flags->SetName("Flags");
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkFloatArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  for (int i = 0; i < numPts; ++i)
+  {
+    flags->InsertNextValue(static_cast<unsigned char>(i % 7));
+    scalars->InsertNextValue(i * 0.125);
+    vectors->InsertNextTuple3(i, -i, 2 * i);
+  }
+  grid->GetPointData()->AddArray(flags);
+  grid->GetPointData()->AddArray(scalars);
+  grid->GetPointData()->AddArray(vectors);
+
+  vtkNew<vtkIntArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType i = 0; i < grid->GetNumberOfCells(); ++i)
+  {
+    cellIds->InsertNextValue(static_cast<int>(i));
+  }
+  grid->GetCellData()->AddArray(cellIds);
+  return grid;
+}
+
+vtkTypeInt64 GetOffset(vtkXMLDataElement* element, const char* name)
+{
+  if (element->GetName() && strcmp(element->GetName(), "DataArray") == 0 &&
+    element->GetAttribute("Name") && strcmp(element->GetAttribute("Name"), name) == 0)
+  {
+    vtkTypeInt64 offset = -1;
+    element->GetScalarAttribute("offset", offset);
+    return offset;
+  }
+  for (int i = 0; i < element->GetNumberOfNestedElements(); ++i)
+  {
+    vtkTypeInt64 offset = GetOffset(element->GetNestedElement(i), name);
+    if (offset >= 0)
+    {
+      return offset;
+    }
+  }
+  return -1;
+}
+}
+
+int TestXMLMemoryMappedAppendedData(int argc, char* argv[])
+{
+  vtkNew<vtkTesting> testing;
+  testing->AddArguments(argc, argv);
+  std::string fileName =
+    std::string(testing->GetTempDirectory()) + "/TestXMLMemoryMappedAppendedData.vtu";
+
+  vtkSmartPointer<vtkUnstructuredGrid> grid = MakeGrid();
+  vtkNew<vtkXMLUnstructuredGridWriter> writer;
+  writer->SetInputData(grid);
+  writer->SetFileName(fileName.c_str());
+  writer->SetDataModeToAppended();
+  writer->EncodeAppendedDataOff();
+  writer->SetCompressorTypeToNone();
+
+  // Without alignment, the arrays are contiguous and the misaligned ones
+  // are read instead of mapped.
+  if (!writer->Write())
+  {
+    cerr << "Could not write " << fileName << endl;
+    return EXIT_FAILURE;
+  }
+  {
+    vtkNew<vtkXMLUnstructuredGridReader> reader;
+    reader->SetFileName(fileName.c_str());
+    reader->MemoryMapAppendedDataOn();
+    reader->Update();
+    vtkXMLDataElement* root = reader->GetXMLParser()->GetRootElement();
+    const vtkTypeInt64 headerSize = writer->GetHeaderType() == vtkXMLWriter::UInt64 ? 8 : 4;
+    if (GetOffset(root, "Scalars") !=
+      GetOffset(root, "Flags") + headerSize + grid->GetNumberOfPoints())
+    {
+      cerr << "Unaligned arrays are padded." << endl;
+      return EXIT_FAILURE;
+    }
+    for (const char* name : { "Flags", "Scalars", "Vectors" })
+    {
+      if (!CompareArrays(grid->GetPointData()->GetArray(name),
+            reader->GetOutput()->GetPointData()->GetArray(name)))
+      {
+        cerr << "Unaligned array " << name << " differs." << endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  writer->AlignAppendedDataOn();
+  if (!writer->Write())
+  {
+    cerr << "Could not write " << fileName << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkSmartPointer<vtkUnstructuredGrid> mapped;
+  vtkDataArray* scalars;
+  vtkDataArray* vectors;
+  {
+    vtkNew<vtkXMLUnstructuredGridReader> reader;
+    reader->SetFileName(fileName.c_str());
+    reader->MemoryMapAppendedDataOn();
+    reader->Update();
+    mapped = reader->GetOutput();
+    scalars = mapped->GetPointData()->GetArray("Scalars");
+    vectors = mapped->GetPointData()->GetArray("Vectors");
+    if (!scalars || !vectors)
+    {
+      cerr << "Missing arrays." << endl;
+      return EXIT_FAILURE;
+    }
+
+    // Mapped arrays are at the distance of their offsets in memory.
+    vtkXMLDataElement* root = reader->GetXMLParser()->GetRootElement();
+    vtkTypeInt64 distance = static_cast<char*>(vectors->GetVoidPointer(0)) -
+      static_cast<char*>(scalars->GetVoidPointer(0));
+    if (distance != GetOffset(root, "Vectors") - GetOffset(root, "Scalars"))
+    {
+      cerr << "Arrays are not mapped from the file." << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The mapping outlives the reader.
+  const char* names[] = { "Flags", "Scalars", "Vectors" };
+  for (const char* name : names)
+  {
+    if (!CompareArrays(
+          grid->GetPointData()->GetArray(name), mapped->GetPointData()->GetArray(name)))
+    {
+      cerr << "Mapped array " << name << " differs." << endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (!CompareArrays(grid->GetCellData()->GetArray("CellIds"),
+        mapped->GetCellData()->GetArray("CellIds")) ||
+    !CompareArrays(grid->GetPoints()->GetData(), mapped->GetPoints()->GetData()) ||
+    mapped->GetNumberOfCells() != grid->GetNumberOfCells() ||
+    mapped->GetCellType(0) != VTK_TETRA)
+  {
+    cerr << "Mapped grid differs." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Modifications are private to the mapped arrays.
+  scalars->SetComponent(0, 0, 42.0);
+  vectors->InsertNextTuple3(1, 2, 3);
+  vtkNew<vtkXMLUnstructuredGridReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->Update();
+  if (!CompareArrays(grid->GetPointData()->GetArray("Scalars"),
+        reader->GetOutput()->GetPointData()->GetArray("Scalars")))
+  {
+    cerr << "Modifying a mapped array modified the file." << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
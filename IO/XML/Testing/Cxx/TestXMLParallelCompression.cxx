@@ -0,0 +1,126 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLParallelCompression.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that compressed blocks written and read in parallel give the same
+// file whatever the number of threads and read back the original data.
+
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+#include "vtkXMLReaderVersion.h"
+
+#include <string>
+
+namespace
+{
+std::string Write(vtkImageData* image, int compressor, int dataMode, int numThreads)
+{
+  vtkSMPTools::Initialize(numThreads);
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image);
+  writer->SetCompressorType(compressor);
+  writer->SetDataMode(dataMode);
+  // Small blocks so that there are many blocks per array.
+  writer->SetBlockSize(1024);
+  writer->WriteToOutputStringOn();
+  writer->Write();
+  return writer->GetOutputString();
+}
+
+bool CompareArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!b || a->GetNumberOfValues() != b->GetNumberOfValues())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+  {
+    if (a->GetTuple1(i) != b->GetTuple1(i))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestXMLParallelCompression(int, char*[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(101, 53, 7);
+  const vtkIdType numPts = image->GetNumberOfPoints();
+
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("Values");
+  values->SetNumberOfTuples(numPts);
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("Ids");
+  ids->SetNumberOfTuples(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    values->SetValue(i, (i % 97) * 0.125 - (i % 13));
+    ids->SetValue(i, numPts - i);
+  }
+  image->GetPointData()->AddArray(values);
+  image->GetPointData()->AddArray(ids);
+
+  const int compressors[] = { vtkXMLWriter::ZLIB, vtkXMLWriter::LZ4, vtkXMLWriter::LZMA,
+    vtkXMLWriter::ZSTD };
+  const std::string currentVersion = "version=\"" + std::to_string(vtkXMLReaderMajorVersion) +
+    "." + std::to_string(vtkXMLReaderMinorVersion) + "\"";
+  const int dataModes[] = { vtkXMLWriter::Binary, vtkXMLWriter::Appended };
+  int status = 0;
+  for (int compressor : compressors)
+  {
+    for (int dataMode : dataModes)
+    {
+      std::string serial = Write(image, compressor, dataMode, 1);
+      std::string parallel = Write(image, compressor, dataMode, 4);
+      if (serial != parallel)
+      {
+        cerr << "Compressor " << compressor << ", data mode " << dataMode
+             << ": output depends on the number of threads." << endl;
+        status = 1;
+      }
+      // Only zstd compressed files need the current file version.
+      const bool current = parallel.find(currentVersion) != std::string::npos;
+      if (current != (compressor == vtkXMLWriter::ZSTD))
+      {
+        cerr << "Compressor " << compressor << ", data mode " << dataMode
+             << ": unexpected file version." << endl;
+        status = 1;
+      }
+
+      vtkNew<vtkXMLImageDataReader> reader;
+      reader->ReadFromInputStringOn();
+      reader->SetInputString(parallel);
+      reader->Update();
+      vtkPointData* pd = reader->GetOutput()->GetPointData();
+      if (!CompareArrays(values, pd->GetArray("Values")) ||
+        !CompareArrays(ids, pd->GetArray("Ids")))
+      {
+        cerr << "Compressor " << compressor << ", data mode " << dataMode
+             << ": data read back differs." << endl;
+        status = 1;
+      }
+    }
+  }
+  vtkSMPTools::Initialize();
+  return status;
+}
@@ -482,6 +482,7 @@ vtkDataObject* vtkXMLCompositeDataReader::ReadDataObject(
     return nullptr;
   }
   reader->SetFileName(fileName.c_str());
+  reader->SetMemoryMapAppendedData(this->MemoryMapAppendedData);
   reader->GetPointDataArraySelection()->CopySelections(this->PointDataArraySelection);
   reader->GetCellDataArraySelection()->CopySelections(this->CellDataArraySelection);
   reader->GetColumnArraySelection()->CopySelections(this->ColumnArraySelection);
@@ -532,6 +533,7 @@ void vtkXMLCompositeDataReader::SyncDataArraySelections(
     return;
   }
   reader->SetFileName(fileName.c_str());
+  reader->SetMemoryMapAppendedData(this->MemoryMapAppendedData);
   // initialize array selection so we don't have any residual array selections
   // from previous use of the reader.
   reader->GetPointDataArraySelection()->RemoveAllArrays();
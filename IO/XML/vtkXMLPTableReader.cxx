@@ -557,6 +557,7 @@ int vtkXMLPTableReader::ReadPiece(vtkXMLDataElement* ePiece)
   this->PieceReaders[this->Piece]->AddObserver(
     vtkCommand::ProgressEvent, this->PieceProgressObserver);
   reader->SetFileName(pieceFileName);
+  reader->SetMemoryMapAppendedData(this->MemoryMapAppendedData);
 
   delete[] pieceFileName;
 
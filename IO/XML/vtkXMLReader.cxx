@@ -44,6 +44,7 @@
 #include "vtkXMLFileReadTester.h"
 #include "vtkXMLReaderVersion.h"
 #include "vtkZLibDataCompressor.h"
+#include "vtkZstdDataCompressor.h"
 
 #include "vtksys/Encoding.hxx"
 #include "vtksys/FStream.hxx"
@@ -54,9 +55,131 @@
 #include <cctype>
 #include <functional>
 #include <locale> // C++ locale
+#include <map>
+#include <mutex>
 #include <sstream>
 #include <vector>
 
+#ifdef _WIN32
+#include "vtkWindows.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//-----------------------------------------------------------------------------
+// A file mapped in memory copy-on-write, unmapped on destruction.
+class vtkXMLReaderMappedFile
+{
+public:
+  static std::shared_ptr<vtkXMLReaderMappedFile> Map(const char* fileName)
+  {
+    std::shared_ptr<vtkXMLReaderMappedFile> file(new vtkXMLReaderMappedFile);
+#ifdef _WIN32
+    HANDLE handle = CreateFileW(vtksys::Encoding::ToWide(fileName).c_str(), GENERIC_READ,
+      FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+    {
+      return nullptr;
+    }
+    LARGE_INTEGER size;
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(handle, &size) && size.QuadPart > 0)
+    {
+      mapping = CreateFileMappingW(handle, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    }
+    if (mapping)
+    {
+      file->Data = static_cast<char*>(MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0));
+      file->Length = static_cast<vtkTypeInt64>(size.QuadPart);
+      CloseHandle(mapping);
+    }
+    CloseHandle(handle);
+#else
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0)
+    {
+      return nullptr;
+    }
+    struct stat fs;
+    if (fstat(fd, &fs) == 0 && fs.st_size > 0)
+    {
+      void* data = mmap(
+        nullptr, static_cast<size_t>(fs.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+      if (data != MAP_FAILED)
+      {
+        file->Data = static_cast<char*>(data);
+        file->Length = static_cast<vtkTypeInt64>(fs.st_size);
+      }
+    }
+    close(fd);
+#endif
+    return file->Data ? file : nullptr;
+  }
+
+  ~vtkXMLReaderMappedFile()
+  {
+    if (this->Data)
+    {
+#ifdef _WIN32
+      UnmapViewOfFile(this->Data);
+#else
+      munmap(this->Data, static_cast<size_t>(this->Length));
+#endif
+    }
+  }
+
+  char* Data = nullptr;
+  vtkTypeInt64 Length = 0;
+
+private:
+  vtkXMLReaderMappedFile() = default;
+  vtkXMLReaderMappedFile(const vtkXMLReaderMappedFile&) = delete;
+  void operator=(const vtkXMLReaderMappedFile&) = delete;
+};
+
+namespace
+{
+//-----------------------------------------------------------------------------
+// The mapped files used by the arrays, keyed by the array memory. The free
+// function of the arrays only gets their memory, it uses this table to find
+// the file to release.
+struct vtkXMLMappedArrays
+{
+  std::mutex Mutex;
+  std::multimap<void*, std::shared_ptr<vtkXMLReaderMappedFile> > Files;
+};
+
+vtkXMLMappedArrays& GetMappedArrays()
+{
+  // Never destroyed, so that arrays released at exit can still use it.
+  static vtkXMLMappedArrays* arrays = new vtkXMLMappedArrays;
+  return *arrays;
+}
+
+void FreeMappedArray(void* data)
+{
+  vtkXMLMappedArrays& arrays = GetMappedArrays();
+  std::unique_lock<std::mutex> lock(arrays.Mutex);
+  auto iter = arrays.Files.find(data);
+  if (iter != arrays.Files.end())
+  {
+    arrays.Files.erase(iter);
+  }
+  else if (data)
+  {
+    // Memory allocated by the array after it was mapped, when it is resized
+    // or reallocated: vtkBuffer allocates it with its malloc function, which
+    // is malloc as arrays in extended memory are never mapped, and keeps this
+    // free function.
+    lock.unlock();
+    free(data);
+  }
+}
+}
+
 vtkCxxSetObjectMacro(vtkXMLReader, ReaderErrorObserver, vtkCommand);
 vtkCxxSetObjectMacro(vtkXMLReader, ParserErrorObserver, vtkCommand);
 
@@ -137,6 +260,7 @@ vtkXMLReader::vtkXMLReader()
   this->FileStream = nullptr;
   this->StringStream = nullptr;
   this->ReadFromInputString = 0;
+  this->MemoryMapAppendedData = false;
   this->InputString = "";
   this->XMLParser = nullptr;
   this->ReaderErrorObserver = nullptr;
@@ -233,6 +357,7 @@ void vtkXMLReader::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << indent << "Stream: (none)\n";
   }
+  os << indent << "MemoryMapAppendedData: " << this->MemoryMapAppendedData << "\n";
   os << indent << "TimeStep:" << this->TimeStep << "\n";
   os << indent << "ActiveTimeDataArrayName:"
      << (this->ActiveTimeDataArrayName ? this->ActiveTimeDataArrayName : "(null)") << "\n";
@@ -391,6 +516,8 @@ void vtkXMLReader::CloseVTKFile()
     delete this->FileStream;
     this->FileStream = nullptr;
   }
+  // The mapped arrays keep their own reference to the file.
+  this->MappedFile = nullptr;
 }
 
 //----------------------------------------------------------------------------
@@ -458,6 +585,10 @@ void vtkXMLReader::SetupCompressor(const char* type)
     {
       compressor = vtkLZMADataCompressor::New();
     }
+    else if (strcmp(type, "vtkZstdDataCompressor") == 0)
+    {
+      compressor = vtkZstdDataCompressor::New();
+    }
   }
 
   if (!compressor)
@@ -868,18 +999,23 @@ int vtkXMLReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
     return 0;
   }
   this->InReadData = 1;
-  int result;
-  vtkArrayIterator* iter = array->NewIterator();
-  switch (array->GetDataType())
-  {
-    vtkArrayIteratorTemplateMacro(result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser,
-                                    arrayIndex, static_cast<VTK_TT*>(iter), startIndex, numValues));
-    default:
-      result = 0;
-  }
-  if (iter)
+  int result = 1;
+  if (!this->MemoryMapAppendedData || arrayIndex != 0 || startIndex != 0 ||
+    numValues != array->GetNumberOfValues() || !this->MapArrayValues(da, array))
   {
-    iter->Delete();
+    vtkArrayIterator* iter = array->NewIterator();
+    switch (array->GetDataType())
+    {
+      vtkArrayIteratorTemplateMacro(
+        result = vtkXMLDataReaderReadArrayValues(
+          da, this->XMLParser, arrayIndex, static_cast<VTK_TT*>(iter), startIndex, numValues));
+      default:
+        result = 0;
+    }
+    if (iter)
+    {
+      iter->Delete();
+    }
   }
 
   this->ConvertGhostLevelsToGhostType(fieldType, array, startIndex, numValues);
@@ -895,6 +1031,59 @@ int vtkXMLReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
   return result;
 }
 
+//----------------------------------------------------------------------------
+bool vtkXMLReader::MapArrayValues(vtkXMLDataElement* da, vtkAbstractArray* array)
+{
+  // Only whole AOS arrays read from the file opened by this reader can be
+  // mapped. Arrays in extended memory are not, as the memory they allocate
+  // once mapped would not be released by free() (see FreeMappedArray()).
+  vtkTypeInt64 offset = 0;
+  vtkIdType numValues = array->GetNumberOfValues();
+  if (!this->FileStream || this->Stream != this->FileStream || numValues == 0 ||
+    array->GetArrayType() != vtkAbstractArray::AoSDataArrayTemplate || array->GetIsInMemkind() ||
+    !da->GetScalarAttribute("offset", offset))
+  {
+    return false;
+  }
+
+  // The values must be stored raw in the file, and aligned for their type.
+  vtkTypeInt64 position = this->XMLParser->GetRawAppendedDataPosition(
+    offset, static_cast<size_t>(numValues), array->GetDataType());
+  vtkTypeInt64 wordSize = array->GetDataTypeSize();
+  if (position < 0 || position % wordSize != 0)
+  {
+    return false;
+  }
+
+  if (!this->MappedFile)
+  {
+    this->MappedFile = vtkXMLReaderMappedFile::Map(this->FileName);
+    if (!this->MappedFile)
+    {
+      vtkDebugMacro("Could not map " << this->FileName << ", reading the arrays instead.");
+      return false;
+    }
+  }
+  if (position + numValues * wordSize > this->MappedFile->Length)
+  {
+    return false;
+  }
+
+  void* data = this->MappedFile->Data + position;
+  if (array->GetVoidPointer(0) == data)
+  {
+    return true;
+  }
+  {
+    vtkXMLMappedArrays& arrays = GetMappedArrays();
+    std::lock_guard<std::mutex> lock(arrays.Mutex);
+    arrays.Files.insert(std::make_pair(data, this->MappedFile));
+  }
+  array->SetVoidArray(data, numValues, 0, vtkAbstractArray::VTK_DATA_ARRAY_USER_DEFINED);
+  array->SetArrayFreeFunction(&FreeMappedArray);
+  return true;
+}
+
 //----------------------------------------------------------------------------
 void vtkXMLReader::ReadXMLData()
 {
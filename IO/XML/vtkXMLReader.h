@@ -27,6 +27,7 @@
 #include "vtkAlgorithm.h"
 #include "vtkIOXMLModule.h" // For export macro
 
+#include <memory> // for std::shared_ptr
 #include <string> // for std::string
 #include <vector>
 
@@ -41,6 +42,7 @@ class vtkXMLDataParser;
 class vtkInformationVector;
 class vtkInformation;
 class vtkStringArray;
+class vtkXMLReaderMappedFile;
 
 class VTKIOXML_EXPORT vtkXMLReader : public vtkAlgorithm
 {
@@ -73,6 +75,22 @@ public:
   void SetInputString(const std::string& s) { this->InputString = s; }
   //@}
 
+  //@{
+  /**
+   * When on, the arrays stored in the appended data section of the file
+   * without encoding nor compression (raw appended data), in the byte order
+   * of this machine, are not read but memory mapped from the file. The
+   * arrays then use the pages of the file directly, which are only loaded
+   * when they are accessed, so opening a large file is almost instant.
+   * Modifications of the arrays stay private to the process and are never
+   * written back to the file. Arrays whose values are not aligned in the
+   * file are still read. Only used when reading from a file, off by default.
+   */
+  vtkSetMacro(MemoryMapAppendedData, bool);
+  vtkGetMacro(MemoryMapAppendedData, bool);
+  vtkBooleanMacro(MemoryMapAppendedData, bool);
+  //@}
+
   /**
    * Test whether the file (type) with the given name can be read by this
    * reader. If the file has a newer version than the reader, we still say
@@ -297,6 +315,11 @@ protected:
   virtual int ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex, vtkAbstractArray* array,
     vtkIdType startIndex, vtkIdType numValues, FieldType type = OTHER);
 
+  // Wrap the memory of the file holding all the values of the array
+  // element da into array instead of reading them. Returns false if the
+  // values cannot be used in place, they must then be read.
+  bool MapArrayValues(vtkXMLDataElement* da, vtkAbstractArray* array);
+
   // Setup the data array selections for the input's set of arrays.
   void SetDataArraySelections(vtkXMLDataElement* eDSA, vtkDataArraySelection* sel);
 
@@ -331,6 +354,9 @@ protected:
   // Default is 0: read from file.
   vtkTypeBool ReadFromInputString;
 
+  // Whether raw appended arrays are memory mapped from the file.
+  bool MemoryMapAppendedData;
+
   // The input string.
   std::string InputString;
 
@@ -416,6 +442,8 @@ private:
   istream* FileStream;
   // The stream used to read the input if it is in a string.
   std::istringstream* StringStream;
+  // The file mapped in memory by MapArrayValues() while it is open.
+  std::shared_ptr<vtkXMLReaderMappedFile> MappedFile;
   int TimeStepWasReadOnce;
 
   int FileMajorVersion;
@@ -45,10 +45,13 @@
 #include "vtkOutputStream.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkZLibDataCompressor.h"
+#include "vtkZstdDataCompressor.h"
 #define vtkXMLOffsetsManager_DoNotInclude
 #include "vtkXMLOffsetsManager.h"
 #undef vtkXMLOffsetsManager_DoNotInclude
@@ -68,6 +71,7 @@
 #include <cassert>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #if !defined(_WIN32) || defined(__CYGWIN__)
 #include <unistd.h> /* unlink */
@@ -443,6 +447,16 @@ static int vtkXMLWriterWriteBinaryDataBlocks(vtkXMLWriter* writer,
 } // end anon namespace
 //*****************************************************************************
 
+// Uncompressed blocks of the array being written, compressed in parallel
+// by FlushCompressionBlocks().
+class vtkXMLCompressionBatch
+{
+public:
+  std::vector<unsigned char> Data;
+  std::vector<size_t> Sizes;
+  size_t MaximumNumberOfBlocks = 1;
+};
+
 vtkCxxSetObjectMacro(vtkXMLWriter, Compressor, vtkDataCompressor);
 //----------------------------------------------------------------------------
 vtkXMLWriter::vtkXMLWriter()
@@ -473,10 +487,12 @@ vtkXMLWriter::vtkXMLWriter()
   this->BlockSize = 32768; // 2^15
   this->Compressor = vtkZLibDataCompressor::New();
   this->CompressionHeader = nullptr;
+  this->CompressionBatch = new vtkXMLCompressionBatch;
   this->Int32IdTypeBuffer = nullptr;
   this->ByteSwapBuffer = nullptr;
 
   this->EncodeAppendedData = 1;
+  this->AlignAppendedData = 0;
   this->AppendedDataPosition = 0;
   this->DataMode = vtkXMLWriter::Appended;
   this->ProgressRange[0] = 0;
@@ -509,6 +525,7 @@ vtkXMLWriter::~vtkXMLWriter()
   this->OutStringStream = nullptr;
   delete this->FieldDataOM;
   delete[] this->NumberOfTimeValues;
+  delete this->CompressionBatch;
 }
 
 //----------------------------------------------------------------------------
@@ -553,6 +570,16 @@ void vtkXMLWriter::SetCompressorType(int compressorType)
     this->Compressor->SetCompressionLevel(this->CompressionLevel);
     this->Modified();
   }
+  else if (compressorType == ZSTD)
+  {
+    if (this->Compressor && !this->Compressor->IsTypeOf("vtkZstdDataCompressor"))
+    {
+      this->Compressor->Delete();
+    }
+    this->Compressor = vtkZstdDataCompressor::New();
+    this->Compressor->SetCompressionLevel(this->CompressionLevel);
+    this->Modified();
+  }
   else
   {
     vtkWarningMacro("Invalid compressorType:" << compressorType);
@@ -619,6 +646,7 @@ void vtkXMLWriter::PrintSelf(ostream& os, vtkIndent indent)
     os << indent << "Compressor: (none)\n";
   }
   os << indent << "EncodeAppendedData: " << this->EncodeAppendedData << "\n";
+  os << indent << "AlignAppendedData: " << this->AlignAppendedData << "\n";
   os << indent << "BlockSize: " << this->BlockSize << "\n";
   if (this->Stream)
   {
@@ -995,10 +1023,17 @@ int vtkXMLWriter::WriteInternal()
   return result;
 }
 
+//----------------------------------------------------------------------------
+bool vtkXMLWriter::CompressorNeedsCurrentVersion()
+{
+  // Readers older than version 2.3 do not know the zstd compressor.
+  return this->Compressor && this->Compressor->IsA("vtkZstdDataCompressor");
+}
+
 //----------------------------------------------------------------------------
 int vtkXMLWriter::GetDataSetMajorVersion()
 {
-  if (this->UsePreviousVersion)
+  if (this->UsePreviousVersion && !this->CompressorNeedsCurrentVersion())
   {
     return (this->HeaderType == vtkXMLWriter::UInt64) ? 1 : 0;
   }
@@ -1011,7 +1046,7 @@ int vtkXMLWriter::GetDataSetMajorVersion()
 //----------------------------------------------------------------------------
 int vtkXMLWriter::GetDataSetMinorVersion()
 {
-  if (this->UsePreviousVersion)
+  if (this->UsePreviousVersion && !this->CompressorNeedsCurrentVersion())
   {
     return (this->HeaderType == vtkXMLWriter::UInt64) ? 0 : 1;
   }
@@ -1310,6 +1345,12 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
       result = 0;
     }
 
+    // Compress and write the last blocks.
+    if (result && !this->FlushCompressionBlocks())
+    {
+      result = 0;
+    }
+
     // Finish writing the data.
     if (result && !this->DataStream->EndWriting())
     {
@@ -1666,32 +1707,82 @@ int vtkXMLWriter::CreateCompressionHeader(size_t size)
   // Initialize counter for block writing.
   this->CompressionBlockNumber = 0;
 
+  // Compress enough blocks at once to keep all the threads busy.
+  this->CompressionBatch->MaximumNumberOfBlocks =
+    4 * static_cast<size_t>(vtkSMPTools::GetEstimatedNumberOfThreads());
+  this->CompressionBatch->Data.clear();
+  this->CompressionBatch->Sizes.clear();
+
   return result;
 }
 
 //----------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
 {
-  // Compress the data.
-  vtkUnsignedCharArray* outputArray = this->Compressor->Compress(data, size);
+  // Blocks are independent from each other: queue them and compress a
+  // whole batch in parallel. The data is copied since the caller reuses
+  // its buffer for the next block.
+  vtkXMLCompressionBatch* batch = this->CompressionBatch;
+  batch->Data.insert(batch->Data.end(), data, data + size);
+  batch->Sizes.push_back(size);
+  if (batch->Sizes.size() < batch->MaximumNumberOfBlocks)
+  {
+    return 1;
+  }
+  return this->FlushCompressionBlocks();
+}
 
-  // Find the compressed size.
-  size_t outputSize = outputArray->GetNumberOfTuples();
-  unsigned char* outputPointer = outputArray->GetPointer(0);
+//----------------------------------------------------------------------------
+int vtkXMLWriter::FlushCompressionBlocks()
+{
+  vtkXMLCompressionBatch* batch = this->CompressionBatch;
+  const vtkIdType numBlocks = static_cast<vtkIdType>(batch->Sizes.size());
+  if (numBlocks == 0)
+  {
+    return 1;
+  }
+
+  std::vector<size_t> offsets(numBlocks, 0);
+  for (vtkIdType i = 1; i < numBlocks; ++i)
+  {
+    offsets[i] = offsets[i - 1] + batch->Sizes[i - 1];
+  }
 
-  // Write the compressed data.
-  int result = this->DataStream->Write(outputPointer, outputSize);
+  // Compress the blocks.
+  std::vector<vtkSmartPointer<vtkUnsignedCharArray> > outputArrays(numBlocks);
+  vtkDataCompressor* compressor = this->Compressor;
+  vtkSMPTools::For(0, numBlocks, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      outputArrays[i].TakeReference(
+        compressor->Compress(batch->Data.data() + offsets[i], batch->Sizes[i]));
+    }
+  });
+
+  // Write the compressed data in order and store the resulting
+  // compressed sizes in the compression header.
+  int result = 1;
+  for (vtkIdType i = 0; i < numBlocks && result; ++i)
+  {
+    if (!outputArrays[i])
+    {
+      vtkErrorMacro("Error compressing data block.");
+      result = 0;
+      break;
+    }
+    size_t outputSize = outputArrays[i]->GetNumberOfTuples();
+    result = this->DataStream->Write(outputArrays[i]->GetPointer(0), outputSize);
+    this->CompressionHeader->Set(3 + this->CompressionBlockNumber++, outputSize);
+  }
   this->Stream->flush();
   if (this->Stream->fail())
   {
     this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+    result = 0;
   }
 
-  // Store the resulting compressed size in the compression header.
-  this->CompressionHeader->Set(3 + this->CompressionBlockNumber++, outputSize);
-
-  outputArray->Delete();
-
+  batch->Data.clear();
+  batch->Sizes.clear();
   return result;
 }
 
@@ -2332,6 +2423,22 @@ void vtkXMLWriter::WriteArrayAppended(vtkAbstractArray* a, vtkIndent indent, Off
 void vtkXMLWriter::WriteArrayAppendedData(
   vtkAbstractArray* a, vtkTypeInt64 pos, vtkTypeInt64& lastoffset)
 {
+  if (this->AlignAppendedData && !this->EncodeAppendedData && !this->Compressor)
+  {
+    // Align the raw values for their type in the file, so that readers can
+    // use them in place (see vtkXMLReader::SetMemoryMapAppendedData()).
+    // Offsets are explicit, older readers skip the padding.
+    ostream& os = *(this->Stream);
+    vtkTypeInt64 wordSize =
+      static_cast<vtkTypeInt64>(this->GetOutputWordTypeSize(a->GetDataType()));
+    vtkTypeInt64 headerSize = (this->HeaderType == vtkXMLWriter::UInt64) ? 8 : 4;
+    vtkTypeInt64 misalignment = (static_cast<vtkTypeInt64>(os.tellp()) + headerSize) % wordSize;
+    if (misalignment != 0)
+    {
+      const char padding[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+      os.write(padding, static_cast<std::streamsize>(wordSize - misalignment));
+    }
+  }
   this->WriteAppendedDataOffset(pos, lastoffset, "offset");
   this->WriteBinaryData(a);
 }
@@ -51,6 +51,7 @@ class vtkOutputStream;
 class vtkPointData;
 class vtkPoints;
 class vtkFieldData;
+class vtkXMLCompressionBatch;
 class vtkXMLDataHeader;
 
 class vtkStdString;
@@ -173,7 +174,8 @@ public:
     NONE,
     ZLIB,
     LZ4,
-    LZMA
+    LZMA,
+    ZSTD
   };
 
   //@{
@@ -185,6 +187,7 @@ public:
   void SetCompressorTypeToLZ4() { this->SetCompressorType(LZ4); }
   void SetCompressorTypeToZLib() { this->SetCompressorType(ZLIB); }
   void SetCompressorTypeToLZMA() { this->SetCompressorType(LZMA); }
+  void SetCompressorTypeToZstd() { this->SetCompressorType(ZSTD); }
 
   void SetCompressionLevel(int compressorLevel);
   vtkGetMacro(CompressionLevel, int);
@@ -227,6 +230,20 @@ public:
   vtkBooleanMacro(EncodeAppendedData, vtkTypeBool);
   //@}
 
+  //@{
+  /**
+   * Get/Set whether the arrays of a raw appended data section (neither
+   * encoded nor compressed) are padded so that their values are aligned for
+   * their type in the file. Such arrays can then be memory mapped by the
+   * readers (see vtkXMLReader::SetMemoryMapAppendedData()). The padding is
+   * skipped through the offsets of the arrays, so that older readers still
+   * read these files. The default is off: the arrays are written contiguously.
+   */
+  vtkSetMacro(AlignAppendedData, vtkTypeBool);
+  vtkGetMacro(AlignAppendedData, vtkTypeBool);
+  vtkBooleanMacro(AlignAppendedData, vtkTypeBool);
+  //@}
+
   //@{
   /**
    * Assign a data object as input. Note that this method does not
@@ -308,6 +325,9 @@ protected:
   // Whether to base64-encode the appended data section.
   vtkTypeBool EncodeAppendedData;
 
+  // Whether to align the values of the raw appended arrays in the file.
+  vtkTypeBool AlignAppendedData;
+
   // The stream position at which appended data starts.
   vtkTypeInt64 AppendedDataPosition;
 
@@ -339,6 +359,8 @@ protected:
   size_t CompressionBlockNumber;
   vtkXMLDataHeader* CompressionHeader;
   vtkTypeInt64 CompressionHeaderPosition;
+  // Blocks waiting to be compressed in parallel.
+  vtkXMLCompressionBatch* CompressionBatch;
   // Compression Level for vtkDataCompressor objects
   // 1 (worst compression, fastest) ... 9 (best compression, slowest)
   int CompressionLevel = 5;
@@ -365,6 +387,10 @@ protected:
   virtual int GetDataSetMajorVersion();
   virtual int GetDataSetMinorVersion();
 
+  // Returns true if the compressor cannot be read by the readers of the
+  // previous file versions.
+  bool CompressorNeedsCurrentVersion();
+
   // Utility methods for subclasses.
   vtkDataSet* GetInputAsDataSet();
   virtual int StartFile();
@@ -462,6 +488,7 @@ protected:
   void PerformByteSwap(void* data, size_t numWords, size_t wordSize);
   int CreateCompressionHeader(size_t size);
   int WriteCompressionBlock(unsigned char* data, size_t size);
+  int FlushCompressionBlocks();
   int WriteCompressionHeader();
   size_t GetWordTypeSize(int dataType);
   const char* GetWordTypeName(int dataType);
@@ -21,12 +21,14 @@
 #include "vtkEndian.h"
 #include "vtkInputStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkXMLDataElement.h"
 #define vtkXMLDataHeaderPrivate_DoNotInclude
 #include "vtkXMLDataHeaderPrivate.h"
 #undef vtkXMLDataHeaderPrivate_DoNotInclude
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cctype>
 #include <memory>
@@ -639,6 +641,47 @@ unsigned char* vtkXMLDataParser::ReadBlock(vtkTypeUInt64 block)
   return decompressBuffer;
 }
 
+//----------------------------------------------------------------------------
+// Read the blocks [firstBlock, endBlock) in buffer. The compressed blocks
+// are contiguous in the stream, so they are read at once and then
+// decompressed and byte swapped in parallel.
+int vtkXMLDataParser::ReadBlocks(
+  vtkTypeUInt64 firstBlock, vtkTypeUInt64 endBlock, unsigned char* buffer, size_t wordSize)
+{
+  const vtkTypeInt64 start = this->BlockStartOffsets[firstBlock];
+  const size_t compressedSize = static_cast<size_t>(
+    this->BlockStartOffsets[endBlock - 1] - start + this->BlockCompressedSizes[endBlock - 1]);
+  if (!this->DataStream->Seek(start))
+  {
+    return 0;
+  }
+  std::vector<unsigned char> readBuffer(compressedSize);
+  if (this->DataStream->Read(readBuffer.data(), compressedSize) < compressedSize)
+  {
+    return 0;
+  }
+
+  std::atomic<bool> result(true);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(endBlock - firstBlock), 1,
+    [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        const vtkTypeUInt64 block = firstBlock + i;
+        const size_t uncompressedSize = this->FindBlockSize(block);
+        unsigned char* output = buffer + i * this->BlockUncompressedSize;
+        const unsigned char* input = readBuffer.data() + (this->BlockStartOffsets[block] - start);
+        if (!this->Compressor->Uncompress(
+              input, this->BlockCompressedSizes[block], output, uncompressedSize))
+        {
+          result = false;
+          return;
+        }
+        this->PerformByteSwap(output, uncompressedSize / wordSize, wordSize);
+      }
+    });
+  return result ? 1 : 0;
+}
+
 //----------------------------------------------------------------------------
 size_t vtkXMLDataParser::ReadUncompressedData(
   unsigned char* data, vtkTypeUInt64 startWord, size_t numWords, size_t wordSize)
@@ -811,21 +854,25 @@ size_t vtkXMLDataParser::ReadCompressedData(
     // Report progress.
     this->UpdateProgress(float(outputPointer - data) / length);
 
-    unsigned int currentBlock = firstBlock + 1;
-    for (; currentBlock != lastBlock && !this->Abort; ++currentBlock)
+    // Read the complete blocks in batches large enough to keep all the
+    // threads busy while decompressing.
+    const vtkTypeUInt64 batchSize =
+      4 * static_cast<vtkTypeUInt64>(vtkSMPTools::GetEstimatedNumberOfThreads());
+    vtkTypeUInt64 currentBlock = firstBlock + 1;
+    while (currentBlock < lastBlock && !this->Abort)
     {
-      // Read this block.
-      if (!this->ReadBlock(currentBlock, outputPointer))
+      vtkTypeUInt64 endBlock = std::min(currentBlock + batchSize, lastBlock);
+
+      // Read and byte swap these blocks.  Note that the complete blocks
+      // are always an integer multiple of the word size.
+      if (!this->ReadBlocks(currentBlock, endBlock, outputPointer, wordSize))
       {
         return 0;
       }
 
-      // Byte swap this block.  Note that blockSize will always be an
-      // integer multiple of the word size.
-      this->PerformByteSwap(outputPointer, blockSize / wordSize, wordSize);
-
       // Advance the pointer to the beginning of the next block.
-      outputPointer += this->FindBlockSize(currentBlock);
+      outputPointer += (endBlock - currentBlock) * this->BlockUncompressedSize;
+      currentBlock = endBlock;
 
       // Report progress.
       this->UpdateProgress(float(outputPointer - data) / length);
@@ -973,6 +1020,44 @@ size_t vtkXMLDataParser::ReadAppendedData(
   return this->ReadBinaryData(buffer, startWord, numWords, wordType);
 }
 
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkXMLDataParser::GetRawAppendedDataPosition(
+  vtkTypeInt64 offset, size_t numWords, int wordType)
+{
+#ifdef VTK_WORDS_BIGENDIAN
+  const int nativeByteOrder = vtkXMLDataParser::BigEndian;
+#else
+  const int nativeByteOrder = vtkXMLDataParser::LittleEndian;
+#endif
+  size_t wordSize = this->GetWordTypeSize(wordType);
+  if (this->AppendedDataPosition == 0 || this->Compressor ||
+    this->AppendedDataStream->IsA("vtkBase64InputStream") ||
+    (wordSize > 1 && this->ByteOrder != nativeByteOrder))
+  {
+    return -1;
+  }
+
+  // Read the length of the data.
+  std::unique_ptr<vtkXMLDataHeader> uh(vtkXMLDataHeader::New(this->HeaderType, 1));
+  size_t const headerSize = uh->DataSize();
+  this->DataStream = this->AppendedDataStream;
+  this->SeekG(this->AppendedDataPosition + offset);
+  this->DataStream->SetStream(this->Stream);
+  this->DataStream->StartReading();
+  size_t r = this->DataStream->Read(uh->Data(), headerSize);
+  this->DataStream->EndReading();
+  if (r < headerSize)
+  {
+    return -1;
+  }
+  this->PerformByteSwap(uh->Data(), uh->WordCount(), uh->WordSize());
+  if (uh->Get(0) < static_cast<vtkTypeUInt64>(numWords) * wordSize)
+  {
+    return -1;
+  }
+  return this->AppendedDataPosition + offset + static_cast<vtkTypeInt64>(headerSize);
+}
+
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 // Define a parsing function template.  The extra "long" argument is used
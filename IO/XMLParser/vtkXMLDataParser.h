@@ -81,6 +81,15 @@ public:
     return this->ReadAppendedData(offset, buffer, startWord, numWords, VTK_CHAR);
   }
 
+  /**
+   * Get the position in the input stream of the values of the appended
+   * data starting at the given appended data offset, so that they can be
+   * used in place, e.g. by memory mapping the file. Returns -1 if the
+   * values are encoded, compressed or not in the byte order of this
+   * machine, or if there are less than numWords words of the given type.
+   */
+  vtkTypeInt64 GetRawAppendedDataPosition(vtkTypeInt64 offset, size_t numWords, int wordType);
+
   /**
    * Read from an ascii data section starting at the current position in
    * the stream.  Returns the number of words read.
@@ -186,6 +195,8 @@ protected:
   size_t FindBlockSize(vtkTypeUInt64 block);
   int ReadBlock(vtkTypeUInt64 block, unsigned char* buffer);
   unsigned char* ReadBlock(vtkTypeUInt64 block);
+  int ReadBlocks(
+    vtkTypeUInt64 firstBlock, vtkTypeUInt64 endBlock, unsigned char* buffer, size_t wordSize);
   size_t ReadUncompressedData(
     unsigned char* data, vtkTypeUInt64 startWord, size_t numWords, size_t wordSize);
   size_t ReadCompressedData(
@@ -0,0 +1,332 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataObjectMarshaller.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME TestDataObjectMarshaller.cxx -- Test for vtkDataObjectMarshaller
+//
+// .SECTION Description
+//  Round trips data objects through the binary marshalling used by
+//  vtkCommunicator, both packed and as separate segments.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCharArray.h"
+#include "vtkCommunicator.h"
+#include "vtkDataObjectMarshaller.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkSmartPointer.h"
+#include "vtkStringArray.h"
+#include "vtkTable.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstring>
+
+namespace
+{
+//------------------------------------------------------------------------------
+bool CompareArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b)
+  {
+    return a == b;
+  }
+  if (a->GetDataType() != b->GetDataType() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents() ||
+    a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    (a->GetName() == nullptr) != (b->GetName() == nullptr) ||
+    (a->GetName() && strcmp(a->GetName(), b->GetName()) != 0))
+  {
+    cerr << "Array metadata mismatch for " << (a->GetName() ? a->GetName() : "(null)") << endl;
+    return false;
+  }
+  for (vtkIdType t = 0; t < a->GetNumberOfTuples(); ++t)
+  {
+    for (int c = 0; c < a->GetNumberOfComponents(); ++c)
+    {
+      if (a->GetComponent(t, c) != b->GetComponent(t, c))
+      {
+        cerr << "Array value mismatch for " << (a->GetName() ? a->GetName() : "(null)") << endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool CompareFieldData(vtkFieldData* a, vtkFieldData* b)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+  {
+    cerr << "Number of arrays mismatch." << endl;
+    return false;
+  }
+  for (int i = 0; i < a->GetNumberOfArrays(); ++i)
+  {
+    if (!CompareArrays(a->GetArray(i), b->GetArray(i)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool CompareCells(vtkCellArray* a, vtkCellArray* b)
+{
+  return CompareArrays(a->GetOffsetsArray(), b->GetOffsetsArray()) &&
+    CompareArrays(a->GetConnectivityArray(), b->GetConnectivityArray());
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkPolyData> MakePolyData()
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  const int numPts = 20;
+  for (int i = 0; i < numPts; ++i)
+  {
+    points->InsertNextPoint(i, i * 0.5, -i);
+  }
+
+  vtkNew<vtkCellArray> polys;
+  for (int i = 0; i + 2 < numPts; ++i)
+  {
+    vtkIdType tri[3] = { i, i + 1, i + 2 };
+    polys->InsertNextCell(3, tri);
+  }
+  vtkNew<vtkCellArray> verts;
+  vtkIdType vert = 0;
+  verts->InsertNextCell(1, &vert);
+
+  auto pd = vtkSmartPointer<vtkPolyData>::New();
+  pd->SetPoints(points);
+  pd->SetPolys(polys);
+  pd->SetVerts(verts);
+
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkSOADataArrayTemplate<double> > vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(numPts);
+  vectors->SetComponentName(1, "Y");
+  for (int i = 0; i < numPts; ++i)
+  {
+    scalars->InsertNextValue(i * 1.5f);
+    vectors->SetTuple3(i, i, -i, 2 * i);
+  }
+  pd->GetPointData()->SetScalars(scalars);
+  pd->GetPointData()->AddArray(vectors);
+
+  vtkNew<vtkIntArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType i = 0; i < pd->GetNumberOfCells(); ++i)
+  {
+    cellIds->InsertNextValue(static_cast<int>(i));
+  }
+  pd->GetCellData()->AddArray(cellIds);
+
+  vtkNew<vtkDoubleArray> time;
+  time->SetName("Time");
+  time->InsertNextValue(42.0);
+  pd->GetFieldData()->AddArray(time);
+  return pd;
+}
+
+//------------------------------------------------------------------------------
+bool ComparePolyData(vtkPolyData* a, vtkPolyData* b)
+{
+  if (!b)
+  {
+    cerr << "No poly data." << endl;
+    return false;
+  }
+  if (!CompareArrays(a->GetPoints()->GetData(), b->GetPoints()->GetData()) ||
+    !CompareCells(a->GetPolys(), b->GetPolys()) || !CompareCells(a->GetVerts(), b->GetVerts()) ||
+    !CompareFieldData(a->GetPointData(), b->GetPointData()) ||
+    !CompareFieldData(a->GetCellData(), b->GetCellData()) ||
+    !CompareFieldData(a->GetFieldData(), b->GetFieldData()))
+  {
+    return false;
+  }
+  if (b->GetPointData()->GetScalars() == nullptr ||
+    strcmp(b->GetPointData()->GetScalars()->GetName(), "Scalars") != 0)
+  {
+    cerr << "Active scalars not restored." << endl;
+    return false;
+  }
+  vtkDataArray* vectors = b->GetPointData()->GetArray("Vectors");
+  if (vectors->GetArrayType() != vtkAbstractArray::SoADataArrayTemplate ||
+    !vectors->GetComponentName(1) || strcmp(vectors->GetComponentName(1), "Y") != 0)
+  {
+    cerr << "SOA layout or component names not restored." << endl;
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+int TestPolyData()
+{
+  vtkSmartPointer<vtkPolyData> pd = MakePolyData();
+
+  // Packed form.
+  vtkNew<vtkCharArray> buffer;
+  if (!vtkCommunicator::MarshalDataObject(pd, buffer) ||
+    !vtkDataObjectMarshaller::IsPacked(buffer))
+  {
+    cerr << "Poly data not marshalled in the binary format." << endl;
+    return 1;
+  }
+  vtkSmartPointer<vtkDataObject> dobj = vtkCommunicator::UnMarshalDataObject(buffer);
+  if (!ComparePolyData(pd, vtkPolyData::SafeDownCast(dobj)))
+  {
+    return 1;
+  }
+
+  // Segments, as done by vtkCommunicator::Send() and Receive().
+  vtkDataObjectMarshaller sender;
+  vtkDataObjectMarshaller receiver;
+  if (!sender.Marshal(pd) ||
+    !receiver.Allocate(
+      sender.GetHeader().data(), static_cast<vtkIdType>(sender.GetHeader().size())))
+  {
+    cerr << "Could not marshal poly data." << endl;
+    return 1;
+  }
+  const auto& sent = sender.GetSegments();
+  const auto& received = receiver.GetSegments();
+  if (sent.size() != received.size())
+  {
+    cerr << "Segment count mismatch." << endl;
+    return 1;
+  }
+  for (size_t i = 0; i < sent.size(); ++i)
+  {
+    if (sent[i].DataType != received[i].DataType ||
+      sent[i].NumberOfValues != received[i].NumberOfValues)
+    {
+      cerr << "Segment mismatch." << endl;
+      return 1;
+    }
+    memcpy(received[i].Pointer, sent[i].Pointer,
+      sent[i].NumberOfValues * vtkDataArray::GetDataTypeSize(sent[i].DataType));
+  }
+  return ComparePolyData(pd, vtkPolyData::SafeDownCast(receiver.Finalize())) ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+int TestUnstructuredGrid()
+{
+  vtkNew<vtkUnstructuredGrid> ug;
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(0, 0, 0);
+  points->InsertNextPoint(1, 0, 0);
+  points->InsertNextPoint(0, 1, 0);
+  points->InsertNextPoint(0, 0, 1);
+  points->InsertNextPoint(1, 1, 1);
+  ug->SetPoints(points);
+  vtkIdType tet[4] = { 0, 1, 2, 3 };
+  vtkIdType tri[3] = { 1, 2, 4 };
+  ug->InsertNextCell(VTK_TETRA, 4, tet);
+  ug->InsertNextCell(VTK_TRIANGLE, 3, tri);
+
+  vtkNew<vtkCharArray> buffer;
+  vtkCommunicator::MarshalDataObject(ug, buffer);
+  vtkSmartPointer<vtkDataObject> dobj = vtkCommunicator::UnMarshalDataObject(buffer);
+  auto result = vtkUnstructuredGrid::SafeDownCast(dobj);
+  if (!result || result->GetNumberOfCells() != 2 || result->GetCellType(0) != VTK_TETRA ||
+    result->GetCellType(1) != VTK_TRIANGLE || !CompareCells(ug->GetCells(), result->GetCells()) ||
+    !CompareArrays(ug->GetPoints()->GetData(), result->GetPoints()->GetData()))
+  {
+    cerr << "Unstructured grid round trip failed." << endl;
+    return 1;
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+int TestImageData()
+{
+  vtkNew<vtkImageData> image;
+  image->SetExtent(2, 5, -1, 3, 0, 0);
+  image->SetOrigin(1, 2, 3);
+  image->SetSpacing(0.5, 0.25, 1);
+  image->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+
+  vtkNew<vtkCharArray> buffer;
+  vtkCommunicator::MarshalDataObject(image, buffer);
+  vtkSmartPointer<vtkDataObject> dobj = vtkCommunicator::UnMarshalDataObject(buffer);
+  auto result = vtkImageData::SafeDownCast(dobj);
+  if (!result)
+  {
+    cerr << "Image data round trip failed." << endl;
+    return 1;
+  }
+  const int* extent = result->GetExtent();
+  const double* origin = result->GetOrigin();
+  const double* spacing = result->GetSpacing();
+  if (extent[0] != 2 || extent[3] != 3 || origin[1] != 2 || spacing[1] != 0.25 ||
+    !CompareFieldData(image->GetPointData(), result->GetPointData()))
+  {
+    cerr << "Image data structure not restored." << endl;
+    return 1;
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+int TestLegacyFallback()
+{
+  vtkNew<vtkTable> table;
+  vtkNew<vtkStringArray> names;
+  names->SetName("Names");
+  names->InsertNextValue("a");
+  names->InsertNextValue("b");
+  table->AddColumn(names);
+
+  vtkDataObjectMarshaller marshaller;
+  if (marshaller.Marshal(table))
+  {
+    cerr << "String arrays should not be marshalled in the binary format." << endl;
+    return 1;
+  }
+
+  vtkNew<vtkCharArray> buffer;
+  vtkCommunicator::MarshalDataObject(table, buffer);
+  vtkSmartPointer<vtkDataObject> dobj = vtkCommunicator::UnMarshalDataObject(buffer);
+  auto result = vtkTable::SafeDownCast(dobj);
+  if (!result || result->GetNumberOfRows() != 2)
+  {
+    cerr << "Legacy round trip failed." << endl;
+    return 1;
+  }
+  return 0;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestDataObjectMarshaller(int, char*[])
+{
+  return TestPolyData() || TestUnstructuredGrid() || TestImageData() || TestLegacyFallback();
+}
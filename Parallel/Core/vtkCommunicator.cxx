@@ -17,6 +17,7 @@
 #include "vtkBoundingBox.h"
 #include "vtkCharArray.h"
 #include "vtkCompositeDataSet.h"
+#include "vtkDataObjectMarshaller.h"
 #include "vtkDataObjectTypes.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkDataSetReader.h"
@@ -210,14 +211,45 @@ int vtkCommunicator::Send(vtkDataObject* data, int remoteHandle, int tag)
 //----------------------------------------------------------------------------
 int vtkCommunicator::SendElementalDataObject(vtkDataObject* data, int remoteHandle, int tag)
 {
-  VTK_CREATE(vtkCharArray, buffer);
-  if (vtkCommunicator::MarshalDataObject(data, buffer))
+  // Data objects supported by vtkDataObjectMarshaller are sent as a header
+  // followed by the raw memory of their arrays, without intermediate copy.
+  // The other ones are sent as a legacy file.
+  vtkDataObjectMarshaller marshaller;
+  int binary = marshaller.Marshal(data) ? 1 : 0;
+  if (!this->Send(&binary, 1, remoteHandle, tag))
   {
-    return this->Send(buffer, remoteHandle, tag);
+    return 0;
   }
 
-  // could not marshal data
-  return 0;
+  if (!binary)
+  {
+    VTK_CREATE(vtkCharArray, buffer);
+    if (vtkCommunicator::MarshalDataObject(data, buffer))
+    {
+      return this->Send(buffer, remoteHandle, tag);
+    }
+
+    // could not marshal data
+    return 0;
+  }
+
+  const std::vector<unsigned char>& header = marshaller.GetHeader();
+  vtkIdType headerSize = static_cast<vtkIdType>(header.size());
+  if (!this->Send(&headerSize, 1, remoteHandle, tag) ||
+    !this->Send(header.data(), headerSize, remoteHandle, tag))
+  {
+    return 0;
+  }
+  for (const auto& segment : marshaller.GetSegments())
+  {
+    if (segment.NumberOfValues > 0 &&
+      !this->SendVoidArray(
+        segment.Pointer, segment.NumberOfValues, segment.DataType, remoteHandle, tag))
+    {
+      return 0;
+    }
+  }
+  return 1;
 }
 
 //----------------------------------------------------------------------------
@@ -403,13 +435,58 @@ int vtkCommunicator::ReceiveDataObject(vtkDataObject* data, int remoteHandle, in
 //----------------------------------------------------------------------------
 int vtkCommunicator::ReceiveElementalDataObject(vtkDataObject* data, int remoteHandle, int tag)
 {
-  VTK_CREATE(vtkCharArray, buffer);
-  if (!this->Receive(buffer, remoteHandle, tag))
+  int binary = 0;
+  if (!this->Receive(&binary, 1, remoteHandle, tag))
+  {
+    return 0;
+  }
+
+  if (!binary)
+  {
+    VTK_CREATE(vtkCharArray, buffer);
+    if (!this->Receive(buffer, remoteHandle, tag))
+    {
+      return 0;
+    }
+
+    return vtkCommunicator::UnMarshalDataObject(buffer, data);
+  }
+
+  vtkIdType headerSize = 0;
+  if (!this->Receive(&headerSize, 1, remoteHandle, tag) || headerSize <= 0)
+  {
+    return 0;
+  }
+  std::vector<unsigned char> header(headerSize);
+  if (!this->Receive(header.data(), headerSize, remoteHandle, tag))
   {
     return 0;
   }
 
-  return vtkCommunicator::UnMarshalDataObject(buffer, data);
+  // The arrays are received in place and adopted by the data object.
+  vtkDataObjectMarshaller marshaller;
+  if (!marshaller.Allocate(header.data(), headerSize))
+  {
+    vtkErrorMacro("Invalid data object header received.");
+    return 0;
+  }
+  for (const auto& segment : marshaller.GetSegments())
+  {
+    if (segment.NumberOfValues > 0 &&
+      !this->ReceiveVoidArray(
+        segment.Pointer, segment.NumberOfValues, segment.DataType, remoteHandle, tag))
+    {
+      return 0;
+    }
+  }
+
+  vtkSmartPointer<vtkDataObject> dobj = marshaller.Finalize();
+  if (!dobj->IsA(data->GetClassName()))
+  {
+    vtkWarningMacro("Type mismatch while receiving data.");
+  }
+  data->ShallowCopy(dobj);
+  return 1;
 }
 
 int vtkCommunicator::Receive(vtkDataArray* data, int remoteHandle, int tag)
@@ -511,6 +588,13 @@ int vtkCommunicator::MarshalDataObject(vtkDataObject* object, vtkCharArray* buff
     return 1;
   }
 
+  vtkDataObjectMarshaller marshaller;
+  if (marshaller.Marshal(object))
+  {
+    return marshaller.Pack(buffer) ? 1 : 0;
+  }
+
+  // Fall back to the legacy file format for the other data objects.
   VTK_CREATE(vtkGenericDataObjectWriter, writer);
 
   vtkSmartPointer<vtkDataObject> copy;
@@ -606,6 +690,12 @@ vtkSmartPointer<vtkDataObject> vtkCommunicator::UnMarshalDataObject(vtkCharArray
     return nullptr;
   }
 
+  if (vtkDataObjectMarshaller::IsPacked(buffer))
+  {
+    vtkDataObjectMarshaller marshaller;
+    return marshaller.Unpack(buffer);
+  }
+
   // You would think that the extent information would be properly saved, but
   // no, it is not.
   int extent[6] = { 0, 0, 0, 0, 0, 0 };
@@ -1265,6 +1265,8 @@ public:
   /**
    * Convert a data object into a string that can be transmitted and vice versa.
    * Returns 1 for success and 0 for failure.
+   * The data objects supported by vtkDataObjectMarshaller are converted to
+   * its binary format, the other ones are written in the legacy file format.
    * WARNING: This will only work for types that have a vtkDataWriter class.
    */
   static int MarshalDataObject(vtkDataObject* object, vtkCharArray* buffer);
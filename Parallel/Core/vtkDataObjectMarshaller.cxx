@@ -0,0 +1,801 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDataObjectMarshaller.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDataObjectMarshaller.h"
+
+#include "vtkByteSwap.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCharArray.h"
+#include "vtkDataObjectTypes.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkEndian.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkMatrix3x3.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkStructuredGrid.h"
+#include "vtkTable.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstring>
+#include <string>
+
+// Layout of the header, written with vtkMultiProcessStream:
+//
+//   int version, int data object type, bool big endian,
+//   structure of the data object (see WriteStructure()),
+//   field data, then point data and cell data for data sets.
+//
+// Each array is described by its data type, layout, number of components,
+// number of tuples, name and component names. Its raw memory is appended to
+// the segments: one segment for AOS arrays, one per component for SOA
+// arrays. Readers and writers traverse the data object in the same order
+// so that the segments match on both sides.
+//
+// The packed form is made of an 8 bytes magic string, the header size as a
+// little endian 64 bits integer, the header and then the segments. The
+// header and each segment are padded to 8 bytes so that the segments stay
+// aligned in the buffer.
+
+namespace
+{
+const int vtkMarshallerVersion = 1;
+const char vtkMarshallerMagic[8] = { 'v', 't', 'k', 'B', 'I', 'N', '0', '1' };
+const vtkIdType vtkMarshallerAlignment = 8;
+
+enum ArrayLayout
+{
+  AOS_LAYOUT = 0,
+  SOA_LAYOUT = 1
+};
+
+//----------------------------------------------------------------------------
+vtkIdType Align(vtkIdType size)
+{
+  return (size + vtkMarshallerAlignment - 1) / vtkMarshallerAlignment * vtkMarshallerAlignment;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType GetSegmentSize(const vtkDataObjectMarshaller::Segment& segment)
+{
+  return segment.NumberOfValues * vtkDataArray::GetDataTypeSize(segment.DataType);
+}
+
+//----------------------------------------------------------------------------
+template <typename T>
+void AddComponentSegments(
+  vtkDataArray* array, std::vector<vtkDataObjectMarshaller::Segment>& segments)
+{
+  auto soa = static_cast<vtkSOADataArrayTemplate<T>*>(array);
+  for (int c = 0; c < soa->GetNumberOfComponents(); ++c)
+  {
+    segments.push_back(
+      { soa->GetComponentArrayPointer(c), soa->GetNumberOfTuples(), soa->GetDataType() });
+  }
+}
+
+//----------------------------------------------------------------------------
+template <typename T>
+vtkDataArray* NewSOAArray(T*)
+{
+  return vtkSOADataArrayTemplate<T>::New();
+}
+
+//============================================================================
+class Writer
+{
+public:
+  vtkMultiProcessStream Stream;
+  std::vector<vtkDataObjectMarshaller::Segment>& Segments;
+  std::vector<vtkSmartPointer<vtkAbstractArray> >& Arrays;
+
+  Writer(std::vector<vtkDataObjectMarshaller::Segment>& segments,
+    std::vector<vtkSmartPointer<vtkAbstractArray> >& arrays)
+    : Segments(segments)
+    , Arrays(arrays)
+  {
+  }
+
+  //--------------------------------------------------------------------------
+  bool WriteArray(vtkAbstractArray* abstractArray)
+  {
+    vtkDataArray* array = vtkDataArray::SafeDownCast(abstractArray);
+    if (!array || array->GetDataType() == VTK_BIT)
+    {
+      return false;
+    }
+
+    int layout;
+    switch (array->GetArrayType())
+    {
+      case vtkAbstractArray::AoSDataArrayTemplate:
+        layout = AOS_LAYOUT;
+        break;
+      case vtkAbstractArray::SoADataArrayTemplate:
+        layout = SOA_LAYOUT;
+        break;
+      default:
+        return false;
+    }
+
+    const int numComps = array->GetNumberOfComponents();
+    const vtkIdType numTuples = array->GetNumberOfTuples();
+    this->Stream << array->GetDataType() << layout << numComps
+                 << static_cast<vtkTypeInt64>(numTuples);
+
+    const char* name = array->GetName();
+    this->Stream << (name != nullptr) << std::string(name ? name : "");
+    const bool hasComponentNames = array->HasAComponentName();
+    this->Stream << hasComponentNames;
+    if (hasComponentNames)
+    {
+      for (int c = 0; c < numComps; ++c)
+      {
+        const char* componentName = array->GetComponentName(c);
+        this->Stream << (componentName != nullptr)
+                     << std::string(componentName ? componentName : "");
+      }
+    }
+
+    if (layout == AOS_LAYOUT)
+    {
+      this->Segments.push_back(
+        { array->GetVoidPointer(0), numTuples * numComps, array->GetDataType() });
+    }
+    else
+    {
+      switch (array->GetDataType())
+      {
+        vtkTemplateMacro(AddComponentSegments<VTK_TT>(array, this->Segments));
+        default:
+          return false;
+      }
+    }
+    this->Arrays.push_back(array);
+    return true;
+  }
+
+  //--------------------------------------------------------------------------
+  bool WriteOptionalArray(vtkAbstractArray* array)
+  {
+    this->Stream << (array != nullptr);
+    return !array || this->WriteArray(array);
+  }
+
+  //--------------------------------------------------------------------------
+  bool WritePoints(vtkPoints* points)
+  {
+    return this->WriteOptionalArray(points ? points->GetData() : nullptr);
+  }
+
+  //--------------------------------------------------------------------------
+  bool WriteCells(vtkCellArray* cells)
+  {
+    this->Stream << (cells != nullptr);
+    return !cells ||
+      (this->WriteArray(cells->GetOffsetsArray()) &&
+        this->WriteArray(cells->GetConnectivityArray()));
+  }
+
+  //--------------------------------------------------------------------------
+  bool WriteExtent(const int extent[6])
+  {
+    for (int i = 0; i < 6; ++i)
+    {
+      this->Stream << extent[i];
+    }
+    return true;
+  }
+
+  //--------------------------------------------------------------------------
+  bool WriteFieldData(vtkFieldData* fd)
+  {
+    const int numArrays = fd ? fd->GetNumberOfArrays() : 0;
+    this->Stream << numArrays;
+    for (int i = 0; i < numArrays; ++i)
+    {
+      if (!this->WriteArray(fd->GetAbstractArray(i)))
+      {
+        return false;
+      }
+    }
+
+    vtkDataSetAttributes* dsa = vtkDataSetAttributes::SafeDownCast(fd);
+    this->Stream << (dsa != nullptr);
+    if (dsa)
+    {
+      int indices[vtkDataSetAttributes::NUM_ATTRIBUTES];
+      dsa->GetAttributeIndices(indices);
+      for (int i = 0; i < vtkDataSetAttributes::NUM_ATTRIBUTES; ++i)
+      {
+        this->Stream << indices[i];
+      }
+    }
+    return true;
+  }
+
+  //--------------------------------------------------------------------------
+  bool WriteStructure(vtkDataObject* object)
+  {
+    if (vtkImageData* image = vtkImageData::SafeDownCast(object))
+    {
+      this->WriteExtent(image->GetExtent());
+      const double* origin = image->GetOrigin();
+      const double* spacing = image->GetSpacing();
+      const double* direction = image->GetDirectionMatrix()->GetData();
+      for (int i = 0; i < 3; ++i)
+      {
+        this->Stream << origin[i] << spacing[i];
+      }
+      for (int i = 0; i < 9; ++i)
+      {
+        this->Stream << direction[i];
+      }
+      return true;
+    }
+    if (vtkRectilinearGrid* rg = vtkRectilinearGrid::SafeDownCast(object))
+    {
+      return this->WriteExtent(rg->GetExtent()) &&
+        this->WriteOptionalArray(rg->GetXCoordinates()) &&
+        this->WriteOptionalArray(rg->GetYCoordinates()) &&
+        this->WriteOptionalArray(rg->GetZCoordinates());
+    }
+    if (vtkStructuredGrid* sg = vtkStructuredGrid::SafeDownCast(object))
+    {
+      return this->WriteExtent(sg->GetExtent()) && this->WritePoints(sg->GetPoints());
+    }
+    if (vtkPolyData* pd = vtkPolyData::SafeDownCast(object))
+    {
+      return this->WritePoints(pd->GetPoints()) && this->WriteCells(pd->GetVerts()) &&
+        this->WriteCells(pd->GetLines()) && this->WriteCells(pd->GetPolys()) &&
+        this->WriteCells(pd->GetStrips());
+    }
+    if (vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(object))
+    {
+      return this->WritePoints(ug->GetPoints()) &&
+        this->WriteOptionalArray(ug->GetCellTypesArray()) && this->WriteCells(ug->GetCells()) &&
+        this->WriteOptionalArray(ug->GetFaceLocations()) &&
+        this->WriteOptionalArray(ug->GetFaces());
+    }
+    if (vtkTable* table = vtkTable::SafeDownCast(object))
+    {
+      return this->WriteFieldData(table->GetRowData());
+    }
+    return false;
+  }
+};
+
+//============================================================================
+class Reader
+{
+public:
+  vtkMultiProcessStream Stream;
+  std::vector<vtkDataObjectMarshaller::Segment>& Segments;
+  std::vector<vtkSmartPointer<vtkAbstractArray> >& Arrays;
+
+  Reader(std::vector<vtkDataObjectMarshaller::Segment>& segments,
+    std::vector<vtkSmartPointer<vtkAbstractArray> >& arrays)
+    : Segments(segments)
+    , Arrays(arrays)
+  {
+  }
+
+  //--------------------------------------------------------------------------
+  // cellStorage creates the array types used by vtkCellArray so that the
+  // arrays are used without being copied.
+  vtkSmartPointer<vtkDataArray> ReadArray(bool cellStorage = false)
+  {
+    int dataType, layout, numComps;
+    vtkTypeInt64 numTuples;
+    bool hasName, hasComponentNames;
+    std::string name;
+    this->Stream >> dataType >> layout >> numComps >> numTuples >> hasName >> name >>
+      hasComponentNames;
+
+    vtkSmartPointer<vtkDataArray> array;
+    if (layout == SOA_LAYOUT)
+    {
+      switch (dataType)
+      {
+        vtkTemplateMacro(array.TakeReference(NewSOAArray(static_cast<VTK_TT*>(nullptr))));
+      }
+    }
+    else if (cellStorage && vtkDataArray::GetDataTypeSize(dataType) == 4)
+    {
+      array = vtkSmartPointer<vtkCellArray::ArrayType32>::New();
+    }
+    else if (cellStorage && vtkDataArray::GetDataTypeSize(dataType) == 8)
+    {
+      array = vtkSmartPointer<vtkCellArray::ArrayType64>::New();
+    }
+    else
+    {
+      array.TakeReference(vtkDataArray::CreateDataArray(dataType));
+    }
+    if (!array || array->GetDataType() != dataType || numComps < 1 || numTuples < 0)
+    {
+      return nullptr;
+    }
+
+    array->SetNumberOfComponents(numComps);
+    array->SetNumberOfTuples(static_cast<vtkIdType>(numTuples));
+    if (hasName)
+    {
+      array->SetName(name.c_str());
+    }
+    if (hasComponentNames)
+    {
+      for (int c = 0; c < numComps; ++c)
+      {
+        bool hasComponentName;
+        std::string componentName;
+        this->Stream >> hasComponentName >> componentName;
+        if (hasComponentName)
+        {
+          array->SetComponentName(c, componentName.c_str());
+        }
+      }
+    }
+
+    if (layout == SOA_LAYOUT)
+    {
+      switch (dataType)
+      {
+        vtkTemplateMacro(AddComponentSegments<VTK_TT>(array, this->Segments));
+      }
+    }
+    else
+    {
+      this->Segments.push_back(
+        { array->GetVoidPointer(0), static_cast<vtkIdType>(numTuples) * numComps, dataType });
+    }
+    this->Arrays.push_back(array);
+    return array;
+  }
+
+  //--------------------------------------------------------------------------
+  bool ReadOptionalArray(vtkSmartPointer<vtkDataArray>& array)
+  {
+    bool present;
+    this->Stream >> present;
+    if (present)
+    {
+      array = this->ReadArray();
+      return array != nullptr;
+    }
+    array = nullptr;
+    return true;
+  }
+
+  //--------------------------------------------------------------------------
+  bool ReadPoints(vtkPointSet* ps)
+  {
+    vtkSmartPointer<vtkDataArray> data;
+    if (!this->ReadOptionalArray(data))
+    {
+      return false;
+    }
+    if (data)
+    {
+      if (data->GetNumberOfComponents() != 3)
+      {
+        return false;
+      }
+      vtkNew<vtkPoints> points;
+      points->SetData(data);
+      ps->SetPoints(points);
+    }
+    return true;
+  }
+
+  //--------------------------------------------------------------------------
+  bool ReadCells(vtkSmartPointer<vtkCellArray>& cells)
+  {
+    bool present;
+    this->Stream >> present;
+    cells = nullptr;
+    if (!present)
+    {
+      return true;
+    }
+    vtkSmartPointer<vtkDataArray> offsets = this->ReadArray(true);
+    vtkSmartPointer<vtkDataArray> connectivity = offsets ? this->ReadArray(true) : nullptr;
+    if (!connectivity || offsets->GetDataType() != connectivity->GetDataType())
+    {
+      return false;
+    }
+    cells = vtkSmartPointer<vtkCellArray>::New();
+    if (auto offsets32 = vtkArrayDownCast<vtkCellArray::ArrayType32>(offsets))
+    {
+      cells->SetData(offsets32, vtkArrayDownCast<vtkCellArray::ArrayType32>(connectivity));
+    }
+    else
+    {
+      cells->SetData(vtkArrayDownCast<vtkCellArray::ArrayType64>(offsets),
+        vtkArrayDownCast<vtkCellArray::ArrayType64>(connectivity));
+    }
+    return true;
+  }
+
+  //--------------------------------------------------------------------------
+  void ReadExtent(int extent[6])
+  {
+    for (int i = 0; i < 6; ++i)
+    {
+      this->Stream >> extent[i];
+    }
+  }
+
+  //--------------------------------------------------------------------------
+  bool ReadFieldData(vtkFieldData* fd)
+  {
+    int numArrays;
+    this->Stream >> numArrays;
+    for (int i = 0; i < numArrays; ++i)
+    {
+      vtkSmartPointer<vtkDataArray> array = this->ReadArray();
+      if (!array)
+      {
+        return false;
+      }
+      fd->AddArray(array);
+    }
+
+    bool isAttributes;
+    this->Stream >> isAttributes;
+    if (isAttributes)
+    {
+      vtkDataSetAttributes* dsa = vtkDataSetAttributes::SafeDownCast(fd);
+      for (int i = 0; i < vtkDataSetAttributes::NUM_ATTRIBUTES; ++i)
+      {
+        int index;
+        this->Stream >> index;
+        if (dsa && index >= 0)
+        {
+          dsa->SetActiveAttribute(index, i);
+        }
+      }
+    }
+    return true;
+  }
+
+  //--------------------------------------------------------------------------
+  bool ReadStructure(vtkDataObject* object)
+  {
+    if (vtkImageData* image = vtkImageData::SafeDownCast(object))
+    {
+      int extent[6];
+      double origin[3], spacing[3], direction[9];
+      this->ReadExtent(extent);
+      for (int i = 0; i < 3; ++i)
+      {
+        this->Stream >> origin[i] >> spacing[i];
+      }
+      for (int i = 0; i < 9; ++i)
+      {
+        this->Stream >> direction[i];
+      }
+      image->SetExtent(extent);
+      image->SetOrigin(origin);
+      image->SetSpacing(spacing);
+      image->SetDirectionMatrix(direction);
+      return true;
+    }
+    if (vtkRectilinearGrid* rg = vtkRectilinearGrid::SafeDownCast(object))
+    {
+      int extent[6];
+      this->ReadExtent(extent);
+      vtkSmartPointer<vtkDataArray> x, y, z;
+      if (!this->ReadOptionalArray(x) || !this->ReadOptionalArray(y) ||
+        !this->ReadOptionalArray(z))
+      {
+        return false;
+      }
+      rg->SetExtent(extent);
+      rg->SetXCoordinates(x);
+      rg->SetYCoordinates(y);
+      rg->SetZCoordinates(z);
+      return true;
+    }
+    if (vtkStructuredGrid* sg = vtkStructuredGrid::SafeDownCast(object))
+    {
+      int extent[6];
+      this->ReadExtent(extent);
+      sg->SetExtent(extent);
+      return this->ReadPoints(sg);
+    }
+    if (vtkPolyData* pd = vtkPolyData::SafeDownCast(object))
+    {
+      vtkSmartPointer<vtkCellArray> verts, lines, polys, strips;
+      if (!this->ReadPoints(pd) || !this->ReadCells(verts) || !this->ReadCells(lines) ||
+        !this->ReadCells(polys) || !this->ReadCells(strips))
+      {
+        return false;
+      }
+      pd->SetVerts(verts);
+      pd->SetLines(lines);
+      pd->SetPolys(polys);
+      pd->SetStrips(strips);
+      return true;
+    }
+    if (vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(object))
+    {
+      vtkSmartPointer<vtkDataArray> types, faceLocations, faces;
+      vtkSmartPointer<vtkCellArray> cells;
+      if (!this->ReadPoints(ug) || !this->ReadOptionalArray(types) || !this->ReadCells(cells) ||
+        !this->ReadOptionalArray(faceLocations) || !this->ReadOptionalArray(faces))
+      {
+        return false;
+      }
+      if (cells && types)
+      {
+        ug->SetCells(vtkArrayDownCast<vtkUnsignedCharArray>(types), cells,
+          vtkArrayDownCast<vtkIdTypeArray>(faceLocations), vtkArrayDownCast<vtkIdTypeArray>(faces));
+      }
+      return true;
+    }
+    if (vtkTable* table = vtkTable::SafeDownCast(object))
+    {
+      return this->ReadFieldData(table->GetRowData());
+    }
+    return false;
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+vtkDataObjectMarshaller::vtkDataObjectMarshaller()
+  : SwapBytes(false)
+{
+}
+
+//----------------------------------------------------------------------------
+vtkDataObjectMarshaller::~vtkDataObjectMarshaller() = default;
+
+//----------------------------------------------------------------------------
+void vtkDataObjectMarshaller::Reset()
+{
+  this->Object = nullptr;
+  this->Header.clear();
+  this->Segments.clear();
+  this->Arrays.clear();
+  this->SwapBytes = false;
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataObjectMarshaller::Marshal(vtkDataObject* object)
+{
+  this->Reset();
+  if (!object)
+  {
+    return false;
+  }
+
+  switch (object->GetDataObjectType())
+  {
+    case VTK_IMAGE_DATA:
+    case VTK_STRUCTURED_POINTS:
+    case VTK_RECTILINEAR_GRID:
+    case VTK_STRUCTURED_GRID:
+    case VTK_POLY_DATA:
+    case VTK_UNSTRUCTURED_GRID:
+    case VTK_TABLE:
+      break;
+    default:
+      return false;
+  }
+
+  Writer writer(this->Segments, this->Arrays);
+#ifdef VTK_WORDS_BIGENDIAN
+  const bool bigEndian = true;
+#else
+  const bool bigEndian = false;
+#endif
+  writer.Stream << vtkMarshallerVersion << object->GetDataObjectType() << bigEndian;
+
+  bool status = writer.WriteStructure(object) && writer.WriteFieldData(object->GetFieldData());
+  if (status)
+  {
+    if (vtkDataSet* ds = vtkDataSet::SafeDownCast(object))
+    {
+      status =
+        writer.WriteFieldData(ds->GetPointData()) && writer.WriteFieldData(ds->GetCellData());
+    }
+  }
+  if (!status)
+  {
+    this->Reset();
+    return false;
+  }
+
+  writer.Stream.GetRawData(this->Header);
+  this->Object = object;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataObjectMarshaller::Allocate(const unsigned char* header, vtkIdType size)
+{
+  this->Reset();
+  if (!header || size <= 0)
+  {
+    return false;
+  }
+  this->Header.assign(header, header + size);
+
+  Reader reader(this->Segments, this->Arrays);
+  reader.Stream.SetRawData(header, static_cast<unsigned int>(size));
+
+  int version, type;
+  bool bigEndian;
+  reader.Stream >> version >> type >> bigEndian;
+  if (version != vtkMarshallerVersion)
+  {
+    this->Reset();
+    return false;
+  }
+#ifdef VTK_WORDS_BIGENDIAN
+  this->SwapBytes = !bigEndian;
+#else
+  this->SwapBytes = bigEndian;
+#endif
+
+  vtkSmartPointer<vtkDataObject> object;
+  object.TakeReference(vtkDataObjectTypes::NewDataObject(type));
+  bool status =
+    object && reader.ReadStructure(object) && reader.ReadFieldData(object->GetFieldData());
+  if (status)
+  {
+    if (vtkDataSet* ds = vtkDataSet::SafeDownCast(object))
+    {
+      status = reader.ReadFieldData(ds->GetPointData()) && reader.ReadFieldData(ds->GetCellData());
+    }
+  }
+  if (!status)
+  {
+    this->Reset();
+    return false;
+  }
+
+  this->Object = object;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkDataObjectMarshaller::Finalize()
+{
+  if (this->SwapBytes)
+  {
+    for (const Segment& segment : this->Segments)
+    {
+      const int wordSize = vtkDataArray::GetDataTypeSize(segment.DataType);
+      if (wordSize > 1)
+      {
+        vtkByteSwap::SwapVoidRange(segment.Pointer, segment.NumberOfValues, wordSize);
+      }
+    }
+  }
+  // The memory of the arrays was written directly.
+  for (auto& array : this->Arrays)
+  {
+    array->DataChanged();
+  }
+
+  vtkSmartPointer<vtkDataObject> object = this->Object;
+  this->Reset();
+  return object;
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataObjectMarshaller::Pack(vtkCharArray* buffer) const
+{
+  if (!buffer || this->Header.empty())
+  {
+    return false;
+  }
+
+  const vtkIdType headerSize = static_cast<vtkIdType>(this->Header.size());
+  vtkIdType size = sizeof(vtkMarshallerMagic) + 8 + Align(headerSize);
+  for (const Segment& segment : this->Segments)
+  {
+    size += Align(GetSegmentSize(segment));
+  }
+
+  buffer->Initialize();
+  buffer->SetNumberOfComponents(1);
+  buffer->SetNumberOfTuples(size);
+  char* data = buffer->GetPointer(0);
+  memset(data, 0, size);
+
+  memcpy(data, vtkMarshallerMagic, sizeof(vtkMarshallerMagic));
+  data += sizeof(vtkMarshallerMagic);
+  vtkTypeUInt64 encodedSize = static_cast<vtkTypeUInt64>(headerSize);
+  for (int i = 0; i < 8; ++i)
+  {
+    data[i] = static_cast<char>((encodedSize >> (8 * i)) & 0xff);
+  }
+  data += 8;
+  memcpy(data, this->Header.data(), headerSize);
+  data += Align(headerSize);
+
+  for (const Segment& segment : this->Segments)
+  {
+    const vtkIdType segmentSize = GetSegmentSize(segment);
+    if (segmentSize > 0)
+    {
+      memcpy(data, segment.Pointer, segmentSize);
+    }
+    data += Align(segmentSize);
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataObjectMarshaller::IsPacked(vtkCharArray* buffer)
+{
+  return buffer &&
+    buffer->GetNumberOfValues() >= static_cast<vtkIdType>(sizeof(vtkMarshallerMagic)) + 8 &&
+    memcmp(buffer->GetPointer(0), vtkMarshallerMagic, sizeof(vtkMarshallerMagic)) == 0;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkDataObjectMarshaller::Unpack(vtkCharArray* buffer)
+{
+  if (!vtkDataObjectMarshaller::IsPacked(buffer))
+  {
+    return nullptr;
+  }
+
+  const char* data = buffer->GetPointer(0);
+  const vtkIdType bufferSize = buffer->GetNumberOfValues();
+  vtkIdType offset = sizeof(vtkMarshallerMagic);
+  vtkTypeUInt64 headerSize = 0;
+  for (int i = 0; i < 8; ++i)
+  {
+    headerSize |= static_cast<vtkTypeUInt64>(static_cast<unsigned char>(data[offset + i]))
+      << (8 * i);
+  }
+  offset += 8;
+  if (headerSize > static_cast<vtkTypeUInt64>(bufferSize - offset) ||
+    !this->Allocate(reinterpret_cast<const unsigned char*>(data + offset),
+      static_cast<vtkIdType>(headerSize)))
+  {
+    return nullptr;
+  }
+  offset += Align(static_cast<vtkIdType>(headerSize));
+
+  for (const Segment& segment : this->Segments)
+  {
+    const vtkIdType segmentSize = GetSegmentSize(segment);
+    if (offset + segmentSize > bufferSize)
+    {
+      this->Reset();
+      return nullptr;
+    }
+    if (segmentSize > 0)
+    {
+      memcpy(segment.Pointer, data + offset, segmentSize);
+    }
+    offset += Align(segmentSize);
+  }
+  return this->Finalize();
+}
@@ -0,0 +1,135 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDataObjectMarshaller.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkDataObjectMarshaller
+ * @brief   binary wire format for the data objects sent by vtkCommunicator
+ *
+ * vtkDataObjectMarshaller describes a data object as a small header, which
+ * holds the structure of the data object and the layout of its arrays, and
+ * a list of segments pointing to the raw memory of these arrays (AOS
+ * buffers, SOA component buffers, cell array offsets and connectivity).
+ * The segments can be sent as they are, without being copied into an
+ * intermediate buffer.
+ *
+ * On the receiving side, Allocate() creates the data object and its arrays
+ * from the header. The segments then point to the memory of these arrays,
+ * so the data can be received in place. Finalize() returns the data object
+ * once all the segments have been received.
+ *
+ * Pack() and Unpack() convert to and from a single contiguous buffer for
+ * the operations that need one (vtkCommunicator::MarshalDataObject(),
+ * collective operations).
+ *
+ * Only vtkImageData, vtkStructuredPoints, vtkRectilinearGrid,
+ * vtkStructuredGrid, vtkPolyData, vtkUnstructuredGrid and vtkTable whose
+ * arrays are all AOS or SOA data arrays can be marshalled. Marshal()
+ * returns false for the other data objects, vtkCommunicator then falls
+ * back to the legacy file format.
+ *
+ * @sa
+ * vtkCommunicator vtkMultiProcessStream
+ */
+
+#ifndef vtkDataObjectMarshaller_h
+#define vtkDataObjectMarshaller_h
+
+#include "vtkParallelCoreModule.h" // For export macro
+#include "vtkSmartPointer.h"       // For vtkSmartPointer
+#include "vtkType.h"               // For vtkIdType
+#include "vtkWrappingHints.h"      // For VTK_WRAPEXCLUDE
+
+#include <vector> // For std::vector
+
+class vtkAbstractArray;
+class vtkCharArray;
+class vtkDataObject;
+
+class VTKPARALLELCORE_EXPORT VTK_WRAPEXCLUDE vtkDataObjectMarshaller
+{
+public:
+  vtkDataObjectMarshaller();
+  ~vtkDataObjectMarshaller();
+
+  /**
+   * Raw memory of an array, NumberOfValues values of type DataType.
+   */
+  struct Segment
+  {
+    void* Pointer;
+    vtkIdType NumberOfValues;
+    int DataType;
+  };
+
+  /**
+   * Describe object. The segments point to the memory of the arrays of
+   * object, which is kept referenced until Reset() is called.
+   * Returns false if object cannot be marshalled.
+   */
+  bool Marshal(vtkDataObject* object);
+
+  /**
+   * Create the data object described by header and allocate its arrays.
+   * The segments then point to the memory that must be filled before
+   * calling Finalize(). Returns false if the header is invalid.
+   */
+  bool Allocate(const unsigned char* header, vtkIdType size);
+
+  /**
+   * Return the data object created by Allocate(), once its segments have
+   * been filled.
+   */
+  vtkSmartPointer<vtkDataObject> Finalize();
+
+  /**
+   * Header and segments of the marshalled or allocated data object.
+   */
+  const std::vector<unsigned char>& GetHeader() const { return this->Header; }
+  const std::vector<Segment>& GetSegments() const { return this->Segments; }
+
+  /**
+   * Copy the header and the segments of the marshalled data object in a
+   * single contiguous buffer.
+   */
+  bool Pack(vtkCharArray* buffer) const;
+
+  /**
+   * Returns true if buffer was produced by Pack().
+   */
+  static bool IsPacked(vtkCharArray* buffer);
+
+  /**
+   * Create the data object packed in buffer. The data is copied out of
+   * buffer. Returns nullptr if buffer is invalid.
+   */
+  vtkSmartPointer<vtkDataObject> Unpack(vtkCharArray* buffer);
+
+  /**
+   * Release the data object and the arrays referenced by the marshaller.
+   */
+  void Reset();
+
+private:
+  vtkDataObjectMarshaller(const vtkDataObjectMarshaller&) = delete;
+  void operator=(const vtkDataObjectMarshaller&) = delete;
+
+  vtkSmartPointer<vtkDataObject> Object;
+  std::vector<unsigned char> Header;
+  std::vector<Segment> Segments;
+  std::vector<vtkSmartPointer<vtkAbstractArray> > Arrays;
+  bool SwapBytes;
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkDataObjectMarshaller.h
@@ -0,0 +1,561 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPTestUtilities.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkSMPTestUtilities
+ * @brief   Utility functions used to test threaded filters.
+ *
+ * vtkSMPTestUtilities provides the methods shared by the tests checking that
+ * the threaded implementation of a filter gives exactly the output of its
+ * sequential one: running a test with several numbers of threads, building
+ * inputs with cells of all dimensions, forcing the sequential path with an
+ * array that cannot be copied concurrently, and comparing arrays, cells,
+ * attributes and whole outputs.
+ */
+
+#ifndef vtkSMPTestUtilities_h
+#define vtkSMPTestUtilities_h
+
+#include "vtkBitArray.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+struct vtkSMPTestUtilities
+{
+  /**
+   * Run the test, a callable taking the number of threads and returning a
+   * non zero status on failure, with 1 then 4 threads. The default number
+   * of threads is restored afterwards. Returns the combined status.
+   */
+  template <typename TestT>
+  static int RunWithThreads(TestT&& test);
+
+  /**
+   * The double precision points of a slightly distorted lattice of res^3
+   * cubes, numbered along x first, followed by an unused point.
+   */
+  static inline vtkSmartPointer<vtkPoints> MakeLatticePoints(int res);
+
+  /**
+   * An unstructured grid on MakeLatticePoints(res) with hexahedra,
+   * tetrahedra, and quads, lines and vertices on some of their points.
+   */
+  static inline vtkSmartPointer<vtkUnstructuredGrid> MakeMixedGrid(int res);
+
+  /**
+   * A polydata on the given lattice points, as made by MakeLatticePoints(res),
+   * with triangles, quads, lines and vertices in the layer k of the lattice.
+   */
+  static inline vtkSmartPointer<vtkPolyData> MakeMixedPolyData(vtkPoints* points, int res, int k);
+
+  /**
+   * Add to the attributes a bit array with numTuples tuples. Filters do not
+   * copy bit arrays concurrently, so they take their sequential path. The
+   * array is ignored by CompareAttributes().
+   */
+  static inline void AddSequentialArray(vtkDataSetAttributes* attributes, vtkIdType numTuples);
+
+  /**
+   * The name of the array added by AddSequentialArray().
+   */
+  static const char* GetSequentialArrayName() { return "Bits"; }
+
+  /**
+   * Whether both arrays exist and have the same type, number of components
+   * and values. The values of arrays of the standard memory layout must be
+   * equal bit for bit, so that signed zeros differ.
+   */
+  static inline bool CompareArrays(vtkAbstractArray* a, vtkAbstractArray* b);
+
+  /**
+   * Whether the array exists and has the expected values, component by
+   * component, within the given relative tolerance. NaN values only match
+   * NaN values. Reports the first value that differs on cerr.
+   */
+  static inline bool CompareValues(
+    vtkDataArray* array, const std::vector<double>& expected, double tolerance = 0.0);
+
+  /**
+   * Whether both cell arrays hold the same cells, in the same order.
+   */
+  static inline bool CompareCells(vtkCellArray* a, vtkCellArray* b);
+
+  /**
+   * Whether both attributes have the same arrays, looked up by name in both
+   * directions, and the same active attributes. Unnamed arrays are compared
+   * in order. The array added by AddSequentialArray() is ignored. Reports
+   * what differs on cerr.
+   */
+  static inline bool CompareAttributes(vtkDataSetAttributes* a, vtkDataSetAttributes* b);
+
+  //@{
+  /**
+   * Whether both outputs have the same points, cells, point data and cell
+   * data. Reports what differs on cerr.
+   */
+  static inline bool CompareOutputs(vtkPolyData* a, vtkPolyData* b);
+  static inline bool CompareOutputs(vtkUnstructuredGrid* a, vtkUnstructuredGrid* b);
+  //@}
+
+  /**
+   * Whether both outputs have the same type and are the same as compared by
+   * the methods above. Other datasets are compared by their number of points
+   * and cells and their attributes.
+   */
+  static inline bool CompareOutputs(vtkDataSet* a, vtkDataSet* b);
+
+  /**
+   * Records the outputs of a test run with one thread by RunWithThreads(),
+   * and checks that the runs with more threads give the same outputs, in the
+   * same order.
+   */
+  class OutputRecorder
+  {
+  public:
+    /**
+     * With one thread, stores a copy of the output and returns true.
+     * Otherwise, compares the output with CompareOutputs() against the one
+     * checked at the same position with one thread.
+     */
+    inline bool Check(vtkDataSet* output, int numThreads);
+
+  private:
+    std::vector<vtkSmartPointer<vtkDataSet>> Outputs;
+    int NumThreads = 0;
+    size_t Next = 0;
+  };
+
+private:
+  static vtkIdType LatticeId(int res, int i, int j, int k)
+  {
+    return i + (res + 1) * (j + (res + 1) * k);
+  }
+  static inline bool ComparePoints(vtkPoints* a, vtkPoints* b);
+  static inline bool CompareIds(vtkIdList* a, vtkIdList* b);
+  static inline bool IsCompared(vtkAbstractArray* array);
+};
+
+template <typename TestT>
+int vtkSMPTestUtilities::RunWithThreads(TestT&& test)
+{
+  int status = 0;
+  for (int numThreads : { 1, 4 })
+  {
+    vtkSMPTools::Initialize(numThreads);
+    status |= test(numThreads);
+  }
+  vtkSMPTools::Initialize();
+  return status;
+}
+
+inline vtkSmartPointer<vtkPoints> vtkSMPTestUtilities::MakeLatticePoints(int res)
+{
+  auto points = vtkSmartPointer<vtkPoints>::New();
+  points->SetDataTypeToDouble();
+  for (int k = 0; k <= res; ++k)
+  {
+    for (int j = 0; j <= res; ++j)
+    {
+      for (int i = 0; i <= res; ++i)
+      {
+        points->InsertNextPoint(i + 0.1 * std::sin(j + k), j + 0.1 * std::cos(i * k), k);
+      }
+    }
+  }
+  points->InsertNextPoint(-1, -1, -1);
+  return points;
+}
+
+inline vtkSmartPointer<vtkUnstructuredGrid> vtkSMPTestUtilities::MakeMixedGrid(int res)
+{
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(vtkSMPTestUtilities::MakeLatticePoints(res));
+  grid->Allocate();
+  for (int k = 0; k < res; ++k)
+  {
+    for (int j = 0; j < res; ++j)
+    {
+      for (int i = 0; i < res; ++i)
+      {
+        const vtkIdType h[8] = { LatticeId(res, i, j, k), LatticeId(res, i + 1, j, k),
+          LatticeId(res, i + 1, j + 1, k), LatticeId(res, i, j + 1, k),
+          LatticeId(res, i, j, k + 1), LatticeId(res, i + 1, j, k + 1),
+          LatticeId(res, i + 1, j + 1, k + 1), LatticeId(res, i, j + 1, k + 1) };
+        switch ((i + 2 * j + 3 * k) % 5)
+        {
+          case 0:
+          {
+            const vtkIdType tet[4] = { h[0], h[1], h[3], h[4] };
+            grid->InsertNextCell(VTK_TETRA, 4, tet);
+            break;
+          }
+          case 1:
+            grid->InsertNextCell(VTK_QUAD, 4, h);
+            grid->InsertNextCell(VTK_LINE, 2, h + 4);
+            break;
+          case 2:
+            grid->InsertNextCell(VTK_VERTEX, 1, h + 6);
+            grid->InsertNextCell(VTK_HEXAHEDRON, 8, h);
+            break;
+          default:
+            grid->InsertNextCell(VTK_HEXAHEDRON, 8, h);
+            break;
+        }
+      }
+    }
+  }
+  return grid;
+}
+
+inline vtkSmartPointer<vtkPolyData> vtkSMPTestUtilities::MakeMixedPolyData(
+  vtkPoints* points, int res, int k)
+{
+  auto polyData = vtkSmartPointer<vtkPolyData>::New();
+  polyData->SetPoints(points);
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkCellArray> polys;
+  for (int j = 0; j < res; ++j)
+  {
+    for (int i = 0; i < res; ++i)
+    {
+      const vtkIdType q[4] = { LatticeId(res, i, j, k), LatticeId(res, i + 1, j, k),
+        LatticeId(res, i + 1, j + 1, k), LatticeId(res, i, j + 1, k) };
+      switch ((i + 2 * j) % 4)
+      {
+        case 0:
+          polys->InsertNextCell(3, q);
+          break;
+        case 1:
+          lines->InsertNextCell(2, q + 1);
+          polys->InsertNextCell(4, q);
+          break;
+        case 2:
+          verts->InsertNextCell(1, q + 2);
+          break;
+        default:
+          polys->InsertNextCell(4, q);
+          break;
+      }
+    }
+  }
+  polyData->SetVerts(verts);
+  polyData->SetLines(lines);
+  polyData->SetPolys(polys);
+  return polyData;
+}
+
+inline void vtkSMPTestUtilities::AddSequentialArray(
+  vtkDataSetAttributes* attributes, vtkIdType numTuples)
+{
+  vtkNew<vtkBitArray> bits;
+  bits->SetName(vtkSMPTestUtilities::GetSequentialArrayName());
+  bits->SetNumberOfTuples(numTuples);
+  attributes->AddArray(bits);
+}
+
+inline bool vtkSMPTestUtilities::CompareArrays(vtkAbstractArray* a, vtkAbstractArray* b)
+{
+  if (!a || !b || a->GetDataType() != b->GetDataType() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents() ||
+    a->GetNumberOfValues() != b->GetNumberOfValues())
+  {
+    return false;
+  }
+  if (vtkArrayDownCast<vtkDataArray>(a) && vtkArrayDownCast<vtkDataArray>(b) &&
+    a->GetDataType() != VTK_BIT && a->HasStandardMemoryLayout() && b->HasStandardMemoryLayout())
+  {
+    return a->GetNumberOfValues() == 0 ||
+      memcmp(a->GetVoidPointer(0), b->GetVoidPointer(0),
+        static_cast<size_t>(a->GetNumberOfValues()) * a->GetDataTypeSize()) == 0;
+  }
+  for (vtkIdType v = 0; v < a->GetNumberOfValues(); ++v)
+  {
+    if (a->GetVariantValue(v) != b->GetVariantValue(v))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+inline bool vtkSMPTestUtilities::CompareValues(
+  vtkDataArray* array, const std::vector<double>& expected, double tolerance)
+{
+  if (!array || array->GetNumberOfValues() != static_cast<vtkIdType>(expected.size()))
+  {
+    cerr << "Found " << (array ? array->GetNumberOfValues() : 0) << " values instead of "
+         << expected.size() << "." << endl;
+    return false;
+  }
+  const int numComps = array->GetNumberOfComponents();
+  for (vtkIdType v = 0; v < array->GetNumberOfValues(); ++v)
+  {
+    const double value = array->GetComponent(v / numComps, v % numComps);
+    if (std::isnan(expected[v]) ? !std::isnan(value)
+                                : std::abs(value - expected[v]) > tolerance * (1 + std::abs(value)))
+    {
+      cerr << "Value " << v << " is " << value << " instead of " << expected[v] << "." << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+inline bool vtkSMPTestUtilities::CompareIds(vtkIdList* a, vtkIdList* b)
+{
+  return a->GetNumberOfIds() == b->GetNumberOfIds() &&
+    std::equal(a->GetPointer(0), a->GetPointer(0) + a->GetNumberOfIds(), b->GetPointer(0));
+}
+
+inline bool vtkSMPTestUtilities::CompareCells(vtkCellArray* a, vtkCellArray* b)
+{
+  if (a->GetNumberOfCells() != b->GetNumberOfCells())
+  {
+    return false;
+  }
+  vtkNew<vtkIdList> aIds;
+  vtkNew<vtkIdList> bIds;
+  for (vtkIdType cellId = 0; cellId < a->GetNumberOfCells(); ++cellId)
+  {
+    a->GetCellAtId(cellId, aIds);
+    b->GetCellAtId(cellId, bIds);
+    if (!vtkSMPTestUtilities::CompareIds(aIds, bIds))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+inline bool vtkSMPTestUtilities::IsCompared(vtkAbstractArray* array)
+{
+  return !array->GetName() ||
+    strcmp(array->GetName(), vtkSMPTestUtilities::GetSequentialArrayName()) != 0;
+}
+
+inline bool vtkSMPTestUtilities::CompareAttributes(
+  vtkDataSetAttributes* a, vtkDataSetAttributes* b)
+{
+  vtkDataSetAttributes* sides[2] = { a, b };
+  int numArrays[2] = { 0, 0 };
+  std::vector<vtkAbstractArray*> unnamed[2];
+  for (int side = 0; side < 2; ++side)
+  {
+    vtkDataSetAttributes* attributes = sides[side];
+    vtkDataSetAttributes* other = sides[1 - side];
+    for (int i = 0; i < attributes->GetNumberOfArrays(); ++i)
+    {
+      vtkAbstractArray* array = attributes->GetAbstractArray(i);
+      if (!vtkSMPTestUtilities::IsCompared(array))
+      {
+        continue;
+      }
+      const char* name = array->GetName();
+      if (!name)
+      {
+        unnamed[side].push_back(array);
+        continue;
+      }
+      ++numArrays[side];
+      if (!other->GetAbstractArray(name))
+      {
+        cerr << "Array " << name << " is missing from the " << (side == 0 ? "second" : "first")
+             << " attributes." << endl;
+        return false;
+      }
+      if (side == 0 && !vtkSMPTestUtilities::CompareArrays(array, other->GetAbstractArray(name)))
+      {
+        cerr << "Array " << name << " differs." << endl;
+        return false;
+      }
+    }
+  }
+  if (numArrays[0] != numArrays[1] || unnamed[0].size() != unnamed[1].size())
+  {
+    cerr << "Found " << numArrays[1] << " named and " << unnamed[1].size()
+         << " unnamed arrays instead of " << numArrays[0] << " and " << unnamed[0].size() << "."
+         << endl;
+    return false;
+  }
+  for (size_t i = 0; i < unnamed[0].size(); ++i)
+  {
+    if (!vtkSMPTestUtilities::CompareArrays(unnamed[0][i], unnamed[1][i]))
+    {
+      cerr << "Unnamed array " << i << " differs." << endl;
+      return false;
+    }
+  }
+  for (int attribute = 0; attribute < vtkDataSetAttributes::NUM_ATTRIBUTES; ++attribute)
+  {
+    vtkAbstractArray* aArray = a->GetAbstractAttribute(attribute);
+    vtkAbstractArray* bArray = b->GetAbstractAttribute(attribute);
+    if ((aArray == nullptr) != (bArray == nullptr) ||
+      (aArray && aArray->GetName() && bArray->GetName() &&
+        strcmp(aArray->GetName(), bArray->GetName()) != 0))
+    {
+      cerr << "Active " << vtkDataSetAttributes::GetAttributeTypeAsString(attribute)
+           << " differ." << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+inline bool vtkSMPTestUtilities::ComparePoints(vtkPoints* a, vtkPoints* b)
+{
+  if (!a || !b)
+  {
+    return a == b;
+  }
+  return vtkSMPTestUtilities::CompareArrays(a->GetData(), b->GetData());
+}
+
+inline bool vtkSMPTestUtilities::CompareOutputs(vtkPolyData* a, vtkPolyData* b)
+{
+  if (!vtkSMPTestUtilities::ComparePoints(a->GetPoints(), b->GetPoints()))
+  {
+    cerr << "Found " << b->GetNumberOfPoints() << " points instead of " << a->GetNumberOfPoints()
+         << ", or different ones." << endl;
+    return false;
+  }
+  if (!vtkSMPTestUtilities::CompareCells(a->GetVerts(), b->GetVerts()) ||
+    !vtkSMPTestUtilities::CompareCells(a->GetLines(), b->GetLines()) ||
+    !vtkSMPTestUtilities::CompareCells(a->GetPolys(), b->GetPolys()) ||
+    !vtkSMPTestUtilities::CompareCells(a->GetStrips(), b->GetStrips()))
+  {
+    cerr << "Found " << b->GetNumberOfCells() << " cells instead of " << a->GetNumberOfCells()
+         << ", or different ones." << endl;
+    return false;
+  }
+  return vtkSMPTestUtilities::CompareAttributes(a->GetPointData(), b->GetPointData()) &&
+    vtkSMPTestUtilities::CompareAttributes(a->GetCellData(), b->GetCellData());
+}
+
+inline bool vtkSMPTestUtilities::CompareOutputs(vtkUnstructuredGrid* a, vtkUnstructuredGrid* b)
+{
+  if (!vtkSMPTestUtilities::ComparePoints(a->GetPoints(), b->GetPoints()))
+  {
+    cerr << "Found " << b->GetNumberOfPoints() << " points instead of " << a->GetNumberOfPoints()
+         << ", or different ones." << endl;
+    return false;
+  }
+  if (a->GetNumberOfCells() != b->GetNumberOfCells())
+  {
+    cerr << "Found " << b->GetNumberOfCells() << " cells instead of " << a->GetNumberOfCells()
+         << "." << endl;
+    return false;
+  }
+  vtkNew<vtkIdList> aIds;
+  vtkNew<vtkIdList> bIds;
+  for (vtkIdType cellId = 0; cellId < a->GetNumberOfCells(); ++cellId)
+  {
+    bool same = a->GetCellType(cellId) == b->GetCellType(cellId);
+    if (same)
+    {
+      a->GetCellPoints(cellId, aIds);
+      b->GetCellPoints(cellId, bIds);
+      same = vtkSMPTestUtilities::CompareIds(aIds, bIds);
+    }
+    if (same)
+    {
+      a->GetFaceStream(cellId, aIds);
+      b->GetFaceStream(cellId, bIds);
+      same = vtkSMPTestUtilities::CompareIds(aIds, bIds);
+    }
+    if (!same)
+    {
+      cerr << "Cell " << cellId << " differs." << endl;
+      return false;
+    }
+  }
+  return vtkSMPTestUtilities::CompareAttributes(a->GetPointData(), b->GetPointData()) &&
+    vtkSMPTestUtilities::CompareAttributes(a->GetCellData(), b->GetCellData());
+}
+
+inline bool vtkSMPTestUtilities::CompareOutputs(vtkDataSet* a, vtkDataSet* b)
+{
+  if (strcmp(a->GetClassName(), b->GetClassName()) != 0)
+  {
+    cerr << "Found a " << b->GetClassName() << " instead of a " << a->GetClassName() << "."
+         << endl;
+    return false;
+  }
+  if (vtkPolyData::SafeDownCast(a))
+  {
+    return vtkSMPTestUtilities::CompareOutputs(
+      vtkPolyData::SafeDownCast(a), vtkPolyData::SafeDownCast(b));
+  }
+  if (vtkUnstructuredGrid::SafeDownCast(a))
+  {
+    return vtkSMPTestUtilities::CompareOutputs(
+      vtkUnstructuredGrid::SafeDownCast(a), vtkUnstructuredGrid::SafeDownCast(b));
+  }
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfCells() != b->GetNumberOfCells())
+  {
+    cerr << "Found " << b->GetNumberOfPoints() << " points and " << b->GetNumberOfCells()
+         << " cells instead of " << a->GetNumberOfPoints() << " and " << a->GetNumberOfCells()
+         << "." << endl;
+    return false;
+  }
+  return vtkSMPTestUtilities::CompareAttributes(a->GetPointData(), b->GetPointData()) &&
+    vtkSMPTestUtilities::CompareAttributes(a->GetCellData(), b->GetCellData());
+}
+
+inline bool vtkSMPTestUtilities::OutputRecorder::Check(vtkDataSet* output, int numThreads)
+{
+  if (numThreads != this->NumThreads)
+  {
+    this->NumThreads = numThreads;
+    this->Next = 0;
+  }
+  if (numThreads == 1)
+  {
+    vtkSmartPointer<vtkDataSet> copy = vtk::TakeSmartPointer(output->NewInstance());
+    copy->DeepCopy(output);
+    this->Outputs.push_back(copy);
+    return true;
+  }
+  if (this->Next >= this->Outputs.size())
+  {
+    cerr << "No output with one thread to compare with." << endl;
+    return false;
+  }
+  if (!vtkSMPTestUtilities::CompareOutputs(this->Outputs[this->Next++], output))
+  {
+    cerr << "The output differs with " << numThreads << " threads." << endl;
+    return false;
+  }
+  return true;
+}
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPTestUtilities.h
@@ -0,0 +1,34 @@
+#!/usr/bin/env bash
+
+set -e
+set -x
+shopt -s dotglob
+
+readonly name="zstd"
+readonly ownership="zstd Upstream <kwrobot@kitware.com>"
+readonly subtree="ThirdParty/$name/vtk$name"
+readonly repo="https://gitlab.kitware.com/third-party/zstd.git"
+readonly tag="for/vtk-20250219-1.5.7"
+readonly paths="
+lib/common/*.c
+lib/common/*.h
+lib/compress/*.c
+lib/compress/*.h
+lib/decompress/*.c
+lib/decompress/*.h
+lib/vtk_zstd_mangle.h
+lib/zstd.h
+lib/zstd_errors.h
+
+.gitattributes
+COPYING
+LICENSE
+README.kitware.md
+CMakeLists.txt
+"
+
+extract_source () {
+    git_archive
+}
+
+. "${BASH_SOURCE%/*}/../update-common.sh"
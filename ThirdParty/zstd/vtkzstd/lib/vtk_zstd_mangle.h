@@ -0,0 +1,368 @@
+#ifndef vtk_zstd_mangle_h
+#define vtk_zstd_mangle_h
+
+#define ERR_getErrorString vtkzstd_ERR_getErrorString
+#define FSE_NCountWriteBound vtkzstd_FSE_NCountWriteBound
+#define FSE_buildCTable_rle vtkzstd_FSE_buildCTable_rle
+#define FSE_buildCTable_wksp vtkzstd_FSE_buildCTable_wksp
+#define FSE_buildDTable_wksp vtkzstd_FSE_buildDTable_wksp
+#define FSE_compressBound vtkzstd_FSE_compressBound
+#define FSE_compress_usingCTable vtkzstd_FSE_compress_usingCTable
+#define FSE_decompress_wksp_bmi2 vtkzstd_FSE_decompress_wksp_bmi2
+#define FSE_getErrorName vtkzstd_FSE_getErrorName
+#define FSE_isError vtkzstd_FSE_isError
+#define FSE_normalizeCount vtkzstd_FSE_normalizeCount
+#define FSE_optimalTableLog vtkzstd_FSE_optimalTableLog
+#define FSE_optimalTableLog_internal vtkzstd_FSE_optimalTableLog_internal
+#define FSE_readNCount vtkzstd_FSE_readNCount
+#define FSE_readNCount_bmi2 vtkzstd_FSE_readNCount_bmi2
+#define FSE_versionNumber vtkzstd_FSE_versionNumber
+#define FSE_writeNCount vtkzstd_FSE_writeNCount
+#define HIST_add vtkzstd_HIST_add
+#define HIST_count vtkzstd_HIST_count
+#define HIST_countFast vtkzstd_HIST_countFast
+#define HIST_countFast_wksp vtkzstd_HIST_countFast_wksp
+#define HIST_count_simple vtkzstd_HIST_count_simple
+#define HIST_count_wksp vtkzstd_HIST_count_wksp
+#define HIST_isError vtkzstd_HIST_isError
+#define HUF_buildCTable_wksp vtkzstd_HUF_buildCTable_wksp
+#define HUF_cardinality vtkzstd_HUF_cardinality
+#define HUF_compress1X_repeat vtkzstd_HUF_compress1X_repeat
+#define HUF_compress1X_usingCTable vtkzstd_HUF_compress1X_usingCTable
+#define HUF_compress4X_repeat vtkzstd_HUF_compress4X_repeat
+#define HUF_compress4X_usingCTable vtkzstd_HUF_compress4X_usingCTable
+#define HUF_compressBound vtkzstd_HUF_compressBound
+#define HUF_decompress1X1_DCtx_wksp vtkzstd_HUF_decompress1X1_DCtx_wksp
+#define HUF_decompress1X2_DCtx_wksp vtkzstd_HUF_decompress1X2_DCtx_wksp
+#define HUF_decompress1X_DCtx_wksp vtkzstd_HUF_decompress1X_DCtx_wksp
+#define HUF_decompress1X_usingDTable vtkzstd_HUF_decompress1X_usingDTable
+#define HUF_decompress4X_hufOnly_wksp vtkzstd_HUF_decompress4X_hufOnly_wksp
+#define HUF_decompress4X_usingDTable vtkzstd_HUF_decompress4X_usingDTable
+#define HUF_estimateCompressedSize vtkzstd_HUF_estimateCompressedSize
+#define HUF_getErrorName vtkzstd_HUF_getErrorName
+#define HUF_getNbBitsFromCTable vtkzstd_HUF_getNbBitsFromCTable
+#define HUF_isError vtkzstd_HUF_isError
+#define HUF_minTableLog vtkzstd_HUF_minTableLog
+#define HUF_optimalTableLog vtkzstd_HUF_optimalTableLog
+#define HUF_readCTable vtkzstd_HUF_readCTable
+#define HUF_readCTableHeader vtkzstd_HUF_readCTableHeader
+#define HUF_readDTableX1_wksp vtkzstd_HUF_readDTableX1_wksp
+#define HUF_readDTableX2_wksp vtkzstd_HUF_readDTableX2_wksp
+#define HUF_readStats vtkzstd_HUF_readStats
+#define HUF_readStats_wksp vtkzstd_HUF_readStats_wksp
+#define HUF_selectDecoder vtkzstd_HUF_selectDecoder
+#define HUF_validateCTable vtkzstd_HUF_validateCTable
+#define HUF_writeCTable_wksp vtkzstd_HUF_writeCTable_wksp
+#define POOL_add vtkzstd_POOL_add
+#define POOL_create vtkzstd_POOL_create
+#define POOL_create_advanced vtkzstd_POOL_create_advanced
+#define POOL_free vtkzstd_POOL_free
+#define POOL_joinJobs vtkzstd_POOL_joinJobs
+#define POOL_resize vtkzstd_POOL_resize
+#define POOL_sizeof vtkzstd_POOL_sizeof
+#define POOL_tryAdd vtkzstd_POOL_tryAdd
+#define ZSTDMT_compressStream_generic vtkzstd_ZSTDMT_compressStream_generic
+#define ZSTDMT_createCCtx_advanced vtkzstd_ZSTDMT_createCCtx_advanced
+#define ZSTDMT_freeCCtx vtkzstd_ZSTDMT_freeCCtx
+#define ZSTDMT_getFrameProgression vtkzstd_ZSTDMT_getFrameProgression
+#define ZSTDMT_initCStream_internal vtkzstd_ZSTDMT_initCStream_internal
+#define ZSTDMT_nextInputSizeHint vtkzstd_ZSTDMT_nextInputSizeHint
+#define ZSTDMT_sizeof_CCtx vtkzstd_ZSTDMT_sizeof_CCtx
+#define ZSTDMT_toFlushNow vtkzstd_ZSTDMT_toFlushNow
+#define ZSTDMT_updateCParams_whileCompressing vtkzstd_ZSTDMT_updateCParams_whileCompressing
+#define ZSTD_CCtxParams_getParameter vtkzstd_ZSTD_CCtxParams_getParameter
+#define ZSTD_CCtxParams_init vtkzstd_ZSTD_CCtxParams_init
+#define ZSTD_CCtxParams_init_advanced vtkzstd_ZSTD_CCtxParams_init_advanced
+#define ZSTD_CCtxParams_registerSequenceProducer vtkzstd_ZSTD_CCtxParams_registerSequenceProducer
+#define ZSTD_CCtxParams_reset vtkzstd_ZSTD_CCtxParams_reset
+#define ZSTD_CCtxParams_setParameter vtkzstd_ZSTD_CCtxParams_setParameter
+#define ZSTD_CCtx_getParameter vtkzstd_ZSTD_CCtx_getParameter
+#define ZSTD_CCtx_loadDictionary vtkzstd_ZSTD_CCtx_loadDictionary
+#define ZSTD_CCtx_loadDictionary_advanced vtkzstd_ZSTD_CCtx_loadDictionary_advanced
+#define ZSTD_CCtx_loadDictionary_byReference vtkzstd_ZSTD_CCtx_loadDictionary_byReference
+#define ZSTD_CCtx_refCDict vtkzstd_ZSTD_CCtx_refCDict
+#define ZSTD_CCtx_refPrefix vtkzstd_ZSTD_CCtx_refPrefix
+#define ZSTD_CCtx_refPrefix_advanced vtkzstd_ZSTD_CCtx_refPrefix_advanced
+#define ZSTD_CCtx_refThreadPool vtkzstd_ZSTD_CCtx_refThreadPool
+#define ZSTD_CCtx_reset vtkzstd_ZSTD_CCtx_reset
+#define ZSTD_CCtx_setCParams vtkzstd_ZSTD_CCtx_setCParams
+#define ZSTD_CCtx_setFParams vtkzstd_ZSTD_CCtx_setFParams
+#define ZSTD_CCtx_setParameter vtkzstd_ZSTD_CCtx_setParameter
+#define ZSTD_CCtx_setParametersUsingCCtxParams vtkzstd_ZSTD_CCtx_setParametersUsingCCtxParams
+#define ZSTD_CCtx_setParams vtkzstd_ZSTD_CCtx_setParams
+#define ZSTD_CCtx_setPledgedSrcSize vtkzstd_ZSTD_CCtx_setPledgedSrcSize
+#define ZSTD_CCtx_trace vtkzstd_ZSTD_CCtx_trace
+#define ZSTD_CStreamInSize vtkzstd_ZSTD_CStreamInSize
+#define ZSTD_CStreamOutSize vtkzstd_ZSTD_CStreamOutSize
+#define ZSTD_DCtx_getParameter vtkzstd_ZSTD_DCtx_getParameter
+#define ZSTD_DCtx_loadDictionary vtkzstd_ZSTD_DCtx_loadDictionary
+#define ZSTD_DCtx_loadDictionary_advanced vtkzstd_ZSTD_DCtx_loadDictionary_advanced
+#define ZSTD_DCtx_loadDictionary_byReference vtkzstd_ZSTD_DCtx_loadDictionary_byReference
+#define ZSTD_DCtx_refDDict vtkzstd_ZSTD_DCtx_refDDict
+#define ZSTD_DCtx_refPrefix vtkzstd_ZSTD_DCtx_refPrefix
+#define ZSTD_DCtx_refPrefix_advanced vtkzstd_ZSTD_DCtx_refPrefix_advanced
+#define ZSTD_DCtx_reset vtkzstd_ZSTD_DCtx_reset
+#define ZSTD_DCtx_setFormat vtkzstd_ZSTD_DCtx_setFormat
+#define ZSTD_DCtx_setMaxWindowSize vtkzstd_ZSTD_DCtx_setMaxWindowSize
+#define ZSTD_DCtx_setParameter vtkzstd_ZSTD_DCtx_setParameter
+#define ZSTD_DDict_dictContent vtkzstd_ZSTD_DDict_dictContent
+#define ZSTD_DDict_dictSize vtkzstd_ZSTD_DDict_dictSize
+#define ZSTD_DStreamInSize vtkzstd_ZSTD_DStreamInSize
+#define ZSTD_DStreamOutSize vtkzstd_ZSTD_DStreamOutSize
+#define ZSTD_XXH32 vtkzstd_ZSTD_XXH32
+#define ZSTD_XXH32_canonicalFromHash vtkzstd_ZSTD_XXH32_canonicalFromHash
+#define ZSTD_XXH32_copyState vtkzstd_ZSTD_XXH32_copyState
+#define ZSTD_XXH32_createState vtkzstd_ZSTD_XXH32_createState
+#define ZSTD_XXH32_digest vtkzstd_ZSTD_XXH32_digest
+#define ZSTD_XXH32_freeState vtkzstd_ZSTD_XXH32_freeState
+#define ZSTD_XXH32_hashFromCanonical vtkzstd_ZSTD_XXH32_hashFromCanonical
+#define ZSTD_XXH32_reset vtkzstd_ZSTD_XXH32_reset
+#define ZSTD_XXH32_update vtkzstd_ZSTD_XXH32_update
+#define ZSTD_XXH64 vtkzstd_ZSTD_XXH64
+#define ZSTD_XXH64_canonicalFromHash vtkzstd_ZSTD_XXH64_canonicalFromHash
+#define ZSTD_XXH64_copyState vtkzstd_ZSTD_XXH64_copyState
+#define ZSTD_XXH64_createState vtkzstd_ZSTD_XXH64_createState
+#define ZSTD_XXH64_digest vtkzstd_ZSTD_XXH64_digest
+#define ZSTD_XXH64_freeState vtkzstd_ZSTD_XXH64_freeState
+#define ZSTD_XXH64_hashFromCanonical vtkzstd_ZSTD_XXH64_hashFromCanonical
+#define ZSTD_XXH64_reset vtkzstd_ZSTD_XXH64_reset
+#define ZSTD_XXH64_update vtkzstd_ZSTD_XXH64_update
+#define ZSTD_XXH_versionNumber vtkzstd_ZSTD_XXH_versionNumber
+#define ZSTD_adjustCParams vtkzstd_ZSTD_adjustCParams
+#define ZSTD_buildBlockEntropyStats vtkzstd_ZSTD_buildBlockEntropyStats
+#define ZSTD_buildCTable vtkzstd_ZSTD_buildCTable
+#define ZSTD_buildFSETable vtkzstd_ZSTD_buildFSETable
+#define ZSTD_cParam_getBounds vtkzstd_ZSTD_cParam_getBounds
+#define ZSTD_checkCParams vtkzstd_ZSTD_checkCParams
+#define ZSTD_checkContinuity vtkzstd_ZSTD_checkContinuity
+#define ZSTD_compress vtkzstd_ZSTD_compress
+#define ZSTD_compress2 vtkzstd_ZSTD_compress2
+#define ZSTD_compressBegin vtkzstd_ZSTD_compressBegin
+#define ZSTD_compressBegin_advanced vtkzstd_ZSTD_compressBegin_advanced
+#define ZSTD_compressBegin_advanced_internal vtkzstd_ZSTD_compressBegin_advanced_internal
+#define ZSTD_compressBegin_usingCDict vtkzstd_ZSTD_compressBegin_usingCDict
+#define ZSTD_compressBegin_usingCDict_advanced vtkzstd_ZSTD_compressBegin_usingCDict_advanced
+#define ZSTD_compressBegin_usingCDict_deprecated vtkzstd_ZSTD_compressBegin_usingCDict_deprecated
+#define ZSTD_compressBegin_usingDict vtkzstd_ZSTD_compressBegin_usingDict
+#define ZSTD_compressBlock vtkzstd_ZSTD_compressBlock
+#define ZSTD_compressBlock_btlazy2 vtkzstd_ZSTD_compressBlock_btlazy2
+#define ZSTD_compressBlock_btlazy2_dictMatchState vtkzstd_ZSTD_compressBlock_btlazy2_dictMatchState
+#define ZSTD_compressBlock_btlazy2_extDict vtkzstd_ZSTD_compressBlock_btlazy2_extDict
+#define ZSTD_compressBlock_btopt vtkzstd_ZSTD_compressBlock_btopt
+#define ZSTD_compressBlock_btopt_dictMatchState vtkzstd_ZSTD_compressBlock_btopt_dictMatchState
+#define ZSTD_compressBlock_btopt_extDict vtkzstd_ZSTD_compressBlock_btopt_extDict
+#define ZSTD_compressBlock_btultra vtkzstd_ZSTD_compressBlock_btultra
+#define ZSTD_compressBlock_btultra2 vtkzstd_ZSTD_compressBlock_btultra2
+#define ZSTD_compressBlock_btultra_dictMatchState vtkzstd_ZSTD_compressBlock_btultra_dictMatchState
+#define ZSTD_compressBlock_btultra_extDict vtkzstd_ZSTD_compressBlock_btultra_extDict
+#define ZSTD_compressBlock_deprecated vtkzstd_ZSTD_compressBlock_deprecated
+#define ZSTD_compressBlock_doubleFast vtkzstd_ZSTD_compressBlock_doubleFast
+#define ZSTD_compressBlock_doubleFast_dictMatchState vtkzstd_ZSTD_compressBlock_doubleFast_dictMatchState
+#define ZSTD_compressBlock_doubleFast_extDict vtkzstd_ZSTD_compressBlock_doubleFast_extDict
+#define ZSTD_compressBlock_fast vtkzstd_ZSTD_compressBlock_fast
+#define ZSTD_compressBlock_fast_dictMatchState vtkzstd_ZSTD_compressBlock_fast_dictMatchState
+#define ZSTD_compressBlock_fast_extDict vtkzstd_ZSTD_compressBlock_fast_extDict
+#define ZSTD_compressBlock_greedy vtkzstd_ZSTD_compressBlock_greedy
+#define ZSTD_compressBlock_greedy_dedicatedDictSearch vtkzstd_ZSTD_compressBlock_greedy_dedicatedDictSearch
+#define ZSTD_compressBlock_greedy_dedicatedDictSearch_row vtkzstd_ZSTD_compressBlock_greedy_dedicatedDictSearch_row
+#define ZSTD_compressBlock_greedy_dictMatchState vtkzstd_ZSTD_compressBlock_greedy_dictMatchState
+#define ZSTD_compressBlock_greedy_dictMatchState_row vtkzstd_ZSTD_compressBlock_greedy_dictMatchState_row
+#define ZSTD_compressBlock_greedy_extDict vtkzstd_ZSTD_compressBlock_greedy_extDict
+#define ZSTD_compressBlock_greedy_extDict_row vtkzstd_ZSTD_compressBlock_greedy_extDict_row
+#define ZSTD_compressBlock_greedy_row vtkzstd_ZSTD_compressBlock_greedy_row
+#define ZSTD_compressBlock_lazy vtkzstd_ZSTD_compressBlock_lazy
+#define ZSTD_compressBlock_lazy2 vtkzstd_ZSTD_compressBlock_lazy2
+#define ZSTD_compressBlock_lazy2_dedicatedDictSearch vtkzstd_ZSTD_compressBlock_lazy2_dedicatedDictSearch
+#define ZSTD_compressBlock_lazy2_dedicatedDictSearch_row vtkzstd_ZSTD_compressBlock_lazy2_dedicatedDictSearch_row
+#define ZSTD_compressBlock_lazy2_dictMatchState vtkzstd_ZSTD_compressBlock_lazy2_dictMatchState
+#define ZSTD_compressBlock_lazy2_dictMatchState_row vtkzstd_ZSTD_compressBlock_lazy2_dictMatchState_row
+#define ZSTD_compressBlock_lazy2_extDict vtkzstd_ZSTD_compressBlock_lazy2_extDict
+#define ZSTD_compressBlock_lazy2_extDict_row vtkzstd_ZSTD_compressBlock_lazy2_extDict_row
+#define ZSTD_compressBlock_lazy2_row vtkzstd_ZSTD_compressBlock_lazy2_row
+#define ZSTD_compressBlock_lazy_dedicatedDictSearch vtkzstd_ZSTD_compressBlock_lazy_dedicatedDictSearch
+#define ZSTD_compressBlock_lazy_dedicatedDictSearch_row vtkzstd_ZSTD_compressBlock_lazy_dedicatedDictSearch_row
+#define ZSTD_compressBlock_lazy_dictMatchState vtkzstd_ZSTD_compressBlock_lazy_dictMatchState
+#define ZSTD_compressBlock_lazy_dictMatchState_row vtkzstd_ZSTD_compressBlock_lazy_dictMatchState_row
+#define ZSTD_compressBlock_lazy_extDict vtkzstd_ZSTD_compressBlock_lazy_extDict
+#define ZSTD_compressBlock_lazy_extDict_row vtkzstd_ZSTD_compressBlock_lazy_extDict_row
+#define ZSTD_compressBlock_lazy_row vtkzstd_ZSTD_compressBlock_lazy_row
+#define ZSTD_compressBound vtkzstd_ZSTD_compressBound
+#define ZSTD_compressCCtx vtkzstd_ZSTD_compressCCtx
+#define ZSTD_compressContinue vtkzstd_ZSTD_compressContinue
+#define ZSTD_compressContinue_public vtkzstd_ZSTD_compressContinue_public
+#define ZSTD_compressEnd vtkzstd_ZSTD_compressEnd
+#define ZSTD_compressEnd_public vtkzstd_ZSTD_compressEnd_public
+#define ZSTD_compressLiterals vtkzstd_ZSTD_compressLiterals
+#define ZSTD_compressRleLiteralsBlock vtkzstd_ZSTD_compressRleLiteralsBlock
+#define ZSTD_compressSequences vtkzstd_ZSTD_compressSequences
+#define ZSTD_compressSequencesAndLiterals vtkzstd_ZSTD_compressSequencesAndLiterals
+#define ZSTD_compressStream vtkzstd_ZSTD_compressStream
+#define ZSTD_compressStream2 vtkzstd_ZSTD_compressStream2
+#define ZSTD_compressStream2_simpleArgs vtkzstd_ZSTD_compressStream2_simpleArgs
+#define ZSTD_compressSuperBlock vtkzstd_ZSTD_compressSuperBlock
+#define ZSTD_compress_advanced vtkzstd_ZSTD_compress_advanced
+#define ZSTD_compress_advanced_internal vtkzstd_ZSTD_compress_advanced_internal
+#define ZSTD_compress_usingCDict vtkzstd_ZSTD_compress_usingCDict
+#define ZSTD_compress_usingCDict_advanced vtkzstd_ZSTD_compress_usingCDict_advanced
+#define ZSTD_compress_usingDict vtkzstd_ZSTD_compress_usingDict
+#define ZSTD_convertBlockSequences vtkzstd_ZSTD_convertBlockSequences
+#define ZSTD_copyCCtx vtkzstd_ZSTD_copyCCtx
+#define ZSTD_copyDCtx vtkzstd_ZSTD_copyDCtx
+#define ZSTD_copyDDictParameters vtkzstd_ZSTD_copyDDictParameters
+#define ZSTD_createCCtx vtkzstd_ZSTD_createCCtx
+#define ZSTD_createCCtxParams vtkzstd_ZSTD_createCCtxParams
+#define ZSTD_createCCtx_advanced vtkzstd_ZSTD_createCCtx_advanced
+#define ZSTD_createCDict vtkzstd_ZSTD_createCDict
+#define ZSTD_createCDict_advanced vtkzstd_ZSTD_createCDict_advanced
+#define ZSTD_createCDict_advanced2 vtkzstd_ZSTD_createCDict_advanced2
+#define ZSTD_createCDict_byReference vtkzstd_ZSTD_createCDict_byReference
+#define ZSTD_createCStream vtkzstd_ZSTD_createCStream
+#define ZSTD_createCStream_advanced vtkzstd_ZSTD_createCStream_advanced
+#define ZSTD_createDCtx vtkzstd_ZSTD_createDCtx
+#define ZSTD_createDCtx_advanced vtkzstd_ZSTD_createDCtx_advanced
+#define ZSTD_createDDict vtkzstd_ZSTD_createDDict
+#define ZSTD_createDDict_advanced vtkzstd_ZSTD_createDDict_advanced
+#define ZSTD_createDDict_byReference vtkzstd_ZSTD_createDDict_byReference
+#define ZSTD_createDStream vtkzstd_ZSTD_createDStream
+#define ZSTD_createDStream_advanced vtkzstd_ZSTD_createDStream_advanced
+#define ZSTD_createThreadPool vtkzstd_ZSTD_createThreadPool
+#define ZSTD_crossEntropyCost vtkzstd_ZSTD_crossEntropyCost
+#define ZSTD_cycleLog vtkzstd_ZSTD_cycleLog
+#define ZSTD_dParam_getBounds vtkzstd_ZSTD_dParam_getBounds
+#define ZSTD_decodeLiteralsBlock_wrapper vtkzstd_ZSTD_decodeLiteralsBlock_wrapper
+#define ZSTD_decodeSeqHeaders vtkzstd_ZSTD_decodeSeqHeaders
+#define ZSTD_decodingBufferSize_min vtkzstd_ZSTD_decodingBufferSize_min
+#define ZSTD_decompress vtkzstd_ZSTD_decompress
+#define ZSTD_decompressBegin vtkzstd_ZSTD_decompressBegin
+#define ZSTD_decompressBegin_usingDDict vtkzstd_ZSTD_decompressBegin_usingDDict
+#define ZSTD_decompressBegin_usingDict vtkzstd_ZSTD_decompressBegin_usingDict
+#define ZSTD_decompressBlock vtkzstd_ZSTD_decompressBlock
+#define ZSTD_decompressBlock_deprecated vtkzstd_ZSTD_decompressBlock_deprecated
+#define ZSTD_decompressBlock_internal vtkzstd_ZSTD_decompressBlock_internal
+#define ZSTD_decompressBound vtkzstd_ZSTD_decompressBound
+#define ZSTD_decompressContinue vtkzstd_ZSTD_decompressContinue
+#define ZSTD_decompressDCtx vtkzstd_ZSTD_decompressDCtx
+#define ZSTD_decompressStream vtkzstd_ZSTD_decompressStream
+#define ZSTD_decompressStream_simpleArgs vtkzstd_ZSTD_decompressStream_simpleArgs
+#define ZSTD_decompress_usingDDict vtkzstd_ZSTD_decompress_usingDDict
+#define ZSTD_decompress_usingDict vtkzstd_ZSTD_decompress_usingDict
+#define ZSTD_decompressionMargin vtkzstd_ZSTD_decompressionMargin
+#define ZSTD_dedicatedDictSearch_lazy_loadDictionary vtkzstd_ZSTD_dedicatedDictSearch_lazy_loadDictionary
+#define ZSTD_defaultCLevel vtkzstd_ZSTD_defaultCLevel
+#define ZSTD_encodeSequences vtkzstd_ZSTD_encodeSequences
+#define ZSTD_endStream vtkzstd_ZSTD_endStream
+#define ZSTD_estimateCCtxSize vtkzstd_ZSTD_estimateCCtxSize
+#define ZSTD_estimateCCtxSize_usingCCtxParams vtkzstd_ZSTD_estimateCCtxSize_usingCCtxParams
+#define ZSTD_estimateCCtxSize_usingCParams vtkzstd_ZSTD_estimateCCtxSize_usingCParams
+#define ZSTD_estimateCDictSize vtkzstd_ZSTD_estimateCDictSize
+#define ZSTD_estimateCDictSize_advanced vtkzstd_ZSTD_estimateCDictSize_advanced
+#define ZSTD_estimateCStreamSize vtkzstd_ZSTD_estimateCStreamSize
+#define ZSTD_estimateCStreamSize_usingCCtxParams vtkzstd_ZSTD_estimateCStreamSize_usingCCtxParams
+#define ZSTD_estimateCStreamSize_usingCParams vtkzstd_ZSTD_estimateCStreamSize_usingCParams
+#define ZSTD_estimateDCtxSize vtkzstd_ZSTD_estimateDCtxSize
+#define ZSTD_estimateDDictSize vtkzstd_ZSTD_estimateDDictSize
+#define ZSTD_estimateDStreamSize vtkzstd_ZSTD_estimateDStreamSize
+#define ZSTD_estimateDStreamSize_fromFrame vtkzstd_ZSTD_estimateDStreamSize_fromFrame
+#define ZSTD_fillDoubleHashTable vtkzstd_ZSTD_fillDoubleHashTable
+#define ZSTD_fillHashTable vtkzstd_ZSTD_fillHashTable
+#define ZSTD_findDecompressedSize vtkzstd_ZSTD_findDecompressedSize
+#define ZSTD_findFrameCompressedSize vtkzstd_ZSTD_findFrameCompressedSize
+#define ZSTD_flushStream vtkzstd_ZSTD_flushStream
+#define ZSTD_frameHeaderSize vtkzstd_ZSTD_frameHeaderSize
+#define ZSTD_freeCCtx vtkzstd_ZSTD_freeCCtx
+#define ZSTD_freeCCtxParams vtkzstd_ZSTD_freeCCtxParams
+#define ZSTD_freeCDict vtkzstd_ZSTD_freeCDict
+#define ZSTD_freeCStream vtkzstd_ZSTD_freeCStream
+#define ZSTD_freeDCtx vtkzstd_ZSTD_freeDCtx
+#define ZSTD_freeDDict vtkzstd_ZSTD_freeDDict
+#define ZSTD_freeDStream vtkzstd_ZSTD_freeDStream
+#define ZSTD_freeThreadPool vtkzstd_ZSTD_freeThreadPool
+#define ZSTD_fseBitCost vtkzstd_ZSTD_fseBitCost
+#define ZSTD_generateSequences vtkzstd_ZSTD_generateSequences
+#define ZSTD_get1BlockSummary vtkzstd_ZSTD_get1BlockSummary
+#define ZSTD_getBlockSize vtkzstd_ZSTD_getBlockSize
+#define ZSTD_getCParams vtkzstd_ZSTD_getCParams
+#define ZSTD_getCParamsFromCCtxParams vtkzstd_ZSTD_getCParamsFromCCtxParams
+#define ZSTD_getCParamsFromCDict vtkzstd_ZSTD_getCParamsFromCDict
+#define ZSTD_getDecompressedSize vtkzstd_ZSTD_getDecompressedSize
+#define ZSTD_getDictID_fromCDict vtkzstd_ZSTD_getDictID_fromCDict
+#define ZSTD_getDictID_fromDDict vtkzstd_ZSTD_getDictID_fromDDict
+#define ZSTD_getDictID_fromDict vtkzstd_ZSTD_getDictID_fromDict
+#define ZSTD_getDictID_fromFrame vtkzstd_ZSTD_getDictID_fromFrame
+#define ZSTD_getErrorCode vtkzstd_ZSTD_getErrorCode
+#define ZSTD_getErrorName vtkzstd_ZSTD_getErrorName
+#define ZSTD_getErrorString vtkzstd_ZSTD_getErrorString
+#define ZSTD_getFrameContentSize vtkzstd_ZSTD_getFrameContentSize
+#define ZSTD_getFrameHeader vtkzstd_ZSTD_getFrameHeader
+#define ZSTD_getFrameHeader_advanced vtkzstd_ZSTD_getFrameHeader_advanced
+#define ZSTD_getFrameProgression vtkzstd_ZSTD_getFrameProgression
+#define ZSTD_getParams vtkzstd_ZSTD_getParams
+#define ZSTD_getSeqStore vtkzstd_ZSTD_getSeqStore
+#define ZSTD_getcBlockSize vtkzstd_ZSTD_getcBlockSize
+#define ZSTD_initCStream vtkzstd_ZSTD_initCStream
+#define ZSTD_initCStream_advanced vtkzstd_ZSTD_initCStream_advanced
+#define ZSTD_initCStream_internal vtkzstd_ZSTD_initCStream_internal
+#define ZSTD_initCStream_srcSize vtkzstd_ZSTD_initCStream_srcSize
+#define ZSTD_initCStream_usingCDict vtkzstd_ZSTD_initCStream_usingCDict
+#define ZSTD_initCStream_usingCDict_advanced vtkzstd_ZSTD_initCStream_usingCDict_advanced
+#define ZSTD_initCStream_usingDict vtkzstd_ZSTD_initCStream_usingDict
+#define ZSTD_initDStream vtkzstd_ZSTD_initDStream
+#define ZSTD_initDStream_usingDDict vtkzstd_ZSTD_initDStream_usingDDict
+#define ZSTD_initDStream_usingDict vtkzstd_ZSTD_initDStream_usingDict
+#define ZSTD_initStaticCCtx vtkzstd_ZSTD_initStaticCCtx
+#define ZSTD_initStaticCDict vtkzstd_ZSTD_initStaticCDict
+#define ZSTD_initStaticCStream vtkzstd_ZSTD_initStaticCStream
+#define ZSTD_initStaticDCtx vtkzstd_ZSTD_initStaticDCtx
+#define ZSTD_initStaticDDict vtkzstd_ZSTD_initStaticDDict
+#define ZSTD_initStaticDStream vtkzstd_ZSTD_initStaticDStream
+#define ZSTD_insertAndFindFirstIndex vtkzstd_ZSTD_insertAndFindFirstIndex
+#define ZSTD_insertBlock vtkzstd_ZSTD_insertBlock
+#define ZSTD_invalidateRepCodes vtkzstd_ZSTD_invalidateRepCodes
+#define ZSTD_isError vtkzstd_ZSTD_isError
+#define ZSTD_isFrame vtkzstd_ZSTD_isFrame
+#define ZSTD_isSkippableFrame vtkzstd_ZSTD_isSkippableFrame
+#define ZSTD_ldm_adjustParameters vtkzstd_ZSTD_ldm_adjustParameters
+#define ZSTD_ldm_blockCompress vtkzstd_ZSTD_ldm_blockCompress
+#define ZSTD_ldm_fillHashTable vtkzstd_ZSTD_ldm_fillHashTable
+#define ZSTD_ldm_generateSequences vtkzstd_ZSTD_ldm_generateSequences
+#define ZSTD_ldm_getMaxNbSeq vtkzstd_ZSTD_ldm_getMaxNbSeq
+#define ZSTD_ldm_getTableSize vtkzstd_ZSTD_ldm_getTableSize
+#define ZSTD_ldm_skipRawSeqStoreBytes vtkzstd_ZSTD_ldm_skipRawSeqStoreBytes
+#define ZSTD_ldm_skipSequences vtkzstd_ZSTD_ldm_skipSequences
+#define ZSTD_loadCEntropy vtkzstd_ZSTD_loadCEntropy
+#define ZSTD_loadDEntropy vtkzstd_ZSTD_loadDEntropy
+#define ZSTD_maxCLevel vtkzstd_ZSTD_maxCLevel
+#define ZSTD_mergeBlockDelimiters vtkzstd_ZSTD_mergeBlockDelimiters
+#define ZSTD_minCLevel vtkzstd_ZSTD_minCLevel
+#define ZSTD_nextInputType vtkzstd_ZSTD_nextInputType
+#define ZSTD_nextSrcSizeToDecompress vtkzstd_ZSTD_nextSrcSizeToDecompress
+#define ZSTD_noCompressLiterals vtkzstd_ZSTD_noCompressLiterals
+#define ZSTD_readSkippableFrame vtkzstd_ZSTD_readSkippableFrame
+#define ZSTD_referenceExternalSequences vtkzstd_ZSTD_referenceExternalSequences
+#define ZSTD_registerSequenceProducer vtkzstd_ZSTD_registerSequenceProducer
+#define ZSTD_resetCStream vtkzstd_ZSTD_resetCStream
+#define ZSTD_resetDStream vtkzstd_ZSTD_resetDStream
+#define ZSTD_resetSeqStore vtkzstd_ZSTD_resetSeqStore
+#define ZSTD_reset_compressedBlockState vtkzstd_ZSTD_reset_compressedBlockState
+#define ZSTD_row_update vtkzstd_ZSTD_row_update
+#define ZSTD_selectBlockCompressor vtkzstd_ZSTD_selectBlockCompressor
+#define ZSTD_selectEncodingType vtkzstd_ZSTD_selectEncodingType
+#define ZSTD_seqToCodes vtkzstd_ZSTD_seqToCodes
+#define ZSTD_sequenceBound vtkzstd_ZSTD_sequenceBound
+#define ZSTD_sizeof_CCtx vtkzstd_ZSTD_sizeof_CCtx
+#define ZSTD_sizeof_CDict vtkzstd_ZSTD_sizeof_CDict
+#define ZSTD_sizeof_CStream vtkzstd_ZSTD_sizeof_CStream
+#define ZSTD_sizeof_DCtx vtkzstd_ZSTD_sizeof_DCtx
+#define ZSTD_sizeof_DDict vtkzstd_ZSTD_sizeof_DDict
+#define ZSTD_sizeof_DStream vtkzstd_ZSTD_sizeof_DStream
+#define ZSTD_splitBlock vtkzstd_ZSTD_splitBlock
+#define ZSTD_toFlushNow vtkzstd_ZSTD_toFlushNow
+#define ZSTD_updateTree vtkzstd_ZSTD_updateTree
+#define ZSTD_versionNumber vtkzstd_ZSTD_versionNumber
+#define ZSTD_versionString vtkzstd_ZSTD_versionString
+#define ZSTD_writeLastEmptyBlock vtkzstd_ZSTD_writeLastEmptyBlock
+#define ZSTD_writeSkippableFrame vtkzstd_ZSTD_writeSkippableFrame
+#define g_ZSTD_threading_useless_symbol vtkzstd_g_ZSTD_threading_useless_symbol
+#define g_debuglevel vtkzstd_g_debuglevel
+
+#endif